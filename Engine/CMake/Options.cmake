@@ -27,6 +27,9 @@ OPTION( ANDROID_BUILD "build android edition" FALSE )
 OPTION( APPLE_BUILD "build android edition" FALSE )
 OPTION( WINDOWS_BUILD "build windows edition" FALSE )
 
+#headless server edition: null render device, no audio, GenesisServer player (windows only)
+OPTION( SERVER_BUILD "build headless server edition (windows only)" FALSE )
+
 
 #Compile option
 OPTION( ANDROID_OPTIMIZED "turn on optimized or not" FALSE )
@@ -75,6 +75,12 @@ namespace Animations
 		: m_bUpdateResult(false)
 		, m_ClientCount(0)
 		, m_bDirty(true)
+		, m_SkeletonKey(NULL)
+		, m_UpdateMode(UM_Idle)
+		, m_UpdateInterval(1)
+		, m_UpdatesSinceSample(1)
+		, m_PoseBlend(FULL_WEIGHT)
+		, m_bInterpolateSkipped(true)
 	{
 	}
 
@@ -317,7 +323,15 @@ namespace Animations
 
 	bool Animation::UpdateAnimation(float time)
 	{
+		if (AdvanceAnimation(time))
+		{
+			EvaluateAnimation();
+		}
+		return m_bUpdateResult;
+	}
 
+	bool Animation::AdvanceAnimation(float time)
+	{
 		m_bUpdateResult = false;
 		AnimationLayers::Iterator it = m_AnimationLayers.Begin();
 		while (it != m_AnimationLayers.End())
@@ -331,20 +345,152 @@ namespace Animations
 
 		if (m_ClientCount == 0)
 		{
+			// nobody shows the pose, sample as soon as a client comes back
 			m_bUpdateResult = false;
+			m_UpdateMode = UM_Culled;
+			m_UpdatesSinceSample = m_UpdateInterval;
+			return false;
+		}
+
+		if (!m_bUpdateResult)
+		{
+			m_UpdateMode = UM_Idle;
+			m_UpdatesSinceSample = m_UpdateInterval;
+			m_ToParentTrans.Clear(false);
+			m_PrevTrans.Clear(false);
 			return false;
 		}
 
-		if (m_bUpdateResult)
+		++m_UpdatesSinceSample;
+		if (m_UpdatesSinceSample >= m_UpdateInterval || m_ToParentTrans.IsEmpty())
+		{
+			m_UpdatesSinceSample = 0;
+			m_UpdateMode = UM_Sample;
+		}
+		else if (m_bInterpolateSkipped && !m_PrevTrans.IsEmpty())
 		{
-			sample();
+			m_UpdateMode = UM_Interpolate;
 		}
 		else
 		{
-			m_ToParentTrans.Clear(false);
+			// keep m_ToParentTrans, IsUpdate() tells the clients nothing has changed
+			m_UpdateMode = UM_Hold;
+			m_bUpdateResult = false;
+			return false;
+		}
+		return true;
+	}
+
+	void Animation::EvaluateAnimation(const Animation* shared)
+	{
+		if (UM_Sample == m_UpdateMode)
+		{
+			bool blend = m_bInterpolateSkipped && m_UpdateInterval > 1 
+				&& m_SampledTrans.Size() == m_NodeNameVec.Size();
+			if (blend)
+			{
+				m_PrevTrans = m_SampledTrans;
+				m_PrevScale = m_SampledScale;
+				m_PrevRotation = m_SampledRotation;
+			}
+			else
+			{
+				m_PrevTrans.Clear(false);
+			}
+
+			if (shared)
+			{
+				copyPose(shared);
+			}
+			else
+			{
+				sample();
+			}
+		}
+		else if (UM_Interpolate == m_UpdateMode)
+		{
+			buildToParent((float)m_UpdatesSinceSample / (float)m_UpdateInterval);
 		}
-		
-		return m_bUpdateResult;
+	}
+
+	void Animation::SetUpdateInterval(int interval)
+	{
+		m_UpdateInterval = Math::n_max(interval, 1);
+		if (m_UpdatesSinceSample > m_UpdateInterval)
+		{
+			m_UpdatesSinceSample = m_UpdateInterval;
+		}
+	}
+
+	uint Animation::GetPoseSignature() const
+	{
+		if (NULL == m_SkeletonKey)
+		{
+			return 0;
+		}
+
+		// FNV-1a over the skeleton and the state of every active clip
+		uint hash = 2166136261u;
+#define _MIX_POSE_KEY(VALUE) hash = (hash ^ (uint)(VALUE)) * 16777619u
+		_MIX_POSE_KEY((size_t)m_SkeletonKey);
+		_MIX_POSE_KEY(m_NodeNameVec.Size());
+		for (IndexT iLayer = 0; iLayer < m_AnimationLayers.Size(); ++iLayer)
+		{
+			const ClipControls& activeControls = m_AnimationLayers[iLayer]->GetActiveList();
+			for (IndexT iControl = 0; iControl < activeControls.Size(); ++iControl)
+			{
+				const ClipControl* cc = activeControls[iControl];
+				if (!cc->GetAffectedBones().IsEmpty())
+				{
+					return 0;
+				}
+				// the float bits, copied instead of read through a uint* which breaks strict aliasing
+				const float wrapTime = cc->GetCurrentWrapTime();
+				const float weight = cc->GetCurrentWeight();
+				uint wrapTimeBits, weightBits;
+				memcpy(&wrapTimeBits, &wrapTime, sizeof(uint));
+				memcpy(&weightBits, &weight, sizeof(uint));
+				_MIX_POSE_KEY(iLayer);
+				_MIX_POSE_KEY((size_t)cc->GetClip()->GetName().Value());
+				_MIX_POSE_KEY(wrapTimeBits);
+				_MIX_POSE_KEY(weightBits);
+			}
+		}
+#undef _MIX_POSE_KEY
+		return (0 == hash) ? 1 : hash;
+	}
+
+	bool Animation::IsSamePose(const Animation* other) const
+	{
+		if (NULL == m_SkeletonKey || other->m_SkeletonKey != m_SkeletonKey 
+			|| other->m_NodeNameVec.Size() != m_NodeNameVec.Size()
+			|| other->m_AnimationLayers.Size() != m_AnimationLayers.Size())
+		{
+			return false;
+		}
+
+		for (IndexT iLayer = 0; iLayer < m_AnimationLayers.Size(); ++iLayer)
+		{
+			const ClipControls& lhs = m_AnimationLayers[iLayer]->GetActiveList();
+			const ClipControls& rhs = other->m_AnimationLayers[iLayer]->GetActiveList();
+			if (lhs.Size() != rhs.Size() 
+				|| m_AnimationLayers[iLayer]->GetLayerIndex() != other->m_AnimationLayers[iLayer]->GetLayerIndex())
+			{
+				return false;
+			}
+			for (IndexT iControl = 0; iControl < lhs.Size(); ++iControl)
+			{
+				if (!lhs[iControl]->GetAffectedBones().IsEmpty() 
+					|| !rhs[iControl]->GetAffectedBones().IsEmpty()
+					|| lhs[iControl]->GetClip()->GetName() != rhs[iControl]->GetClip()->GetName()
+					|| lhs[iControl]->GetCurrentWrapTime() != rhs[iControl]->GetCurrentWrapTime()
+					|| lhs[iControl]->GetCurrentWeight() != rhs[iControl]->GetCurrentWeight())
+				{
+					return false;
+				}
+			}
+		}
+		return true;
 	}
 
 	void Animation::SetTime(const Resources::ResourceId& name, float time)
@@ -502,6 +648,8 @@ namespace Animations
 	void Animation::SetSkelTree( const Util::Array< GPtr<Resources::SkelTreeData> >& skelTree )
 	{
 		//clean data
+		m_SkeletonKey = skelTree.IsEmpty() ? NULL : skelTree[0].get();
+		m_PrevTrans.Clear(false);
 		m_NodeNameVec.Clear(false);
 		m_NodeParentIndexVec.Clear(false);
 		m_CheckedNodeList.Clear(false);
@@ -670,10 +818,32 @@ namespace Animations
 	}
 
 	void Animation::sample()
+	{
+		samplePose();
+		buildToParent(m_PrevTrans.IsEmpty() ? FULL_WEIGHT : NO_WEIGHT);
+	}
+
+	void Animation::copyPose(const Animation* shared)
+	{
+		m_SampledTrans = shared->m_SampledTrans;
+		m_SampledScale = shared->m_SampledScale;
+		m_SampledRotation = shared->m_SampledRotation;
+
+		if (m_PrevTrans.IsEmpty() && FULL_WEIGHT == shared->m_PoseBlend)
+		{
+			m_ToParentTrans = shared->m_ToParentTrans;
+			m_PoseBlend = FULL_WEIGHT;
+		}
+		else
+		{
+			buildToParent(m_PrevTrans.IsEmpty() ? FULL_WEIGHT : NO_WEIGHT);
+		}
+	}
+
+	void Animation::samplePose()
 	{
 		int nodeCount = m_NodeNameVec.Size();
 
-		m_ToParentTrans.Clear(false);
 		m_SampledTrans.Clear(false);
 		m_SampledScale.Clear(false);
 		m_SampledRotation.Clear(false);
@@ -715,12 +885,37 @@ namespace Animations
 
 			if(m_SampledRotation[iNode].length() != 0)
 				m_SampledRotation[iNode] = m_SampledRotation[iNode].normalize(m_SampledRotation[iNode]);
+		}
+	}
+
+	void Animation::buildToParent(float blend)
+	{
+		int nodeCount = m_SampledTrans.Size();
+		if (m_PrevTrans.Size() != nodeCount)
+		{
+			blend = FULL_WEIGHT;
+		}
+		m_PoseBlend = blend;
+
+		m_ToParentTrans.Clear(false);
+		for (int iNode = 0; iNode < nodeCount; ++iNode)
+		{
+			Math::float3 trans = m_SampledTrans[iNode];
+			Math::float3 scale = m_SampledScale[iNode];
+			Math::quaternion rotation = m_SampledRotation[iNode];
+			if (blend < FULL_WEIGHT)
+			{
+				// lags one sample behind, but never extrapolates a pose the clips did not produce
+				trans = m_PrevTrans[iNode] + (trans - m_PrevTrans[iNode]) * blend;
+				scale = m_PrevScale[iNode] + (scale - m_PrevScale[iNode]) * blend;
+				rotation = Math::quaternion::slerp(m_PrevRotation[iNode], rotation, blend);
+			}
 
-			Math::float4   trans4(m_SampledTrans[iNode].x(), m_SampledTrans[iNode].y(), m_SampledTrans[iNode].z(), 1.0);
-			Math::float4   scale4(m_SampledScale[iNode].x(), m_SampledScale[iNode].y(), m_SampledScale[iNode].z(), 1.0);
+			Math::float4   trans4(trans.x(), trans.y(), trans.z(), 1.0);
+			Math::float4   scale4(scale.x(), scale.y(), scale.z(), 1.0);
 
 			Math::matrix44 toParent = Math::matrix44::transformation(
-				scale4, m_SampledRotation[iNode], trans4);	
+				scale4, rotation, trans4);	
 			m_ToParentTrans.Append(toParent);
 		}
 	}
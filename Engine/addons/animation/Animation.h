@@ -60,6 +60,16 @@ namespace Animations
 			PlayNow = 2
 		};
 
+		/// how the pose was produced by the last update
+		enum UpdateMode
+		{
+			UM_Idle = 0,		// nothing is playing
+			UM_Culled,			// no visible client, clip times advance but nothing is sampled
+			UM_Sample,			// the clips are sampled (or a shared pose is copied)
+			UM_Interpolate,		// between two samples of a reduced update rate
+			UM_Hold				// between two samples, the last pose is kept
+		};
+
 		Animation();
 		~Animation();
 
@@ -110,6 +120,31 @@ namespace Animations
 
 		bool  UpdateAnimation(float time);
 
+		/// advance the clip times and decide how the pose of this update is produced, returns false if there is nothing to evaluate
+		bool  AdvanceAnimation(float time);
+
+		/// build the pose decided by AdvanceAnimation, copies the sampled pose of 'shared' instead of sampling when given
+		void  EvaluateAnimation(const Animation* shared = NULL);
+
+		UpdateMode GetUpdateMode() const;
+
+		/// sample the clips only every 'interval' updates, 1 samples every update
+		void SetUpdateInterval(int interval);
+		int  GetUpdateInterval() const;
+
+		/// interpolate between the last two samples on skipped updates instead of holding the last pose
+		void SetInterpolateSkipped(bool interpolate);
+		bool IsInterpolateSkipped() const;
+
+		/// sample on the next update regardless of the update interval
+		void RequestSample();
+
+		/// hash of everything the sampled pose depends on, 0 if the pose can not be shared
+		uint GetPoseSignature() const;
+
+		/// true if 'other' samples exactly the same pose
+		bool IsSamePose(const Animation* other) const;
+
 		void  AddAffectedNodes(const Resources::ResourceId& stateName, const Util::String& nodeName, bool recursive);
 		void  RemoveAffectedNodes(const Resources::ResourceId& stateName, const Util::String& nodeName, bool recursive);
 
@@ -141,6 +176,9 @@ namespace Animations
 		};
 
 		void sample();
+		void samplePose();
+		void copyPose(const Animation* shared);
+		void buildToParent(float blend);
 		void buildControl(AnimationClip* clip, AnimationLayer* layer);
 		AnimationLayer* buildLayer(int index);
 		AnimationLayer* findLayer(int index) const;
@@ -174,6 +212,18 @@ namespace Animations
 		Util::Array<float>			  m_LayerWeights;
 		//-------------------------------------------------------------------------------
 
+		//--------------------------------- level of detail. ---------------------------
+		Util::Array<Math::float3>     m_PrevTrans;
+		Util::Array<Math::float3>     m_PrevScale;
+		Util::Array<Math::quaternion> m_PrevRotation;
+		const void*		m_SkeletonKey;		// identifies the skeleton the clips are matched against
+		UpdateMode		m_UpdateMode;
+		int				m_UpdateInterval;
+		int				m_UpdatesSinceSample;
+		float			m_PoseBlend;		// weight of the latest sample in m_ToParentTrans
+		bool			m_bInterpolateSkipped;
+		//-------------------------------------------------------------------------------
+
 
 		GPtr<AnimationClip>			m_CurrentAnimClip;
 		int		m_ClientCount;//Use for record this animation's user count
@@ -212,6 +262,31 @@ namespace Animations
 		return m_bUpdateResult;
 	}
 
+	inline Animation::UpdateMode Animation::GetUpdateMode() const
+	{
+		return m_UpdateMode;
+	}
+
+	inline int Animation::GetUpdateInterval() const
+	{
+		return m_UpdateInterval;
+	}
+
+	inline void Animation::SetInterpolateSkipped(bool interpolate)
+	{
+		m_bInterpolateSkipped = interpolate;
+	}
+
+	inline bool Animation::IsInterpolateSkipped() const
+	{
+		return m_bInterpolateSkipped;
+	}
+
+	inline void Animation::RequestSample()
+	{
+		m_UpdatesSinceSample = m_UpdateInterval;
+	}
+
 	inline void Animation::ClientAdd()
 	{
 		++m_ClientCount;
@@ -26,6 +26,8 @@ THE SOFTWARE.
 #include "animation/AnimationServer.h"
 #include "animation/Animation.h"
 
+#include <algorithm>
+
 namespace Animations
 {
 	__ImplementClass(Animations::AnimationServer, 'ANSR', Core::RefCounted);
@@ -34,11 +36,28 @@ namespace Animations
 
 	AnimationServer::AnimationServer()
 		: m_LocalTime(0.0),
-		m_bStop(false)
+		m_bStop(false),
+		m_bLodEnabled(false),
+		m_bLodInterpolation(true),
+		m_bPoseSharing(true),
+		m_bHasLodView(false)
 	{
 		__ConstructImageSingleton;
 
 		m_Animations.Clear();
+
+		AnimationLodLevel level;
+		level.distance = 30.0f;
+		level.interval = 2;
+		m_LodLevels.Append(level);
+		level.distance = 60.0f;
+		level.interval = 4;
+		m_LodLevels.Append(level);
+		level.distance = 120.0f;
+		level.interval = 8;
+		m_LodLevels.Append(level);
+
+		Memory::Clear(&m_UpdateStats, sizeof(m_UpdateStats));
 	}
 
 	AnimationServer::~AnimationServer()
@@ -85,13 +104,115 @@ namespace Animations
 
 		SizeT count = m_Animations.Size();
 
+		Memory::Clear(&m_UpdateStats, sizeof(m_UpdateStats));
+		m_UpdateStats.animations = count;
+		m_PendingPoses.Clear(false);
+
 		for (IndexT i = 0; i<count; ++i)
 		{
-			m_Animations[i]->UpdateAnimation(time);
+			Animation* animation = m_Animations[i].get_unsafe();
+			if (animation->AdvanceAnimation(time))
+			{
+				uint signature = 0;
+				if (m_bPoseSharing && Animation::UM_Sample == animation->GetUpdateMode())
+				{
+					signature = animation->GetPoseSignature();
+				}
+
+				if (0 == signature)
+				{
+					animation->EvaluateAnimation();
+				}
+				else
+				{
+					PendingPose pending;
+					pending.signature = signature;
+					pending.animation = animation;
+					m_PendingPoses.Append(pending);
+					continue;
+				}
+			}
+			countUpdate(animation);
+		}
 
+		// crowds playing the same clips in sync sample once per group
+		if (!m_PendingPoses.IsEmpty())
+		{
+			std::sort(m_PendingPoses.Begin(), m_PendingPoses.End());
+
+			const Animation* source = NULL;
+			uint sourceSignature = 0;
+			for (IndexT i = 0; i < m_PendingPoses.Size(); ++i)
+			{
+				const PendingPose& pending = m_PendingPoses[i];
+				if (source && sourceSignature == pending.signature && pending.animation->IsSamePose(source))
+				{
+					pending.animation->EvaluateAnimation(source);
+					++m_UpdateStats.shared;
+				}
+				else
+				{
+					pending.animation->EvaluateAnimation();
+					source = pending.animation;
+					sourceSignature = pending.signature;
+					++m_UpdateStats.sampled;
+				}
+			}
 		}
 
 		m_LocalTime += time;
 	}
 
+	void AnimationServer::SetLodLevels(const Util::Array<AnimationLodLevel>& levels)
+	{
+		m_LodLevels = levels;
+		for (IndexT i = 1; i < m_LodLevels.Size(); ++i)
+		{
+			for (IndexT j = i; j > 0 && m_LodLevels[j].distance < m_LodLevels[j - 1].distance; --j)
+			{
+				AnimationLodLevel level = m_LodLevels[j];
+				m_LodLevels[j] = m_LodLevels[j - 1];
+				m_LodLevels[j - 1] = level;
+			}
+		}
+	}
+
+	int AnimationServer::GetUpdateInterval(const Math::vector& position) const
+	{
+		int interval = 1;
+		if (m_bLodEnabled && m_bHasLodView)
+		{
+			float distance = (position - m_LodViewPosition).length();
+			for (IndexT i = 0; i < m_LodLevels.Size() && distance >= m_LodLevels[i].distance; ++i)
+			{
+				interval = m_LodLevels[i].interval;
+			}
+		}
+		return Math::n_max(interval, 1);
+	}
+
+	void AnimationServer::countUpdate(const Animation* animation)
+	{
+		switch (animation->GetUpdateMode())
+		{
+		case Animation::UM_Idle:
+			++m_UpdateStats.idle;
+			break;
+		case Animation::UM_Culled:
+			++m_UpdateStats.culled;
+			break;
+		case Animation::UM_Sample:
+			++m_UpdateStats.sampled;
+			break;
+		case Animation::UM_Interpolate:
+			++m_UpdateStats.interpolated;
+			break;
+		case Animation::UM_Hold:
+			++m_UpdateStats.held;
+			break;
+		default:
+			break;
+		}
+	}
+
 }
\ No newline at end of file
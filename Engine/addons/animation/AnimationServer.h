@@ -25,11 +25,30 @@ THE SOFTWARE.
 
 #include "core/refcounted.h"
 #include "core/singleton.h"
+#include "math/vector.h"
 
 namespace Animations
 {
 	class Animation;
 
+	/// characters at least 'distance' away from the camera sample their clips every 'interval' frames
+	struct AnimationLodLevel
+	{
+		float distance;
+		int   interval;
+	};
+
+	struct AnimationUpdateStats
+	{
+		SizeT animations;
+		SizeT idle;
+		SizeT culled;
+		SizeT sampled;
+		SizeT shared;
+		SizeT interpolated;
+		SizeT held;
+	};
+
 	class AnimationServer : public Core::RefCounted
 	{
 		__DeclareClass(AnimationServer);
@@ -56,11 +75,58 @@ namespace Animations
 
 		bool IsStop();
 
+		/// distance based update rates, off by default
+		void SetLodEnabled(bool enable);
+		bool IsLodEnabled() const;
+
+		/// levels are kept sorted by distance, closer than the first level updates every frame
+		void SetLodLevels(const Util::Array<AnimationLodLevel>& levels);
+		const Util::Array<AnimationLodLevel>& GetLodLevels() const;
+
+		/// interpolate distant characters between two samples instead of holding the pose
+		void SetLodInterpolation(bool interpolate);
+		bool IsLodInterpolation() const;
+
+		/// sample once and copy the pose to every animation playing the same clips at the same time
+		void SetPoseSharing(bool share);
+		bool IsPoseSharing() const;
+
+		/// camera position the lod distances are measured from, set once per frame
+		void SetLodViewPosition(const Math::vector& position);
+		void ClearLodViewPosition();
+		bool HasLodViewPosition() const;
+		const Math::vector& GetLodViewPosition() const;
+
+		/// update interval of a character at 'position'
+		int GetUpdateInterval(const Math::vector& position) const;
+
+		const AnimationUpdateStats& GetUpdateStats() const;
+
 	protected:
+		struct PendingPose
+		{
+			uint       signature;
+			Animation* animation;
+			bool operator<(const PendingPose& rhs) const
+			{
+				return signature < rhs.signature;
+			}
+		};
+
+		void countUpdate(const Animation* animation);
+
 		float                  m_LocalTime;
 		bool                   m_bStop;
+		bool                   m_bLodEnabled;
+		bool                   m_bLodInterpolation;
+		bool                   m_bPoseSharing;
+		bool                   m_bHasLodView;
+		Math::vector           m_LodViewPosition;
 
 		Util::Array< GPtr<Animation> > m_Animations;
+		Util::Array<AnimationLodLevel> m_LodLevels;
+		Util::Array<PendingPose>       m_PendingPoses;
+		AnimationUpdateStats           m_UpdateStats;
 	};
 
 	inline float AnimationServer::GetLocalTime() const
@@ -83,4 +149,65 @@ namespace Animations
 		return m_bStop;
 	}
 
+	inline void AnimationServer::SetLodEnabled(bool enable)
+	{
+		m_bLodEnabled = enable;
+	}
+
+	inline bool AnimationServer::IsLodEnabled() const
+	{
+		return m_bLodEnabled;
+	}
+
+	inline const Util::Array<AnimationLodLevel>& AnimationServer::GetLodLevels() const
+	{
+		return m_LodLevels;
+	}
+
+	inline void AnimationServer::SetLodInterpolation(bool interpolate)
+	{
+		m_bLodInterpolation = interpolate;
+	}
+
+	inline bool AnimationServer::IsLodInterpolation() const
+	{
+		return m_bLodInterpolation;
+	}
+
+	inline void AnimationServer::SetPoseSharing(bool share)
+	{
+		m_bPoseSharing = share;
+	}
+
+	inline bool AnimationServer::IsPoseSharing() const
+	{
+		return m_bPoseSharing;
+	}
+
+	inline void AnimationServer::SetLodViewPosition(const Math::vector& position)
+	{
+		m_LodViewPosition = position;
+		m_bHasLodView = true;
+	}
+
+	inline void AnimationServer::ClearLodViewPosition()
+	{
+		m_bHasLodView = false;
+	}
+
+	inline bool AnimationServer::HasLodViewPosition() const
+	{
+		return m_bHasLodView;
+	}
+
+	inline const Math::vector& AnimationServer::GetLodViewPosition() const
+	{
+		return m_LodViewPosition;
+	}
+
+	inline const AnimationUpdateStats& AnimationServer::GetUpdateStats() const
+	{
+		return m_UpdateStats;
+	}
+
 }
\ No newline at end of file
@@ -249,6 +249,10 @@ InputServerBase::BeginFrame()
     n_assert(!this->inBeginFrame);
     this->inBeginFrame = true;
 
+    if (this->inputRecorder.isvalid())
+    {
+        this->inputRecorder->BeginFrame();
+    }
 
 	// first handler, then source. because hander maybe clear all input status
 
@@ -310,6 +314,10 @@ void
 InputServerBase::PutEvent(const InputEvent& inputEvent)
 {
     n_assert2(creatorThreadId == Threading::Thread::GetMyThreadId(), "PutEvent can't be called from any thread but the creator thread!");
+    if (this->inputRecorder.isvalid())
+    {
+        this->inputRecorder->Record(inputEvent);
+    }
     // check for mouse capture
     if (this->mouseCaptureHandler.isvalid())
     {
@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include "input/inputsource.h"
 #include "input/inputpriority.h"
 #include "input/inputevent.h"
+#include "input/inputrecorder.h"
 #include "threading/criticalsection.h"   
 #include "threading/thread.h"
 
@@ -86,6 +87,11 @@ namespace Input
 		/// remove a input source
 		void RemoveInputSource( const GPtr<Input::InputSource>& inputSource);
 
+		/// set an input recorder which records all events put into the handler chain (NULL to stop recording)
+		void SetInputRecorder(const GPtr<Input::InputRecorder>& recorder);
+		/// get the input recorder
+		const GPtr<Input::InputRecorder>& GetInputRecorder() const;
+
 		/// call before processing window events
 		virtual void BeginFrame();
 		/// call after processing window events
@@ -125,6 +131,7 @@ namespace Input
 		Util::Array< GPtr<Input::InputSource> > mInputSourceList;
 		GPtr<Input::InputHandler> mouseCaptureHandler;
 		GPtr<Input::InputHandler> keyboardCaptureHandler;
+		GPtr<Input::InputRecorder> inputRecorder;
 		GPtr<Input::InputKeyboard> defaultKeyboard;
 		GPtr<Input::InputMouse> defaultMouse;
 		
@@ -173,6 +180,26 @@ namespace Input
 		return this->isQuitRequested;
 	}
 
+	//------------------------------------------------------------------------------
+	/**
+	*/
+	inline 
+	void
+	InputServerBase::SetInputRecorder(const GPtr<Input::InputRecorder>& recorder)
+	{
+		this->inputRecorder = recorder;
+	}
+
+	//------------------------------------------------------------------------------
+	/**
+	*/
+	inline 
+	const GPtr<Input::InputRecorder>&
+	InputServerBase::GetInputRecorder() const
+	{
+		return this->inputRecorder;
+	}
+
 	//------------------------------------------------------------------------------
 	/**
 	*/
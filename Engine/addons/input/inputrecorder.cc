@@ -0,0 +1,180 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "input/input_stdneb.h"
+#include "input/inputrecorder.h"
+
+namespace Input
+{
+	__ImplementClass(Input::InputRecorder, 'INRC', Core::RefCounted);
+
+	//------------------------------------------------------------------------
+	InputRecorder::InputRecorder()
+		: mFrameIndex(0)
+	{
+
+	}
+	//------------------------------------------------------------------------
+	InputRecorder::~InputRecorder()
+	{
+		n_assert( !IsOpen() );
+	}
+	//------------------------------------------------------------------------
+	void InputRecorder::SetStream(const GPtr<IO::Stream>& s)
+	{
+		n_assert( !IsOpen() );
+		mStream = s;
+	}
+	//------------------------------------------------------------------------
+	bool InputRecorder::Open()
+	{
+		n_assert( !IsOpen() );
+		n_assert( mStream.isvalid() );
+
+		GPtr<IO::BinaryWriter> writer = IO::BinaryWriter::Create();
+		writer->SetStream(mStream);
+		if (!writer->Open())
+		{
+			n_warning("InputRecorder::Open(): can not open '%s' for writing!\n", mStream->GetURI().AsString().AsCharPtr());
+			return false;
+		}
+		writer->WriteUInt(FourCC);
+		writer->WriteUInt(Version);
+
+		mWriter = writer;
+		mFrameIndex = 0;
+		mFrameEvents.Clear();
+		return true;
+	}
+	//------------------------------------------------------------------------
+	void InputRecorder::Close()
+	{
+		n_assert( IsOpen() );
+		FlushFrame();
+		mWriter->Close();
+		mWriter = NULL;
+		mStream = NULL;
+	}
+	//------------------------------------------------------------------------
+	void InputRecorder::BeginFrame()
+	{
+		n_assert( IsOpen() );
+		FlushFrame();
+		mFrameIndex++;
+	}
+	//------------------------------------------------------------------------
+	void InputRecorder::Record(const InputEvent& inputEvent)
+	{
+		n_assert( IsOpen() );
+		if (IsRecordable(inputEvent))
+		{
+			mFrameEvents.Append(inputEvent);
+		}
+	}
+	//------------------------------------------------------------------------
+	void InputRecorder::FlushFrame()
+	{
+		// frames without input are not written at all
+		if (mFrameEvents.IsEmpty())
+		{
+			return;
+		}
+		mWriter->WriteUInt(mFrameIndex);
+		mWriter->WriteUInt(mFrameEvents.Size());
+		IndexT i;
+		for (i = 0; i < mFrameEvents.Size(); i++)
+		{
+			WriteEvent(mWriter, mFrameEvents[i]);
+		}
+		mFrameEvents.Clear(false);
+	}
+	//------------------------------------------------------------------------
+	bool InputRecorder::IsRecordable(const InputEvent& inputEvent)
+	{
+		switch (inputEvent.GetType())
+		{
+		case InputEvent::InvalidType:
+		case InputEvent::Reset:
+		case InputEvent::BeginMouseCapture:
+		case InputEvent::EndMouseCapture:
+		case InputEvent::BeginKeyboardCapture:
+		case InputEvent::EndKeyboardCapture:
+			return false;
+		default:
+			return true;
+		}
+	}
+	//------------------------------------------------------------------------
+	/**
+		Touch pointers are always written (count 0 on platforms without touch
+		input), so a recording can be replayed on any platform.
+	*/
+	void InputRecorder::WriteEvent(const GPtr<IO::BinaryWriter>& writer, const InputEvent& inputEvent)
+	{
+		writer->WriteInt(inputEvent.GetType());
+		writer->WriteInt(inputEvent.GetKey());
+		writer->WriteUInt(inputEvent.GetChar());
+		writer->WriteInt(inputEvent.GetDeviceIndex());
+		writer->WriteInt(inputEvent.GetMouseButton());
+		writer->WriteFloat2(inputEvent.GetAbsMousePos());
+		writer->WriteFloat2(inputEvent.GetNormMousePos());
+#if __ANDROID__ || __OSX__
+		SizeT numPointers = inputEvent.GetPointersCount();
+		writer->WriteUInt(numPointers);
+		IndexT i;
+		for (i = 0; i < numPointers; i++)
+		{
+			IndexT id = inputEvent.GetPointerId(i);
+			writer->WriteInt(id);
+			writer->WriteFloat2(inputEvent.GetAbsTouchPos(id));
+			writer->WriteFloat2(inputEvent.GetNormTouchPos(id));
+		}
+#else
+		writer->WriteUInt(0);
+#endif
+	}
+	//------------------------------------------------------------------------
+	void InputRecorder::ReadEvent(const GPtr<IO::BinaryReader>& reader, InputEvent& inputEvent)
+	{
+		inputEvent.SetType((InputEvent::Type)reader->ReadInt());
+		inputEvent.SetKey((InputKey::Code)reader->ReadInt());
+		inputEvent.SetChar(reader->ReadUInt());
+		inputEvent.SetDeviceIndex(reader->ReadInt());
+		inputEvent.SetMouseButton((InputMouseButton::Code)reader->ReadInt());
+		inputEvent.SetAbsMousePos(reader->ReadFloat2());
+		inputEvent.SetNormMousePos(reader->ReadFloat2());
+		uint numPointers = reader->ReadUInt();
+		uint i;
+		for (i = 0; i < numPointers; i++)
+		{
+			IndexT id = reader->ReadInt();
+			Math::float2 absPos = reader->ReadFloat2();
+			Math::float2 normPos = reader->ReadFloat2();
+#if __ANDROID__ || __OSX__
+			inputEvent.SetPointerId(id);
+			inputEvent.SetAbsTouchPos(absPos, id);
+			inputEvent.SetNormTouchPos(normPos, id);
+#endif
+		}
+	}
+}
@@ -0,0 +1,109 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __inputrecorder_H__
+#define __inputrecorder_H__
+
+#include "core/refcounted.h"
+#include "input/inputevent.h"
+#include "io/stream.h"
+#include "io/binarywriter.h"
+#include "io/binaryreader.h"
+
+//------------------------------------------------------------------------------
+namespace Input
+{
+	/**
+		Writes every input event which goes through the InputServer into a
+		stream, tagged with the input frame it arrived in. Attach with
+		InputServerBase::SetInputRecorder(), the recorded stream can be played
+		back with an InputReplaySource to reproduce a frame sequence exactly.
+
+		Events the input server generates itself (Reset, capture changes) are
+		not recorded, they are generated again during the replay.
+	*/
+	class InputRecorder : public Core::RefCounted
+	{
+		__DeclareClass(InputRecorder);
+	public:
+		/// file magic of a recording
+		static const uint FourCC = 'GINR';
+		/// version of the recording format
+		static const uint Version = 1;
+
+		/// constructor
+		InputRecorder();
+		/// destructor
+		virtual ~InputRecorder();
+
+		/// set the stream to record into
+		void SetStream(const GPtr<IO::Stream>& s);
+		/// open the recorder, writes the header
+		bool Open();
+		/// close the recorder, flushes the pending frame
+		void Close();
+		/// return true if open
+		bool IsOpen() const;
+
+		/// called by the input server at the beginning of an input frame
+		void BeginFrame();
+		/// called by the input server for every event put into the handler chain
+		void Record(const InputEvent& inputEvent);
+		/// get the current input frame index
+		IndexT GetFrameIndex() const;
+
+		/// return true if an event should be recorded / replayed
+		static bool IsRecordable(const InputEvent& inputEvent);
+		/// write a single event
+		static void WriteEvent(const GPtr<IO::BinaryWriter>& writer, const InputEvent& inputEvent);
+		/// read a single event
+		static void ReadEvent(const GPtr<IO::BinaryReader>& reader, InputEvent& inputEvent);
+
+	protected:
+		/// write the events of the current frame
+		void FlushFrame();
+
+		GPtr<IO::Stream> mStream;
+		GPtr<IO::BinaryWriter> mWriter;
+		Util::Array<InputEvent> mFrameEvents;
+		IndexT mFrameIndex;
+	};
+
+	//------------------------------------------------------------------------
+	inline
+	bool
+	InputRecorder::IsOpen() const
+	{
+		return mWriter.isvalid();
+	}
+
+	//------------------------------------------------------------------------
+	inline
+	IndexT
+	InputRecorder::GetFrameIndex() const
+	{
+		return mFrameIndex;
+	}
+}
+//------------------------------------------------------------------------------
+#endif // __inputrecorder_H__
@@ -0,0 +1,140 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "input/input_stdneb.h"
+#include "input/inputreplaysource.h"
+#include "input/inputrecorder.h"
+#include "input/base/inputserverbase.h"
+#include "io/ioserver.h"
+#include "io/assignregistry.h"
+
+namespace Input
+{
+	__ImplementClass(Input::InputReplaySource, 'INRP', Input::InputSource);
+
+	//------------------------------------------------------------------------
+	InputReplaySource::InputReplaySource()
+		: mFrameIndex(0)
+		, mNextFrameIndex(InvalidIndex)
+		, mNextFrameEventCount(0)
+	{
+
+	}
+	//------------------------------------------------------------------------
+	InputReplaySource::~InputReplaySource()
+	{
+
+	}
+	//------------------------------------------------------------------------
+	void InputReplaySource::SetURI(const IO::URI& uri)
+	{
+		n_assert( !mIsOpen );
+		mURI = uri;
+	}
+	//------------------------------------------------------------------------
+	void InputReplaySource::Open(const GPtr<InputServerBase>& inputServer )
+	{
+		InputSource::Open(inputServer);
+		n_assert( !mURI.IsEmpty() );
+
+		mFrameIndex = 0;
+		mNextFrameIndex = InvalidIndex;
+		mReader = IO::BinaryReader::Create();
+		// the uri usually comes from the command line, before the assigns exist
+		mReader->SetStream(IO::IoServer::Instance()->CreateFileStream(IO::AssignRegistry::Instance()->ResolveAssigns(mURI)));
+		mReader->SetBufferedReadEnabled(true);
+		if (!mReader->Open())
+		{
+			n_warning("InputReplaySource::Open(): can not open '%s'!\n", mURI.AsString().AsCharPtr());
+			mReader = NULL;
+			return;
+		}
+		if (mReader->ReadUInt() != InputRecorder::FourCC || mReader->ReadUInt() != InputRecorder::Version)
+		{
+			n_warning("InputReplaySource::Open(): '%s' is not a valid input recording!\n", mURI.AsString().AsCharPtr());
+			mReader->Close();
+			mReader = NULL;
+			return;
+		}
+		ReadFrameHeader();
+	}
+	//------------------------------------------------------------------------
+	void InputReplaySource::Close()
+	{
+		if (mReader.isvalid())
+		{
+			mReader->Close();
+			mReader = NULL;
+		}
+		InputSource::Close();
+	}
+	//------------------------------------------------------------------------
+	void InputReplaySource::ReadFrameHeader()
+	{
+		if (mReader->Eof())
+		{
+			mNextFrameIndex = InvalidIndex;
+			mNextFrameEventCount = 0;
+			return;
+		}
+		uint header[2];
+		if (mReader->ReadRawData(header, sizeof(header)) < (SizeT)sizeof(header))
+		{
+			// a recording cut off while it was written
+			n_warning("InputReplaySource: %s ends inside a frame header\n", mURI.AsString().AsCharPtr());
+			mNextFrameIndex = InvalidIndex;
+			mNextFrameEventCount = 0;
+			return;
+		}
+		mNextFrameIndex = header[0];
+		mNextFrameEventCount = header[1];
+	}
+	//------------------------------------------------------------------------
+	/**
+		Events recorded before the first input frame are put together with
+		the events of the first frame.
+	*/
+	void InputReplaySource::BeginFrame()
+	{
+		n_assert( mIsOpen );
+		mFrameIndex++;
+
+		while (!IsFinished() && mNextFrameIndex <= mFrameIndex)
+		{
+			IndexT i;
+			for (i = 0; i < mNextFrameEventCount; i++)
+			{
+				if (mReader->Eof())
+				{
+					n_warning("InputReplaySource: %s ends inside frame %d\n", mURI.AsString().AsCharPtr(), mNextFrameIndex);
+					mNextFrameIndex = InvalidIndex;
+					return;
+				}
+				InputEvent inputEvent;
+				InputRecorder::ReadEvent(mReader, inputEvent);
+				mInputServer->PutEvent(inputEvent);
+			}
+			ReadFrameHeader();
+		}
+	}
+}
@@ -0,0 +1,82 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __inputreplaysource_H__
+#define __inputreplaysource_H__
+
+#include "input/inputsource.h"
+#include "io/stream.h"
+#include "io/uri.h"
+#include "io/binaryreader.h"
+
+//------------------------------------------------------------------------------
+namespace Input
+{
+	/**
+		Plays back a recording written by an InputRecorder. Every input frame
+		the recorded events of that frame are put into the input server, so
+		together with a fixed frame time a recorded session reproduces exactly.
+	*/
+	class InputReplaySource : public InputSource
+	{
+		__DeclareClass(InputReplaySource);
+	public:
+		/// constructor
+		InputReplaySource();
+		/// destructor
+		virtual ~InputReplaySource();
+
+		/// set the file holding the recording
+		void SetURI(const IO::URI& uri);
+
+		/// called when the input server Open
+		virtual void Open(const GPtr<InputServerBase>& inputServer );
+		/// called whem the input server Close
+		virtual void Close(void);
+		/// put the recorded events of the current frame
+		virtual void BeginFrame(void);
+
+		/// return true if all recorded events have been replayed
+		bool IsFinished() const;
+
+	protected:
+		/// read the header of the next recorded frame
+		void ReadFrameHeader();
+
+		IO::URI mURI;
+		GPtr<IO::BinaryReader> mReader;
+		IndexT mFrameIndex;
+		IndexT mNextFrameIndex;
+		SizeT mNextFrameEventCount;
+	};
+
+	//------------------------------------------------------------------------
+	inline
+	bool
+	InputReplaySource::IsFinished() const
+	{
+		return InvalidIndex == mNextFrameIndex;
+	}
+}
+//------------------------------------------------------------------------------
+#endif // __inputreplaysource_H__
@@ -50,6 +50,8 @@ private:
 	Util::String m_shaderType;
 	Util::String m_renderAPI;
 	Graphic::ShaderParamList m_paramList; 
+
+	friend class GenesisShaderCache;
 };
 
 typedef Util::Array<GenesisMakeGPUProgram> GenesisGPUProgramList;
@@ -204,6 +204,16 @@ namespace GenesisMaterialMaker
 
 	}
 
+	void GenesisMakeMaterial::DestroyMatParams()
+	{
+		for (SizeT i = 0; i < m_matParamList.Size(); ++i)
+		{
+			delete m_matParamList[i];
+		}
+		m_matParamList.Clear();
+		m_SampleTypeMap.Clear();
+	}
+
 	void GenesisMakeMaterial::_SetTextureSamplers()
 	{
 		for(SizeT i = 0; i < m_TechniqueList.Size(); ++i)
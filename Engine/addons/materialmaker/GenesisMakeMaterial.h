@@ -43,12 +43,16 @@ THE SOFTWARE.
 		 void AssignDefaultMatParamBindings();
 		 void _SetTextureSamplers();
 		 void AddTextureSampler(const Util::String& name, RenderBase::TextureAddressMode tam = RenderBase::eTAMWRAP, RenderBase::TextureFilter tfo = RenderBase::eTFPOINT);
+		 /// delete the params of a description which never became a material (MakeMaterial hands them over otherwise)
+		 void DestroyMatParams();
 	 private:
 		 Util::Array<GenesisMakeTechnique> m_TechniqueList;
 		 Graphic::MaterialParamList m_matParamList;
 		 Graphic::RenderQueue m_renderQueue;
 		 GenesisTextureSamplerStateList m_TexSamplerStateList;
 		 Util::Dictionary<Util::String, Graphic::MaterialParameterType> m_SampleTypeMap;
+
+		 friend class GenesisShaderCache;
 	 };
 
 	 inline void GenesisMakeMaterial::AddTechnique(const GenesisMakeTechnique& tech)
@@ -62,6 +62,8 @@ namespace GenesisMaterialMaker
 		GPtr<RenderBase::RenderStateDesc> m_RenderObjectState;
 
 		bool m_bGles;
+
+		friend class GenesisShaderCache;
 	};
 
 	inline void GenesisMakePass::SetName(const Util::String& name)
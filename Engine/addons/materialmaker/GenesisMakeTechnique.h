@@ -46,6 +46,8 @@ namespace GenesisMaterialMaker
 		GenesisPassList m_matPassList;
 		Util::String m_techName;
 		bool m_bMatTemplate;
+
+		friend class GenesisShaderCache;
 	};
 
 	inline void GenesisMakeTechnique::AddPass(const GenesisMakePass& pass)
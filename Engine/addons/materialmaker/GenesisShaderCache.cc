@@ -0,0 +1,682 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "stdneb.h"
+#include "GenesisShaderCache.h"
+#include "io/binarywriter.h"
+#include "io/binaryreader.h"
+#include "io/ioserver.h"
+#include "io/iointerfaceprotocol.h"
+#include "io/iointerface.h"
+#include "util/crc.h"
+#include "util/fourcc.h"
+#include "rendersystem/config/RenderDeviceConfig.h"
+
+namespace GenesisMaterialMaker
+{
+	// the compiled shader code depends on the device the shader compiler was built for
+#if RENDERDEVICE_D3D9
+	static const Util::FourCC sDeviceTag('D3D9');
+#elif RENDERDEVICE_OPENGLES
+	static const Util::FourCC sDeviceTag('GLES');
+#else
+	static const Util::FourCC sDeviceTag('NULL');
+#endif
+	static const Util::FourCC sFileMagic('GSHC');
+	// magic, version, device, key, payload size, payload crc
+	static const SizeT sHeaderSize = 6 * sizeof(uint);
+
+	bool GenesisShaderCache::s_enabled = true;
+#ifdef __GENESIS_EDITOR__
+	bool GenesisShaderCache::s_writeBack = true;
+#else
+	bool GenesisShaderCache::s_writeBack = false;
+#endif
+	Util::Dictionary<uint, GPtr<IO::MemoryStream> > GenesisShaderCache::s_entries;
+	GenesisShaderCacheStats GenesisShaderCache::s_stats = { 0, 0, 0, 0, 0 };
+	uint GenesisShaderCache::s_includeCrc = 0;
+	bool GenesisShaderCache::s_includeCrcValid = false;
+
+	// read by the CG and GLES shader compilers ahead of every shader, see GLESCompiler and CGTool
+	const char* GenesisShaderCache::IncludeFiles[] = { "sys:common.wjh", NULL };
+
+	//------------------------------------------------------------------------
+	static uint _ComputeCrc(const void* data, SizeT size)
+	{
+		Util::Crc crc;
+		crc.Begin();
+		if (size > 0)
+		{
+			crc.Compute((unsigned char*)data, size);
+		}
+		crc.End();
+		return crc.GetResult();
+	}
+	//------------------------------------------------------------------------
+	void GenesisShaderCache::SetEnabled(bool b)
+	{
+		s_enabled = b;
+	}
+	//------------------------------------------------------------------------
+	bool GenesisShaderCache::IsEnabled()
+	{
+		return s_enabled;
+	}
+	//------------------------------------------------------------------------
+	void GenesisShaderCache::SetWriteBackEnabled(bool b)
+	{
+		s_writeBack = b;
+	}
+	//------------------------------------------------------------------------
+	bool GenesisShaderCache::IsWriteBackEnabled()
+	{
+		return s_writeBack;
+	}
+	//------------------------------------------------------------------------
+	uint GenesisShaderCache::ComputeKey(const void* data, SizeT size)
+	{
+		uint tail[3] = { Version, sDeviceTag.AsUInt(), includeCrc() };
+		Util::Crc crc;
+		crc.Begin();
+		if (size > 0)
+		{
+			crc.Compute((unsigned char*)data, size);
+		}
+		crc.Compute((unsigned char*)tail, sizeof(tail));
+		crc.End();
+		return crc.GetResult();
+	}
+	//------------------------------------------------------------------------
+	Util::String GenesisShaderCache::GetCachePath(uint key)
+	{
+		Util::String path;
+		path.Format("cmpileshd:cache/%08x.gsc", key);
+		return path;
+	}
+	//------------------------------------------------------------------------
+	const GenesisShaderCacheStats& GenesisShaderCache::GetStats()
+	{
+		return s_stats;
+	}
+	//------------------------------------------------------------------------
+	void GenesisShaderCache::ResetStats()
+	{
+		Memory::Clear(&s_stats, sizeof(s_stats));
+	}
+	//------------------------------------------------------------------------
+	void GenesisShaderCache::Clear()
+	{
+		s_entries.Clear();
+		s_includeCrcValid = false;
+	}
+	//------------------------------------------------------------------------
+	uint GenesisShaderCache::includeCrc()
+	{
+		if (!s_includeCrcValid)
+		{
+			Util::Crc crc;
+			crc.Begin();
+			for (IndexT i = 0; NULL != IncludeFiles[i]; ++i)
+			{
+				// a missing file hashes as empty, which still differs from any content
+				GPtr<IO::MemoryStream> stream = readFile(Util::StringAtom(IncludeFiles[i]));
+				uint size = stream.isvalid() ? (uint)stream->GetSize() : 0;
+				crc.Compute((unsigned char*)&size, sizeof(size));
+				if (size > 0)
+				{
+					crc.Compute((unsigned char*)stream->GetRawPointer(), size);
+				}
+			}
+			crc.End();
+			s_includeCrc = crc.GetResult();
+			s_includeCrcValid = true;
+		}
+		return s_includeCrc;
+	}
+	//------------------------------------------------------------------------
+	GenesisMaterial* GenesisShaderCache::Load(uint key)
+	{
+		IndexT found = s_entries.FindIndex(key);
+		if (InvalidIndex != found)
+		{
+			GenesisMaterial* mat = readEntry(s_entries.ValueAtIndex(found), key);
+			if (mat)
+			{
+				++s_stats.memoryHits;
+				return mat;
+			}
+			s_entries.EraseAtIndex(found);
+		}
+
+		GPtr<IO::MemoryStream> stream = readFile(key);
+		if (stream.isvalid())
+		{
+			GenesisMaterial* mat = readEntry(stream, key);
+			if (mat)
+			{
+				s_entries.Add(key, stream);
+				++s_stats.diskHits;
+				return mat;
+			}
+		}
+		++s_stats.misses;
+		return NULL;
+	}
+	//------------------------------------------------------------------------
+	bool GenesisShaderCache::Store(uint key, const GenesisMaterial& mat, bool writeToDisk)
+	{
+		// don't keep descriptions which would end in the fallback material anyway
+		const Util::Array<GenesisMakeTechnique>& techs = mat.m_material.m_TechniqueList;
+		if (techs.IsEmpty())
+		{
+			return false;
+		}
+		for (IndexT i = 0; i < techs.Size(); ++i)
+		{
+			if (techs[i].m_matPassList.IsEmpty())
+			{
+				return false;
+			}
+		}
+
+		// the payload goes first so its crc can be put in the header
+		GPtr<IO::MemoryStream> payload = IO::MemoryStream::Create();
+		GPtr<IO::BinaryWriter> writer = IO::BinaryWriter::Create();
+		writer->SetStream(payload.upcast<IO::Stream>());
+		writer->SetStreamByteOrder(System::ByteOrder::LittleEndian);
+		if (!writer->Open())
+		{
+			return false;
+		}
+		Write(writer, mat);
+		writer->Close();
+
+		GPtr<IO::MemoryStream> stream = IO::MemoryStream::Create();
+		writer->SetStream(stream.upcast<IO::Stream>());
+		if (!writer->Open())
+		{
+			return false;
+		}
+		const SizeT payloadSize = payload->GetSize();
+		writer->WriteUInt(sFileMagic.AsUInt());
+		writer->WriteUInt(Version);
+		writer->WriteUInt(sDeviceTag.AsUInt());
+		writer->WriteUInt(key);
+		writer->WriteUInt(payloadSize);
+		writer->WriteUInt(_ComputeCrc(payloadSize > 0 ? payload->GetRawPointer() : NULL, payloadSize));
+		writer->WriteRawData(payload->GetRawPointer(), payloadSize);
+		writer->Close();
+
+		if (s_entries.Contains(key))
+		{
+			s_entries[key] = stream;
+		}
+		else
+		{
+			s_entries.Add(key, stream);
+		}
+		++s_stats.stores;
+
+		if (writeToDisk || s_writeBack)
+		{
+			return writeFile(key, stream);
+		}
+		return true;
+	}
+	//------------------------------------------------------------------------
+	GenesisMaterial* GenesisShaderCache::readEntry(const GPtr<IO::MemoryStream>& stream, uint key)
+	{
+		if (stream->GetSize() < sHeaderSize)
+		{
+			++s_stats.rejected;
+			return NULL;
+		}
+
+		GPtr<IO::BinaryReader> reader = IO::BinaryReader::Create();
+		reader->SetStream(stream.upcast<IO::Stream>());
+		reader->SetStreamByteOrder(System::ByteOrder::LittleEndian);
+		if (!reader->Open())
+		{
+			return NULL;
+		}
+
+		const uint magic = reader->ReadUInt();
+		const uint version = reader->ReadUInt();
+		const uint device = reader->ReadUInt();
+		const uint entryKey = reader->ReadUInt();
+		const uint payloadSize = reader->ReadUInt();
+		const uint payloadCrc = reader->ReadUInt();
+		const unsigned char* payload = (const unsigned char*)stream->GetRawPointer() + sHeaderSize;
+
+		if (magic != sFileMagic.AsUInt() || version != Version || device != sDeviceTag.AsUInt() || entryKey != key
+			|| payloadSize != (uint)(stream->GetSize() - sHeaderSize) || payloadCrc != _ComputeCrc(payload, payloadSize))
+		{
+			reader->Close();
+			++s_stats.rejected;
+			return NULL;
+		}
+
+		GenesisMaterial* mat = new GenesisMaterial();
+		Read(reader, *mat);
+		reader->Close();
+		return mat;
+	}
+	//------------------------------------------------------------------------
+	bool GenesisShaderCache::writeFile(uint key, const GPtr<IO::MemoryStream>& stream)
+	{
+		IO::URI uri(GetCachePath(key));
+		IO::IoServer* ioServer = IO::IoServer::Instance();
+		if (!ioServer->CreateDirectory(uri.AsString().ExtractDirName()))
+		{
+			n_warning("GenesisShaderCache: can't create directory: %s", uri.AsString().ExtractDirName().AsCharPtr());
+			return false;
+		}
+
+		GPtr<IO::Stream> file = ioServer->CreateFileStream(uri);
+		file->SetAccessMode(IO::Stream::WriteAccess);
+		if (!file->Open())
+		{
+			n_warning("GenesisShaderCache: can't write %s", uri.AsString().AsCharPtr());
+			return false;
+		}
+		file->Write(stream->GetRawPointer(), stream->GetSize());
+		file->Close();
+		return true;
+	}
+	//------------------------------------------------------------------------
+	GPtr<IO::MemoryStream> GenesisShaderCache::readFile(uint key)
+	{
+		return readFile(Util::StringAtom(GetCachePath(key)));
+	}
+	//------------------------------------------------------------------------
+	GPtr<IO::MemoryStream> GenesisShaderCache::readFile(const Util::StringAtom& path)
+	{
+		if (!IO::IoServer::Instance()->FileExists(path))
+		{
+			return GPtr<IO::MemoryStream>();
+		}
+
+		GPtr<IO::MemoryStream> stream = IO::MemoryStream::Create();
+		GPtr<IO::ReadStream> readStreamMsg = IO::ReadStream::Create();
+		readStreamMsg->SetFileName(path);
+		readStreamMsg->SetStream(stream.upcast<IO::Stream>());
+		IO::IoInterface::Instance()->SendWait(readStreamMsg.upcast<Messaging::Message>());
+		if (!readStreamMsg->GetResult())
+		{
+			return GPtr<IO::MemoryStream>();
+		}
+		return stream;
+	}
+	//------------------------------------------------------------------------
+	void GenesisShaderCache::Write(IO::BinaryWriter* writer, const GenesisMaterial& mat)
+	{
+		writer->WriteString(mat.m_name);
+		writer->WriteString(mat.m_GPUProgrampath);
+		writeMaterial(writer, mat.m_material);
+	}
+	//------------------------------------------------------------------------
+	void GenesisShaderCache::Read(IO::BinaryReader* reader, GenesisMaterial& mat)
+	{
+		mat.m_name = reader->ReadString();
+		mat.m_GPUProgrampath = reader->ReadString();
+		readMaterial(reader, mat.m_material);
+	}
+	//------------------------------------------------------------------------
+	void GenesisShaderCache::writeMaterial(IO::BinaryWriter* writer, const GenesisMakeMaterial& mat)
+	{
+		writer->WriteInt(mat.m_renderQueue.GetQueueType());
+		writer->WriteShort(mat.m_renderQueue.GetSort());
+
+		writer->WriteInt(mat.m_matParamList.Size());
+		for (IndexT i = 0; i < mat.m_matParamList.Size(); ++i)
+		{
+			const Graphic::MaterialParam* param = mat.m_matParamList[i];
+			writer->WriteInt(param->GetType());
+			writer->WriteString(param->GetName());
+			writer->WriteString(param->GetDesc());
+			writer->WriteString(param->GetStringValue());
+		}
+
+		writer->WriteInt(mat.m_TexSamplerStateList.Size());
+		for (IndexT i = 0; i < mat.m_TexSamplerStateList.Size(); ++i)
+		{
+			const GenesisTextureSamplerState& tss = mat.m_TexSamplerStateList[i];
+			writer->WriteString(tss.m_name);
+			writer->WriteString(tss.m_textureType);
+			writer->WriteInt(tss.m_tam);
+			writer->WriteInt(tss.m_tfo);
+		}
+
+		writer->WriteInt(mat.m_TechniqueList.Size());
+		for (IndexT i = 0; i < mat.m_TechniqueList.Size(); ++i)
+		{
+			writeTechnique(writer, mat.m_TechniqueList[i]);
+		}
+	}
+	//------------------------------------------------------------------------
+	void GenesisShaderCache::readMaterial(IO::BinaryReader* reader, GenesisMakeMaterial& mat)
+	{
+		Graphic::RenderQueue::QueueType queueType = (Graphic::RenderQueue::QueueType)reader->ReadInt();
+		int16 sort = reader->ReadShort();
+		mat.m_renderQueue.SetQueue(queueType, sort);
+
+		SizeT numParams = reader->ReadInt();
+		for (IndexT i = 0; i < numParams; ++i)
+		{
+			Graphic::MaterialParameterType type = (Graphic::MaterialParameterType)reader->ReadInt();
+			Graphic::MaterialParam* param = NULL;
+			switch (type)
+			{
+			case Graphic::eMaterialParamMatrix:
+				param = new Graphic::MaterialParamMatrix();
+				break;
+			case Graphic::eMaterialParamVector:
+				param = new Graphic::MaterialParamVector();
+				break;
+			case Graphic::eMaterialParamFloat:
+				param = new Graphic::MaterialParamFloat();
+				break;
+			case Graphic::eMaterialParamTexture1D:
+				param = new Graphic::MaterialParamTex1D();
+				break;
+			case Graphic::eMaterialParamTexture2D:
+				param = new Graphic::MaterialParamTex2D();
+				break;
+			case Graphic::eMaterialParamTexture3D:
+				param = new Graphic::MaterialParamTex3D();
+				break;
+			case Graphic::eMaterialParamTextureCUBE:
+				param = new Graphic::MaterialParamTexCube();
+				break;
+			default:
+				n_error("GenesisShaderCache: unknown material param type %d!", type);
+				break;
+			}
+			param->SetName(reader->ReadString());
+			param->SetDesc(reader->ReadString());
+			param->SetStringValue(reader->ReadString());
+			mat.AddMatParam(param);
+		}
+
+		SizeT numSamplers = reader->ReadInt();
+		mat.m_TexSamplerStateList.Reserve(numSamplers);
+		for (IndexT i = 0; i < numSamplers; ++i)
+		{
+			GenesisTextureSamplerState tss;
+			tss.m_name = reader->ReadString();
+			tss.m_textureType = reader->ReadString();
+			tss.m_tam = (RenderBase::TextureAddressMode)reader->ReadInt();
+			tss.m_tfo = (RenderBase::TextureFilter)reader->ReadInt();
+			mat.m_TexSamplerStateList.Append(tss);
+		}
+
+		SizeT numTechs = reader->ReadInt();
+		mat.m_TechniqueList.Reserve(numTechs);
+		for (IndexT i = 0; i < numTechs; ++i)
+		{
+			mat.m_TechniqueList.Append(GenesisMakeTechnique());
+			readTechnique(reader, mat.m_TechniqueList.Back());
+		}
+	}
+	//------------------------------------------------------------------------
+	void GenesisShaderCache::writeTechnique(IO::BinaryWriter* writer, const GenesisMakeTechnique& tech)
+	{
+		writer->WriteString(tech.m_techName);
+		writer->WriteBool(tech.m_bMatTemplate);
+		writer->WriteInt(tech.m_matPassList.Size());
+		for (IndexT i = 0; i < tech.m_matPassList.Size(); ++i)
+		{
+			writePass(writer, tech.m_matPassList[i]);
+		}
+	}
+	//------------------------------------------------------------------------
+	void GenesisShaderCache::readTechnique(IO::BinaryReader* reader, GenesisMakeTechnique& tech)
+	{
+		tech.m_techName = reader->ReadString();
+		tech.m_bMatTemplate = reader->ReadBool();
+		SizeT numPasses = reader->ReadInt();
+		tech.m_matPassList.Reserve(numPasses);
+		for (IndexT i = 0; i < numPasses; ++i)
+		{
+			tech.m_matPassList.Append(GenesisMakePass());
+			readPass(reader, tech.m_matPassList.Back());
+		}
+	}
+	//------------------------------------------------------------------------
+	void GenesisShaderCache::writePass(IO::BinaryWriter* writer, const GenesisMakePass& pass)
+	{
+		writer->WriteString(pass.m_name);
+		writer->WriteBool(pass.m_RenderObjectState.isvalid());
+		if (pass.m_RenderObjectState.isvalid())
+		{
+			writeRenderState(writer, *pass.m_RenderObjectState);
+		}
+		writer->WriteInt(pass.m_ShaderProgramList.Size());
+		for (IndexT i = 0; i < pass.m_ShaderProgramList.Size(); ++i)
+		{
+			writeProgram(writer, pass.m_ShaderProgramList[i]);
+		}
+	}
+	//------------------------------------------------------------------------
+	void GenesisShaderCache::readPass(IO::BinaryReader* reader, GenesisMakePass& pass)
+	{
+		pass.m_name = reader->ReadString();
+		if (reader->ReadBool())
+		{
+			GPtr<RenderBase::RenderStateDesc> state = RenderBase::RenderStateDesc::Create();
+			state->Setup();
+			readRenderState(reader, *state);
+			pass.m_RenderObjectState = state;
+		}
+		SizeT numPrograms = reader->ReadInt();
+		pass.m_ShaderProgramList.Reserve(numPrograms);
+		for (IndexT i = 0; i < numPrograms; ++i)
+		{
+			pass.m_ShaderProgramList.Append(GenesisMakeGPUProgram());
+			readProgram(reader, pass.m_ShaderProgramList.Back());
+		}
+	}
+	//------------------------------------------------------------------------
+	void GenesisShaderCache::writeProgram(IO::BinaryWriter* writer, const GenesisMakeGPUProgram& program)
+	{
+		writer->WriteString(program.m_codeStr);
+		writer->WriteString(program.m_shaderType);
+		writer->WriteString(program.m_renderAPI);
+		writer->WriteInt(program.m_paramList.Size());
+		for (IndexT i = 0; i < program.m_paramList.Size(); ++i)
+		{
+			const Graphic::ShaderParam& param = program.m_paramList[i];
+			writer->WriteInt(param.GetParamType());
+			writer->WriteInt(param.GetRegister());
+			writer->WriteString(param.GetName());
+		}
+	}
+	//------------------------------------------------------------------------
+	void GenesisShaderCache::readProgram(IO::BinaryReader* reader, GenesisMakeGPUProgram& program)
+	{
+		program.m_codeStr = reader->ReadString();
+		program.m_shaderType = reader->ReadString();
+		program.m_renderAPI = reader->ReadString();
+		SizeT numParams = reader->ReadInt();
+		program.m_paramList.Reserve(numParams);
+		for (IndexT i = 0; i < numParams; ++i)
+		{
+			Graphic::ShaderParam param;
+			param.SetParamType((Graphic::ShaderParamType)reader->ReadInt());
+			param.SetRegister(reader->ReadInt());
+			param.SetName(reader->ReadString());
+			program.m_paramList.Append(param);
+		}
+	}
+	//------------------------------------------------------------------------
+	template<typename T>
+	static void _WriteEnumArray(IO::BinaryWriter* writer, const Util::Array<T>& values)
+	{
+		writer->WriteInt(values.Size());
+		for (IndexT i = 0; i < values.Size(); ++i)
+		{
+			writer->WriteInt((int)values[i]);
+		}
+	}
+	//------------------------------------------------------------------------
+	template<typename T>
+	static void _ReadEnumArray(IO::BinaryReader* reader, Util::Array<T>& values)
+	{
+		SizeT count = reader->ReadInt();
+		values.Clear();
+		values.Reserve(count);
+		for (IndexT i = 0; i < count; ++i)
+		{
+			values.Append((T)reader->ReadInt());
+		}
+	}
+	//------------------------------------------------------------------------
+	void GenesisShaderCache::writeRenderState(IO::BinaryWriter* writer, const RenderBase::RenderStateDesc& state)
+	{
+		writer->WriteUInt(state.GetUpdateFlag());
+
+		const RenderBase::DeviceRasterizerState& rs = state.GetRasterizerState();
+		writer->WriteInt(rs.m_fillMode);
+		writer->WriteInt(rs.m_cullMode);
+		writer->WriteFloat(rs.m_slopScaleDepthBias);
+		writer->WriteFloat(rs.m_depthBias);
+		writer->WriteBool(rs.m_scissorTestEnable);
+		writer->WriteBool(rs.m_multisampleEnable);
+
+		const RenderBase::DeviceDepthAndStencilState& ds = state.GetDepthAndStencilState();
+		writer->WriteBool(ds.m_depthEnable);
+		writer->WriteBool(ds.m_depthWriteMask);
+		writer->WriteInt(ds.m_zFunc);
+		writer->WriteInt(ds.m_stencilRef);
+		writer->WriteBool(ds.m_stencilEnable);
+		writer->WriteInt(ds.m_stencilFunc);
+		writer->WriteUShort(ds.m_stencilReadMask);
+		writer->WriteUShort(ds.m_stencilWriteMask);
+		writer->WriteInt(ds.m_stencilFail);
+		writer->WriteInt(ds.m_stencilZFail);
+		writer->WriteInt(ds.m_stencilPass);
+		writer->WriteBool(ds.m_stencilTwoEnable);
+		writer->WriteInt(ds.m_StencilTwoFunc);
+		writer->WriteUShort(ds.m_stencilTwoReadMask);
+		writer->WriteUShort(ds.m_stencilTwoWriteMask);
+		writer->WriteInt(ds.m_stencilTwoFail);
+		writer->WriteInt(ds.m_stencilTwoZFail);
+		writer->WriteInt(ds.m_stencilTwoPass);
+
+		const RenderBase::DeviceBlendState& bs = state.GetBlendState();
+		writer->WriteBool(bs.m_alphaTestEnable);
+		writer->WriteBool(bs.m_separateAlphaBlendEnable);
+		writer->WriteInt(bs.m_alphaFunc);
+		writer->WriteFloat(bs.m_alphaRef);
+		_WriteEnumArray(writer, bs.m_alphaBlendEnable);
+		_WriteEnumArray(writer, bs.m_blendOP);
+		_WriteEnumArray(writer, bs.m_srcBlend);
+		_WriteEnumArray(writer, bs.m_destBlend);
+		_WriteEnumArray(writer, bs.m_blendOPAlpha);
+		_WriteEnumArray(writer, bs.m_srcBlendAlpha);
+		_WriteEnumArray(writer, bs.m_destBlendAlpha);
+		_WriteEnumArray(writer, bs.m_colorWriteMask);
+
+		const RenderBase::DeviceSamplerState& ss = state.GetSamplerState();
+		_WriteEnumArray(writer, ss.m_textureIndexEnable);
+		_WriteEnumArray(writer, ss.m_addressU);
+		_WriteEnumArray(writer, ss.m_addressV);
+		_WriteEnumArray(writer, ss.m_addressW);
+		_WriteEnumArray(writer, ss.m_Filter);
+		_WriteEnumArray(writer, ss.m_maxAnisotropy);
+		writer->WriteInt(ss.m_textureType.Size());
+		for (IndexT i = 0; i < ss.m_textureType.Size(); ++i)
+		{
+			writer->WriteString(ss.m_textureType[i]);
+		}
+	}
+	//------------------------------------------------------------------------
+	void GenesisShaderCache::readRenderState(IO::BinaryReader* reader, RenderBase::RenderStateDesc& state)
+	{
+		const uint updateFlag = reader->ReadUInt();
+
+		RenderBase::DeviceRasterizerState rs;
+		rs.m_fillMode = (RenderBase::FillMode)reader->ReadInt();
+		rs.m_cullMode = (RenderBase::CullMode)reader->ReadInt();
+		rs.m_slopScaleDepthBias = reader->ReadFloat();
+		rs.m_depthBias = reader->ReadFloat();
+		rs.m_scissorTestEnable = reader->ReadBool();
+		rs.m_multisampleEnable = reader->ReadBool();
+
+		RenderBase::DeviceDepthAndStencilState ds;
+		ds.m_depthEnable = reader->ReadBool();
+		ds.m_depthWriteMask = reader->ReadBool();
+		ds.m_zFunc = (RenderBase::CompareFunction)reader->ReadInt();
+		ds.m_stencilRef = reader->ReadInt();
+		ds.m_stencilEnable = reader->ReadBool();
+		ds.m_stencilFunc = (RenderBase::CompareFunction)reader->ReadInt();
+		ds.m_stencilReadMask = reader->ReadUShort();
+		ds.m_stencilWriteMask = reader->ReadUShort();
+		ds.m_stencilFail = (RenderBase::StencilOperation)reader->ReadInt();
+		ds.m_stencilZFail = (RenderBase::StencilOperation)reader->ReadInt();
+		ds.m_stencilPass = (RenderBase::StencilOperation)reader->ReadInt();
+		ds.m_stencilTwoEnable = reader->ReadBool();
+		ds.m_StencilTwoFunc = (RenderBase::CompareFunction)reader->ReadInt();
+		ds.m_stencilTwoReadMask = reader->ReadUShort();
+		ds.m_stencilTwoWriteMask = reader->ReadUShort();
+		ds.m_stencilTwoFail = (RenderBase::StencilOperation)reader->ReadInt();
+		ds.m_stencilTwoZFail = (RenderBase::StencilOperation)reader->ReadInt();
+		ds.m_stencilTwoPass = (RenderBase::StencilOperation)reader->ReadInt();
+
+		RenderBase::DeviceBlendState bs;
+		bs.m_alphaTestEnable = reader->ReadBool();
+		bs.m_separateAlphaBlendEnable = reader->ReadBool();
+		bs.m_alphaFunc = (RenderBase::CompareFunction)reader->ReadInt();
+		bs.m_alphaRef = reader->ReadFloat();
+		_ReadEnumArray(reader, bs.m_alphaBlendEnable);
+		_ReadEnumArray(reader, bs.m_blendOP);
+		_ReadEnumArray(reader, bs.m_srcBlend);
+		_ReadEnumArray(reader, bs.m_destBlend);
+		_ReadEnumArray(reader, bs.m_blendOPAlpha);
+		_ReadEnumArray(reader, bs.m_srcBlendAlpha);
+		_ReadEnumArray(reader, bs.m_destBlendAlpha);
+		_ReadEnumArray(reader, bs.m_colorWriteMask);
+
+		RenderBase::DeviceSamplerState ss;
+		_ReadEnumArray(reader, ss.m_textureIndexEnable);
+		_ReadEnumArray(reader, ss.m_addressU);
+		_ReadEnumArray(reader, ss.m_addressV);
+		_ReadEnumArray(reader, ss.m_addressW);
+		_ReadEnumArray(reader, ss.m_Filter);
+		_ReadEnumArray(reader, ss.m_maxAnisotropy);
+		SizeT numTypes = reader->ReadInt();
+		ss.m_textureType.Clear();
+		ss.m_textureType.Reserve(numTypes);
+		for (IndexT i = 0; i < numTypes; ++i)
+		{
+			ss.m_textureType.Append(reader->ReadString());
+		}
+
+		state.SetRasterizerState(rs);
+		state.SetDepthAndStencilState(ds);
+		state.SetBlendState(bs);
+		state.SetSamplerState(ss);
+		// the setters above raise their bits, restore what the parser had
+		state.SetUpdateFlag(updateFlag);
+	}
+}
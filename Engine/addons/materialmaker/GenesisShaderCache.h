@@ -0,0 +1,128 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#pragma once
+#ifndef GENESISSHADERCACHE_H_
+#define GENESISSHADERCACHE_H_
+#include "core/types.h"
+#include "util/dictionary.h"
+#include "io/memorystream.h"
+#include "GenesisMaterial.h"
+
+namespace IO
+{
+	class BinaryWriter;
+	class BinaryReader;
+}
+
+namespace GenesisMaterialMaker
+{
+	struct GenesisShaderCacheStats
+	{
+		SizeT memoryHits;
+		SizeT diskHits;
+		SizeT misses;
+		SizeT stores;
+		SizeT rejected;		// entries with a wrong version, device or checksum
+	};
+
+	/**
+		Binary form of the parsed .shader descriptions.
+
+		A .shader file is compiled by the ShaderFactory and the output is run through the bison parser
+		into a GenesisMaterial. The cache stores that GenesisMaterial in a versioned binary form, keyed by
+		a crc of the .shader source bytes, the format version and the render device, so a known shader
+		is rebuilt without the ShaderFactory and without the parser.
+
+		Entries are kept in memory for the session and live as "cmpileshd:cache/<key>.gsc" files on disk.
+		The disk files are written when write back is enabled (editor builds by default) or by CookShader,
+		and are only read on the render device they were written for.
+
+		The sys: files the shader compilers prepend to every shader (IncludeFiles) are hashed into the
+		key as well, once per session; Clear rereads them. Code generated by the compilers themselves is
+		not: bump Version when it changes.
+	*/
+	class GenesisShaderCache
+	{
+	public:
+		/// format version, bump when the layout or the shader compiler output changes
+		static const uint Version = 1;
+
+		/// enable or disable the cache, on by default
+		static void SetEnabled(bool b);
+		static bool IsEnabled();
+		/// write new entries to disk as well, on in editor builds by default
+		static void SetWriteBackEnabled(bool b);
+		static bool IsWriteBackEnabled();
+
+		/// the files every shader is compiled with, part of each key
+		static const char* IncludeFiles[];
+
+		/// compute the cache key of the .shader source bytes
+		static uint ComputeKey(const void* data, SizeT size);
+		/// the disk location of an entry
+		static Util::String GetCachePath(uint key);
+
+		/// return a new GenesisMaterial rebuilt from the cache, or NULL on a miss. the caller deletes it
+		static GenesisMaterial* Load(uint key);
+		/// store a parsed description, writeToDisk forces the disk file regardless of write back
+		static bool Store(uint key, const GenesisMaterial& mat, bool writeToDisk);
+		/// drop the memory entries and reread the include files
+		static void Clear();
+
+		static const GenesisShaderCacheStats& GetStats();
+		static void ResetStats();
+
+		/// serialize a parsed description
+		static void Write(IO::BinaryWriter* writer, const GenesisMaterial& mat);
+		/// deserialize a description into an empty GenesisMaterial
+		static void Read(IO::BinaryReader* reader, GenesisMaterial& mat);
+
+	private:
+		static GenesisMaterial* readEntry(const GPtr<IO::MemoryStream>& stream, uint key);
+		static bool writeFile(uint key, const GPtr<IO::MemoryStream>& stream);
+		static GPtr<IO::MemoryStream> readFile(uint key);
+		static GPtr<IO::MemoryStream> readFile(const Util::StringAtom& path);
+		/// crc of the contents of IncludeFiles, computed on first use
+		static uint includeCrc();
+
+		static void writeMaterial(IO::BinaryWriter* writer, const GenesisMakeMaterial& mat);
+		static void readMaterial(IO::BinaryReader* reader, GenesisMakeMaterial& mat);
+		static void writeTechnique(IO::BinaryWriter* writer, const GenesisMakeTechnique& tech);
+		static void readTechnique(IO::BinaryReader* reader, GenesisMakeTechnique& tech);
+		static void writePass(IO::BinaryWriter* writer, const GenesisMakePass& pass);
+		static void readPass(IO::BinaryReader* reader, GenesisMakePass& pass);
+		static void writeProgram(IO::BinaryWriter* writer, const GenesisMakeGPUProgram& program);
+		static void readProgram(IO::BinaryReader* reader, GenesisMakeGPUProgram& program);
+		static void writeRenderState(IO::BinaryWriter* writer, const RenderBase::RenderStateDesc& state);
+		static void readRenderState(IO::BinaryReader* reader, RenderBase::RenderStateDesc& state);
+
+		static bool s_enabled;
+		static bool s_writeBack;
+		static Util::Dictionary<uint, GPtr<IO::MemoryStream> > s_entries;
+		static GenesisShaderCacheStats s_stats;
+		static uint s_includeCrc;
+		static bool s_includeCrcValid;
+	};
+}
+#endif//GENESISSHADERCACHE_H_
@@ -24,6 +24,7 @@ THE SOFTWARE.
 #include "stdneb.h"
 #include "../GenesisMaterial.h"
 #include "GenesisShaderParser.h"
+#include "../GenesisShaderCache.h"
 #include "addons/shadercompiler/ShaderFactory.h"
 #include "foundation/io/ioserver.h"
 #include "foundation/io/textreader.h"
@@ -73,19 +74,43 @@ namespace GenesisMaterialMaker
 		
 	}
 
-GPtr<Graphic::Material> MakeFromShader(const char* text,SizeT size)
+GenesisMaterial* ParseShaderText(const char* text,SizeT size)
 {
 	GenesisMaterial* genesismat = new GenesisMaterial();
 	g_GenesisMaterial = genesismat;
 	InitLexer(text,size);
 	Genesisparse();
 	EndLexer();
-	GPtr<Graphic::Material> mat = genesismat->CreateRealMaterial();
 	g_GenesisMaterial = NULL;
+	return genesismat;
+}
+
+GPtr<Graphic::Material> MakeFromShader(const char* text,SizeT size)
+{
+	GenesisMaterial* genesismat = ParseShaderText(text,size);
+	GPtr<Graphic::Material> mat = genesismat->CreateRealMaterial();
 	delete genesismat;
 	return mat;
 }
 
+bool ReadShaderFile(const Util::StringAtom& shaderfile, GPtr<IO::MemoryStream>& stream)
+{
+	stream = IO::MemoryStream::Create();
+	n_assert( stream );
+	GPtr<IO::ReadStream> readStreamMsg = IO::ReadStream::Create();
+	n_assert( readStreamMsg );
+
+	readStreamMsg->SetFileName( shaderfile );
+	readStreamMsg->SetStream( stream.upcast<IO::Stream>() );
+	IO::IoInterface::Instance()->SendWait( readStreamMsg.upcast<Messaging::Message>() );
+	return readStreamMsg->GetResult();
+}
+
+uint ComputeShaderCacheKey(const GPtr<IO::MemoryStream>& stream)
+{
+	return GenesisShaderCache::ComputeKey(stream->GetSize() > 0 ? stream->GetRawPointer() : NULL, stream->GetSize());
+}
+
 void CreateDefaultFallBackMaterial()
 {
 	Util::StringAtom atom("sys:defaultFallBackShader.shader");
@@ -137,21 +162,26 @@ GPtr<Graphic::Material> MakeFromShader(const Util::StringAtom& shaderfile)
 #endif
 
 	// check the empty file
-	GPtr<IO::Stream> pStream = IO::MemoryStream::Create();
-	n_assert( pStream );
-	GPtr<IO::ReadStream> readStreamMsg = IO::ReadStream::Create();
-	n_assert( readStreamMsg );
-
-	readStreamMsg->SetFileName( shaderfile );
-	readStreamMsg->SetStream( pStream );
-	IO::IoInterface::Instance()->SendWait( readStreamMsg.upcast<Messaging::Message>() );
-
-	if ( !readStreamMsg->GetResult() )
+	GPtr<IO::MemoryStream> pStream;
+	if ( !ReadShaderFile(shaderfile, pStream) )
 	{
 		n_warning( "ShaderProcessor::ReadTextStream: can not open file: %s", shaderfile.Value() );
 		return Graphic::Material::s_defaultFallBackMat;
 	}
-	
+
+	// a known source skips the shader compiler and the parser
+	uint cacheKey = 0;
+	if (GenesisShaderCache::IsEnabled())
+	{
+		cacheKey = ComputeShaderCacheKey(pStream);
+		GenesisMaterial* cached = GenesisShaderCache::Load(cacheKey);
+		if (cached)
+		{
+			GPtr<Graphic::Material> mat = cached->CreateRealMaterial();
+			delete cached;
+			return VerifyGenesisShader(mat,shaderfile) ? mat : Graphic::Material::s_defaultFallBackMat;
+		}
+	}
 
 	Util::String text;
 	try
@@ -164,8 +194,72 @@ GPtr<Graphic::Material> MakeFromShader(const Util::StringAtom& shaderfile)
 		return Graphic::Material::s_defaultFallBackMat;
 	}
 
-	GPtr<Graphic::Material> mat = GenesisMaterialMaker::MakeFromShader(text.AsCharPtr(),text.Length());
+	GenesisMaterial* genesismat = ParseShaderText(text.AsCharPtr(),text.Length());
+	if (GenesisShaderCache::IsEnabled())
+	{
+		// stored before CreateRealMaterial, which hands the params over to the material
+		GenesisShaderCache::Store(cacheKey, *genesismat, false);
+	}
+	GPtr<Graphic::Material> mat = genesismat->CreateRealMaterial();
+	delete genesismat;
 
 	return VerifyGenesisShader(mat,shaderfile) ? mat : Graphic::Material::s_defaultFallBackMat;
 }
+
+bool CookShader(const Util::StringAtom& shaderfile)
+{
+	GPtr<IO::MemoryStream> pStream;
+	if ( !ReadShaderFile(shaderfile, pStream) )
+	{
+		n_warning( "CookShader: can not open file: %s", shaderfile.Value() );
+		return false;
+	}
+
+	Util::String text;
+	try
+	{
+		CompileShaderCode(shaderfile, text);
+	}
+	catch(const Exceptions::Exception& e)
+	{
+		n_warning( "Compile %s Error: %s!\n", shaderfile.AsString().AsCharPtr(), e.what() );
+		return false;
+	}
+
+	GenesisMaterial* genesismat = ParseShaderText(text.AsCharPtr(),text.Length());
+	bool stored = GenesisShaderCache::Store(ComputeShaderCacheKey(pStream), *genesismat, true);
+	if (!stored)
+	{
+		n_warning( "CookShader: %s has no valid technique, not cached", shaderfile.Value() );
+	}
+	// no material takes the params over here
+	genesismat->m_material.DestroyMatParams();
+	delete genesismat;
+	return stored;
+}
+
+SizeT CookShaders(const Util::String& dir)
+{
+	IO::IoServer* ioServer = IO::IoServer::Instance();
+	SizeT cooked = 0;
+
+	Util::Array<Util::String> files = ioServer->ListFiles(IO::URI(dir), "*.shader");
+	for (IndexT i = 0; i < files.Size(); ++i)
+	{
+		if (CookShader(Util::StringAtom(dir + "/" + files[i])))
+		{
+			++cooked;
+		}
+	}
+
+	Util::Array<Util::String> dirs = ioServer->ListDirectories(IO::URI(dir), "*");
+	for (IndexT i = 0; i < dirs.Size(); ++i)
+	{
+		if (dirs[i] != "." && dirs[i] != "..")
+		{
+			cooked += CookShaders(dir + "/" + dirs[i]);
+		}
+	}
+	return cooked;
+}
 }
\ No newline at end of file
@@ -30,5 +30,9 @@ namespace GenesisMaterialMaker
 {
 	GPtr<Graphic::Material> MakeFromShader(const char* text,SizeT size);
 	GPtr<Graphic::Material> MakeFromShader(const Util::StringAtom& shaderfile);
+	/// compile and parse a .shader file and write its binary cache entry to disk, for offline cooking
+	bool CookShader(const Util::StringAtom& shaderfile);
+	/// cook every .shader below dir, returns the number of entries written
+	SizeT CookShaders(const Util::String& dir);
 }
 #endif
@@ -74,10 +74,10 @@ namespace Particles
 		float percent = (particle->mTotalTimeToLive - particle->mTimeToLive)/particle->mTotalTimeToLive;
 
 		float randomSid = Math::n_rand(0.0f,1.0f);
-		clr.r =  Math::n_scalartoByte(mMinMaxColorR.Calculate(percent,randomSid));
-		clr.g =  Math::n_scalartoByte(mMinMaxColorG.Calculate(percent,randomSid));
-		clr.b =  Math::n_scalartoByte(mMinMaxColorB.Calculate(percent,randomSid)) ;
-		clr.a =  Math::n_scalartoByte(mMinMaxColorA.Calculate(percent,randomSid));
+		clr.r =  Math::n_scalartoByte(mMinMaxColorR.CalculateBaked(percent,randomSid));
+		clr.g =  Math::n_scalartoByte(mMinMaxColorG.CalculateBaked(percent,randomSid));
+		clr.b =  Math::n_scalartoByte(mMinMaxColorB.CalculateBaked(percent,randomSid)) ;
+		clr.a =  Math::n_scalartoByte(mMinMaxColorA.CalculateBaked(percent,randomSid));
 
 		particle->mColor = clr;
 
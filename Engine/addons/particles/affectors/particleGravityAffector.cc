@@ -48,15 +48,15 @@ namespace Particles
 			return;
 		float percent = (particle->mTotalTimeToLive - particle->mTimeToLive)/particle->mTotalTimeToLive;
 
-		Math::float3	gravityDir(mMinMaxPosX.Calculate(percent,particle->mRandom0)
-			, mMinMaxPosY.Calculate(percent,particle->mRandom1)
-			, mMinMaxPosZ.Calculate(percent,particle->mRandom2)  );
+		Math::float3	gravityDir(mMinMaxPosX.CalculateBaked(percent,particle->mRandom0)
+			, mMinMaxPosY.CalculateBaked(percent,particle->mRandom1)
+			, mMinMaxPosZ.CalculateBaked(percent,particle->mRandom2)  );
 
 		gravityDir = gravityDir - particle->mPosition;
 
 		gravityDir.normalise();
 
-		float  gravity = mMinMaxGravity.Calculate(percent,particle->mRandom3);
+		float  gravity = mMinMaxGravity.CalculateBaked(percent,particle->mRandom3);
 
 		Math::scalar _curTime = (Math::scalar)mParentSystem->GetCurrentFrameTime();
 		particle->mDirection += gravity  * gravityDir * _curTime * _calculateAffectSpecialisationFactor(particle);
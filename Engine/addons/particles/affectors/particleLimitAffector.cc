@@ -56,14 +56,14 @@ namespace Particles
 			float curTime = (particle->mTotalTimeToLive - particle->mTimeToLive)/particle->mTotalTimeToLive;
 
 			//mAxisX
-			float limitX = mLimitX.Calculate(curTime,particle->mRandom0);
+			float limitX = mLimitX.CalculateBaked(curTime,particle->mRandom0);
 			//mAxisY
-			float limitY = mLimitY.Calculate(curTime,particle->mRandom1);
+			float limitY = mLimitY.CalculateBaked(curTime,particle->mRandom1);
 			//mAxisZ
-			float limitZ = mLimitZ.Calculate(curTime,particle->mRandom2);
+			float limitZ = mLimitZ.CalculateBaked(curTime,particle->mRandom2);
 
 			//mDampen
-			float _value = mLimitValue.Calculate(curTime,particle->mRandom3);
+			float _value = mLimitValue.CalculateBaked(curTime,particle->mRandom3);
 
 
 			Math::float3 velocity = particle->mDirection;
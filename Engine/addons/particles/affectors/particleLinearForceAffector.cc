@@ -57,9 +57,9 @@ namespace Particles
 			float percent = (particle->mTotalTimeToLive - particle->mTimeToLive)/particle->mTotalTimeToLive;
 
 
-			Math::float3 forceVec(mForceVectorX.Calculate(percent,particle->mRandom0) ,
-				mForceVectorY.Calculate(percent,particle->mRandom1),
-				mForceVectorZ.Calculate(percent,particle->mRandom2) );
+			Math::float3 forceVec(mForceVectorX.CalculateBaked(percent,particle->mRandom0) ,
+				mForceVectorY.CalculateBaked(percent,particle->mRandom1),
+				mForceVectorZ.CalculateBaked(percent,particle->mRandom2) );
 
 			if  ( mSpaceCoord == SCT_WORLD  )
 			{
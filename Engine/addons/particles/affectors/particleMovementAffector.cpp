@@ -45,13 +45,13 @@ namespace Particles
 			return;
 		float percent = (particle->mTotalTimeToLive - particle->mTimeToLive)/particle->mTotalTimeToLive;		
 
-		Math::float3	GravityPos(mMinMaxPosX.Calculate(percent,particle->mRandom0)
-			, mMinMaxPosY.Calculate(percent,particle->mRandom1)
-			, mMinMaxPosZ.Calculate(percent,particle->mRandom2)  );
+		Math::float3	GravityPos(mMinMaxPosX.CalculateBaked(percent,particle->mRandom0)
+			, mMinMaxPosY.CalculateBaked(percent,particle->mRandom1)
+			, mMinMaxPosZ.CalculateBaked(percent,particle->mRandom2)  );
 
 
 		Math::float3 gravity = GravityPos;
-		float  Gravity = mMinMaxSpeed.Calculate(percent,particle->mRandom3);
+		float  Gravity = mMinMaxSpeed.CalculateBaked(percent,particle->mRandom3);
 		gravity = gravity - particle->mPosition;
 		gravity.normalise();
 		particle->mDirection = (particle->mDirection + gravity*Gravity)/2.0f;
@@ -51,9 +51,9 @@ namespace Particles
 			return;
 		float percent = (particle->mTotalTimeToLive - particle->mTimeToLive)/particle->mTotalTimeToLive;
 
-		Math::float3 particleSize(mScaleX.Calculate(percent,particle->mRandom0),
-			mScaleY.Calculate(percent,particle->mRandom1),
-			mScaleZ.Calculate(percent,particle->mRandom2) );
+		Math::float3 particleSize(mScaleX.CalculateBaked(percent,particle->mRandom0),
+			mScaleY.CalculateBaked(percent,particle->mRandom1),
+			mScaleZ.CalculateBaked(percent,particle->mRandom2) );
 
 
 		if(!mIsAxialScale)
@@ -130,7 +130,7 @@ namespace Particles
 		float texCoordMaxIndex = 0;
 
 		time = time - int(time);
-		texCoordIndex = mMinMaxTexAnimation.Calculate(time,particle->mRandom0);
+		texCoordIndex = mMinMaxTexAnimation.CalculateBaked(time,particle->mRandom0);
 
 		int iTexCoordIndex = (int)texCoordIndex;
 
@@ -51,7 +51,7 @@ namespace Particles
 			return;
 		float percent = (particle->mTotalTimeToLive - particle->mTimeToLive)/particle->mTotalTimeToLive;
 
-		float rotatorAngularVelocity = mMinMaxRotation.Calculate(percent,particle->mRandom0);
+		float rotatorAngularVelocity = mMinMaxRotation.CalculateBaked(percent,particle->mRandom0);
 
 		float rotatorRadian = rotatorAngularVelocity * N_PI / 180;
 		particle->mZRotation = particle->mZRotation + (float)(rotatorRadian * mParentSystem->GetCurrentFrameTime());
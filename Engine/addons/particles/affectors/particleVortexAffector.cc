@@ -50,11 +50,11 @@ namespace Particles
 		if(!GetEnable())
 			return;
 		float percent = (particle->mTotalTimeToLive - particle->mTimeToLive)/particle->mTotalTimeToLive;
-		Math::vector normal(mMinMaxNormalX.Calculate(percent,particle->mRandom0),
-			mMinMaxNormalY.Calculate(percent,particle->mRandom1),
-			mMinMaxNormalZ.Calculate(percent,particle->mRandom2) );
+		Math::vector normal(mMinMaxNormalX.CalculateBaked(percent,particle->mRandom0),
+			mMinMaxNormalY.CalculateBaked(percent,particle->mRandom1),
+			mMinMaxNormalZ.CalculateBaked(percent,particle->mRandom2) );
 
-		float rotSpeed = mMinMaxRotationSpeed.Calculate(percent,particle->mRandom3);
+		float rotSpeed = mMinMaxRotationSpeed.CalculateBaked(percent,particle->mRandom3);
 
 		Math::quaternion mRotation = Math::quaternion::rotationaxis(Math::float4::normalize(normal), rotSpeed * (Math::scalar)mParentSystem->GetCurrentFrameTime());
 
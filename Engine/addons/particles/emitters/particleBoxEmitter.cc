@@ -51,9 +51,9 @@ namespace Particles
 	{
 		float percent = (float)mParentSystem->GetCurEmitTime();
 
-		float fkfRangeX = mCurveRangeX.Calculate(percent);
-		float fkfRangeY = mCurveRangeY.Calculate(percent);
-		float fkfRangeZ = mCurveRangeZ.Calculate(percent);
+		float fkfRangeX = mCurveRangeX.CalculateBaked(percent);
+		float fkfRangeY = mCurveRangeY.CalculateBaked(percent);
+		float fkfRangeZ = mCurveRangeZ.CalculateBaked(percent);
 
 		Math::float3 randomxyz = ConstDefine::FLOAT3_ZERO;
 		if (mInitFromType == EFT_BODY)
@@ -91,9 +91,9 @@ namespace Particles
 			return;
 		}
 		float percent = (float)mParentSystem->GetCurEmitTime();
-		float fkfRangeX = mCurveRangeX.Calculate(percent)*0.5f;
-		float fkfRangeY = mCurveRangeY.Calculate(percent)*0.5f;
-		float fkfRangeZ = mCurveRangeZ.Calculate(percent)*0.5f;
+		float fkfRangeX = mCurveRangeX.CalculateBaked(percent)*0.5f;
+		float fkfRangeY = mCurveRangeY.CalculateBaked(percent)*0.5f;
+		float fkfRangeZ = mCurveRangeZ.CalculateBaked(percent)*0.5f;
 
 
 		Math::float3 randomxyz = particle->mPosition;
@@ -52,10 +52,10 @@ namespace Particles
 	{
 		float percent = (float)mParentSystem->GetCurEmitTime();
 
-		float fkfAngle = mCurveAngle.Calculate(percent);
-		float fkfConeHeight = mCurveConeHeight.Calculate(percent);
-		float fkfOuterRadius = mCurveOuterRadius.Calculate(percent);
-		float fkfInnerRadius = mCurveInnerRadius.Calculate(percent);
+		float fkfAngle = mCurveAngle.CalculateBaked(percent);
+		float fkfConeHeight = mCurveConeHeight.CalculateBaked(percent);
+		float fkfOuterRadius = mCurveOuterRadius.CalculateBaked(percent);
+		float fkfInnerRadius = mCurveInnerRadius.CalculateBaked(percent);
 
 		float a = Math::n_deg2rad(fkfAngle);
 
@@ -52,14 +52,14 @@ namespace Particles
 	{
 		float percent = (float)mParentSystem->GetCurEmitTime();
 
-		float fkfRadius = mRadiusCurve.Calculate(percent);
+		float fkfRadius = mRadiusCurve.CalculateBaked(percent);
 		float tRadius = fkfRadius;
 
-		float fkfHem = mHemCurve.Calculate(percent);
+		float fkfHem = mHemCurve.CalculateBaked(percent);
 		float tHemZ = Math::n_deg2rad(fkfHem);
 		float randomHemi = Math::n_rand( tHemZ,  N_PI);
 
-		float fkfSlice = mSliceCurve.Calculate(percent);
+		float fkfSlice = mSliceCurve.CalculateBaked(percent);
 		float tSliceY = Math::n_deg2rad( fkfSlice);
 
 		/// hemi
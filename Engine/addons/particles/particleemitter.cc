@@ -127,7 +127,7 @@ namespace Particles
 		if ( mEnable )
 		{
 			float percent = (float)mParentSystem->GetCurEmitTime();
-			Math::scalar rate = mMinMaxRate.Calculate(percent,Math::n_rand(0.0f,1.0f));
+			Math::scalar rate = mMinMaxRate.CalculateBaked(percent,Math::n_rand(0.0f,1.0f));
 
 			mRemainder += rate * (Math::scalar)timeElapsed;
 			requestedParticles = (SizeT)mRemainder;
@@ -198,13 +198,13 @@ namespace Particles
 		n_assert( particle );
 
 		float percent = (float)mParentSystem->GetCurEmitTime();
-		float veloX = mMinMaxVelocityX.Calculate(percent,Math::n_rand(0.0f,1.0f));		
+		float veloX = mMinMaxVelocityX.CalculateBaked(percent,Math::n_rand(0.0f,1.0f));		
 
 		if (mIsAxialVelocity)
 		{
 
-			float veloY =  mMinMaxVelocityY.Calculate(percent,Math::n_rand(0.0f,1.0f));
-			float veloZ = mMinMaxVelocityZ.Calculate(percent,Math::n_rand(0.0f,1.0f));
+			float veloY =  mMinMaxVelocityY.CalculateBaked(percent,Math::n_rand(0.0f,1.0f));
+			float veloZ = mMinMaxVelocityZ.CalculateBaked(percent,Math::n_rand(0.0f,1.0f));
 			particle->mDirection = Math::float3(veloX, veloY, veloZ);
 		}
 		else
@@ -255,10 +255,10 @@ namespace Particles
 		float percent = (float)mParentSystem->GetCurEmitTime();
 
 		float colorRand = Math::n_rand(0,1);
-		ubyte colorR =  Math::n_scalartoByte(mMinMaxColorR.Calculate(percent,colorRand));
-		ubyte colorG =  Math::n_scalartoByte(mMinMaxColorG.Calculate(percent,colorRand));
-		ubyte colorB =  Math::n_scalartoByte(mMinMaxColorB.Calculate(percent,colorRand)) ;
-		ubyte colorA =  Math::n_scalartoByte(mMinMaxColorA.Calculate(percent,colorRand));
+		ubyte colorR =  Math::n_scalartoByte(mMinMaxColorR.CalculateBaked(percent,colorRand));
+		ubyte colorG =  Math::n_scalartoByte(mMinMaxColorG.CalculateBaked(percent,colorRand));
+		ubyte colorB =  Math::n_scalartoByte(mMinMaxColorB.CalculateBaked(percent,colorRand)) ;
+		ubyte colorA =  Math::n_scalartoByte(mMinMaxColorA.CalculateBaked(percent,colorRand));
 
 		particle->mColor = Math::Color32(colorR, colorG, colorB, colorA );
 
@@ -285,7 +285,7 @@ namespace Particles
 		n_assert( particle );
 
 		float percent = (float)mParentSystem->GetCurEmitTime();
-		particle->mTotalTimeToLive = mMinMaxLiveTime.Calculate(percent,Math::n_rand(0.0f,1.0f));
+		particle->mTotalTimeToLive = mMinMaxLiveTime.CalculateBaked(percent,Math::n_rand(0.0f,1.0f));
 
 		particle->mTimeToLive = particle->mTotalTimeToLive;
 
@@ -298,11 +298,11 @@ namespace Particles
 
 		float percent = (float)mParentSystem->GetCurEmitTime();
 
-		float sizeX = mMinMaxSizeX.Calculate(percent,Math::n_rand(0.0f,1.0f));
+		float sizeX = mMinMaxSizeX.CalculateBaked(percent,Math::n_rand(0.0f,1.0f));
 		if (mIsAxialSize)
 		{
-			float sizeY = mMinMaxSizeY.Calculate(percent,Math::n_rand(0.0f,1.0f));
-			float sizeZ = mMinMaxSizeZ.Calculate(percent,Math::n_rand(0.0f,1.0f));
+			float sizeY = mMinMaxSizeY.CalculateBaked(percent,Math::n_rand(0.0f,1.0f));
+			float sizeZ = mMinMaxSizeZ.CalculateBaked(percent,Math::n_rand(0.0f,1.0f));
 			particle->mSize = Math::float3(sizeX, sizeY, sizeZ);
 
 		}
@@ -320,7 +320,7 @@ namespace Particles
 
 		float percent = (float)mParentSystem->GetCurEmitTime();
 
-		float zRotation = mMinMaxInitRotaion.Calculate( percent,Math::n_rand(0.0f,1.0f));
+		float zRotation = mMinMaxInitRotaion.CalculateBaked( percent,Math::n_rand(0.0f,1.0f));
 
 		particle->mZRotation = zRotation * N_PI / 180;
 	}
@@ -191,15 +191,15 @@ namespace Particles
 
 		Math::Color32 color1;
 		Math::Color32 color2;
-		color1.a = Math::n_scalartoByte(alphaAdd * mLineColorA.Calculate(v0));
-		color1.r = Math::n_scalartoByte(mLineColorR.Calculate(v0));
-		color1.g = Math::n_scalartoByte(mLineColorG.Calculate(v0));
-		color1.b = Math::n_scalartoByte(mLineColorB.Calculate(v0));
-
-		color2.a = Math::n_scalartoByte(alphaAdd * mLineColorA.Calculate(v1));
-		color2.r = Math::n_scalartoByte(mLineColorR.Calculate(v1));
-		color2.g = Math::n_scalartoByte(mLineColorG.Calculate(v1));
-		color2.b = Math::n_scalartoByte(mLineColorB.Calculate(v1));
+		color1.a = Math::n_scalartoByte(alphaAdd * mLineColorA.CalculateBaked(v0));
+		color1.r = Math::n_scalartoByte(mLineColorR.CalculateBaked(v0));
+		color1.g = Math::n_scalartoByte(mLineColorG.CalculateBaked(v0));
+		color1.b = Math::n_scalartoByte(mLineColorB.CalculateBaked(v0));
+
+		color2.a = Math::n_scalartoByte(alphaAdd * mLineColorA.CalculateBaked(v1));
+		color2.r = Math::n_scalartoByte(mLineColorR.CalculateBaked(v1));
+		color2.g = Math::n_scalartoByte(mLineColorG.CalculateBaked(v1));
+		color2.b = Math::n_scalartoByte(mLineColorB.CalculateBaked(v1));
 
 
 		particleVertex[0].mColor = color1.HexARGB();
@@ -24,6 +24,268 @@ THE SOFTWARE.
 ****************************************************************************/
 #include "resource/resource_stdneb.h"
 #include "DXTextureDecompress.h"
+#include "jobs/stdjob.h"
+#include "jobs/jobsystem.h"
+#include "jobs/jobport.h"
+#include "jobs/job.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DXTDECOMPRESS_USE_SSE2 (1)
+#else
+#define DXTDECOMPRESS_USE_SSE2 (0)
+#endif
+#if !DXTDECOMPRESS_USE_SSE2 && (defined(__ARM_NEON__) || defined(__ARM_NEON))
+#include <arm_neon.h>
+#define DXTDECOMPRESS_USE_NEON (1)
+#else
+#define DXTDECOMPRESS_USE_NEON (0)
+#endif
+
+namespace Resources
+{
+	using squish::u8;
+
+	// about 64K pixels per job slice
+	static const int sPixelsPerBand = 64 * 1024;
+	SizeT DXTextureDecompress::s_parallelThreshold = 256 * 256;
+
+	//------------------------------------------------------------------------
+	// the pixels are uint32 holding r, g, b, a in memory order
+	static inline uint32 _PackRgba(u8 r, u8 g, u8 b, u8 a)
+	{
+		const u8 bytes[4] = { r, g, b, a };
+		uint32 value;
+		memcpy(&value, bytes, sizeof(value));
+		return value;
+	}
+	//------------------------------------------------------------------------
+	static inline void _Unpack565(int value, u8* colour)
+	{
+		const u8 red = ( u8 )( ( value >> 11 ) & 0x1f );
+		const u8 green = ( u8 )( ( value >> 5 ) & 0x3f );
+		const u8 blue = ( u8 )( value & 0x1f );
+		colour[0] = ( red << 3 ) | ( red >> 2 );
+		colour[1] = ( green << 2 ) | ( green >> 4 );
+		colour[2] = ( blue << 3 ) | ( blue >> 2 );
+	}
+	//------------------------------------------------------------------------
+	// same codebook as squish::DecompressColour, as packed pixels
+	static inline void _BuildColourPalette(const u8* bytes, bool isDxt1, uint32* palette)
+	{
+		const int a = ( int )bytes[0] | ( ( int )bytes[1] << 8 );
+		const int b = ( int )bytes[2] | ( ( int )bytes[3] << 8 );
+		u8 c[3], d[3];
+		_Unpack565(a, c);
+		_Unpack565(b, d);
+		palette[0] = _PackRgba(c[0], c[1], c[2], 255);
+		palette[1] = _PackRgba(d[0], d[1], d[2], 255);
+		if( isDxt1 && a <= b )
+		{
+			palette[2] = _PackRgba(( u8 )( ( c[0] + d[0] )/2 ), ( u8 )( ( c[1] + d[1] )/2 ), ( u8 )( ( c[2] + d[2] )/2 ), 255);
+			palette[3] = _PackRgba(0, 0, 0, 0);
+		}
+		else
+		{
+			palette[2] = _PackRgba(( u8 )( ( 2*c[0] + d[0] )/3 ), ( u8 )( ( 2*c[1] + d[1] )/3 ), ( u8 )( ( 2*c[2] + d[2] )/3 ), 255);
+			palette[3] = _PackRgba(( u8 )( ( c[0] + 2*d[0] )/3 ), ( u8 )( ( c[1] + 2*d[1] )/3 ), ( u8 )( ( c[2] + 2*d[2] )/3 ), 255);
+		}
+	}
+	//------------------------------------------------------------------------
+	// the 16 alpha values of a dxt3/dxt5 block, already moved to the alpha byte of a pixel
+	static inline void _BuildAlpha(const u8* bytes, int flags, uint32* alpha)
+	{
+		const uint32 alphaUnit = _PackRgba(0, 0, 0, 1);
+		if( ( flags & squish::kDxt3 ) != 0 )
+		{
+			for( int i = 0; i < 8; ++i )
+			{
+				const u8 lo = bytes[i] & 0x0f;
+				const u8 hi = bytes[i] & 0xf0;
+				alpha[2*i] = ( u8 )( lo | ( lo << 4 ) ) * alphaUnit;
+				alpha[2*i + 1] = ( u8 )( hi | ( hi >> 4 ) ) * alphaUnit;
+			}
+			return;
+		}
+
+		const int alpha0 = bytes[0];
+		const int alpha1 = bytes[1];
+		uint32 codes[8];
+		codes[0] = alpha0 * alphaUnit;
+		codes[1] = alpha1 * alphaUnit;
+		if( alpha0 <= alpha1 )
+		{
+			for( int i = 1; i < 5; ++i )
+				codes[1 + i] = ( ( ( 5 - i )*alpha0 + i*alpha1 )/5 ) * alphaUnit;
+			codes[6] = 0;
+			codes[7] = 255 * alphaUnit;
+		}
+		else
+		{
+			for( int i = 1; i < 7; ++i )
+				codes[1 + i] = ( ( ( 7 - i )*alpha0 + i*alpha1 )/7 ) * alphaUnit;
+		}
+		// 16 3-bit indices in 6 bytes
+		uint64 indices = 0;
+		for( int i = 5; i >= 0; --i )
+			indices = ( indices << 8 ) | bytes[2 + i];
+		for( int i = 0; i < 16; ++i, indices >>= 3 )
+			alpha[i] = codes[indices & 0x7];
+	}
+	//------------------------------------------------------------------------
+	// intensity modifiers of ETC1, by table codeword and pixel index
+	static const int sEtc1Modifiers[8][4] =
+	{
+		{   2,   8,   -2,   -8 },
+		{   5,  17,   -5,  -17 },
+		{   9,  29,   -9,  -29 },
+		{  13,  42,  -13,  -42 },
+		{  18,  60,  -18,  -60 },
+		{  24,  80,  -24,  -80 },
+		{  33, 106,  -33, -106 },
+		{  47, 183,  -47, -183 }
+	};
+	//------------------------------------------------------------------------
+	static inline u8 _ClampByte(int value)
+	{
+		return ( u8 )( value < 0 ? 0 : ( value > 255 ? 255 : value ) );
+	}
+	//------------------------------------------------------------------------
+	// the 4 colours of each half of an ETC1 block, as packed pixels
+	static inline void _BuildEtc1Palettes(const u8* bytes, uint32 palettes[2][4])
+	{
+		int base[2][3];
+		if( ( bytes[3] & 0x2 ) != 0 )
+		{
+			// differential mode, 5 bit base and 3 bit signed delta
+			for( int c = 0; c < 3; ++c )
+			{
+				const int value = bytes[c] >> 3;
+				int delta = bytes[c] & 0x7;
+				if( delta >= 4 )
+					delta -= 8;
+				const int second = ( value + delta ) & 0x1f;
+				base[0][c] = ( value << 3 ) | ( value >> 2 );
+				base[1][c] = ( second << 3 ) | ( second >> 2 );
+			}
+		}
+		else
+		{
+			// individual mode, two 4 bit colours
+			for( int c = 0; c < 3; ++c )
+			{
+				const int first = bytes[c] >> 4;
+				const int second = bytes[c] & 0xf;
+				base[0][c] = ( first << 4 ) | first;
+				base[1][c] = ( second << 4 ) | second;
+			}
+		}
+
+		const int tables[2] = { ( bytes[3] >> 5 ) & 0x7, ( bytes[3] >> 2 ) & 0x7 };
+		for( int half = 0; half < 2; ++half )
+		{
+			for( int i = 0; i < 4; ++i )
+			{
+				const int modifier = sEtc1Modifiers[tables[half]][i];
+				palettes[half][i] = _PackRgba(_ClampByte(base[half][0] + modifier), _ClampByte(base[half][1] + modifier),
+					_ClampByte(base[half][2] + modifier), 255);
+			}
+		}
+	}
+	//------------------------------------------------------------------------
+	// decode one ETC1 block into a 4x4 pixel rect, the 64 bits are stored big endian
+	static inline void _DecodeEtc1Block(const u8* block, uint32* dst, int pitch)
+	{
+		uint32 palettes[2][4];
+		_BuildEtc1Palettes(block, palettes);
+
+		// pixel indices run down the columns, msb and lsb in separate 16 bit planes
+		const int msb = ( ( int )block[4] << 8 ) | block[5];
+		const int lsb = ( ( int )block[6] << 8 ) | block[7];
+		const bool flip = ( block[3] & 0x1 ) != 0;
+		for( int y = 0; y < 4; ++y, dst += pitch )
+		{
+			for( int x = 0; x < 4; ++x )
+			{
+				const int bit = x*4 + y;
+				const int index = ( ( ( msb >> bit ) & 1 ) << 1 ) | ( ( lsb >> bit ) & 1 );
+				const int half = flip ? ( y >> 1 ) : ( x >> 1 );
+				dst[x] = palettes[half][index];
+			}
+		}
+	}
+	//------------------------------------------------------------------------
+	// decode one block straight into a 4x4 pixel rect, pitch in pixels
+	static inline void _DecodeBlock(const u8* block, int flags, uint32* dst, int pitch)
+	{
+		if( ( flags & DXTextureDecompress::kEtc1 ) != 0 )
+		{
+			_DecodeEtc1Block(block, dst, pitch);
+			return;
+		}
+		const bool hasAlpha = ( flags & ( squish::kDxt3 | squish::kDxt5 ) ) != 0;
+		const u8* colourBytes = hasAlpha ? block + 8 : block;
+
+		uint32 palette[4];
+		_BuildColourPalette(colourBytes, ( flags & squish::kDxt1 ) != 0, palette);
+		uint32 alpha[16];
+		if( hasAlpha )
+		{
+			_BuildAlpha(block, flags, alpha);
+		}
+		const uint32 colourMask = _PackRgba(255, 255, 255, 0);
+
+		for( int row = 0; row < 4; ++row, dst += pitch )
+		{
+			const u8 packed = colourBytes[4 + row];
+#if DXTDECOMPRESS_USE_SSE2
+			__m128i pixels = _mm_set_epi32(( int )palette[( packed >> 6 ) & 0x3], ( int )palette[( packed >> 4 ) & 0x3], 
+				( int )palette[( packed >> 2 ) & 0x3], ( int )palette[packed & 0x3]);
+			if( hasAlpha )
+			{
+				pixels = _mm_or_si128(_mm_and_si128(pixels, _mm_set1_epi32(( int )colourMask)), _mm_loadu_si128(( const __m128i* )( alpha + 4*row )));
+			}
+			_mm_storeu_si128(( __m128i* )dst, pixels);
+#elif DXTDECOMPRESS_USE_NEON
+			const uint32 rowPixels[4] = { palette[packed & 0x3], palette[( packed >> 2 ) & 0x3], palette[( packed >> 4 ) & 0x3], palette[( packed >> 6 ) & 0x3] };
+			uint32x4_t pixels = vld1q_u32(rowPixels);
+			if( hasAlpha )
+			{
+				pixels = vorrq_u32(vandq_u32(pixels, vdupq_n_u32(colourMask)), vld1q_u32(alpha + 4*row));
+			}
+			vst1q_u32(dst, pixels);
+#else
+			for( int i = 0; i < 4; ++i )
+			{
+				const uint32 pixel = palette[( packed >> 2*i ) & 0x3];
+				dst[i] = hasAlpha ? ( ( pixel & colourMask ) | alpha[4*row + i] ) : pixel;
+			}
+#endif
+		}
+	}
+	//------------------------------------------------------------------------
+	struct DXTDecodeBand
+	{
+		uint32* destData;
+		const uint32* srcData;
+		int imageW;
+		int imageH;
+		int flags;
+		int firstBlockRow;
+		int numBlockRows;
+	};
+	//------------------------------------------------------------------------
+	void DXTDecodeJobFunc(const JobFuncContext& ctx)
+	{
+		const DXTDecodeBand* bands = (const DXTDecodeBand*)ctx.inputs[0];
+		const SizeT count = ctx.inputSizes[0] / sizeof(DXTDecodeBand);
+		for (IndexT i = 0; i < count; ++i)
+		{
+			const DXTDecodeBand& band = bands[i];
+			DXTextureDecompress::DecompressBlockRows(band.destData, band.imageW, band.imageH, band.srcData, band.flags, band.firstBlockRow, band.numBlockRows);
+		}
+	}
+}
+__ImplementSpursJob(Resources::DXTDecodeJobFunc);
 
 namespace Resources
 {
@@ -41,58 +303,85 @@ namespace Resources
 												const uint32* srcData, int flags)
 
 	{
-		
-		// fix any bad flags
-		//flags = FixFlags( flags );	
+		const int blockRows = ( imageH + 3 ) / 4;
+		if ( !Jobs::JobSystem::HasInstance() || blockRows < 2 || imageW * imageH < s_parallelThreshold )
+		{
+			DecompressBlockRows(destData, imageW, imageH, srcData, flags, 0, blockRows);
+			return;
+		}
+
+		// one job, one slice per band of block rows, the slices spread over the worker threads
+		const int rowsPerBand = Math::n_max(1, sPixelsPerBand / ( imageW * 4 ));
+		Util::Array<DXTDecodeBand> bands;
+		bands.Reserve(( blockRows + rowsPerBand - 1 ) / rowsPerBand);
+		for ( int row = 0; row < blockRows; row += rowsPerBand )
+		{
+			DXTDecodeBand band;
+			band.destData = destData;
+			band.srcData = srcData;
+			band.imageW = imageW;
+			band.imageH = imageH;
+			band.flags = flags;
+			band.firstBlockRow = row;
+			band.numBlockRows = Math::n_min(rowsPerBand, blockRows - row);
+			bands.Append(band);
+		}
 
-		// initialise the block input output
-		squish::u8 const* sourceBlock = reinterpret_cast< squish::u8 const* >( srcData );		
-		squish::u8* rgba = reinterpret_cast< squish::u8* >(destData);
-		int bytesPerBlock = ( ( flags & squish::kDxt1 ) != 0 ) ? 8 : 16;
+		Jobs::JobFuncDesc jobFunction(DXTDecodeJobFunc);
+		Jobs::JobUniformDesc uniformData(&bands[0], sizeof(DXTDecodeBand), 0);
+		Jobs::JobDataDesc inputData(&bands[0], bands.Size() * sizeof(DXTDecodeBand), sizeof(DXTDecodeBand));
+		Jobs::JobDataDesc outputData(&bands[0], bands.Size() * sizeof(DXTDecodeBand), sizeof(DXTDecodeBand));
+
+		GPtr<Jobs::Job> job = Jobs::Job::Create();
+		job->Setup(uniformData, inputData, outputData, jobFunction);
+		GPtr<Jobs::JobPort> jobPort = Jobs::JobPort::Create();
+		jobPort->Setup();
+		jobPort->PushJob(job);
+		jobPort->WaitDone();
+		jobPort->Discard();
+	}
+	//------------------------------------------------------------------------
+	void DXTextureDecompress::DecompressBlockRows(uint32* destData, const int imageW, const int imageH,
+												   const uint32* srcData, int flags, int firstBlockRow, int numBlockRows)
+	{
+		const int blocksW = ( imageW + 3 ) / 4;
+		const int bytesPerBlock = ( ( flags & ( squish::kDxt1 | kEtc1 ) ) != 0 ) ? 8 : 16;
+		const u8* sourceBlock = reinterpret_cast< const u8* >( srcData ) + firstBlockRow * blocksW * bytesPerBlock;
 
-		// loop over blocks
-		for( int y = 0; y < imageH; y += 4 )
+		for ( int by = firstBlockRow; by < firstBlockRow + numBlockRows; ++by )
 		{
-			for( int x = 0; x < imageW; x += 4 )
+			const int y = by * 4;
+			const int rows = Math::n_min(4, imageH - y);
+			for ( int x = 0; x < imageW; x += 4, sourceBlock += bytesPerBlock )
 			{
-				// decompress the block
-				squish::u8 targetRgba[4*16];
-				squish::Decompress( targetRgba, sourceBlock, flags );
-
-				// write the decompressed pixels to the correct image locations
-				squish::u8 const* sourcePixel = targetRgba;
-				for( int py = 0; py < 4; ++py )
+				const int cols = Math::n_min(4, imageW - x);
+				uint32* target = destData + imageW * y + x;
+				if ( rows == 4 && cols == 4 )
 				{
-					for( int px = 0; px < 4; ++px )
-					{
-						// get the target location
-						int sx = x + px;
-						int sy = y + py;
-						if( sx < imageW && sy < imageH )
-						{
-							squish::u8* targetPixel = rgba + 4*( imageW*sy + sx );
-
-							// copy the rgba value
-							for( int i = 0; i < 4; ++i )
-								*targetPixel++ = *sourcePixel++;
-						}
-						else
-						{
-							// skip this pixel as its outside the image
-							sourcePixel += 4;
-						}
-					}
+					_DecodeBlock(sourceBlock, flags, target, imageW);
+					continue;
 				}
 
-				// advance
-				sourceBlock += bytesPerBlock;
+				// skip the pixels outside the image
+				uint32 block[16];
+				_DecodeBlock(sourceBlock, flags, block, 4);
+				for ( int py = 0; py < rows; ++py )
+				{
+					memcpy(target + imageW * py, block + 4 * py, cols * sizeof(uint32));
+				}
 			}
 		}
-		
 	}
-
 	//------------------------------------------------------------------------
-	
+	void DXTextureDecompress::SetParallelThreshold(SizeT pixels)
+	{
+		s_parallelThreshold = pixels;
+	}
+	//------------------------------------------------------------------------
+	SizeT DXTextureDecompress::GetParallelThreshold()
+	{
+		return s_parallelThreshold;
+	}
 }
 namespace squish
 {
@@ -29,17 +29,35 @@ THE SOFTWARE.
 namespace Resources
 {
 
+	/**
+		Decodes DXT1/3/5 images to r,g,b,a bytes, with the same results as the squish functions below,
+		and ETC1 images (kEtc1, alpha 255) as loaded from PKM files.
+
+		Each block is decoded straight into the image from a packed palette, a row of 4 pixels at a time
+		(SSE2/NEON where available). Images of at least GetParallelThreshold() pixels are split into bands
+		of block rows and decoded on the job system; the caller waits for the result, so don't call it
+		from a job.
+	*/
 	class DXTextureDecompress
 	{
 	public:
+		/// flag for ETC1 rgb blocks, next to the squish flags
+		enum { kEtc1 = ( 1 << 16 ) };
+
 		DXTextureDecompress(void);
 		virtual ~DXTextureDecompress(void);
 
+		/// decode a whole image, imageW and imageH need not be multiples of 4
 		static void DecompressImage (uint32* destData,const int imageW, const int imageH,  const uint32* srcData, int flags);
+		/// decode the given rows of blocks of an image on the calling thread
+		static void DecompressBlockRows (uint32* destData, const int imageW, const int imageH, const uint32* srcData, int flags, int firstBlockRow, int numBlockRows);
 
-	
-
+		/// images with fewer pixels are decoded on the calling thread, 256x256 by default
+		static void SetParallelThreshold(SizeT pixels);
+		static SizeT GetParallelThreshold();
 
+	private:
+		static SizeT s_parallelThreshold;
 	};
 
 }
@@ -68,6 +68,7 @@ namespace Resources
 		n_assert(pReader.isvalid());
 
 		pReader->SetStream( mStream );
+		pReader->SetMemoryMappingEnabled( true );
 
 		//Every file shuold be LittleEndian
 #ifdef __OSX__
@@ -91,7 +91,16 @@ namespace Resources
 	//------------------------------------------------------------------------
 	void AudioRes::UnLoadImpl(void)
 	{
-		this->mRaw = NULL;
+		if ( this->mRaw )
+		{
+			n_delete_array(this->mRaw);
+			this->mRaw = NULL;
+		}
 		this->mSize = 0;
 	}
+	//------------------------------------------------------------------------
+	SizeT AudioRes::CalculateRuntimeSize(void) const
+	{
+		return mSize + Super::CalculateRuntimeSize();
+	}
 }
@@ -39,6 +39,9 @@ namespace Resources
 		const char* GetPtr(void) const { return mRaw; }
 		char* GetPtr(void) { return mRaw; }
 
+		// @Resource::CalculateRuntimeSize
+		virtual SizeT CalculateRuntimeSize(void) const;
+
 	protected:
 		virtual bool SwapLoadImpl( const GPtr<Resource>& tempRes );
 		virtual void UnLoadImpl(void);
@@ -0,0 +1,143 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "resource/resource_stdneb.h"
+#include "resource/debug/resourcepagehandler.h"
+#include "resource/resourceserver.h"
+#include "http/html/htmlpagewriter.h"
+
+namespace Debug
+{
+__ImplementClass(Debug::ResourcePageHandler, 'RSPH', Http::HttpRequestHandler);
+
+using namespace Http;
+using namespace Util;
+using namespace Resources;
+
+//------------------------------------------------------------------------------
+/**
+*/
+ResourcePageHandler::ResourcePageHandler()
+{
+    this->SetName("Resources");
+    this->SetDesc("display resource residency and budgets");
+    this->SetRootLocation("resource");
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+ResourcePageHandler::HandleRequest(const GPtr<HttpRequest>& request)
+{
+    n_assert(HttpMethod::Get == request->GetMethod());
+
+    // configure a HTML page writer
+    GPtr<HtmlPageWriter> htmlWriter = HtmlPageWriter::Create();
+    htmlWriter->SetStream(request->GetResponseContentStream());
+    htmlWriter->SetTitle("Genesis Resource Info");
+    if (htmlWriter->Open())
+    {
+        htmlWriter->Element(HtmlElement::Heading1, "Genesis Resources");
+        htmlWriter->AddAttr("href", "/index.html");
+        htmlWriter->Element(HtmlElement::Anchor, "Home");
+
+        if (!ResourceServer::HasInstance())
+        {
+            htmlWriter->LineBreak();
+            htmlWriter->LineBreak();
+            htmlWriter->Text("ResourceServer not created!");
+        }
+        else
+        {
+            ResourceServer* resServer = ResourceServer::Instance();
+            htmlWriter->Element(HtmlElement::Heading3, "Residency");
+            htmlWriter->Text("Last update at frame " + String::FromInt(resServer->GetFrameIndex()));
+
+            htmlWriter->AddAttr("border", "1");
+            htmlWriter->AddAttr("rules", "cols");
+            htmlWriter->Begin(HtmlElement::Table);
+                htmlWriter->AddAttr("bgcolor", "lightsteelblue");
+                htmlWriter->Begin(HtmlElement::TableRow);
+                    htmlWriter->Element(HtmlElement::TableHeader, "Type");
+                    htmlWriter->Element(HtmlElement::TableHeader, "Budget (KB)");
+                    htmlWriter->Element(HtmlElement::TableHeader, "Resident (KB)");
+                    htmlWriter->Element(HtmlElement::TableHeader, "Resident Count");
+                    htmlWriter->Element(HtmlElement::TableHeader, "Evicted Count");
+                    htmlWriter->Element(HtmlElement::TableHeader, "Evicted (KB)");
+                htmlWriter->End(HtmlElement::TableRow);
+
+                const Array<ResourceServer::ResidencyStats>& stats = resServer->GetResidencyStats();
+                IndexT i;
+                for (i = 0; i < stats.Size(); i++)
+                {
+                    const ResourceServer::ResidencyStats& cur = stats[i];
+                    htmlWriter->Begin(HtmlElement::TableRow);
+                        htmlWriter->Element(HtmlElement::TableData, cur.resType->GetName());
+                        htmlWriter->Element(HtmlElement::TableData, cur.budget > 0 ? String::FromInt(cur.budget / 1024) : String("unlimited"));
+                        htmlWriter->Element(HtmlElement::TableData, String::FromInt(cur.residentBytes / 1024));
+                        htmlWriter->Element(HtmlElement::TableData, String::FromInt(cur.numResident));
+                        htmlWriter->Element(HtmlElement::TableData, String::FromInt(cur.numEvicted));
+                        htmlWriter->Element(HtmlElement::TableData, String::FromInt(cur.evictedBytes / 1024));
+                    htmlWriter->End(HtmlElement::TableRow);
+                }
+            htmlWriter->End(HtmlElement::Table);
+
+            htmlWriter->Element(HtmlElement::Heading3, "Load Pipeline");
+            htmlWriter->AddAttr("border", "1");
+            htmlWriter->AddAttr("rules", "cols");
+            htmlWriter->Begin(HtmlElement::Table);
+                htmlWriter->AddAttr("bgcolor", "lightsteelblue");
+                htmlWriter->Begin(HtmlElement::TableRow);
+                    htmlWriter->Element(HtmlElement::TableHeader, "Stage");
+                    htmlWriter->Element(HtmlElement::TableHeader, "Depth");
+                    htmlWriter->Element(HtmlElement::TableHeader, "Completed");
+                    htmlWriter->Element(HtmlElement::TableHeader, "Avg (ms)");
+                    htmlWriter->Element(HtmlElement::TableHeader, "Max (ms)");
+                htmlWriter->End(HtmlElement::TableRow);
+
+                for (i = 0; i < ResourceServer::NumPipelineStages; i++)
+                {
+                    ResourceServer::PipelineStage stage = (ResourceServer::PipelineStage)i;
+                    const ResourceServer::PipelineStageStats& cur = resServer->GetPipelineStats(stage);
+                    Timing::Time avg = cur.completed > 0 ? cur.totalTime / cur.completed : 0.0;
+                    htmlWriter->Begin(HtmlElement::TableRow);
+                        htmlWriter->Element(HtmlElement::TableData, ResourceServer::GetPipelineStageName(stage));
+                        htmlWriter->Element(HtmlElement::TableData, String::FromInt(cur.depth));
+                        htmlWriter->Element(HtmlElement::TableData, String::FromInt(cur.completed));
+                        htmlWriter->Element(HtmlElement::TableData, String::FromFloat(float(avg * 1000.0)));
+                        htmlWriter->Element(HtmlElement::TableData, String::FromFloat(float(cur.maxTime * 1000.0)));
+                    htmlWriter->End(HtmlElement::TableRow);
+                }
+            htmlWriter->End(HtmlElement::Table);
+        }
+        htmlWriter->Close();
+        request->SetStatus(HttpStatus::OK);
+    }
+    else
+    {
+        request->SetStatus(HttpStatus::InternalServerError);
+    }
+}
+
+} // namespace Debug
@@ -0,0 +1,121 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "resource/resource_stdneb.h"
+#include "resource/debug/texturedecodebenchmark.h"
+#include "resource/DXTextureDecompress.h"
+#include "util/fixedarray.h"
+#include "timing/timer.h"
+
+namespace Debug
+{
+using namespace Util;
+using namespace Resources;
+
+//------------------------------------------------------------------------------
+/**
+    Fills the blocks with a fixed pseudo random sequence.
+*/
+static void
+FillBlocks(FixedArray<uint32>& blocks)
+{
+    uint32 seed = 0x12345678;
+    IndexT i;
+    for (i = 0; i < blocks.Size(); i++)
+    {
+        seed = seed * 1664525 + 1013904223;
+        blocks[i] = seed;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Decodes the image num times, with the given parallel threshold.
+*/
+static void
+RunCase(Array<TextureDecodeBenchmark::Result>& results, const char* name, int flags, SizeT bytesPerBlock, 
+        SizeT size, SizeT num, SizeT threshold)
+{
+    FixedArray<uint32> blocks((size / 4) * (size / 4) * bytesPerBlock / sizeof(uint32));
+    FillBlocks(blocks);
+    FixedArray<uint32> pixels(size * size);
+
+    const SizeT oldThreshold = DXTextureDecompress::GetParallelThreshold();
+    DXTextureDecompress::SetParallelThreshold(threshold);
+    Timing::Timer timer;
+    timer.Start();
+    IndexT i;
+    for (i = 0; i < num; i++)
+    {
+        DXTextureDecompress::DecompressImage(pixels.Begin(), size, size, blocks.Begin(), flags);
+    }
+    timer.Stop();
+    DXTextureDecompress::SetParallelThreshold(oldThreshold);
+
+    TextureDecodeBenchmark::Result& result = results.EmplaceBack();
+    result.name = name;
+    result.iterations = num;
+    result.pixels = size * size;
+    result.time = timer.GetTime();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+Array<TextureDecodeBenchmark::Result>
+TextureDecodeBenchmark::Run(SizeT scale)
+{
+    n_assert(scale > 0);
+    Array<Result> results;
+    const SizeT size = 1024;
+    const SizeT num = 8 * scale;
+    const SizeT serial = size * size + 1;
+    const SizeT parallel = DXTextureDecompress::GetParallelThreshold();
+
+    RunCase(results, "DXT1", squish::kDxt1, 8, size, num, serial);
+    RunCase(results, "DXT5", squish::kDxt5, 16, size, num, serial);
+    RunCase(results, "ETC1", DXTextureDecompress::kEtc1, 8, size, num, serial);
+    RunCase(results, "DXT1(jobs)", squish::kDxt1, 8, size, num, parallel);
+    RunCase(results, "DXT5(jobs)", squish::kDxt5, 16, size, num, parallel);
+    RunCase(results, "ETC1(jobs)", DXTextureDecompress::kEtc1, 8, size, num, parallel);
+    return results;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+TextureDecodeBenchmark::Print(const Array<Result>& results)
+{
+    n_printf("TextureDecodeBenchmark:\n");
+    IndexT i;
+    for (i = 0; i < results.Size(); i++)
+    {
+        const Result& result = results[i];
+        const double mpixels = double(result.iterations) * double(result.pixels) / 1000000.0;
+        n_printf("  %-32s %8d images %10.3f ms %10.1f MPixel/s\n", result.name, result.iterations, result.time * 1000.0,
+            result.time > 0.0 ? mpixels / result.time : 0.0);
+    }
+}
+
+} // namespace Debug
@@ -0,0 +1,62 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __texturedecodebenchmark_H__
+#define __texturedecodebenchmark_H__
+//------------------------------------------------------------------------------
+/**
+    @class Debug::TextureDecodeBenchmark
+    
+    Decode throughput of Resources::DXTextureDecompress for DXT1, DXT5 and
+    ETC1 images, on the calling thread and split over the job system. The
+    blocks are pseudo random, so every palette path is taken. Results have
+    the same layout as Debug::ContainerBenchmark.
+*/
+#include "core/types.h"
+#include "util/array.h"
+#include "timing/time.h"
+
+//------------------------------------------------------------------------------
+namespace Debug
+{
+class TextureDecodeBenchmark
+{
+public:
+    /// result of a single benchmark case
+    struct Result
+    {
+        const char* name;
+        SizeT iterations;   // images decoded
+        SizeT pixels;       // pixels per image
+        Timing::Time time;
+    };
+
+    /// run all benchmark cases, scale multiplies the iteration counts
+    static Util::Array<Result> Run(SizeT scale = 1);
+    /// write results to the log
+    static void Print(const Util::Array<Result>& results);
+};
+
+} // namespace Debug
+//------------------------------------------------------------------------------
+#endif // __texturedecodebenchmark_H__
@@ -234,7 +234,8 @@ namespace Resources
 				 mPixelFormat == RenderBase::PixelFormat::DXT2 ||
 				 mPixelFormat == RenderBase::PixelFormat::DXT3 ||
 				 mPixelFormat == RenderBase::PixelFormat::DXT4 ||
-				 mPixelFormat == RenderBase::PixelFormat::DXT5 )
+				 mPixelFormat == RenderBase::PixelFormat::DXT5 ||
+				 mPixelFormat == RenderBase::PixelFormat::ETC1_RGB8 )
 			{
 				if ( !mData.isvalid() || !mData->Ptr())
 				{
@@ -242,8 +243,6 @@ namespace Resources
 					return false;
 				}
 
-				// dds format min mipmapsize is 4
-				const int minMipmapSize = 4; 
 				int mipmapW = width >> mipLevel;
 				int mipmapH = height >> mipLevel;
 
@@ -260,22 +259,8 @@ namespace Resources
 				//
 				ubyte* data = mData->Ptr() +  totalOffset;
 				
-				if (mipmapW % minMipmapSize == 0 && mipmapH % minMipmapSize == 0)
-				{
-					_DecompressDDSTextureFormat( mPixelFormat, mipmapW, mipmapH, reinterpret_cast<const uint32*>(data), reinterpret_cast<uint32*>(pixels) );
-					return true;
-				}
-				else
-				{
-					// target mipmap width or height size not be multipled 4,but dds format must be 4x4 block.
-					int nMultiped16 = ( (mipmapW + 3)/4 ) * ( (mipmapH + 3)/4 ) * 16;
-					uint32* tmpColorBuf = n_new_array(uint32,nMultiped16);
-					_DecompressDDSTextureFormat( mPixelFormat, mipmapW, mipmapH, reinterpret_cast<const uint32*>(data), tmpColorBuf);
-					memcpy(reinterpret_cast<uint32*>(pixels),tmpColorBuf,sizeof(uint32)*mipmapW*mipmapH);
-
-					n_delete_array(tmpColorBuf);
-					return true;
-				}
+				// the decoder clips the 4x4 blocks, mipmaps smaller than a block go straight to the target as well
+				return _DecompressDDSTextureFormat( mPixelFormat, mipmapW, mipmapH, reinterpret_cast<const uint32*>(data), reinterpret_cast<uint32*>(pixels) );
 			} 
 			else
 			{
@@ -331,8 +316,6 @@ namespace Resources
 	bool ImageRes::_DecompressDDSTextureFormat( const RenderBase::PixelFormat::Code srcFormat, const int srcWidth, const int srcHeight, 
 		const uint32* sourceData, uint32* destData )
 	{
-		n_assert(srcWidth%4 == 0 && srcHeight%4 == 0);
-
 		int flags(1);
 		switch( srcFormat )
 		{
@@ -345,6 +328,9 @@ namespace Resources
 		case RenderBase::PixelFormat::DXT5:
 			flags = squish::kDxt5;
 			break;
+		case RenderBase::PixelFormat::ETC1_RGB8:
+			flags = DXTextureDecompress::kEtc1;
+			break;
 		default:
 			{
 				n_assert2(0,"now not support other dds compress format!");
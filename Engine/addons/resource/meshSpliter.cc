@@ -24,6 +24,15 @@ THE SOFTWARE.
 #include "stdneb.h"
 #include "meshSpliter.h"
 #include "RenderSystem.h"
+#include "io/binarywriter.h"
+#include "io/binaryreader.h"
+#include "io/iointerfaceprotocol.h"
+#include "io/iointerface.h"
+#include "io/memorystream.h"
+#include "timing/timer.h"
+#include "util/crc.h"
+#include "util/fourcc.h"
+#include <algorithm>
 
 //#define __DEBUG_MESHSPLITER__
 //#define __DEBUG_MESHSPLITER_Print__
@@ -32,12 +41,20 @@ namespace Resources
 	//---------------------------------------------------------------------
 	__ImplementClass(MeshSpliter,'MHSP',Core::RefCounted);
 	__ImplementImageSingleton(MeshSpliter);
+
+	// 3 vertices, 4 bones each
+	static const int MaxBonesByTri = 12;
+	static const Util::FourCC sCacheMagic('MSPC');
+	// magic, version, key, submesh count
+	static const SizeT sCacheHeaderSize = 4 * sizeof(uint);
 	//---------------------------------------------------------------------
 	MeshSpliter::MeshSpliter():mMaxBoneBySubmesh( (128-16)/4 ),
-		mbInit(false)
+		mbInit(false),
+		mbCacheEnabled(true),
+		mbCacheWriteBack(true)
 	{
 		__ConstructImageSingleton;
-		
+		Memory::Clear(&mStats, sizeof(mStats));
 	}
 	MeshSpliter::~MeshSpliter()
 	{
@@ -50,7 +67,7 @@ namespace Resources
 			return;
 		}
 		mbInit = true;
-#if RENDERDEVICE_OPENGLES		
+#if RENDERDEVICE_OPENGLES && !RENDERDEVICE_HEADLESS
 		const RenderBase::GraphicCardCapability& caps = RenderBase::RenderSystem::Instance()->GetGraphicCardCapability();
 		mMaxBoneBySubmesh = (caps.mMaxUniformVectors-16)/4;
 #else
@@ -69,23 +86,22 @@ namespace Resources
 		{
 			return;
 		}
-		mMeshRes=pMesh;
 
 		//debug=============
 		n_printf("meshID %s===================================\n",pMesh->GetMeshID().Get());
 		n_printf("submesh===================================\n");
-		for ( IndexT i = 0; i < mMeshRes->mSubMeshs.Size(); i++ )
+		for ( IndexT i = 0; i < pMesh->mSubMeshs.Size(); i++ )
 		{
 			n_printf("sub%d: 		\n",i);
-			n_printf("first index %d\n",mMeshRes->mSubMeshs[i].FirstIndex);
-			n_printf("number index %d\n",mMeshRes->mSubMeshs[i].numIndex);
-			n_printf("first vertex %d\n",mMeshRes->mSubMeshs[i].firstVertex);
-			n_printf("number vertex %d:\n",mMeshRes->mSubMeshs[i].numVertex);
+			n_printf("first index %d\n",pMesh->mSubMeshs[i].FirstIndex);
+			n_printf("number index %d\n",pMesh->mSubMeshs[i].numIndex);
+			n_printf("first vertex %d\n",pMesh->mSubMeshs[i].firstVertex);
+			n_printf("number vertex %d:\n",pMesh->mSubMeshs[i].numVertex);
 		}
 		n_printf("affected bone===================================\n");
-		for ( IndexT i = 0; i < mMeshRes->mAffectedBonesIndex.Size(); i++  )
+		for ( IndexT i = 0; i < pMesh->mAffectedBonesIndex.Size(); i++  )
 		{
-			Util::Array<uchar> affectedIdx = mMeshRes->mAffectedBonesIndex[i];
+			Util::Array<uchar> affectedIdx = pMesh->mAffectedBonesIndex[i];
 			n_printf("sub%d------------------		\n",i);
 			for ( IndexT j = 0; j < affectedIdx.Size(); j++ )
 			{
@@ -94,12 +110,12 @@ namespace Resources
 			}
 		}
 		n_printf("bone info===================================\n");
-		for ( IndexT i = 0; i < mMeshRes->mBoneInfo.Size(); i++ )
+		for ( IndexT i = 0; i < pMesh->mBoneInfo.Size(); i++ )
 		{
 			n_printf("mBoneInfo[%d]: ",i);
 			for ( IndexT j = 0; j < 4; j++ )
 			{
-				IndexT val = mMeshRes->mBoneInfo[i].boneIndex[j];
+				IndexT val = pMesh->mBoneInfo[i].boneIndex[j];
 				n_printf("%d	",val);
 
 			}
@@ -107,11 +123,11 @@ namespace Resources
 		}
 
 		n_printf("IB ===================================\n");
-		for ( IndexT i = 0; i < mMeshRes->mIndex16.Size(); i++ )
+		for ( IndexT i = 0; i < pMesh->mIndex16.Size(); i++ )
 		{
 			n_printf("Index16: ");
 
-			IndexT val = mMeshRes->mIndex16[i];
+			IndexT val = pMesh->mIndex16[i];
 			n_printf("%d	",val);
 
 
@@ -119,11 +135,11 @@ namespace Resources
 		}
 
 		/*	n_printf("VB ===================================\n");
-		for ( IndexT i = 0; i < mMeshRes->mPosition.Size(); i++ )
+		for ( IndexT i = 0; i < pMesh->mPosition.Size(); i++ )
 		{
 		n_printf("vbData: ");
 
-		Math::float3& v3Val =  mMeshRes->mPosition[i];
+		Math::float3& v3Val =  pMesh->mPosition[i];
 		n_printf("%f,%f,%f	\n",v3Val.x(),v3Val.y(),v3Val.z());
 		}*/
 
@@ -132,7 +148,8 @@ namespace Resources
 	}
 	void MeshSpliter::DoWork(GPtr<MeshRes>& pMesh)
 	{
-#if RENDERDEVICE_OPENGLES
+		// headless servers split as well, so submesh counts and split times can be compared without a device
+#if RENDERDEVICE_OPENGLES || RENDERDEVICE_HEADLESS
 
 
 
@@ -157,18 +174,6 @@ namespace Resources
 
 		
 #endif
-
-		DoWork_1(pMesh);
-#ifdef __DEBUG_MESHSPLITER__
-		n_printf("meshspliter after======================\n");
-		DebugPrint(pMesh);
-#endif
-#endif
-
-	}
-	//------------------------------------------------------------------------
-	void MeshSpliter::DoWork_1(GPtr<MeshRes>& pMesh)
-	{
 		if ( pMesh->GetAffectedBonesIndex(0).Size() == 0 )
 		{
 			return;
@@ -177,14 +182,38 @@ namespace Resources
 		{
 			return;
 		}
-		
-		mMeshRes=pMesh;
 
-		mSubmeshMapWorkPart.Clear();
+		Timing::Timer timer;
+		timer.Start();
+
+		const SizeT oldSubmeshCount = pMesh->GetSubMeshCount();
+		MeshPartition partition;
+		uint key = 0;
+		bool bCached = false;
+		if ( mbCacheEnabled )
+		{
+			key = ComputeCacheKey(pMesh);
+			bCached = _LoadPartition(key, pMesh, partition);
+		}
+		if ( !bCached )
+		{
+			for ( IndexT i = 0; i < oldSubmeshCount; ++i )
+			{
+				if ( pMesh->GetAffectedBonesIndex(i).Size() > mMaxBoneBySubmesh )
+				{
+					partition.Append(SubmeshPartition());
+					_PartitionSubmesh(pMesh, i, partition.Back());
+				}
+			}
+			if ( mbCacheEnabled )
+			{
+				_StorePartition(key, partition);
+			}
+		}
+
+		// reorders the index buffer, so it goes before the workspace copies it
 		SubMeshArray allSubMeshArray;
-		bool bSuc(false);
-		bSuc = _SplitMesh(mMeshRes,allSubMeshArray);		
-		if ( !bSuc )
+		if ( !_ApplyPartition(pMesh, partition, allSubMeshArray) )
 		{
 			return;
 		}
@@ -195,25 +224,31 @@ namespace Resources
 		DebugPrint(pMesh);
 #endif
 		MeshReviseWorkspace workspace;
-		workspace.Init(mMeshRes);
+		workspace.Init(pMesh);
 
-		// update AffectedBonesIndex
-		//_UpdateAffectedBonesIndex(mMeshRes->mSubMeshs,workspace);	
+		_RestoreRawBoneInfo(pMesh,pMesh->mSubMeshs,workspace);
 
-		_RestoreRawBoneInfo(mMeshRes->mSubMeshs,workspace);
+		_SplitVertexs(pMesh,allSubMeshArray,workspace);
+
+		pMesh->mSubMeshs.Swap(allSubMeshArray);
+		timer.Stop();
+
+		mCacheLock.Enter();
+		++mStats.meshesSplit;
+		mStats.submeshesIn += oldSubmeshCount;
+		mStats.submeshesOut += pMesh->GetSubMeshCount();
+		mStats.splitTime += timer.GetTime();
+		mCacheLock.Leave();
+#ifdef __DEBUG_MESHSPLITER__
+		n_printf("meshspliter after======================\n");
+		DebugPrint(pMesh);
+#endif
+#endif
 
-		_SplitVertexs(allSubMeshArray,workspace);
-		
-		//update 
-		//debug start==============================
-		//allSubMeshArray.EraseIndex(1);
-		//mMeshRes->mSummeshUsedMaterial[0] = 0;
-		//debug end==============================
-		mMeshRes->mSubMeshs.Swap(allSubMeshArray);
 	}
 
 	//-------------------------------------------------------------------------
-	bool  MeshSpliter::_IsNeedSplit(GPtr<MeshRes>& pMesh)
+	bool  MeshSpliter::_IsNeedSplit(const GPtr<MeshRes>& pMesh) const
 	{
 		SizeT oldSubmeshCount =pMesh->GetSubMeshCount();
 		for ( SizeT i = 0; i < oldSubmeshCount; ++i )
@@ -229,123 +264,495 @@ namespace Resources
 	}
 
 	//--------------------------------------------------------------------------
-	bool MeshSpliter::_SplitMesh(GPtr<MeshRes>& pMesh,SubMeshArray& mergeResult)
-	{	
-		bool bSuc(false);
-		SizeT oldSubmeshCount =pMesh->GetSubMeshCount();
-		for ( SizeT i = 0; i < oldSubmeshCount; ++i )
+	void MeshSpliter::_PartitionSubmesh(const GPtr<MeshRes>& pMesh, IndexT iSubmesh, SubmeshPartition& outPartition) const
+	{
+		const SubMesh& submesh = pMesh->mSubMeshs[iSubmesh];
+		n_assert(submesh.numIndex%3 == 0);
+		const SizeT numTris  = submesh.numIndex / 3;
+		const SizeT numBones = pMesh->mAffectedBonesIndex[iSubmesh].Size();
+
+		// the distinct bones of every triangle, the boneInfo indices are local to the submesh
+		Util::Array<ushort> triBones;
+		Util::Array<uchar>  triBoneCount;
+		Util::Array<IndexT> boneTriStart;
+		triBones.Resize(numTris * MaxBonesByTri, 0);
+		triBoneCount.Resize(numTris, 0);
+		boneTriStart.Resize(numBones + 1, 0);
+		for ( IndexT iTri = 0; iTri < numTris; ++iTri )
 		{
-			SubMesh* pSubMesh= pMesh->GetSubMesh(i);
-			Util::Array<uchar>& affectdBones = pMesh->GetAffectedBonesIndex(i);
-			bSuc |= _TrySplitSubmesh(i,pSubMesh,affectdBones);
+			ushort* bones = &triBones[iTri * MaxBonesByTri];
+			uchar count = 0;
+			for ( IndexT iVet = 0; iVet < 3; ++iVet )
+			{
+				const BoneInfo& info = pMesh->mBoneInfo[_GetVertexIndex(pMesh, submesh.FirstIndex + iTri * 3 + iVet)];
+				for ( int i = 0; i < 4; ++i )
+				{
+					const ushort bone = info.boneIndex[i];
+					n_assert(bone < numBones);
+					bool bFound = false;
+					for ( uchar j = 0; j < count && !bFound; ++j )
+					{
+						bFound = (bones[j] == bone);
+					}
+					if ( !bFound )
+					{
+						bones[count++] = bone;
+						++boneTriStart[bone + 1];
+					}
+				}
+			}
+			triBoneCount[iTri] = count;
 		}
 
-		// submeshϲ		
-		_MergeSubmeshes(mergeResult,mSubmeshMapWorkPart);		
-
-		// add materialIdx used by submesh
-		mMeshRes->mSummeshUsedMaterial.Resize(oldSubmeshCount,1);
-		for ( SizeT i = 0; i < oldSubmeshCount; ++i )
+		// the triangles using every bone
+		for ( IndexT iBone = 0; iBone < numBones; ++iBone )
+		{
+			boneTriStart[iBone + 1] += boneTriStart[iBone];
+		}
+		Util::Array<IndexT> boneTris;
+		Util::Array<IndexT> boneTriFill(boneTriStart);
+		boneTris.Resize(boneTriStart[numBones], 0);
+		for ( IndexT iTri = 0; iTri < numTris; ++iTri )
 		{
-			IndexT keyIdx = mSubmeshMapWorkPart.FindIndex(i);
-			if ( keyIdx != InvalidIndex  )
-			{// 
-				mMeshRes->mSummeshUsedMaterial[i] = mSubmeshMapWorkPart[i].Size();
-			} 			
+			for ( uchar j = 0; j < triBoneCount[iTri]; ++j )
+			{
+				boneTris[boneTriFill[triBones[iTri * MaxBonesByTri + j]]++] = iTri;
+			}
 		}
 
-		return bSuc;		
+		// fill one new submesh at a time: start at the first triangle left, then keep taking the triangle
+		// which adds the fewest bones the submesh doesn't use yet, until no triangle fits the budget anymore.
+		// missing[] counts the bones a triangle would add, buckets[k] holds the triangles with k missing
+		// bones; entries go stale when the count drops and are skipped when taken.
+		Util::Array<uchar>  missing;
+		Util::Array<bool>   placed;
+		Util::Array<IndexT> boneInBin;
+		Util::Array<IndexT> buckets[MaxBonesByTri + 1];
+		missing.Resize(numTris, 0);
+		placed.Resize(numTris, false);
+		boneInBin.Resize(numBones, InvalidIndex);
+
+		outPartition.submesh = iSubmesh;
+		outPartition.triangles.Clear();
+		outPartition.triangles.Reserve(numTris);
+		outPartition.binSizes.Clear();
+
+		IndexT firstLeft = 0;
+		for ( IndexT iBin = 0; outPartition.triangles.Size() < numTris; ++iBin )
+		{
+			for ( IndexT k = 0; k <= MaxBonesByTri; ++k )
+			{
+				buckets[k].Clear(false);
+			}
+			for ( IndexT iTri = firstLeft; iTri < numTris; ++iTri )
+			{
+				if ( !placed[iTri] )
+				{
+					missing[iTri] = triBoneCount[iTri];
+					buckets[missing[iTri]].Append(iTri);
+				}
+			}
+			while ( placed[firstLeft] )
+			{
+				++firstLeft;
+			}
+
+			const IndexT binStart = outPartition.triangles.Size();
+			SizeT binBones = 0;
+			IndexT next = firstLeft;
+			while ( InvalidIndex != next )
+			{
+				placed[next] = true;
+				outPartition.triangles.Append(next);
+				for ( uchar j = 0; j < triBoneCount[next]; ++j )
+				{
+					const ushort bone = triBones[next * MaxBonesByTri + j];
+					if ( boneInBin[bone] == iBin )
+					{
+						continue;
+					}
+					boneInBin[bone] = iBin;
+					++binBones;
+					for ( IndexT t = boneTriStart[bone]; t < boneTriStart[bone + 1]; ++t )
+					{
+						const IndexT iTri = boneTris[t];
+						if ( !placed[iTri] )
+						{
+							--missing[iTri];
+							buckets[missing[iTri]].Append(iTri);
+						}
+					}
+				}
+
+				next = InvalidIndex;
+				for ( IndexT k = 0; k <= MaxBonesByTri && binBones + k <= (SizeT)mMaxBoneBySubmesh && InvalidIndex == next; ++k )
+				{
+					Util::Array<IndexT>& bucket = buckets[k];
+					while ( !bucket.IsEmpty() )
+					{
+						const IndexT iTri = bucket.Back();
+						bucket.EraseIndex(bucket.Size() - 1);
+						if ( !placed[iTri] && missing[iTri] == k )
+						{
+							next = iTri;
+							break;
+						}
+					}
+				}
+			}
+
+			// keep the original order inside the new submesh for the vertex cache
+			std::sort(outPartition.triangles.Begin() + binStart, outPartition.triangles.End());
+			outPartition.binSizes.Append(outPartition.triangles.Size() - binStart);
+		}
 	}
-	bool MeshSpliter::_TrySplitSubmesh(int iSubmesh,SubMesh* pSubmesh,Util::Array<uchar>& affectdBones)
+	//--------------------------------------------------------------------------
+	bool MeshSpliter::_ApplyPartition(GPtr<MeshRes>& pMesh, const MeshPartition& partition, SubMeshArray& outResult)
 	{
-		int nSubmesh_bones = affectdBones.Size();
-		if ( nSubmesh_bones <= mMaxBoneBySubmesh )
-		{// no need split
-			return false;
-		}
+		SubMeshArray& oldSubmesh = pMesh->mSubMeshs;
+		const SizeT oldSubmeshCount = oldSubmesh.Size();
+		bool bSplit = false;
+		IndexT iPart = 0;
+		Util::Array<IndexT> rawIndices;
 
-		// ѭ		
-		int		numIndex				= pSubmesh->numIndex;
-		IndexT	begin					= pSubmesh->FirstIndex;
-		IndexT	end						= begin + pSubmesh->numIndex;
-		int		curIndexByNewSubmesh	= begin;
-		n_assert(numIndex%3 == 0);
-		
-		Util::FixedArray<uint> aVertex;
-		aVertex.Resize(3);		
-		SubMeshArray aSubmesh;
-		StdSetHelper helperSet;
-
-		//ΪλжǷ񳬳subMesh
-		for (IndexT iIndex = begin; iIndex < end; iIndex += 3)
+		// add materialIdx used by submesh
+		pMesh->mSummeshUsedMaterial.Resize(oldSubmeshCount,1);
+		for ( IndexT i = 0; i < oldSubmeshCount; i++ )
 		{
-			aVertex[0] = _GetVertexIndex(iIndex);
-			aVertex[1] = _GetVertexIndex(iIndex+1);
-			aVertex[2] = _GetVertexIndex(iIndex+2);
-
-			if ( _IsOverMaxBonesByTri(aVertex,helperSet) )
+			if ( iPart < partition.Size() && partition[iPart].submesh == i && partition[iPart].binSizes.Size() > 1 )
 			{
-				// add one new submesh
-				SubMesh newSubmesh;
-				newSubmesh.FirstIndex = curIndexByNewSubmesh;
-				//newSubmesh.numIndex   = (iIndex - 1) - curIndexByNewSubmesh + 1;
-				newSubmesh.numIndex   = (iIndex-1) - curIndexByNewSubmesh + 1;
+				const SubmeshPartition& part = partition[iPart];
+				const SubMesh& sub = oldSubmesh[i];
+
+				rawIndices.Clear(false);
+				for ( IndexT iIndex = 0; iIndex < sub.numIndex; ++iIndex )
+				{
+					rawIndices.Append(_GetVertexIndex(pMesh, sub.FirstIndex + iIndex));
+				}
+				for ( IndexT iTri = 0; iTri < part.triangles.Size(); ++iTri )
+				{
+					for ( IndexT iVet = 0; iVet < 3; ++iVet )
+					{
+						_SetVertexIndex(pMesh, sub.FirstIndex + iTri * 3 + iVet, rawIndices[part.triangles[iTri] * 3 + iVet]);
+					}
+				}
 
-				curIndexByNewSubmesh  = newSubmesh.FirstIndex + newSubmesh.numIndex;
+				IndexT firstIndex = sub.FirstIndex;
+				for ( IndexT iBin = 0; iBin < part.binSizes.Size(); ++iBin )
+				{
+					SubMesh newSubmesh;
+					newSubmesh.FirstIndex = firstIndex;
+					newSubmesh.numIndex   = part.binSizes[iBin] * 3;
+					firstIndex += newSubmesh.numIndex;
+					outResult.Append(newSubmesh);
+				}
+				pMesh->mSummeshUsedMaterial[i] = part.binSizes.Size();
+				bSplit = true;
+			}
+			else
+			{// keep the old submesh
+				outResult.Append(oldSubmesh[i]);
+			}
 
-				aSubmesh.Append(newSubmesh);
-				helperSet.clear();
-				iIndex -= 3;
+			if ( iPart < partition.Size() && partition[iPart].submesh == i )
+			{
+				++iPart;
+			}
+		}
+		return bSplit;
+	}
+	//--------------------------------------------------------------------------
+	uint MeshSpliter::ComputeCacheKey(const GPtr<MeshRes>& pMesh) const
+	{
+		Util::Crc crc;
+		crc.Begin();
+		if ( pMesh->IsUseIndex16() )
+		{
+			if ( pMesh->mIndex16.Size() > 0 )
+			{
+				crc.Compute((unsigned char*)&pMesh->mIndex16[0], pMesh->mIndex16.Size() * sizeof(Index16Container::value_type));
 			}
 		}
+		else if ( pMesh->mIndex32.Size() > 0 )
+		{
+			crc.Compute((unsigned char*)&pMesh->mIndex32[0], pMesh->mIndex32.Size() * sizeof(Index32Container::value_type));
+		}
+		if ( pMesh->mBoneInfo.Size() > 0 )
+		{
+			crc.Compute((unsigned char*)&pMesh->mBoneInfo[0], pMesh->mBoneInfo.Size() * sizeof(BoneInfo));
+		}
+		for ( IndexT i = 0; i < pMesh->mSubMeshs.Size(); ++i )
+		{
+			uint submesh[3] = { (uint)pMesh->mSubMeshs[i].FirstIndex, (uint)pMesh->mSubMeshs[i].numIndex, (uint)pMesh->GetAffectedBonesIndex(i).Size() };
+			crc.Compute((unsigned char*)submesh, sizeof(submesh));
+		}
+		uint tail[2] = { CacheVersion, (uint)mMaxBoneBySubmesh };
+		crc.Compute((unsigned char*)tail, sizeof(tail));
+		crc.End();
+		return crc.GetResult();
+	}
+	//--------------------------------------------------------------------------
+	Util::String MeshSpliter::GetCachePath(uint key)
+	{
+		Util::String path;
+		path.Format("user:cache/meshsplit/%08x.msc", key);
+		return path;
+	}
+	//--------------------------------------------------------------------------
+	Util::String MeshSpliter::GetCookedCachePath(uint key)
+	{
+		Util::String path;
+		path.Format("asset:cache/meshsplit/%08x.msc", key);
+		return path;
+	}
+	//--------------------------------------------------------------------------
+	void MeshSpliter::SetMaxBoneBySubmesh(int maxBones)
+	{
+		n_assert(maxBones >= MaxBonesByTri);
+		mMaxBoneBySubmesh = maxBones;
+		mbInit = true;
+	}
+	//--------------------------------------------------------------------------
+	void MeshSpliter::SetCacheEnabled(bool b)
+	{
+		mbCacheEnabled = b;
+	}
+	//--------------------------------------------------------------------------
+	bool MeshSpliter::IsCacheEnabled() const
+	{
+		return mbCacheEnabled;
+	}
+	//--------------------------------------------------------------------------
+	void MeshSpliter::SetCacheWriteBack(bool b)
+	{
+		mbCacheWriteBack = b;
+	}
+	//--------------------------------------------------------------------------
+	bool MeshSpliter::IsCacheWriteBack() const
+	{
+		return mbCacheWriteBack;
+	}
+	//--------------------------------------------------------------------------
+	void MeshSpliter::ClearCache()
+	{
+		mCacheLock.Enter();
+		mCache.Clear();
+		mCacheLock.Leave();
+	}
+	//--------------------------------------------------------------------------
+	MeshSplitStats MeshSpliter::GetStats()
+	{
+		mCacheLock.Enter();
+		MeshSplitStats stats = mStats;
+		mCacheLock.Leave();
+		return stats;
+	}
+	//--------------------------------------------------------------------------
+	void MeshSpliter::ResetStats()
+	{
+		mCacheLock.Enter();
+		Memory::Clear(&mStats, sizeof(mStats));
+		mCacheLock.Leave();
+	}
+	//--------------------------------------------------------------------------
+	bool MeshSpliter::_LoadPartition(uint key, const GPtr<MeshRes>& pMesh, MeshPartition& outPartition)
+	{
+		mCacheLock.Enter();
+		IndexT found = mCache.FindIndex(key);
+		if ( InvalidIndex != found )
+		{
+			outPartition = mCache.ValueAtIndex(found);
+			++mStats.cacheHits;
+			mCacheLock.Leave();
+			return true;
+		}
+		mCacheLock.Leave();
 
-		// old submesh Ϊnew submesh ʣƬsubmesh
-		IndexT endIdxByOldSubmesh = pSubmesh->FirstIndex + pSubmesh->numIndex -1;
-		if ( curIndexByNewSubmesh-1 < endIdxByOldSubmesh)
-		{//Ƭ
-			// add  one new submesh by left
-			SubMesh newSubmesh;
-			newSubmesh.FirstIndex = curIndexByNewSubmesh ;
-			newSubmesh.numIndex   = endIdxByOldSubmesh - newSubmesh.FirstIndex + 1;
-			aSubmesh.Append(newSubmesh);
+		// a cache file written on this device first, then one cooked into the project
+		bool bLoaded = _ReadPartitionFile(GetCachePath(key), key, pMesh, outPartition);
+		if ( !bLoaded )
+		{
+			outPartition.Clear();
+			bLoaded = _ReadPartitionFile(GetCookedCachePath(key), key, pMesh, outPartition);
 		}
 
-		n_assert(aSubmesh.Size() >= 2); //Ȼһ2
-		if ( aSubmesh.Size() > 0 )
+		mCacheLock.Enter();
+		if ( bLoaded )
+		{
+			if ( !mCache.Contains(key) )
+			{
+				mCache.Add(key, outPartition);
+			}
+			++mStats.cacheHits;
+		}
+		else
 		{
-			mSubmeshMapWorkPart.Add(iSubmesh,aSubmesh);
+			outPartition.Clear();
+			++mStats.cacheMisses;
 		}
-		return true;
+		mCacheLock.Leave();
+		return bLoaded;
+	}
+	//--------------------------------------------------------------------------
+	bool MeshSpliter::_ReadPartitionFile(const Util::String& path, uint key, const GPtr<MeshRes>& pMesh, MeshPartition& outPartition)
+	{
+		// decode jobs have no IoServer of their own, read through the io thread
+		bool bLoaded = false;
+		GPtr<IO::MemoryStream> stream = IO::MemoryStream::Create();
+		GPtr<IO::ReadStream> readStreamMsg = IO::ReadStream::Create();
+		readStreamMsg->SetFileName(path);
+		readStreamMsg->SetStream(stream.upcast<IO::Stream>());
+		IO::IoInterface::Instance()->SendWait(readStreamMsg.upcast<Messaging::Message>());
+		if ( readStreamMsg->GetResult() && stream->GetSize() >= sCacheHeaderSize )
+		{
+			GPtr<IO::BinaryReader> reader = IO::BinaryReader::Create();
+			reader->SetStream(stream.upcast<IO::Stream>());
+			reader->SetStreamByteOrder(System::ByteOrder::LittleEndian);
+			if ( reader->Open() )
+			{
+				const uint magic = reader->ReadUInt();
+				const uint version = reader->ReadUInt();
+				const uint entryKey = reader->ReadUInt();
+				const uint count = reader->ReadUInt();
+				if ( magic == sCacheMagic.AsUInt() && version == CacheVersion && entryKey == key && count <= (uint)pMesh->GetSubMeshCount() )
+				{
+					// the reader may map the stream, so the bytes left are counted here
+					SizeT left = stream->GetSize() - sCacheHeaderSize;
+					outPartition.Resize(count, SubmeshPartition());
+					bLoaded = true;
+					for ( IndexT i = 0; i < (IndexT)count && bLoaded; ++i )
+					{
+						SubmeshPartition& part = outPartition[i];
+						if ( left < 3 * sizeof(uint) )
+						{
+							bLoaded = false;
+							break;
+						}
+						part.submesh = reader->ReadUInt();
+						const uint numBins = reader->ReadUInt();
+						const uint numTris = reader->ReadUInt();
+						left -= 3 * sizeof(uint);
+						if ( numBins > numTris || numTris > (uint)left || (numBins + numTris) * sizeof(uint) > (uint)left )
+						{
+							bLoaded = false;
+							break;
+						}
+						left -= (numBins + numTris) * sizeof(uint);
+						part.binSizes.Resize(numBins, 0);
+						for ( IndexT iBin = 0; iBin < (IndexT)numBins; ++iBin )
+						{
+							part.binSizes[iBin] = reader->ReadUInt();
+						}
+						part.triangles.Resize(numTris, 0);
+						for ( IndexT iTri = 0; iTri < (IndexT)numTris; ++iTri )
+						{
+							part.triangles[iTri] = reader->ReadUInt();
+						}
+					}
+					bLoaded = bLoaded && _IsPartitionValid(pMesh, outPartition);
+				}
+				reader->Close();
+			}
+		}
+		return bLoaded;
 	}
-	int MeshSpliter::_GetSubmeshFirstIndex(int iSubmesh)
+	//--------------------------------------------------------------------------
+	void MeshSpliter::_StorePartition(uint key, const MeshPartition& partition)
 	{
-		int firstIndex = 0;
-		for ( int i = 0; i < iSubmesh; ++i)
+		mCacheLock.Enter();
+		if ( !mCache.Contains(key) )
+		{
+			mCache.Add(key, partition);
+		}
+		mCacheLock.Leave();
+		if ( !mbCacheWriteBack )
 		{
-			firstIndex += mMeshRes->GetSubMesh(i)->numIndex;
+			return;
 		}
-		return firstIndex;
+
+		GPtr<IO::MemoryStream> stream = IO::MemoryStream::Create();
+		GPtr<IO::BinaryWriter> writer = IO::BinaryWriter::Create();
+		writer->SetStream(stream.upcast<IO::Stream>());
+		writer->SetStreamByteOrder(System::ByteOrder::LittleEndian);
+		if ( !writer->Open() )
+		{
+			return;
+		}
+		writer->WriteUInt(sCacheMagic.AsUInt());
+		writer->WriteUInt(CacheVersion);
+		writer->WriteUInt(key);
+		writer->WriteUInt(partition.Size());
+		for ( IndexT i = 0; i < partition.Size(); ++i )
+		{
+			const SubmeshPartition& part = partition[i];
+			writer->WriteUInt(part.submesh);
+			writer->WriteUInt(part.binSizes.Size());
+			writer->WriteUInt(part.triangles.Size());
+			for ( IndexT iBin = 0; iBin < part.binSizes.Size(); ++iBin )
+			{
+				writer->WriteUInt(part.binSizes[iBin]);
+			}
+			for ( IndexT iTri = 0; iTri < part.triangles.Size(); ++iTri )
+			{
+				writer->WriteUInt(part.triangles[iTri]);
+			}
+		}
+		writer->Close();
+
+		Util::String path = GetCachePath(key);
+		GPtr<IO::CreateDirectory> createDirMsg = IO::CreateDirectory::Create();
+		createDirMsg->SetFileName(path.ExtractDirName());
+		IO::IoInterface::Instance()->Send(createDirMsg.upcast<Messaging::Message>());
+		GPtr<IO::WriteStream> writeStreamMsg = IO::WriteStream::Create();
+		writeStreamMsg->SetFileName(path);
+		writeStreamMsg->SetStream(stream.upcast<IO::Stream>());
+		IO::IoInterface::Instance()->Send(writeStreamMsg.upcast<Messaging::Message>());
 	}
-	bool MeshSpliter::_IsOverMaxBonesByTri(Util::FixedArray<uint>& aVertex,StdSetHelper& helperSet)
+	//--------------------------------------------------------------------------
+	bool MeshSpliter::_IsPartitionValid(const GPtr<MeshRes>& pMesh, const MeshPartition& partition)
 	{
-		n_assert(aVertex.Size() == 3);
-		BoneInfoData::Elem* boneInfo = (BoneInfoData::Elem*)mMeshRes->GetDataImpl(VertexIndex::egBoneInfo,0);
-		for ( IndexT iVet = 0; iVet < aVertex.Size(); ++iVet )
+		IndexT lastSubmesh = InvalidIndex;
+		Util::Array<bool> used;
+		for ( IndexT i = 0; i < partition.Size(); ++i )
 		{
-			uint iVetex = aVertex[iVet];			
+			const SubmeshPartition& part = partition[i];
+			if ( part.submesh <= lastSubmesh || part.submesh >= pMesh->GetSubMeshCount() )
+			{
+				return false;
+			}
+			lastSubmesh = part.submesh;
 
-			// һ4ͷӰ
-			for ( int i = 0; i < 4; ++i )
+			const SizeT numTris = pMesh->mSubMeshs[part.submesh].numIndex / 3;
+			if ( part.triangles.Size() != numTris )
 			{
-				ushort usIdxValue = boneInfo[iVetex].boneIndex[i]; // BoneInfoData
-				helperSet.insert(usIdxValue);
-				if ( (IndexT)helperSet.size() >= mMaxBoneBySubmesh )
+				return false;
+			}
+			SizeT binTris = 0;
+			for ( IndexT iBin = 0; iBin < part.binSizes.Size(); ++iBin )
+			{
+				if ( 0 == part.binSizes[iBin] )
+				{
+					return false;
+				}
+				binTris += part.binSizes[iBin];
+			}
+			if ( binTris != numTris )
+			{
+				return false;
+			}
+			used.Clear(false);
+			used.Resize(numTris, false);
+			for ( IndexT iTri = 0; iTri < numTris; ++iTri )
+			{
+				const uint tri = part.triangles[iTri];
+				if ( tri >= (uint)numTris || used[tri] )
 				{
-					return true;
+					return false;
 				}
+				used[tri] = true;
 			}
 		}
-		return false;
+		return true;
 	}
 #ifdef __DEBUG_MESHSPLITER__
 	typedef std::set<IndexT> StdSetIdx;
@@ -362,14 +769,14 @@ namespace Resources
 
 	}
 #endif
-	void MeshSpliter::_RestoreRawBoneInfo(SubMeshArray& arrayRawSubmeshs, MeshReviseWorkspace& workspace)
+	void MeshSpliter::_RestoreRawBoneInfo(GPtr<MeshRes>& pMesh, SubMeshArray& arrayRawSubmeshs, MeshReviseWorkspace& workspace)
 	{
 #ifdef __DEBUG_MESHSPLITER__
 		g_stdMapIdx.clear();
 #endif
 
 		// ָԭʼֵ
-		workspace.mRestoreBoneInfo = mMeshRes->mBoneInfo;
+		workspace.mRestoreBoneInfo = pMesh->mBoneInfo;
 		IndexT boneIdxOffset(0);
 		for ( IndexT  iSubmesh = 0;  iSubmesh < (IndexT)arrayRawSubmeshs.Size(); ++iSubmesh )
 		{
@@ -377,13 +784,13 @@ namespace Resources
 			std::set<IndexT> stdSetModifedIdx;
 			if ( iSubmesh >= 1 )
 			{
-				boneIdxOffset +=  mMeshRes->GetAffectedBonesIndex(iSubmesh-1).Size();
+				boneIdxOffset +=  pMesh->GetAffectedBonesIndex(iSubmesh-1).Size();
 			}	
 			IndexT begin = arrayRawSubmeshs[iSubmesh].FirstIndex;
 			IndexT end   = begin + arrayRawSubmeshs[iSubmesh].numIndex;	
 			for ( IndexT i = begin; i < end; i++ )
 			{
-				IndexT iVet = _GetVertexIndex(i);
+				IndexT iVet = _GetVertexIndex(pMesh,i);
 #ifdef __DEBUG_MESHSPLITER__
 				if ( iSubmesh >= 1 && PreSubMeshHaveIVetIdx(iSubmesh,iVet) )
 				{
@@ -408,24 +815,8 @@ namespace Resources
 	}
 	
 
-	void MeshSpliter::_MergeSubmeshes(SubMeshArray& outResult, Util::Dictionary<IndexT,SubMeshArray>& aNewSubmesh)
-	{
-		SubMeshArray& oldSubmesh = mMeshRes->mSubMeshs;
-		for ( IndexT i = 0; i < oldSubmesh.Size(); i++ )
-		{
-			IndexT keyIdx = aNewSubmesh.FindIndex(i);
-			if ( keyIdx != InvalidIndex )
-			{// submesh 
-				outResult.AppendArray( aNewSubmesh.ValueAtIndex(keyIdx) );
-			} 
-			else
-			{// old submesh
-				outResult.Append( oldSubmesh[i]);
-			}
-		}
-	}
 	//======================================================================
-	void MeshSpliter::_SplitVertexs(SubMeshArray& allSubMeshArray,MeshReviseWorkspace& workspace)
+	void MeshSpliter::_SplitVertexs(GPtr<MeshRes>& pMesh, SubMeshArray& allSubMeshArray,MeshReviseWorkspace& workspace)
 	{// vertex
 		/*
 		 * allSubMeshArrayΪ׼cloneҪ¹
@@ -435,7 +826,7 @@ namespace Resources
 		 *  remark:ͬ༭һ£cloneĶź
 		*/
 		n_assert(allSubMeshArray.Size() >= 1);
-		n_printf("=====================submeshID: %s \n",mMeshRes->meshId.Get());		
+		n_printf("=====================submeshID: %s \n",pMesh->meshId.Get());		
 		
 		//Util::Array<StdMapVertexArrayIdx> ssvaVertexIdx;
 		std::vector<StdMapVertexArrayIdx> ssvaVertexIdx;
@@ -457,8 +848,8 @@ namespace Resources
 		IndexT iSub(0);
 		for ( IndexT i = begin; i < end; i++ )
 		{
-			IndexT rawVertexIdx = _GetVertexIndex(i);
-			_MakeAffectedBoneAndBoneInfo(iSub,rawVertexIdx,rawVertexIdx,workspace,helperAfftectedBone);	
+			IndexT rawVertexIdx = _GetVertexIndex(pMesh,i);
+			_MakeAffectedBoneAndBoneInfo(pMesh,iSub,rawVertexIdx,rawVertexIdx,workspace,helperAfftectedBone);	
 
 			//std::vector< uint >itFindRaw = std::find(subIndexVB.begin(),subIndexVB.end(),rawVertexIdx);
 			//if ( itFindRaw == subIndexVB.end() )
@@ -487,7 +878,7 @@ namespace Resources
 			IndexT end   = begin + allSubMeshArray[iSub].numIndex;
 			for ( IndexT indexIdx = begin; indexIdx < end; indexIdx++ )
 			{
-				IndexT rawVertexIdx  = _GetVertexIndex(indexIdx);
+				IndexT rawVertexIdx  = _GetVertexIndex(pMesh,indexIdx);
 				bool bNeedClone = _HaveVertexIdx(ssvaVertexIdx,iSub,rawVertexIdx);
 				StdMapVertexArrayIdx::iterator itFind = ssvaVertexIdx[iSub].find(rawVertexIdx);
 				bool bHadCloned = ( ( itFind != ssvaVertexIdx[iSub].end() ) && ( itFind->second != (uint)-1) ) ;
@@ -502,7 +893,7 @@ namespace Resources
 						
 						ssvaVertexIdx[iSub].insert(std::make_pair(rawVertexIdx,lastVertexIdx));
 						subIndexVB.push_back(lastVertexIdx);
-						_MakeAffectedBoneAndBoneInfo(iSub,rawVertexIdx,lastVertexIdx,workspace,helperAfftectedBone);
+						_MakeAffectedBoneAndBoneInfo(pMesh,iSub,rawVertexIdx,lastVertexIdx,workspace,helperAfftectedBone);
 					} 
 					else
 					{// had cloned ֱָǸ
@@ -517,7 +908,7 @@ namespace Resources
 					// 
 					ssvaVertexIdx[iSub].insert(std::make_pair(rawVertexIdx,-1));
 					subIndexVB.push_back(rawVertexIdx);
-					_MakeAffectedBoneAndBoneInfo(iSub,rawVertexIdx,rawVertexIdx,workspace,helperAfftectedBone);
+					_MakeAffectedBoneAndBoneInfo(pMesh,iSub,rawVertexIdx,rawVertexIdx,workspace,helperAfftectedBone);
 				}
 					
 				
@@ -535,7 +926,7 @@ namespace Resources
 	}
 	
 	//------------------------------------------------------------------------
-	void MeshSpliter::_MakeAffectedBoneAndBoneInfo(IndexT iSub,IndexT rawVertexIdx,IndexT newVertexIdx,MeshReviseWorkspace& workspace,Util::Array<IndexT>& helperAfftectedBone)
+	void MeshSpliter::_MakeAffectedBoneAndBoneInfo(GPtr<MeshRes>& pMesh, IndexT iSub,IndexT rawVertexIdx,IndexT newVertexIdx,MeshReviseWorkspace& workspace,Util::Array<IndexT>& helperAfftectedBone)
 	{
 		// ԭʼaffectedBoneworkspaceеaffectedbone
 		// workspaceеaffectedbone boneInfoеboneidxΪȾλ
@@ -545,7 +936,7 @@ namespace Resources
 			// ָboneIndex
 			IndexT idxAffetedBone		= workspace.mRestoreBoneInfo[rawVertexIdx].boneIndex[j];
 			//
-			IndexT affectedBoneValue	= _GetRawAffectedBonesValue(mMeshRes->mAffectedBonesIndex,idxAffetedBone);
+			IndexT affectedBoneValue	= _GetRawAffectedBonesValue(pMesh->mAffectedBonesIndex,idxAffetedBone);
 			
 
 
@@ -575,23 +966,35 @@ namespace Resources
 
 	//======================================================================
 	
-	IndexT MeshSpliter::_GetVertexIndex(IndexT idxAtIndexArray)
+	IndexT MeshSpliter::_GetVertexIndex(const GPtr<MeshRes>& pMesh, IndexT idxAtIndexArray)
 	{
 		Index16Container::value_type* index16;
 		Index32Container::value_type* index32;
-		if ( mMeshRes->IsUseIndex16() )
+		if ( pMesh->IsUseIndex16() )
 		{
-			index16 = mMeshRes->GetIndex16();
+			index16 = pMesh->GetIndex16();
 		}
 		else
 		{
-			index32 = mMeshRes->GetIndex32();
+			index32 = pMesh->GetIndex32();
 		}
 
-		IndexT iVet = mMeshRes->IsUseIndex16() ? index16[idxAtIndexArray] : index32[idxAtIndexArray];
+		IndexT iVet = pMesh->IsUseIndex16() ? index16[idxAtIndexArray] : index32[idxAtIndexArray];
 		return iVet;
 	}
 	//-------------------------------------------------------------------------
+	void MeshSpliter::_SetVertexIndex(GPtr<MeshRes>& pMesh, IndexT idxAtIndexArray, IndexT val)
+	{
+		if ( pMesh->IsUseIndex16() )
+		{
+			pMesh->mIndex16[idxAtIndexArray] = (ushort)val;
+		}
+		else
+		{
+			pMesh->mIndex32[idxAtIndexArray] = val;
+		}
+	}
+	//-------------------------------------------------------------------------
 	void MeshSpliter::_GetAffectedBonesIndex(FixedArrayBonesIndex& outAffectedBonesIndex, IndexT idxAtVertexArray,MeshReviseWorkspace& workspace)
 	{
 		outAffectedBonesIndex.Resize(4);
@@ -604,7 +1007,7 @@ namespace Resources
 	
 	
 	//------------------------------------------------------------------------
-	bool MeshSpliter::_HaveVertexIdx(std::vector<StdMapVertexArrayIdx> ssvaVertexIdx, IndexT end, IndexT testVal)
+	bool MeshSpliter::_HaveVertexIdx(const std::vector<StdMapVertexArrayIdx>& ssvaVertexIdx, IndexT end, IndexT testVal)
 	{
 		for ( IndexT iSub = 0; iSub < end; iSub++ )
 		{
@@ -617,7 +1020,7 @@ namespace Resources
 		return false;
 	}
 	//------------------------------------------------------------------------
-	IndexT MeshSpliter::_GetRawAffectedBonesValue(AffectedBonesIndex& rawAffectedBones, IndexT restoreBoneIdx)
+	IndexT MeshSpliter::_GetRawAffectedBonesValue(const AffectedBonesIndex& rawAffectedBones, IndexT restoreBoneIdx)
 	{
 		IndexT totalIdx(0),preTotalNum(0);
 		for ( IndexT i = 0; i < rawAffectedBones.Size(); i++ )
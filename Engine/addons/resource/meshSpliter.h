@@ -26,6 +26,9 @@ THE SOFTWARE.
 #include "foundation/core/refcounted.h"
 #include "foundation/core/singleton.h"
 #include "core/ptr.h"
+#include "threading/criticalsection.h"
+#include "timing/time.h"
+#include "util/dictionary.h"
 #include "resource/meshres.h"
 #include <set>
 #include <map>
@@ -40,47 +43,123 @@ namespace Resources
 	typedef std::map<uint,uint>		 StdMapVertexArrayIdx;
 	typedef Util::FixedArray<ushort> FixedArrayBonesIndex;
 	typedef Util::Array<uchar>		 ArrayBonesIndex;
+
+	struct MeshSplitStats
+	{
+		SizeT meshesSplit;		// skinned meshes which needed more submeshes
+		SizeT submeshesIn;		// submeshes of those meshes before the split
+		SizeT submeshesOut;		// and after it
+		SizeT cacheHits;
+		SizeT cacheMisses;
+		Timing::Time splitTime;	// seconds spent splitting
+	};
+
+	/**
+		Splits the submeshes of a skinned mesh which are affected by more bones than the
+		skinning shader can take (GL/GLES only, the D3D9 path has enough constants). Headless
+		server builds split too, with the D3D9 budget or the one given to SetMaxBoneBySubmesh.
+
+		The triangles of such a submesh are packed into new submeshes so that every new
+		submesh stays within the bone budget: each new submesh takes the triangles which
+		add the fewest bones not yet used by it, so triangles sharing bones end up together
+		and fewer submeshes (draw calls) are needed than by cutting the index range in order.
+
+		The packing result (triangle order and submesh sizes) is cached by a crc of the index
+		buffer, the bone indices and the bone budget, in memory and as "user:cache/meshsplit/<key>.msc"
+		files (write back, on by default), so later sessions on the device skip the packing. user: is
+		writable on every platform, the project itself may sit in a read only apk. Files copied from
+		there into the project's "asset:cache/meshsplit" are read as well, so a project can ship them
+		cooked for the bone budget of its target devices and only repeats the vertex split on load.
+
+		DoWork keeps no state between calls and may run on several decode jobs at once.
+	*/
 	class MeshSpliter : public Core::RefCounted
 	{
 		__DeclareClass(MeshSpliter);
 		__DeclareImageSingleton(MeshSpliter);
 	public:
+		/// format version of the cache files, bump when the packing changes
+		static const uint CacheVersion = 1;
+
 		MeshSpliter();
 		virtual ~MeshSpliter();
 		void Init();
+		/// split the submeshes of the mesh which use too many bones
 		void DoWork(GPtr<MeshRes>& pMesh);
-		void DoWork_1(GPtr<MeshRes>& pMesh);
 		void DebugPrint(GPtr<MeshRes>& pMesh);
+		/// max bones a submesh may use after the split
+		int GetMaxBoneBySubmesh() const;
+		/// use this budget instead of the one from the device caps (e.g. a GLES budget on a headless server)
+		void SetMaxBoneBySubmesh(int maxBones);
+
+		/// enable or disable the split cache, on by default
+		void SetCacheEnabled(bool b);
+		bool IsCacheEnabled() const;
+		/// write new cache entries to disk as well, on by default
+		void SetCacheWriteBack(bool b);
+		bool IsCacheWriteBack() const;
+		/// drop the cache entries held in memory
+		void ClearCache();
+		/// compute the cache key of a mesh for the current bone budget
+		uint ComputeCacheKey(const GPtr<MeshRes>& pMesh) const;
+		/// the disk location of a cache entry written at runtime
+		static Util::String GetCachePath(uint key);
+		/// the location of a cache entry shipped with the project
+		static Util::String GetCookedCachePath(uint key);
+
+		/// counters since the last reset, for comparing submesh counts and split times
+		MeshSplitStats GetStats();
+		void ResetStats();
 	private:
-		// split mesh===============================================
-		// split mesh base on max bone count
-		bool _SplitMesh(GPtr<MeshRes>& pMesh,SubMeshArray& mergeResult);
-		// try split submesh
-		bool _TrySplitSubmesh(int iSubmesh,SubMesh* pSubmesh,Util::Array<uchar>& affectdBones);
+		// packing of one split submesh: the new triangle order inside the submesh
+		// and the triangle count of every new submesh
+		struct SubmeshPartition
+		{
+			IndexT submesh;
+			Util::Array<uint> triangles;
+			Util::Array<uint> binSizes;
+		};
+		typedef Util::Array<SubmeshPartition> MeshPartition;
 
-		int _GetSubmeshFirstIndex(int iSubmesh);
-			// Check is over max bone use triangle as unit
-		bool _IsOverMaxBonesByTri(Util::FixedArray<uint>& aVertex,StdSetHelper& helperSet);
-		void _MergeSubmeshes(SubMeshArray& outResult, Util::Dictionary<IndexT,SubMeshArray>& aNewSubmesh);
-		void _RestoreRawBoneInfo(SubMeshArray& arrayRawSubmeshs, MeshReviseWorkspace& workspace);
+		// split mesh===============================================
+		// pack the triangles of a submesh into new submeshes within the bone budget
+		void _PartitionSubmesh(const GPtr<MeshRes>& pMesh, IndexT iSubmesh, SubmeshPartition& outPartition) const;
+		// reorder the index buffer and build the new submesh list, false if nothing was split
+		bool _ApplyPartition(GPtr<MeshRes>& pMesh, const MeshPartition& partition, SubMeshArray& outResult);
+		void _RestoreRawBoneInfo(GPtr<MeshRes>& pMesh, SubMeshArray& arrayRawSubmeshs, MeshReviseWorkspace& workspace);
 
 		// split vertexs===============================================
-		void _SplitVertexs(SubMeshArray& allSubMeshArray,MeshReviseWorkspace& workspace);
-		void _MakeAffectedBoneAndBoneInfo(IndexT iSub,IndexT rawVertexIdx,IndexT newVertexIdx,MeshReviseWorkspace& workspace,Util::Array<IndexT>& helperAfftectedBone);
+		void _SplitVertexs(GPtr<MeshRes>& pMesh, SubMeshArray& allSubMeshArray,MeshReviseWorkspace& workspace);
+		void _MakeAffectedBoneAndBoneInfo(GPtr<MeshRes>& pMesh, IndexT iSub,IndexT rawVertexIdx,IndexT newVertexIdx,MeshReviseWorkspace& workspace,Util::Array<IndexT>& helperAfftectedBone);
+
+		// cache===============================================
+		bool _LoadPartition(uint key, const GPtr<MeshRes>& pMesh, MeshPartition& outPartition);
+		static bool _ReadPartitionFile(const Util::String& path, uint key, const GPtr<MeshRes>& pMesh, MeshPartition& outPartition);
+		void _StorePartition(uint key, const MeshPartition& partition);
+		static bool _IsPartitionValid(const GPtr<MeshRes>& pMesh, const MeshPartition& partition);
 
 		// common func===============================================
-		IndexT _GetVertexIndex(IndexT idxAtIndexArray);
+		static IndexT _GetVertexIndex(const GPtr<MeshRes>& pMesh, IndexT idxAtIndexArray);
+		static void   _SetVertexIndex(GPtr<MeshRes>& pMesh, IndexT idxAtIndexArray, IndexT val);
 		void   _GetAffectedBonesIndex(FixedArrayBonesIndex& outAffectedBonesIndex, IndexT idxAtVertexArray,MeshReviseWorkspace& workspace);
-		IndexT _GetRawAffectedBonesValue(AffectedBonesIndex& rawAffectedBones, IndexT restoreBoneIdx);		
-		bool   _HaveVertexIdx(std::vector<StdMapVertexArrayIdx> ssvaVertexIdx, IndexT end, IndexT testVal);
-		bool   _IsNeedSplit(GPtr<MeshRes>& pMesh);
+		static IndexT _GetRawAffectedBonesValue(const AffectedBonesIndex& rawAffectedBones, IndexT restoreBoneIdx);
+		static bool   _HaveVertexIdx(const std::vector<StdMapVertexArrayIdx>& ssvaVertexIdx, IndexT end, IndexT testVal);
+		bool   _IsNeedSplit(const GPtr<MeshRes>& pMesh) const;
 
 	private:
 		bool			mbInit;
 		int				mMaxBoneBySubmesh;
-		GPtr<MeshRes>   mMeshRes;
-		Util::Dictionary<IndexT,SubMeshArray>	mSubmeshMapWorkPart;	
+		bool			mbCacheEnabled;
+		bool			mbCacheWriteBack;
+		Util::Dictionary<uint, MeshPartition>	mCache;
+		MeshSplitStats	mStats;
+		Threading::CriticalSection	mCacheLock;	// meshes are decoded by several jobs at once, guards mCache and mStats
 	};
+	//------------------------------------------------------------------------
+	inline int MeshSpliter::GetMaxBoneBySubmesh() const
+	{
+		return mMaxBoneBySubmesh;
+	}
 
 	class MeshReviseWorkspace
 	{
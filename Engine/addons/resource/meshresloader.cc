@@ -69,6 +69,7 @@ namespace Resources
 		n_assert(pReader.isvalid());
 
 		pReader->SetStream( mStream );
+		pReader->SetMemoryMappingEnabled( true );
 
 #if __OSX__
 		pReader->SetStreamByteOrder(System::ByteOrder::BigEndian);
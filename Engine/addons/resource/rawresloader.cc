@@ -66,6 +66,7 @@ namespace Resources
 		n_assert(pReader.isvalid());
 
 		pReader->SetStream( mStream );
+		pReader->SetMemoryMappingEnabled( true );
 
 		//  every file should be LittleEndian
 		pReader->SetStreamByteOrder(System::ByteOrder::LittleEndian);
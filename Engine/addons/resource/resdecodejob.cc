@@ -0,0 +1,102 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "resource/resource_stdneb.h"
+#include "resource/resdecodejob.h"
+#include "jobs/stdjob.h"
+
+namespace Resources{
+
+	void ResDecodeJobFunc(const JobFuncContext& ctx)
+	{
+		ResDecodeJobData* data = (ResDecodeJobData*)ctx.uniforms[0];
+		ResourceHandler::LoadResourceFromMsg( data->mMsg );
+	}
+
+} // namespace Resources
+__ImplementSpursJob(Resources::ResDecodeJobFunc);
+
+namespace Resources
+{
+	__ImplementClass(Resources::ResDecodeJob, 'RDCJ', Core::RefCounted)
+	//------------------------------------------------------------------------
+	ResDecodeJob::ResDecodeJob()
+	{
+
+	}
+	//------------------------------------------------------------------------
+	ResDecodeJob::~ResDecodeJob()
+	{
+		n_assert( !mData.mMsg );
+		n_assert( !mJobPort.isvalid() );
+		n_assert( !mJob.isvalid() );
+	}
+	//------------------------------------------------------------------------
+	void ResDecodeJob::Setup( const GPtr<ResLoadMsg>& msg )
+	{
+		n_assert( msg.isvalid() );
+		mMsg = msg;
+		mData.mMsg = msg.get();
+	}
+	//------------------------------------------------------------------------
+	void 
+		ResDecodeJob::Run()
+	{
+		n_assert( !mJobPort.isvalid() );
+		n_assert( mData.mMsg != NULL );
+
+		mJobPort = Jobs::JobPort::Create();
+		mJobPort->Setup();
+
+		// create new job           
+		mJob = Jobs::Job::Create();
+
+		// input data for job  
+		// function
+		Jobs::JobFuncDesc jobFunction(ResDecodeJobFunc);   
+
+		Jobs::JobUniformDesc uniformData( &mData, sizeof(void*), 0 );
+
+		Jobs::JobDataDesc inputData( &mData, sizeof(void*), sizeof(void*) );
+		Jobs::JobDataDesc outputData( &mData, sizeof(void*), sizeof(void*) );
+
+		// setup job with data
+		mJob->Setup(uniformData, inputData, outputData, jobFunction);
+
+		mJobPort->PushJob( mJob );
+	}
+	//------------------------------------------------------------------------
+	void 
+		ResDecodeJob::End()
+	{
+		if ( mJobPort.isvalid() )
+		{
+			mJobPort->WaitDone();
+		}
+		mData.mMsg = NULL;
+		mMsg = NULL;
+		mJobPort = NULL;
+		mJob = NULL;
+	}
+
+}
@@ -0,0 +1,81 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __resdecodejob_H__
+#define __resdecodejob_H__
+#include "core/refcounted.h"
+#include "jobs/jobport.h"
+#include "jobs/job.h"
+#include "resource/resourceinterface.h"
+
+namespace Resources
+{
+	struct ResDecodeJobData
+	{
+		ResDecodeJobData()
+			: mMsg(NULL)
+		{ }
+		ResLoadMsg* mMsg;
+	};
+
+	// decode one resource from its memory stream on the job system, used instead of the resource thread
+	// for resource types whose loaders can run in parallel
+	class ResDecodeJob: public Core::RefCounted
+	{
+		__DeclareClass(ResDecodeJob); 
+	public:
+		ResDecodeJob();
+		virtual ~ResDecodeJob();
+
+		void Setup( const GPtr<ResLoadMsg>& msg );
+
+		/// run job
+		void Run();
+
+		/// is finished
+		bool IsFinished() const;
+
+		/// finish clear
+		void End();
+
+	protected:
+		ResDecodeJobData mData;
+		GPtr<ResLoadMsg> mMsg;
+		GPtr<Jobs::JobPort> mJobPort;
+		GPtr<Jobs::Job>     mJob;
+	};
+
+	//------------------------------------------------------------------------------
+	inline
+		bool 
+		ResDecodeJob::IsFinished() const
+	{
+		if ( mJobPort.isvalid() )
+		{
+			return mJobPort->CheckDone();
+		}
+		return true;
+	}
+}
+
+#endif // __resdecodejob_H__
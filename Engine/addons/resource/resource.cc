@@ -47,6 +47,10 @@ namespace Resources
 		: mState(UnLoaded)
 		, mAsynProcessingIndex(0)
 		, mManuLoad(false)
+		, mResidentSize(0)
+		, mLastUseFrame(0)
+		, mLoadPriority(ResourcePriority::Lowest)
+		, mLoadSerial(InvalidIndex)
 
 	{
 		// empty
@@ -198,6 +202,9 @@ namespace Resources
 
 		mState = newState;
 
+		// the data changed, the ResourceServer measures it again on its next residency update
+		mResidentSize = 0;
+
 		//	if(newState != Resources::Resource::Loaded)
 		//		return;
 		IndexT size = mNotifierList.Size();
@@ -233,6 +233,12 @@ namespace Resources
 		*/
 		void SetState( State newState);
 
+		/// get the cached runtime size while loaded, 0 if not yet measured by the ResourceServer
+		SizeT GetResidentSize(void) const;
+
+		/// get the last ResourceServer frame the resource was requested or referenced
+		IndexT GetLastUseFrame(void) const;
+
 		static ResourceId EmptyResID;
 	protected:
 
@@ -253,6 +259,10 @@ namespace Resources
 		ResourceId mResourceID;
 		IndexT mAsynProcessingIndex;
 		bool mManuLoad;
+		SizeT mResidentSize;
+		IndexT mLastUseFrame;
+		Priority mLoadPriority;	//	priority of a pending asynchronous load, smaller is more urgent
+		IndexT mLoadSerial;	//	serial of the queued load request, InvalidIndex if not queued
 		Util::Array< WeakPtr<ResourceNotifier> > mNotifierList;
 
 		friend class ResourceServer;
@@ -342,6 +352,20 @@ namespace Resources
 	{
 		return mManuLoad;
 	}
+	//------------------------------------------------------------------------
+	inline
+		SizeT 
+		Resource::GetResidentSize(void) const
+	{
+		return mResidentSize;
+	}
+	//------------------------------------------------------------------------
+	inline
+		IndexT 
+		Resource::GetLastUseFrame(void) const
+	{
+		return mLastUseFrame;
+	}
 
 }	//	namespace Resources
 
@@ -123,11 +123,18 @@ namespace Resources
 		ResourceHandler::OnLoad( const GPtr<ResLoadMsg>& msg )
 	{
 		n_assert(msg.isvalid());
+		LoadResourceFromMsg( msg.get() );
+	}
+	//------------------------------------------------------------------------
+	void 
+		ResourceHandler::LoadResourceFromMsg( ResLoadMsg* msg )
+	{
+		n_assert( msg );
 
 		if ( !msg->GetLoader() || !msg->GetResource() || !msg->GetStream() )
 		{
-			msg->SetHandled(true);
 			msg->SetResult(false);
+			msg->SetHandled(true);
 			return;
 		}
 
@@ -142,8 +149,9 @@ namespace Resources
 			loadStream->Close();
 		}
 
-		msg->SetHandled(true);
+		// the result must be visible before the main thread sees the message handled
 		msg->SetResult(bLoadOK);
+		msg->SetHandled(true);
 	}
 	//------------------------------------------------------------------------
 	void 
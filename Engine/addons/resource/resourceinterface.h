@@ -140,6 +140,8 @@ namespace Resources
 		virtual void Close();
 		/// handle a message, return true if handled
 		virtual bool HandleMessage(const GPtr<Messaging::Message>& msg);
+		/// decode the resource of a load message from its stream, may run on any thread
+		static void LoadResourceFromMsg(ResLoadMsg* msg);
 
 	protected:
 		void OnLoad( const GPtr<ResLoadMsg>& msg );
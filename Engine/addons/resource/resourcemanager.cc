@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include "foundation/io/memorystream.h"
 #include "foundation/io/iointerface.h"
 #include "resource/resourceserver.h"
+#include "timing/timer.h"
 #include "graphicsystem/Material/GlobalShaderParam.h"
 #include "materialmaker/GenesisMaterial.h"
 #include "materialmaker/parser/GenesisShaderParser.h"
@@ -338,6 +339,11 @@ namespace Resources
 		GPtr<baseResInfo> resInfo = pManager->CreateOrGetResInfo(resId);
 		n_assert(resInfo);
 
+		if ( resInfo->IsAsynLoading() && resInfo->GetPriority() != priority )
+		{
+			// still pending in the resource server, let it reorder the request
+			ResourceServer::Instance()->SetLoadPriority( resInfo->GetRes(), priority );
+		}
 		resInfo->SetPriority(priority);
 
 		if ( resInfo->CanUsable() )
@@ -377,64 +383,39 @@ namespace Resources
 			return;
 		}
 
-		m_AsynRequsetList.push_back(resInfo);
+		// the resource server queues the request by priority and bounds the reads and decodes in flight
+		_LoadSingleResData(resInfo, true);
+		m_AsynLoadingList.push_back(resInfo);
 
 		resInfo->SetAsynLoading(true);
 	}
 
 	//------------------------------------------------------------------------
-	class PrioritySorter
-	{
-	public:
-		bool operator() (const GPtr<baseResInfo>& lhs, const GPtr<baseResInfo>& rhs) const
-		{
-			return lhs->GetPriority() < rhs->GetPriority();
-		}
-	};
-
+	const Timing::Time Max_Compile_Time_One_Frame = 0.004;	//	seconds spent on compiling loaded resources per frame
 	void ResourceManager::_OnLoadingAsynList()
 	{
-		ResourceServer* resServer = ResourceServer::Instance();
+		Timing::Timer t;
+		t.Start();
 
 		for (BaseResInfoList::iterator itorLoad = m_AsynLoadingList.begin();
 			itorLoad != m_AsynLoadingList.end(); 
 			)
 		{
-			GPtr<baseResInfo>& resInfo = *itorLoad;
-			if ( _FlushSingleResInfo(resInfo) )
-			{
-				resInfo->SetAsynLoading(false);
-				itorLoad = m_AsynLoadingList.erase(itorLoad);
-			}
-			else
+			// compile at least one resource per frame, the rest is left to the next frames
+			if ( t.GetTime() > Max_Compile_Time_One_Frame )
 			{
-				++itorLoad;
-			}
-		}
-
-		// Request List ȼС
-		m_AsynRequsetList.sort( PrioritySorter() );
-
-		const int MaxLoadingCount = 5;
-		int loadingCount = 0;
-		for ( BaseResInfoList::iterator itorReq = m_AsynRequsetList.begin();
-			itorReq != m_AsynRequsetList.end();++loadingCount )
-		{
-			if(loadingCount > MaxLoadingCount)
 				break;
+			}
 
-			GPtr<baseResInfo>& resInfo = *itorReq;
+			GPtr<baseResInfo>& resInfo = *itorLoad;
 			if ( _FlushSingleResInfo(resInfo) )
 			{
 				resInfo->SetAsynLoading(false);
-				itorReq = m_AsynRequsetList.erase(itorReq);
+				itorLoad = m_AsynLoadingList.erase(itorLoad);
 			}
 			else
 			{
-				// 룬ƵLoadingб
-				_LoadSingleResData(resInfo,true);
-				m_AsynLoadingList.push_back( *itorReq );
-				itorReq = m_AsynRequsetList.erase(itorReq);
+				++itorLoad;
 			}
 		}
 	}
@@ -445,7 +426,7 @@ namespace Resources
 
 		ResourceServer* resServer = ResourceServer::Instance();
 		GPtr<Resource> pRes = resInfo->GetRes();
-		return resServer->LoadResource( pRes, asyn );
+		return resServer->LoadResource( pRes, asyn, 'CYWJ', NULL, resInfo->GetPriority() );
 	}
 	//------------------------------------------------------------------------
 
@@ -756,13 +737,19 @@ namespace Resources
 	//------------------------------------------------------------------------
 	void ResourceManager::OnLoadingShader()
 	{
-		const ResInfoArray& resInfo = m_MaterialResInfoContainer.GetAllResInfo();
-		for (SizeT i = 0; i < resInfo.Size(); ++i)
+		// only the materials which changed since the last frame are visited, instead of every material.
+		// the ones still waiting for their textures are queued again and polled next frame.
+		Graphic::MaterialInstance::_TakeDirtyMaterials(m_DirtyMaterials);
+		for (SizeT i = 0; i < m_DirtyMaterials.Size(); ++i)
 		{
-			const GPtr<MaterialResInfo>& matResInfo = resInfo[i].downcast<MaterialResInfo>();
-			n_assert(matResInfo->GetHandle());
-			_RefreshMaterial(matResInfo->GetHandle());		
+			GPtr<Graphic::MaterialInstance>& mat = m_DirtyMaterials[i];
+			_RefreshMaterial(mat);
+			if (mat->IsDirty())
+			{
+				mat->_MarkDirty();
+			}
 		}
+		m_DirtyMaterials.Clear(false);
 	}
 	//------------------------------------------------------------------------
 	void ResourceManager::ReloadAllVideoMemResource()
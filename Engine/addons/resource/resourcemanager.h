@@ -222,11 +222,13 @@ namespace Resources
 		SpritePackageResInfoContainer	m_SpritePackageResInfoContainer;
 
 		typedef Util::STL_list< GPtr<baseResInfo> >::type BaseResInfoList;
-		BaseResInfoList m_AsynRequsetList;
 		BaseResInfoList m_AsynLoadingList;	//	صԴб
 
 		bool m_UsedForResourceHotLoader;
 		GPtr<MeshSpliter> mMeshSpliter;
+
+		// materials marked dirty since the last OnLoadingShader, kept to reuse the memory
+		Util::Array< GPtr<Graphic::MaterialInstance> > m_DirtyMaterials;
 	};
 
 	inline const ResInfoContainer& ResourceManager::GetSpritePackageResInfoContainer()
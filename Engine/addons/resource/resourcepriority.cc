@@ -28,6 +28,7 @@ namespace Resources
 {
 	const Priority ResourcePriority::Synchronization = 0;
 	const Priority ResourcePriority::Undefinition = -1;
+	const Priority ResourcePriority::Lowest = 65535;
 	const Priority ResourcePriority::MeshDefault = 1;
 	const Priority ResourcePriority::TextureDefault = 1;
 	const Priority ResourcePriority::SoundDefault = 1;
@@ -34,6 +34,7 @@ namespace Resources
 	public:
 		static const Priority Synchronization;
 		static const Priority Undefinition;
+		static const Priority Lowest;
 		static const Priority MeshDefault;
 		static const Priority TextureDefault;
 		static const Priority SoundDefault;
@@ -53,6 +53,8 @@ THE SOFTWARE.
 #include "resource/spritepackageressaver.h"
 
 #include "timing/timer.h"
+#include "jobs/jobsystem.h"
+#include <algorithm>
 
 #include "foundation/io/ioserver.h"
 #include "foundation/io/stream.h"
@@ -76,6 +78,13 @@ namespace Resources{
 	//------------------------------------------------------------------------
 	ResourceServer::ResourceServer()
 		:mIsOpen(false)
+		,mFrameIndex(0)
+		,mResidencyUpdateInterval(30)
+		,mLoadSerial(0)
+		,mMaxReads(4)
+		,mMaxDecodes(2)
+		,mNumDecodes(0)
+		,mFinalizeBudget(0.004)
 	{
 		__ConstructImageSingleton;
 	}
@@ -112,6 +121,9 @@ namespace Resources{
 		mThreadInterface = ResourceInterface::Create();
 		mThreadInterface->Open();
 
+		mPipelineTimer.Reset();
+		mPipelineTimer.Start();
+
 		mIsOpen = true;
 	}
 	//------------------------------------------------------------------------
@@ -120,13 +132,29 @@ namespace Resources{
 	{
 		n_assert(mIsOpen);
 
+		// decode jobs still reference their messages, wait for them before dropping the stubs
+		ReadStubList::Iterator endItor = mAsynReadQueue.End(); 
+		for ( ReadStubList::Iterator itor = mAsynReadQueue.Begin(); itor != endItor; ++itor )
+		{
+			if ( itor->decode_job.isvalid() )
+			{
+				itor->decode_job->End();
+			}
+		}
+
 		mThreadInterface->Close();
 		mThreadInterface = NULL;
 
 		mAsynPrepareQueue.Clear();
 		mAsynReadQueue.Clear();
+		mIoWaitQueue.Clear();
+		mDecodeWaitQueue.Clear();
+		mNumDecodes = 0;
+		mPipelineTimer.Stop();
 
 		mResources.Clear();
+		mEvictCandidates.Clear();
+		mResidencyStats.Clear();
 
 		// may be need close resCodec in thread
 		SizeT numReg = mResReg.Size();
@@ -230,6 +258,26 @@ namespace Resources{
 		GPtr<ImageResCodecReg> imageCode = ImageResCodecReg::Instance();
 		RegisterResourceType( &ImageRes::RTTI, 'CYWJ', &ImageResLoader::RTTI, NULL, imageCode.upcast<ResCodecReg>() ) ;
 
+		// default residency budgets of the cpu side resource data, the application may override them
+#if __ANDROID__ || __OSX__
+		const SizeT mb = 1024 * 1024;
+		SetResidencyBudget( &ImageRes::RTTI, 48 * mb );
+		SetResidencyBudget( &MeshRes::RTTI, 24 * mb );
+		SetResidencyBudget( &AudioRes::RTTI, 16 * mb );
+		SetResidencyBudget( &AnimationRes::RTTI, 16 * mb );
+#else
+		const SizeT mb = 1024 * 1024;
+		SetResidencyBudget( &ImageRes::RTTI, 256 * mb );
+		SetResidencyBudget( &MeshRes::RTTI, 128 * mb );
+		SetResidencyBudget( &AudioRes::RTTI, 64 * mb );
+		SetResidencyBudget( &AnimationRes::RTTI, 64 * mb );
+#endif
+
+		// these loaders keep no shared state, decode them on the job system
+		SetParallelDecode( &MeshRes::RTTI, true );
+		SetParallelDecode( &ImageRes::RTTI, true );
+		SetParallelDecode( &AudioRes::RTTI, true );
+
 
 		// RegisterResourceType( , , , );
 	}
@@ -258,6 +306,7 @@ namespace Resources{
 				GPtr<Resource> pRes = pObject.downcast<Resource>();
 				n_assert( pRes.isvalid() );
 				pRes->SetResourceId( resID ); 
+				pRes->mLastUseFrame = mFrameIndex;
 				mResources.Add(resID, pRes );
 
 				return pRes;
@@ -270,7 +319,8 @@ namespace Resources{
 		ResourceServer::LoadResource( const GPtr<Resource>& res,
 		bool bAsyn /*= true*/,
 		const Util::FourCC& typeFilter /*= 'CYWJ'*/,
-		const Core::Rtti* manuLoaderType /*= NULL*/ )
+		const Core::Rtti* manuLoaderType /*= NULL*/,
+		Priority priority /*= ResourcePriority::Lowest*/ )
 	{
 		n_assert(mIsOpen);
 
@@ -278,6 +328,7 @@ namespace Resources{
 		{
 			return false;
 		}
+		res->mLastUseFrame = mFrameIndex;
 
 		// ֧ؼأҪUnLoad
 		if ( res->GetState() == Resource::Loaded )
@@ -308,6 +359,11 @@ namespace Resources{
 		// 첽أͨ߳̽
 		if ( bAsyn )
 		{
+			// a repeated request can only make a pending load more urgent
+			if ( !res->IsAsynProcessing() || priority < res->mLoadPriority )
+			{
+				SetLoadPriority(res, priority);
+			}
 			return _AsynPrepare(res, res->GetResourceId(), resLoader);//resURI
 		}
 		else
@@ -370,21 +426,16 @@ namespace Resources{
 
 		// 첽. Ƚⲿ豸IO
 		// 
-		PrepareStub stub;
-		stub.res = res;	// Real Res .  not Temp Res
-		stub.msg_stream = IO::ReadStream::Create();
-		stub.loader = resLoader;
-
-		n_assert( stub.msg_stream.isvalid() );
-		stub.msg_stream->SetFileName( resURI );
-		stub.msg_stream->SetStream( IO::MemoryStream::Create() );
-		IO::IoInterface::Instance()->Send( stub.msg_stream );
+		// wait for a read slot, the io wait queue hands out the reads by priority
+		LoadRequest request;
+		request.res = res;	// Real Res .  not Temp Res
+		request.loader = resLoader;
+		request.stageTime = mPipelineTimer.GetTime();
+		_PushRequest(mIoWaitQueue, request);
 
 		// Դ첽ʼ
 		res->AddAsynProcessingIndex();
 
-		mAsynPrepareQueue.AddBack(stub);
-
 		return true;
 	}
 	//------------------------------------------------------------------------
@@ -462,55 +513,106 @@ namespace Resources{
 
 		t.Reset();
 		_FlushPrepareList(t, Max_Tick_One_Frame);
+
+		// refill the decode and read slots by priority
+		_FlushDecodeWaitQueue();
+		_FlushIoWaitQueue();
+
+		mPipelineStats[IoWaitStage].depth = _CountRequests(mIoWaitQueue);
+		mPipelineStats[IoStage].depth = mAsynPrepareQueue.Size();
+		mPipelineStats[DecodeWaitStage].depth = _CountRequests(mDecodeWaitQueue);
+
+		++mFrameIndex;
+		if ( mResidencyUpdateInterval > 0 && 0 == (mFrameIndex % mResidencyUpdateInterval) )
+		{
+			UpdateResidency();
+		}
 	}
 	//------------------------------------------------------------------------
 	void 
 		ResourceServer::_FlushReadList(const Timing::Timer& t, Timing::Tick max_tick)
 	{
+		const Timing::Time budgetEnd = mPipelineTimer.GetTime() + mFinalizeBudget;
+		bool finalized = false;
+		SizeT numDecoding = 0;
+		SizeT numFinalizing = 0;
+
 		ReadStubList::Iterator endItor = mAsynReadQueue.End(); 
 		for ( ReadStubList::Iterator itor = mAsynReadQueue.Begin(); itor != endItor; )
 		{
-			/*Timing::Tick tick = t.GetTicks();
-			if ( tick > Max_Tick_One_Frame)
-			{
-			return;
-			}*/
-
 			bool isRead = false;
+			// fake stubs only wait for the real load of the same resource
+			const bool isFake = !itor->msg_loader.isvalid();
 
-			// Դ״̬Unload ٴ , ˵̼߳عˡظ
-			if( itor->res->GetState() != Resource::UnLoaded )
+			if ( !isFake && !itor->decoded )
 			{
-				isRead = true;
+				itor->decoded = itor->decode_job.isvalid() ? itor->decode_job->IsFinished() : itor->msg_loader->Handled();
+				if ( itor->decoded )
+				{
+					_LeaveStage(DecodeStage, itor->stageTime);
+					itor->stageTime = mPipelineTimer.GetTime();
+				}
 			}
 
-			if ( itor->msg_loader && itor->msg_loader->Handled() )	
+			if ( isFake || itor->decoded )
 			{
-				isRead = true;
-				if ( itor->msg_loader->GetResult() )
+				// Դ״̬Unload ٴ , ˵̼߳عˡظ
+				if( itor->res->GetState() != Resource::UnLoaded )
 				{
-					if( itor->res->SwapLoad( itor->msg_loader->GetResource() ) )
+					isRead = true;
+				}
+				else if ( !isFake )
+				{
+					const Timing::Time finalizeStart = mPipelineTimer.GetTime();
+					if ( finalized && finalizeStart >= budgetEnd )
+					{
+						// out of budget, keep it for the next frame
+						++numFinalizing;
+						++itor;
+						continue;
+					}
+
+					isRead = true;
+					finalized = true;
+					if ( itor->msg_loader->GetResult() )
 					{
-						n_printf("Asyn Load Resource %s OK \n", itor->res->GetResourceId().AsString().AsCharPtr() );
+						if( itor->res->SwapLoad( itor->msg_loader->GetResource() ) )
+						{
+							n_printf("Asyn Load Resource %s OK \n", itor->res->GetResourceId().AsString().AsCharPtr() );
+						}
+						else
+						{
+							n_warning("Asyn Load Resource %s Failed. Swap Load Failed \n", itor->res->GetResourceId().AsString().AsCharPtr() );
+							itor->res->SetState( Resource::Failed );
+						}
 					}
 					else
 					{
-						n_warning("Asyn Load Resource %s Failed. Swap Load Failed \n", itor->res->GetResourceId().AsString().AsCharPtr() );
+						n_warning("Asyn Load Resource %s Failed. Not Read From Stream \n", itor->res->GetResourceId().AsString().AsCharPtr() );
 						itor->res->SetState( Resource::Failed );
 					}
-
-				}
-				else
-				{
-					n_warning("Asyn Load Resource %s Failed. Not Read From Stream \n", itor->res->GetResourceId().AsString().AsCharPtr() );
-					itor->res->SetState( Resource::Failed );
+					_LeaveStage(FinalizeStage, itor->stageTime);
 				}
 			}
+			else
+			{
+				++numDecoding;
+			}
 
 			if ( isRead )
 			{
-				// Դ첽ʼ
-				itor->res->DecAsynProcessingIndex();
+				if ( !isFake )
+				{
+					if ( itor->decode_job.isvalid() )
+					{
+						itor->decode_job->End();
+					}
+					n_assert( mNumDecodes > 0 );
+					--mNumDecodes;
+
+					// only the real load counted the resource as processing
+					itor->res->DecAsynProcessingIndex();
+				}
 
 				// Ƴ
 				ReadStubList::Iterator Removeitor = itor;
@@ -522,7 +624,11 @@ namespace Resources{
 				++itor;
 			}
 		}
+
+		mPipelineStats[DecodeStage].depth = numDecoding;
+		mPipelineStats[FinalizeStage].depth = numFinalizing;
 	}
+	//------------------------------------------------------------------------
 	void 
 		ResourceServer::_FlushPrepareList(const Timing::Timer& t, Timing::Tick max_tick)
 	{
@@ -530,42 +636,33 @@ namespace Resources{
 		for ( PrepareStubbList::Iterator itor = mAsynPrepareQueue.Begin(); itor != endItor; )
 		{
 			Timing::Tick tick = t.GetTicks();
-			if ( tick > Max_Tick_One_Frame)
+			if ( tick > max_tick )
 			{
 				return;
 			}
 
 			if ( itor->msg_stream->Handled() )	
 			{
+				_LeaveStage(IoStage, itor->stageTime);
+
 				if ( itor->msg_stream->GetResult() )
 				{
-					// һзлĲ
-					GPtr<ResLoadMsg> msg = ResLoadMsg::Create();
-					msg->SetLoader( itor->loader );
-					msg->SetSream( itor->msg_stream->GetStream() );
-
-					// һʱԴ
-					GPtr<RefCounted> pTempResObject = itor->res->GetRtti()->Create();
-					n_assert( pTempResObject.isvalid() );
-					GPtr<Resource> pTempResData = pTempResObject.downcast<Resource>();
-					pTempResData->InitLoadParam( itor->res );
-					msg->SetResource( pTempResData );	// read to Temp Res
-
-					//
-					ReadStub stub;
-					stub.res = itor->res;
-					stub.msg_loader = msg;
-					mAsynReadQueue.AddBack(stub);
-					mThreadInterface->Send( msg );
+					// wait for a decode slot
+					LoadRequest request;
+					request.res = itor->res;
+					request.loader = itor->loader;
+					request.stream = itor->msg_stream->GetStream();
+					request.stageTime = mPipelineTimer.GetTime();
+					_PushRequest(mDecodeWaitQueue, request);
 				}
 				else
 				{
 					n_warning("Asyn Load Resource %s Failed. Can Not Handle Stream!\n", itor->res->GetResourceId().AsString().AsCharPtr());
 
 					itor->res->SetState( Resource::Failed );
+					itor->res->DecAsynProcessingIndex();
 				}
 
-
 				// Ƴ
 				PrepareStubbList::Iterator Removeitor = itor;
 				++itor;
@@ -577,6 +674,215 @@ namespace Resources{
 			}
 		}
 	}
+	//------------------------------------------------------------------------
+	void 
+		ResourceServer::_FlushIoWaitQueue(void)
+	{
+		LoadRequest request;
+		while ( mAsynPrepareQueue.Size() < mMaxReads && _PopRequest(mIoWaitQueue, request) )
+		{
+			_LeaveStage(IoWaitStage, request.stageTime);
+
+			// loaded synchronously meanwhile
+			if ( request.res->GetState() != Resource::UnLoaded )
+			{
+				request.res->DecAsynProcessingIndex();
+				continue;
+			}
+
+			PrepareStub stub;
+			stub.res = request.res;
+			stub.loader = request.loader;
+			stub.msg_stream = IO::ReadStream::Create();
+			stub.stageTime = mPipelineTimer.GetTime();
+
+			n_assert( stub.msg_stream.isvalid() );
+			stub.msg_stream->SetFileName( request.res->GetResourceId() );
+			stub.msg_stream->SetStream( IO::MemoryStream::Create() );
+			IO::IoInterface::Instance()->Send( stub.msg_stream );
+
+			mAsynPrepareQueue.AddBack(stub);
+		}
+	}
+	//------------------------------------------------------------------------
+	void 
+		ResourceServer::_FlushDecodeWaitQueue(void)
+	{
+		const bool hasJobSystem = Jobs::JobSystem::HasInstance();
+
+		LoadRequest request;
+		while ( mNumDecodes < mMaxDecodes && _PopRequest(mDecodeWaitQueue, request) )
+		{
+			_LeaveStage(DecodeWaitStage, request.stageTime);
+
+			if ( request.res->GetState() != Resource::UnLoaded )
+			{
+				request.res->DecAsynProcessingIndex();
+				continue;
+			}
+
+			GPtr<ResLoadMsg> msg = ResLoadMsg::Create();
+			msg->SetLoader( request.loader );
+			msg->SetSream( request.stream );
+
+			// decode to a temp resource, swapped into the real one when finalized
+			GPtr<RefCounted> pTempResObject = request.res->GetRtti()->Create();
+			n_assert( pTempResObject.isvalid() );
+			GPtr<Resource> pTempResData = pTempResObject.downcast<Resource>();
+			pTempResData->InitLoadParam( request.res );
+			msg->SetResource( pTempResData );
+
+			ReadStub stub;
+			stub.res = request.res;
+			stub.msg_loader = msg.upcast<ResMsg>();
+			stub.stageTime = mPipelineTimer.GetTime();
+
+			if ( hasJobSystem && _IsParallelDecode(request.res->GetRtti()) )
+			{
+				stub.decode_job = ResDecodeJob::Create();
+				stub.decode_job->Setup( msg );
+				stub.decode_job->Run();
+			}
+			else
+			{
+				mThreadInterface->Send( msg );
+			}
+
+			mAsynReadQueue.AddBack(stub);
+			++mNumDecodes;
+		}
+	}
+	//------------------------------------------------------------------------
+	void 
+		ResourceServer::_PushRequest(LoadRequestQueue& queue, LoadRequest& request)
+	{
+		request.priority = request.res->mLoadPriority;
+		request.serial = mLoadSerial++;
+		request.res->mLoadSerial = request.serial;
+
+		queue.Append(request);
+		std::push_heap(queue.Begin(), queue.End());
+	}
+	//------------------------------------------------------------------------
+	bool 
+		ResourceServer::_PopRequest(LoadRequestQueue& queue, LoadRequest& request)
+	{
+		while ( !queue.IsEmpty() )
+		{
+			std::pop_heap(queue.Begin(), queue.End());
+			request = queue.Back();
+			queue.EraseIndex(queue.Size() - 1);
+
+			// skip the stale entries left behind by SetLoadPriority
+			if ( request.res->mLoadSerial == request.serial )
+			{
+				request.res->mLoadSerial = InvalidIndex;
+				return true;
+			}
+		}
+		return false;
+	}
+	//------------------------------------------------------------------------
+	SizeT 
+		ResourceServer::_CountRequests(const LoadRequestQueue& queue) const
+	{
+		SizeT count = 0;
+		for ( IndexT i = 0; i < queue.Size(); ++i )
+		{
+			if ( queue[i].res->mLoadSerial == queue[i].serial )
+			{
+				++count;
+			}
+		}
+		return count;
+	}
+	//------------------------------------------------------------------------
+	void 
+		ResourceServer::SetLoadPriority( const GPtr<Resource>& res, Priority priority )
+	{
+		n_assert( res.isvalid() );
+		if ( res->mLoadPriority == priority )
+		{
+			return;
+		}
+		res->mLoadPriority = priority;
+
+		if ( InvalidIndex == res->mLoadSerial )
+		{
+			return;
+		}
+
+		// push the pending request again, the old entry turns stale
+		LoadRequestQueue* queues[2] = { &mIoWaitQueue, &mDecodeWaitQueue };
+		for ( IndexT q = 0; q < 2; ++q )
+		{
+			LoadRequestQueue& queue = *queues[q];
+			for ( IndexT i = 0; i < queue.Size(); ++i )
+			{
+				if ( queue[i].res == res && queue[i].serial == res->mLoadSerial )
+				{
+					LoadRequest request = queue[i];
+					_PushRequest(queue, request);
+					return;
+				}
+			}
+		}
+	}
+	//------------------------------------------------------------------------
+	void 
+		ResourceServer::_LeaveStage(PipelineStage stage, Timing::Time enterTime)
+	{
+		PipelineStageStats& stats = mPipelineStats[stage];
+		const Timing::Time elapsed = mPipelineTimer.GetTime() - enterTime;
+		++stats.completed;
+		stats.totalTime += elapsed;
+		stats.maxTime = Math::n_max( stats.maxTime, elapsed );
+	}
+	//------------------------------------------------------------------------
+	bool 
+		ResourceServer::_IsParallelDecode(const Core::Rtti* resType) const
+	{
+		return InvalidIndex != mParallelDecodeTypes.FindIndex(resType);
+	}
+	//------------------------------------------------------------------------
+	void 
+		ResourceServer::SetPipelineLimits( SizeT maxReads, SizeT maxDecodes, Timing::Time finalizeBudget )
+	{
+		n_assert( maxReads > 0 && maxDecodes > 0 );
+		mMaxReads = maxReads;
+		mMaxDecodes = maxDecodes;
+		mFinalizeBudget = finalizeBudget;
+	}
+	//------------------------------------------------------------------------
+	void 
+		ResourceServer::SetParallelDecode( const Core::Rtti* resType, bool bParallel )
+	{
+		n_assert( resType );
+		IndexT index = mParallelDecodeTypes.FindIndex(resType);
+		if ( bParallel && InvalidIndex == index )
+		{
+			mParallelDecodeTypes.Append(resType);
+		}
+		else if ( !bParallel && InvalidIndex != index )
+		{
+			mParallelDecodeTypes.EraseIndex(index);
+		}
+	}
+	//------------------------------------------------------------------------
+	const char* 
+		ResourceServer::GetPipelineStageName( PipelineStage stage )
+	{
+		switch ( stage )
+		{
+		case IoWaitStage:		return "IoWait";
+		case IoStage:			return "Io";
+		case DecodeWaitStage:	return "DecodeWait";
+		case DecodeStage:		return "Decode";
+		case FinalizeStage:		return "Finalize";
+		default:				return "Invalid";
+		}
+	}
+
 	//------------------------------------------------------------------------
 	void 
 		ResourceServer::UnLoadUnreferencedResources(void)
@@ -613,6 +919,115 @@ namespace Resources{
 		mResources.Swap(useRes);
 	}
 	//------------------------------------------------------------------------
+	void 
+		ResourceServer::SetResidencyBudget( const Core::Rtti* resType, SizeT budgetBytes )
+	{
+		n_assert( resType && resType->IsDerivedFrom( Resource::RTTI ) );
+		IndexT index = _FindResidencyStats( resType );
+		if ( InvalidIndex == index || mResidencyStats[index].resType != resType )
+		{
+			ResidencyStats stats;
+			stats.resType = resType;
+			mResidencyStats.Append( stats );
+			index = mResidencyStats.Size() - 1;
+		}
+		mResidencyStats[index].budget = budgetBytes;
+	}
+	//------------------------------------------------------------------------
+	SizeT 
+		ResourceServer::GetResidencyBudget( const Core::Rtti* resType ) const
+	{
+		IndexT index = _FindResidencyStats( resType );
+		return ( InvalidIndex != index ) ? mResidencyStats[index].budget : 0;
+	}
+	//------------------------------------------------------------------------
+	IndexT 
+		ResourceServer::_FindResidencyStats( const Core::Rtti* resType ) const
+	{
+		// the nearest budgeted base type wins, there are only a few budgets
+		for ( const Core::Rtti* rtti = resType; rtti; rtti = rtti->GetParent() )
+		{
+			for ( IndexT index = 0; index < mResidencyStats.Size(); ++index )
+			{
+				if ( mResidencyStats[index].resType == rtti )
+				{
+					return index;
+				}
+			}
+		}
+		return InvalidIndex;
+	}
+	//------------------------------------------------------------------------
+	void 
+		ResourceServer::UpdateResidency(void)
+	{
+		for ( IndexT index = 0; index < mResidencyStats.Size(); ++index )
+		{
+			mResidencyStats[index].residentBytes = 0;
+			mResidencyStats[index].numResident = 0;
+		}
+		mEvictCandidates.Clear(false);
+
+		SizeT size = mResources.Size();
+		for ( IndexT index = 0; index < size; ++index )
+		{
+			Resource* res = mResources.ValueAtIndex(index).get();
+			if ( res->GetState() != Resource::Loaded )
+			{
+				continue;
+			}
+
+			if ( 0 == res->mResidentSize )
+			{
+				// first update since the resource was (re)loaded
+				res->mResidentSize = Math::n_max( res->CalculateRuntimeSize(), 1 );
+				res->mLastUseFrame = mFrameIndex;
+			}
+
+			bool referenced = res->GetRefCount() > UnRefResCounter;
+			if ( referenced )
+			{
+				res->mLastUseFrame = mFrameIndex;
+			}
+
+			IndexT statsIndex = _FindResidencyStats( res->GetRtti() );
+			if ( InvalidIndex == statsIndex )
+			{
+				continue;
+			}
+			ResidencyStats& stats = mResidencyStats[statsIndex];
+			stats.residentBytes += res->mResidentSize;
+			++stats.numResident;
+
+			if ( stats.budget > 0 && !referenced && !res->IsManuLoad() && !res->IsAsynProcessing() )
+			{
+				EvictCandidate candidate;
+				candidate.res = res;
+				mEvictCandidates.Append( candidate );
+			}
+		}
+
+		// least recently used first
+		mEvictCandidates.Sort();
+		for ( IndexT index = 0; index < mEvictCandidates.Size(); ++index )
+		{
+			Resource* res = mEvictCandidates[index].res;
+			ResidencyStats& stats = mResidencyStats[ _FindResidencyStats( res->GetRtti() ) ];
+			if ( stats.residentBytes <= stats.budget )
+			{
+				continue;
+			}
+
+			SizeT resSize = res->mResidentSize;
+			stats.residentBytes -= resSize;
+			--stats.numResident;
+			++stats.numEvicted;
+			stats.evictedBytes += resSize;
+			res->UnLoad();
+		}
+		mEvictCandidates.Clear(false);
+	}
+	//------------------------------------------------------------------------
 	IO::URI
 		ResourceServer::_ConstructURI( const IO::URI& defaultUri, 
 		const ResourceId& resID )
@@ -46,6 +46,7 @@ Step2  
 #include "util/queue.h"
 #include "util/list.h"
 #include "resource/resourceinterface.h"
+#include "resource/resdecodejob.h"
 
 #include "io/iointerfaceprotocol.h"
 #include "timing/timer.h"
@@ -163,6 +164,7 @@ namespace Resources
 		* @param: const Core::Rtti * manuLoaderType  ֶõԴȡ͡
 		1ΪʱʹtypeFilterעġҲԴʧܣؿָ; 
 		2ΪʱʹûԶĶȡ 
+		* @param: Priority priority  asynchronous load priority, smaller is more urgent
 		* @return: bool                              ͬأbool ʾǷسɹ
 		첽أbool ʾɹ뵽ضУfalseʾѾڼض
 		* @see: 
@@ -171,7 +173,18 @@ namespace Resources
 		bool LoadResource( const GPtr<Resource>& res,
 			bool bAsyn = true,
 			const Util::FourCC& typeFilter = 'CYWJ',
-			const Core::Rtti* manuLoaderType = NULL );
+			const Core::Rtti* manuLoaderType = NULL,
+			Priority priority = ResourcePriority::Lowest );
+
+		/**
+		* SetLoadPriority  change the priority of a pending asynchronous load
+		* @param: const GPtr<Resource> & res  
+		* @param: Priority priority  smaller is more urgent
+		* @return: void  
+		* @see: 
+		* @remark:  takes effect while the resource waits for a read or a decode slot
+		*/
+		void SetLoadPriority( const GPtr<Resource>& res, Priority priority );
 
 		/**
 		* SaveResource  ͬ洢һԴ
@@ -217,6 +230,126 @@ namespace Resources
 		*/
 		void DicardUnreferencedResources(void);
 
+		/// residency statistics of one budgeted resource type
+		struct ResidencyStats
+		{
+			ResidencyStats(): resType(NULL), budget(0), residentBytes(0), numResident(0), numEvicted(0), evictedBytes(0) { };
+			const Core::Rtti* resType;	//	the budgeted resource type, derived types are accounted to it
+			SizeT budget;	//	0 means unlimited
+			SizeT residentBytes;
+			SizeT numResident;
+			SizeT numEvicted;
+			SizeT evictedBytes;
+		};
+
+		/**
+		* SetResidencyBudget  set the memory budget of a resource type
+		* @param: const Core::Rtti * resType  resource type, resources of derived types are accounted to it
+		* @param: SizeT budgetBytes  0 means unlimited, the type is tracked but never evicted
+		* @return: void  
+		* @see: UpdateResidency
+		* @remark:  only unreferenced, not manual loaded resources are evicted, least recently used first
+		*/
+		void SetResidencyBudget( const Core::Rtti* resType, SizeT budgetBytes );
+
+		/**
+		* GetResidencyBudget  get the memory budget of a resource type, 0 if unlimited or not tracked
+		* @param: const Core::Rtti * resType  
+		* @return: SizeT  
+		* @see: 
+		* @remark:  
+		*/
+		SizeT GetResidencyBudget( const Core::Rtti* resType ) const;
+
+		/**
+		* SetResidencyUpdateInterval  set the number of frames between two residency updates done by Flush
+		* @param: SizeT frames  0 disables the automatic update
+		* @return: void  
+		* @see: 
+		* @remark:  
+		*/
+		void SetResidencyUpdateInterval( SizeT frames );
+
+		/**
+		* UpdateResidency  account the loaded resources per budget and evict unreferenced ones LRU-first when over budget
+		* @param: void  
+		* @return: void  
+		* @see: 
+		* @remark:  walks all resources, called by Flush every residency update interval frames
+		*/
+		void UpdateResidency(void);
+
+		/**
+		* GetResidencyStats  get the statistics of all budgeted resource types, as of the last UpdateResidency
+		* @return: const Util::Array<ResidencyStats>&  
+		* @see: 
+		* @remark:  
+		*/
+		const Util::Array<ResidencyStats>& GetResidencyStats(void) const;
+
+		/**
+		* GetFrameIndex  the number of Flush calls, used as the residency clock
+		* @return: IndexT  
+		* @see: 
+		* @remark:  
+		*/
+		IndexT GetFrameIndex(void) const;
+
+		/// stages of the asynchronous load pipeline
+		enum PipelineStage
+		{
+			IoWaitStage = 0,	//	queued by priority, waiting for a read slot
+			IoStage,			//	read in flight on the io thread
+			DecodeWaitStage,	//	read done, queued by priority, waiting for a decode slot
+			DecodeStage,		//	decode in flight on the job system or the resource thread
+			FinalizeStage,		//	decoded, waiting to be swapped in on the main thread
+
+			NumPipelineStages
+		};
+
+		/// statistics of one pipeline stage
+		struct PipelineStageStats
+		{
+			PipelineStageStats(): depth(0), completed(0), totalTime(0.0), maxTime(0.0) { };
+			SizeT depth;	//	requests in the stage after the last Flush
+			SizeT completed;	//	requests that left the stage
+			Timing::Time totalTime;	//	summed time spent in the stage, divide by completed for the average
+			Timing::Time maxTime;
+		};
+
+		/**
+		* SetPipelineLimits  configure the asynchronous load pipeline
+		* @param: SizeT maxReads  max number of reads in flight on the io thread
+		* @param: SizeT maxDecodes  max number of decodes in flight
+		* @param: Timing::Time finalizeBudget  main thread seconds per Flush spent on swapping in decoded resources
+		* @return: void  
+		* @see: 
+		* @remark:  at least one decoded resource is finalized per Flush
+		*/
+		void SetPipelineLimits( SizeT maxReads, SizeT maxDecodes, Timing::Time finalizeBudget );
+
+		/**
+		* SetParallelDecode  decode a resource type on the job system instead of the resource thread
+		* @param: const Core::Rtti * resType  
+		* @param: bool bParallel  the loader of the type must be safe to run on several threads at once
+		* @return: void  
+		* @see: 
+		* @remark:  
+		*/
+		void SetParallelDecode( const Core::Rtti* resType, bool bParallel );
+
+		/**
+		* GetPipelineStats  get the statistics of a pipeline stage
+		* @param: PipelineStage stage  
+		* @return: const PipelineStageStats&  
+		* @see: 
+		* @remark:  
+		*/
+		const PipelineStageStats& GetPipelineStats( PipelineStage stage ) const;
+
+		/// get a pipeline stage name, for debug output
+		static const char* GetPipelineStageName( PipelineStage stage );
+
 	protected:
 		IO::URI _ConstructURI( const IO::URI& defaultUri, 
 			const ResourceId& resID );
@@ -235,6 +368,13 @@ namespace Resources
 		void _FlushReadList(const Timing::Timer& t ,Timing::Tick max_tick);
 		void _FlushPrepareList(const Timing::Timer& t, Timing::Tick max_tick);
 
+		IndexT _FindResidencyStats(const Core::Rtti* resType) const;
+
+		void _FlushIoWaitQueue(void);
+		void _FlushDecodeWaitQueue(void);
+		void _LeaveStage(PipelineStage stage, Timing::Time enterTime);
+		bool _IsParallelDecode(const Core::Rtti* resType) const;
+
 	protected:
 		// ԴĶȡдע ݽṹ
 		struct LoadSaveRegistry 
@@ -258,12 +398,18 @@ namespace Resources
 			GPtr<Resource> res;	//	صԴ
 			GPtr<ResourceLoader> loader;
 			GPtr<IO::ReadStream> msg_stream;	//	IO߳ͨŵϢ
+			Timing::Time stageTime;	//	when the request entered its current stage
+			PrepareStub(): stageTime(0.0) { };
 		};
 
 		struct ReadStub		// лıش
 		{
 			GPtr<Resource> res;	//	صԴ
 			GPtr<ResMsg> msg_loader;	//	л߳ͨŵϢ
+			GPtr<ResDecodeJob> decode_job;	//	set when decoded on the job system instead of the resource thread
+			Timing::Time stageTime;
+			bool decoded;	//	decode finished, waiting for the finalize budget
+			ReadStub(): stageTime(0.0), decoded(false) { };
 		};
 
 		typedef Util::List<PrepareStub> PrepareStubbList;
@@ -272,6 +418,50 @@ namespace Resources
 		GPtr<ResourceInterface> mThreadInterface;//	л̡߳ڴзлԴ
 		PrepareStubbList mAsynPrepareQueue;	//	¼IO߳Уⲿ豸IOԴ
 		ReadStubList mAsynReadQueue;	//	¼л߳УзлԴ
+
+		// residency
+		struct EvictCandidate
+		{
+			Resource* res;
+			bool operator<(const EvictCandidate& rhs) const { return res->GetLastUseFrame() < rhs.res->GetLastUseFrame(); }
+		};
+		Util::Array<ResidencyStats> mResidencyStats;	//	one entry per budgeted resource type
+		Util::Array<EvictCandidate> mEvictCandidates;	//	scratch array, kept to avoid reallocations
+		IndexT mFrameIndex;
+		SizeT mResidencyUpdateInterval;
+
+		// pipeline queues. they are binary heaps, a re-prioritized request is pushed again and
+		// its old entry is skipped when popped because the serial no longer matches the resource
+		struct LoadRequest
+		{
+			GPtr<Resource> res;
+			GPtr<ResourceLoader> loader;
+			GPtr<IO::Stream> stream;	//	the read data, empty while waiting for the read
+			Priority priority;
+			IndexT serial;
+			Timing::Time stageTime;
+			// the heap top is the most urgent request, the older one on equal priority
+			bool operator<(const LoadRequest& rhs) const
+			{
+				return priority != rhs.priority ? priority > rhs.priority : serial > rhs.serial;
+			}
+		};
+		typedef Util::Array<LoadRequest> LoadRequestQueue;
+
+		void _PushRequest(LoadRequestQueue& queue, LoadRequest& request);
+		bool _PopRequest(LoadRequestQueue& queue, LoadRequest& request);
+		SizeT _CountRequests(const LoadRequestQueue& queue) const;
+
+		LoadRequestQueue mIoWaitQueue;
+		LoadRequestQueue mDecodeWaitQueue;
+		IndexT mLoadSerial;
+		SizeT mMaxReads;
+		SizeT mMaxDecodes;
+		SizeT mNumDecodes;
+		Timing::Time mFinalizeBudget;
+		Util::Array<const Core::Rtti*> mParallelDecodeTypes;
+		Timing::Timer mPipelineTimer;
+		PipelineStageStats mPipelineStats[NumPipelineStages];
 	};
 	//------------------------------------------------------------------------
 	inline
@@ -288,6 +478,35 @@ namespace Resources
 		return mResources.FindIndex( resID ) != InvalidIndex;
 	}
 	//------------------------------------------------------------------------
+	inline
+		const Util::Array<ResourceServer::ResidencyStats>&
+		ResourceServer::GetResidencyStats(void) const
+	{
+		return mResidencyStats;
+	}
+	//------------------------------------------------------------------------
+	inline
+		const ResourceServer::PipelineStageStats&
+		ResourceServer::GetPipelineStats( PipelineStage stage ) const
+	{
+		n_assert( stage >= 0 && stage < NumPipelineStages );
+		return mPipelineStats[stage];
+	}
+	//------------------------------------------------------------------------
+	inline
+		IndexT
+		ResourceServer::GetFrameIndex(void) const
+	{
+		return mFrameIndex;
+	}
+	//------------------------------------------------------------------------
+	inline
+		void
+		ResourceServer::SetResidencyUpdateInterval( SizeT frames )
+	{
+		mResidencyUpdateInterval = frames;
+	}
+	//------------------------------------------------------------------------
 	inline
 		GPtr<Resource> 
 		ResourceServer::GetResource( const ResourceId& resID )
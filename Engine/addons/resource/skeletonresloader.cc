@@ -65,6 +65,7 @@ namespace Resources
 		n_assert(pReader.isvalid());
 
 		pReader->SetStream( mStream );
+		pReader->SetMemoryMappingEnabled( true );
 
 		//  ļС˵
 #ifdef __OSX__
@@ -324,6 +324,7 @@ namespace Serialization
 		}
 
 		mBinReaderPtr->SetStream( mStream );
+		mBinReaderPtr->SetBufferedReadEnabled( true );
 		bool bOK = mBinReaderPtr->Open();
 		if ( !bOK )
 		{
@@ -0,0 +1,147 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __SOUND_COMMIT__
+
+#include "stdneb.h"
+#include "SoundMixer.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SOUNDMIXER_USE_SSE (1)
+#else
+#define SOUNDMIXER_USE_SSE (0)
+#endif
+
+namespace Sound
+{
+	//------------------------------------------------------------------------------
+	void SoundMixer::MixPcm16(float* accum, const short* src, SizeT count, float gain)
+	{
+		const float scale = gain * (1.0f / 32768.0f);
+		IndexT i = 0;
+#if SOUNDMIXER_USE_SSE
+		const __m128 vScale = _mm_set1_ps(scale);
+		for (; i + 8 <= count; i += 8)
+		{
+			__m128i pcm = _mm_loadu_si128((const __m128i*)(src + i));
+			// sign extend the 8 shorts into two groups of 4 ints
+			__m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(pcm, pcm), 16);
+			__m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(pcm, pcm), 16);
+			__m128 a0 = _mm_loadu_ps(accum + i);
+			__m128 a1 = _mm_loadu_ps(accum + i + 4);
+			a0 = _mm_add_ps(a0, _mm_mul_ps(_mm_cvtepi32_ps(lo), vScale));
+			a1 = _mm_add_ps(a1, _mm_mul_ps(_mm_cvtepi32_ps(hi), vScale));
+			_mm_storeu_ps(accum + i, a0);
+			_mm_storeu_ps(accum + i + 4, a1);
+		}
+#endif
+		for (; i < count; ++i)
+		{
+			accum[i] += src[i] * scale;
+		}
+	}
+	//------------------------------------------------------------------------------
+	void SoundMixer::ResolvePcm16(short* dst, const float* accum, SizeT count)
+	{
+		IndexT i = 0;
+#if SOUNDMIXER_USE_SSE
+		const __m128 vScale = _mm_set1_ps(32768.0f);
+		for (; i + 8 <= count; i += 8)
+		{
+			__m128i lo = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(accum + i), vScale));
+			__m128i hi = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(accum + i + 4), vScale));
+			// packs saturates to the 16 bit range
+			_mm_storeu_si128((__m128i*)(dst + i), _mm_packs_epi32(lo, hi));
+		}
+#endif
+		for (; i < count; ++i)
+		{
+			float s = accum[i] * 32768.0f;
+			if (s > 32767.0f)
+			{
+				s = 32767.0f;
+			}
+			else if (s < -32768.0f)
+			{
+				s = -32768.0f;
+			}
+			dst[i] = (short)(s < 0.0f ? s - 0.5f : s + 0.5f);
+		}
+	}
+	//------------------------------------------------------------------------------
+	static void WriteLE32(ubyte* dst, uint value)
+	{
+		dst[0] = (ubyte)(value & 0xff);
+		dst[1] = (ubyte)((value >> 8) & 0xff);
+		dst[2] = (ubyte)((value >> 16) & 0xff);
+		dst[3] = (ubyte)((value >> 24) & 0xff);
+	}
+	//------------------------------------------------------------------------------
+	static void WriteLE16(ubyte* dst, ushort value)
+	{
+		dst[0] = (ubyte)(value & 0xff);
+		dst[1] = (ubyte)((value >> 8) & 0xff);
+	}
+	//------------------------------------------------------------------------------
+	bool SoundMixer::WriteWave(const GPtr<IO::Stream>& stream, const short* samples, SizeT count, int channels, int frequency)
+	{
+		n_assert(stream.isvalid());
+		if (channels <= 0 || frequency <= 0)
+		{
+			return false;
+		}
+
+		stream->SetAccessMode(IO::Stream::WriteAccess);
+		if (!stream->IsOpen() && !stream->Open())
+		{
+			return false;
+		}
+
+		const uint dataSize = (uint)count * sizeof(short);
+		const ushort blockAlign = (ushort)(channels * sizeof(short));
+		ubyte header[44];
+		Memory::Copy("RIFF", header, 4);
+		WriteLE32(header + 4, 36 + dataSize);
+		Memory::Copy("WAVEfmt ", header + 8, 8);
+		WriteLE32(header + 16, 16);
+		WriteLE16(header + 20, 1);	// pcm
+		WriteLE16(header + 22, (ushort)channels);
+		WriteLE32(header + 24, (uint)frequency);
+		WriteLE32(header + 28, (uint)frequency * blockAlign);
+		WriteLE16(header + 32, blockAlign);
+		WriteLE16(header + 34, 16);
+		Memory::Copy("data", header + 36, 4);
+		WriteLE32(header + 40, dataSize);
+
+		stream->Write(header, sizeof(header));
+		if (dataSize > 0)
+		{
+			// wave data is little endian, like every target we ship on
+			stream->Write(samples, dataSize);
+		}
+		stream->Close();
+		return true;
+	}
+}
+
+#endif // __SOUND_COMMIT__
@@ -0,0 +1,47 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __SOUNDMIXER_H__
+#define __SOUNDMIXER_H__
+
+#ifndef __SOUND_COMMIT__
+
+#include "io/stream.h"
+
+namespace Sound
+{
+	// 16 bit pcm mixing helpers, used to mix down streamed audio without an output device
+	class SoundMixer
+	{
+	public:
+		/// accum[i] += src[i] * gain / 32768, count is the number of samples (not frames)
+		static void MixPcm16(float* accum, const short* src, SizeT count, float gain);
+		/// dst[i] = accum[i] * 32768 clamped to 16 bit
+		static void ResolvePcm16(short* dst, const float* accum, SizeT count);
+		/// write interleaved 16 bit pcm as a RIFF wave file
+		static bool WriteWave(const GPtr<IO::Stream>& stream, const short* samples, SizeT count, int channels, int frequency);
+	};
+}
+
+#endif // __SOUND_COMMIT__
+#endif // __SOUNDMIXER_H__
@@ -0,0 +1,287 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __SOUND_COMMIT__
+
+#include "stdneb.h"
+#include "SoundStreamThread.h"
+#include "SoundSystemSourceOpenAL.h"
+#include "SoundMixer.h"
+#include "threading/interlocked.h"
+
+namespace Sound
+{
+	__ImplementClass(Sound::SoundStreamThread, 'SSTT', Threading::Thread);
+
+	//------------------------------------------------------------------------------
+	static bool _SortByAudibility(SoundSystemSourceOpenAL* a, SoundSystemSourceOpenAL* b)
+	{
+		return a->GetStreamAudibility() > b->GetStreamAudibility();
+	}
+	//------------------------------------------------------------------------------
+	SoundStreamThread::SoundStreamThread()
+		: mWriteIndex(0)
+		, mReadIndex(0)
+		, mWakeup(false)
+		, mAck(false)
+		, mMaxRealStreams(16)
+		, mCaptureMaxSamples(0)
+		, mCaptureSeconds(0.0f)
+		, mCaptureChannels(0)
+		, mCaptureFrequency(0)
+		, mCapturing(false)
+		, mCaptureResult(false)
+	{
+		this->SetName("SoundStreamThread");
+		this->SetPriority(Threading::Thread::High);
+	}
+	//------------------------------------------------------------------------------
+	SoundStreamThread::~SoundStreamThread()
+	{
+		n_assert(!this->IsRunning());
+	}
+	//------------------------------------------------------------------------------
+	void SoundStreamThread::PushCommand(CommandCode code, SoundSystemSourceOpenAL* source, float param)
+	{
+		int write = mWriteIndex;
+		int next = (write + 1) & (QueueSize - 1);
+		while (next == mReadIndex)
+		{
+			// ring is full, let the stream thread catch up
+			mWakeup.Signal();
+			n_sleep(0.001);
+		}
+
+		mCommands[write].code = code;
+		mCommands[write].source = source;
+		mCommands[write].param = param;
+
+		// publishing the index is a full barrier, the command is visible before it
+		Threading::Interlocked::Exchange(&mWriteIndex, next);
+		mWakeup.Signal();
+	}
+	//------------------------------------------------------------------------------
+	bool SoundStreamThread::PopCommand(Command& cmd)
+	{
+		int read = mReadIndex;
+		if (read == mWriteIndex)
+		{
+			return false;
+		}
+		cmd = mCommands[read];
+		Threading::Interlocked::Exchange(&mReadIndex, (read + 1) & (QueueSize - 1));
+		return true;
+	}
+	//------------------------------------------------------------------------------
+	void SoundStreamThread::AddStream(SoundSystemSourceOpenAL* source)
+	{
+		n_assert(NULL != source && NULL == source->mStreamThread);
+		source->mStreamThread = this;
+		PushCommand(AddCmd, source, 0.0f);
+	}
+	//------------------------------------------------------------------------------
+	void SoundStreamThread::RemoveStream(SoundSystemSourceOpenAL* source)
+	{
+		n_assert(NULL != source && this == source->mStreamThread);
+		PushCommand(RemoveCmd, source, 0.0f);
+		mAck.Wait();
+		source->mStreamThread = NULL;
+	}
+	//------------------------------------------------------------------------------
+	void SoundStreamThread::SetMaxRealStreams(SizeT count)
+	{
+		n_assert(count > 0);
+		mMaxRealStreams = count;
+	}
+	//------------------------------------------------------------------------------
+	void SoundStreamThread::BeginCapture(float maxSeconds)
+	{
+		n_assert(maxSeconds > 0.0f);
+		PushCommand(BeginCaptureCmd, NULL, maxSeconds);
+	}
+	//------------------------------------------------------------------------------
+	bool SoundStreamThread::EndCapture(const GPtr<IO::Stream>& stream)
+	{
+		mCaptureStream = stream;
+		PushCommand(EndCaptureCmd, NULL, 0.0f);
+		mAck.Wait();
+		mCaptureStream = NULL;
+		return mCaptureResult;
+	}
+	//------------------------------------------------------------------------------
+	void SoundStreamThread::EmitWakeupSignal()
+	{
+		mWakeup.Signal();
+	}
+	//------------------------------------------------------------------------------
+	void SoundStreamThread::DoWork()
+	{
+		while (!this->ThreadStopRequested())
+		{
+			ProcessCommands();
+			UpdateStreams();
+			mWakeup.WaitTimeout(StreamIntervalMs);
+		}
+		ProcessCommands();
+	}
+	//------------------------------------------------------------------------------
+	void SoundStreamThread::ProcessCommands()
+	{
+		Command cmd;
+		while (PopCommand(cmd))
+		{
+			switch (cmd.code)
+			{
+			case AddCmd:
+				mStreams.Append(cmd.source);
+				cmd.source->StreamPrefill();
+				break;
+
+			case RemoveCmd:
+				{
+					IndexT index = mStreams.FindIndex(cmd.source);
+					if (InvalidIndex != index)
+					{
+						mStreams.EraseIndexSwap(index);
+					}
+					mAck.Signal();
+				}
+				break;
+
+			case BeginCaptureCmd:
+				mCaptureMix.Clear();
+				mCaptureMaxSamples = 0;
+				mCaptureChannels = 0;
+				mCaptureFrequency = 0;
+				mCapturing = true;
+				mCaptureTimer.Reset();
+				mCaptureTimer.Start();
+				mCaptureSeconds = cmd.param;
+				for (IndexT i = 0; i < mStreams.Size(); ++i)
+				{
+					mStreams[i]->mCaptureFrame = InvalidIndex;
+				}
+				break;
+
+			case EndCaptureCmd:
+				{
+					mCaptureResult = false;
+					if (mCapturing && mCaptureStream.isvalid() && mCaptureChannels > 0)
+					{
+						Util::Array<short> pcm;
+						pcm.Resize(mCaptureMix.Size(), 0);
+						if (!mCaptureMix.IsEmpty())
+						{
+							SoundMixer::ResolvePcm16(&pcm[0], &mCaptureMix[0], mCaptureMix.Size());
+						}
+						mCaptureResult = SoundMixer::WriteWave(mCaptureStream, pcm.IsEmpty() ? NULL : &pcm[0], pcm.Size(), mCaptureChannels, mCaptureFrequency);
+					}
+					mCapturing = false;
+					mCaptureTimer.Stop();
+					mCaptureMix.Clear();
+					mAck.Signal();
+				}
+				break;
+			}
+		}
+	}
+	//------------------------------------------------------------------------------
+	void SoundStreamThread::UpdateStreams()
+	{
+		// - rank the streams that want to play, only the most audible ones get decoded
+		mSorted.Clear();
+		for (IndexT i = 0; i < mStreams.Size(); ++i)
+		{
+			SoundSystemSourceOpenAL* source = mStreams[i];
+			if (source->WantsStreamUpdate())
+			{
+				source->UpdateStreamAudibility();
+				mSorted.Append(source);
+			}
+		}
+		if (mSorted.Size() > (SizeT)mMaxRealStreams)
+		{
+			std::sort(mSorted.Begin(), mSorted.End(), _SortByAudibility);
+		}
+
+		for (IndexT i = 0; i < mSorted.Size(); ++i)
+		{
+			SoundSystemSourceOpenAL* source = mSorted[i];
+			bool audible = i < (IndexT)mMaxRealStreams && source->GetStreamAudibility() > 0.0f;
+			source->SetStreamVirtual(!audible);
+			if (audible)
+			{
+				source->StreamRefill();
+			}
+		}
+	}
+	//------------------------------------------------------------------------------
+	void SoundStreamThread::CaptureBlock(SoundSystemSourceOpenAL* source, const void* data, SizeT bytes, float gain)
+	{
+		if (!mCapturing)
+		{
+			return;
+		}
+
+		SoundBuffer* buffer = source->GetSoundBuffer();
+		int channels = (int)buffer->GetBufferChannelCount();
+		int frequency = (int)buffer->GetBufferFrequency();
+		if (0 == mCaptureChannels)
+		{
+			// - the first captured stream decides the format of the mix
+			mCaptureChannels = channels;
+			mCaptureFrequency = frequency;
+			mCaptureMaxSamples = (SizeT)(mCaptureSeconds * frequency) * channels;
+			mCaptureMix.Reserve(mCaptureMaxSamples);
+		}
+		if (channels != mCaptureChannels || frequency != mCaptureFrequency)
+		{
+			return;
+		}
+
+		if (InvalidIndex == source->mCaptureFrame)
+		{
+			// - place the stream on the capture timeline where it started
+			source->mCaptureFrame = (IndexT)(mCaptureTimer.GetTime() * frequency);
+		}
+
+		SizeT samples = bytes / sizeof(short);
+		SizeT first = source->mCaptureFrame * channels;
+		source->mCaptureFrame += samples / channels;
+		if (first >= mCaptureMaxSamples)
+		{
+			return;
+		}
+		if (first + samples > mCaptureMaxSamples)
+		{
+			samples = mCaptureMaxSamples - first;
+		}
+		if (mCaptureMix.Size() < first + samples)
+		{
+			mCaptureMix.Resize(first + samples, 0.0f);
+		}
+		SoundMixer::MixPcm16(&mCaptureMix[first], (const short*)data, samples, gain);
+	}
+}
+
+#endif // __SOUND_COMMIT__
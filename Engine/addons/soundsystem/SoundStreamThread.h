@@ -0,0 +1,130 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __SOUNDSTREAMTHREAD_H__
+#define __SOUNDSTREAMTHREAD_H__
+
+#ifndef __SOUND_COMMIT__
+
+#include "threading/thread.h"
+#include "threading/event.h"
+#include "io/stream.h"
+#include "timing/timer.h"
+
+namespace Sound
+{
+	class SoundSystemSourceOpenAL;
+
+	// decodes and requeues the buffers of streamed sources off the game thread.
+	// the game thread talks to it through a single producer / single consumer command ring.
+	class SoundStreamThread : public Threading::Thread
+	{
+		__DeclareClass(SoundStreamThread);
+	public:
+		SoundStreamThread();
+		virtual ~SoundStreamThread();
+
+		/// start decoding a source, the initial buffers are filled on the stream thread
+		void AddStream(SoundSystemSourceOpenAL* source);
+		/// stop decoding a source, returns once the stream thread no longer touches it
+		void RemoveStream(SoundSystemSourceOpenAL* source);
+
+		/// set how many streams may decode at once, the least audible ones beyond this are virtualized
+		void SetMaxRealStreams(SizeT count);
+		/// get how many streams may decode at once
+		SizeT GetMaxRealStreams() const;
+
+		/// start mixing every decoded stream block into a capture buffer, up to maxSeconds long
+		void BeginCapture(float maxSeconds);
+		/// stop capturing and write the mix as a wave file
+		bool EndCapture(const GPtr<IO::Stream>& stream);
+
+		/// called if thread needs a wakeup call before stopping
+		virtual void EmitWakeupSignal();
+
+	protected:
+		/// this method runs in the thread context
+		virtual void DoWork();
+
+	private:
+		enum CommandCode
+		{
+			AddCmd,
+			RemoveCmd,
+			BeginCaptureCmd,
+			EndCaptureCmd,
+		};
+		struct Command
+		{
+			CommandCode code;
+			SoundSystemSourceOpenAL* source;
+			float param;
+		};
+
+		/// push a command, only called from the game thread
+		void PushCommand(CommandCode code, SoundSystemSourceOpenAL* source, float param);
+		/// pop a command, only called from the stream thread
+		bool PopCommand(Command& cmd);
+		/// run all queued commands
+		void ProcessCommands();
+		/// pick the streams that may decode this tick and refill them
+		void UpdateStreams();
+		/// mix a freshly decoded block into the capture buffer
+		void CaptureBlock(SoundSystemSourceOpenAL* source, const void* data, SizeT bytes, float gain);
+
+		static const int QueueSize = 256;			// must be a power of two
+		static const int StreamIntervalMs = 10;		// stream buffers hold 250ms, so this is plenty
+
+		Command mCommands[QueueSize];
+		int volatile mWriteIndex;
+		int volatile mReadIndex;
+		Threading::Event mWakeup;
+		Threading::Event mAck;
+
+		// - only touched on the stream thread
+		Util::Array<SoundSystemSourceOpenAL*> mStreams;
+		Util::Array<SoundSystemSourceOpenAL*> mSorted;
+		SizeT mMaxRealStreams;
+
+		// - capture, only touched on the stream thread between BeginCapture and EndCapture
+		Util::Array<float> mCaptureMix;
+		SizeT mCaptureMaxSamples;
+		float mCaptureSeconds;
+		Timing::Timer mCaptureTimer;
+		int mCaptureChannels;
+		int mCaptureFrequency;
+		bool mCapturing;
+		GPtr<IO::Stream> mCaptureStream;
+		bool mCaptureResult;
+
+		friend class SoundSystemSourceOpenAL;
+	};
+	//------------------------------------------------------------------------------
+	inline SizeT SoundStreamThread::GetMaxRealStreams() const
+	{
+		return mMaxRealStreams;
+	}
+}
+
+#endif // __SOUND_COMMIT__
+#endif // __SOUNDSTREAMTHREAD_H__
@@ -60,8 +60,13 @@ namespace Sound
 		if (!ret)
 		{
 			ALFWShutdown();
+			return ret;
 		}
 
+		// streamed sources decode and requeue their buffers on their own thread
+		mStreamThread = SoundStreamThread::Create();
+		mStreamThread->Start();
+
 		return ret;
 	}
 	//------------------------------------------------------------------------------
@@ -84,6 +89,13 @@ namespace Sound
 
 		mSoundBufferContainer.Clear();
 
+		// sources leave the stream thread when they are released, so it's idle now
+		if (mStreamThread.isvalid())
+		{
+			mStreamThread->Stop();
+			mStreamThread = NULL;
+		}
+
 		ALFWShutdownOpenAL();
 		ALFWShutdown();
 #ifndef __OSX__
@@ -311,58 +323,7 @@ namespace Sound
 		GPtr< SoundSystemSourceOpenAL > tempSoundSource = SoundSystemSourceOpenAL::Create();
 		
 		GENESISOUND_MODE mode = soundBuffer->GetBufferMode();
-		GENESIS_FILE_FORMAT fileFormat = soundBuffer->GetFileFormat();
-		if (mode & GENESISSOUND_CREATESTREAM)
-		{
-			if ( fileFormat & GENESIS_FILE_FORMAT_MP3 )
-			{
-				size_t ulBytesWritten = NULL;
-				int iMpg123_ret = NULL;
-				mpg123_handle *mpg123 = soundBuffer->GetMpg123Handle();
-				unsigned char *pDecodeBuffer = soundBuffer->GetDecodeBuffer();
-				unsigned long ulBufferSize = soundBuffer->GetDecodeBufferSize();
-				ALuint * queueBuffers = soundBuffer->GetQueueBuffers();
-				ALuint ulFormat = soundBuffer->GetBufferFormat();
-				unsigned long ulFrequency = soundBuffer->GetBufferFrequency();
-				for(int iLoop = 0; iLoop < NUM_BUFFERS; iLoop++)
-				{
-					iMpg123_ret = mpg123_read(mpg123, pDecodeBuffer, ulBufferSize,&ulBytesWritten);
-					if (iMpg123_ret == MPG123_OK)
-					{
-						alBufferData(queueBuffers[iLoop], ulFormat, pDecodeBuffer, ulBytesWritten, ulFrequency);
-						alSourceQueueBuffers(uiSource, 1, &queueBuffers[iLoop]);
-					}
-					else
-					{
-						tempSoundSource->SetDecode(false);
-						break;
-					}
-				}
-			}
-			else if ( fileFormat & GENESIS_FILE_FORMAT_OGG )
-			{
-				size_t ulBytesWritten = NULL;
-				OggVorbis_File *oggHandle = soundBuffer->GetOggHandle();
-				unsigned char *pDecodeBuffer = soundBuffer->GetDecodeBuffer();
-				unsigned long ulBufferSize = soundBuffer->GetDecodeBufferSize();
-				ALuint * queueBuffers = soundBuffer->GetQueueBuffers();
-				ALuint ulFormat = soundBuffer->GetBufferFormat();
-				unsigned long ulFrequency = soundBuffer->GetBufferFrequency();
-				unsigned long ulChannels = soundBuffer->GetBufferChannelCount();
-				// Fill all the Buffers with decoded audio data from the OggVorbis file
-				for (int iLoop = 0; iLoop < NUM_BUFFERS; iLoop++)
-				{
-					ulBytesWritten = tempSoundSource->DecodeOggVorbis(oggHandle, (char*)pDecodeBuffer, ulBufferSize, ulChannels);
-					if (ulBytesWritten)
-					{
-						alBufferData(queueBuffers[iLoop], ulFormat, pDecodeBuffer, ulBytesWritten, ulFrequency);
-						alSourceQueueBuffers(uiSource, 1, &queueBuffers[iLoop]);
-					}
-				}
-			}
-
-		}
-		else
+		if ( !(mode & GENESISSOUND_CREATESTREAM) )
 		{
 			// Attach Source to Buffer
 			void *vpBuffer = soundBuffer->GetBuffer();
@@ -378,6 +339,19 @@ namespace Sound
 
 		tempSoundSource->SetPaused(paused);
 
+		if (mode & GENESISSOUND_CREATESTREAM)
+		{
+			// the queue buffers are filled on the stream thread, it starts playing once they are there
+			if (mStreamThread.isvalid())
+			{
+				mStreamThread->AddStream(tempSoundSource.get());
+			}
+			else
+			{
+				tempSoundSource->StreamPrefill();
+			}
+		}
+
 		return true;
 	}
 	//------------------------------------------------------------------------------
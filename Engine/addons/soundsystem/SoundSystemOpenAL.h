@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "SoundSystem.h"
 #include "SoundBuffer.h"
 #include "CWaves.h"
+#include "SoundStreamThread.h"
 #include "mpg123/mpg123.h"
 #include "Vorbisfile/vorbisfile.h"
 
@@ -66,7 +67,17 @@ namespace Sound
 									const Math::vector& up);
 
 		void SetBufferInfo(SoundBuffer::BufferInfo &bf);
+
+		/// get the thread streamed sources are decoded on
+		SoundStreamThread* GetStreamThread() const;
+	private:
+		GPtr<SoundStreamThread> mStreamThread;
 	};
+	//------------------------------------------------------------------------------
+	inline SoundStreamThread* SoundSystemOpenAL::GetStreamThread() const
+	{
+		return mStreamThread.get_unsafe();
+	}
 }
 
 // For Mp3
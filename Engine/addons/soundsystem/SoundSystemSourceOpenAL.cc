@@ -27,6 +27,8 @@ THE SOFTWARE.
 #include "SoundSystem.h"
 #include "SoundSystemOpenAL.h"
 #include "soundsystem/Framework.h"
+#include "SoundStreamThread.h"
+#include "threading/interlocked.h"
 
 namespace Sound
 {
@@ -39,6 +41,13 @@ namespace Sound
 		, mStopByPlayOver(false)
 		, mIsLoop(false)
 		, m_bDecode(true)
+		, mVolume(1.0f)
+		, mStreamThread(NULL)
+		, mUserPaused(false)
+		, mStreamStart(StreamEmpty)
+		, mVirtual(false)
+		, mAudibility(1.0f)
+		, mCaptureFrame(InvalidIndex)
 	{}
 	//------------------------------------------------------------------------
 	SoundSystemSourceOpenAL::~SoundSystemSourceOpenAL() {}
@@ -52,6 +61,11 @@ namespace Sound
 	//------------------------------------------------------------------------------
 	bool SoundSystemSourceOpenAL::InternalReleaseSource()
 	{
+		if (mStreamThread)
+		{
+			mStreamThread->RemoveStream(this);
+		}
+
 		alSource3i(mSource, AL_AUXILIARY_SEND_FILTER, AL_EFFECTSLOT_NULL, 0, AL_FILTER_NULL);
 		alSourceStop(mSource);
 		alSourcei(mSource, AL_BUFFER, 0);
@@ -70,19 +84,32 @@ namespace Sound
 	//------------------------------------------------------------------------------
 	bool SoundSystemSourceOpenAL::SetPaused(bool paused)
 	{
+		mUserPaused = paused;
+		GENESISOUND_MODE mode = mSoundBuffer->GetBufferMode();
+		bool bStream = (0 != (mode & GENESISSOUND_CREATESTREAM));
 		if (paused)
 		{
+			if (bStream && StreamQueued == Threading::Interlocked::Exchange(&mStreamStart, StreamEmpty))
+			{
+				// - only a start the stream thread has not served yet is withdrawn
+				Threading::Interlocked::Exchange(&mStreamStart, StreamQueued);
+			}
 			alSourcePause(mSource);
 		} 
 		else
 		{
-			alSourcePlay(mSource);
-
-			GENESISOUND_MODE mode = mSoundBuffer->GetBufferMode();
-			if (mode & GENESISSOUND_CREATESTREAM)
+			if (bStream)
 			{
 				mStopByPlayOver = false;
+				// - playing an empty queue stops the source at once, StreamPrefill starts it instead.
+				//   the stream thread writes mStreamStart once, so a queued state can simply be put back
+				if (StreamQueued != Threading::Interlocked::Exchange(&mStreamStart, StreamPlayRequested))
+				{
+					return true;
+				}
+				Threading::Interlocked::Exchange(&mStreamStart, StreamQueued);
 			}
+			alSourcePlay(mSource);
 		}
 
 		return true;
@@ -90,6 +117,12 @@ namespace Sound
 	//------------------------------------------------------------------------------
 	bool SoundSystemSourceOpenAL::GetPaused(bool *paused)
 	{
+		if (mVirtual)
+		{
+			*paused = mUserPaused;
+			return true;
+		}
+
 		ALint iState;
 
 		alGetSourcei( mSource, AL_SOURCE_STATE, &iState);
@@ -108,6 +141,12 @@ namespace Sound
 	//------------------------------------------------------------------------------
 	bool SoundSystemSourceOpenAL::IsPlaying(bool *isPlaying)
 	{
+		if (mVirtual)
+		{
+			*isPlaying = !mUserPaused;
+			return true;
+		}
+
 		ALint iState;
 
 		alGetSourcei( mSource, AL_SOURCE_STATE, &iState);
@@ -127,12 +166,19 @@ namespace Sound
 	bool SoundSystemSourceOpenAL::SetVolume(float volume)
 	{
 		alSourcef(mSource, AL_GAIN, volume);
+		mVolume = volume;
 
 		return true;
 	}
 	//------------------------------------------------------------------------------
 	bool SoundSystemSourceOpenAL::Stop()
 	{
+		// - the decoder is rewound below, the stream thread must be done with it
+		if (mStreamThread)
+		{
+			mStreamThread->RemoveStream(this);
+		}
+
 		alSourceStop(mSource);
 
 		GENESIS_FILE_FORMAT fileFormat = mSoundBuffer->GetFileFormat();
@@ -357,18 +403,139 @@ namespace Sound
 	//------------------------------------------------------------------------------
 	void SoundSystemSourceOpenAL::Decode(GENESIS_FILE_FORMAT fileFormat)
 	{
-		if (mStopByPlayOver || !m_bDecode)
+		// - streams owned by the stream thread are refilled there
+		if (mStreamThread || !WantsStreamUpdate())
 		{
 			return;
 		}
+		StreamRefill();
+	}
+	//------------------------------------------------------------------------------
+	void SoundSystemSourceOpenAL::QueueDecoded(ALuint buffer, const unsigned char* data, size_t bytes, bool bCapture)
+	{
+		alBufferData(buffer, mSoundBuffer->GetBufferFormat(), data, (ALsizei)bytes, mSoundBuffer->GetBufferFrequency());
+		alSourceQueueBuffers(mSource, 1, &buffer);
+
+		if (bCapture && mStreamThread)
+		{
+			mStreamThread->CaptureBlock(this, data, bytes, mVolume);
+		}
+	}
+	//------------------------------------------------------------------------------
+	void SoundSystemSourceOpenAL::StreamPrefill()
+	{
+		GENESIS_FILE_FORMAT fileFormat = mSoundBuffer->GetFileFormat();
+		size_t ulBytesWritten = NULL;
+		unsigned char *pDecodeBuffer = mSoundBuffer->GetDecodeBuffer();
+		unsigned long ulBufferSize = mSoundBuffer->GetDecodeBufferSize();
+		ALuint * queueBuffers = mSoundBuffer->GetQueueBuffers();
+
+		if ( fileFormat & GENESIS_FILE_FORMAT_MP3 )
+		{
+			mpg123_handle *mpg123 = mSoundBuffer->GetMpg123Handle();
+			for(int iLoop = 0; iLoop < NUM_BUFFERS; iLoop++)
+			{
+				int iMpg123_ret = mpg123_read(mpg123, pDecodeBuffer, ulBufferSize,&ulBytesWritten);
+				if (iMpg123_ret == MPG123_OK)
+				{
+					QueueDecoded(queueBuffers[iLoop], pDecodeBuffer, ulBytesWritten);
+				}
+				else
+				{
+					SetDecode(false);
+					break;
+				}
+			}
+		}
+		else if ( fileFormat & GENESIS_FILE_FORMAT_OGG )
+		{
+			OggVorbis_File *oggHandle = mSoundBuffer->GetOggHandle();
+			unsigned long ulChannels = mSoundBuffer->GetBufferChannelCount();
+			// Fill all the Buffers with decoded audio data from the OggVorbis file
+			for (int iLoop = 0; iLoop < NUM_BUFFERS; iLoop++)
+			{
+				ulBytesWritten = DecodeOggVorbis(oggHandle, (char*)pDecodeBuffer, ulBufferSize, ulChannels);
+				if (ulBytesWritten)
+				{
+					QueueDecoded(queueBuffers[iLoop], pDecodeBuffer, ulBytesWritten);
+				}
+			}
+		}
 
+		// - SetPaused(false) ran before the buffers were there
+		if (StreamPlayRequested == Threading::Interlocked::Exchange(&mStreamStart, StreamQueued))
+		{
+			alSourcePlay(mSource);
+		}
+	}
+	//------------------------------------------------------------------------------
+	void SoundSystemSourceOpenAL::UpdateStreamAudibility()
+	{
+		float audibility = mVolume;
+		if (audibility > 0.0f && mIs3D)
+		{
+			ALfloat sourcePos[3];
+			ALfloat listenerPos[3];
+			ALfloat refDistance = 1.0f;
+			ALfloat maxDistance = 0.0f;
+			alGetSourcefv(mSource, AL_POSITION, sourcePos);
+			alGetListenerfv(AL_POSITION, listenerPos);
+			alGetSourcef(mSource, AL_REFERENCE_DISTANCE, &refDistance);
+			alGetSourcef(mSource, AL_MAX_DISTANCE, &maxDistance);
+
+			float dx = sourcePos[0] - listenerPos[0];
+			float dy = sourcePos[1] - listenerPos[1];
+			float dz = sourcePos[2] - listenerPos[2];
+			float distance = Math::n_sqrt(dx * dx + dy * dy + dz * dz);
+
+			if (AL_LINEAR_DISTANCE_CLAMPED == alGetInteger(AL_DISTANCE_MODEL) && distance >= maxDistance)
+			{
+				// - linear rolloff is silent from the max distance on
+				audibility = 0.0f;
+			}
+			else if (distance > refDistance && refDistance > 0.0f)
+			{
+				// - rough inverse rolloff, only used to rank the streams
+				audibility *= refDistance / distance;
+			}
+		}
+		mAudibility = audibility;
+	}
+	//------------------------------------------------------------------------------
+	void SoundSystemSourceOpenAL::SetStreamVirtual(bool bVirtual)
+	{
+		ALint iState = 0;
+		alGetSourcei(mSource, AL_SOURCE_STATE, &iState);
+		if (bVirtual)
+		{
+			// - stop consuming buffers, the stream picks up where it was when it becomes audible
+			if (AL_PLAYING == iState)
+			{
+				alSourcePause(mSource);
+			}
+			mVirtual = true;
+		}
+		else if (mVirtual)
+		{
+			mVirtual = false;
+			if (AL_PLAYING != iState)
+			{
+				alSourcePlay(mSource);
+			}
+		}
+	}
+	//------------------------------------------------------------------------------
+	void SoundSystemSourceOpenAL::StreamRefill()
+	{
 		bool bPaused = false;
 		GetPaused(&bPaused);
-		if ( bPaused)
+		// - a stream created paused never left AL_INITIAL, don't start it below
+		if ( bPaused || mUserPaused)
 		{
 			return;
 		}
 
+		GENESIS_FILE_FORMAT fileFormat = mSoundBuffer->GetFileFormat();
 		int iBuffersProcessed = NULL;
 		ALuint uiBuffer = NULL;
 		int iState = NULL;
@@ -381,8 +548,6 @@ namespace Sound
 		OggVorbis_File* oggHandle = mSoundBuffer->GetOggHandle();
 		unsigned char *pDecodeBuffer = mSoundBuffer->GetDecodeBuffer();
 		unsigned long ulBufferSize = mSoundBuffer->GetDecodeBufferSize();
-		ALuint ulFormat = mSoundBuffer->GetBufferFormat();
-		unsigned long ulFrequency = mSoundBuffer->GetBufferFrequency();
 		unsigned long ulChannels = mSoundBuffer->GetBufferChannelCount();
 		
 		while(iBuffersProcessed)
@@ -404,8 +569,7 @@ namespace Sound
 
 			if(ulBytesWritten)
 			{
-				alBufferData(uiBuffer, ulFormat, pDecodeBuffer, ulBytesWritten, ulFrequency);
-				alSourceQueueBuffers(mSource, 1, &uiBuffer);
+				QueueDecoded(uiBuffer, pDecodeBuffer, ulBytesWritten);
 			}
 			else if( GetLoop() )
 			{
@@ -416,8 +580,7 @@ namespace Sound
 					mpg123_read(mpg123, pDecodeBuffer, ulBufferSize, &ulBytesWritten);
 					if(ulBytesWritten)
 					{
-						alBufferData(uiBuffer, ulFormat, pDecodeBuffer, ulBytesWritten, ulFrequency);
-						alSourceQueueBuffers(mSource, 1, &uiBuffer);
+						QueueDecoded(uiBuffer, pDecodeBuffer, ulBytesWritten);
 					}
 				}
 				else if(fileFormat & GENESIS_FILE_FORMAT_OGG )
@@ -427,8 +590,7 @@ namespace Sound
 					ulBytesWritten = DecodeOggVorbis( oggHandle, (char*)pDecodeBuffer, ulBufferSize, ulChannels);
 					if(ulBytesWritten)
 					{
-						alBufferData(uiBuffer, ulFormat, pDecodeBuffer, ulBytesWritten, ulFrequency);
-						alSourceQueueBuffers(mSource, 1, &uiBuffer);
+						QueueDecoded(uiBuffer, pDecodeBuffer, ulBytesWritten);
 					}
 				}
 			}
@@ -446,31 +608,28 @@ namespace Sound
 			}
 			else
 			{
+				ALuint * queueBuffers = mSoundBuffer->GetQueueBuffers();
 				if ( fileFormat & GENESIS_FILE_FORMAT_MP3 )
 				{
 					// mp3
 					mpg123_seek(mpg123, 0, 0);
-					ALuint * queueBuffers = mSoundBuffer->GetQueueBuffers();
 					for(int iLoop = 0; iLoop < NUM_BUFFERS; iLoop++)
 					{
 						mpg123_read(mpg123, pDecodeBuffer, ulBufferSize,&ulBytesWritten);
-						alBufferData(queueBuffers[iLoop], ulFormat, pDecodeBuffer, ulBytesWritten, ulFrequency);
-						alSourceQueueBuffers(mSource, 1, &queueBuffers[iLoop]);
+						QueueDecoded(queueBuffers[iLoop], pDecodeBuffer, ulBytesWritten, false);
 					}
 				}
 				else if( fileFormat & GENESIS_FILE_FORMAT_OGG )
 				{
 					// ogg
 					ov_raw_seek(oggHandle, 0);
-					ALuint * queueBuffers = mSoundBuffer->GetQueueBuffers();
 					// Fill all the Buffers with decoded audio data from the OggVorbis file
 					for (int iLoop = 0; iLoop < NUM_BUFFERS; iLoop++)
 					{
 						ulBytesWritten = DecodeOggVorbis(oggHandle, (char*)pDecodeBuffer, ulBufferSize, ulChannels);
 						if (ulBytesWritten)
 						{
-							alBufferData(queueBuffers[iLoop], ulFormat, pDecodeBuffer, ulBytesWritten, ulFrequency);
-							alSourceQueueBuffers(mSource, 1, &queueBuffers[iLoop]);
+							QueueDecoded(queueBuffers[iLoop], pDecodeBuffer, ulBytesWritten, false);
 						}
 					}
 				}
@@ -30,6 +30,8 @@ THE SOFTWARE.
 
 namespace Sound
 {
+	class SoundStreamThread;
+
 	class SoundSystemSourceOpenAL :  public Sound::SoundSystemSource
 	{
 		__DeclareSubClass(SoundSystemSourceOpenAL, Sound::SoundSystemSource);
@@ -86,20 +88,63 @@ namespace Sound
 
 		void SetDecode(bool bDecode);
 
+		// - called on the stream thread
+		/// fill all queue buffers and start playing unless paused
+		void StreamPrefill();
+		/// requeue the buffers OpenAL has finished with
+		void StreamRefill();
+		/// if this stream still needs decoding
+		bool WantsStreamUpdate() const;
+		/// estimate how loud this stream is at the listener
+		void UpdateStreamAudibility();
+		/// get the estimate of UpdateStreamAudibility
+		float GetStreamAudibility() const;
+		/// pause an inaudible stream without the user noticing, or resume it
+		void SetStreamVirtual(bool bVirtual);
+
 	private:
+		/// hand a decoded block to OpenAL, bCapture is false for blocks queued ahead for the next play
+		void QueueDecoded(ALuint buffer, const unsigned char* data, size_t bytes, bool bCapture = true);
+
 		SoundBuffer*  mSoundBuffer;
 		bool		  mIs3D;
 		bool          mStopByPlayOver;
 		bool		  mIsLoop;
 		ALuint        mSource;
 		bool          m_bDecode;
-
+		float         mVolume;
+
+		SoundStreamThread* mStreamThread;	///< - set while the stream thread decodes this source
+		bool volatile mUserPaused;			///< - paused through SetPaused, virtual pauses don't count
+		/// - a stream may only start once StreamPrefill queued its first buffers, whoever comes last starts it
+		enum StreamStart
+		{
+			StreamEmpty = 0,
+			StreamPlayRequested,
+			StreamQueued
+		};
+		int volatile  mStreamStart;
+		bool          mVirtual;				///< - paused by the stream thread because it can't be heard
+		float         mAudibility;
+		IndexT        mCaptureFrame;		///< - position on the stream thread's capture timeline
+
+		friend class SoundStreamThread;
 	};
 
 	inline void SoundSystemSourceOpenAL::SetDecode(bool bDecode)
 	{
 		m_bDecode = bDecode;
 	}
+
+	inline bool SoundSystemSourceOpenAL::WantsStreamUpdate() const
+	{
+		return m_bDecode && !mStopByPlayOver && !mUserPaused;
+	}
+
+	inline float SoundSystemSourceOpenAL::GetStreamAudibility() const
+	{
+		return mAudibility;
+	}
 }
 
 #endif//__SOUNDSYSTEMSOURCEOPENAL_H__
\ No newline at end of file
@@ -210,6 +210,9 @@ namespace Sprite
 		RenderBase::PrimitiveHandle handle = Graphic::GraphicSystem::Instance()->CreatePrimitiveHandle(&vbd2, &ibd2);
 
 		sv.Setup(handle, vertex_count, index_count);
+		// the vertex unit keeps the quad as Graphic::SpriteVertex for the sprite batcher
+		n_static_assert(sizeof(_sprite_vertex) == sizeof(Graphic::SpriteVertex));
+		sv.SetQuad(reinterpret_cast<const Graphic::SpriteVertex*>(vertices), false);
 
 		return box;
 	}
@@ -221,15 +224,12 @@ namespace Sprite
 			buildVertexTemplate();
 		}
 
-		Graphic::DynamicBuffer dvb;
-		dvb.SetSize(RECT_VERTEX_COUNT * sizeof(_sprite_vertex));
-
-		_sprite_vertex* vertices = dvb.GetBufferPtr<_sprite_vertex>();//_SimpleVertex vertices[RECT_VERTEX_COUNT];
+		_sprite_vertex vertices[RECT_VERTEX_COUNT];
 
 		bbox box = setVertexByTemplate(vertices, image, block);
 
-		RenderBase::PrimitiveHandle handle = sv.GetHandle();
-		Graphic::GraphicSystem::Instance()->UpdatePrimitiveHandle(handle, &dvb, NULL);
+		// the upload waits for SpriteVertexUnit::Commit, batched sprites never need it
+		sv.SetQuad(reinterpret_cast<const Graphic::SpriteVertex*>(vertices), true);
 
 		return box;
 	}
@@ -70,6 +70,11 @@ namespace Sprite
 
 		const RenderBase::PrimitiveHandle& GetPrimitiveHandle() const;
 
+		/// upload the vertices changed since the last draw, call before drawing the primitive
+		void CommitVertex();
+
+		const Graphic::SpriteVertex* GetQuad() const;
+
 		const GPtr<Resources::SpritePackageResInfo>& GetPackageResInfo() const;
 
 		GPtr<Resources::MaterialResInfo> GetMaterial() const;
@@ -107,6 +112,16 @@ namespace Sprite
 		return mVertexUnit.GetHandle();
 	}
 
+	inline void SpriteInfo::CommitVertex()
+	{
+		mVertexUnit.Commit();
+	}
+
+	inline const Graphic::SpriteVertex* SpriteInfo::GetQuad() const
+	{
+		return mVertexUnit.GetQuad();
+	}
+
 	inline bool SpriteInfo::IsValid() const
 	{
 		return mPackageResInfo.isvalid();
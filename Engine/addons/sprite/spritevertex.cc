@@ -31,7 +31,9 @@ namespace Sprite
 	SpriteVertexUnit::SpriteVertexUnit()
 		:mVertexCount(0)
 		,mIndexCount(0)
+		,mDirty(false)
 	{
+		Memory::Clear(mQuad, sizeof(mQuad));
 
 	}
 
@@ -50,6 +52,22 @@ namespace Sprite
 		mHandle = handle;
 		mVertexCount = vertexCount;
 		mIndexCount = indexCount;
+		mDirty = false;
+	}
+
+	void SpriteVertexUnit::SetQuad(const Graphic::SpriteVertex* vertices, bool dirty)
+	{
+		Memory::Copy(vertices, mQuad, sizeof(mQuad));
+		mDirty = mDirty || dirty;
+	}
+
+	void SpriteVertexUnit::Commit()
+	{
+		if (mDirty && mHandle.IsValid())
+		{
+			Graphic::GraphicSystem::Instance()->UpdatePrimitiveVertices(mHandle, mQuad, sizeof(mQuad), 0);
+		}
+		mDirty = false;
 	}
 
 	void SpriteVertexUnit::Destroy()
@@ -59,5 +77,6 @@ namespace Sprite
 			Graphic::GraphicSystem::Instance()->RemovePrimitive(mHandle);
 			mHandle = RenderBase::PrimitiveHandle();
 		}
+		mDirty = false;
 	}
 }
\ No newline at end of file
@@ -24,6 +24,7 @@ THE SOFTWARE.
 #ifndef __SPRITE_VERTEX_H__
 #define __SPRITE_VERTEX_H__
 #include "rendersystem/base/RenderDeviceTypes.h"
+#include "graphicsystem/Renderable/SpriteBatcher.h"
 
 namespace Sprite
 {
@@ -37,10 +38,19 @@ namespace Sprite
 
 		const RenderBase::PrimitiveHandle& GetHandle() const;
 
+		/// keep a copy of the quad, dirty marks it for upload on the next Commit
+		void SetQuad(const Graphic::SpriteVertex* vertices, bool dirty);
+		/// the object space quad, read by the sprite batcher
+		const Graphic::SpriteVertex* GetQuad() const;
+		/// upload the quad if it changed, only sprites drawn one by one need it
+		void Commit();
+
 	private:
 		RenderBase::PrimitiveHandle mHandle;
 		SizeT mVertexCount;
 		SizeT mIndexCount;
+		Graphic::SpriteVertex mQuad[4];
+		bool mDirty;
 
 	};
 
@@ -48,6 +58,11 @@ namespace Sprite
 	{
 		return mHandle;
 	}
+
+	inline const Graphic::SpriteVertex* SpriteVertexUnit::GetQuad() const
+	{
+		return mQuad;
+	}
 }
 
 #endif //__SPRITE_VERTEX_H__
\ No newline at end of file
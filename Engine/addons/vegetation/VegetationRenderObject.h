@@ -41,6 +41,8 @@ namespace Vegetation
 		virtual ~VegetationRenderObject();
 		virtual void AddToCollection(Graphic::RenderDataCollection* colection);
 		virtual void Render(const Graphic::Renderable* renderable, Graphic::RenderPassType passType, const Graphic::Material* customizedMaterial);
+		/// instances and render units change without the object moving, never cache its shadow
+		virtual bool IsDeforming() const;
 		void SetOwner(Owner* owner, Graphic::LayerID layerID);
 		Owner* GetOwner() const;
 	protected:	
@@ -51,6 +53,11 @@ namespace Vegetation
 		Owner* mOwner;
 	};
 
+	inline bool VegetationRenderObject::IsDeforming() const
+	{
+		return true;
+	}
+
 	inline void VegetationRenderObject::SetOwner(Owner* owner, Graphic::LayerID layerID)
 	{
 		mOwner = owner;
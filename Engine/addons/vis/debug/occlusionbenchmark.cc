@@ -0,0 +1,148 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "stdneb.h"
+#include "vis/debug/occlusionbenchmark.h"
+#include "vis/occlusionbuffer.h"
+#include "timing/timer.h"
+
+namespace Debug
+{
+using namespace Util;
+using namespace Math;
+using namespace Vis;
+
+//------------------------------------------------------------------------------
+/**
+    Rasterizes the occluders num times, the last result stays in the buffer.
+*/
+static void
+RunRaster(Array<OcclusionBenchmark::Result>& results, const char* name, OcclusionBuffer* buffer, 
+          const Array<GPtr<Occluder> >& occluders, const matrix44& viewProj, SizeT num, bool expected)
+{
+    Timing::Timer timer;
+    timer.Start();
+    IndexT i;
+    for (i = 0; i < num; i++)
+    {
+        buffer->Rasterize(occluders, viewProj);
+    }
+    timer.Stop();
+
+    OcclusionBenchmark::Result& result = results.EmplaceBack();
+    result.name = name;
+    result.iterations = num;
+    result.time = timer.GetTime();
+    result.occluded = buffer->HasOccluders();
+    result.expected = expected;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Tests the box against the buffer num times.
+*/
+static void
+RunQuery(Array<OcclusionBenchmark::Result>& results, const char* name, const OcclusionBuffer* buffer, 
+         const bbox& box, SizeT num, bool expected)
+{
+    bool occluded = false;
+    Timing::Timer timer;
+    timer.Start();
+    IndexT i;
+    for (i = 0; i < num; i++)
+    {
+        occluded = buffer->IsOccluded(box);
+    }
+    timer.Stop();
+
+    OcclusionBenchmark::Result& result = results.EmplaceBack();
+    result.name = name;
+    result.iterations = num;
+    result.time = timer.GetTime();
+    result.occluded = occluded;
+    result.expected = expected;
+}
+
+//------------------------------------------------------------------------------
+/**
+    The camera sits at z = 10 and looks down -z at a 6x6 wall in the 
+    origin, with a near plane of 0.1.
+*/
+Array<OcclusionBenchmark::Result>
+OcclusionBenchmark::Run(SizeT scale)
+{
+    n_assert(scale > 0);
+    Array<Result> results;
+    const SizeT numRaster = 256 * scale;
+    const SizeT numQuery = 65536 * scale;
+
+    const matrix44 view = matrix44::lookatrh(float4(0.0f, 0.0f, 10.0f, 1.0f), float4(0.0f, 0.0f, 0.0f, 1.0f), float4(0.0f, 1.0f, 0.0f, 0.0f));
+    const matrix44 proj = matrix44::perspfovrh(1.0f, 2.0f, 0.1f, 100.0f);
+    const matrix44 viewProj = matrix44::multiply(proj, view);
+
+    Array<GPtr<Occluder> > occluders;
+    GPtr<Occluder> wall = Occluder::Create();
+    wall->SetupBox(bbox(point(0.0f, 0.0f, 0.0f), vector(3.0f, 3.0f, 0.1f)));
+    occluders.Append(wall);
+
+    const bbox behind(point(0.0f, 0.0f, -5.0f), vector(0.5f, 0.5f, 0.5f));
+    const bbox beside(point(8.0f, 0.0f, -5.0f), vector(0.5f, 0.5f, 0.5f));
+    const bbox inFront(point(0.0f, 0.0f, 3.0f), vector(0.5f, 0.5f, 0.5f));
+    const bbox nearPlane(point(0.0f, 0.0f, 10.0f), vector(0.5f, 0.5f, 0.5f));
+
+    GPtr<OcclusionBuffer> buffer = OcclusionBuffer::Create();
+    buffer->Setup(256, 128);
+
+    RunRaster(results, "Rasterize(wall)", buffer, occluders, viewProj, numRaster, true);
+    RunQuery(results, "IsOccluded(behind)", buffer, behind, numQuery, true);
+    RunQuery(results, "IsOccluded(beside)", buffer, beside, numQuery, false);
+    RunQuery(results, "IsOccluded(in front)", buffer, inFront, numQuery, false);
+    RunQuery(results, "IsOccluded(near plane)", buffer, nearPlane, numQuery, false);
+
+    wall->SetEnabled(false);
+    RunRaster(results, "Rasterize(disabled)", buffer, occluders, viewProj, numRaster, false);
+    RunQuery(results, "IsOccluded(behind, disabled)", buffer, behind, numQuery, false);
+    return results;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+bool
+OcclusionBenchmark::Print(const Array<Result>& results)
+{
+    n_printf("OcclusionBenchmark:\n");
+    bool passed = true;
+    IndexT i;
+    for (i = 0; i < results.Size(); i++)
+    {
+        const Result& result = results[i];
+        const bool ok = (result.occluded == result.expected);
+        n_printf("  %-32s %8d calls %10.3f ms %8.1f ns/call  %s\n", result.name, result.iterations, result.time * 1000.0,
+            result.iterations > 0 ? result.time * 1000000000.0 / result.iterations : 0.0, ok ? "ok" : "WRONG");
+        passed &= ok;
+    }
+    return passed;
+}
+
+} // namespace Debug
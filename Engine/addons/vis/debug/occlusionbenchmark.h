@@ -0,0 +1,65 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __occlusionbenchmark_H__
+#define __occlusionbenchmark_H__
+//------------------------------------------------------------------------------
+/**
+    @class Debug::OcclusionBenchmark
+    
+    Checks and times Vis::OcclusionBuffer on a fixed scene: a wall in front
+    of the camera, and boxes behind it, beside it, in front of it and
+    crossing the near plane, once more with the wall disabled. Every case
+    compares IsOccluded() against the expected answer; only a box fully
+    behind an enabled wall may be culled. Results have the same layout as
+    Debug::ContainerBenchmark plus the check.
+*/
+#include "core/types.h"
+#include "util/array.h"
+#include "timing/time.h"
+
+//------------------------------------------------------------------------------
+namespace Debug
+{
+class OcclusionBenchmark
+{
+public:
+    /// result of a single benchmark case
+    struct Result
+    {
+        const char* name;
+        SizeT iterations;   // Rasterize() or IsOccluded() calls
+        Timing::Time time;
+        bool occluded;      // answer of IsOccluded(), or of HasOccluders() for the raster cases
+        bool expected;
+    };
+
+    /// run all benchmark cases, scale multiplies the iteration counts
+    static Util::Array<Result> Run(SizeT scale = 1);
+    /// write results to the log, returns false if a case gave a wrong answer
+    static bool Print(const Util::Array<Result>& results);
+};
+
+} // namespace Debug
+//------------------------------------------------------------------------------
+#endif // __occlusionbenchmark_H__
@@ -0,0 +1,47 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "stdneb.h"
+#include "jobs/stdjob.h"
+#include "vis/occlusionbuffer.h"
+
+namespace Vis
+{
+
+//------------------------------------------------------------------------------
+/**
+	Rasterize the occluders into some bands of an OcclusionBuffer, one band per slice.
+*/
+void
+OcclusionRasterJobFunc(const JobFuncContext& ctx)
+{
+	const OcclusionBuffer::RasterBand* bands = (const OcclusionBuffer::RasterBand*)ctx.inputs[0];
+	const SizeT count = ctx.inputSizes[0] / sizeof(OcclusionBuffer::RasterBand);
+	for (IndexT i = 0; i < count; ++i)
+	{
+		bands[i].buffer->_RasterizeBand(bands[i].band);
+	}
+}
+
+} // namespace Vis
+__ImplementSpursJob(Vis::OcclusionRasterJobFunc);
@@ -37,6 +37,8 @@ using namespace Math;
 ObserverContext::ObserverContext()
 	: mType(InvalidObserverType)
 	, mUserData(NULL)
+	, mOcclusionBuffer(NULL)
+	, mOcclusionCulling(false)
 {
 }
 
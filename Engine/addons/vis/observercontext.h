@@ -27,6 +27,7 @@ THE SOFTWARE.
 
 #include "core/refcounted.h"
 #include "math/bbox.h"
+#include "vis/occlusionbuffer.h"
 
 //------------------------------------------------------------------------------
 namespace Vis
@@ -80,8 +81,21 @@ namespace Vis
 
 		Math::ClipStatus::Type ComputeClipStatus(const Math::bbox& boundingBox);
 
+		/// ask for occlusion culling, only used with ObserverCullingType = ProjectionMatrix
+		void SetOcclusionCulling(bool enable);
+		bool IsOcclusionCulling() const;
+
+		/// the occluders rasterized for this observer, set by the VisServer while a query runs
+		void SetOcclusionBuffer(const OcclusionBuffer* buffer);
+		const OcclusionBuffer* GetOcclusionBuffer() const;
+
+		/// true if the box is hidden by the occluders
+		bool IsOccluded(const Math::bbox& boundingBox) const;
+
 	protected: 
 		Core::RefCounted* mUserData;
+		const OcclusionBuffer* mOcclusionBuffer;
+		bool mOcclusionCulling;
 		ObserverCullingType mType;    
 		Math::bbox mBoundingBox;    
 		Math::matrix44 mViewProjection;
@@ -153,6 +167,41 @@ namespace Vis
 	{
 		return mUserData;
 	}
+	//------------------------------------------------------------------------
+	inline
+	void 
+	ObserverContext::SetOcclusionCulling(bool enable)
+	{
+		mOcclusionCulling = enable;
+	}
+	//------------------------------------------------------------------------
+	inline
+	bool 
+	ObserverContext::IsOcclusionCulling() const
+	{
+		return mOcclusionCulling;
+	}
+	//------------------------------------------------------------------------
+	inline
+	void 
+	ObserverContext::SetOcclusionBuffer(const OcclusionBuffer* buffer)
+	{
+		mOcclusionBuffer = buffer;
+	}
+	//------------------------------------------------------------------------
+	inline
+	const OcclusionBuffer* 
+	ObserverContext::GetOcclusionBuffer() const
+	{
+		return mOcclusionBuffer;
+	}
+	//------------------------------------------------------------------------
+	inline
+	bool 
+	ObserverContext::IsOccluded(const Math::bbox& boundingBox) const
+	{
+		return ( NULL != mOcclusionBuffer ) && mOcclusionBuffer->IsOccluded(boundingBox);
+	}
 } // namespace Vis
 //------------------------------------------------------------------------------
 
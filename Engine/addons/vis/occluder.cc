@@ -0,0 +1,105 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "stdneb.h"
+#include "vis/occluder.h"
+
+namespace Vis
+{
+__ImplementClass(Vis::Occluder, 'VIOC', Core::RefCounted);
+
+using namespace Math;
+
+//------------------------------------------------------------------------------
+/**
+*/
+Occluder::Occluder()
+	: mTransform(matrix44::identity())
+	, mEnabled(true)
+{
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+Occluder::~Occluder()
+{
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+Occluder::Setup(const Util::Array<float4>& positions, const Util::Array<uint>& indices)
+{
+	n_assert( indices.Size() % 3 == 0 );
+	mPositions = positions;
+	mIndices = indices;
+	for ( IndexT i = 0; i < mPositions.Size(); ++i )
+	{
+		mPositions[i].w() = 1.0f;
+	}
+#if NEBULA3_DEBUG
+	for ( IndexT i = 0; i < mIndices.Size(); ++i )
+	{
+		n_assert( mIndices[i] < (uint)mPositions.Size() );
+	}
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+Occluder::SetupBox(const bbox& box)
+{
+	static const uint boxIndices[36] = 
+	{
+		0, 1, 2,  0, 2, 3,		// -y
+		4, 6, 5,  4, 7, 6,		// +y
+		0, 4, 5,  0, 5, 1,		// -x
+		3, 2, 6,  3, 6, 7,		// +x
+		0, 3, 7,  0, 7, 4,		// -z
+		1, 5, 6,  1, 6, 2		// +z
+	};
+
+	mPositions.Clear();
+	mPositions.Reserve(8);
+	mPositions.Append(float4(box.pmin.x(), box.pmin.y(), box.pmin.z(), 1.0f));
+	mPositions.Append(float4(box.pmin.x(), box.pmin.y(), box.pmax.z(), 1.0f));
+	mPositions.Append(float4(box.pmax.x(), box.pmin.y(), box.pmax.z(), 1.0f));
+	mPositions.Append(float4(box.pmax.x(), box.pmin.y(), box.pmin.z(), 1.0f));
+	mPositions.Append(float4(box.pmin.x(), box.pmax.y(), box.pmin.z(), 1.0f));
+	mPositions.Append(float4(box.pmin.x(), box.pmax.y(), box.pmax.z(), 1.0f));
+	mPositions.Append(float4(box.pmax.x(), box.pmax.y(), box.pmax.z(), 1.0f));
+	mPositions.Append(float4(box.pmax.x(), box.pmax.y(), box.pmin.z(), 1.0f));
+
+	mIndices.Clear();
+	mIndices.Reserve(36);
+	for ( IndexT i = 0; i < 36; ++i )
+	{
+		mIndices.Append(boxIndices[i]);
+	}
+}
+
+} // namespace Vis
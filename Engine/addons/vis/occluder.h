@@ -0,0 +1,123 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __occluder_H__
+#define __occluder_H__
+
+#include "core/refcounted.h"
+#include "math/float4.h"
+#include "math/matrix44.h"
+#include "math/bbox.h"
+
+//------------------------------------------------------------------------------
+namespace Vis
+{
+	/**
+		A mesh that hides what is behind it, rasterized into the OcclusionBuffer of a
+		VisQuery. Occluders are a handful of simple, opaque meshes (walls, buildings,
+		terrain blocks) designated by the application, not the render meshes: the mesh
+		should lie inside the rendered geometry, or objects that are partly visible
+		around its edges get culled.
+	*/
+	class Occluder : public Core::RefCounted
+	{
+		__DeclareClass(Occluder);
+	public:
+		/// constructor
+		Occluder();
+		/// destructor
+		virtual ~Occluder();
+
+		/// setup from a local space triangle list
+		void Setup(const Util::Array<Math::float4>& positions, const Util::Array<uint>& indices);
+		/// setup as a box
+		void SetupBox(const Math::bbox& box);
+
+		/// set local to world transform
+		void SetTransform(const Math::matrix44& m);
+		/// get local to world transform
+		const Math::matrix44& GetTransform() const;
+
+		/// enable or disable, a disabled occluder is not rasterized
+		void SetEnabled(bool enabled);
+		/// is enabled
+		bool IsEnabled() const;
+
+		/// get local space positions, w is 1
+		const Util::Array<Math::float4>& GetPositions() const;
+		/// get triangle list indices
+		const Util::Array<uint>& GetIndices() const;
+
+	protected:
+		Util::Array<Math::float4> mPositions;
+		Util::Array<uint> mIndices;
+		Math::matrix44 mTransform;
+		bool mEnabled;
+	};
+
+	//------------------------------------------------------------------------
+	inline
+	void
+	Occluder::SetTransform(const Math::matrix44& m)
+	{
+		mTransform = m;
+	}
+	//------------------------------------------------------------------------
+	inline
+	const Math::matrix44&
+	Occluder::GetTransform() const
+	{
+		return mTransform;
+	}
+	//------------------------------------------------------------------------
+	inline
+	void
+	Occluder::SetEnabled(bool enabled)
+	{
+		mEnabled = enabled;
+	}
+	//------------------------------------------------------------------------
+	inline
+	bool
+	Occluder::IsEnabled() const
+	{
+		return mEnabled;
+	}
+	//------------------------------------------------------------------------
+	inline
+	const Util::Array<Math::float4>&
+	Occluder::GetPositions() const
+	{
+		return mPositions;
+	}
+	//------------------------------------------------------------------------
+	inline
+	const Util::Array<uint>&
+	Occluder::GetIndices() const
+	{
+		return mIndices;
+	}
+} // namespace Vis
+//------------------------------------------------------------------------------
+
+#endif // __occluder_H__
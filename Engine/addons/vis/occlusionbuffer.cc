@@ -0,0 +1,508 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "stdneb.h"
+#include "vis/occlusionbuffer.h"
+#include "jobs/jobsystem.h"
+#include "jobs/jobport.h"
+#include "jobs/job.h"
+#include <float.h>
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define OCCLUSIONBUFFER_USE_SSE (1)
+#else
+#define OCCLUSIONBUFFER_USE_SSE (0)
+#endif
+#if !OCCLUSIONBUFFER_USE_SSE && (defined(__ARM_NEON__) || defined(__ARM_NEON))
+#include <arm_neon.h>
+#define OCCLUSIONBUFFER_USE_NEON (1)
+#else
+#define OCCLUSIONBUFFER_USE_NEON (0)
+#endif
+
+namespace Vis
+{
+__ImplementClass(Vis::OcclusionBuffer, 'VIOB', Core::RefCounted);
+
+using namespace Math;
+using namespace Jobs;
+
+extern void OcclusionRasterJobFunc(const JobFuncContext& ctx);
+
+SizeT OcclusionBuffer::s_parallelThreshold = 128;
+
+// vertices nearer than this (clip w) are behind the camera for the buffer
+static const float sMinClipW = 1.0e-4f;
+// triangles reaching farther off screen than this many buffer sizes are dropped
+static const float sMaxGuardBand = 16.0f;
+
+//------------------------------------------------------------------------------
+/**
+*/
+OcclusionBuffer::OcclusionBuffer()
+	: mViewProj(matrix44::identity())
+	, mWidth(0)
+	, mHeight(0)
+	, mTilesX(0)
+	, mTilesY(0)
+{
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+OcclusionBuffer::~OcclusionBuffer()
+{
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+OcclusionBuffer::Setup(SizeT width, SizeT height)
+{
+	n_assert( width > 0 && height > 0 );
+	mTilesX = ( width + TileSize - 1 ) / TileSize;
+	mTilesY = ( height + TileSize - 1 ) / TileSize;
+	mWidth = mTilesX * TileSize;
+	mHeight = mTilesY * TileSize;
+
+	mDepth.Clear();
+	mDepth.Resize(mWidth * mHeight, FLT_MAX);
+	mTileDepth.Clear();
+	mTileDepth.Resize(mTilesX * mTilesY, FLT_MAX);
+	mTriangles.Clear();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+OcclusionBuffer::Rasterize(const Util::Array<GPtr<Occluder> >& occluders, const matrix44& viewProj)
+{
+	n_assert( mWidth > 0 && mHeight > 0 );
+	mViewProj = viewProj;
+	mTriangles.Reset();
+
+	for ( IndexT i = 0; i < occluders.Size(); ++i )
+	{
+		const GPtr<Occluder>& occluder = occluders[i];
+		if ( occluder->IsEnabled() )
+		{
+			_SetupTriangles(*occluder);
+		}
+	}
+
+	// nothing drawn: IsOccluded() returns false without looking at the pixels
+	if ( mTriangles.IsEmpty() )
+	{
+		return;
+	}
+
+	if ( !JobSystem::HasInstance() || mTriangles.Size() < s_parallelThreshold )
+	{
+		for ( IndexT band = 0; band < mTilesY; ++band )
+		{
+			_RasterizeBand(band);
+		}
+		return;
+	}
+
+	// one job, one slice per band, the slices spread over the worker threads
+	Util::Array<RasterBand> bands;
+	bands.Reserve(mTilesY);
+	for ( IndexT band = 0; band < mTilesY; ++band )
+	{
+		RasterBand desc;
+		desc.buffer = this;
+		desc.band = band;
+		bands.Append(desc);
+	}
+
+	JobFuncDesc jobFunction(OcclusionRasterJobFunc);
+	JobUniformDesc uniformData(&bands[0], sizeof(RasterBand), 0);
+	JobDataDesc inputData(&bands[0], bands.Size() * sizeof(RasterBand), sizeof(RasterBand));
+	JobDataDesc outputData(&bands[0], bands.Size() * sizeof(RasterBand), sizeof(RasterBand));
+
+	GPtr<Job> job = Job::Create();
+	job->Setup(uniformData, inputData, outputData, jobFunction);
+	GPtr<JobPort> jobPort = JobPort::Create();
+	jobPort->Setup();
+	jobPort->PushJob(job);
+	jobPort->WaitDone();
+	jobPort->Discard();
+}
+
+//------------------------------------------------------------------------------
+/**
+	Triangles with a vertex behind the camera or far outside the screen are dropped
+	instead of clipped: an occluder may only hide less than it could, never more.
+*/
+void
+OcclusionBuffer::_SetupTriangles(const Occluder& occluder)
+{
+	const Util::Array<float4>& positions = occluder.GetPositions();
+	const Util::Array<uint>& indices = occluder.GetIndices();
+	if ( indices.IsEmpty() )
+	{
+		return;
+	}
+
+	const matrix44 localToClip = matrix44::multiply(mViewProj, occluder.GetTransform());
+	mClipPositions.Reset();
+	for ( IndexT i = 0; i < positions.Size(); ++i )
+	{
+		mClipPositions.Append(matrix44::transform(localToClip, positions[i]));
+	}
+
+	const float halfW = 0.5f * mWidth;
+	const float halfH = 0.5f * mHeight;
+	const float maxX = sMaxGuardBand * mWidth;
+	const float maxY = sMaxGuardBand * mHeight;
+	const SizeT numIndices = indices.Size() - indices.Size() % 3;
+	for ( IndexT i = 0; i < numIndices; i += 3 )
+	{
+		const float4* clip[3] = { &mClipPositions[indices[i]], &mClipPositions[indices[i + 1]], &mClipPositions[indices[i + 2]] };
+
+		// behind the camera or completely outside one of the frustum planes
+		int andFlags = 0x1f;
+		bool drop = false;
+		for ( IndexT v = 0; v < 3; ++v )
+		{
+			const float4& c = *clip[v];
+			if ( c.w() <= sMinClipW )
+			{
+				drop = true;
+				break;
+			}
+			int flags = 0;
+			if ( c.x() < -c.w() ) flags |= 1;
+			if ( c.x() > c.w() ) flags |= 2;
+			if ( c.y() < -c.w() ) flags |= 4;
+			if ( c.y() > c.w() ) flags |= 8;
+			if ( c.z() > c.w() ) flags |= 16;
+			andFlags &= flags;
+		}
+		if ( drop || andFlags != 0 )
+		{
+			continue;
+		}
+
+		ScreenTriangle tri;
+		tri.depth = -FLT_MAX;
+		for ( IndexT v = 0; v < 3; ++v )
+		{
+			const float4& c = *clip[v];
+			const float invW = 1.0f / c.w();
+			tri.x[v] = ( c.x() * invW + 1.0f ) * halfW;
+			tri.y[v] = ( c.y() * invW + 1.0f ) * halfH;
+			tri.depth = n_max(tri.depth, c.z() * invW);
+			if ( n_abs(tri.x[v]) > maxX || n_abs(tri.y[v]) > maxY )
+			{
+				drop = true;
+			}
+		}
+		if ( drop )
+		{
+			continue;
+		}
+
+		// both windings are drawn, make the edge functions positive inside
+		const float area = ( tri.x[1] - tri.x[0] ) * ( tri.y[2] - tri.y[0] ) - ( tri.x[2] - tri.x[0] ) * ( tri.y[1] - tri.y[0] );
+		if ( n_abs(area) < 1.0e-6f )
+		{
+			continue;
+		}
+		if ( area < 0.0f )
+		{
+			float t = tri.x[1]; tri.x[1] = tri.x[2]; tri.x[2] = t;
+			t = tri.y[1]; tri.y[1] = tri.y[2]; tri.y[2] = t;
+		}
+
+		// rows whose pixel centers lie in the triangle's y extent
+		const float minY = n_min(tri.y[0], n_min(tri.y[1], tri.y[2]));
+		const float maxYf = n_max(tri.y[0], n_max(tri.y[1], tri.y[2]));
+		tri.minY = n_max(0, (int)ceilf(minY - 0.5f));
+		tri.maxY = n_min((int)mHeight - 1, (int)floorf(maxYf - 0.5f));
+		if ( tri.minY > tri.maxY )
+		{
+			continue;
+		}
+		mTriangles.Append(tri);
+	}
+}
+
+//------------------------------------------------------------------------------
+/**
+	Clear the band, draw every triangle that overlaps it and update the tile depths.
+	Only touches the rows of the band, so bands can run in parallel.
+*/
+void
+OcclusionBuffer::_RasterizeBand(IndexT band)
+{
+	n_assert( band >= 0 && band < mTilesY );
+	const int row0 = band * TileSize;
+	const int row1 = row0 + TileSize - 1;
+	float* bandDepth = &mDepth[row0 * mWidth];
+
+	// clear
+	const SizeT bandSize = TileSize * mWidth;
+#if OCCLUSIONBUFFER_USE_SSE
+	const __m128 farDepth = _mm_set1_ps(FLT_MAX);
+	for ( IndexT i = 0; i < bandSize; i += 4 )
+	{
+		_mm_storeu_ps(bandDepth + i, farDepth);
+	}
+#elif OCCLUSIONBUFFER_USE_NEON
+	const float32x4_t farDepth = vdupq_n_f32(FLT_MAX);
+	for ( IndexT i = 0; i < bandSize; i += 4 )
+	{
+		vst1q_f32(bandDepth + i, farDepth);
+	}
+#else
+	for ( IndexT i = 0; i < bandSize; ++i )
+	{
+		bandDepth[i] = FLT_MAX;
+	}
+#endif
+
+	const SizeT numTriangles = mTriangles.Size();
+	for ( IndexT t = 0; t < numTriangles; ++t )
+	{
+		const ScreenTriangle& tri = mTriangles[t];
+		if ( tri.maxY < row0 || tri.minY > row1 )
+		{
+			continue;
+		}
+		const float minX = n_min(tri.x[0], n_min(tri.x[1], tri.x[2]));
+		const float maxX = n_max(tri.x[0], n_max(tri.x[1], tri.x[2]));
+		const int x0 = n_max(0, (int)ceilf(minX - 0.5f));
+		const int x1 = n_min((int)mWidth - 1, (int)floorf(maxX - 0.5f));
+		if ( x0 > x1 )
+		{
+			continue;
+		}
+		const int y0 = n_max(tri.minY, row0);
+		const int y1 = n_min(tri.maxY, row1);
+
+		// edge e runs from vertex e to vertex e + 1, E(x, y) = a * x + b * y + c >= 0 inside
+		float a[3], b[3], c[3];
+		for ( IndexT e = 0; e < 3; ++e )
+		{
+			const IndexT n = ( e + 1 ) % 3;
+			a[e] = tri.y[e] - tri.y[n];
+			b[e] = tri.x[n] - tri.x[e];
+			c[e] = -( a[e] * tri.x[e] + b[e] * tri.y[e] );
+		}
+
+#if OCCLUSIONBUFFER_USE_SSE
+		// 4 pixel blocks from a 4 aligned x, the buffer width is a multiple of 4
+		const int xStart = x0 & ~3;
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 depth = _mm_set1_ps(tri.depth);
+		const __m128 laneX = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+		const __m128 a0 = _mm_set1_ps(a[0]);
+		const __m128 a1 = _mm_set1_ps(a[1]);
+		const __m128 a2 = _mm_set1_ps(a[2]);
+		for ( int y = y0; y <= y1; ++y )
+		{
+			const float py = y + 0.5f;
+			const __m128 r0 = _mm_set1_ps(b[0] * py + c[0]);
+			const __m128 r1 = _mm_set1_ps(b[1] * py + c[1]);
+			const __m128 r2 = _mm_set1_ps(b[2] * py + c[2]);
+			float* row = &mDepth[y * mWidth];
+			for ( int x = xStart; x <= x1; x += 4 )
+			{
+				const __m128 px = _mm_add_ps(_mm_set1_ps((float)x), laneX);
+				__m128 inside = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a0, px), r0), zero);
+				inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a1, px), r1), zero));
+				inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a2, px), r2), zero));
+				const __m128 old = _mm_loadu_ps(row + x);
+				const __m128 nearer = _mm_min_ps(old, depth);
+				_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, old)));
+			}
+		}
+#elif OCCLUSIONBUFFER_USE_NEON
+		const int xStart = x0 & ~3;
+		const float32x4_t depth = vdupq_n_f32(tri.depth);
+		const float laneInit[4] = { 0.5f, 1.5f, 2.5f, 3.5f };
+		const float32x4_t laneX = vld1q_f32(laneInit);
+		for ( int y = y0; y <= y1; ++y )
+		{
+			const float py = y + 0.5f;
+			const float32x4_t r0 = vdupq_n_f32(b[0] * py + c[0]);
+			const float32x4_t r1 = vdupq_n_f32(b[1] * py + c[1]);
+			const float32x4_t r2 = vdupq_n_f32(b[2] * py + c[2]);
+			float* row = &mDepth[y * mWidth];
+			for ( int x = xStart; x <= x1; x += 4 )
+			{
+				const float32x4_t px = vaddq_f32(vdupq_n_f32((float)x), laneX);
+				uint32x4_t inside = vcgeq_f32(vmlaq_n_f32(r0, px, a[0]), vdupq_n_f32(0.0f));
+				inside = vandq_u32(inside, vcgeq_f32(vmlaq_n_f32(r1, px, a[1]), vdupq_n_f32(0.0f)));
+				inside = vandq_u32(inside, vcgeq_f32(vmlaq_n_f32(r2, px, a[2]), vdupq_n_f32(0.0f)));
+				const float32x4_t old = vld1q_f32(row + x);
+				vst1q_f32(row + x, vbslq_f32(inside, vminq_f32(old, depth), old));
+			}
+		}
+#else
+		for ( int y = y0; y <= y1; ++y )
+		{
+			const float py = y + 0.5f;
+			const float r0 = b[0] * py + c[0];
+			const float r1 = b[1] * py + c[1];
+			const float r2 = b[2] * py + c[2];
+			float* row = &mDepth[y * mWidth];
+			for ( int x = x0; x <= x1; ++x )
+			{
+				const float px = x + 0.5f;
+				if ( a[0] * px + r0 >= 0.0f && a[1] * px + r1 >= 0.0f && a[2] * px + r2 >= 0.0f )
+				{
+					row[x] = n_min(row[x], tri.depth);
+				}
+			}
+		}
+#endif
+	}
+
+	// farthest depth of each tile in the band
+	for ( IndexT tx = 0; tx < mTilesX; ++tx )
+	{
+		const float* tile = bandDepth + tx * TileSize;
+#if OCCLUSIONBUFFER_USE_SSE
+		__m128 farthest = _mm_loadu_ps(tile);
+		for ( IndexT y = 0; y < TileSize; ++y )
+		{
+			const float* row = tile + y * mWidth;
+			farthest = _mm_max_ps(farthest, _mm_max_ps(_mm_loadu_ps(row), _mm_loadu_ps(row + 4)));
+		}
+		farthest = _mm_max_ps(farthest, _mm_shuffle_ps(farthest, farthest, _MM_SHUFFLE(1, 0, 3, 2)));
+		farthest = _mm_max_ps(farthest, _mm_shuffle_ps(farthest, farthest, _MM_SHUFFLE(2, 3, 0, 1)));
+		_mm_store_ss(&mTileDepth[band * mTilesX + tx], farthest);
+#elif OCCLUSIONBUFFER_USE_NEON
+		float32x4_t farthest = vld1q_f32(tile);
+		for ( IndexT y = 0; y < TileSize; ++y )
+		{
+			const float* row = tile + y * mWidth;
+			farthest = vmaxq_f32(farthest, vmaxq_f32(vld1q_f32(row), vld1q_f32(row + 4)));
+		}
+		float32x2_t pair = vpmax_f32(vget_low_f32(farthest), vget_high_f32(farthest));
+		pair = vpmax_f32(pair, pair);
+		mTileDepth[band * mTilesX + tx] = vget_lane_f32(pair, 0);
+#else
+		float farthest = tile[0];
+		for ( IndexT y = 0; y < TileSize; ++y )
+		{
+			const float* row = tile + y * mWidth;
+			for ( IndexT x = 0; x < TileSize; ++x )
+			{
+				farthest = n_max(farthest, row[x]);
+			}
+		}
+		mTileDepth[band * mTilesX + tx] = farthest;
+#endif
+	}
+}
+
+//------------------------------------------------------------------------------
+/**
+	The box is hidden if its nearest depth lies behind every pixel it may cover.
+	Tiles whose farthest depth is in front of the box are accepted without looking
+	at their pixels. A box crossing the camera plane or off the buffer is never
+	hidden, the frustum test decides about it.
+*/
+bool
+OcclusionBuffer::IsOccluded(const bbox& box) const
+{
+	if ( mTriangles.IsEmpty() )
+	{
+		return false;
+	}
+
+	const float halfW = 0.5f * mWidth;
+	const float halfH = 0.5f * mHeight;
+	float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+	float nearest = FLT_MAX;
+	for ( IndexT i = 0; i < 8; ++i )
+	{
+		const float4 corner((i & 1) ? box.pmax.x() : box.pmin.x(),
+							(i & 2) ? box.pmax.y() : box.pmin.y(),
+							(i & 4) ? box.pmax.z() : box.pmin.z(),
+							1.0f);
+		const float4 clip = matrix44::transform(mViewProj, corner);
+		if ( clip.w() <= sMinClipW )
+		{
+			return false;
+		}
+		const float invW = 1.0f / clip.w();
+		const float sx = ( clip.x() * invW + 1.0f ) * halfW;
+		const float sy = ( clip.y() * invW + 1.0f ) * halfH;
+		minX = n_min(minX, sx);
+		maxX = n_max(maxX, sx);
+		minY = n_min(minY, sy);
+		maxY = n_max(maxY, sy);
+		nearest = n_min(nearest, clip.z() * invW);
+	}
+
+	// every pixel the projected box touches
+	if ( maxX < 0.0f || maxY < 0.0f || minX >= (float)mWidth || minY >= (float)mHeight )
+	{
+		return false;
+	}
+	const int x0 = n_max(0, (int)floorf(minX));
+	const int y0 = n_max(0, (int)floorf(minY));
+	const int x1 = n_min((int)mWidth - 1, (int)floorf(maxX));
+	const int y1 = n_min((int)mHeight - 1, (int)floorf(maxY));
+
+	const int tx0 = x0 / TileSize;
+	const int tx1 = x1 / TileSize;
+	const int ty0 = y0 / TileSize;
+	const int ty1 = y1 / TileSize;
+	for ( int ty = ty0; ty <= ty1; ++ty )
+	{
+		for ( int tx = tx0; tx <= tx1; ++tx )
+		{
+			if ( nearest > mTileDepth[ty * mTilesX + tx] )
+			{
+				continue;
+			}
+			const int px0 = n_max(x0, tx * (int)TileSize);
+			const int px1 = n_min(x1, tx * (int)TileSize + (int)TileSize - 1);
+			const int py0 = n_max(y0, ty * (int)TileSize);
+			const int py1 = n_min(y1, ty * (int)TileSize + (int)TileSize - 1);
+			for ( int y = py0; y <= py1; ++y )
+			{
+				const float* row = &mDepth[y * mWidth];
+				for ( int x = px0; x <= px1; ++x )
+				{
+					if ( nearest <= row[x] )
+					{
+						return false;
+					}
+				}
+			}
+		}
+	}
+	return true;
+}
+
+} // namespace Vis
@@ -0,0 +1,176 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __occlusionbuffer_H__
+#define __occlusionbuffer_H__
+
+#include "core/refcounted.h"
+#include "math/matrix44.h"
+#include "math/bbox.h"
+#include "vis/occluder.h"
+
+//------------------------------------------------------------------------------
+namespace Vis
+{
+	/**
+		Low resolution depth buffer for software occlusion culling.
+
+		Rasterize() draws the occluders as seen through a view projection matrix. Each
+		triangle is written at the depth of its farthest vertex and each pixel keeps the
+		nearest triangle, so the buffer never claims a pixel is nearer than the occluders
+		really are. The buffer is split into bands of TileSize rows which are rasterized
+		as job slices; every band also stores the farthest depth of each TileSize x
+		TileSize tile.
+
+		IsOccluded() projects a box and compares its nearest depth against the tiles it
+		covers, and only falls back to the pixels for tiles that do not decide. It is
+		read only and may be called from several jobs at once.
+
+		Depth is clip z / w, which grows with the distance for both depth conventions.
+		Nothing here touches the GPU.
+	*/
+	class OcclusionBuffer : public Core::RefCounted
+	{
+		__DeclareClass(OcclusionBuffer);
+	public:
+		/// tile width and height in pixels, also the height of a raster band
+		static const SizeT TileSize = 8;
+
+		/// constructor
+		OcclusionBuffer();
+		/// destructor
+		virtual ~OcclusionBuffer();
+
+		/// set the resolution, rounded up to multiples of TileSize
+		void Setup(SizeT width, SizeT height);
+		/// get width in pixels
+		SizeT GetWidth() const;
+		/// get height in pixels
+		SizeT GetHeight() const;
+
+		/// clear and rasterize the enabled occluders
+		void Rasterize(const Util::Array<GPtr<Occluder> >& occluders, const Math::matrix44& viewProj);
+		/// true if the last Rasterize() drew at least one triangle
+		bool HasOccluders() const;
+		/// number of triangles drawn by the last Rasterize()
+		SizeT GetNumTriangles() const;
+
+		/// true if the box is completely hidden behind the occluders
+		bool IsOccluded(const Math::bbox& box) const;
+
+		/// get the depth of a pixel, for debugging
+		float GetDepth(IndexT x, IndexT y) const;
+
+		/// job slice of the raster job
+		struct RasterBand
+		{
+			OcclusionBuffer* buffer;
+			IndexT band;
+		};
+		/// rasterize a band of TileSize rows, called from the raster jobs
+		void _RasterizeBand(IndexT band);
+
+		/// the number of triangles from which Rasterize() uses the job system
+		static void SetParallelThreshold(SizeT numTriangles);
+		static SizeT GetParallelThreshold();
+
+	protected:
+		struct ScreenTriangle
+		{
+			float x[3];
+			float y[3];
+			float depth;		// farthest vertex
+			int minY;
+			int maxY;
+		};
+
+		/// transform, clip and set up the triangles of an occluder
+		void _SetupTriangles(const Occluder& occluder);
+
+		Math::matrix44 mViewProj;
+		SizeT mWidth;
+		SizeT mHeight;
+		SizeT mTilesX;
+		SizeT mTilesY;
+		Util::Array<float> mDepth;
+		Util::Array<float> mTileDepth;		// farthest depth of each tile
+		Util::Array<ScreenTriangle> mTriangles;
+		Util::Array<Math::float4> mClipPositions;
+
+		static SizeT s_parallelThreshold;
+	};
+
+	//------------------------------------------------------------------------
+	inline
+	SizeT
+	OcclusionBuffer::GetWidth() const
+	{
+		return mWidth;
+	}
+	//------------------------------------------------------------------------
+	inline
+	SizeT
+	OcclusionBuffer::GetHeight() const
+	{
+		return mHeight;
+	}
+	//------------------------------------------------------------------------
+	inline
+	bool
+	OcclusionBuffer::HasOccluders() const
+	{
+		return !mTriangles.IsEmpty();
+	}
+	//------------------------------------------------------------------------
+	inline
+	SizeT
+	OcclusionBuffer::GetNumTriangles() const
+	{
+		return mTriangles.Size();
+	}
+	//------------------------------------------------------------------------
+	inline
+	float
+	OcclusionBuffer::GetDepth(IndexT x, IndexT y) const
+	{
+		n_assert( x >= 0 && x < mWidth && y >= 0 && y < mHeight );
+		return mDepth[y * mWidth + x];
+	}
+	//------------------------------------------------------------------------
+	inline
+	void
+	OcclusionBuffer::SetParallelThreshold(SizeT numTriangles)
+	{
+		s_parallelThreshold = numTriangles;
+	}
+	//------------------------------------------------------------------------
+	inline
+	SizeT
+	OcclusionBuffer::GetParallelThreshold()
+	{
+		return s_parallelThreshold;
+	}
+} // namespace Vis
+//------------------------------------------------------------------------------
+
+#endif // __occlusionbuffer_H__
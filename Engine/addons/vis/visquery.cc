@@ -46,6 +46,11 @@ VisQuery::VisQuery()
 VisQuery::~VisQuery()
 {
     this->mJobPort = 0;
+	if ( this->mObserverContext.isvalid() )
+	{
+		this->mObserverContext->SetOcclusionBuffer( NULL );
+	}
+	this->mOcclusionBuffer = 0;
     this->mObserverContext = 0;
 	mResultList.Clear();
 	mVisibilitySystems.Clear();
@@ -105,6 +110,13 @@ VisQuery::EndQuery()
 	mVisibilitySystems.Clear();
 	mJobs.Clear();
 
+	// the buffer goes back to the VisServer pool
+	if ( mOcclusionBuffer.isvalid() )
+	{
+		mObserverContext->SetOcclusionBuffer( NULL );
+		mOcclusionBuffer = 0;
+	}
+
 	// սָĿܻ⡣ 
 	SizeT AllCount = 0;
 	for ( IndexT index = 0; index < mTempResults.Size(); ++index )
@@ -59,6 +59,9 @@ namespace Vis
 		/// get Observer
 		const GPtr<ObserverContext>& GetObserver() const;  
 
+		/// set the occlusion buffer of the observer, kept until EndQuery()
+		void SetOcclusionBuffer(const GPtr<OcclusionBuffer>& buffer);
+
 		/// run job
 		void Run();
 
@@ -75,6 +78,7 @@ namespace Vis
 		friend class VisServer;	
 
 		GPtr<ObserverContext> mObserverContext;
+		GPtr<OcclusionBuffer> mOcclusionBuffer;
 		Util::Array<GPtr<VisEntity> > mResultList;
 		Util::Array<GPtr<VisSystemBase> > mVisibilitySystems;       
 		GPtr<Jobs::JobPort> mJobPort;
@@ -105,6 +109,15 @@ namespace Vis
 	{
 		return mObserverContext;
 	}
+	//------------------------------------------------------------------------------
+	inline 
+	void 
+	VisQuery::SetOcclusionBuffer(const GPtr<OcclusionBuffer>& buffer)
+	{
+		n_assert( mObserverContext.isvalid() );
+		mOcclusionBuffer = buffer;
+		mObserverContext->SetOcclusionBuffer( buffer.get_unsafe() );
+	}
 	//------------------------------------------------------------------------
 	inline
 	const Util::Array<GPtr<VisEntity> >& 
@@ -32,6 +32,10 @@ using namespace Math;
 
 #define NUM_JOBS_PERFRAME 64
 
+// low resolution is enough for the few large occluders, and keeps rasterizing and testing cheap
+static const SizeT DefaultOcclusionWidth = 256;
+static const SizeT DefaultOcclusionHeight = 128;
+
 __ImplementClass(Vis::VisServer, 'VISE', Core::RefCounted);
 
 //------------------------------------------------------------------------------
@@ -39,7 +43,8 @@ __ImplementClass(Vis::VisServer, 'VISE', Core::RefCounted);
 */
 VisServer::VisServer()
 	: mIsOpen(false)
-
+	, mOcclusionWidth(DefaultOcclusionWidth)
+	, mOcclusionHeight(DefaultOcclusionHeight)
 { 
 
 }
@@ -186,10 +191,70 @@ VisServer::Close()
         this->mVisibilitySystems[i]->Close();    	
     }
 	mVisibilitySystems.Clear();
+	mOccluders.Clear();
+	mOcclusionBuffers.Clear();
     this->mIsOpen = false;
 }
 
 
+//------------------------------------------------------------------------------
+/**
+*/
+void 
+VisServer::AttachOccluder(const GPtr<Occluder>& occluder)
+{
+	n_assert( occluder.isvalid() );
+	n_assert( InvalidIndex == mOccluders.FindIndex(occluder) );
+	mOccluders.Append(occluder);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void 
+VisServer::RemoveOccluder(const GPtr<Occluder>& occluder)
+{
+	IndexT index = mOccluders.FindIndex(occluder);
+	n_assert( InvalidIndex != index );
+	if ( InvalidIndex != index )
+	{
+		mOccluders.EraseIndex(index);
+	}
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void 
+VisServer::SetOcclusionBufferSize(SizeT width, SizeT height)
+{
+	n_assert( width > 0 && height > 0 );
+	mOcclusionWidth = width;
+	mOcclusionHeight = height;
+	// the buffers are set up again when they are used next
+	mOcclusionBuffers.Clear();
+}
+
+//------------------------------------------------------------------------------
+/**
+	A buffer referenced only by this pool is not used by any query.
+*/
+GPtr<OcclusionBuffer> 
+VisServer::_AcquireOcclusionBuffer()
+{
+	for ( IndexT i = 0; i < mOcclusionBuffers.Size(); ++i )
+	{
+		if ( mOcclusionBuffers[i]->GetRefCount() == 1 )
+		{
+			return mOcclusionBuffers[i];
+		}
+	}
+	GPtr<OcclusionBuffer> buffer = OcclusionBuffer::Create();
+	buffer->Setup(mOcclusionWidth, mOcclusionHeight);
+	mOcclusionBuffers.Append(buffer);
+	return buffer;
+}
+
 //------------------------------------------------------------------------------
 /**
 */
@@ -249,6 +314,17 @@ VisServer::CreateVisQuery(const GPtr<ObserverContext>& observer , const Util::Ar
 
 	pQuery->SetObserver( observer );
 
+	// rasterize the occluders as seen by this observer before the query jobs test against them
+	if ( observer->IsOcclusionCulling() && ObserverContext::ViewProjectionMatrix == observer->GetType() && !mOccluders.IsEmpty() )
+	{
+		GPtr<OcclusionBuffer> buffer = _AcquireOcclusionBuffer();
+		buffer->Rasterize( mOccluders, observer->GetViewProjectionMatrix() );
+		if ( buffer->HasOccluders() )
+		{
+			pQuery->SetOcclusionBuffer( buffer );
+		}
+	}
+
 	if ( systemIndex.Size() == 0 )
 	{
 		SizeT systemSize = mVisibilitySystems.Size();
@@ -29,6 +29,8 @@ THE SOFTWARE.
 #include "vis/visentity.h"
 #include "vis/vissystems/vissystembase.h"
 #include "vis/visquery.h"
+#include "vis/occluder.h"
+#include "vis/occlusionbuffer.h"
 #include "vis/visentity.h"
 #include "core/singleton.h"
               
@@ -143,17 +145,58 @@ public:
 								 Util::Array< GPtr<VisQuery> >& results );
 
 
+	/**
+	* AttachOccluder  add an occluder mesh. 
+	* @param: const GPtr<Occluder> & occluder  
+	* @return: void  
+	* @see: ObserverContext::SetOcclusionCulling
+	* @remark:  the occluders are rasterized for each query whose observer asks for occlusion culling
+	*/
+	void AttachOccluder(const GPtr<Occluder>& occluder);
+
+	/**
+	* RemoveOccluder  remove an occluder mesh.
+	* @param: const GPtr<Occluder> & occluder  
+	* @return: void  
+	* @see: 
+	* @remark:  
+	*/
+	void RemoveOccluder(const GPtr<Occluder>& occluder);
+
+	/// get the attached occluders
+	const Util::Array<GPtr<Occluder> >& GetOccluders() const;
+
+	/// set the resolution of the occlusion buffers
+	void SetOcclusionBufferSize(SizeT width, SizeT height);
+
     /// on render debug
     void OnRenderDebug();
 
 protected:
 	GPtr<VisQuery> CreateVisQuery(const GPtr<ObserverContext>& observer , const Util::Array<IndexT>& systemIndex );
 
+	/// get an occlusion buffer no running query uses
+	GPtr<OcclusionBuffer> _AcquireOcclusionBuffer();
+
 private:       
     bool mIsOpen;
     Util::Array<GPtr<VisSystemBase> > mVisibilitySystems;  
+
+	Util::Array<GPtr<Occluder> > mOccluders;
+	Util::Array<GPtr<OcclusionBuffer> > mOcclusionBuffers;
+	SizeT mOcclusionWidth;
+	SizeT mOcclusionHeight;
 };
 
+//------------------------------------------------------------------------------
+/**
+*/
+inline const Util::Array<GPtr<Occluder> >&
+VisServer::GetOccluders() const
+{
+	return this->mOccluders;
+}
+
 } // namespace Vis
 //------------------------------------------------------------------------------
 
@@ -243,13 +243,23 @@ VisCell::RecurseCollectVisibleEntities(const GPtr<ObserverContext>& observerCont
 			// cell isn't visible by observer context
 			return;
 		}
-		else if (ClipStatus::Inside == clipStatus)
+
+		// cell is hidden behind the occluders, so are its entities and child cells
+		if ( observerContext->IsOccluded( this->GetBoundingBox() ) )
+		{
+			return;
+		}
+
+		if (ClipStatus::Inside == clipStatus)
 		{
 			EntityList::const_iterator itor = this->mEntities.begin();
 			EntityList::const_iterator end = this->mEntities.end();
 			while( itor != end )
 			{
-				visibilityEntities.Append( *itor );
+				if ( !observerContext->IsOccluded( (*itor)->GetBoundingBox() ) )
+				{
+					visibilityEntities.Append( *itor );
+				}
 				++itor;
 			}
 		}
@@ -259,7 +269,8 @@ VisCell::RecurseCollectVisibleEntities(const GPtr<ObserverContext>& observerCont
 			EntityList::const_iterator end = this->mEntities.end();
 			while( itor != end )
 			{
-				if ( observerContext->ComputeClipStatus( (*itor)->GetBoundingBox() ) != ClipStatus::Outside )
+				if ( observerContext->ComputeClipStatus( (*itor)->GetBoundingBox() ) != ClipStatus::Outside
+					&& !observerContext->IsOccluded( (*itor)->GetBoundingBox() ) )
 				{    
 					visibilityEntities.Append(*itor);
 				}  
@@ -275,7 +286,8 @@ VisCell::RecurseCollectVisibleEntities(const GPtr<ObserverContext>& observerCont
 		EntityList::const_iterator end = this->mEntities.end();
 		while( itor != end )
 		{
-			if ( observerContext->ComputeClipStatus( (*itor)->GetBoundingBox() ) != ClipStatus::Outside )
+			if ( observerContext->ComputeClipStatus( (*itor)->GetBoundingBox() ) != ClipStatus::Outside
+				&& !observerContext->IsOccluded( (*itor)->GetBoundingBox() ) )
 			{    
 				visibilityEntities.Append(*itor);
 			}  
@@ -27,6 +27,8 @@ THE SOFTWARE.
 #include "AnimationFeature.h"
 #include "animation/AnimationServer.h"
 #include "basegamefeature/managers/timesource.h"
+#include "graphicfeature/graphicsfeature.h"
+#include "appframework/actor.h"
 
 namespace App
 {
@@ -61,6 +63,16 @@ namespace App
 	void AnimationFeature::OnFrame()
 	{
 		PROFILER_ADDDTICKBEGIN(animationsTime);
+		// the components pick their lod from this position on the next frame
+		m_pAnimationServer->ClearLodViewPosition();
+		if (m_pAnimationServer->IsLodEnabled() && GraphicsFeature::HasInstance())
+		{
+			GPtr<Actor> camera = GraphicsFeature::Instance()->GetDefaultCameraActor();
+			if (camera.isvalid())
+			{
+				m_pAnimationServer->SetLodViewPosition(camera->GetWorldPosition());
+			}
+		}
 		m_pAnimationServer->UpdateAnimatons( (float)GameTime::Instance()->GetFrameTime() );
 		PROFILER_ADDDTICKEND(animationsTime);
 	}
@@ -29,6 +29,7 @@ THE SOFTWARE.
 #include "app/application.h"
 #include "debug/debugserver.h"
 #include "appframework/actormanager.h"
+#include "appframework/transformsystem.h"
 #include "basegamefeature/managers/sceneschedulemanager.h"
 #include "terrainfeature/components/TerrainRenderComponent.h"
 #include "vegetationfeature/components/vegetationrendercomponent.h"
@@ -73,6 +74,8 @@ Actor::Actor() :
 	mLocalRotation(0,0,0,1),
 	mWorldRotation(0,0,0,1),
 	mParent(NULL),
+	mTransformSlot(InvalidIndex),
+	mMovePending(false),
 	mComponentsCommSign(eCCS_None),
 	mVisible(true),
 #ifdef __GENESIS_EDITOR__
@@ -97,6 +100,7 @@ Actor::~Actor()
 {
     n_assert(!this->mActivated);
 	n_assert(mComponents.Size()==0);
+	n_assert(InvalidIndex == mTransformSlot);
     this->mDispatcher = 0;
 }
 
@@ -129,6 +133,10 @@ Actor::_Destory(bool forceShutDown )
 	{
 		/// ϵͳ
 		_CleanupAllComponents();
+		if ( TransformSystem::HasInstance() )
+		{
+			TransformSystem::Instance()->Detach(this);
+		}
 		mParent = NULL;
 		mChildren.Clear();
 		mActivated = false;
@@ -203,6 +211,7 @@ Actor::SetTransform( const Math::matrix44& m )
 void
 Actor::SetWorldTransform( const Math::matrix44& m )
 {
+	_UpdateWolrdTransform();
 	if ( mWorldTrans == m )
 	{
 		return;
@@ -359,6 +368,8 @@ Actor::GetTransform() const
 void
 Actor::SetWorldPosition(const Math::vector& pos)
 {
+	// the other two components are used below, they must be current
+	_UpdateWolrdTransform();
 	if (mWorldPosition != pos)
 	{
 		if ( IsActive() )
@@ -413,6 +424,8 @@ Actor::SetWorldPosition(const Math::vector& pos)
 void
 Actor::SetWorldRotation(const Math::quaternion& rot)
 {
+	// the other two components are used below, they must be current
+	_UpdateWolrdTransform();
 	if (mWorldRotation != rot)
 	{
 		if ( IsActive() )
@@ -467,6 +480,8 @@ Actor::SetWorldRotation(const Math::quaternion& rot)
 void 
 Actor::SetWorldScale(const Math::vector& scale)
 {
+	// the other two components are used below, they must be current
+	_UpdateWolrdTransform();
 	if (mWorldScale != scale)
 	{
 		if ( IsActive() )
@@ -971,6 +986,10 @@ Actor::OnActivate()
 {
 	n_assert(!this->mActivated);
 	this->mActivated = true;
+	if ( TransformSystem::HasInstance() )
+	{
+		TransformSystem::Instance()->Attach(this);
+	}
 	// activate all Components
 	this->_ActivateAllComponents();
 }
@@ -983,6 +1002,11 @@ Actor::OnDeactivate()
 
 	// cleanup Components
 	this->_DeactivateAllComponents();
+
+	if ( TransformSystem::HasInstance() )
+	{
+		TransformSystem::Instance()->Detach(this);
+	}
 }
 //------------------------------------------------------------------------------
 /**
@@ -1189,6 +1213,16 @@ void
 Actor::OnMoveBefore()
 {
     //n_assert(this->IsActive());
+	if ( InvalidIndex != mTransformSlot && TransformSystem::Instance()->IsDeferMoveNotify() )
+	{
+		// only the first move in a frame, TransformSystem::Update() sends OnMoveAfter
+		if ( mMovePending )
+		{
+			return;
+		}
+		mMovePending = true;
+		TransformSystem::Instance()->MarkDirty(mTransformSlot);
+	}
 
 	const Util::Array<GPtr<Component> >& props = this->mCallbackComponents[Component::MoveBefore];
     IndexT i;
@@ -1218,7 +1252,23 @@ void
 Actor::OnMoveAfter()
 {
     //n_assert(this->IsActive());
+	if ( mMovePending )
+	{
+		return;
+	}
 
+	_SendMoveAfter();
+
+	SizeT numActor = mChildren.Size();
+	for ( IndexT i = 0; i < numActor; ++i )
+	{
+		mChildren[i]->OnMoveAfter();
+	}
+}
+//------------------------------------------------------------------------------
+void
+Actor::_SendMoveAfter()
+{
 	const Util::Array<GPtr<Component> >& props = this->mCallbackComponents[Component::MoveAfter];
     IndexT i;
     SizeT num = props.Size();
@@ -1235,12 +1285,6 @@ Actor::OnMoveAfter()
 		this->mComponentOnMoveAfterDebugTimer[timerName]->StopAccum();
 #endif
     }
-
-	SizeT numActor = mChildren.Size();
-	for ( IndexT i = 0; i < numActor; ++i )
-	{
-		mChildren[i]->OnMoveAfter();
-	}
 }
 //------------------------------------------------------------------------------
 void 
@@ -1714,6 +1758,10 @@ Actor::_SetParentImpl(Actor* p)
 			OnMoveBefore();
 		}
 		mParent = p;
+		if ( InvalidIndex != mTransformSlot )
+		{
+			TransformSystem::Instance()->MarkHierarchyDirty();
+		}
 		_DirtyWorldTransform();
 
 		if ( IsActive() )
@@ -1730,6 +1778,17 @@ Actor::_SetParentImpl(Actor* p)
 void 
 Actor::_DirtyWorldTransform()
 {
+	if ( InvalidIndex != mTransformSlot )
+	{
+		TransformSystem::Instance()->MarkDirty(mTransformSlot);
+	}
+#ifndef __GENESIS_EDITOR__
+	// the children of a dirty actor are dirty already
+	if ( mDirtyWorldTrans && mDirtyWorldBB )
+	{
+		return;
+	}
+#endif
 	mDirtyWorldTrans = true;
 	mDirtyWorldBB = true;	//	world matrix change world bounding box need change too
 
@@ -1779,44 +1838,29 @@ Actor::_UpdateWolrdTransform() const
  {
 	if ( mDirtyWorldTrans )
 	{
-		// ¼
 		if (mParent)
 		{
-			const Math::matrix44& pw =  mParent->GetWorldTransform();
-			Math::matrix44 own = Math::matrix44::transformation(mLocalScale, mLocalRotation, mLocalPosition);
-			mWorldTrans = Math::matrix44::multiply(pw,own);
-			mWorldTrans.setrow3( Math::float4(0.0f,0.0f,0.0f,1.0f));
-			mWorldTrans.decompose(mWorldScale,mWorldRotation, mWorldPosition);
-
-			//Math::quaternion ParentRotation = mParent->GetWorldRotation();
-			//Math::vector ParentScale = mParent->GetWorldScale();
-			//Math::vector ParentPosition = mParent->GetWorldPosition();
-
-			//mWorldRotation = Math::quaternion::multiply( ParentRotation, mLocalRotation );
-			//mWorldPosition = ParentRotation * ( mLocalPosition * ParentScale ) + ParentPosition;
-			//mWorldScale = ParentScale * mLocalScale;
+			mParent->_UpdateWolrdTransform();
 		}
-		else
+		// an attached actor reads the world the last TransformSystem::Update() computed for it
+		if ( InvalidIndex != mTransformSlot 
+			&& TransformSystem::Instance()->_FetchWorld(mTransformSlot, mWorldTrans, mWorldPosition, mWorldRotation, mWorldScale) )
 		{
-			// Root node, no parent
-			mWorldRotation = mLocalRotation;
-			mWorldPosition = mLocalPosition;
-			mWorldScale = mLocalScale;
-
-			mWorldTrans = Math::matrix44::transformation(
-				mWorldScale,
-				mWorldRotation,
-				mWorldPosition);
+			mDirtyWorldTrans = false;
+			return;
 		}
-
-		//mWorldTrans = Math::matrix44::transformation(
-		//	mWorldScale,
-		//	mWorldRotation,
-		//	mWorldPosition);
-
-		mDirtyWorldTrans = false;
+		_ComputeWorldTransform( mParent ? &mParent->mWorldTrans : NULL );
 	}
 }
+//------------------------------------------------------------------------
+void 
+Actor::_ComputeWorldTransform(const Math::matrix44* parentWorld) const
+{
+	// same math as the TransformSystem entries, a lazily computed world matches the batched one
+	TransformSystem::ComputeWorld(parentWorld, mLocalPosition, mLocalRotation, mLocalScale, 
+		mWorldTrans, mWorldPosition, mWorldRotation, mWorldScale);
+	mDirtyWorldTrans = false;
+}
 
 //------------------------------------------------------------------------------
 void 
@@ -326,6 +326,9 @@ namespace App
 		/// called after movement
 		void OnMoveAfter();
 
+		/// slot in the TransformSystem, InvalidIndex while not active
+		IndexT GetTransformSlot() const;
+
 		/// called before rendering
 		void OnFrame();
 
@@ -384,6 +387,8 @@ namespace App
 		typedef Util::Array<TActorPtr> Children;
 		// recompute world transform if need
 		void _UpdateWolrdTransform() const;
+		// recompute world transform from the parent world transform, NULL for a root
+		void _ComputeWorldTransform(const Math::matrix44* parentWorld) const;
 		void _UpdateLocalTransform() const;
 		
 
@@ -419,6 +424,9 @@ namespace App
 
 		void _DirtyWorldTransform();
 
+		/// call the MoveAfter callbacks of this actor only
+		void _SendMoveAfter();
+
 		/// called when attached to world. Just called by ActorManger
 		void OnActivate();
 
@@ -515,6 +523,9 @@ namespace App
 
 		Actor* mParent;
 		Children mChildren;
+
+		IndexT mTransformSlot;
+		bool mMovePending;		// OnMoveAfter deferred to TransformSystem::Update()
 		
 		bool mVisible;
 		Resources::Priority mPriority;
@@ -524,6 +535,7 @@ namespace App
 		friend class ActorManager;
 		friend class ActorSerialization;
 		friend class Scene;
+		friend class TransformSystem;
 
 #if NEBULA3_ENABLE_PROFILING
 		Util::Dictionary<Util::String, GPtr<Debug::DebugTimer> > mComponentActivateDebugTimer;
@@ -747,6 +759,13 @@ namespace App
 		return mParent;
 	}
 	//------------------------------------------------------------------------
+	inline
+		IndexT 
+		Actor::GetTransformSlot(void) const
+	{
+		return mTransformSlot;
+	}
+	//------------------------------------------------------------------------
 	inline
 		SizeT 
 		Actor::GetChildCount(void) const
@@ -47,6 +47,7 @@ namespace App
 	{
 		__ConstructThreadSingleton;
 		mCurrentClearIterator = mAllCreatedActors.begin();
+		mTransformSystem = TransformSystem::Create();
 	}
 	//------------------------------------------------------------------------
 	ActorManager::~ActorManager()
@@ -54,6 +55,7 @@ namespace App
 		n_assert( mActiveActors.Size() == 0 );
 		n_assert( mTemplateActors.Size() == 0 );
 		n_assert( mAllCreatedActors.size() == 0 );
+		mTransformSystem = 0;
 		__DestructThreadSingleton;
 	}
 	//------------------------------------------------------------------------
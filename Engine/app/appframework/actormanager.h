@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "app/appframework/serialization.h"
 #include "addons/serialization/serializeserver.h"
 #include "app/appframework/actor.h"
+#include "app/appframework/transformsystem.h"
 #include "core/singleton.h"
 
 namespace App
@@ -283,6 +284,8 @@ namespace App
 
 		ActorDustbin  mArrActorDustbin; 
 
+		GPtr<TransformSystem> mTransformSystem;
+
 		bool mModified;
 
 		friend class ActorManagerSerialization;
@@ -0,0 +1,227 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "stdneb.h"
+#include "appframework/framebenchmark.h"
+
+namespace App
+{
+	__ImplementClass(App::FrameBenchmark, 'FRBM', Core::RefCounted);
+
+	using namespace Util;
+	using namespace Debug;
+
+	//------------------------------------------------------------------------
+	FrameBenchmark::FrameBenchmark()
+		: mFrameBeginTicks(0)
+	{
+
+	}
+	//------------------------------------------------------------------------
+	FrameBenchmark::~FrameBenchmark()
+	{
+
+	}
+	//------------------------------------------------------------------------
+	void FrameBenchmark::SetInfo(const String& key, const String& value)
+	{
+		IndexT index = mInfo.FindIndex(key);
+		if (InvalidIndex == index)
+		{
+			mInfo.Add(key, value);
+		}
+		else
+		{
+			mInfo.ValueAtIndex(index) = value;
+		}
+	}
+	//------------------------------------------------------------------------
+	void FrameBenchmark::Reset()
+	{
+		mFrameTimes.Clear();
+		mZoneIndices.Clear();
+		mZones.Clear();
+	}
+	//------------------------------------------------------------------------
+	void FrameBenchmark::BeginFrame()
+	{
+		mFrameBeginTicks = ZoneProfiler::GetTicks();
+	}
+	//------------------------------------------------------------------------
+	void FrameBenchmark::EndFrame()
+	{
+		uint64 endTicks = ZoneProfiler::GetTicks();
+		mFrameTimes.Append(TicksToMs(endTicks - mFrameBeginTicks));
+		AccumulateZones(ZoneProfiler::GetFrameIndex());
+	}
+	//------------------------------------------------------------------------
+	/**
+		The profiler keeps the last ZoneProfiler::ThreadBuffer::Capacity zones
+		per thread, frames which record more zones on a thread are only
+		partially accounted.
+	*/
+	void FrameBenchmark::AccumulateZones(uint frame)
+	{
+		IndexT zoneIndex;
+		for (zoneIndex = 0; zoneIndex < mZones.Size(); zoneIndex++)
+		{
+			mZones[zoneIndex].frameTicks = 0;
+		}
+
+		IndexT threadIndex;
+		for (threadIndex = 0; threadIndex < ZoneProfiler::GetNumThreads(); threadIndex++)
+		{
+			const char* threadName = ZoneProfiler::GetThreadName(threadIndex);
+			ZoneProfiler::CopyEvents(threadIndex, mEvents);
+			IndexT i;
+			for (i = 0; i < mEvents.Size(); i++)
+			{
+				const ZoneProfiler::Event& event = mEvents[i];
+				if (event.frame != frame)
+				{
+					continue;
+				}
+				String key;
+				key.Format("%s|%d|%s", threadName, event.depth, event.name);
+				IndexT index = mZoneIndices.FindIndex(key);
+				if (InvalidIndex == index)
+				{
+					ZoneStats stats;
+					stats.thread = threadName;
+					stats.name = event.name;
+					stats.depth = event.depth;
+					stats.calls = 0;
+					stats.totalTicks = 0;
+					stats.frameTicks = 0;
+					stats.maxFrameTicks = 0;
+					mZoneIndices.Add(key, mZones.Size());
+					mZones.Append(stats);
+					index = mZones.Size() - 1;
+				}
+				else
+				{
+					index = mZoneIndices.ValueAtIndex(index);
+				}
+				ZoneStats& stats = mZones[index];
+				uint64 ticks = event.endTicks - event.beginTicks;
+				stats.calls++;
+				stats.totalTicks += ticks;
+				stats.frameTicks += ticks;
+			}
+		}
+
+		for (zoneIndex = 0; zoneIndex < mZones.Size(); zoneIndex++)
+		{
+			ZoneStats& stats = mZones[zoneIndex];
+			stats.maxFrameTicks = Math::n_max(stats.maxFrameTicks, stats.frameTicks);
+		}
+	}
+	//------------------------------------------------------------------------
+	double FrameBenchmark::TicksToMs(uint64 ticks)
+	{
+		return ZoneProfiler::TicksToMicroseconds(ticks) / 1000.0;
+	}
+	//------------------------------------------------------------------------
+	/**
+		Output layout:
+
+		{ "info": { key: value, ... },
+		  "frames": n,
+		  "frameTime": { "avg", "min", "max", "p50", "p90", "p99" },
+		  "zones": [ { "thread", "name", "depth", "calls", "callsPerFrame",
+		               "totalMs", "avgMs", "maxMs" }, ... ] }
+
+		All times are milliseconds, "avgMs" is the average time per frame,
+		"maxMs" the maximum time spent in the zone within one frame.
+	*/
+	bool FrameBenchmark::WriteJson(const GPtr<IO::Stream>& stream) const
+	{
+		n_assert(stream.isvalid());
+		bool wasOpen = stream->IsOpen();
+		if (!wasOpen)
+		{
+			stream->SetAccessMode(IO::Stream::WriteAccess);
+			if (!stream->Open())
+			{
+				return false;
+			}
+		}
+
+		SizeT numFrames = mFrameTimes.Size();
+		double avg = 0.0, minTime = 0.0, maxTime = 0.0, p50 = 0.0, p90 = 0.0, p99 = 0.0;
+		if (numFrames > 0)
+		{
+			Array<double> sorted = mFrameTimes;
+			sorted.Sort();
+			IndexT i;
+			for (i = 0; i < numFrames; i++)
+			{
+				avg += sorted[i];
+			}
+			avg /= numFrames;
+			minTime = sorted.Front();
+			maxTime = sorted.Back();
+			p50 = sorted[(numFrames - 1) * 50 / 100];
+			p90 = sorted[(numFrames - 1) * 90 / 100];
+			p99 = sorted[(numFrames - 1) * 99 / 100];
+		}
+
+		String str;
+		str.Reserve(256);
+		str = "{\n\"info\":{";
+		IndexT i;
+		for (i = 0; i < mInfo.Size(); i++)
+		{
+			String item;
+			item.Format("%s\"%s\":\"%s\"", i > 0 ? "," : "", ZoneProfiler::EscapeJson(mInfo.KeyAtIndex(i).AsCharPtr()).AsCharPtr(), 
+				ZoneProfiler::EscapeJson(mInfo.ValueAtIndex(i).AsCharPtr()).AsCharPtr());
+			str.Append(item);
+		}
+		str.Append("},\n");
+		stream->Write(str.AsCharPtr(), str.Length());
+
+		str.Format("\"frames\":%d,\n\"frameTime\":{\"avg\":%.4f,\"min\":%.4f,\"max\":%.4f,\"p50\":%.4f,\"p90\":%.4f,\"p99\":%.4f},\n\"zones\":[",
+			numFrames, avg, minTime, maxTime, p50, p90, p99);
+		stream->Write(str.AsCharPtr(), str.Length());
+
+		double frameDiv = (numFrames > 0) ? double(numFrames) : 1.0;
+		for (i = 0; i < mZones.Size(); i++)
+		{
+			const ZoneStats& stats = mZones[i];
+			double totalMs = TicksToMs(stats.totalTicks);
+			str.Format("%s\n{\"thread\":\"%s\",\"name\":\"%s\",\"depth\":%u,\"calls\":%d,\"callsPerFrame\":%.2f,\"totalMs\":%.4f,\"avgMs\":%.4f,\"maxMs\":%.4f}",
+				i > 0 ? "," : "", ZoneProfiler::EscapeJson(stats.thread.AsCharPtr()).AsCharPtr(), ZoneProfiler::EscapeJson(stats.name).AsCharPtr(), 
+				stats.depth, stats.calls,
+				stats.calls / frameDiv, totalMs, totalMs / frameDiv, TicksToMs(stats.maxFrameTicks));
+			stream->Write(str.AsCharPtr(), str.Length());
+		}
+		str = "\n]\n}\n";
+		stream->Write(str.AsCharPtr(), str.Length());
+
+		if (!wasOpen)
+		{
+			stream->Close();
+		}
+		return true;
+	}
+}
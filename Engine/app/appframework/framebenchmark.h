@@ -0,0 +1,102 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __framebenchmark_H__
+#define __framebenchmark_H__
+
+#include "core/refcounted.h"
+#include "util/array.h"
+#include "util/dictionary.h"
+#include "util/string.h"
+#include "io/stream.h"
+#include "debug/zoneprofiler.h"
+
+namespace App
+{
+	/**
+		Measures a sequence of frames and writes machine readable timings.
+
+		Bracket every measured frame with BeginFrame()/EndFrame(). The wall
+		time of every frame is kept, the zones recorded by the Debug::ZoneProfiler
+		during the frame are accumulated per thread and zone, so every subsystem
+		which opens a zone (PROFILER_ZONE, PROFILER_ADDDTICKBEGIN) shows up in
+		the output. WriteJson() writes the result, meant to be consumed by
+		automated performance regression tests.
+	*/
+	class FrameBenchmark : public Core::RefCounted
+	{
+		__DeclareClass(FrameBenchmark);
+	public:
+		/// constructor
+		FrameBenchmark();
+		/// destructor
+		virtual ~FrameBenchmark();
+
+		/// add a key/value pair to the "info" section of the output (scene name, frame time, ...)
+		void SetInfo(const Util::String& key, const Util::String& value);
+		/// discard all samples
+		void Reset();
+		/// call right before a measured frame
+		void BeginFrame();
+		/// call right after a measured frame
+		void EndFrame();
+		/// get number of measured frames
+		SizeT GetNumFrames() const;
+		/// write the result as json
+		bool WriteJson(const GPtr<IO::Stream>& stream) const;
+
+	private:
+		struct ZoneStats
+		{
+			Util::String thread;
+			const char* name;
+			uint depth;
+			SizeT calls;
+			uint64 totalTicks;
+			uint64 frameTicks;
+			uint64 maxFrameTicks;
+		};
+
+		/// accumulate the zones of the given profiler frame
+		void AccumulateZones(uint frame);
+		/// convert profiler ticks to milliseconds
+		static double TicksToMs(uint64 ticks);
+
+		Util::Dictionary<Util::String, Util::String> mInfo;
+		Util::Array<double> mFrameTimes;
+		Util::Dictionary<Util::String, IndexT> mZoneIndices;
+		Util::Array<ZoneStats> mZones;
+		Util::Array<Debug::ZoneProfiler::Event> mEvents;
+		uint64 mFrameBeginTicks;
+	};
+
+	//------------------------------------------------------------------------
+	inline
+	SizeT
+	FrameBenchmark::GetNumFrames() const
+	{
+		return mFrameTimes.Size();
+	}
+}
+
+#endif // __framebenchmark_H__
@@ -60,9 +60,11 @@ THE SOFTWARE.
 #include "memory/debug/memorypagehandler.h"
 #include "io/debug/consolepagehandler.h"
 #include "io/debug/iopagehandler.h"
+#include "resource/debug/resourcepagehandler.h"
 #endif
 
 #include "shadercompiler/ShaderFactory.h"
+#include "materialmaker/parser/GenesisShaderParser.h"
 
 namespace App
 {
@@ -198,6 +200,7 @@ GameApplication::Open()
 	this->mHttpServerProxy->AttachRequestHandler(Debug::MemoryPageHandler::Create());
 	this->mHttpServerProxy->AttachRequestHandler(Debug::ConsolePageHandler::Create());
 	this->mHttpServerProxy->AttachRequestHandler(Debug::IoPageHandler::Create());
+	this->mHttpServerProxy->AttachRequestHandler(Debug::ResourcePageHandler::Create());
 
 	// setup debug subsystem
 	this->mDebugInterface = DebugInterface::Create();
@@ -251,6 +254,15 @@ bool GameApplication::Start()
 	// start game world
 	this->mGameServer->Start();
 
+	// -cookshaders <dir>: write the shader cache entries of every .shader below dir for this render device
+	const Util::CommandLineArgs& args = this->GetCmdLineArgs();
+	if (args.HasArg("-cookshaders"))
+	{
+		Util::String dir = args.GetString("-cookshaders");
+		SizeT cooked = GenesisMaterialMaker::CookShaders(dir);
+		n_printf("cooked %d shaders from %s\n", cooked, dir.AsCharPtr());
+	}
+
 
 	// - execute root's load method
 #ifndef __SCRIPT_COMMIT__
@@ -650,6 +662,17 @@ GameApplication::setupProjectAssigns()
 	pAssignRegistry->SetAssign(IO::Assign("sys", "project:System"));
 	pAssignRegistry->SetAssign(IO::Assign("shd", "project:Shader"));
 	pAssignRegistry->SetAssign(IO::Assign("script", "project:Script"));
+	// files the engine writes at runtime (caches), the project itself may be read only (apk)
+#if __ANDROID__
+	if (mPackageName.IsValid())
+	{
+		pAssignRegistry->SetAssign(IO::Assign("user", "/data/data/" + mPackageName + "/files"));
+	}
+	else
+#endif
+	{
+		pAssignRegistry->SetAssign(IO::Assign("user", "project:User"));
+	}
 #ifdef __PROFILER__
 	pAssignRegistry->SetAssign(IO::Assign("profile", "project:Profile"));
 #endif
@@ -341,6 +341,8 @@ void
 GameServer::onFrame()
 {
     //_start_timer(mGameServerOnFrame);
+	PROFILER_NEXTFRAME();
+	PROFILER_ZONE("GameServer::OnFrame");
 	//OnBeginframe
 	PROFILER_RESETICKSTATS();
 	{
@@ -410,6 +412,13 @@ GameServer::onFrame()
 		{
 			mGameFeatures["Font"]->OnFrame();
 		}
+
+		// world transforms of everything moved this frame, before rendering reads them
+		if ( TransformSystem::HasInstance() )
+		{
+			TransformSystem::Instance()->Update();
+		}
+
 		if(_graphic)
 		{
 			mGameFeatures["Graphics"]->OnFrame();
@@ -0,0 +1,496 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "stdneb.h"
+#include "appframework/transformsystem.h"
+#include "appframework/actor.h"
+#include "profilesystem/ProfileSystem.h"
+#include "jobs/stdjob.h"
+#include "jobs/jobsystem.h"
+#include "jobs/jobport.h"
+#include "jobs/job.h"
+
+namespace App
+{
+	__ImplementClass(App::TransformSystem, 'TRSY', Core::RefCounted);
+	__ImplementThreadSingleton(App::TransformSystem);
+
+	// ranges larger than this are split below their root for the jobs
+	static const SizeT sSplitRangeSize = 512;
+	// about this many transforms per job slice
+	static const SizeT sTransformsPerBatch = 256;
+
+	struct TransformUpdateBatch
+	{
+		TransformSystem* system;
+		const TransformSystem::Range* ranges;
+		SizeT numRanges;
+	};
+	//------------------------------------------------------------------------
+	void TransformUpdateJobFunc(const JobFuncContext& ctx)
+	{
+		const TransformUpdateBatch* batches = (const TransformUpdateBatch*)ctx.inputs[0];
+		const SizeT count = ctx.inputSizes[0] / sizeof(TransformUpdateBatch);
+		for (IndexT i = 0; i < count; ++i)
+		{
+			const TransformUpdateBatch& batch = batches[i];
+			for (IndexT r = 0; r < batch.numRanges; ++r)
+			{
+				batch.system->_UpdateRange(batch.ranges[r].begin, batch.ranges[r].end);
+			}
+		}
+	}
+}
+__ImplementSpursJob(App::TransformUpdateJobFunc);
+
+namespace App
+{
+	//------------------------------------------------------------------------
+	TransformSystem::TransformSystem()
+		: mHierarchyDirty(false)
+		, mDeferMoveNotify(false)
+		, mParallelThreshold(2048)
+	{
+		__ConstructThreadSingleton;
+		Memory::Clear(&mStats, sizeof(mStats));
+	}
+	//------------------------------------------------------------------------
+	TransformSystem::~TransformSystem()
+	{
+		n_assert( mStats.actors == 0 );
+		__DestructThreadSingleton;
+	}
+	//------------------------------------------------------------------------
+	void
+	TransformSystem::Attach(Actor* actor)
+	{
+		n_assert( actor && actor->mTransformSlot == InvalidIndex );
+		IndexT slot;
+		if ( mFreeSlots.IsEmpty() )
+		{
+			slot = mSlotActors.Size();
+			mSlotActors.Append(actor);
+			mSlotOrder.Append(InvalidIndex);
+			if ( ( slot >> 5 ) >= mDirtyBits.Size() )
+			{
+				mDirtyBits.Append(0);
+			}
+		}
+		else
+		{
+			slot = mFreeSlots.Back();
+			mFreeSlots.EraseIndex(mFreeSlots.Size() - 1);
+			mSlotActors[slot] = actor;
+			mSlotOrder[slot] = InvalidIndex;
+		}
+		actor->mTransformSlot = slot;
+		mHierarchyDirty = true;
+		MarkDirty(slot);
+		++mStats.actors;
+	}
+	//------------------------------------------------------------------------
+	void
+	TransformSystem::Detach(Actor* actor)
+	{
+		n_assert( actor );
+		const IndexT slot = actor->mTransformSlot;
+		if ( InvalidIndex == slot )
+		{
+			return;
+		}
+		n_assert( mSlotActors[slot] == actor );
+		if ( InvalidIndex != mSlotOrder[slot] )
+		{
+			mOrderActors[mSlotOrder[slot]] = NULL;
+		}
+		// a stale entry may stay in mDirtySlots, it is skipped by the cleared bit
+		mDirtyBits[slot >> 5] &= ~( 1u << ( slot & 31 ) );
+		mSlotActors[slot] = NULL;
+		mSlotOrder[slot] = InvalidIndex;
+		mFreeSlots.Append(slot);
+
+		actor->mTransformSlot = InvalidIndex;
+		actor->mMovePending = false;
+		mHierarchyDirty = true;
+		--mStats.actors;
+	}
+	//------------------------------------------------------------------------
+	void
+	TransformSystem::ResetStats()
+	{
+		const SizeT actors = mStats.actors;
+		Memory::Clear(&mStats, sizeof(mStats));
+		mStats.actors = actors;
+	}
+	//------------------------------------------------------------------------
+	void
+	TransformSystem::_RebuildOrder()
+	{
+		// fresh world entries are carried over to the new order
+		const Util::Array<IndexT> oldSlotOrder(mSlotOrder);
+		const Util::Array<Math::matrix44> oldWorld(mOrderWorld);
+		const Util::Array<Math::vector> oldWorldPos(mOrderWorldPos);
+		const Util::Array<Math::quaternion> oldWorldRot(mOrderWorldRot);
+		const Util::Array<Math::vector> oldWorldScale(mOrderWorldScale);
+		const Util::Array<ubyte> oldFlags(mOrderFlags);
+
+		mOrderActors.Reset();
+		mOrderSlots.Reset();
+		mOrderParents.Reset();
+		mOrderEnds.Reset();
+
+		// an actor whose parent is not attached starts a tree of its own
+		const SizeT numSlots = mSlotActors.Size();
+		for ( IndexT slot = 0; slot < numSlots; ++slot )
+		{
+			Actor* actor = mSlotActors[slot];
+			if ( actor && ( NULL == actor->mParent || InvalidIndex == actor->mParent->mTransformSlot ) )
+			{
+				_AppendSubtree(actor, InvalidIndex);
+			}
+		}
+		const SizeT count = mOrderActors.Size();
+		n_assert( count == mStats.actors );
+		mOrderLocalPos.Resize(count, Math::vector::nullvec());
+		mOrderLocalRot.Resize(count, Math::quaternion::identity());
+		mOrderLocalScale.Resize(count, Math::vector::nullvec());
+		mOrderWorld.Resize(count, Math::matrix44::identity());
+		mOrderWorldPos.Resize(count, Math::vector::nullvec());
+		mOrderWorldRot.Resize(count, Math::quaternion::identity());
+		mOrderWorldScale.Resize(count, Math::vector::nullvec());
+		mOrderFlags.Resize(count, 0);
+
+		// the local TRS is taken from the actors, the world from the old order or a clean actor
+		for ( IndexT i = 0; i < count; ++i )
+		{
+			const Actor* actor = mOrderActors[i];
+			mOrderLocalPos[i] = actor->mLocalPosition;
+			mOrderLocalRot[i] = actor->mLocalRotation;
+			mOrderLocalScale[i] = actor->mLocalScale;
+			mOrderFlags[i] = 0;
+
+			const IndexT old = oldSlotOrder[mOrderSlots[i]];
+			if ( InvalidIndex != old && ( oldFlags[old] & EntryFresh ) )
+			{
+				mOrderWorld[i] = oldWorld[old];
+				mOrderWorldPos[i] = oldWorldPos[old];
+				mOrderWorldRot[i] = oldWorldRot[old];
+				mOrderWorldScale[i] = oldWorldScale[old];
+				mOrderFlags[i] = EntryFresh;
+			}
+			else if ( !actor->mDirtyWorldTrans )
+			{
+				_StoreWorld(i, actor);
+			}
+		}
+		mHierarchyDirty = false;
+		++mStats.rebuilds;
+	}
+	//------------------------------------------------------------------------
+	void
+	TransformSystem::_AppendSubtree(Actor* actor, IndexT parent)
+	{
+		const IndexT index = mOrderActors.Size();
+		mOrderActors.Append(actor);
+		mOrderSlots.Append(actor->mTransformSlot);
+		mOrderParents.Append(parent);
+		mOrderEnds.Append(index + 1);
+		mSlotOrder[actor->mTransformSlot] = index;
+
+		const SizeT numChildren = actor->mChildren.Size();
+		for ( IndexT i = 0; i < numChildren; ++i )
+		{
+			Actor* child = actor->mChildren[i].get();
+			if ( InvalidIndex != child->mTransformSlot )
+			{
+				_AppendSubtree(child, index);
+			}
+		}
+		mOrderEnds[index] = mOrderActors.Size();
+	}
+	//------------------------------------------------------------------------
+	void
+	TransformSystem::_CollectRanges()
+	{
+		mDirtyOrder.Reset();
+		const SizeT numDirty = mDirtySlots.Size();
+		for ( IndexT i = 0; i < numDirty; ++i )
+		{
+			const IndexT slot = mDirtySlots[i];
+			uint& bits = mDirtyBits[slot >> 5];
+			const uint bit = 1u << ( slot & 31 );
+			if ( bits & bit )
+			{
+				bits &= ~bit;
+				const IndexT index = mSlotOrder[slot];
+				mDirtyOrder.Append(index);
+
+				// the only place the update reads an actor: the local TRS of a changed one, and its world if
+				// it was given (SetWorldTransform) or recomputed since the change
+				const Actor* actor = mSlotActors[slot];
+				mOrderLocalPos[index] = actor->mLocalPosition;
+				mOrderLocalRot[index] = actor->mLocalRotation;
+				mOrderLocalScale[index] = actor->mLocalScale;
+				mOrderFlags[index] &= ~EntryFresh;
+				if ( !actor->mDirtyWorldTrans )
+				{
+					_StoreWorld(index, actor);
+					mOrderFlags[index] |= EntryKeep;
+				}
+			}
+		}
+		mDirtySlots.Reset();
+		mDirtyOrder.Sort();
+
+		// a marked actor inside a range is covered by it
+		mRanges.Reset();
+		const SizeT numOrder = mDirtyOrder.Size();
+		for ( IndexT i = 0; i < numOrder; ++i )
+		{
+			const IndexT index = mDirtyOrder[i];
+			if ( mRanges.IsEmpty() || index >= mRanges.Back().end )
+			{
+				Range range;
+				range.begin = index;
+				range.end = mOrderEnds[index];
+				mRanges.Append(range);
+			}
+		}
+	}
+	//------------------------------------------------------------------------
+	void
+	TransformSystem::Update()
+	{
+		PROFILER_ZONE("TransformSystem::Update");
+		if ( mHierarchyDirty )
+		{
+			_RebuildOrder();
+		}
+		_CollectRanges();
+
+		mStats.ranges = mRanges.Size();
+		mStats.updated = 0;
+		mStats.moveNotifies = 0;
+		if ( mRanges.IsEmpty() )
+		{
+			return;
+		}
+
+		// the parent of a range root is outside every range, its entry must be fresh before the ranges
+		// run in parallel. a root whose parent is not attached takes the world from the parent actor
+		const SizeT numRanges = mRanges.Size();
+		for ( IndexT i = 0; i < numRanges; ++i )
+		{
+			const Range& range = mRanges[i];
+			const IndexT parent = mOrderParents[range.begin];
+			if ( InvalidIndex != parent )
+			{
+				if ( 0 == ( mOrderFlags[parent] & EntryFresh ) )
+				{
+					const Actor* actor = mOrderActors[parent];
+					actor->_UpdateWolrdTransform();
+					_StoreWorld(parent, actor);
+				}
+			}
+			else if ( mOrderActors[range.begin]->mParent && 0 == ( mOrderFlags[range.begin] & EntryKeep ) )
+			{
+				_ComputeEntry(range.begin, &mOrderActors[range.begin]->mParent->GetWorldTransform());
+				mOrderFlags[range.begin] |= EntryKeep;
+			}
+			mStats.updated += range.end - range.begin;
+		}
+
+		if ( !Jobs::JobSystem::HasInstance() || mStats.updated < mParallelThreshold )
+		{
+			for ( IndexT i = 0; i < numRanges; ++i )
+			{
+				_UpdateRange(mRanges[i].begin, mRanges[i].end);
+			}
+		}
+		else
+		{
+			// the subtrees below the root of a large range are independent as well
+			mJobRanges.Reset();
+			for ( IndexT i = 0; i < numRanges; ++i )
+			{
+				const Range& range = mRanges[i];
+				if ( range.end - range.begin <= sSplitRangeSize )
+				{
+					mJobRanges.Append(range);
+					continue;
+				}
+				_UpdateRange(range.begin, range.begin + 1);
+				for ( IndexT child = range.begin + 1; child < range.end; child = mOrderEnds[child] )
+				{
+					Range sub;
+					sub.begin = child;
+					sub.end = mOrderEnds[child];
+					mJobRanges.Append(sub);
+				}
+			}
+
+			// consecutive ranges batched into slices of about sTransformsPerBatch transforms
+			Util::Array<TransformUpdateBatch> batches;
+			TransformUpdateBatch batch;
+			batch.system = this;
+			batch.ranges = &mJobRanges[0];
+			batch.numRanges = 0;
+			SizeT batchSize = 0;
+			const SizeT numJobRanges = mJobRanges.Size();
+			for ( IndexT i = 0; i < numJobRanges; ++i )
+			{
+				++batch.numRanges;
+				batchSize += mJobRanges[i].end - mJobRanges[i].begin;
+				if ( batchSize >= sTransformsPerBatch || i == numJobRanges - 1 )
+				{
+					batches.Append(batch);
+					batch.ranges = &mJobRanges[0] + i + 1;
+					batch.numRanges = 0;
+					batchSize = 0;
+				}
+			}
+
+			Jobs::JobFuncDesc jobFunction(TransformUpdateJobFunc);
+			Jobs::JobUniformDesc uniformData(&batches[0], sizeof(TransformUpdateBatch), 0);
+			Jobs::JobDataDesc inputData(&batches[0], batches.Size() * sizeof(TransformUpdateBatch), sizeof(TransformUpdateBatch));
+			Jobs::JobDataDesc outputData(&batches[0], batches.Size() * sizeof(TransformUpdateBatch), sizeof(TransformUpdateBatch));
+
+			GPtr<Jobs::Job> job = Jobs::Job::Create();
+			job->Setup(uniformData, inputData, outputData, jobFunction);
+			GPtr<Jobs::JobPort> jobPort = Jobs::JobPort::Create();
+			jobPort->Setup();
+			jobPort->PushJob(job);
+			jobPort->WaitDone();
+			jobPort->Discard();
+		}
+
+		_NotifyMoved();
+	}
+	//------------------------------------------------------------------------
+	void
+	TransformSystem::_UpdateRange(IndexT begin, IndexT end)
+	{
+		// parents are in front of their children, so the parent entry is always computed already
+		for ( IndexT i = begin; i < end; ++i )
+		{
+			ubyte& flags = mOrderFlags[i];
+			if ( 0 == ( flags & EntryKeep ) )
+			{
+				const IndexT parent = mOrderParents[i];
+				_ComputeEntry(i, InvalidIndex != parent ? &mOrderWorld[parent] : NULL);
+			}
+			flags = EntryFresh;
+		}
+	}
+	//------------------------------------------------------------------------
+	void
+	TransformSystem::_ComputeEntry(IndexT index, const Math::matrix44* parentWorld)
+	{
+		ComputeWorld(parentWorld, mOrderLocalPos[index], mOrderLocalRot[index], mOrderLocalScale[index],
+			mOrderWorld[index], mOrderWorldPos[index], mOrderWorldRot[index], mOrderWorldScale[index]);
+	}
+	//------------------------------------------------------------------------
+	void
+	TransformSystem::_StoreWorld(IndexT index, const Actor* actor)
+	{
+		mOrderWorld[index] = actor->mWorldTrans;
+		mOrderWorldPos[index] = actor->mWorldPosition;
+		mOrderWorldRot[index] = actor->mWorldRotation;
+		mOrderWorldScale[index] = actor->mWorldScale;
+		mOrderFlags[index] |= EntryFresh;
+	}
+	//------------------------------------------------------------------------
+	bool
+	TransformSystem::_FetchWorld(IndexT slot, Math::matrix44& world, Math::vector& pos, Math::quaternion& rot, Math::vector& scale) const
+	{
+		if ( mHierarchyDirty )
+		{
+			return false;
+		}
+		const IndexT index = mSlotOrder[slot];
+		if ( InvalidIndex == index || 0 == ( mOrderFlags[index] & EntryFresh ) )
+		{
+			return false;
+		}
+		// a change marked on the actor or one of its parents since the entry was computed
+		if ( !mDirtySlots.IsEmpty() )
+		{
+			for ( IndexT i = index; InvalidIndex != i; i = mOrderParents[i] )
+			{
+				const IndexT s = mOrderSlots[i];
+				if ( mDirtyBits[s >> 5] & ( 1u << ( s & 31 ) ) )
+				{
+					return false;
+				}
+			}
+		}
+		world = mOrderWorld[index];
+		pos = mOrderWorldPos[index];
+		rot = mOrderWorldRot[index];
+		scale = mOrderWorldScale[index];
+		return true;
+	}
+	//------------------------------------------------------------------------
+	void
+	TransformSystem::ComputeWorld(const Math::matrix44* parentWorld, const Math::vector& localPos, const Math::quaternion& localRot, 
+		const Math::vector& localScale, Math::matrix44& world, Math::vector& pos, Math::quaternion& rot, Math::vector& scale)
+	{
+		if ( parentWorld )
+		{
+			const Math::matrix44 own = Math::matrix44::transformation(localScale, localRot, localPos);
+			world = Math::matrix44::multiply(*parentWorld, own);
+			world.setrow3( Math::float4(0.0f,0.0f,0.0f,1.0f) );
+			world.decompose(scale, rot, pos);
+		}
+		else
+		{
+			// root node, no parent
+			rot = localRot;
+			pos = localPos;
+			scale = localScale;
+			world = Math::matrix44::transformation(scale, rot, pos);
+		}
+	}
+	//------------------------------------------------------------------------
+	void
+	TransformSystem::_NotifyMoved()
+	{
+		// parents before children, like Actor::OnMoveAfter. A callback may move or detach actors again:
+		// moved ones are marked for the next update, detached ones are cleared from the order
+		const SizeT numRanges = mRanges.Size();
+		for ( IndexT r = 0; r < numRanges; ++r )
+		{
+			const IndexT end = mRanges[r].end;
+			for ( IndexT i = mRanges[r].begin; i < end; ++i )
+			{
+				Actor* actor = mOrderActors[i];
+				if ( actor && actor->mMovePending )
+				{
+					actor->mMovePending = false;
+					actor->_SendMoveAfter();
+					++mStats.moveNotifies;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,213 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __transformsystem_H__
+#define __transformsystem_H__
+
+#include "core/refcounted.h"
+#include "core/singleton.h"
+#include "util/array.h"
+#include "math/matrix44.h"
+#include "math/vector.h"
+#include "math/quaternion.h"
+
+//------------------------------------------------------------------------------
+namespace App
+{
+	class Actor;
+
+	struct TransformStats
+	{
+		SizeT actors;			// attached actors
+		SizeT rebuilds;			// hierarchy order rebuilds since the last reset
+		SizeT ranges;			// dirty subtrees updated by the last Update()
+		SizeT updated;			// world transforms recomputed by the last Update()
+		SizeT moveNotifies;		// deferred OnMoveAfter calls sent by the last Update()
+	};
+
+	/**
+		World transforms of the active actors.
+
+		Every active actor owns a slot (see Actor::OnActivate). The attached actors are kept in depth
+		first order, so each subtree is one contiguous range with a parent in front of its children,
+		and parents are stored as order indices. The local TRS, the world matrix and the world TRS of
+		every actor live in flat arrays in that order. A transform change marks the actor's slot in a
+		bit set instead of walking pointers. Once per frame, Update() sorts the marked slots, copies
+		their local TRS in, merges them into disjoint subtree ranges and recomputes each range front to
+		back from the arrays alone, the actors are not touched. Disjoint ranges are independent and go
+		to the job system when there is enough work.
+
+		An actor reads its world transform back through its slot (_FetchWorld) while the entry is
+		fresh, that is computed by an Update() with no change marked on the actor or its parents since.
+		Otherwise the actor falls back to its lazy getters, so a transform read between two updates is
+		still correct.
+
+		SetDeferMoveNotify(true) batches the move callbacks too: an active actor sends OnMoveBefore
+		at its first change in a frame and OnMoveAfter once from Update(), so components see each
+		moved actor once per frame instead of after every setter.
+	*/
+	class TransformSystem : public Core::RefCounted
+	{
+		__DeclareClass(TransformSystem);
+		__DeclareThreadSingleton(TransformSystem);
+	public:
+		TransformSystem();
+		virtual ~TransformSystem();
+
+		/// add an actor, called when the actor is activated
+		void Attach(Actor* actor);
+		/// remove an actor, called when the actor is deactivated
+		void Detach(Actor* actor);
+		/// the parent of an attached actor changed
+		void MarkHierarchyDirty();
+		/// the world transform of an attached actor and its children changed
+		void MarkDirty(IndexT slot);
+
+		/// recompute the world transforms of the dirty subtrees, called once per frame
+		void Update();
+
+		/// batch OnMoveAfter of active actors to Update()
+		void SetDeferMoveNotify(bool defer);
+		bool IsDeferMoveNotify() const;
+
+		/// an Update() recomputing at least this many transforms uses the job system
+		void SetParallelThreshold(SizeT count);
+		SizeT GetParallelThreshold() const;
+
+		const TransformStats& GetStats() const;
+		void ResetStats();
+
+		/// recompute the order range [begin, end), called from the update jobs
+		void _UpdateRange(IndexT begin, IndexT end);
+		/// copy the world transform of a slot if it is fresh, returns false otherwise
+		bool _FetchWorld(IndexT slot, Math::matrix44& world, Math::vector& pos, Math::quaternion& rot, Math::vector& scale) const;
+
+		/// the world math shared by the update and the actor's lazy getters, NULL parentWorld for a root
+		static void ComputeWorld(const Math::matrix44* parentWorld, const Math::vector& localPos, const Math::quaternion& localRot, 
+			const Math::vector& localScale, Math::matrix44& world, Math::vector& pos, Math::quaternion& rot, Math::vector& scale);
+
+		struct Range
+		{
+			IndexT begin;
+			IndexT end;
+		};
+	private:
+		/// depth first order of the attached actors
+		void _RebuildOrder();
+		void _AppendSubtree(Actor* actor, IndexT parent);
+		/// merge the marked slots into disjoint subtree ranges
+		void _CollectRanges();
+		void _NotifyMoved();
+		/// recompute one order entry from its local TRS
+		void _ComputeEntry(IndexT index, const Math::matrix44* parentWorld);
+		/// copy the world transform of an actor into its order entry
+		void _StoreWorld(IndexT index, const Actor* actor);
+
+		enum EntryFlags
+		{
+			EntryFresh = 1 << 0,	// the world of the entry is up to date
+			EntryKeep = 1 << 1,		// the world was given, the next range update keeps it
+		};
+
+		// slots, stable while an actor is attached
+		Util::Array<Actor*> mSlotActors;
+		Util::Array<IndexT> mSlotOrder;			// order index of a slot, InvalidIndex until the next rebuild
+		Util::Array<IndexT> mFreeSlots;
+		Util::Array<uint> mDirtyBits;			// one bit per slot
+		Util::Array<IndexT> mDirtySlots;
+
+		// depth first order, rebuilt when the hierarchy changed
+		Util::Array<Actor*> mOrderActors;		// only used to build the order and for the callbacks
+		Util::Array<IndexT> mOrderSlots;
+		Util::Array<IndexT> mOrderParents;		// InvalidIndex for roots
+		Util::Array<IndexT> mOrderEnds;			// one past the last descendant
+		Util::Array<Math::vector> mOrderLocalPos;
+		Util::Array<Math::quaternion> mOrderLocalRot;
+		Util::Array<Math::vector> mOrderLocalScale;
+		Util::Array<Math::matrix44> mOrderWorld;
+		Util::Array<Math::vector> mOrderWorldPos;
+		Util::Array<Math::quaternion> mOrderWorldRot;
+		Util::Array<Math::vector> mOrderWorldScale;
+		Util::Array<ubyte> mOrderFlags;			// EntryFlags
+
+		Util::Array<Range> mRanges;
+		Util::Array<Range> mJobRanges;
+		Util::Array<IndexT> mDirtyOrder;
+
+		bool mHierarchyDirty;
+		bool mDeferMoveNotify;
+		SizeT mParallelThreshold;
+		TransformStats mStats;
+	};
+	//------------------------------------------------------------------------
+	inline void
+	TransformSystem::MarkHierarchyDirty()
+	{
+		mHierarchyDirty = true;
+	}
+	//------------------------------------------------------------------------
+	inline void
+	TransformSystem::MarkDirty(IndexT slot)
+	{
+		n_assert( slot >= 0 && slot < mSlotActors.Size() );
+		uint& bits = mDirtyBits[slot >> 5];
+		const uint bit = 1u << ( slot & 31 );
+		if ( ( bits & bit ) == 0 )
+		{
+			bits |= bit;
+			mDirtySlots.Append(slot);
+		}
+	}
+	//------------------------------------------------------------------------
+	inline void
+	TransformSystem::SetDeferMoveNotify(bool defer)
+	{
+		mDeferMoveNotify = defer;
+	}
+	//------------------------------------------------------------------------
+	inline bool
+	TransformSystem::IsDeferMoveNotify() const
+	{
+		return mDeferMoveNotify;
+	}
+	//------------------------------------------------------------------------
+	inline void
+	TransformSystem::SetParallelThreshold(SizeT count)
+	{
+		mParallelThreshold = count;
+	}
+	//------------------------------------------------------------------------
+	inline SizeT
+	TransformSystem::GetParallelThreshold() const
+	{
+		return mParallelThreshold;
+	}
+	//------------------------------------------------------------------------
+	inline const TransformStats&
+	TransformSystem::GetStats() const
+	{
+		return mStats;
+	}
+}
+
+#endif // __transformsystem_H__
@@ -43,6 +43,7 @@ using namespace Math;
 TimeManager::TimeManager() :                                           
     mLastRealTime(0)  
 	, mFrameIndex(0)
+	, mFixedFrameTime(0)
 {                                              
     __ConstructImageSingleton;                     
 }
@@ -227,6 +228,9 @@ TimeManager::OnFrame()
     by the current application state handler. This will get the current frame time
     and call UpdateTime() on all attached time sources.
 
+    If a fixed frame time is set, the time sources advance by exactly that amount
+    regardless of the real time passed, so a frame sequence is reproducible.
+
     FIXME:
     * properly handle time exceptions!!!
 */
@@ -238,6 +242,10 @@ TimeManager::Update()
 	Timing::Time curTime = this->mTimer.GetTime();
 
     Timing::Time frameTime = curTime - this->mLastRealTime;           
+	if (this->mFixedFrameTime > 0.0)
+	{
+		frameTime = this->mFixedFrameTime;
+	}
 
     IndexT i;
     for (i = 0; i < this->mTimeSourceArray.Size(); i++)
@@ -61,6 +61,10 @@ namespace App
 
 		/// get frame index
 		IndexT GetFrameIndex(void) const;
+		/// set a fixed frame time, time sources then advance by exactly this amount per frame (0 = use real time)
+		void SetFixedFrameTime(Timing::Time t);
+		/// get the fixed frame time (0 if real time is used)
+		Timing::Time GetFixedFrameTime(void) const;
 
 		/// attach a time source
 		void AttachTimeSource(const GPtr<TimeSource>& timeSource);
@@ -80,6 +84,7 @@ namespace App
 
 		IndexT mFrameIndex;
 		Timing::Time mLastRealTime;
+		Timing::Time mFixedFrameTime;
 		Timing::Timer mTimer;
 	
 		Util::Array<GPtr<TimeSource> > mTimeSourceArray;
@@ -93,6 +98,23 @@ namespace App
 		return mFrameIndex;
 	}
 
+	//------------------------------------------------------------------------
+	inline
+	void
+	TimeManager::SetFixedFrameTime(Timing::Time t)
+	{
+		n_assert(t >= 0.0);
+		mFixedFrameTime = t;
+	}
+
+	//------------------------------------------------------------------------
+	inline
+	Timing::Time
+	TimeManager::GetFixedFrameTime(void) const
+	{
+		return mFixedFrameTime;
+	}
+
 } // namespace BaseGameFeature
 
 //------------------------------------------------------------------------------
@@ -362,6 +362,25 @@ namespace App
 				AddDefaultAttachedActor();
 			}
 		}
+
+		UpdateAnimationLod();
+	}
+
+	void AnimationComponent::UpdateAnimationLod()
+	{
+		if (!m_Animation.isvalid() || !AnimationServer::HasInstance())
+		{
+			return;
+		}
+
+		const AnimationServer* server = AnimationServer::Instance();
+		int interval = 1;
+		if (server->IsLodEnabled() && m_Animation->GetClientCount() > 0)
+		{
+			interval = server->GetUpdateInterval(mActor->GetWorldPosition());
+		}
+		m_Animation->SetUpdateInterval(interval);
+		m_Animation->SetInterpolateSkipped(server->IsLodInterpolation());
 	}
 
 	void AnimationComponent::_OnEndFrame()
@@ -739,6 +758,7 @@ namespace App
 
 	void AnimationComponent::ForceUpdate()
 	{
+		m_Animation->RequestSample();
 		m_Animation->UpdateAnimation((float)GameTime::Instance()->GetFrameTime());
 	}
 
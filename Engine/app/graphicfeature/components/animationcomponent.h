@@ -288,6 +288,9 @@ namespace App
 		bool FindUsedBones(const GPtr<AnimationClip>& clip, const GPtr<SkeletonRes>& skelteon, const GPtr<Actor>& pActor);
 		bool ReFindUsedBones(const GPtr<Actor>& pActor);
 
+		/// pick the sample rate of the animation from the distance to the lod view position
+		void UpdateAnimationLod();
+
 
 	public:
 		bool HasBuildDefaultToRootX();
@@ -110,6 +110,48 @@ namespace App
 		}
 	}
 
+	bool MeshRenderObject::GetInstanceInfo(const Graphic::Renderable* renderable, Graphic::RenderPassType passType, const Graphic::Material* customizedMaterial, Graphic::InstanceInfo& info)
+	{
+		n_assert(NULL != renderable);
+		n_assert(mOwner);
+
+		const RenderBase::PrimitiveHandle& priHandle = getOwner()->GetPrimitiveHandle();
+		// lightmap textures and params are per object
+		if (!priHandle.IsValid() || (IsUseLM() && IsLMHandleValid()))
+		{
+			return false;
+		}
+
+		const Graphic::Material* material = (NULL == customizedMaterial) ? renderable->GetMaterial() : customizedMaterial;
+		int passindex = (eCustomized == passType) ? 0 : passType -1;
+		const Util::Array< GPtr<MaterialPass> >& passList = material->GetTech()->GetPassList();
+		if (passindex >= passList.Size())
+		{
+			return false;
+		}
+		const GPtr<MaterialPass>& pass = passList[passindex];
+		if ( pass->isGlobalParamUsed( eGShaderMatInverseM ) || pass->isGlobalParamUsed( eGShaderMatInverseTransposeM ) )
+		{
+			return false;
+		}
+
+		const RenderableType* rd = renderable->cast_fast<RenderableType>();
+		if (rd->GetNumVertex() <= 0 || rd->GetNumIndex() <= 0)
+		{
+			return false;
+		}
+
+		info.surType = (passType && material->GetTech()->IsTemplateTech()) ? passType : eForward;
+		info.primHandle = priHandle;
+		info.firstVertex = rd->GetFirstVertix();
+		info.numVertex = rd->GetNumVertex();
+		info.firstIndex = rd->GetFirstIndex();
+		info.numIndex = rd->GetNumIndex();
+		info.data.world = GetTransform();
+		info.data.param = float4(this->GetReceiveShadow() ? 1.0f : 0.0f, 0.0f, 0.0f, 0.0f);
+		return true;
+	}
+
 	const Util::StringAtom& MeshRenderObject::GetMeshName() const
 	{
 		return getOwner()->GetMeshID();
@@ -42,6 +42,7 @@ namespace App
 		virtual ~MeshRenderObject();
 		const Util::StringAtom& GetMeshName() const;
 		virtual void Render(const Graphic::Renderable* renderable, Graphic::RenderPassType passType, const Graphic::Material* customizedMaterial);
+		virtual bool GetInstanceInfo(const Graphic::Renderable* renderable, Graphic::RenderPassType passType, const Graphic::Material* customizedMaterial, Graphic::InstanceInfo& info);
 
 		virtual bool IsUseLM() const;
 		virtual bool IsLightmapHandleValid() const;
@@ -0,0 +1,127 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "stdneb.h"
+#include "graphicfeature/components/occludercomponent.h"
+#include "appframework/actor.h"
+#include "graphicsystem/Vision/RenderScene.h"
+
+namespace App
+{
+	__ImplementClass(App::OccluderComponent, 'OCLC', App::Component);
+
+	OccluderComponent::OccluderComponent()
+		: mBox(Math::point(0.0f, 0.0f, 0.0f), Math::vector(0.5f, 0.5f, 0.5f))
+		, mRenderScene(NULL)
+	{
+		mOccluder = Vis::Occluder::Create();
+		mOccluder->SetupBox(mBox);
+	}
+
+	OccluderComponent::~OccluderComponent()
+	{
+		_Detach();
+		mOccluder = NULL;
+	}
+
+	void OccluderComponent::OnActivate()
+	{
+		Super::OnActivate();
+		n_assert(mActor);
+		mOccluder->SetTransform(mActor->GetWorldTransform());
+		_Attach();
+	}
+
+	void OccluderComponent::OnDeactivate()
+	{
+		_Detach();
+		Super::OnDeactivate();
+	}
+
+	void OccluderComponent::OnRenderSceneChanged()
+	{
+		_Detach();
+		if (IsActive())
+		{
+			_Attach();
+		}
+	}
+
+	void OccluderComponent::SetupCallbacks()
+	{
+		mActor->RegisterComponentCallback(this, MoveAfter);
+		Super::SetupCallbacks();
+	}
+
+	void OccluderComponent::_OnMoveAfter()
+	{
+		if (mActor)
+		{
+			mOccluder->SetTransform(mActor->GetWorldTransform());
+		}
+	}
+
+	void OccluderComponent::SetBox(const Math::bbox& box)
+	{
+		mBox = box;
+		mOccluder->SetupBox(box);
+	}
+
+	void OccluderComponent::SetOccluderEnabled(bool enabled)
+	{
+		mOccluder->SetEnabled(enabled);
+	}
+
+	void OccluderComponent::_Attach()
+	{
+		n_assert(NULL == mRenderScene);
+		if (mActor && mActor->GetRenderScene())
+		{
+			mRenderScene = mActor->GetRenderScene();
+			mRenderScene->AttachOccluder(mOccluder);
+		}
+	}
+
+	void OccluderComponent::_Detach()
+	{
+		if (mRenderScene)
+		{
+			mRenderScene->RemoveOccluder(mOccluder);
+			mRenderScene = NULL;
+		}
+	}
+
+	void OccluderComponent::CopyFrom( const GPtr<Component>& pComponent )
+	{
+		if( !pComponent.isvalid()  )
+			return;
+		if( !pComponent->GetRtti()->IsDerivedFrom( *(this->GetRtti()) ) )
+			return;
+
+		GPtr<OccluderComponent> pSource = pComponent.downcast<OccluderComponent>();
+		n_assert(pSource.isvalid());
+
+		SetBox(pSource->GetBox());
+		SetOccluderEnabled(pSource->IsOccluderEnabled());
+	}
+}
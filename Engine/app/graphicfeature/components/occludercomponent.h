@@ -0,0 +1,116 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __OCCLUDERCOMPONENT_H__
+#define __OCCLUDERCOMPONENT_H__
+
+#include "appframework/component.h"
+#include "vis/occluder.h"
+#include "math/bbox.h"
+
+namespace Graphic
+{
+	class RenderScene;
+}
+
+namespace App
+{
+	/**
+		Registers a box occluder with the render scene of its actor. The box is given in
+		actor space and follows the actor's world transform, the cameras of the scene
+		cull the render objects it hides. Place it inside the visible geometry of the
+		actor (a wall, a building), see Vis::Occluder.
+	*/
+	class OccluderComponent : public App::Component
+	{
+		__DeclareSubClass(OccluderComponent, App::Component);
+	public:
+		OccluderComponent();
+		virtual ~OccluderComponent();
+
+		/// @Component::OnActivate  called from Actor::ActivateComponents()
+		virtual void OnActivate();
+
+		/// @Component::OnDeactivate called from Actor::DeactivateComponents()
+		virtual void OnDeactivate();
+
+		/// @Component::OnRenderSceneChanged move the occluder to the new scene of the actor
+		virtual void OnRenderSceneChanged();
+
+		/// @Component::SetupCallbacks setup callbacks for this component, call by Actor in OnActivate()
+		virtual void SetupCallbacks();
+
+		/// called after the actor moved
+		virtual void _OnMoveAfter();
+
+		/// set the occluding box, in actor space
+		void SetBox(const Math::bbox& box);
+		/// get the occluding box
+		const Math::bbox& GetBox() const;
+
+		/// enable or disable occlusion by this actor
+		void SetOccluderEnabled(bool enabled);
+		/// is occlusion enabled
+		bool IsOccluderEnabled() const;
+
+		const GPtr<Vis::Occluder>& GetOccluder() const;
+
+	public:	//	Serialization
+		// @ISerialization::GetVersion. when change storage, must add SerializeVersion count
+		virtual Version GetVersion() const;
+
+		// @ISerialization::Load 
+		virtual void Load( Version ver, AppReader* pReader, const Serialization::SerializationArgs* args );
+
+		// @ISerialization::Save
+		virtual void Save( AppWriter* pWriter ) const;
+
+		// copy from other component
+		virtual void CopyFrom( const GPtr<Component>& pComponent );
+
+	private:
+		void _Attach();
+		void _Detach();
+
+		GPtr<Vis::Occluder> mOccluder;
+		Math::bbox mBox;
+		Graphic::RenderScene* mRenderScene;	//	the scene the occluder is attached to
+	};
+
+	inline const Math::bbox& OccluderComponent::GetBox() const
+	{
+		return mBox;
+	}
+
+	inline bool OccluderComponent::IsOccluderEnabled() const
+	{
+		return mOccluder->IsEnabled();
+	}
+
+	inline const GPtr<Vis::Occluder>& OccluderComponent::GetOccluder() const
+	{
+		return mOccluder;
+	}
+}
+
+#endif //__OCCLUDERCOMPONENT_H__
@@ -0,0 +1,103 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "stdneb.h"
+#include "graphicfeature/components/occludercomponent.h"
+
+namespace App
+{
+	class OccluderComponentSerialization
+	{
+	public:
+		OccluderComponentSerialization(OccluderComponent* pComponent);
+		~OccluderComponentSerialization();
+
+	public:
+		void Load(Version ver, AppReader* pReader, const Serialization::SerializationArgs* args);
+		void Load_1(AppReader* pReader, const Serialization::SerializationArgs* args);
+		void Save(AppWriter* pWriter) const;
+
+	protected:
+		OccluderComponent* m_Object;
+	};
+
+	const char* s_OccluderBox     = "OccluderBox";
+	const char* s_OccluderEnabled = "OccluderEnabled";
+
+	OccluderComponentSerialization::OccluderComponentSerialization(OccluderComponent* pComponent)
+		: m_Object(pComponent)
+	{
+
+	}
+
+	OccluderComponentSerialization::~OccluderComponentSerialization()
+	{
+
+	}
+
+	void OccluderComponentSerialization::Load(Version ver, AppReader *pReader, const Serialization::SerializationArgs* args)
+	{
+		if (ver == 1)
+		{
+			Load_1(pReader, args);
+		}
+		else
+			n_error(" OccluderComponentSerialization::Load unknown version " );
+	}
+
+	void OccluderComponentSerialization::Load_1(AppReader* pReader, const Serialization::SerializationArgs* args)
+	{
+		Math::bbox box;
+		pReader->SerializeBBox(s_OccluderBox, box);
+		m_Object->SetBox(box);
+
+		bool enabled = true;
+		pReader->SerializeBool(s_OccluderEnabled, enabled);
+		m_Object->SetOccluderEnabled(enabled);
+	}
+
+	void OccluderComponentSerialization::Save(AppWriter* pWriter) const
+	{
+		pWriter->SerializeBBox(s_OccluderBox, m_Object->GetBox());
+		pWriter->SerializeBool(s_OccluderEnabled, m_Object->IsOccluderEnabled());
+	}
+
+	Version OccluderComponent::GetVersion() const
+	{
+		return 1;
+	}
+
+	void OccluderComponent::Load( Version ver, AppReader* pReader, const Serialization::SerializationArgs* args )
+	{
+		pReader->SerializeSuper<Super>(this, args);
+		OccluderComponentSerialization Serialize(this);
+		Serialize.Load(ver, pReader, args);
+	}
+
+	void OccluderComponent::Save( AppWriter* pWriter ) const
+	{
+		pWriter->SerializeSuper<Super>(this);
+		OccluderComponentSerialization Serialize(const_cast<OccluderComponent*>(this));
+		Serialize.Save(pWriter);
+	}
+}
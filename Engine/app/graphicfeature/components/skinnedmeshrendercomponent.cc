@@ -38,6 +38,7 @@ THE SOFTWARE.
 #include "util/stl.h"
 
 #include "graphicsystem/GraphicObjectManager.h"
+#include "jobs/jobsystem.h"
 
 #define MaxSupportedBones 60
 
@@ -50,16 +51,26 @@ namespace App
 	using namespace RenderBase;
 	using namespace Graphic;
 	const Math::matrix44 SkinnedMeshRenderComponent::m_IndentityMatrix;
+	bool SkinnedMeshRenderComponent::s_ForceSoftwareSkinning = false;
+	SkinnedMeshRenderComponent::SkinningStats SkinnedMeshRenderComponent::s_SkinningStats = { 0, 0, 0, 0 };
 
 	SkinnedMeshRenderComponent::SkinnedMeshRenderComponent()
 		: m_bHasRecorded(false)
 		, m_bReserveFinalTrans(false)
 		, m_pVertexDataPtr(NULL)
+		, m_InvBindSkeleton(NULL)
+		, m_SoftwareDirty(false)
+		, m_SoftwareFailed(false)
 		, m_SkeletonCom(NULL)
 		, m_AniamtionCom(NULL)
 		, m_UpdateState(US_Lack)
 	{
 		mResourcePrior = 1;
+		m_SoftwareLayout.stride = 0;
+		m_SoftwareLayout.position = InvalidIndex;
+		m_SoftwareLayout.normal = InvalidIndex;
+		m_SoftwareLayout.tangent = InvalidIndex;
+		m_SoftwareLayout.bones = InvalidIndex;
 	}
 
 	SkinnedMeshRenderComponent::~SkinnedMeshRenderComponent()
@@ -87,12 +98,32 @@ namespace App
 
 	void SkinnedMeshRenderComponent::_Destroy()
 	{
-		if (m_pVertexDataPtr != NULL)
-		{
-			n_delete_array(m_pVertexDataPtr);
-			m_pVertexDataPtr = NULL;
-		}
+		_DiscardSoftwareSkinning();
 		m_VertsRecord.Clear();
+		m_InvBindSkeleton = NULL;
+	}
+
+	void SkinnedMeshRenderComponent::SetForceSoftwareSkinning(bool force)
+	{
+		s_ForceSoftwareSkinning = force;
+	}
+
+	bool SkinnedMeshRenderComponent::IsForceSoftwareSkinning()
+	{
+		return s_ForceSoftwareSkinning;
+	}
+
+	const SkinnedMeshRenderComponent::SkinningStats& SkinnedMeshRenderComponent::GetSkinningStats()
+	{
+		return s_SkinningStats;
+	}
+
+	void SkinnedMeshRenderComponent::ResetSkinningStats()
+	{
+		s_SkinningStats.paletteBones = 0;
+		s_SkinningStats.hwSubMeshes = 0;
+		s_SkinningStats.swSubMeshes = 0;
+		s_SkinningStats.swVertices = 0;
 	}
 
 
@@ -104,6 +135,11 @@ namespace App
 
 	void SkinnedMeshRenderComponent::_ResetSkinnedMatrices()
 	{
+		// back to the mesh's own primitive, the software one holds the last skinned pose
+		if (m_SoftwarePrimitive.IsValid())
+		{
+			_DiscardSoftwareSkinning();
+		}
 		for ( IndexT index = 0; index < mRenderableResUnitList.Size(); ++index )
 		{
 			RenderObjectType::RenderableType* smr = mRenderableResUnitList[index].GetRenderableFast<RenderObjectType::RenderableType>();
@@ -387,43 +423,202 @@ namespace App
 
 	}
 
-	void SkinnedMeshRenderComponent::_BuildOriginalVertices(const GPtr<Resources::MeshRes> &mesh)
+	bool SkinnedMeshRenderComponent::_BuildOriginalVertices(const GPtr<Resources::MeshRes> &mesh)
 	{
 		n_assert(mesh.isvalid());
 
-		// must has vertex and index
+		// must has vertex, index and bone weights
 		if ( mesh->GetIndexCount() == 0 
 			|| mesh->GetVertexCount() == 0 
-			|| mesh->GetTopologyType() == RenderBase::PrimitiveTopology::InvalidPrimitiveTopology )
+			|| mesh->GetTopologyType() == RenderBase::PrimitiveTopology::InvalidPrimitiveTopology
+			|| !mesh->GetVertexData<BoneInfoData>()
+			|| !mPrimitiveResInfo.isvalid() || !mPrimitiveResInfo->GetHandle().IsValid() )
 		{
-			n_error("error:SkinnedMeshRenderComponent::_BuildPrimitive(const GPtr<Resources::MeshRes> &mesh): must have vertex and index!");
-			return;
+			n_warning("SkinnedMeshRenderComponent::_BuildOriginalVertices: %s can not be skinned on the cpu!\n", mesh->GetMeshID().AsCharPtr());
+			m_SoftwareFailed = true;
+			return false;
 		}
 
-		//// @todo: add check which vertex prams arecurrent hardware or shader can use
-
-		// copy vertex data
+		// copy vertex data, in the layout of the mesh's primitive
 		Graphic::GraphicSystem* gs = Graphic::GraphicSystem::Instance();
 		RenderBase::VertexComponents vcs;
-		gs->GetVertexComponents(mPrimitive, vcs);
-
+		gs->GetVertexComponents(mPrimitiveResInfo->GetHandle(), vcs);
+		RenderBase::VertexComponent::BuildComponentsOffsetAndSize(vcs);
 
+		m_SoftwareLayout.position = InvalidIndex;
+		m_SoftwareLayout.normal = InvalidIndex;
+		m_SoftwareLayout.tangent = InvalidIndex;
+		m_SoftwareLayout.bones = InvalidIndex;
 		m_pVertexDataPtr = _BuildOriginalVertices( mesh, vcs, m_nVerticeCount, m_VertexDataSize);
-		if ( m_pVertexDataPtr == NULL )
+		m_SoftwareLayout.stride = m_VertexDataSize / m_nVerticeCount;
+		if ( InvalidIndex == m_SoftwareLayout.bones || m_SoftwareLayout.stride > JobMaxSliceSize )
 		{
-			n_error("error:SkinnedMeshRenderComponent::_BuildPrimitive(const GPtr<Resources::MeshRes> &mesh): m_pVertexDataPtr is NULL!");
-			return;
+			n_warning("SkinnedMeshRenderComponent::_BuildOriginalVertices: %s has no usable bone weights!\n", mesh->GetMeshID().AsCharPtr());
+			n_delete_array(m_pVertexDataPtr);
+			m_pVertexDataPtr = NULL;
+			m_SoftwareFailed = true;
+			return false;
 		}
-		RenderBase::VERTEX_DESC desc;
-		gs->GetVertexDesc(mPrimitive, desc);
+
+		m_SoftwareVertices.Clear();
+		m_SoftwareVertices.Resize(m_VertexDataSize, 0);
+		Memory::Copy(m_pVertexDataPtr, &m_SoftwareVertices[0], m_VertexDataSize);
+
+		// a primitive of its own, the mesh's one is shared with every other instance
 		Graphic::VertexBufferData2 vbd2;
-		vbd2.Setup(m_nVerticeCount, m_VertexDataSize / m_nVerticeCount, RenderBase::BufferData::Dynamic, mesh->GetTopologyType(), true);
+		vbd2.Setup(m_nVerticeCount, m_SoftwareLayout.stride, RenderBase::BufferData::Dynamic, mesh->GetTopologyType(), true);
+		vbd2.GetVertexComponents() = vcs;
 		vbd2.SetVertices(m_pVertexDataPtr, m_nVerticeCount);
 
-		gs->ChangePrimitiveHandle(mPrimitive, &vbd2, NULL);
+		Graphic::IndexBufferData2 ibd2;
+		if ( mesh->IsUseIndex16() )
+		{
+			ibd2.Setup(mesh->GetIndexCount(), RenderBase::BufferData::Static, RenderBase::IndexBufferData::Int16, true);
+			ibd2.SetIndices((void*)mesh->GetIndex16(), mesh->GetIndexCount());
+		}
+		else
+		{
+			ibd2.Setup(mesh->GetIndexCount(), RenderBase::BufferData::Static, RenderBase::IndexBufferData::Int32, true);
+			ibd2.SetIndices((void*)mesh->GetIndex32(), mesh->GetIndexCount());
+		}
+		m_SoftwarePrimitive = gs->CreatePrimitiveHandle(&vbd2, &ibd2);
+		mPrimitive = m_SoftwarePrimitive;
 
-		m_VertsRecord.Reserve(m_nVerticeCount);
+		if (Jobs::JobSystem::HasInstance())
+		{
+			m_SoftwareJobPort = Jobs::JobPort::Create();
+			m_SoftwareJobPort->Setup();
+		}
+		m_SoftwareDirty = false;
+		return true;
+	}
 
+	void SkinnedMeshRenderComponent::_WaitSoftwareSkinning()
+	{
+		if (!m_SoftwareJobs.IsEmpty())
+		{
+			m_SoftwareJobPort->WaitDone();
+			m_SoftwareJobs.Clear(false);
+		}
+	}
+
+	void SkinnedMeshRenderComponent::_DiscardSoftwareSkinning()
+	{
+		_WaitSoftwareSkinning();
+		if (m_SoftwareJobPort.isvalid())
+		{
+			m_SoftwareJobPort->Discard();
+			m_SoftwareJobPort = NULL;
+		}
+		if (m_SoftwarePrimitive.IsValid())
+		{
+			if (mPrimitive == m_SoftwarePrimitive)
+			{
+				mPrimitive = (mPrimitiveResInfo.isvalid()) ? mPrimitiveResInfo->GetHandle() : RenderBase::PrimitiveHandle();
+			}
+			Graphic::GraphicSystem::Instance()->RemovePrimitive(m_SoftwarePrimitive);
+			m_SoftwarePrimitive = RenderBase::PrimitiveHandle();
+		}
+		if (m_pVertexDataPtr != NULL)
+		{
+			n_delete_array(m_pVertexDataPtr);
+			m_pVertexDataPtr = NULL;
+		}
+		m_SoftwareVertices.Clear();
+		m_SoftwarePalette.Clear();
+		m_SoftwareDirty = false;
+		m_SoftwareFailed = false;
+	}
+
+	void SkinnedMeshRenderComponent::_SoftwareSkinning(const GPtr<Resources::MeshRes>& meshRes)
+	{
+		_WaitSoftwareSkinning();
+
+		// the palettes of all sub meshes in one block, reserved up front so the jobs can point into it.
+		// bone indices in the vertices are local to the affected bones of their sub mesh.
+		SizeT paletteSize = 0;
+		for ( IndexT index = 0; index < mRenderableResUnitList.Size(); ++index )
+		{
+			RenderObjectType::RenderableType* smr = mRenderableResUnitList[index].GetRenderableFast<RenderObjectType::RenderableType>();
+			paletteSize += smr->GetAffectedBonesIndex().Size();
+		}
+		m_SoftwarePalette.Clear(false);
+		m_SoftwarePalette.Reserve(paletteSize);
+
+		const SizeT stride = m_SoftwareLayout.stride;
+		for ( IndexT index = 0; index < mRenderableResUnitList.Size(); ++index )
+		{
+			RenderObjectType::RenderableType* smr = mRenderableResUnitList[index].GetRenderableFast<RenderObjectType::RenderableType>();
+
+			// the vertices are skinned already, the shader only sees one identity bone
+			smr->SetHWSkinning(true);
+			smr->ResetFinalMatrix(1);
+
+			const Resources::SubMesh* subMesh = meshRes->GetSubMesh(index);
+			if (NULL == subMesh || subMesh->numVertex <= 0 || subMesh->firstVertex >= m_nVerticeCount)
+			{
+				continue;
+			}
+
+			const Util::Array<uchar>& bonesIndex = smr->GetAffectedBonesIndex();
+			const IndexT paletteStart = m_SoftwarePalette.Size();
+			for (IndexT iBone = 0; iBone < bonesIndex.Size(); ++iBone)
+			{
+				SkinPaletteEntry entry;
+				SkinningKernel::ToPaletteEntry(m_FinalTrans[(IndexT)bonesIndex[iBone]], entry);
+				m_SoftwarePalette.Append(entry);
+			}
+
+			const SkinPaletteEntry* palette = (bonesIndex.IsEmpty()) ? NULL : &m_SoftwarePalette[paletteStart];
+			const SizeT count = n_min(subMesh->numVertex, m_nVerticeCount - subMesh->firstVertex);
+			const uchar* src = m_pVertexDataPtr + subMesh->firstVertex * stride;
+			uchar* dst = &m_SoftwareVertices[0] + subMesh->firstVertex * stride;
+			if (m_SoftwareJobPort.isvalid() && NULL != palette)
+			{
+				m_SoftwareJobs.Append(SkinningKernel::CreateSkinJob(palette, bonesIndex.Size(), &m_SoftwareLayout, src, dst, count));
+			}
+			else
+			{
+				SkinningKernel::SkinVertices(palette, bonesIndex.Size(), m_SoftwareLayout, src, dst, count);
+			}
+
+			s_SkinningStats.swSubMeshes++;
+			s_SkinningStats.swVertices += count;
+		}
+
+		// one chain per character, the characters of a frame spread over the worker threads
+		if (!m_SoftwareJobs.IsEmpty())
+		{
+			m_SoftwareJobPort->PushJobChain(m_SoftwareJobs);
+		}
+		m_SoftwareDirty = true;
+	}
+
+	void SkinnedMeshRenderComponent::_FlushSoftwareSkinning()
+	{
+		if (!m_SoftwareDirty)
+		{
+			return;
+		}
+		_WaitSoftwareSkinning();
+		Graphic::GraphicSystem::Instance()->UpdatePrimitiveVertices(m_SoftwarePrimitive, &m_SoftwareVertices[0], m_SoftwareVertices.Size(), 0);
+		m_SoftwareDirty = false;
+	}
+
+	void SkinnedMeshRenderComponent::_UpdateInvBindPose(const GPtr<Resources::SkeletonRes>& skeletonRes)
+	{
+		const SkelBoneContainer& skelBones = skeletonRes->GetSkelBones();
+		if (m_InvBindSkeleton == skeletonRes.get() && m_InvBindPose.Size() == skelBones.Size())
+		{
+			return;
+		}
+		m_InvBindSkeleton = skeletonRes.get();
+		m_InvBindPose.Clear(false);
+		m_InvBindPose.Reserve(skelBones.Size());
+		for (IndexT i = 0; i < skelBones.Size(); ++i)
+		{
+			m_InvBindPose.Append(skelBones[i].inverseBindingMatrix);
+		}
 	}
 
 	bool SkinnedMeshRenderComponent::_BuildVertexComponent(const GPtr<Resources::MeshRes>& mesh, Util::Array<RenderBase::VertexComponent>& verDeclare)
@@ -562,6 +757,7 @@ namespace App
 
 				m_VertexPosSize       = VertexSize;
 				m_VertexPosByteOffset = vcdef.GetByteOffset();
+				m_SoftwareLayout.position = vcdef.GetByteOffset();
 			}
 			break;
 		case VertexComponent::Normal:
@@ -572,6 +768,7 @@ namespace App
 
 				m_VertexNormalSize       = VertexSize;
 				m_VertexNormalByteOffset = vcdef.GetByteOffset();
+				m_SoftwareLayout.normal = vcdef.GetByteOffset();
 			}
 			break;
 		case VertexComponent::Tangent:
@@ -579,6 +776,7 @@ namespace App
 				TangentData::Elem* elem = mesh->GetVertexData<TangentData>();
 				n_assert( vcdef.GetByteSize() == 16 );
 				//StripeCopy<TangentData::Elem,16>(elem, vertexDataPtr, VertexSize, vcdef.GetByteOffset(), numVertices );
+				m_SoftwareLayout.tangent = vcdef.GetByteOffset();
 			}
 			break;
 		case VertexComponent::Binormal:
@@ -625,6 +823,7 @@ namespace App
 				//StripeCopy<BoneInfoData::Elem,24>(elem, vertexDataPtr, VertexSize, vcdef.GetByteOffset(), numVertices );
 
 				m_BoneInfoIndex = vcdef.GetSemanticIndex();
+				m_SoftwareLayout.bones = vcdef.GetByteOffset();
 			}
 			break;
 		case VertexComponent::SkinWeights:
@@ -698,53 +897,35 @@ namespace App
 				return true;
 			}
 
-			m_FinalTrans.Clear();
-			m_DefaultFinalTrans.Clear();
+			m_FinalTrans.Clear(false);
 
 			const SizeT bonesCount = skeletonRes->GetBonesCount();
 
 			const SkelBoneContainer& SkelBones = skeletonRes->GetSkelBones();
 
-			m_DefaultFinalTrans.Reserve(bonesCount);
-
-
+			//remainder bones use identity matrix
+			m_DefaultFinalTrans.Clear(false);
+			m_DefaultFinalTrans.Resize(bonesCount, Math::matrix44::identity());
 
 			//The hole skel's every bone's ToRootX matrix array, find from default ToRootX
 			const Util::Dictionary<Util::String, Math::matrix44>& ToRootX = m_AniamtionCom->GetDefaultToRootX();
-			Util::Array<IndexT> unusedBoneIndex;
+			const Math::matrix44 invWorld = Math::matrix44::inverse(mActor->GetTransform());
 
 			for (IndexT iBone = 0; iBone < bonesCount; ++iBone)
 			{
 				if(iBone >= ToRootX.Size())
 				{
-					unusedBoneIndex.Append(iBone);
 					continue;
 				}
 
 				IndexT nodeIndex = ToRootX.FindIndex(SkelBones[iBone].boneName.AsString());
 				if(nodeIndex == InvalidIndex)
 				{
-					unusedBoneIndex.Append(iBone);
 					continue;
 				}
-				Math::matrix44 final = Math::matrix44::multiply(ToRootX.ValueAtIndex(nodeIndex), SkelBones[iBone].inverseBindingMatrix );
-
-
-				Math::matrix44 transformMat = mActor->GetTransform();
-				transformMat = Math::matrix44::inverse(transformMat);
-
-				final = Math::matrix44::multiply(transformMat, final);
-
-				m_DefaultFinalTrans.Add(iBone, final);
-			}
-
-			//remainder bones use identity matrix
-			int remainBonesCount = unusedBoneIndex.Size();
-			for(int index = 0; index < remainBonesCount; ++index)
-			{
-				IndexT iBone = unusedBoneIndex[index];
-				m_DefaultFinalTrans.Add(iBone, Math::matrix44::identity());
+				m_DefaultFinalTrans[iBone] = Math::matrix44::multiply(invWorld, Math::matrix44::multiply(ToRootX.ValueAtIndex(nodeIndex), SkelBones[iBone].inverseBindingMatrix));
 			}
+			s_SkinningStats.paletteBones += bonesCount;
 
 			m_FinalTrans = m_DefaultFinalTrans;
 			return true;
@@ -827,12 +1008,10 @@ namespace App
 				return true;
 			}
 
-			m_FinalTrans.Clear();
+			m_FinalTrans.Clear(false);
 
 			const SizeT bonesCount = skeletonRes->GetBonesCount();
 
-			const SkelBoneContainer& SkelBones = skeletonRes->GetSkelBones();
-
 			Util::Dictionary<IndexT, IndexT> usedBoneIndex;
 			bool ret = m_AniamtionCom->GetUsedBoneIndex(mActor, usedBoneIndex);
 			if(!ret)
@@ -852,9 +1031,6 @@ namespace App
 				return false;
 			}
 
-			m_FinalTrans.Reserve(bonesCount);
-
-
 			if ( ! m_AniamtionCom->HasBuildToParentTrans() )
 			{
 				n_warning("No Available AnimationState! \n");
@@ -877,44 +1053,47 @@ namespace App
 			//The hole skel's every bone's ToRootX matrix array
 			const Util::Array<Math::matrix44>& ToRootX = m_AniamtionCom->GetToRootXTrans();
 
+			//if used and unused skel count not same as totel count, this anim is not correct
+			if(bonesCount != usedBoneIndex.Size() + unusedBoneIndex.Size())
+			{
+				return false;
+			}
+
+			// gather the bones into flat arrays, then build the palette in one pass
+			m_PaletteNodes.Clear(false);
+			m_PaletteBones.Clear(false);
 			for (IndexT iBone = 0; iBone < usedBoneIndex.Size(); ++iBone)
 			{
 				const IndexT& nodeIndex = usedBoneIndex.KeyAtIndex(iBone);
 				const IndexT& boneIndex = usedBoneIndex.ValueAtIndex(iBone);
 
-				if(nodeIndex >= ToRootX.Size() || boneIndex >= SkelBones.Size())
+				if(nodeIndex >= ToRootX.Size() || boneIndex >= bonesCount)
 				{
-					m_FinalTrans.Clear();
 					return false;
 				}
-				Math::matrix44 final = Math::matrix44::multiply(ToRootX[nodeIndex], SkelBones[boneIndex].inverseBindingMatrix );
-
-
-				Math::matrix44 transformMat = mActor->GetTransform();
-				transformMat = Math::matrix44::inverse(transformMat);
-
-				final = Math::matrix44::multiply(transformMat, final);
-
-				m_FinalTrans.Add(boneIndex, final);
+				m_PaletteNodes.Append(nodeIndex);
+				m_PaletteBones.Append(boneIndex);
 			}
 
 			for (IndexT iRemain = 0; iRemain < unusedBoneIndex.Size(); ++iRemain)
 			{
-				const IndexT& remainBoneIndex = unusedBoneIndex[iRemain];
-				m_FinalTrans.Add(remainBoneIndex, Math::matrix44::identity());
+				if (unusedBoneIndex[iRemain] >= bonesCount)
+				{
+					return false;
+				}
 			}
 
-			//if used and unused skel count not same as totel count, this anim is not correct
-			if(bonesCount != m_FinalTrans.Size())
-			{
-				m_FinalTrans.Clear();
-				return false;
-			}
-			else
-				return true;
+			_UpdateInvBindPose(skeletonRes);
+
+			// remainder bones use identity matrix
+			m_FinalTrans.Resize(bonesCount, Math::matrix44::identity());
+			SkinningKernel::BuildPalette(Math::matrix44::inverse(mActor->GetTransform()), ToRootX.Begin(), m_InvBindPose.Begin(),
+				m_PaletteNodes.Begin(), m_PaletteBones.Begin(), m_PaletteNodes.Size(), m_FinalTrans.Begin());
+			s_SkinningStats.paletteBones += m_PaletteNodes.Size();
+			return true;
 
 		}
-		m_FinalTrans.Clear();
+		m_FinalTrans.Clear(false);
 		return false;
 	}
 
@@ -924,8 +1103,23 @@ namespace App
 
 		n_assert(meshRes.isvalid())
 		{
-			bool bSWSkinning = false;
+			bool bSWSkinning = s_ForceSoftwareSkinning;
+			for ( IndexT index = 0; index < mRenderableResUnitList.Size() && !bSWSkinning; ++index )
+			{
+				RenderObjectType::RenderableType* smr = mRenderableResUnitList[index].GetRenderableFast<RenderObjectType::RenderableType>();
+				bSWSkinning = smr->GetAffectedBonesCount() > MaxSupportedBones;
+			}
 
+			//Software Skinning, the whole mesh is skinned on the cpu into a primitive of its own
+			if (bSWSkinning && !m_SoftwareFailed && (m_SoftwarePrimitive.IsValid() || _BuildOriginalVertices(meshRes)))
+			{
+				_SoftwareSkinning(meshRes);
+				return;
+			}
+			if (m_SoftwarePrimitive.IsValid())
+			{
+				_DiscardSoftwareSkinning();
+			}
 
 			for ( IndexT index = 0; index < mRenderableResUnitList.Size(); ++index )
 			{
@@ -937,6 +1131,7 @@ namespace App
 				if (nBones <= MaxSupportedBones)
 				{
 					smr->SetHWSkinning(true);
+					s_SkinningStats.hwSubMeshes++;
 
 					const Util::Array<uchar>& bonesIndex = smr->GetAffectedBonesIndex();
 
@@ -968,11 +1163,9 @@ namespace App
 					}
 
 				} 
-				//Software Skinning
 				else
 				{
-					// TODO
-					n_warning("Not Support Software Skinning Now. /n");
+					n_warning("Too many bones for hardware skinning, and software skinning is not available. /n");
 				}
 
 			}
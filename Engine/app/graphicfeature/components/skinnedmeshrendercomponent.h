@@ -26,7 +26,10 @@ THE SOFTWARE.
 
 #include "graphicfeature/components/meshrendercomponent.h"
 #include "graphicfeature/components/skinnedrenderobject.h"
+#include "graphicfeature/components/skinningkernel.h"
 #include "resource/meshres.h"
+#include "resource/skeletonres.h"
+#include "jobs/jobport.h"
 #include "foundation/math/matrix44.h"
 
 namespace App
@@ -50,6 +53,16 @@ namespace App
 		};
 
 		typedef SkinnedRenderObject RenderObjectType;
+
+		/// skinning work of all skinned meshes since the last reset, to compare hardware and software skinning
+		struct SkinningStats
+		{
+			SizeT paletteBones;		// bone matrices built
+			SizeT hwSubMeshes;		// sub meshes skinned by the vertex shader
+			SizeT swSubMeshes;		// sub meshes skinned on the cpu
+			SizeT swVertices;		// vertices skinned on the cpu
+		};
+
 		SkinnedMeshRenderComponent();
 		~SkinnedMeshRenderComponent();
 		/// @Component::OnActivate  called from Actor::ActivateComponents()
@@ -82,6 +95,17 @@ namespace App
 
 		static const Math::matrix44 m_IndentityMatrix;
 
+		/// skin every mesh on the cpu, for devices with too few vertex shader constants and for headless runs. 
+		/// sub meshes with more bones than the shaders support are always skinned on the cpu.
+		static void SetForceSoftwareSkinning(bool force);
+		static bool IsForceSoftwareSkinning();
+
+		static const SkinningStats& GetSkinningStats();
+		static void ResetSkinningStats();
+
+		// !!!!!!internal call!!!!!  upload the cpu skinned vertices once their jobs are done, called before drawing.
+		void _FlushSoftwareSkinning();
+
 	protected:
 
 		virtual void _OnFrame();
@@ -95,7 +119,7 @@ namespace App
 
 		void _SetRenderable(const GPtr<Resources::MeshRes>& meshRes, IndexT index, RenderObjectType::RenderableType* renderable);
 
-		void _BuildOriginalVertices(const GPtr<Resources::MeshRes>& mesh);//Only used in software skinning
+		bool _BuildOriginalVertices(const GPtr<Resources::MeshRes>& mesh);//Only used in software skinning
 
 	private:
 
@@ -119,12 +143,39 @@ namespace App
 
 		void _Skinning();
 
+		void _SoftwareSkinning(const GPtr<Resources::MeshRes>& meshRes);
+
+		void _WaitSoftwareSkinning();
+
+		void _DiscardSoftwareSkinning();
+
+		void _UpdateInvBindPose(const GPtr<Resources::SkeletonRes>& skeletonRes);
+
 		void _Destroy();
 
-		Util::Dictionary<IndexT, Math::matrix44>   m_FinalTrans;
-		Util::Dictionary<IndexT, Math::matrix44>   m_DefaultFinalTrans;
+		// skin matrix of every skeleton bone, indexed by bone
+		Util::Array<Math::matrix44>   m_FinalTrans;
+		Util::Array<Math::matrix44>   m_DefaultFinalTrans;
+		// inverse binding matrix of every skeleton bone, and the skeleton they were taken from
+		Util::Array<Math::matrix44>   m_InvBindPose;
+		const Resources::SkeletonRes* m_InvBindSkeleton;
+		Util::Array<IndexT> m_PaletteNodes;
+		Util::Array<IndexT> m_PaletteBones;
 		Util::Array<int> m_VertsRecord;
 
+		// software skinning: bind pose copy (m_pVertexDataPtr), skinned copy and the primitive drawn instead of the mesh's
+		RenderBase::PrimitiveHandle m_SoftwarePrimitive;
+		Util::Array<uchar> m_SoftwareVertices;
+		Util::Array<SkinPaletteEntry> m_SoftwarePalette;
+		SkinVertexLayout m_SoftwareLayout;
+		Util::Array<GPtr<Jobs::Job> > m_SoftwareJobs;
+		GPtr<Jobs::JobPort> m_SoftwareJobPort;
+		bool m_SoftwareDirty;
+		bool m_SoftwareFailed;
+
+		static bool s_ForceSoftwareSkinning;
+		static SkinningStats s_SkinningStats;
+
 		Util::String m_LostedSkelton;
 
 		GPtr<SkeletonComponent> m_SkeletonCom;
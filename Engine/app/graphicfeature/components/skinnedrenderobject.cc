@@ -72,6 +72,12 @@ namespace App
 		}
 	}
 
+	bool SkinnedRenderObject::GetInstanceInfo(const Graphic::Renderable* renderable, Graphic::RenderPassType passType, const Graphic::Material* customizedMaterial, Graphic::InstanceInfo& info)
+	{
+		// every skinned object uploads its own bone palette
+		return false;
+	}
+
 	void SkinnedRenderObject::render(const RenderableType* renderable, Graphic::RenderPassType passType, const Graphic::Material* customizedMat, const Math::matrix44& _matrix)
 	{
 
@@ -80,6 +86,8 @@ namespace App
 
 		if (priHandle.IsValid())
 		{
+			skinnedMeshRC->_FlushSoftwareSkinning();
+
 			//Hardware Skinning, set the final transform
 			if( renderable->HasUseHWSkinning() && passType !=  Graphic::eCustomized)
 			{
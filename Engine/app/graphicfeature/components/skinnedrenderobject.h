@@ -41,6 +41,8 @@ namespace App
 		~SkinnedRenderObject();
 		virtual void AddToCollection(Graphic::RenderDataCollection* collection);
 		virtual void Render(const Graphic::Renderable* renderable, Graphic::RenderPassType passType, const Graphic::Material* customizedMaterial);
+		virtual bool IsDeforming() const;
+		virtual bool GetInstanceInfo(const Graphic::Renderable* renderable, Graphic::RenderPassType passType, const Graphic::Material* customizedMaterial, Graphic::InstanceInfo& info);
 	protected:
 		void render(const RenderableType* renderable, Graphic::RenderPassType passType, const Graphic::Material* customizedMat, const Math::matrix44& _matrix);
 	private:
@@ -50,6 +52,10 @@ namespace App
 	{
 		return GetOwner<Owner>();
 	}
+	inline bool SkinnedRenderObject::IsDeforming() const
+	{
+		return true;
+	}
 }
 
 #endif //_SKINNEDRENDEROBJECT_H_
\ No newline at end of file
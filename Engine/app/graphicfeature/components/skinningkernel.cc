@@ -0,0 +1,247 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "stdneb.h"
+#include "graphicfeature/components/skinningkernel.h"
+#include "jobs/stdjob.h"
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define SKINNINGKERNEL_USE_SSE (1)
+#else
+#define SKINNINGKERNEL_USE_SSE (0)
+#endif
+#if !SKINNINGKERNEL_USE_SSE && (defined(__ARM_NEON__) || defined(__ARM_NEON))
+#include <arm_neon.h>
+#define SKINNINGKERNEL_USE_NEON (1)
+#else
+#define SKINNINGKERNEL_USE_NEON (0)
+#endif
+
+namespace App
+{
+	//------------------------------------------------------------------------------
+	void SkinningKernel::BuildPalette(const Math::matrix44& invWorld, const Math::matrix44* toRoot, const Math::matrix44* invBind,
+		const IndexT* nodes, const IndexT* bones, SizeT count, Math::matrix44* palette)
+	{
+		for (IndexT i = 0; i < count; ++i)
+		{
+			const IndexT bone = bones[i];
+			palette[bone] = Math::matrix44::multiply(invWorld, Math::matrix44::multiply(toRoot[nodes[i]], invBind[bone]));
+		}
+	}
+	//------------------------------------------------------------------------------
+	void SkinningKernel::ToPaletteEntry(const Math::matrix44& m, SkinPaletteEntry& entry)
+	{
+		// the columns are the images of the unit vectors, independent of how matrix44 stores its rows
+		for (IndexT c = 0; c < 4; ++c)
+		{
+			Math::float4 unit(0.0f, 0.0f, 0.0f, 0.0f);
+			unit[c] = 1.0f;
+			Math::float4 col = Math::matrix44::transform(m, unit);
+			entry.col[c][0] = col.x();
+			entry.col[c][1] = col.y();
+			entry.col[c][2] = col.z();
+			entry.col[c][3] = col.w();
+		}
+	}
+	//------------------------------------------------------------------------------
+	static inline void _ResetBones(uchar* dst)
+	{
+		ushort* indices = (ushort*)dst;
+		float* weights = (float*)(dst + 4 * sizeof(ushort));
+		indices[0] = indices[1] = indices[2] = indices[3] = 0;
+		weights[0] = 1.0f;
+		weights[1] = weights[2] = weights[3] = 0.0f;
+	}
+	//------------------------------------------------------------------------------
+	void SkinningKernel::SkinVertices(const SkinPaletteEntry* palette, SizeT paletteCount, const SkinVertexLayout& layout, const uchar* src, uchar* dst, SizeT count)
+	{
+		n_assert(InvalidIndex != layout.bones);
+		const SizeT stride = layout.stride;
+		for (IndexT v = 0; v < count; ++v, src += stride, dst += stride)
+		{
+			Memory::Copy(src, dst, stride);
+			const ushort* indices = (const ushort*)(src + layout.bones);
+			const float* weights = (const float*)(src + layout.bones + 4 * sizeof(ushort));
+#if SKINNINGKERNEL_USE_SSE
+			__m128 c0 = _mm_setzero_ps();
+			__m128 c1 = _mm_setzero_ps();
+			__m128 c2 = _mm_setzero_ps();
+			__m128 c3 = _mm_setzero_ps();
+			for (IndexT k = 0; k < 4; ++k)
+			{
+				if (weights[k] != 0.0f && indices[k] < paletteCount)
+				{
+					const float* e = &palette[indices[k]].col[0][0];
+					const __m128 w = _mm_set1_ps(weights[k]);
+					c0 = _mm_add_ps(c0, _mm_mul_ps(w, _mm_loadu_ps(e)));
+					c1 = _mm_add_ps(c1, _mm_mul_ps(w, _mm_loadu_ps(e + 4)));
+					c2 = _mm_add_ps(c2, _mm_mul_ps(w, _mm_loadu_ps(e + 8)));
+					c3 = _mm_add_ps(c3, _mm_mul_ps(w, _mm_loadu_ps(e + 12)));
+				}
+			}
+			float out[4];
+			if (InvalidIndex != layout.position)
+			{
+				const float* p = (const float*)(src + layout.position);
+				__m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(p[0])), _mm_mul_ps(c1, _mm_set1_ps(p[1]))),
+					_mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(p[2])), c3));
+				_mm_storeu_ps(out, r);
+				Memory::Copy(out, dst + layout.position, 3 * sizeof(float));
+			}
+			if (InvalidIndex != layout.normal)
+			{
+				const float* n = (const float*)(src + layout.normal);
+				__m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(n[0])), _mm_mul_ps(c1, _mm_set1_ps(n[1]))),
+					_mm_mul_ps(c2, _mm_set1_ps(n[2])));
+				_mm_storeu_ps(out, r);
+				Memory::Copy(out, dst + layout.normal, 3 * sizeof(float));
+			}
+			if (InvalidIndex != layout.tangent)
+			{
+				const float* t = (const float*)(src + layout.tangent);
+				__m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(t[0])), _mm_mul_ps(c1, _mm_set1_ps(t[1]))),
+					_mm_mul_ps(c2, _mm_set1_ps(t[2])));
+				_mm_storeu_ps(out, r);
+				Memory::Copy(out, dst + layout.tangent, 3 * sizeof(float));
+			}
+#elif SKINNINGKERNEL_USE_NEON
+			float32x4_t c0 = vdupq_n_f32(0.0f);
+			float32x4_t c1 = c0;
+			float32x4_t c2 = c0;
+			float32x4_t c3 = c0;
+			for (IndexT k = 0; k < 4; ++k)
+			{
+				if (weights[k] != 0.0f && indices[k] < paletteCount)
+				{
+					const float* e = &palette[indices[k]].col[0][0];
+					const float w = weights[k];
+					c0 = vmlaq_n_f32(c0, vld1q_f32(e), w);
+					c1 = vmlaq_n_f32(c1, vld1q_f32(e + 4), w);
+					c2 = vmlaq_n_f32(c2, vld1q_f32(e + 8), w);
+					c3 = vmlaq_n_f32(c3, vld1q_f32(e + 12), w);
+				}
+			}
+			float out[4];
+			if (InvalidIndex != layout.position)
+			{
+				const float* p = (const float*)(src + layout.position);
+				float32x4_t r = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(c3, c0, p[0]), c1, p[1]), c2, p[2]);
+				vst1q_f32(out, r);
+				Memory::Copy(out, dst + layout.position, 3 * sizeof(float));
+			}
+			if (InvalidIndex != layout.normal)
+			{
+				const float* n = (const float*)(src + layout.normal);
+				float32x4_t r = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(c0, n[0]), c1, n[1]), c2, n[2]);
+				vst1q_f32(out, r);
+				Memory::Copy(out, dst + layout.normal, 3 * sizeof(float));
+			}
+			if (InvalidIndex != layout.tangent)
+			{
+				const float* t = (const float*)(src + layout.tangent);
+				float32x4_t r = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(c0, t[0]), c1, t[1]), c2, t[2]);
+				vst1q_f32(out, r);
+				Memory::Copy(out, dst + layout.tangent, 3 * sizeof(float));
+			}
+#else
+			float c[4][4] = { { 0.0f } };
+			for (IndexT k = 0; k < 4; ++k)
+			{
+				if (weights[k] != 0.0f && indices[k] < paletteCount)
+				{
+					const SkinPaletteEntry& e = palette[indices[k]];
+					const float w = weights[k];
+					for (IndexT i = 0; i < 4; ++i)
+					{
+						c[i][0] += e.col[i][0] * w;
+						c[i][1] += e.col[i][1] * w;
+						c[i][2] += e.col[i][2] * w;
+						c[i][3] += e.col[i][3] * w;
+					}
+				}
+			}
+			if (InvalidIndex != layout.position)
+			{
+				const float* p = (const float*)(src + layout.position);
+				float* o = (float*)(dst + layout.position);
+				for (IndexT i = 0; i < 3; ++i)
+				{
+					o[i] = c[0][i] * p[0] + c[1][i] * p[1] + c[2][i] * p[2] + c[3][i];
+				}
+			}
+			if (InvalidIndex != layout.normal)
+			{
+				const float* n = (const float*)(src + layout.normal);
+				float* o = (float*)(dst + layout.normal);
+				for (IndexT i = 0; i < 3; ++i)
+				{
+					o[i] = c[0][i] * n[0] + c[1][i] * n[1] + c[2][i] * n[2];
+				}
+			}
+			if (InvalidIndex != layout.tangent)
+			{
+				const float* t = (const float*)(src + layout.tangent);
+				float* o = (float*)(dst + layout.tangent);
+				for (IndexT i = 0; i < 3; ++i)
+				{
+					o[i] = c[0][i] * t[0] + c[1][i] * t[1] + c[2][i] * t[2];
+				}
+			}
+#endif
+			_ResetBones(dst + layout.bones);
+		}
+	}
+	//------------------------------------------------------------------------------
+	void SkinningJobFunc(const JobFuncContext& ctx)
+	{
+		const SkinPaletteEntry* palette = (const SkinPaletteEntry*)ctx.uniforms[0];
+		const SizeT paletteCount = ctx.uniformSizes[0] / sizeof(SkinPaletteEntry);
+		const SkinVertexLayout& layout = *(const SkinVertexLayout*)ctx.uniforms[1];
+		const SizeT count = ctx.inputSizes[0] / layout.stride;
+		n_assert(ctx.outputSizes[0] == count * layout.stride);
+		SkinningKernel::SkinVertices(palette, paletteCount, layout, ctx.inputs[0], ctx.outputs[0], count);
+	}
+}
+__ImplementSpursJob(App::SkinningJobFunc);
+
+namespace App
+{
+	//------------------------------------------------------------------------------
+	GPtr<Jobs::Job> SkinningKernel::CreateSkinJob(const SkinPaletteEntry* palette, SizeT paletteCount, const SkinVertexLayout* layout, const uchar* src, uchar* dst, SizeT count)
+	{
+		n_assert(layout->stride > 0 && layout->stride <= JobMaxSliceSize);
+		const SizeT vertsPerSlice = JobMaxSliceSize / layout->stride;
+		const SizeT sliceSize = vertsPerSlice * layout->stride;
+		const SizeT size = count * layout->stride;
+
+		Jobs::JobFuncDesc jobFunction(SkinningJobFunc);
+		Jobs::JobUniformDesc uniformData((void*)palette, paletteCount * sizeof(SkinPaletteEntry), (void*)layout, sizeof(SkinVertexLayout), 0);
+		Jobs::JobDataDesc inputData((void*)src, size, sliceSize);
+		Jobs::JobDataDesc outputData(dst, size, sliceSize);
+
+		GPtr<Jobs::Job> job = Jobs::Job::Create();
+		job->Setup(uniformData, inputData, outputData, jobFunction);
+		return job;
+	}
+}
@@ -0,0 +1,64 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef _SKINNINGKERNEL_H_
+#define _SKINNINGKERNEL_H_
+#include "math/matrix44.h"
+#include "jobs/job.h"
+
+namespace App
+{
+	/// one skin matrix stored by columns, p' = col[0] * x + col[1] * y + col[2] * z + col[3]
+	struct SkinPaletteEntry
+	{
+		float col[4][4];
+	};
+
+	/// byte layout of an interleaved skinned vertex, offsets are InvalidIndex for missing components
+	struct SkinVertexLayout
+	{
+		SizeT stride;
+		IndexT position;	// float3
+		IndexT normal;		// float3
+		IndexT tangent;		// float4, w is kept
+		IndexT bones;		// 4 ushort indices followed by 4 float weights
+	};
+
+	// cpu side skinning helpers, shared by the palette build and the software skinning path
+	class SkinningKernel
+	{
+	public:
+		/// palette[bones[i]] = invWorld * toRoot[nodes[i]] * invBind[bones[i]] for i < count
+		static void BuildPalette(const Math::matrix44& invWorld, const Math::matrix44* toRoot, const Math::matrix44* invBind,
+			const IndexT* nodes, const IndexT* bones, SizeT count, Math::matrix44* palette);
+		/// store a skin matrix by columns
+		static void ToPaletteEntry(const Math::matrix44& m, SkinPaletteEntry& entry);
+		/// skin count vertices from src to dst (same layout). the bone data written to dst selects palette entry 0 with full weight,
+		/// so the result can be drawn with the hardware skinning shaders and a single identity matrix.
+		static void SkinVertices(const SkinPaletteEntry* palette, SizeT paletteCount, const SkinVertexLayout& layout, const uchar* src, uchar* dst, SizeT count);
+		/// a job doing SkinVertices in slices. palette, layout, src and dst must stay valid until the job is done.
+		static GPtr<Jobs::Job> CreateSkinJob(const SkinPaletteEntry* palette, SizeT paletteCount, const SkinVertexLayout* layout, const uchar* src, uchar* dst, SizeT count);
+	};
+}
+
+#endif //_SKINNINGKERNEL_H_
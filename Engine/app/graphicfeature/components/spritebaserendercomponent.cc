@@ -245,6 +245,16 @@ namespace App
 		return mSpriteInfo.GetPrimitiveHandle();
 	}
 
+	const Graphic::SpriteVertex* SpriteBaseRenderComponent::_getQuad() const
+	{
+		return mSpriteInfo.GetQuad();
+	}
+
+	void SpriteBaseRenderComponent::_commitVertex()
+	{
+		mSpriteInfo.CommitVertex();
+	}
+
 	Resources::ResourceId SpriteBaseRenderComponent::GetPackageID() const
 	{
 		return mSpriteInfo.GetPackID();
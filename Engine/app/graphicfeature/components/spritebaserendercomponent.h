@@ -77,6 +77,12 @@ namespace App
 
 		const RenderBase::PrimitiveHandle& _getHandle() const;
 
+		/// object space quad of the current frame, see Sprite::SpriteInfo::GetQuad
+		const Graphic::SpriteVertex* _getQuad() const;
+
+		/// upload the quad before the sprite is drawn on its own
+		void _commitVertex();
+
 		Math::bbox GetLocalBoundingBox();
 
 		bool Intersect(const Math::Ray& worldRay, Math::scalar& fout, Math::scalar fTolerance = N_TINY);
@@ -27,6 +27,7 @@ THE SOFTWARE.
 #include "graphicfeature/components/spritebaserendercomponent.h"
 #include "graphicsystem/Camera/RenderPipeline/RenderData.h"
 #include "graphicsystem/Renderable/GraphicRenderer.h"
+#include "graphicsystem/Renderable/SpriteBatcher.h"
 #include "spriterenderobject.h"
 
 namespace App
@@ -50,6 +51,13 @@ namespace App
 		Graphic::GraphicRenderer::RenderForward(surType, this, primHandle, custom);
 	}
 
+	void SpriteRenderable::RenderBatch(Graphic::RenderPassType surType, const Graphic::Material* custom) const
+	{
+		mImage->PushTexture();
+		Graphic::GraphicRenderer::ResetMaterialCache();
+		Graphic::GraphicRenderer::RenderSprites(surType, this, custom);
+	}
+
 
 	__ImplementClass(SpriteRenderObject,'SPRO',AppRenderObject);
 
@@ -70,6 +78,8 @@ namespace App
 		const RenderBase::PrimitiveHandle& priHandle = getOwner()->_getHandle();
 		if (priHandle.IsValid())//( (customizedMat.isvalid() || mat.isvalid()) && priHandle.IsValid() )
 		{
+			getOwner()->_commitVertex();
+
 			GlobalMaterialParam* pGMP = Graphic::Material::GetGlobalMaterialParams();
 
 			pGMP->SetMatrixParam(eGShaderMatM,GetTransform());
@@ -93,4 +103,46 @@ namespace App
 		}
 
 	}
-}
\ No newline at end of file
+
+	bool SpriteRenderObject::GetSpriteQuadInfo(const Graphic::Renderable* renderable, Graphic::RenderPassType passType, const Graphic::Material* customizedMaterial, Graphic::SpriteQuadInfo& info)
+	{
+		n_assert(NULL != renderable);
+		const RenderableType* rd = renderable->cast_fast<RenderableType>();
+		if (!getOwner()->_getHandle().IsValid() || !rd->GetImage().isvalid())
+		{
+			return false;
+		}
+
+		// the batch is drawn with an identity world matrix, shaders reading the inverse one keep the per sprite path
+		const Graphic::Material* material = (NULL == customizedMaterial) ? renderable->GetMaterial() : customizedMaterial;
+		int passindex = (eCustomized == passType) ? 0 : passType -1;
+		const Util::Array< GPtr<MaterialPass> >& passList = material->GetTech()->GetPassList();
+		if (passindex >= passList.Size())
+		{
+			return false;
+		}
+		const GPtr<MaterialPass>& pass = passList[passindex];
+		if ( pass->isGlobalParamUsed( eGShaderMatInverseM ) || pass->isGlobalParamUsed( eGShaderMatInverseTransposeM ) )
+		{
+			return false;
+		}
+
+		info.surType = (passType && material->GetTech()->IsTemplateTech()) ? passType : eForward;
+		info.image = rd->GetImage().get();
+		info.vertices = getOwner()->_getQuad();
+		info.world = &GetTransform();
+		return true;
+	}
+
+	void SpriteRenderObject::RenderSpriteBatch(const Graphic::Renderable* renderable, Graphic::RenderPassType passType, const Graphic::Material* customizedMaterial)
+	{
+		const RenderableType* rd = renderable->cast_fast<RenderableType>();
+		GlobalMaterialParam* pGMP = Graphic::Material::GetGlobalMaterialParams();
+
+		pGMP->SetMatrixParam(eGShaderMatM, Math::matrix44::identity());
+		pGMP->SetMatrixParam(eGShaderMatInverseM, Math::matrix44::identity());
+		pGMP->SetMatrixParam(eGShaderMatInverseTransposeM, Math::matrix44::identity());
+
+		rd->RenderBatch(GraphicSystem::Instance()->GetSpriteBatcher()->GetRun().surType, customizedMaterial);
+	}
+}
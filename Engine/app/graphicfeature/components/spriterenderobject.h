@@ -46,6 +46,9 @@ namespace App
 		~SpriteRenderable();
 		void RenderForward(Graphic::RenderPassType surType, const RenderBase::PrimitiveHandle& primHandle, const Graphic::Material* custom) const;
 		void SetImage(const GPtr<Sprite::SpriteImage>& texture);
+		const GPtr<Sprite::SpriteImage>& GetImage() const;
+		/// push the image and draw the quads collected by the sprite batcher
+		void RenderBatch(Graphic::RenderPassType surType, const Graphic::Material* custom) const;
 	protected:
 		GPtr<Sprite::SpriteImage> mImage;
 	};
@@ -53,6 +56,13 @@ namespace App
 	inline void SpriteRenderable::SetImage(const GPtr<Sprite::SpriteImage>& texture)
 	{
 		mImage = texture;
+		// sprites of one image are sorted next to each other, so the sprite batcher gets long runs
+		SetBatchKey(texture.get());
+	}
+
+	inline const GPtr<Sprite::SpriteImage>& SpriteRenderable::GetImage() const
+	{
+		return mImage;
 	}
 
 
@@ -66,6 +76,8 @@ namespace App
 		virtual ~SpriteRenderObject();
 		//The overrided fuctions of Graphic::RenderObject 
 		virtual void Render(const Graphic::Renderable* renderable, Graphic::RenderPassType passType, const Graphic::Material* customizedMaterial);
+		virtual bool GetSpriteQuadInfo(const Graphic::Renderable* renderable, Graphic::RenderPassType passType, const Graphic::Material* customizedMaterial, Graphic::SpriteQuadInfo& info);
+		virtual void RenderSpriteBatch(const Graphic::Renderable* renderable, Graphic::RenderPassType passType, const Graphic::Material* customizedMaterial);
 	private:
 		Owner* getOwner() const;
 	};
@@ -202,7 +202,7 @@ namespace App
 	GPtr<App::Actor> GraphicsFeature::GetDefaultCameraActor() const
 	{
 		const Graphic::CameraList& list = mGraphicSystem->GetCameraList();
-		for (SizeT i = list.Size() - 1; i >= 0; ++i)
+		for (SizeT i = list.Size() - 1; i >= 0; --i)
 		{
 			Camera* camera = list[i];
 			if (camera && (NULL == camera->GetTargetWindow() || Graphic::VPT_MAIN == camera->GetTargetWindow()->GetType()))
@@ -41,6 +41,7 @@ namespace App
 		//The overrided fuctions of Graphic::RenderObject 
 		virtual void AddToCollection(Graphic::RenderDataCollection* collection);
 		virtual void Render(const Graphic::Renderable* renderable, Graphic::RenderPassType passType, const Graphic::Material* customizedMaterial);
+		virtual bool IsDeforming() const;
 	private:
 		Owner* getOwner() const;
 	};
@@ -48,6 +49,10 @@ namespace App
 	{
 		return GetOwner<Owner>();
 	}
+	inline bool ParticleRenderObject::IsDeforming() const
+	{
+		return true;
+	}
 }
 
 
@@ -42,6 +42,10 @@ namespace App
 
     static MonoObject* ICall_ActorManager_GetMainCameraActor( void );
 
+    static void ICall_ActorManager_GetWorldTransforms(MonoArray* actors, MonoArray* outPositions, MonoArray* outRotations);
+
+    static void ICall_ActorManager_SetWorldPositions(MonoArray* actors, MonoArray* positions);
+
 //********************************* Register func to mono ********************************************
 	void ICallReg_ScriptRuntime_ActorManager( void )
     {
@@ -55,6 +59,8 @@ namespace App
              { "ScriptRuntime.ActorManager::ICall_ActorManager_FindActiveActorByGuid",              (void*)&ICall_ActorManager_FindActiveActorByGuid},
              { "ScriptRuntime.ActorManager::ICall_ActorManager_FindActiveActorByName",              (void*)&ICall_ActorManager_FindActiveActorByName},
              { "ScriptRuntime.ActorManager::ICall_ActorManager_GetMainCameraActor",                 (void*)&ICall_ActorManager_GetMainCameraActor},
+             { "ScriptRuntime.ActorManager::ICall_ActorManager_GetWorldTransforms",                 (void*)&ICall_ActorManager_GetWorldTransforms},
+             { "ScriptRuntime.ActorManager::ICall_ActorManager_SetWorldPositions",                  (void*)&ICall_ActorManager_SetWorldPositions},
         };
         int size = sizeof(s_cScriptBindInternalCallDetail) / sizeof(InternalCallDetail);
         for (int ii = 0; ii < size; ++ii)
@@ -112,6 +112,48 @@ namespace App
 		return NULL;
 	}
 
+	// - batched transform access: one transition for N actors, results go straight into the caller's arrays
+	static void ICall_ActorManager_GetWorldTransforms(MonoArray* actors, MonoArray* outPositions, MonoArray* outRotations)
+	{
+		SizeT count = (SizeT)mono_array_length( actors );
+		n_assert( (SizeT)mono_array_length( outPositions )>=count );
+		n_assert( (SizeT)mono_array_length( outRotations )>=count );
+
+		for ( IndexT ii=0; ii<count; ii++ )
+		{
+			Actor* pActor = ScriptObjWrapper<Actor>::Convert( mono_array_get( actors, MonoObject*, ii ) );
+			if ( NULL==pActor )
+			{
+				continue;
+			}
+
+			// - managed elements are only 4 bytes aligned, so don't store SSE types into them
+			const Math::vector& pos = pActor->GetWorldPosition();
+			const Math::quaternion& rot = pActor->GetWorldRotation();
+			*mono_array_addr( outPositions, Math::float3, ii ) = Utility_VectorToFloat3( pos );
+			float* pRot = (float*)mono_array_addr_with_size( outRotations, sizeof(float) * 4, ii );
+			pRot[0] = rot.x();
+			pRot[1] = rot.y();
+			pRot[2] = rot.z();
+			pRot[3] = rot.w();
+		}
+	}
+
+	static void ICall_ActorManager_SetWorldPositions(MonoArray* actors, MonoArray* positions)
+	{
+		SizeT count = (SizeT)mono_array_length( actors );
+		n_assert( (SizeT)mono_array_length( positions )>=count );
+
+		for ( IndexT ii=0; ii<count; ii++ )
+		{
+			Actor* pActor = ScriptObjWrapper<Actor>::Convert( mono_array_get( actors, MonoObject*, ii ) );
+			if ( NULL!=pActor )
+			{
+				pActor->SetWorldPosition( Utility_Float3ToVector( mono_array_get( positions, Math::float3, ii ) ) );
+			}
+		}
+	}
+
 }
 
 #include "autogen/scriptbind_ActorManager_register.h"
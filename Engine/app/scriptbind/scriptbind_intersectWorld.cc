@@ -96,12 +96,67 @@ namespace App
 		outPoint3 = triAngle.point2;
 	}
 
+	// - batched raycasts: N rays per transition, results are written into preallocated managed arrays
+	static int ICall_IntersectWorld_Points(MonoArray* rays, uint select_mark, MonoArray* outPoints, MonoArray* outHits)
+	{
+		SizeT count = (SizeT)mono_array_length( rays );
+		n_assert( (SizeT)mono_array_length( outPoints )>=count );
+		n_assert( (SizeT)mono_array_length( outHits )>=count );
+
+		int hitCount = 0;
+		AppUtil::IntersectResultList rsList;
+		for ( IndexT ii=0; ii<count; ii++ )
+		{
+			const Math::Ray& ray = mono_array_get( rays, Math::Ray, ii );
+			rsList.Clear();
+			AppUtil::IntersectUtil::IntersectWorld(ray, select_mark, false, rsList );
+			rsList.Sort();
+			if (rsList.IsEmpty())
+			{
+				mono_array_set( outPoints, Math::float3, ii, Math::float3(0,0,0) );
+				mono_array_set( outHits, ubyte, ii, 0 );
+				continue;
+			}
+			mono_array_set( outPoints, Math::float3, ii, ray.PointAt( rsList[0].intersectPoint ) );
+			mono_array_set( outHits, ubyte, ii, 1 );
+			hitCount++;
+		}
+		return hitCount;
+	}
+
+	static int ICall_IntersectWorld_Actors(MonoArray* rays, uint select_mark, MonoArray* outActors)
+	{
+		SizeT count = (SizeT)mono_array_length( rays );
+		n_assert( (SizeT)mono_array_length( outActors )>=count );
+
+		int hitCount = 0;
+		AppUtil::IntersectResultList rsList;
+		for ( IndexT ii=0; ii<count; ii++ )
+		{
+			const Math::Ray& ray = mono_array_get( rays, Math::Ray, ii );
+			rsList.Clear();
+			AppUtil::IntersectUtil::IntersectWorld(ray, select_mark, false, rsList );
+			rsList.Sort();
+
+			MonoObject* pMonoActor = NULL;
+			if (!rsList.IsEmpty() && rsList[0].actor.isvalid())
+			{
+				pMonoActor = CppObjectToScriptObj( *rsList[0].actor );
+				hitCount++;
+			}
+			mono_array_setref( outActors, ii, pMonoActor );
+		}
+		return hitCount;
+	}
+
 	void ICallReg_ScriptRuntime_IntersectWorld( void )
 	{
 		static const InternalCallDetail s_cScriptBindInternalCallDetail[] = {
 			{ "ScriptRuntime.IntersectWorld::ICall_IntersectWorld_Actor", (void*)&ICall_IntersectWorld_Actor },
 			{ "ScriptRuntime.IntersectWorld::ICall_IntersectWorld_Point", (void*)&ICall_IntersectWorld_Point },
 			{ "ScriptRuntime.IntersectWorld::ICall_IntersectWorld_Triangle", (void*)&ICall_IntersectWorld_Triangle },
+			{ "ScriptRuntime.IntersectWorld::ICall_IntersectWorld_Points", (void*)&ICall_IntersectWorld_Points },
+			{ "ScriptRuntime.IntersectWorld::ICall_IntersectWorld_Actors", (void*)&ICall_IntersectWorld_Actors },
 			{ "ScriptRuntime.IntersectWorld::ICall_IntersectWorld_ComputeRay", (void*)&ICall_IntersectWorld_ComputeRay },
 			{ "ScriptRuntime.IntersectWorld::ICall_IntersectWorld_IntersectActor", (void*)&ICall_IntersectWorld_IntersectActor },
 		};
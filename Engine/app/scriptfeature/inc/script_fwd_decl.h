@@ -58,6 +58,16 @@ namespace App
 	typedef Util::Dictionary<Util::String, MonoClassField*> TMonoClassFieldMap;
 	typedef Util::Dictionary<Util::String, MonoMethod*> ScriptMessageHandlerMap;
 
+	// - unmanaged thunk of a parameterless instance method, see mono_method_get_unmanaged_thunk.
+	// - the thunk takes 'this' first and reports a thrown exception through the last argument
+#if __WIN32__
+	#define MONO_THUNK_CALL __stdcall
+#else
+	#define MONO_THUNK_CALL
+#endif
+	typedef void (MONO_THUNK_CALL *TMonoEntryThunk)( MonoObject* self, MonoObject** exc );
+	typedef Util::Array<TMonoEntryThunk> TMonoThunkArray;
+
 	typedef Util::Array< Util::Array< GPtr<ScriptInstance> > > ScriptInstanceArraies;
 	typedef Util::Array< GPtr<ScriptInstance> > ScriptInstances;
 }
@@ -53,6 +53,7 @@ namespace App
 		ScriptInstance()
 			: m_pOwner( NULL )
 			, m_pArrEntryMethods( NULL )
+			, m_pArrEntryThunks( NULL )
 			, m_pMonoObj( NULL )
 			, m_pDicMethods( NULL )
 			, m_pMonoScript()
@@ -106,9 +107,12 @@ namespace App
 		void HandleMessage( const TScriptMessagePtr& msg );
 	private:
 		MonoObject* invokeScript(EEntryMethodIndex methodIndex, void** params = NULL);
+		/// call a parameterless entry through its unmanaged thunk, fall back to invokeScript
+		void invokeEntry(EEntryMethodIndex methodIndex);
 
 		Actor*				m_pOwner;					///< - owner of this script					
 		TMonoMethodArray*	m_pArrEntryMethods;			///< - methods which will be call by engine
+		TMonoThunkArray*	m_pArrEntryThunks;			///< - direct call thunks of m_pArrEntryMethods
 		TMonoMethodMap*	    m_pDicMethods;				///< - all method of a script, get from mono script,temp code
 		MonoObject*			m_pMonoObj;					///< - script instance on Mono side	
 		TMonoScriptPtr		m_pMonoScript;				///< - mono script which init this class
@@ -171,6 +175,26 @@ namespace App
 		}
 		return NULL;
 	}
+	//------------------------------------------------------------------------
+	inline void ScriptInstance::invokeEntry(EEntryMethodIndex methodIndex)
+	{
+		if ( IsInit() )
+		{
+			TMonoEntryThunk pThunk = m_pArrEntryThunks->operator[]( methodIndex );
+			if ( pThunk )
+			{
+				MonoObject* exc = NULL;
+				pThunk( m_pMonoObj, &exc );
+				if ( exc!=NULL )
+				{
+					Util::String error = Utility_ExceptionToString( exc );
+					n_warning( error.AsCharPtr() );
+				}
+				return;
+			}
+			invokeScript( methodIndex );
+		}
+	}
 }
 
 #endif // - __SCRIPT_INSTANCE_H__
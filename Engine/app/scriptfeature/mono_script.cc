@@ -42,9 +42,11 @@ namespace App
 		, m_pMonoClass( NULL )
 		, m_dicMethods()
 		, m_arrEntryMethods( EEntryMethodIndex_Num, EEntryMethodIndex_Num )
+		, m_arrEntryThunks( EEntryMethodIndex_Num, EEntryMethodIndex_Num )
 		, m_dicRegistedMessageHandler()
 	{
 		m_arrEntryMethods.Resize( EEntryMethodIndex_Num, NULL );
+		m_arrEntryThunks.Resize( EEntryMethodIndex_Num, NULL );
 	}
 	//------------------------------------------------------------------------
 	MonoScript::~MonoScript()
@@ -96,6 +98,9 @@ namespace App
 		m_pMonoClass = pMonoClass;
 		GetEntryMethods( pMonoClass, pScriptableClass );
 
+		// - build direct call thunks for the per frame entries
+		GetEntryThunks();
+
 		// - get message handler,if it has
 		GetMessageHandlerMethods( pMonoClass );
 
@@ -186,6 +191,25 @@ namespace App
 		}
 	}
 	//------------------------------------------------------------------------
+	void MonoScript::GetEntryThunks( void )
+	{
+		for ( IndexT idx=0; idx<EEntryMethodIndex_Num; idx++ )
+		{
+			// - entries with parameters keep going through mono_runtime_invoke
+			if ( EEntryMethodIndex_OnRenderPostEffect==idx ||
+				EEntryMethodIndex_OnWillRenderObject==idx )
+			{
+				continue;
+			}
+
+			MonoMethod* pMethod = m_arrEntryMethods[idx];
+			if ( NULL!=pMethod )
+			{
+				m_arrEntryThunks[idx] = (TMonoEntryThunk)mono_method_get_unmanaged_thunk( pMethod );
+			}
+		}
+	}
+	//------------------------------------------------------------------------
 	void MonoScript::GetMessageHandlerMethods( MonoClass* pMonoClass )
 	{
 		for ( int ii=0; ii<ScriptMessageCreator::Instance()->GetMessageCount(); ii++ )
@@ -58,6 +58,8 @@ namespace App
 		MonoClass* GetMonoClass();
 		/// get entry methods
 		TMonoMethodArray* GetEntryMethods( void ); 
+		/// get unmanaged thunks of the parameterless entry methods, NULL where there is none
+		TMonoThunkArray* GetEntryThunkArray( void );
 		/// get methods
 		TMonoMethodMap* GetMethods( void );
 		/// get fields
@@ -74,6 +76,8 @@ namespace App
 	private:
 		/// recursively get entry methods,terminate at @pTimlParentClass class
 		void GetEntryMethods( MonoClass* pMonoClass, MonoClass* pTimlParentClass );
+		/// create unmanaged thunks for the entry methods found by GetEntryMethods
+		void GetEntryThunks( void );
 		void GetMessageHandlerMethods( MonoClass* pMonoClass );
 		void GetClassFields( MonoClass* pMonoClass );
 		MonoMethod* GetMethodBySignature( const Util::String& sig ,MonoClass* pMonoClass );
@@ -86,6 +90,7 @@ namespace App
 		MonoClass*			m_pMonoClass;		///< - mono class which this class stands for
 		TMonoMethodMap	    m_dicMethods;		///< - record all the methods of a mono class
 		TMonoMethodArray	m_arrEntryMethods;	///< - record methods which would be call by the C++ side
+		TMonoThunkArray		m_arrEntryThunks;	///< - direct call thunks of m_arrEntryMethods, skip mono_runtime_invoke's boxing
 		TMonoClassFieldMap        m_mapFileds;  ///< - fields of this class
 		ScriptMessageHandlerMap   m_dicRegistedMessageHandler;  ///< - recored registered message handler
 	};
@@ -122,6 +127,11 @@ namespace App
 		return &m_arrEntryMethods; 
 	} 
 	//------------------------------------------------------------------------
+	inline TMonoThunkArray* MonoScript::GetEntryThunkArray( void )
+	{
+		return &m_arrEntryThunks; 
+	} 
+	//------------------------------------------------------------------------
 	inline TMonoMethodMap* MonoScript::GetMethods( void )	
 	{ 
 		return &m_dicMethods;
@@ -51,6 +51,7 @@ namespace App
 
 		// - get Methods from mono script
 		m_pArrEntryMethods = pMonoScript->GetEntryMethods();
+		m_pArrEntryThunks  = pMonoScript->GetEntryThunkArray();
 		m_pDicMethods  	   = pMonoScript->GetMethods(); 
 
 		// - get registed message method
@@ -115,37 +116,37 @@ namespace App
 	//------------------------------------------------------------------------	
 	void ScriptInstance::OnBeginFrame( void )
 	{
-		invokeScript(EEntryMethodIndex_OnBeginFrame);
+		invokeEntry(EEntryMethodIndex_OnBeginFrame);
 	}
 	//------------------------------------------------------------------------
 	void ScriptInstance::OnFrame( void )
 	{
-		invokeScript(EEntryMethodIndex_OnFrame);
+		invokeEntry(EEntryMethodIndex_OnFrame);
 	}
 	//------------------------------------------------------------------------
 	void ScriptInstance::OnEndFrame( void )
 	{
-		invokeScript(EEntryMethodIndex_OnEndFrame);
+		invokeEntry(EEntryMethodIndex_OnEndFrame);
 	}
 	//------------------------------------------------------------------------
 	void ScriptInstance::OnLoad( void )
 	{
-		invokeScript(EEntryMethodIndex_OnLoad);
+		invokeEntry(EEntryMethodIndex_OnLoad);
 	}
 	//------------------------------------------------------------------------
 	void ScriptInstance::OnExit( void )
 	{
-		invokeScript(EEntryMethodIndex_OnExit);
+		invokeEntry(EEntryMethodIndex_OnExit);
 	}
 	//------------------------------------------------------------------------
 	void ScriptInstance::OnStopped( void )
 	{
-		invokeScript(EEntryMethodIndex_OnStopped);
+		invokeEntry(EEntryMethodIndex_OnStopped);
 	}
 	//------------------------------------------------------------------------
 	void ScriptInstance::OnResumed( void )
 	{
-		invokeScript(EEntryMethodIndex_OnResumed);
+		invokeEntry(EEntryMethodIndex_OnResumed);
 	}
 	//------------------------------------------------------------------------
 	void ScriptInstance::OnWillRenderObject( RenderComponent* renderComponent )
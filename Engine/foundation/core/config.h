@@ -179,6 +179,18 @@ static const int JobMaxSliceSize = 0x3FFF;
 #define NEBULA3_ENABLE_PROFILING (0)
 #endif
 
+// enable/disable the hierarchical zone profiler (see Debug::ZoneProfiler),
+// cheap enough to stay on in public builds, recording can be switched off at runtime
+#define NEBULA3_ENABLE_ZONE_PROFILING (1)
+
+// enable/disable rvalue references (move constructors / move assignment) in the
+// container and smart pointer classes, VS2010 and gcc in c++0x mode support them
+#if (defined(_MSC_VER) && (_MSC_VER >= 1600)) || defined(__GXX_EXPERIMENTAL_CXX0X__) || (__cplusplus >= 201103L)
+#define NEBULA3_MOVE_SEMANTICS (1)
+#else
+#define NEBULA3_MOVE_SEMANTICS (0)
+#endif
+
 // max length of a path name
 #define NEBULA3_MAXPATH (512)
 
@@ -61,10 +61,18 @@ public:
     GPtr(TYPE* p);
     /// construct from smart pointer
     GPtr(const GPtr<TYPE>& p);
+    #if NEBULA3_MOVE_SEMANTICS
+    /// move constructor, takes over the reference without touching the refcount
+    GPtr(GPtr<TYPE>&& p);
+    #endif
     /// destructor
     ~GPtr();
     /// assignment operator
     void operator=(const GPtr<TYPE>& rhs);
+    #if NEBULA3_MOVE_SEMANTICS
+    /// move assignment operator, takes over the reference without touching the refcount
+    void operator=(GPtr<TYPE>&& rhs);
+    #endif
     /// assignment operator
     void operator=(TYPE* rhs);
     /// equality operator
@@ -143,6 +151,18 @@ GPtr<TYPE>::GPtr(const GPtr<TYPE>& p) :
     }
 }
 
+#if NEBULA3_MOVE_SEMANTICS
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE>
+GPtr<TYPE>::GPtr(GPtr<TYPE>&& p) :
+    ptr(p.ptr)
+{
+    p.ptr = 0;
+}
+#endif
+
 //------------------------------------------------------------------------------
 /**
 */
@@ -177,6 +197,26 @@ GPtr<TYPE>::operator=(const GPtr<TYPE>& rhs)
     }
 }
 
+#if NEBULA3_MOVE_SEMANTICS
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE>
+void
+GPtr<TYPE>::operator=(GPtr<TYPE>&& rhs)
+{
+    if (this != &rhs)
+    {
+        if (this->ptr)
+        {
+            this->ptr->Release();
+        }
+        this->ptr = rhs.ptr;
+        rhs.ptr = 0;
+    }
+}
+#endif
+
 //------------------------------------------------------------------------------
 /**
 */
@@ -27,6 +27,7 @@ THE SOFTWARE.
 #include "core/rtti.h"
 #include "core/refcounted.h"
 #include "core/sysfunc.h"
+#include "threading/criticalsection.h"
 
 #if NEBULA3_OBJECTS_USE_MEMORYPOOL
 #include "memory/poolarrayallocator.h"
@@ -56,6 +57,10 @@ Rtti::Construct(const char* className, FourCC fcc, Creator creatorFunc, const Rt
     this->fourCC = fcc;     // NOTE: may be 0
     this->creator = creatorFunc;
     this->instanceSize = instSize;
+    this->cachedInstances = 0;
+    this->numCachedInstances = 0;
+    this->maxCachedInstances = 0;
+    this->cacheLock = 0;
 
     // register class with factory
     this->name = className;
@@ -194,6 +199,22 @@ Rtti::IsDerivedFrom(const Util::FourCC& otherClassFourCC) const
 void*
 Rtti::AllocInstanceMemory()
 {
+    if (0 != this->cacheLock)
+    {
+        this->cacheLock->Enter();
+        CachedInstance* cached = this->cachedInstances;
+        if (0 != cached)
+        {
+            this->cachedInstances = cached->next;
+            this->numCachedInstances--;
+        }
+        this->cacheLock->Leave();
+        if (0 != cached)
+        {
+            return cached;
+        }
+    }
+
     #if NEBULA3_OBJECTS_USE_MEMORYPOOL    
     void* ptr = Memory::ObjectPoolAllocator->Alloc(this->instanceSize);
     #else
@@ -208,6 +229,24 @@ Rtti::AllocInstanceMemory()
 void
 Rtti::FreeInstanceMemory(void* ptr)
 {
+    if (0 != this->cacheLock)
+    {
+        this->cacheLock->Enter();
+        if (this->numCachedInstances < this->maxCachedInstances)
+        {
+            CachedInstance* cached = (CachedInstance*)ptr;
+            cached->next = this->cachedInstances;
+            this->cachedInstances = cached;
+            this->numCachedInstances++;
+            ptr = 0;
+        }
+        this->cacheLock->Leave();
+        if (0 == ptr)
+        {
+            return;
+        }
+    }
+
     #if NEBULA3_OBJECTS_USE_MEMORYPOOL
     Memory::ObjectPoolAllocator->Free(ptr, this->instanceSize);
     #else
@@ -215,4 +254,61 @@ Rtti::FreeInstanceMemory(void* ptr)
     #endif
 }
 
+//------------------------------------------------------------------------------
+/**
+    Short lived objects which are created over and over (messages mainly)
+    can keep their freed memory blocks in a per-class free list, so that
+    Create() doesn't go through the heap every time. The lock is created
+    on first use and kept for the lifetime of the class, setting the size
+    to 0 only stops caching new blocks.
+*/
+void
+Rtti::SetInstanceCacheSize(SizeT maxInstances)
+{
+    n_assert(maxInstances >= 0);
+    n_assert(this->instanceSize >= sizeof(CachedInstance));
+    if ((0 == this->cacheLock) && (maxInstances > 0))
+    {
+        this->cacheLock = n_new(Threading::CriticalSection);
+    }
+    if (0 != this->cacheLock)
+    {
+        this->cacheLock->Enter();
+        this->maxCachedInstances = maxInstances;
+        this->cacheLock->Leave();
+        if (this->numCachedInstances > maxInstances)
+        {
+            this->ReleaseInstanceCache();
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+Rtti::ReleaseInstanceCache()
+{
+    if (0 == this->cacheLock)
+    {
+        return;
+    }
+    this->cacheLock->Enter();
+    CachedInstance* cached = this->cachedInstances;
+    this->cachedInstances = 0;
+    this->numCachedInstances = 0;
+    this->cacheLock->Leave();
+
+    while (0 != cached)
+    {
+        CachedInstance* next = cached->next;
+        #if NEBULA3_OBJECTS_USE_MEMORYPOOL
+        Memory::ObjectPoolAllocator->Free(cached, this->instanceSize);
+        #else
+        Memory::Free(Memory::ObjectHeap, cached);
+        #endif
+        cached = next;
+    }
+}
+
 } // namespace Core
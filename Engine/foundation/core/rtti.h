@@ -42,6 +42,11 @@ THE SOFTWARE.
 #include "util/fourcc.h"
 
 //------------------------------------------------------------------------------
+namespace Threading
+{
+class CriticalSection;
+}
+
 namespace Core
 {
 class RefCounted;
@@ -79,6 +84,12 @@ public:
     void* AllocInstanceMemory();
     /// free instance memory block (called by class delete operator)
     void FreeInstanceMemory(void* ptr);
+    /// keep up to maxInstances freed instance blocks in a free list for reuse (0 disables)
+    void SetInstanceCacheSize(SizeT maxInstances);
+    /// get the maximum number of cached instance blocks
+    SizeT GetInstanceCacheSize() const;
+    /// return the cached instance blocks to the heap
+    void ReleaseInstanceCache();
 
 private:
     /// constructor method, called from the various constructors
@@ -89,6 +100,15 @@ private:
     Util::FourCC fourCC;
     Creator creator;
     SizeT instanceSize;
+
+    struct CachedInstance
+    {
+        CachedInstance* next;
+    };
+    CachedInstance* cachedInstances;
+    SizeT numCachedInstances;
+    SizeT maxCachedInstances;
+    Threading::CriticalSection* cacheLock;
 };
 
 //------------------------------------------------------------------------------
@@ -109,6 +129,15 @@ Rtti::operator!=(const Rtti& rhs) const
     return this != &rhs;
 }
 
+//------------------------------------------------------------------------------
+/**
+*/
+inline SizeT
+Rtti::GetInstanceCacheSize() const
+{
+    return this->maxCachedInstances;
+}
+
 //------------------------------------------------------------------------------
 /**
 */
@@ -133,6 +133,62 @@ inline T BIT_FlAG_DELETE(T x, T2 flag)
 	return (T)(((T)x) & (~((T)flag)));
 }
 
+//------------------------------------------------------------------------------
+/**
+    n_move() casts an lvalue to an rvalue reference so the move constructor
+    or move assignment of the target type gets picked. Without compiler
+    support for rvalue references it simply yields the argument, so the
+    code falls back to the copy operations.
+*/
+#if NEBULA3_MOVE_SEMANTICS
+template<typename T> struct n_remove_reference { typedef T type; };
+template<typename T> struct n_remove_reference<T&> { typedef T type; };
+template<typename T> struct n_remove_reference<T&&> { typedef T type; };
+
+template<typename T>
+inline typename n_remove_reference<T>::type&& n_move(T&& t)
+{
+	return static_cast<typename n_remove_reference<T>::type&&>(t);
+}
+#else
+#define n_move(x) (x)
+#endif
+
+//------------------------------------------------------------------------------
+/**
+    TypeIsBitwiseMovable<T>::Value is true if objects of T can be relocated
+    with a plain memory copy, i.e. T has no user-defined copy constructor,
+    assignment operator or destructor. The container classes use this to
+    replace element-wise copying with Memory::Copy(). Types which are
+    not detected by the compiler intrinsics can opt in with
+    __DeclareBitwiseMovable(type).
+*/
+#if (__VC__ || (__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 3)))
+#define N_HAS_TRIVIAL_COPY(T) (__has_trivial_copy(T) && __has_trivial_assign(T) && __has_trivial_destructor(T))
+#else
+#define N_HAS_TRIVIAL_COPY(T) (0)
+#endif
+
+template<typename T> struct TypeIsBitwiseMovable { enum { Value = N_HAS_TRIVIAL_COPY(T) }; };
+template<typename T> struct TypeIsBitwiseMovable<T*> { enum { Value = 1 }; };
+
+#define __DeclareBitwiseMovable(type) \
+template<> struct TypeIsBitwiseMovable<type> { enum { Value = 1 }; };
+
+__DeclareBitwiseMovable(bool)
+__DeclareBitwiseMovable(char)
+__DeclareBitwiseMovable(signed char)
+__DeclareBitwiseMovable(unsigned char)
+__DeclareBitwiseMovable(short)
+__DeclareBitwiseMovable(unsigned short)
+__DeclareBitwiseMovable(int)
+__DeclareBitwiseMovable(unsigned int)
+__DeclareBitwiseMovable(long)
+__DeclareBitwiseMovable(unsigned long)
+__DeclareBitwiseMovable(long long)
+__DeclareBitwiseMovable(unsigned long long)
+__DeclareBitwiseMovable(float)
+__DeclareBitwiseMovable(double)
 
 #if (__PS3__ || __WII__ || __OSX__ || __ANDROID__)
 inline ushort                _byteswap_ushort(ushort x)              { return ((x>>8) | (x<<8)); }
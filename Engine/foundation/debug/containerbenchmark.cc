@@ -0,0 +1,307 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "stdneb.h"
+#include "debug/containerbenchmark.h"
+#include "core/refcounted.h"
+#include "timing/timer.h"
+#include "util/string.h"
+#include "messaging/dispatcher.h"
+#include "io/iointerfaceprotocol.h"
+#include "http/httpprotocol.h"
+
+namespace Debug
+{
+using namespace Util;
+
+//------------------------------------------------------------------------------
+/**
+    A port which only counts the messages it gets.
+*/
+class BenchmarkPort : public Messaging::Port
+{
+    __DeclareClass(BenchmarkPort);
+public:
+    /// constructor
+    BenchmarkPort() : numHandled(0) { }
+    /// accept a message id
+    void Accept(const Messaging::Id& msgId) { this->RegisterMessage(msgId); }
+    /// count the message
+    virtual void HandleMessage(const GPtr<Messaging::Message>& msg) { this->numHandled++; }
+
+    SizeT numHandled;
+};
+__ImplementClass(Debug::BenchmarkPort, 'DBMP', Messaging::Port);
+
+//------------------------------------------------------------------------------
+/**
+    Messages of the foundation protocols, one per id.
+*/
+static void
+MakeMessages(Array<GPtr<Messaging::Message> >& msgs)
+{
+    msgs.Append(IO::CopyFile::Create());
+    msgs.Append(IO::CreateDirectory::Create());
+    msgs.Append(IO::DeleteDirectory::Create());
+    msgs.Append(IO::DeleteFile::Create());
+    msgs.Append(IO::MountArchive::Create());
+    msgs.Append(IO::ReadStream::Create());
+    msgs.Append(IO::WriteStream::Create());
+    msgs.Append(IO::UseFileService::Create());
+    msgs.Append(Http::AttachRequestHandler::Create());
+    msgs.Append(Http::RemoveRequestHandler::Create());
+}
+
+//------------------------------------------------------------------------------
+/**
+    Builds a string which does not fit into the local buffer of Util::String,
+    so copies of it hit the string heap.
+*/
+static String
+MakeHeapString(IndexT i)
+{
+    String str;
+    str.Format("benchmark/resources/some/longer/path/%08d.mesh", i);
+    return str;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+static void
+AddResult(Array<ContainerBenchmark::Result>& results, const char* name, SizeT iterations, const Timing::Timer& timer)
+{
+    ContainerBenchmark::Result& result = results.EmplaceBack();
+    result.name = name;
+    result.iterations = iterations;
+    result.time = timer.GetTime();
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+Array<ContainerBenchmark::Result>
+ContainerBenchmark::Run(SizeT scale)
+{
+    n_assert(scale > 0);
+    Array<Result> results;
+    Timing::Timer timer;
+    IndexT i;
+
+    // growing an array of builtin types, relocation is a single memory copy
+    {
+        const SizeT num = 1000000 * scale;
+        timer.Reset();
+        timer.Start();
+        Array<int> ints;
+        for (i = 0; i < num; i++)
+        {
+            ints.Append(i);
+        }
+        timer.Stop();
+        AddResult(results, "Array<int>::Append", num, timer);
+    }
+
+    // growing an array of smart pointers, every relocation touches the refcount unless moved
+    {
+        const SizeT num = 100000 * scale;
+        GPtr<Core::RefCounted> obj = Core::RefCounted::Create();
+        timer.Reset();
+        timer.Start();
+        Array<GPtr<Core::RefCounted> > ptrs;
+        for (i = 0; i < num; i++)
+        {
+            ptrs.Append(obj);
+        }
+        timer.Stop();
+        AddResult(results, "Array<GPtr>::Append", num, timer);
+    }
+
+    // growing an array of heap strings, every relocation allocates unless moved
+    {
+        const SizeT num = 100000 * scale;
+        String str = MakeHeapString(0);
+        timer.Reset();
+        timer.Start();
+        Array<String> strings;
+        for (i = 0; i < num; i++)
+        {
+            strings.Append(str);
+        }
+        timer.Stop();
+        AddResult(results, "Array<String>::Append", num, timer);
+    }
+
+    // appending temporaries, the argument is moved into the array if possible
+    {
+        const SizeT num = 100000 * scale;
+        timer.Reset();
+        timer.Start();
+        Array<String> strings;
+        for (i = 0; i < num; i++)
+        {
+            strings.Append(MakeHeapString(i));
+        }
+        timer.Stop();
+        AddResult(results, "Array<String>::Append(temp)", num, timer);
+    }
+
+    // filling elements in place
+    {
+        const SizeT num = 100000 * scale;
+        timer.Reset();
+        timer.Start();
+        Array<String> strings;
+        for (i = 0; i < num; i++)
+        {
+            strings.EmplaceBack().Format("benchmark/resources/some/longer/path/%08d.mesh", i);
+        }
+        timer.Stop();
+        AddResult(results, "Array<String>::EmplaceBack", num, timer);
+    }
+
+    // erasing from the front shifts all remaining elements down
+    {
+        const SizeT num = 5000 * scale;
+        Array<String> strings(num, 0);
+        for (i = 0; i < num; i++)
+        {
+            strings.Append(MakeHeapString(i));
+        }
+        timer.Reset();
+        timer.Start();
+        while (strings.Size() > 0)
+        {
+            strings.EraseIndex(0);
+        }
+        timer.Stop();
+        AddResult(results, "Array<String>::EraseIndex(0)", num, timer);
+    }
+
+    // copying a whole array of builtin types
+    {
+        const SizeT num = 1000 * scale;
+        Array<float> floats(4096, 0, 1.0f);
+        timer.Reset();
+        timer.Start();
+        for (i = 0; i < num; i++)
+        {
+            Array<float> copy(floats);
+            n_assert(copy.Size() == floats.Size());
+        }
+        timer.Stop();
+        AddResult(results, "Array<float>::Copy", num, timer);
+    }
+
+    // looking up ids in the sorted accepted id array of a port, half of them are not accepted
+    {
+        const SizeT num = 1000000 * scale;
+        Array<GPtr<Messaging::Message> > msgs;
+        MakeMessages(msgs);
+        GPtr<BenchmarkPort> port = BenchmarkPort::Create();
+        for (i = 0; i < msgs.Size(); i += 2)
+        {
+            port->Accept(msgs[i]->GetId());
+        }
+        SizeT accepted = 0;
+        timer.Reset();
+        timer.Start();
+        for (i = 0; i < num; i++)
+        {
+            if (port->AcceptsMessage(msgs[i % msgs.Size()]->GetId()))
+            {
+                accepted++;
+            }
+        }
+        timer.Stop();
+        n_assert(accepted > 0);
+        AddResult(results, "Port::AcceptsMessage", num, timer);
+    }
+
+    // distributing messages to the ports interested in their id
+    {
+        const SizeT num = 1000000 * scale;
+        Array<GPtr<Messaging::Message> > msgs;
+        MakeMessages(msgs);
+        GPtr<Messaging::Dispatcher> dispatcher = Messaging::Dispatcher::Create();
+        Array<GPtr<BenchmarkPort> > ports;
+        IndexT p;
+        for (p = 0; p < 8; p++)
+        {
+            GPtr<BenchmarkPort> port = BenchmarkPort::Create();
+            for (i = p % 3; i < msgs.Size(); i += 3)
+            {
+                port->Accept(msgs[i]->GetId());
+            }
+            dispatcher->AttachPort(port.upcast<Messaging::Port>());
+            ports.Append(port);
+        }
+        timer.Reset();
+        timer.Start();
+        for (i = 0; i < num; i++)
+        {
+            dispatcher->HandleMessage(msgs[i % msgs.Size()]);
+        }
+        timer.Stop();
+        n_assert(ports[0]->numHandled > 0);
+        for (p = 0; p < ports.Size(); p++)
+        {
+            dispatcher->RemovePort(ports[p].upcast<Messaging::Port>());
+        }
+        AddResult(results, "Dispatcher::HandleMessage", num, timer);
+    }
+
+    // creating and releasing messages, the memory comes from the instance cache of the class
+    {
+        const SizeT num = 100000 * scale;
+        timer.Reset();
+        timer.Start();
+        for (i = 0; i < num; i++)
+        {
+            GPtr<IO::ReadStream> msg = IO::ReadStream::Create();
+            msg->SetHandled(true);
+        }
+        timer.Stop();
+        AddResult(results, "Message::Create", num, timer);
+    }
+
+    return results;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+ContainerBenchmark::Print(const Array<Result>& results)
+{
+    n_printf("ContainerBenchmark (move semantics %s):\n", NEBULA3_MOVE_SEMANTICS ? "on" : "off");
+    IndexT i;
+    for (i = 0; i < results.Size(); i++)
+    {
+        const Result& result = results[i];
+        n_printf("  %-32s %8d iterations %10.3f ms\n", result.name, result.iterations, result.time * 1000.0);
+    }
+}
+
+} // namespace Debug
@@ -0,0 +1,65 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Debug::ContainerBenchmark
+    
+    Micro benchmarks for the Util containers, GPtr and String. Every case
+    is a small loop of the kind the engine runs per frame (appending 
+    visibility results, growing resource lists, erasing from the front 
+    of a queue...) and is measured with a Timing::Timer. Use it to compare
+    builds with and without NEBULA3_MOVE_SEMANTICS, or before and after
+    changes to the container classes.
+
+    The message cases measure the id lookups of the messaging system:
+    Port::AcceptsMessage, Dispatcher::HandleMessage and creating messages
+    through the per class instance cache.
+*/
+#include "core/types.h"
+#include "util/array.h"
+#include "timing/time.h"
+
+//------------------------------------------------------------------------------
+namespace Debug
+{
+class ContainerBenchmark
+{
+public:
+    /// result of a single benchmark case
+    struct Result
+    {
+        const char* name;
+        SizeT iterations;
+        Timing::Time time;
+    };
+
+    /// run all benchmark cases, scale multiplies the iteration counts
+    static Util::Array<Result> Run(SizeT scale = 1);
+    /// write results to the log
+    static void Print(const Util::Array<Result>& results);
+};
+
+} // namespace Debug
+//------------------------------------------------------------------------------
@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include "debug/debugserver.h"
 #include "debug/debugtimer.h"
 #include "debug/debugcounter.h"
+#include "debug/zoneprofiler.h"
 #include "util/variant.h"
 
 namespace Debug
@@ -41,6 +42,63 @@ using namespace Util;
 using namespace Timing;
 using namespace Math;
 
+//------------------------------------------------------------------------------
+/**
+    Percent-encodes everything but the unreserved characters, so a thread
+    name survives as a single query value.
+*/
+static String
+UrlEncode(const String& str)
+{
+    static const char* hex = "0123456789ABCDEF";
+    String result;
+    IndexT i;
+    for (i = 0; i < str.Length(); i++)
+    {
+        const unsigned char c = (unsigned char)str[i];
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || 
+            c == '-' || c == '_' || c == '.' || c == '~')
+        {
+            result.AppendRange(&str.AsCharPtr()[i], 1);
+        }
+        else
+        {
+            char code[3] = { '%', hex[c >> 4], hex[c & 0xf] };
+            result.AppendRange(code, 3);
+        }
+    }
+    return result;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Reverses UrlEncode(), also accepts '+' for a space. URI::ParseQuery()
+    leaves the values encoded.
+*/
+static String
+UrlDecode(const String& str)
+{
+    String result;
+    const SizeT len = str.Length();
+    IndexT i;
+    for (i = 0; i < len; i++)
+    {
+        char c = str[i];
+        if ('+' == c)
+        {
+            c = ' ';
+        }
+        else if ('%' == c && i + 2 < len && isxdigit((unsigned char)str[i + 1]) && isxdigit((unsigned char)str[i + 2]))
+        {
+            char code[3] = { str[i + 1], str[i + 2], 0 };
+            c = (char)strtol(code, 0, 16);
+            i += 2;
+        }
+        result.AppendRange(&c, 1);
+    }
+    return result;
+}
+
 //------------------------------------------------------------------------------
 /**
 */
@@ -82,6 +140,16 @@ DebugPageHandler::HandleRequest(const GPtr<HttpRequest>& request)
         this->HandleCounterChartRequest(query["counterChart"], request);
         return;
     }
+    else if (query.Contains("zones"))
+    {
+        this->HandleZonesRequest(UrlDecode(query["zones"]), request);
+        return;
+    }
+    else if (query.Contains("zoneTrace"))
+    {
+        this->HandleZoneTraceRequest(request);
+        return;
+    }
     else if (query.Contains("TimerTableSort"))
     {
         this->HandleTableSortRequest(query["TimerTableSort"], request);        
@@ -205,6 +273,34 @@ DebugPageHandler::HandleRequest(const GPtr<HttpRequest>& request)
             }
         htmlWriter->End(HtmlElement::Table);
 
+        // display zone profiler threads
+        htmlWriter->Element(HtmlElement::Heading3, "Zone Profiler");
+        htmlWriter->AddAttr("href", "/debug?zoneTrace=all");
+        htmlWriter->Element(HtmlElement::Anchor, "Download Chrome Trace (chrome://tracing, ui.perfetto.dev)");
+        htmlWriter->LineBreak();
+        htmlWriter->AddAttr("border", "1");
+        htmlWriter->AddAttr("rules", "cols");
+        htmlWriter->Begin(HtmlElement::Table);
+            htmlWriter->AddAttr("bgcolor", "lightsteelblue");
+            htmlWriter->Begin(HtmlElement::TableRow);
+                htmlWriter->Element(HtmlElement::TableHeader, "Thread");
+                htmlWriter->Element(HtmlElement::TableHeader, "Recorded Zones");
+            htmlWriter->End(HtmlElement::TableRow);
+            Array<ZoneProfiler::Event> zoneEvents;
+            for (i = 0; i < ZoneProfiler::GetNumThreads(); i++)
+            {
+                String threadName = ZoneProfiler::GetThreadName(i);
+                ZoneProfiler::CopyEvents(i, zoneEvents);
+                htmlWriter->Begin(HtmlElement::TableRow);
+                    htmlWriter->Begin(HtmlElement::TableData);
+                        htmlWriter->AddAttr("href", "/debug?zones=" + UrlEncode(threadName));
+                        htmlWriter->Element(HtmlElement::Anchor, threadName);
+                    htmlWriter->End(HtmlElement::TableData);
+                    htmlWriter->Element(HtmlElement::TableData, String::FromInt(zoneEvents.Size()));
+                htmlWriter->End(HtmlElement::TableRow);
+            }
+        htmlWriter->End(HtmlElement::Table);
+
         htmlWriter->Close();
         request->SetStatus(HttpStatus::OK);
     }
@@ -433,4 +529,135 @@ DebugPageHandler::HandleTableSortRequest(const Util::String& columnName, const G
     this->sortByColumn = columnName;
     request->SetStatus(HttpStatus::OK);
 }
+
+//------------------------------------------------------------------------------
+/**
+    Displays the zones recorded by a thread during the last complete
+    frames, accumulated by zone name and nesting depth.
+*/
+void
+DebugPageHandler::HandleZonesRequest(const Util::String& threadName, const GPtr<Http::HttpRequest>& request)
+{
+    IndexT threadIndex;
+    for (threadIndex = 0; threadIndex < ZoneProfiler::GetNumThreads(); threadIndex++)
+    {
+        if (threadName == ZoneProfiler::GetThreadName(threadIndex))
+        {
+            break;
+        }
+    }
+    if (threadIndex == ZoneProfiler::GetNumThreads())
+    {
+        request->SetStatus(HttpStatus::NotFound);
+        return;
+    }
+
+    // accumulate zones by name, skip the current (incomplete) frame
+    Array<ZoneProfiler::Event> events;
+    ZoneProfiler::CopyEvents(threadIndex, events);
+    uint curFrame = ZoneProfiler::GetFrameIndex();
+    uint firstFrame = curFrame;
+    Dictionary<String, IndexT> zoneIndices;
+    Array<String> zoneNames;
+    Array<uint> zoneDepths;
+    Array<int> zoneCalls;
+    Array<uint64> zoneTicks;
+    Array<uint64> zoneMaxTicks;
+    IndexT i;
+    for (i = 0; i < events.Size(); i++)
+    {
+        const ZoneProfiler::Event& event = events[i];
+        if (event.frame == curFrame)
+        {
+            continue;
+        }
+        firstFrame = n_min(firstFrame, event.frame);
+        String key;
+        key.Format("%d:%s", event.depth, event.name);
+        IndexT zoneIndex = zoneIndices.FindIndex(key);
+        if (InvalidIndex == zoneIndex)
+        {
+            zoneIndices.Add(key, zoneNames.Size());
+            zoneNames.Append(event.name);
+            zoneDepths.Append(event.depth);
+            zoneCalls.Append(0);
+            zoneTicks.Append(0);
+            zoneMaxTicks.Append(0);
+            zoneIndex = zoneNames.Size() - 1;
+        }
+        else
+        {
+            zoneIndex = zoneIndices.ValueAtIndex(zoneIndex);
+        }
+        uint64 ticks = event.endTicks - event.beginTicks;
+        zoneCalls[zoneIndex]++;
+        zoneTicks[zoneIndex] += ticks;
+        zoneMaxTicks[zoneIndex] = n_max(zoneMaxTicks[zoneIndex], ticks);
+    }
+    int numFrames = n_max(int(curFrame - firstFrame), 1);
+
+    GPtr<HtmlPageWriter> htmlWriter = HtmlPageWriter::Create();
+    htmlWriter->SetStream(request->GetResponseContentStream());
+    htmlWriter->SetTitle("Genesis Zone Profiler Info");
+    if (htmlWriter->Open())
+    {
+        htmlWriter->Element(HtmlElement::Heading1, "Zones: " + threadName);
+        htmlWriter->AddAttr("href", "/index.html");
+        htmlWriter->Element(HtmlElement::Anchor, "Home");
+        htmlWriter->LineBreak();
+        htmlWriter->AddAttr("href", "/debug");
+        htmlWriter->Element(HtmlElement::Anchor, "Debug Subsystem Home");
+        htmlWriter->LineBreak();
+        htmlWriter->Text("Frames: " + String::FromInt(numFrames));
+
+        htmlWriter->AddAttr("border", "1");
+        htmlWriter->AddAttr("rules", "cols");
+        htmlWriter->Begin(HtmlElement::Table);
+            htmlWriter->AddAttr("bgcolor", "lightsteelblue");
+            htmlWriter->Begin(HtmlElement::TableRow);
+                htmlWriter->Element(HtmlElement::TableHeader, "Zone");
+                htmlWriter->Element(HtmlElement::TableHeader, "Depth");
+                htmlWriter->Element(HtmlElement::TableHeader, "Calls/Frame");
+                htmlWriter->Element(HtmlElement::TableHeader, "ms/Frame");
+                htmlWriter->Element(HtmlElement::TableHeader, "Max ms");
+            htmlWriter->End(HtmlElement::TableRow);
+            for (i = 0; i < zoneNames.Size(); i++)
+            {
+                double msPerFrame = ZoneProfiler::TicksToMicroseconds(zoneTicks[i]) / (1000.0 * numFrames);
+                double maxMs = ZoneProfiler::TicksToMicroseconds(zoneMaxTicks[i]) / 1000.0;
+                htmlWriter->Begin(HtmlElement::TableRow);
+                    htmlWriter->Element(HtmlElement::TableData, zoneNames[i]);
+                    htmlWriter->Element(HtmlElement::TableData, String::FromInt(zoneDepths[i]));
+                    htmlWriter->Element(HtmlElement::TableData, String::FromFloat(float(zoneCalls[i]) / numFrames));
+                    htmlWriter->Element(HtmlElement::TableData, String::FromFloat(float(msPerFrame)));
+                    htmlWriter->Element(HtmlElement::TableData, String::FromFloat(float(maxMs)));
+                htmlWriter->End(HtmlElement::TableRow);
+            }
+        htmlWriter->End(HtmlElement::Table);
+        htmlWriter->Close();
+        request->SetStatus(HttpStatus::OK);
+    }
+    else
+    {
+        request->SetStatus(HttpStatus::InternalServerError);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+DebugPageHandler::HandleZoneTraceRequest(const GPtr<Http::HttpRequest>& request)
+{
+    const GPtr<IO::Stream>& stream = request->GetResponseContentStream();
+    stream->SetMediaType(IO::MediaType("application/json"));
+    if (ZoneProfiler::WriteChromeTrace(stream))
+    {
+        request->SetStatus(HttpStatus::OK);
+    }
+    else
+    {
+        request->SetStatus(HttpStatus::InternalServerError);
+    }
+}
 } // namespace Debug
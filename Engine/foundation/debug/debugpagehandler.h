@@ -62,6 +62,10 @@ private:
     void HandleCounterChartRequest(const Util::String& counterName, const GPtr<Http::HttpRequest>& request);
     /// handle HTTP request to sort table
     void HandleTableSortRequest(const Util::String& columnName, const GPtr<Http::HttpRequest>& request);
+    /// handle HTTP request for the zone profiler summary of a thread
+    void HandleZonesRequest(const Util::String& threadName, const GPtr<Http::HttpRequest>& request);
+    /// handle HTTP request to export the zone profiler events as Chrome trace json
+    void HandleZoneTraceRequest(const GPtr<Http::HttpRequest>& request);
 
     Util::String sortByColumn;
 };
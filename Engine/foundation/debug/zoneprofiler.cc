@@ -0,0 +1,439 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "stdneb.h"
+#include "debug/zoneprofiler.h"
+#include "threading/criticalsection.h"
+#include "threading/ThreadRuntimeInfo.h"
+#include "timing/timer.h"
+#if __OSX__
+#include <mach/mach_time.h>
+#endif
+
+#if __VC__
+#define __zone_threadlocal __declspec(thread)
+#else
+#define __zone_threadlocal __thread
+#endif
+
+// use the cpu time stamp counter where available, it is by far the cheapest clock
+#if (__VC__ && (defined(_M_IX86) || defined(_M_X64))) || (__GNUC__ && (defined(__i386__) || defined(__x86_64__)))
+#define __zone_use_tsc (1)
+#if __GNUC__
+#include <x86intrin.h>
+#endif
+#else
+#define __zone_use_tsc (0)
+#endif
+
+namespace Debug
+{
+using namespace Util;
+
+static __zone_threadlocal ZoneProfiler::ThreadBuffer* curThreadBuffer = 0;
+static ZoneProfiler::ThreadBuffer* threadBuffers[ZoneProfiler::MaxThreads] = { 0 };
+static volatile int numThreadBuffers = 0;
+static volatile int zoneProfilerEnabled = 1;
+static volatile int frameIndex = 0;
+static Threading::CriticalSection registryCritSect;
+// shared by all threads beyond MaxThreads, never read back
+static ZoneProfiler::ThreadBuffer overflowBuffer;
+
+#if __zone_use_tsc
+// reference points for converting tsc ticks into timer microseconds,
+// the tick rate is measured against the system timer over the entire run time
+static uint64 refTsc = __rdtsc();
+static Timing::MicrosecondTick refMicroseconds = Timing::Timer::GetusTicks();
+#endif
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+ZoneProfiler::SetEnabled(bool b)
+{
+    zoneProfilerEnabled = b ? 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+bool
+ZoneProfiler::IsEnabled()
+{
+    return 0 != zoneProfilerEnabled;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+uint64
+ZoneProfiler::GetTicks()
+{
+#if __zone_use_tsc
+    return __rdtsc();
+#elif __WIN32__
+    __int64 time;
+    QueryPerformanceCounter((LARGE_INTEGER*) &time);
+    return (uint64) time;
+#elif __OSX__
+    return mach_absolute_time();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64(ts.tv_sec) * 1000000000 + uint64(ts.tv_nsec);
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+uint64
+ZoneProfiler::GetTicksPerSecond()
+{
+#if __zone_use_tsc
+    Timing::MicrosecondTick elapsedMicroseconds = Timing::Timer::GetusTicks() - refMicroseconds;
+    uint64 elapsedTicks = __rdtsc() - refTsc;
+    if (elapsedMicroseconds < 1000)
+    {
+        // not enough samples to measure the rate yet, assume 1 GHz
+        return 1000000000;
+    }
+    return uint64(double(elapsedTicks) * 1000000.0 / double(elapsedMicroseconds));
+#elif __WIN32__
+    __int64 freq;
+    QueryPerformanceFrequency((LARGE_INTEGER*) &freq);
+    return (uint64) freq;
+#elif __OSX__
+    mach_timebase_info_data_t info;
+    mach_timebase_info(&info);
+    return uint64(1000000000.0 * double(info.denom) / double(info.numer));
+#else
+    return 1000000000;
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+double
+ZoneProfiler::TicksToMicroseconds(uint64 ticks)
+{
+    return double(ticks) * 1000000.0 / double(GetTicksPerSecond());
+}
+
+//------------------------------------------------------------------------------
+/**
+    Creates the calling thread's buffer and adds it to the registry. Buffers
+    are never freed, so readers may access them without synchronization
+    even after their thread has finished.
+*/
+ZoneProfiler::ThreadBuffer*
+ZoneProfiler::CreateThreadBuffer()
+{
+    ThreadBuffer* buffer = 0;
+    registryCritSect.Enter();
+    if (numThreadBuffers < MaxThreads)
+    {
+        buffer = (ThreadBuffer*) Memory::Alloc(Memory::DefaultHeap, sizeof(ThreadBuffer));
+        Memory::Clear(buffer, sizeof(ThreadBuffer));
+        buffer->threadIndex = numThreadBuffers;
+
+        // default to the Nebula thread name
+        Threading::ThreadRunTimeInfo* info = Threading::ThreadRunTimeInfo::GetMyThreadRuntime();
+        String name;
+        if (info && info->mThreadName)
+        {
+            name = info->mThreadName;
+        }
+        else
+        {
+            name.Format("Thread %d", numThreadBuffers);
+        }
+        name.CopyToBuffer(buffer->threadName, sizeof(buffer->threadName));
+        threadBuffers[numThreadBuffers] = buffer;
+        numThreadBuffers++;
+    }
+    registryCritSect.Leave();
+    if (0 == buffer)
+    {
+        n_warning("ZoneProfiler: too many threads, zones of this thread will not be recorded!\n");
+        buffer = &overflowBuffer;
+    }
+    return buffer;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline ZoneProfiler::ThreadBuffer*
+ZoneProfiler::GetThreadBuffer()
+{
+    ThreadBuffer* buffer = curThreadBuffer;
+    if (0 == buffer)
+    {
+        buffer = CreateThreadBuffer();
+        curThreadBuffer = buffer;
+    }
+    return buffer;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Open a zone. If recording is disabled, the zone is still pushed (with
+    a null name) so that the matching EndZone() stays balanced.
+*/
+void
+ZoneProfiler::BeginZone(const char* name)
+{
+    ThreadBuffer* buffer = GetThreadBuffer();
+    if (&overflowBuffer == buffer)
+    {
+        return;
+    }
+    uint depth = buffer->depth++;
+    if (depth < (uint)ThreadBuffer::MaxDepth)
+    {
+        buffer->openNames[depth] = zoneProfilerEnabled ? name : 0;
+        buffer->openTicks[depth] = GetTicks();
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Close the most recent zone and write it into the thread's ring buffer.
+    The event is completely written before the write counter is published,
+    so readers never see half written events.
+*/
+void
+ZoneProfiler::EndZone()
+{
+    ThreadBuffer* buffer = curThreadBuffer;
+    if (&overflowBuffer == buffer)
+    {
+        return;
+    }
+    n_assert(0 != buffer && buffer->depth > 0);
+    uint depth = --buffer->depth;
+    if (depth < (uint)ThreadBuffer::MaxDepth && 0 != buffer->openNames[depth])
+    {
+        uint index = buffer->numWritten;
+        Event& event = buffer->events[index & (ThreadBuffer::Capacity - 1)];
+        event.name = buffer->openNames[depth];
+        event.beginTicks = buffer->openTicks[depth];
+        event.endTicks = GetTicks();
+        event.depth = depth;
+        event.frame = frameIndex;
+#if __GNUC__
+        __atomic_store_n(&buffer->numWritten, index + 1, __ATOMIC_RELEASE);
+#else
+        // volatile stores have release semantics with the Microsoft compiler
+        buffer->numWritten = index + 1;
+#endif
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+ZoneProfiler::SetThreadName(const char* name)
+{
+    n_assert(0 != name);
+    ThreadBuffer* buffer = GetThreadBuffer();
+    String(name).CopyToBuffer(buffer->threadName, sizeof(buffer->threadName));
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+ZoneProfiler::NextFrame()
+{
+    frameIndex++;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+uint
+ZoneProfiler::GetFrameIndex()
+{
+    return frameIndex;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+SizeT
+ZoneProfiler::GetNumThreads()
+{
+    return numThreadBuffers;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+const char*
+ZoneProfiler::GetThreadName(IndexT threadIndex)
+{
+    n_assert(threadIndex >= 0 && threadIndex < numThreadBuffers);
+    return threadBuffers[threadIndex]->threadName;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Takes a snapshot of a thread's ring buffer. The owner thread keeps
+    writing while we copy, so every event which may have been overwritten
+    during the copy is dropped afterwards.
+*/
+void
+ZoneProfiler::CopyEvents(IndexT threadIndex, Array<Event>& outEvents)
+{
+    n_assert(threadIndex >= 0 && threadIndex < numThreadBuffers);
+    const ThreadBuffer* buffer = threadBuffers[threadIndex];
+    const uint mask = ThreadBuffer::Capacity - 1;
+
+    uint end = buffer->numWritten;
+    uint begin = (end > (uint)ThreadBuffer::Capacity) ? end - ThreadBuffer::Capacity : 0;
+    Array<Event> snapshot(end - begin + 1, 16);
+    uint i;
+    for (i = begin; i < end; i++)
+    {
+        snapshot.Append(buffer->events[i & mask]);
+    }
+
+    // drop everything the writer may have overwritten in the meantime, including
+    // the slot of the event it may be writing right now
+    uint endAfterCopy = buffer->numWritten;
+    uint firstValid = (endAfterCopy + 1 > (uint)ThreadBuffer::Capacity) ? endAfterCopy + 1 - ThreadBuffer::Capacity : 0;
+    IndexT firstIndex = (firstValid > begin) ? IndexT(firstValid - begin) : 0;
+    outEvents.Clear();
+    IndexT snapshotIndex;
+    for (snapshotIndex = firstIndex; snapshotIndex < snapshot.Size(); snapshotIndex++)
+    {
+        outEvents.Append(snapshot[snapshotIndex]);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Writes the recorded zones of all threads in the Chrome trace event
+    format as "complete" events, plus thread name meta data events.
+*/
+bool
+ZoneProfiler::WriteChromeTrace(const GPtr<IO::Stream>& stream)
+{
+    n_assert(stream.isvalid());
+    bool wasOpen = stream->IsOpen();
+    if (!wasOpen)
+    {
+        stream->SetAccessMode(IO::Stream::WriteAccess);
+        if (!stream->Open())
+        {
+            return false;
+        }
+    }
+
+    uint64 baseTicks = 0;
+#if __zone_use_tsc
+    baseTicks = refTsc;
+#endif
+    double microsecondsPerTick = 1000000.0 / double(GetTicksPerSecond());
+
+    String str;
+    str.Reserve(256);
+    str = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    stream->Write(str.AsCharPtr(), str.Length());
+
+    bool first = true;
+    Array<Event> events;
+    IndexT threadIndex;
+    for (threadIndex = 0; threadIndex < GetNumThreads(); threadIndex++)
+    {
+        str.Format("%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                   first ? "" : ",\n", threadIndex, EscapeJson(GetThreadName(threadIndex)).AsCharPtr());
+        stream->Write(str.AsCharPtr(), str.Length());
+        first = false;
+
+        CopyEvents(threadIndex, events);
+        IndexT i;
+        for (i = 0; i < events.Size(); i++)
+        {
+            const Event& event = events[i];
+            double ts = double(int64(event.beginTicks - baseTicks)) * microsecondsPerTick;
+            double dur = double(event.endTicks - event.beginTicks) * microsecondsPerTick;
+            str.Format(",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%u}}",
+                       EscapeJson(event.name).AsCharPtr(), threadIndex, ts, dur, event.frame);
+            stream->Write(str.AsCharPtr(), str.Length());
+        }
+    }
+    str = "\n]}\n";
+    stream->Write(str.AsCharPtr(), str.Length());
+
+    if (!wasOpen)
+    {
+        stream->Close();
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Escapes quotes, backslashes and control characters. Zone and thread 
+    names are arbitrary strings (Rtti class names, user thread names).
+*/
+String
+ZoneProfiler::EscapeJson(const char* str)
+{
+    n_assert(0 != str);
+    String result;
+    const char* c;
+    for (c = str; *c; c++)
+    {
+        switch (*c)
+        {
+            case '"':   result.Append("\\\""); break;
+            case '\\':  result.Append("\\\\"); break;
+            case '\n':  result.Append("\\n"); break;
+            case '\r':  result.Append("\\r"); break;
+            case '\t':  result.Append("\\t"); break;
+            default:
+                if ((unsigned char)*c < 0x20)
+                {
+                    String code;
+                    code.Format("\\u%04x", (unsigned char)*c);
+                    result.Append(code);
+                }
+                else
+                {
+                    result.AppendRange(c, 1);
+                }
+                break;
+        }
+    }
+    return result;
+}
+
+} // namespace Debug
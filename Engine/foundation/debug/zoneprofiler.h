@@ -0,0 +1,180 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class Debug::ZoneProfiler
+    
+    A hierarchical, thread aware CPU profiler. Code blocks are measured by
+    opening and closing named zones (use the _zone() macro or the
+    Debug::ZoneScope helper), zones may be nested.
+
+    Every thread writes its finished zones into its own fixed size ring
+    buffer, so recording a zone never takes a lock and never allocates.
+    The buffer of a thread is created the first time the thread opens a
+    zone, this is the only point where the profiler takes a critical section.
+    Readers (the http debug page and the trace exporter) only take snapshots
+    of the ring buffers and never block the writing threads.
+
+    Zone names must be static strings (string literals or Rtti class names),
+    only the pointer is recorded.
+
+    The recorded events can be written as a Chrome / Perfetto trace
+    (chrome://tracing or ui.perfetto.dev) with WriteChromeTrace().
+*/
+#include "core/types.h"
+#include "util/array.h"
+#include "io/stream.h"
+
+//------------------------------------------------------------------------------
+#define __zone_concat_impl(a, b) a##b
+#define __zone_concat(a, b) __zone_concat_impl(a, b)
+#if NEBULA3_ENABLE_ZONE_PROFILING
+#define _zone(name) Debug::ZoneScope __zone_concat(__zone_scope_, __LINE__)(name);
+#define _zone_begin(name) Debug::ZoneProfiler::BeginZone(name);
+#define _zone_end() Debug::ZoneProfiler::EndZone();
+#define _zone_thread_name(name) Debug::ZoneProfiler::SetThreadName(name);
+#define _zone_next_frame() Debug::ZoneProfiler::NextFrame();
+#else
+#define _zone(name)
+#define _zone_begin(name)
+#define _zone_end()
+#define _zone_thread_name(name)
+#define _zone_next_frame()
+#endif
+
+//------------------------------------------------------------------------------
+namespace Debug
+{
+class ZoneProfiler
+{
+public:
+    /// a finished zone
+    struct Event
+    {
+        const char* name;
+        uint64 beginTicks;
+        uint64 endTicks;
+        uint depth;
+        uint frame;
+    };
+
+    /// per thread ring buffer of finished zones, only written by its owner thread
+    struct ThreadBuffer
+    {
+        /// max number of finished zones kept per thread (must be a power of 2)
+        static const SizeT Capacity = 8192;
+        /// max nesting depth of zones
+        static const SizeT MaxDepth = 64;
+
+        uint threadIndex;
+        char threadName[32];
+        /// total number of events written, the write position is (numWritten & (Capacity - 1))
+        volatile uint numWritten;
+        /// current nesting depth
+        uint depth;
+        /// the open zones
+        const char* openNames[MaxDepth];
+        uint64 openTicks[MaxDepth];
+        Event events[Capacity];
+    };
+
+    /// max number of threads which may record zones
+    static const SizeT MaxThreads = 64;
+
+    /// enable/disable recording (enabled by default)
+    static void SetEnabled(bool b);
+    /// return true if recording is enabled
+    static bool IsEnabled();
+    /// open a zone on the calling thread
+    static void BeginZone(const char* name);
+    /// close the most recent zone on the calling thread
+    static void EndZone();
+    /// set a display name for the calling thread (optional, defaults to the Nebula thread name)
+    static void SetThreadName(const char* name);
+    /// advance the frame counter, call once per frame on the main thread
+    static void NextFrame();
+    /// get the current frame index
+    static uint GetFrameIndex();
+
+    /// get raw profiler ticks
+    static uint64 GetTicks();
+    /// get the number of raw ticks per second
+    static uint64 GetTicksPerSecond();
+    /// convert raw ticks to microseconds
+    static double TicksToMicroseconds(uint64 ticks);
+
+    /// get number of threads which have recorded zones
+    static SizeT GetNumThreads();
+    /// get name of a recording thread
+    static const char* GetThreadName(IndexT threadIndex);
+    /// copy the events currently held by a thread buffer, oldest first
+    static void CopyEvents(IndexT threadIndex, Util::Array<Event>& outEvents);
+    /// write all recorded events as Chrome trace event json
+    static bool WriteChromeTrace(const GPtr<IO::Stream>& stream);
+    /// escape a string for use inside a json string literal
+    static Util::String EscapeJson(const char* str);
+
+private:
+    /// get the calling thread's buffer, create if not exists
+    static ThreadBuffer* GetThreadBuffer();
+    /// create and register a buffer for the calling thread
+    static ThreadBuffer* CreateThreadBuffer();
+};
+
+//------------------------------------------------------------------------------
+/**
+    Helper class which opens a zone in the constructor and closes it
+    in the destructor.
+*/
+class ZoneScope
+{
+public:
+    /// constructor, opens zone
+    ZoneScope(const char* name);
+    /// destructor, closes zone
+    ~ZoneScope();
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline
+ZoneScope::ZoneScope(const char* name)
+{
+    ZoneProfiler::BeginZone(name);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline
+ZoneScope::~ZoneScope()
+{
+    ZoneProfiler::EndZone();
+}
+
+} // namespace Debug
+//------------------------------------------------------------------------------
@@ -40,7 +40,13 @@ BinaryReader::BinaryReader() :
     enableMapping(false),
     isMapped(false),
     mapCursor(0),
-    mapEnd(0)
+    mapEnd(0),
+    enableBuffering(false),
+    isBuffered(false),
+    bufferSize(64 * 1024),
+    buffer(0),
+    bufferCursor(0),
+    bufferEnd(0)
 {
     // empty
 }
@@ -76,6 +82,13 @@ BinaryReader::Open()
             this->mapCursor = 0;
             this->mapEnd = 0;
         }
+        if (!this->isMapped && this->enableBuffering && this->stream->CanSeek())
+        {
+            this->isBuffered = true;
+            this->buffer = (unsigned char*) Memory::Alloc(Memory::ScratchHeap, this->bufferSize);
+            this->bufferCursor = this->buffer;
+            this->bufferEnd = this->buffer;
+        }
         return true;
     }
     return false;
@@ -87,12 +100,101 @@ BinaryReader::Open()
 void
 BinaryReader::Close()
 {
+    if (this->isMapped && this->stream->IsMapped())
+    {
+        this->stream->Unmap();
+    }
+    if (this->isBuffered)
+    {
+        // give back what was read ahead, so the stream position matches what was consumed
+        SizeT unread = SizeT(this->bufferEnd - this->bufferCursor);
+        if (unread > 0)
+        {
+            this->stream->Seek(-unread, Stream::Current);
+        }
+        Memory::Free(Memory::ScratchHeap, this->buffer);
+        this->isBuffered = false;
+        this->buffer = 0;
+        this->bufferCursor = 0;
+        this->bufferEnd = 0;
+    }
     StreamReader::Close();
     this->isMapped = false;
     this->mapCursor = 0;
     this->mapEnd = 0;
 }
 
+//------------------------------------------------------------------------------
+/**
+*/
+bool
+BinaryReader::Eof() const
+{
+    n_assert(this->IsOpen());
+    if (this->isMapped)
+    {
+        return this->mapCursor >= this->mapEnd;
+    }
+    if (this->isBuffered && (this->bufferCursor < this->bufferEnd))
+    {
+        return false;
+    }
+    return this->stream->Eof();
+}
+
+//------------------------------------------------------------------------------
+/**
+    Called when the read buffer doesn't hold enough data. The rest of the
+    buffer is used up, then it is refilled with the next chunk of the
+    stream. Reads at least as large as the buffer bypass it.
+
+    Returns the number of bytes read, which is less than numBytes if the
+    stream ends early. The missing bytes are zeroed.
+*/
+SizeT
+BinaryReader::readFromStreamSlow(void* ptr, SizeT numBytes)
+{
+    unsigned char* dst = (unsigned char*) ptr;
+    SizeT numRead = 0;
+    if (!this->isBuffered)
+    {
+        numRead = this->stream->Read(dst, numBytes);
+    }
+    else
+    {
+        SizeT available = SizeT(this->bufferEnd - this->bufferCursor);
+        if (available > 0)
+        {
+            Memory::Copy(this->bufferCursor, dst, available);
+            numRead = available;
+        }
+        this->bufferCursor = this->buffer;
+        this->bufferEnd = this->buffer;
+
+        SizeT rest = numBytes - numRead;
+        if (rest >= this->bufferSize)
+        {
+            numRead += this->stream->Read(dst + numRead, rest);
+        }
+        else
+        {
+            Stream::Size remaining = this->stream->GetSize() - this->stream->GetPosition();
+            Stream::Size readSize = this->stream->Read(this->buffer, Math::n_min(this->bufferSize, remaining));
+            SizeT copySize = Math::n_min(rest, readSize);
+            this->bufferEnd = this->buffer + readSize;
+            Memory::Copy(this->buffer, dst + numRead, copySize);
+            this->bufferCursor = this->buffer + copySize;
+            numRead += copySize;
+        }
+    }
+
+    if (numRead < numBytes)
+    {
+        Memory::Clear(dst + numRead, numBytes - numRead);
+    }
+    return numRead;
+}
+
 //------------------------------------------------------------------------------
 /**
 */
@@ -107,7 +209,7 @@ BinaryReader::ReadChar()
     else
     {
         char c;
-        this->stream->Read(&c, sizeof(c));
+        this->readFromStream(&c, sizeof(c));
         return c;
     }
 }
@@ -126,7 +228,7 @@ BinaryReader::ReadUChar()
     else
     {
         unsigned char c;
-        this->stream->Read(&c, sizeof(c));
+        this->readFromStream(&c, sizeof(c));
         return c;
     }
 }
@@ -147,7 +249,7 @@ BinaryReader::ReadShort()
     }
     else
     {
-        this->stream->Read(&val, sizeof(val));
+        this->readFromStream(&val, sizeof(val));
     }
     return this->byteOrder.Convert<short>(val);
 }
@@ -168,7 +270,7 @@ BinaryReader::ReadUShort()
     }
     else
     {
-        this->stream->Read(&val, sizeof(val));
+        this->readFromStream(&val, sizeof(val));
     }
     return this->byteOrder.Convert<ushort>(val);
 }
@@ -189,7 +291,7 @@ BinaryReader::ReadInt()
     }
     else
     {
-        this->stream->Read(&val, sizeof(val));
+        this->readFromStream(&val, sizeof(val));
     }
     return this->byteOrder.Convert<int>(val);
 }
@@ -210,7 +312,7 @@ BinaryReader::ReadUInt()
     }
     else
     {
-        this->stream->Read(&val, sizeof(val));
+        this->readFromStream(&val, sizeof(val));
     }
     return this->byteOrder.Convert<uint>(val);
 }
@@ -231,7 +333,7 @@ BinaryReader::ReadFloat()
     }
     else
     {
-        this->stream->Read(&val, sizeof(val));
+        this->readFromStream(&val, sizeof(val));
     }
     return this->byteOrder.Convert<float>(val);
 }
@@ -274,7 +376,7 @@ BinaryReader::ReadDouble()
     }
     else
     {
-        this->stream->Read(&val, sizeof(val));
+        this->readFromStream(&val, sizeof(val));
     }
     return this->byteOrder.Convert<double>(val);
 }
@@ -295,7 +397,7 @@ BinaryReader::ReadBool()
     }
     else
     {
-        this->stream->Read(&val, sizeof(val));        
+        this->readFromStream(&val, sizeof(val));        
     }
     return val;
 }
@@ -329,7 +431,7 @@ BinaryReader::ReadString()
         {
             str.Reserve(length + 1);
             char* buf = (char*) str.AsCharPtr();
-            this->stream->Read((void*)buf, length);
+            this->readFromStream((void*)buf, length);
             buf[length] = 0;
         }
         return str;
@@ -353,7 +455,7 @@ BinaryReader::ReadBlob()
     }
     else
     {
-        this->stream->Read(ptr, numBytes);
+        this->readFromStream(ptr, numBytes);
     }
     return blob;
 }
@@ -385,7 +487,7 @@ BinaryReader::ReadFloat2()
     }
     else
     {
-        this->stream->Read(&val, sizeof(val));
+        this->readFromStream(&val, sizeof(val));
     }
 
     val.set(this->byteOrder.Convert<float>(val.x()),
@@ -409,7 +511,7 @@ BinaryReader::ReadFloat4()
     }
     else
     {
-        this->stream->Read(&val, sizeof(val));
+        this->readFromStream(&val, sizeof(val));
     }
     this->byteOrder.ConvertInPlace<Math::float4>(val);
     return val;
@@ -432,7 +534,7 @@ BinaryReader::ReadPoint()
     }
     else
     {
-        this->stream->Read(val, readSize);
+        this->readFromStream(val, readSize);
     }
 
     this->byteOrder.ConvertInPlace<float>(val[0]);
@@ -459,7 +561,7 @@ BinaryReader::ReadVector()
     }
     else
     {
-        this->stream->Read(val, readSize);
+        this->readFromStream(val, readSize);
     }
 
     this->byteOrder.ConvertInPlace<float>(val[0]);
@@ -485,7 +587,7 @@ BinaryReader::ReadMatrix44()
     }
     else
     {
-        this->stream->Read(&val, sizeof(val));
+        this->readFromStream(&val, sizeof(val));
     }
     this->byteOrder.ConvertInPlace<Math::matrix44>(val);
     return val;
@@ -495,7 +597,7 @@ BinaryReader::ReadMatrix44()
 //------------------------------------------------------------------------------
 /**
 */ 
-void
+SizeT
 BinaryReader::ReadRawData(void* ptr, SizeT numBytes)
 {
     n_assert((ptr != 0) && (numBytes > 0));
@@ -504,10 +606,11 @@ BinaryReader::ReadRawData(void* ptr, SizeT numBytes)
         n_assert((this->mapCursor + numBytes) <= this->mapEnd);
         Memory::Copy(this->mapCursor, ptr, numBytes);
         this->mapCursor += numBytes;
+        return numBytes;
     }
     else
     {
-        this->stream->Read(ptr, numBytes);
+        return this->readFromStream(ptr, numBytes);
     }
 }
 } // namespace IO
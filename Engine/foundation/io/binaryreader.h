@@ -29,8 +29,10 @@ THE SOFTWARE.
     @class IO::BinaryReader
     
     A friendly interface to read binary data from a stream. Optionally the
-    reader can use memory mapping for optimal read performance. Performs
-    automatic byte order conversion if necessary.
+    reader can use memory mapping for optimal read performance. Streams
+    which can't be mapped can be read through an internal buffer instead,
+    so small values don't cost one stream read each. Performs automatic
+    byte order conversion if necessary.
 
     @todo convert endianess!
 */
@@ -61,6 +63,12 @@ public:
     void SetMemoryMappingEnabled(bool b);
     /// return true if memory mapping is enabled
     bool IsMemoryMappingEnabled() const;
+    /// call before Open() to read through a buffer (if the stream can't be mapped)
+    void SetBufferedReadEnabled(bool b);
+    /// return true if buffered reading is enabled
+    bool IsBufferedReadEnabled() const;
+    /// call before Open() to set the read buffer size (default is 64 KByte)
+    void SetReadBufferSize(SizeT s);
     /// set the stream byte order (default is host byte order)
     void SetStreamByteOrder(System::ByteOrder::Type byteOrder);
     /// get the stream byte order
@@ -69,6 +77,8 @@ public:
     virtual bool Open();
     /// end reading from the stream
     virtual void Close();
+    /// return true if the reader is at the end of the stream
+    bool Eof() const;
     /// read an 8-bit char from the stream
     char ReadChar();
     /// read an 8-bit unsigned character from the stream
@@ -109,8 +119,14 @@ public:
     Util::Guid ReadGuid();
     /// read a blob of data
     Util::Blob ReadBlob();
-    /// read raw data
-    void ReadRawData(void* ptr, SizeT numBytes);
+    /// read raw data, returns the number of bytes read (less than numBytes at the end of a stream)
+    SizeT ReadRawData(void* ptr, SizeT numBytes);
+
+private:
+    /// read from the stream, through the read buffer if buffering, returns the number of bytes read
+    SizeT readFromStream(void* ptr, SizeT numBytes);
+    /// read data which is not contained in the read buffer, returns the number of bytes read
+    SizeT readFromStreamSlow(void* ptr, SizeT numBytes);
 
 public:
     bool enableMapping;
@@ -118,6 +134,12 @@ public:
     System::ByteOrder byteOrder;
     unsigned char* mapCursor;
     unsigned char* mapEnd;
+    bool enableBuffering;
+    bool isBuffered;
+    SizeT bufferSize;
+    unsigned char* buffer;
+    unsigned char* bufferCursor;
+    unsigned char* bufferEnd;
 };
 
 //------------------------------------------------------------------------------
@@ -138,6 +160,53 @@ BinaryReader::IsMemoryMappingEnabled() const
     return this->enableMapping;
 }
 
+//------------------------------------------------------------------------------
+/**
+*/
+inline void
+BinaryReader::SetBufferedReadEnabled(bool b)
+{
+    this->enableBuffering = b;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline bool
+BinaryReader::IsBufferedReadEnabled() const
+{
+    return this->enableBuffering;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline void
+BinaryReader::SetReadBufferSize(SizeT s)
+{
+    n_assert(!this->IsOpen());
+    n_assert(s > 0);
+    this->bufferSize = s;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline SizeT
+BinaryReader::readFromStream(void* ptr, SizeT numBytes)
+{
+    if (this->isBuffered && ((this->bufferCursor + numBytes) <= this->bufferEnd))
+    {
+        Memory::Copy(this->bufferCursor, ptr, numBytes);
+        this->bufferCursor += numBytes;
+        return numBytes;
+    }
+    else
+    {
+        return this->readFromStreamSlow(ptr, numBytes);
+    }
+}
+
 //------------------------------------------------------------------------------
 /**
 */
@@ -37,7 +37,8 @@ using namespace Core;
 */
 FileStream::FileStream() :
     handle(0),
-    mappedContent(0)
+    mappedContent(0),
+    mappedSize(0)
 {
     // empty
 }
@@ -222,6 +223,10 @@ FileStream::Eof() const
 
 //------------------------------------------------------------------------------
 /**
+    Read-only streams are mapped by the platform's FSWrapper, so the pages
+    are only loaded when touched and nothing is copied. If the file can't
+    be mapped, or the stream is writable, the whole file is read into a
+    scratch buffer instead.
 */
 void*
 FileStream::Map()
@@ -230,10 +235,21 @@ FileStream::Map()
     
     Size size = this->GetSize();
     n_assert(size > 0);
-    this->mappedContent = Memory::Alloc(Memory::ScratchHeap, size);
-    this->Seek(0, Begin);
-    Size readSize = this->Read(this->mappedContent, size);
-    n_assert(readSize == size);
+    if (ReadAccess == this->accessMode)
+    {
+        this->mappedContent = FSWrapper::Map(this->handle, size);
+    }
+    if (0 != this->mappedContent)
+    {
+        this->mappedSize = size;
+    }
+    else
+    {
+        this->mappedContent = Memory::Alloc(Memory::ScratchHeap, size);
+        this->Seek(0, Begin);
+        Size readSize = this->Read(this->mappedContent, size);
+        n_assert(readSize == size);
+    }
     Stream::Map();
     return this->mappedContent;
 }
@@ -246,7 +262,15 @@ FileStream::Unmap()
 {
     n_assert(0 != this->mappedContent);
     Stream::Unmap();
-    Memory::Free(Memory::ScratchHeap, this->mappedContent);
+    if (this->mappedSize > 0)
+    {
+        FSWrapper::Unmap(this->mappedContent, this->mappedSize);
+        this->mappedSize = 0;
+    }
+    else
+    {
+        Memory::Free(Memory::ScratchHeap, this->mappedContent);
+    }
     this->mappedContent = 0;
 }
 
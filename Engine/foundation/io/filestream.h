@@ -80,6 +80,7 @@ public:
 private:
     FSWrapper::Handle handle;
     void* mappedContent;
+    Size mappedSize;        // size of a file mapping, 0 if mappedContent is a scratch buffer
 };
 
 } // namespace IO
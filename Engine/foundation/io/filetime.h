@@ -56,7 +56,7 @@ namespace IO
 {
 typedef OSX::OSXFileTime FileTime;
 }
-#elif __ANDROID__
+#elif (__ANDROID__ || __LINUX__)
 #include "io/android/androidfiletime.h"
 namespace IO
 {
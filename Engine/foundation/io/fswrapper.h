@@ -60,14 +60,12 @@ namespace IO
 class FSWrapper : public OSX::OSXFSWrapper
 { };
 }
-#elif __ANDROID__
-#include "io/android/androidfswrapper.h"
+#elif (__ANDROID__ || __LINUX__)
+#include "io/posix/posixfswrapper.h"
 namespace IO
 {
-class FSWrapper : public Android::AndroidFSWrapper
-{
-
-};
+class FSWrapper : public Posix::PosixFSWrapper
+{ };
 }
 #else
 #error "FSWrapper class not implemented on this platform!"
@@ -199,6 +199,26 @@ OSXFSWrapper::GetFileSize(Handle handle)
     
 	return fileSize;
 }
+
+//------------------------------------------------------------------------------
+/**
+    Files are not mapped yet on OSX, the caller reads them instead.
+*/
+void*
+OSXFSWrapper::Map(Handle handle, Stream::Size numBytes)
+{
+    n_assert(0 != handle);
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+void
+OSXFSWrapper::Unmap(void* ptr, Stream::Size numBytes)
+{
+    n_error("OSXFSWrapper::Unmap: nothing is ever mapped!");
+}
     
 //------------------------------------------------------------------------------
 /**
@@ -0,0 +1,593 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#if (__ANDROID__ || __LINUX__)
+#include "stdneb.h"
+#include "io/posix/posixfswrapper.h"
+#include "core/sysfunc.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <fnmatch.h>
+#include <dirent.h>
+#include <utime.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+namespace Posix
+{
+using namespace Util;
+using namespace Core;
+using namespace IO;
+
+//------------------------------------------------------------------------------
+/**
+    Open a file with open(). Returns a handle to the file which must be 
+    passed to the other PosixFSWrapper file methods. If opening the file
+    fails, the function will return 0.
+*/
+PosixFSWrapper::Handle
+PosixFSWrapper::OpenFile(const String& path, Stream::AccessMode accessMode, Stream::AccessPattern accessPattern)
+{
+    int flags = 0;
+    switch (accessMode)
+    {
+        case Stream::ReadAccess:
+            flags = O_RDONLY;
+            break;
+
+        case Stream::WriteAccess:
+            flags = O_WRONLY | O_CREAT | O_TRUNC;
+            break;
+
+        case Stream::ReadWriteAccess:
+        case Stream::AppendAccess:
+            flags = O_RDWR | O_CREAT;
+            break;
+    }
+
+    int fd = open(path.AsCharPtr(), flags, 0644);
+    if (-1 == fd)
+    {
+        return 0;
+    }
+
+    #if !__ANDROID__
+    // read-ahead hint for the whole file, bionic only has this from API level 21 on
+    switch (accessPattern)
+    {
+        case Stream::Random:
+            posix_fadvise(fd, 0, 0, POSIX_FADV_RANDOM);
+            break;
+
+        case Stream::Sequential:
+            posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+            break;
+    }
+    #endif
+
+    Handle handle = n_new(File);
+    handle->fd = fd;
+    handle->position = 0;
+    handle->accessPattern = accessPattern;
+
+    // in append mode, we need to seek to the end of the file
+    if (Stream::AppendAccess == accessMode)
+    {
+        handle->position = GetFileSize(handle);
+    }
+    return handle;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Closes a file opened by PosixFSWrapper::OpenFile().
+*/
+void
+PosixFSWrapper::CloseFile(Handle handle)
+{
+    n_assert(0 != handle);
+    close(handle->fd);
+    n_delete(handle);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Write data to a file at the handle's position.
+*/
+void
+PosixFSWrapper::Write(Handle handle, const void* buf, Stream::Size numBytes)
+{
+    n_assert(0 != handle);
+    n_assert(buf != 0);
+    n_assert(numBytes > 0);
+    const char* ptr = (const char*) buf;
+    Stream::Size remaining = numBytes;
+    while (remaining > 0)
+    {
+        ssize_t written = pwrite(handle->fd, ptr, remaining, handle->position);
+        if (written < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            n_error("PosixFSWrapper: pwrite() failed! %s", strerror(errno));
+            return;
+        }
+        ptr += written;
+        remaining -= (Stream::Size) written;
+        handle->position += (Stream::Position) written;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+    Read data from a file at the handle's position, returns number of bytes 
+    read. Short reads are only returned at the end of the file.
+*/
+Stream::Size
+PosixFSWrapper::Read(Handle handle, void* buf, Stream::Size numBytes)
+{
+    n_assert(0 != handle);
+    n_assert(buf != 0);
+    n_assert(numBytes > 0);
+    char* ptr = (char*) buf;
+    Stream::Size bytesRead = 0;
+    while (bytesRead < numBytes)
+    {
+        ssize_t result = pread(handle->fd, ptr + bytesRead, numBytes - bytesRead, handle->position);
+        if (result < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            n_error("PosixFSWrapper: pread() failed! %s", strerror(errno));
+            break;
+        }
+        if (0 == result)
+        {
+            // end of file
+            break;
+        }
+        bytesRead += (Stream::Size) result;
+        handle->position += (Stream::Position) result;
+    }
+    return bytesRead;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Seek in a file. This only moves the handle's own position.
+*/
+void
+PosixFSWrapper::Seek(Handle handle, Stream::Offset offset, Stream::SeekOrigin orig)
+{
+    n_assert(0 != handle);
+    Stream::Offset base;
+    switch (orig)
+    {
+        case Stream::Current:
+            base = handle->position;
+            break;
+        case Stream::End:
+            base = GetFileSize(handle);
+            break;
+        case Stream::Begin:
+        default:
+            base = 0;
+            break;
+    }
+    handle->position = Math::n_max(0, base + offset);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Get current position in file.
+*/
+Stream::Position
+PosixFSWrapper::Tell(Handle handle)
+{
+    n_assert(0 != handle);
+    return handle->position;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Flush unwritten data to file. Nothing is buffered in user space, so 
+    this does nothing.
+*/
+void
+PosixFSWrapper::Flush(Handle handle)
+{
+    n_assert(0 != handle);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Returns true if current position is at end of file.
+*/
+bool
+PosixFSWrapper::Eof(Handle handle)
+{
+    n_assert(0 != handle);
+    return handle->position >= GetFileSize(handle);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Returns the size of a file in bytes.
+*/
+Stream::Size
+PosixFSWrapper::GetFileSize(Handle handle)
+{
+    n_assert(0 != handle);
+    struct stat attr;
+    if (0 != fstat(handle->fd, &attr))
+    {
+        return 0;
+    }
+    return (Stream::Size) attr.st_size;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Map the start of a file read-only into memory. The pages are only read
+    when touched, so the access pattern from OpenFile() is passed on as a
+    read-ahead hint. Returns 0 if the file can't be mapped, the caller then
+    has to read it instead.
+*/
+void*
+PosixFSWrapper::Map(Handle handle, Stream::Size numBytes)
+{
+    n_assert(0 != handle);
+    n_assert(numBytes > 0);
+    void* ptr = mmap(0, numBytes, PROT_READ, MAP_PRIVATE, handle->fd, 0);
+    if (MAP_FAILED == ptr)
+    {
+        return 0;
+    }
+    switch (handle->accessPattern)
+    {
+        case Stream::Random:
+            madvise(ptr, numBytes, MADV_RANDOM);
+            break;
+
+        case Stream::Sequential:
+            madvise(ptr, numBytes, MADV_SEQUENTIAL);
+            madvise(ptr, numBytes, MADV_WILLNEED);
+            break;
+    }
+    return ptr;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Unmap memory returned by Map().
+*/
+void
+PosixFSWrapper::Unmap(void* ptr, Stream::Size numBytes)
+{
+    n_assert(0 != ptr);
+    munmap(ptr, numBytes);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Set the read-only status of a file.
+*/
+void
+PosixFSWrapper::SetReadOnly(const String& path, bool readOnly)
+{
+    n_assert(path.IsValid());
+    struct stat attr;
+    if (0 != stat(path.AsCharPtr(), &attr))
+    {
+        return;
+    }
+    if (readOnly)
+    {
+        attr.st_mode &= ~(S_IWUSR | S_IWGRP | S_IWOTH);
+    }
+    else
+    {
+        attr.st_mode |= S_IWUSR;
+    }
+    chmod(path.AsCharPtr(), attr.st_mode);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Get the read-only status of a file.
+*/
+bool
+PosixFSWrapper::IsReadOnly(const String& path)
+{
+    n_assert(path.IsValid());
+    return 0 != access(path.AsCharPtr(), W_OK);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Deletes a file. Returns true if the operation was successful.
+*/
+bool
+PosixFSWrapper::DeleteFile(const String& path)
+{
+    n_assert(path.IsValid());
+    return 0 == unlink(path.AsCharPtr());
+}
+
+//------------------------------------------------------------------------------
+/**
+    Delete an empty directory. Returns true if the operation was successful.
+*/
+bool
+PosixFSWrapper::DeleteDirectory(const String& path)
+{
+    n_assert(path.IsValid());
+    return 0 == rmdir(path.AsCharPtr());
+}
+
+//------------------------------------------------------------------------------
+/**
+    Return true if a file exists.
+*/
+bool
+PosixFSWrapper::FileExists(const String& path)
+{
+    n_assert(path.IsValid());
+    struct stat attr;
+    return (0 == stat(path.AsCharPtr(), &attr)) && !S_ISDIR(attr.st_mode);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Return true if a directory exists.
+*/
+bool
+PosixFSWrapper::DirectoryExists(const String& path)
+{
+    n_assert(path.IsValid());
+    struct stat attr;
+    return (0 == stat(path.AsCharPtr(), &attr)) && S_ISDIR(attr.st_mode);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Set the write-access time stamp of a file.
+*/
+void
+PosixFSWrapper::SetFileWriteTime(const String& path, FileTime fileTime)
+{
+    n_assert(path.IsValid());
+    utime(path.AsCharPtr(), &fileTime.time);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Return the last write-access time to a file.
+*/
+FileTime
+PosixFSWrapper::GetFileWriteTime(const String& path)
+{
+    n_assert(path.IsValid());
+    FileTime fileTime;
+    Memory::Clear(&fileTime, sizeof(fileTime));
+    struct stat attr;
+    if (0 == stat(path.AsCharPtr(), &attr))
+    {
+        fileTime.time.actime = attr.st_atime;
+        fileTime.time.modtime = attr.st_mtime;
+    }
+    return fileTime;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Creates a new directory.
+*/
+bool
+PosixFSWrapper::CreateDirectory(const String& path)
+{
+    n_assert(path.IsValid());
+    return 0 == mkdir(path.AsCharPtr(), S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+Array<String>
+PosixFSWrapper::ListEntries(const String& dirPath, const String& pattern, bool dirs)
+{
+    n_assert(dirPath.IsValid());
+    n_assert(pattern.IsValid());
+
+    Array<String> result;
+    DIR* dir = opendir(dirPath.AsCharPtr());
+    if (0 == dir)
+    {
+        return result;
+    }
+    struct dirent* entry;
+    while (0 != (entry = readdir(dir)))
+    {
+        if ((0 == strcmp(entry->d_name, ".")) || (0 == strcmp(entry->d_name, "..")))
+        {
+            continue;
+        }
+        if (0 != fnmatch(pattern.AsCharPtr(), entry->d_name, 0))
+        {
+            continue;
+        }
+        String fullPath = dirPath + "/" + entry->d_name;
+        struct stat attr;
+        if ((0 == stat(fullPath.AsCharPtr(), &attr)) && (dirs == S_ISDIR(attr.st_mode)))
+        {
+            result.Append(entry->d_name);
+        }
+    }
+    closedir(dir);
+    return result;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Lists all files in a directory, filtered by a pattern.
+*/
+Array<String>
+PosixFSWrapper::ListFiles(const String& dirPath, const String& pattern)
+{
+    return ListEntries(dirPath, pattern, false);
+}
+
+//------------------------------------------------------------------------------
+/**
+    Lists all subdirectories in a directory, filtered by a pattern. This will
+    not return the special directories ".." and ".".
+*/
+Array<String>
+PosixFSWrapper::ListDirectories(const String& dirPath, const String& pattern)
+{
+    return ListEntries(dirPath, pattern, true);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+String
+PosixFSWrapper::GetExecutableDirectory()
+{
+    char buffer[NEBULA3_MAXPATH];
+    ssize_t length = readlink("/proc/self/exe", buffer, sizeof(buffer) - 1);
+    if (length <= 0)
+    {
+        return "";
+    }
+    buffer[length] = 0;
+
+    String pathToExe(buffer);
+    String dirName = pathToExe.ExtractDirName();
+    dirName.TrimRight("/");
+    return dirName;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Android has no per user directory, returns an empty string.
+*/
+String
+PosixFSWrapper::GetUserDirectory()
+{
+    return "";
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+String
+PosixFSWrapper::GetAppDataDirectory()
+{
+    return "";
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+String
+PosixFSWrapper::GetProgramsDirectory()
+{
+    return "";
+}
+
+//------------------------------------------------------------------------------
+/**
+    Android has no shared temp directory, returns an empty string.
+*/
+String
+PosixFSWrapper::GetTempDirectory()
+{
+    return "";
+}
+
+//------------------------------------------------------------------------------
+/**
+    This method sould return the directory where the executable is located.
+*/
+String
+PosixFSWrapper::GetBinDirectory()
+{
+    return String("file://") + GetExecutableDirectory();
+}
+
+//------------------------------------------------------------------------------
+/**
+    This method sould return the installation directory of the
+    application, which is the executable's directory as well.
+*/
+String
+PosixFSWrapper::GetHomeDirectory()
+{
+    return String("file://") + GetExecutableDirectory();
+}
+
+//------------------------------------------------------------------------------
+/**
+    There are no drive letters, "ANDROID" is the only device name. IoServer
+    stops creating parent directories there and URI treats "ANDROID:" as a
+    local path instead of a scheme.
+*/
+bool
+PosixFSWrapper::IsDeviceName(const String& str)
+{
+    return str == "ANDROID";
+}
+
+//------------------------------------------------------------------------------
+/**
+    Skips the device prefix at the start of the path.
+*/
+const char*
+PosixFSWrapper::ConvertPath(const String& str)
+{
+    const char* ptr = str.AsCharPtr();
+    n_assert((ptr[0] == 'O') && (ptr[1] == 'S') && (ptr[2] == 'X') && (ptr[3] == ':'));
+    return &(ptr[4]);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+String
+PosixFSWrapper::GetEditorAssetDirectory()
+{
+    return "";
+}
+
+} // namespace Posix
+
+#endif // (__ANDROID__ || __LINUX__)
@@ -262,6 +262,39 @@ Win360FSWrapper::GetFileSize(Handle handle)
     return ::GetFileSize(handle, NULL);
 }
 
+//------------------------------------------------------------------------------
+/**
+    Map the start of a file read-only into memory through a file mapping
+    object. The view keeps the mapping alive, so the mapping handle is
+    closed right away. Returns 0 if the file can't be mapped, the caller 
+    then has to read it instead.
+*/
+void*
+Win360FSWrapper::Map(Handle handle, Stream::Size numBytes)
+{
+    n_assert(0 != handle);
+    n_assert(numBytes > 0);
+    HANDLE mapping = CreateFileMapping(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (NULL == mapping)
+    {
+        return 0;
+    }
+    void* ptr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, numBytes);
+    CloseHandle(mapping);
+    return ptr;
+}
+
+//------------------------------------------------------------------------------
+/**
+    Unmap memory returned by Map().
+*/
+void
+Win360FSWrapper::Unmap(void* ptr, Stream::Size numBytes)
+{
+    n_assert(0 != ptr);
+    UnmapViewOfFile(ptr);
+}
+
 //------------------------------------------------------------------------------
 /**
     Set the read-only status of a file. This method does nothing on the
@@ -67,6 +67,10 @@ public:
     static bool Eof(Handle h);
     /// get size of a file in bytes
     static IO::Stream::Size GetFileSize(Handle h);
+    /// map the first numBytes of a file read-only into memory, returns 0 if the file can't be mapped
+    static void* Map(Handle h, IO::Stream::Size numBytes);
+    /// unmap memory returned by Map()
+    static void Unmap(void* ptr, IO::Stream::Size numBytes);
     /// set read-only status of a file
     static void SetReadOnly(const Util::String& path, bool readOnly);
     /// get read-only status of a file
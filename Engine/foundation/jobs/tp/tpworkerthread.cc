@@ -7,6 +7,7 @@
 #include "jobs/job.h"
 #include "jobs/jobfuncdesc.h"
 #include "debug/debugserver.h"
+#include "debug/zoneprofiler.h"
 #include "math/scalar.h"
 namespace Jobs
 {
@@ -166,7 +167,9 @@ TPWorkerThread::ProcessJobSlices(TPJobSlice* firstSlice, ushort numSlices, ushor
             this->debugTimer->Start();       
         }
 #endif
+        _zone_begin("TPWorkerThread::JobSlice");
         funcDesc.GetFunctionPointer()(ctx);
+        _zone_end();
 #if NEBULA3_ENABLE_PROFILING
         if (this->debugTimer.isvalid())
         {
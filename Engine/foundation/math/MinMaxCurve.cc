@@ -24,6 +24,18 @@ THE SOFTWARE.
 
 #include "stdneb.h"
 #include "MinMaxCurve.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MINMAXCURVE_USE_SSE2 (1)
+#else
+#define MINMAXCURVE_USE_SSE2 (0)
+#endif
+#if !MINMAXCURVE_USE_SSE2 && (defined(__ARM_NEON__) || defined(__ARM_NEON))
+#include <arm_neon.h>
+#define MINMAXCURVE_USE_NEON (1)
+#else
+#define MINMAXCURVE_USE_NEON (0)
+#endif
 
 namespace Math
 {
@@ -31,10 +43,13 @@ namespace Math
 	mMinScalar(0.0f),
 	mMaxScalar(1.0f),
 	mCurveState(curveState),
-	mMaxY(0)
+	mMaxY(0),
+	mBakedBegin(0.0f),
+	mBakedScale(0.0f)
 	{
 		mMinCurve.AddPolyKeyFrame(FloatKeyFrame(0.0f, 0.0f));
 		mMaxCurve.AddPolyKeyFrame(FloatKeyFrame(0.0f, 1.0f));
+		Bake();
 	}
 	float MinMaxCurve::Calculate(float time,float randomValue)
 	{
@@ -57,6 +72,129 @@ namespace Math
 		}
 		return ans;
 	}
+	//--------------------------------------------------------------------------------
+	void MinMaxCurve::CalculateBatch(const float* times, const float* randomValues, float* results, SizeT count) const
+	{
+		n_assert(0 != times && 0 != results);
+		IndexT i = 0;
+		if (Scalar == mCurveState || RandomScalar == mCurveState)
+		{
+			for (; i < count; i++)
+			{
+				results[i] = CalculateBaked(times[i], randomValues ? randomValues[i] : 1.0f);
+			}
+			return;
+		}
+		// without random values the max curve is taken, like CalculateBaked's default
+		const bool twoCurves = (TwoCurves == mCurveState);
+		// sample position and fraction four at a time, the table fetches stay scalar
+#if MINMAXCURVE_USE_SSE2
+		const __m128 begin = _mm_set1_ps(mBakedBegin);
+		const __m128 scale = _mm_set1_ps(mBakedScale);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 last = _mm_set1_ps(float(BakedSamples - 1));
+		const __m128i lastIndex = _mm_set1_epi32(BakedSamples - 2);
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 pos = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(times + i), begin), scale);
+			pos = _mm_min_ps(_mm_max_ps(pos, zero), last);
+			// pos is not negative, so truncation is floor. SSE2 has no _mm_min_epi32
+			__m128i index = _mm_cvttps_epi32(pos);
+			__m128i over = _mm_cmpgt_epi32(index, lastIndex);
+			index = _mm_or_si128(_mm_and_si128(over, lastIndex), _mm_andnot_si128(over, index));
+			__m128 frac = _mm_sub_ps(pos, _mm_cvtepi32_ps(index));
+
+			int idx[4];
+			_mm_storeu_si128((__m128i*)idx, index);
+
+			__m128 a = _mm_setr_ps(mBakedMin[idx[0]], mBakedMin[idx[1]], mBakedMin[idx[2]], mBakedMin[idx[3]]);
+			__m128 b = _mm_setr_ps(mBakedMin[idx[0] + 1], mBakedMin[idx[1] + 1], mBakedMin[idx[2] + 1], mBakedMin[idx[3] + 1]);
+			__m128 ans = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), frac));
+			if (twoCurves)
+			{
+				a = _mm_setr_ps(mBakedMax[idx[0]], mBakedMax[idx[1]], mBakedMax[idx[2]], mBakedMax[idx[3]]);
+				b = _mm_setr_ps(mBakedMax[idx[0] + 1], mBakedMax[idx[1] + 1], mBakedMax[idx[2] + 1], mBakedMax[idx[3] + 1]);
+				__m128 ansMax = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), frac));
+				ans = randomValues ? _mm_add_ps(ans, _mm_mul_ps(_mm_sub_ps(ansMax, ans), _mm_loadu_ps(randomValues + i))) : ansMax;
+			}
+			_mm_storeu_ps(results + i, ans);
+		}
+#elif MINMAXCURVE_USE_NEON
+		const float32x4_t begin = vdupq_n_f32(mBakedBegin);
+		const float32x4_t scale = vdupq_n_f32(mBakedScale);
+		const float32x4_t zero = vdupq_n_f32(0.0f);
+		const float32x4_t last = vdupq_n_f32(float(BakedSamples - 1));
+		const int32x4_t lastIndex = vdupq_n_s32(BakedSamples - 2);
+		for (; i + 4 <= count; i += 4)
+		{
+			float32x4_t pos = vmulq_f32(vsubq_f32(vld1q_f32(times + i), begin), scale);
+			pos = vminq_f32(vmaxq_f32(pos, zero), last);
+			int32x4_t index = vminq_s32(vcvtq_s32_f32(pos), lastIndex);
+			float32x4_t frac = vsubq_f32(pos, vcvtq_f32_s32(index));
+
+			int idx[4];
+			vst1q_s32(idx, index);
+
+			float lo[4], hi[4];
+			for (IndexT k = 0; k < 4; k++)
+			{
+				lo[k] = mBakedMin[idx[k]];
+				hi[k] = mBakedMin[idx[k] + 1];
+			}
+			float32x4_t a = vld1q_f32(lo);
+			float32x4_t ans = vmlaq_f32(a, vsubq_f32(vld1q_f32(hi), a), frac);
+			if (twoCurves)
+			{
+				for (IndexT k = 0; k < 4; k++)
+				{
+					lo[k] = mBakedMax[idx[k]];
+					hi[k] = mBakedMax[idx[k] + 1];
+				}
+				a = vld1q_f32(lo);
+				float32x4_t ansMax = vmlaq_f32(a, vsubq_f32(vld1q_f32(hi), a), frac);
+				ans = randomValues ? vmlaq_f32(ans, vsubq_f32(ansMax, ans), vld1q_f32(randomValues + i)) : ansMax;
+			}
+			vst1q_f32(results + i, ans);
+		}
+#endif
+		for (; i < count; i++)
+		{
+			results[i] = CalculateBaked(times[i], randomValues ? randomValues[i] : 1.0f);
+		}
+	}
+	//--------------------------------------------------------------------------------
+	void MinMaxCurve::Bake()
+	{
+		const bool twoCurves = (TwoCurves == mCurveState) && !mMaxCurve.IsEmpty();
+		if (mMinCurve.IsEmpty())
+		{
+			mBakedBegin = 0.0f;
+			mBakedScale = 0.0f;
+			Memory::Clear(mBakedMin, sizeof(mBakedMin));
+			Memory::Clear(mBakedMax, sizeof(mBakedMax));
+			return;
+		}
+
+		float begin = mMinCurve.GetBeginTime();
+		float end = mMinCurve.GetEndTime();
+		if (twoCurves)
+		{
+			begin = n_min(begin, mMaxCurve.GetBeginTime());
+			end = n_max(end, mMaxCurve.GetEndTime());
+		}
+		const float range = end - begin;
+		const float step = range / float(BakedSamples - 1);
+		mBakedBegin = begin;
+		mBakedScale = (range > TINY) ? float(BakedSamples - 1) / range : 0.0f;
+
+		// sample the precise evaluation, this is the only place the keyframe cache gets touched
+		for (IndexT i = 0; i < BakedSamples; i++)
+		{
+			const float time = begin + step * float(i);
+			mBakedMin[i] = mMinCurve.EvaluatePolyCurveFloat(time).GetValue();
+			mBakedMax[i] = twoCurves ? mMaxCurve.EvaluatePolyCurveFloat(time).GetValue() : mBakedMin[i];
+		}
+	}
 	
 	void MinMaxCurve::SetCurveState(CurveState state)
 	{
@@ -135,6 +273,7 @@ namespace Math
 		}
 
 		mCurveState = state;
+		Bake();
 	}
 	
 	void MinMaxCurve::CopyFrom(const MinMaxCurve& source)
@@ -144,6 +283,10 @@ namespace Math
 		this->mCurveState = source.mCurveState;
 		this->mMinCurve = source.mMinCurve;
 		this->mMaxCurve = source.mMaxCurve;
+		this->mBakedBegin = source.mBakedBegin;
+		this->mBakedScale = source.mBakedScale;
+		Memory::Copy(source.mBakedMin, this->mBakedMin, sizeof(mBakedMin));
+		Memory::Copy(source.mBakedMax, this->mBakedMax, sizeof(mBakedMax));
 	}
 	void MinMaxCurve::GetArrayFromCurve(Util::Array<float2>& _list,Util::Array<bool>& _curveTypes) const
 	{
@@ -152,6 +295,7 @@ namespace Math
 	void MinMaxCurve::SetCurveFromArray(const Util::Array<float2>& _list,const Util::Array<bool>& _curveTypes)
 	{
 		_setCurve(mMinCurve,_list,_curveTypes);
+		Bake();
 	}
 	void MinMaxCurve::GetArrayFromCurve(Util::Array<float2>& _list1,Util::Array<bool>& _curveTypes1, Util::Array<float2>& _list2,Util::Array<bool>& _curveTypes2) const
 	{
@@ -162,6 +306,7 @@ namespace Math
 	{
 		_setCurve(mMinCurve,_list1,_curveTypes1);
 		_setCurve(mMaxCurve,_list2,_curveTypes2);
+		Bake();
 	}
 	void MinMaxCurve::Clear()
 	{		
@@ -174,12 +319,19 @@ namespace Math
 		mMaxCurve.ClearFrameCache();
 		mMaxCurve.ClearFrameLevers();
 		mMaxCurve.ClearFrames();
+		Bake();
 	}
 	void MinMaxCurve::SetMaxY(float Value)
 	{
 		mMaxY = Value;
 		if(Curve != mCurveState && TwoCurves != mCurveState)
 			return;
+		_clampCurveMaxY();
+		Bake();
+	}
+	//--------------------------------------------------------------------------------
+	void MinMaxCurve::_clampCurveMaxY()
+	{
 		SizeT count = mMinCurve.GetKeyFrameCount();
 		for (IndexT i = 0; i < count; i++)
 		{
@@ -36,7 +36,17 @@ namespace Math
 		MinMaxCurve(CurveState curveState = Scalar);
 		~MinMaxCurve(){}
 
+		/// number of samples in the baked lookup tables
+		static const SizeT BakedSamples = 64;
+
+		/// precise keyframe evaluation (editor / tools), not thread safe
 		float Calculate(float time,float randomValue = 1.0f);
+		/// evaluate from the baked lookup tables, const and thread safe
+		float CalculateBaked(float time,float randomValue = 1.0f) const;
+		/// evaluate count samples from the baked lookup tables (SSE2/NEON, scalar otherwise), randomValues may be 0
+		void CalculateBatch(const float* times, const float* randomValues, float* results, SizeT count) const;
+		/// rebake the lookup tables from the current curves
+		void Bake();
 		void SetTwoCurve(const FloatPolyCurve& curve1, const FloatPolyCurve& curve2);
 		void GetTwoCurve(FloatPolyCurve& curve1, FloatPolyCurve& curve2)const;
 		void SetOneCurve(const FloatPolyCurve& curve1);
@@ -67,8 +77,14 @@ namespace Math
 		float					mMinY;
 		CurveState        mCurveState;
 
+		float					mBakedBegin;
+		float					mBakedScale;
+		float					mBakedMin[BakedSamples];
+		float					mBakedMax[BakedSamples];
+
 		void _getCurve(const FloatPolyCurve& curve, Util::Array<float2>& _list,Util::Array<bool>& _curveTypes)const;
 		void _setCurve(FloatPolyCurve& curve, const Util::Array<float2>& _list, const Util::Array<bool>& _curveTypes);
+		void _clampCurveMaxY();
 	};
 	inline void MinMaxCurve::GetTwoCurve(FloatPolyCurve& curve1, FloatPolyCurve& curve2) const
 	{
@@ -79,10 +95,12 @@ namespace Math
 	{
 		mMinCurve = curve1;
 		mMaxCurve = curve2;
+		Bake();
 	}
 	inline void MinMaxCurve::SetOneCurve(const FloatPolyCurve& curve1)
 	{
 		mMinCurve = curve1;
+		Bake();
 	}
 	inline void MinMaxCurve::GetOneCurve(FloatPolyCurve& curve1) const
 	{
@@ -113,6 +131,27 @@ namespace Math
 	{
 		return mCurveState;
 	}
+	inline float MinMaxCurve::CalculateBaked(float time,float randomValue) const
+	{
+		switch(mCurveState)
+		{
+		case Scalar:
+			return mMinScalar;
+		case RandomScalar:
+			return n_lerp(mMinScalar,mMaxScalar,randomValue);
+		default:
+			break;
+		}
+		float pos = n_clamp((time - mBakedBegin) * mBakedScale, 0.0f, float(BakedSamples - 1));
+		int index = n_min((int)pos, (int)BakedSamples - 2);
+		float frac = pos - float(index);
+		float ans = n_lerp(mBakedMin[index], mBakedMin[index + 1], frac);
+		if (TwoCurves == mCurveState)
+		{
+			ans = n_lerp(ans, n_lerp(mBakedMax[index], mBakedMax[index + 1], frac), randomValue);
+		}
+		return ans;
+	}
 }
 
 
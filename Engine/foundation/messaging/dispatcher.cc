@@ -63,14 +63,20 @@ Dispatcher::AttachPort(const GPtr<Port>& port)
     {
         const Id* msgIdPtr = idArray[i];
         this->RegisterMessage(*msgIdPtr);
-        if (!this->idPortMap.Contains(msgIdPtr))
+        IndexT idIndex = msgIdPtr->GetIndex();
+        if (idIndex >= this->idPortTable.Size())
+        {
+            // ids are dense, so this is bounded by the number of message classes
+            this->idPortTable.Fill(this->idPortTable.Size(), Id::GetNumIds() - this->idPortTable.Size(), InvalidIndex);
+        }
+        if (InvalidIndex == this->idPortTable[idIndex])
         {
             // need to add a new empty entry
             Util::Array<GPtr<Port> > emptyArray;
             this->idPorts.Append(emptyArray);
-            this->idPortMap.Add(msgIdPtr, this->idPorts.Size() - 1);
+            this->idPortTable[idIndex] = this->idPorts.Size() - 1;
         }
-        this->idPorts[this->idPortMap[msgIdPtr]].Append(port);
+        this->idPorts[this->idPortTable[idIndex]].Append(port);
     }
 }
 
@@ -91,10 +97,10 @@ Dispatcher::RemovePort(const GPtr<Port>& port)
     IndexT i;
     for (i = 0; i < idArray.Size(); i++)
     {
-        const Id* msgIdPtr = idArray[i];
-        if (this->idPortMap.Contains(msgIdPtr))
+        IndexT idIndex = idArray[i]->GetIndex();
+        if ((idIndex < this->idPortTable.Size()) && (InvalidIndex != this->idPortTable[idIndex]))
         {            
-            Util::Array<GPtr<Port> >& ports = this->idPorts[this->idPortMap[msgIdPtr]];
+            Util::Array<GPtr<Port> >& ports = this->idPorts[this->idPortTable[idIndex]];
             IndexT portIndex = ports.FindIndex(port);
             n_assert(InvalidIndex != portIndex);
             ports.EraseIndex(portIndex);
@@ -129,11 +135,11 @@ Dispatcher::HasPort(const GPtr<Port>& port) const
 void
 Dispatcher::HandleMessage(const GPtr<Message>& msg)
 {
-    const Id* msgIdPtr = &(msg->GetId());
-    IndexT mapIndex = this->idPortMap.FindIndex(msgIdPtr);
-    if (InvalidIndex != mapIndex)
+    IndexT idIndex = msg->GetId().GetIndex();
+    IndexT portsIndex = (idIndex < this->idPortTable.Size()) ? this->idPortTable[idIndex] : InvalidIndex;
+    if (InvalidIndex != portsIndex)
     {
-        const Util::Array<GPtr<Port> >& portArray = this->idPorts[this->idPortMap.ValueAtIndex(mapIndex)];
+        const Util::Array<GPtr<Port> >& portArray = this->idPorts[portsIndex];
         IndexT portIndex;
         for (portIndex = 0; portIndex < portArray.Size(); portIndex++)
         {
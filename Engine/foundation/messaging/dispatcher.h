@@ -47,6 +47,9 @@ THE SOFTWARE.
     Dispatcher objects usually serve as front end message ports which hide
     a more complex message processing infrastructure underneath.
 
+    The ports of a message are found by indexing a table with the dense
+    index of the message id, there's no search per message.
+
     (C) 2007 RadonLabs GmbH
 */
 #include "core/ptr.h"
@@ -73,7 +76,7 @@ public:
 private:
     Util::Array<GPtr<Port> > portArray;
     Util::Array<Util::Array<GPtr<Port> > > idPorts;             // one entry per message, contains ports which accepts the message
-    Util::Dictionary<const Id*,IndexT> idPortMap;    // maps message id's to indices in the msgIdPorts array
+    Util::Array<IndexT> idPortTable;    // indexed by Id::GetIndex(), maps message id's to indices in the idPorts array
 };
 
 } // namespace Message
@@ -26,6 +26,7 @@ THE SOFTWARE.
 #include "stdneb.h"
 #include "messaging/handlerthreadbase.h"
 #include "messaging/batchmessage.h"
+#include "debug/zoneprofiler.h"
 
 namespace Messaging
 {
@@ -178,6 +179,7 @@ HandlerThreadBase::ThreadCloseHandlers()
 void
 HandlerThreadBase::ThreadUpdateHandlers()
 {
+    _zone("HandlerThread::UpdateHandlers");
     this->handlersCritSect.Enter();
     Array<GPtr<Handler> >::Iterator iter;
     for (iter = this->handlers.Begin(); iter < this->handlers.End(); iter++)
@@ -282,6 +284,8 @@ HandlerThreadBase::ThreadHandleMessages(const Array<GPtr<Message> >& msgArray)
 bool
 HandlerThreadBase::ThreadHandleSingleMessage(const GPtr<Message>& msg)
 {
+    // Rtti objects are static, so the class name may be recorded as zone name
+    _zone(msg->GetClassName().AsCharPtr());
     bool msgHandled = false;
 
     // let each handler look at the message
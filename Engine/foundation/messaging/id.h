@@ -27,22 +27,42 @@ THE SOFTWARE.
 #include "core/types.h"
 
 //------------------------------------------------------------------------------
+namespace Core
+{
+class Rtti;
+}
+
 namespace Messaging
 {
 class Id
 {
 public:
-    /// constructor
+    /// constructor, assigns the next dense index
     Id();
+    /// constructor for message classes, also enables the instance cache of the class
+    Id(Core::Rtti& msgClass);
     /// equality operator
     bool operator==(const Id& rhs) const;
+    /// get the dense index of the id, usable to index dispatch tables directly
+    IndexT GetIndex() const;
+    /// get the number of ids created so far
+    static SizeT GetNumIds();
+
+    /// number of freed instances kept per message class
+    static const SizeT InstanceCacheSize = 32;
+
+private:
+    IndexT index;
+    // zero initialized before any id is constructed, ids are only created during static initialization
+    static SizeT numIds;
 };
 
 //------------------------------------------------------------------------------
 /**
 */
 inline
-Id::Id()
+Id::Id() :
+    index(numIds++)
 {
     // empty
 }
@@ -57,5 +77,25 @@ Id::operator==(const Id& rhs) const
     return (this == &rhs);
 }
 
+//------------------------------------------------------------------------------
+/**
+*/
+inline
+IndexT
+Id::GetIndex() const
+{
+    return this->index;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline
+SizeT
+Id::GetNumIds()
+{
+    return numIds;
+}
+
 } // namespace Messaging
 //------------------------------------------------------------------------------
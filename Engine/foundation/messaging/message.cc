@@ -32,6 +32,20 @@ namespace Messaging
 __ImplementClass(Messaging::Message, 'MSG_', Core::RefCounted);
 __ImplementMsgId(Message);
 
+SizeT Id::numIds = 0;
+
+//------------------------------------------------------------------------------
+/**
+    Message classes are created and released for every send, so they
+    keep their freed instances in a free list instead of going through
+    the heap each time.
+*/
+Id::Id(Core::Rtti& msgClass) :
+    index(numIds++)
+{
+    msgClass.SetInstanceCacheSize(InstanceCacheSize);
+}
+
 //------------------------------------------------------------------------------
 /**
 */
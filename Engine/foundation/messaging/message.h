@@ -42,7 +42,7 @@ public:\
 private:
 
 #define __ImplementMsgId(type) \
-    Messaging::Id type::Id; \
+    Messaging::Id type::Id(type::RTTI); \
     const Messaging::Id& type::GetId() const { return type::Id; }
 
 //------------------------------------------------------------------------------
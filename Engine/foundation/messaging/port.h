@@ -118,7 +118,7 @@ inline
 bool 
 Port::AcceptsMessage(const Id& msgId) const
 {
-    return (InvalidIndex != this->acceptedMessageIds.FindIndex(&msgId));
+    return (InvalidIndex != this->acceptedMessageIds.BinarySearchIndex(&msgId));
 }
 
 } // namespace Messaging
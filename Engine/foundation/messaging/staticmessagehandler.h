@@ -25,6 +25,7 @@ THE SOFTWARE.
 ****************************************************************************/
 
 #include "messaging/message.h"
+#include "util/array.h"
 
 //------------------------------------------------------------------------------
 namespace Messaging
@@ -40,6 +41,78 @@ public:
     template<class MSGTYPE> static void Handle(const GPtr<MSGTYPE>& msg);
 };
 
+//------------------------------------------------------------------------------
+/**
+    A jump table of static message handlers. Where a chain of __StaticHandle
+    tests the message against every handled id in turn, the table is indexed
+    directly with the dense index of the message id.
+*/
+class StaticHandlerTable
+{
+public:
+    /// add the static handler of a message class (__StaticHandler(MSGCLASS))
+    template<class MSGTYPE> void Add();
+    /// return true if a handler exists for the message id
+    bool Contains(const Id& msgId) const;
+    /// call the handler of the message, return false if there's none
+    bool Dispatch(const GPtr<Message>& msg) const;
+
+private:
+    typedef void (*HandlerFunc)(const GPtr<Message>& msg);
+    /// cast the message and call its static handler
+    template<class MSGTYPE> static void Invoke(const GPtr<Message>& msg);
+
+    Util::Array<HandlerFunc> handlers;
+};
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class MSGTYPE> void
+StaticHandlerTable::Add()
+{
+    IndexT index = MSGTYPE::Id.GetIndex();
+    if (index >= this->handlers.Size())
+    {
+        this->handlers.Fill(this->handlers.Size(), Id::GetNumIds() - this->handlers.Size(), (HandlerFunc)0);
+    }
+    this->handlers[index] = &StaticHandlerTable::Invoke<MSGTYPE>;
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+template<class MSGTYPE> void
+StaticHandlerTable::Invoke(const GPtr<Message>& msg)
+{
+    StaticMessageHandler::Handle<MSGTYPE>(msg.downcast<MSGTYPE>());
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline bool
+StaticHandlerTable::Contains(const Id& msgId) const
+{
+    IndexT index = msgId.GetIndex();
+    return (index < this->handlers.Size()) && (0 != this->handlers[index]);
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline bool
+StaticHandlerTable::Dispatch(const GPtr<Message>& msg) const
+{
+    IndexT index = msg->GetId().GetIndex();
+    if ((index < this->handlers.Size()) && (0 != this->handlers[index]))
+    {
+        this->handlers[index](msg);
+        return true;
+    }
+    return false;
+}
+
 //------------------------------------------------------------------------------
 /**
 */
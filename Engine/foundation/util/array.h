@@ -51,11 +51,19 @@ public:
     Array(SizeT initialSize, SizeT initialGrow, const TYPE& initialValue);
     /// copy constructor
     Array(const Array<TYPE>& rhs);
+    #if NEBULA3_MOVE_SEMANTICS
+    /// move constructor, takes over the element buffer of rhs
+    Array(Array<TYPE>&& rhs);
+    #endif
     /// destructor
     ~Array();
 
     /// assignment operator
     void operator=(const Array<TYPE>& rhs);
+    #if NEBULA3_MOVE_SEMANTICS
+    /// move assignment operator, takes over the element buffer of rhs
+    void operator=(Array<TYPE>&& rhs);
+    #endif
 	void Assign( const TYPE* vBegin, const TYPE* vEnd );
 
     /// [] operator
@@ -69,6 +77,12 @@ public:
 
     /// append element to end of array
     void Append(const TYPE& elm);
+    #if NEBULA3_MOVE_SEMANTICS
+    /// append element to end of array, moving it into place
+    void Append(TYPE&& elm);
+    #endif
+    /// append a default element to end of array and return a reference to it
+    TYPE& EmplaceBack();
     /// append the contents of an array to this array
     void AppendArray(const Array<TYPE>& rhs);
     /// increase capacity to fit N more elements into the array
@@ -242,10 +256,17 @@ Array<TYPE>::Copy(const Array<TYPE>& src)
     if (this->capacity > 0)
     {
         this->elements = n_new_array(TYPE, this->capacity);
-        IndexT i;
-        for (i = 0; i < this->size; i++)
+        if (TypeIsBitwiseMovable<TYPE>::Value)
         {
-            this->elements[i] = src.elements[i];
+            Memory::Copy(src.elements, this->elements, this->size * sizeof(TYPE));
+        }
+        else
+        {
+            IndexT i;
+            for (i = 0; i < this->size; i++)
+            {
+                this->elements[i] = src.elements[i];
+            }
         }
     }
 }
@@ -288,6 +309,23 @@ Array<TYPE>::Array(const Array<TYPE>& rhs) :
     this->Copy(rhs);
 }
 
+#if NEBULA3_MOVE_SEMANTICS
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE>
+Array<TYPE>::Array(Array<TYPE>&& rhs) :
+    grow(rhs.grow),
+    capacity(rhs.capacity),
+    size(rhs.size),
+    elements(rhs.elements)
+{
+    rhs.capacity = 0;
+    rhs.size = 0;
+    rhs.elements = 0;
+}
+#endif
+
 //------------------------------------------------------------------------------
 /**
 */
@@ -357,6 +395,28 @@ Array<TYPE>::operator=(const Array<TYPE>& rhs)
         }
     }
 }
+
+#if NEBULA3_MOVE_SEMANTICS
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> void 
+Array<TYPE>::operator=(Array<TYPE>&& rhs)
+{
+    if (this != &rhs)
+    {
+        this->Delete();
+        this->grow = rhs.grow;
+        this->capacity = rhs.capacity;
+        this->size = rhs.size;
+        this->elements = rhs.elements;
+        rhs.capacity = 0;
+        rhs.size = 0;
+        rhs.elements = 0;
+    }
+}
+#endif
+
 //------------------------------------------------------------------------
 template<class TYPE> void 
 Array<TYPE>::Assign(  const TYPE* vBegin, const TYPE* vEnd  )
@@ -410,6 +470,10 @@ Array<TYPE>::Assign(  const TYPE* vBegin, const TYPE* vEnd  )
 
 //------------------------------------------------------------------------------
 /**
+    Relocates the existing elements into a new buffer. Bitwise movable
+    element types are relocated with a single memory copy, everything
+    else is moved element by element (which degrades to a copy without
+    rvalue reference support).
 */
 template<class TYPE> void
 Array<TYPE>::GrowTo(SizeT newCapacity)
@@ -417,11 +481,18 @@ Array<TYPE>::GrowTo(SizeT newCapacity)
     TYPE* newArray = n_new_array(TYPE, newCapacity);
     if (this->elements)
     {
-        // copy over contents
-        IndexT i;
-        for (i = 0; i < this->size; i++)
+        // relocate contents
+        if (TypeIsBitwiseMovable<TYPE>::Value)
+        {
+            Memory::Copy(this->elements, newArray, this->size * sizeof(TYPE));
+        }
+        else
         {
-            newArray[i] = this->elements[i];
+            IndexT i;
+            for (i = 0; i < this->size; i++)
+            {
+                newArray[i] = n_move(this->elements[i]);
+            }
         }
 
         // discard old array and update contents
@@ -498,7 +569,7 @@ Array<TYPE>::Move(IndexT fromIndex, IndexT toIndex)
         IndexT i;
         for (i = 0; i < num; i++)
         {
-            this->elements[toIndex + i] = this->elements[fromIndex + i];
+            this->elements[toIndex + i] = n_move(this->elements[fromIndex + i]);
         }
 
         // destroy remaining elements
@@ -513,7 +584,7 @@ Array<TYPE>::Move(IndexT fromIndex, IndexT toIndex)
         int i;  // NOTE: this must remain signed for the following loop to work!!!
         for (i = num - 1; i >= 0; --i)
         {
-            this->elements[toIndex + i] = this->elements[fromIndex + i];
+            this->elements[toIndex + i] = n_move(this->elements[fromIndex + i]);
         }
 
         // destroy freed elements
@@ -544,6 +615,48 @@ Array<TYPE>::Append(const TYPE& elm)
     this->elements[this->size++] = elm;
 }
 
+#if NEBULA3_MOVE_SEMANTICS
+//------------------------------------------------------------------------------
+/**
+*/
+template<class TYPE> void
+Array<TYPE>::Append(TYPE&& elm)
+{
+    // grow allocated space if exhausted
+    if (this->size == this->capacity)
+    {
+        this->Grow();
+    }
+    #if NEBULA3_BOUNDSCHECKS
+    n_assert(this->elements);
+    #endif
+    this->elements[this->size++] = n_move(elm);
+}
+#endif
+
+//------------------------------------------------------------------------------
+/**
+    Appends an element in place and returns a reference to it, so the
+    caller can fill it without building a temporary and copying it
+    into the array. The slot is reset to a default constructed value,
+    since it may hold a destroyed element from a previous erase.
+*/
+template<class TYPE> TYPE&
+Array<TYPE>::EmplaceBack()
+{
+    // grow allocated space if exhausted
+    if (this->size == this->capacity)
+    {
+        this->Grow();
+    }
+    #if NEBULA3_BOUNDSCHECKS
+    n_assert(this->elements);
+    #endif
+    TYPE& elm = this->elements[this->size++];
+    elm = TYPE();
+    return elm;
+}
+
 //------------------------------------------------------------------------------
 /**
 */
@@ -720,7 +833,7 @@ Array<TYPE>::EraseIndexSwap(IndexT index)
     IndexT lastElementIndex = this->size - 1;
     if (index < lastElementIndex)
     {
-        this->elements[index] = this->elements[lastElementIndex];
+        this->elements[index] = n_move(this->elements[lastElementIndex]);
     }
     this->Destroy(&(this->elements[lastElementIndex]));
     this->size--;
@@ -57,6 +57,7 @@ UNFOLD( MonoMethod* ,mono_method_get_last_managed, ());\
 UNFOLD( mono_bool, mono_class_is_valuetype, (MonoClass* klass) );\
 UNFOLD( void*, mono_object_unbox,(MonoObject* pObj) );\
 UNFOLD( MonoObject*, mono_runtime_invoke, (MonoMethod* method, void* obj, void** params, MonoObject** exc) );\
+UNFOLD( void*, mono_method_get_unmanaged_thunk, (MonoMethod* method) );\
 UNFOLD( char*, mono_string_to_utf8,(MonoString* string_obj) );\
 UNFOLD( mono_unichar2*, mono_string_to_utf16,(MonoString* string_obj) );\
 UNFOLD( void, mono_free, (void*) );\
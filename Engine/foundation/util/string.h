@@ -64,6 +64,10 @@ public:
     String();
     /// copy constructor
     String(const String& rhs);
+    #if NEBULA3_MOVE_SEMANTICS
+    /// move constructor, takes over the heap buffer of rhs
+    String(String&& rhs);
+    #endif
     /// construct from C string
     String(const char* cStr);
     /// destructor
@@ -71,6 +75,10 @@ public:
 
     /// assignment operator
     void operator=(const String& rhs);
+    #if NEBULA3_MOVE_SEMANTICS
+    /// move assignment operator, takes over the heap buffer of rhs
+    void operator=(String&& rhs);
+    #endif
     /// assign from const char*
     void operator=(const char* cStr);
     /// += operator
@@ -338,6 +346,10 @@ private:
     void Alloc(SizeT size);
     /// (re-)allocate the string buffer (copies old content)
     void Realloc(SizeT newSize);
+    #if NEBULA3_MOVE_SEMANTICS
+    /// take over the contents of rhs, leaves rhs empty
+    void MoveFrom(String& rhs);
+    #endif
 
     enum
     {
@@ -599,6 +611,47 @@ String::String(const String& rhs) :
     this->SetCharPtr(rhs.AsCharPtr());
 }
 
+#if NEBULA3_MOVE_SEMANTICS
+//------------------------------------------------------------------------------
+/**
+    Strings living in the local buffer are simply copied, heap buffers
+    change owner without allocating.
+*/
+inline void
+String::MoveFrom(String& rhs)
+{
+    if (rhs.heapBuffer)
+    {
+        this->Delete();
+        this->heapBuffer = rhs.heapBuffer;
+        this->heapBufferSize = rhs.heapBufferSize;
+        this->strLen = rhs.strLen;
+        rhs.heapBuffer = 0;
+        rhs.heapBufferSize = 0;
+        rhs.strLen = 0;
+        rhs.localBuffer[0] = 0;
+    }
+    else
+    {
+        this->Set(rhs.localBuffer, rhs.strLen);
+        rhs.Delete();
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+*/
+inline
+String::String(String&& rhs) :
+    heapBuffer(0),
+    strLen(0),
+    heapBufferSize(0)
+{
+    this->localBuffer[0] = 0;
+    this->MoveFrom(rhs);
+}
+#endif
+
 //------------------------------------------------------------------------------
 /**
 */
@@ -636,6 +689,20 @@ String::operator=(const String& rhs)
     }
 }
 
+#if NEBULA3_MOVE_SEMANTICS
+//------------------------------------------------------------------------------
+/**
+*/
+inline void
+String::operator=(String&& rhs)
+{
+    if (&rhs != this)
+    {
+        this->MoveFrom(rhs);
+    }
+}
+#endif
+
 //------------------------------------------------------------------------------
 /**
 */
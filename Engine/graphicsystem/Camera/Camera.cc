@@ -230,8 +230,7 @@ namespace Graphic
 
 			Material::GetGlobalMaterialParams()->SetVectorParam(eGShaderVecScreenSize,float4(float(dm.GetWidth()),float(dm.GetHeight()),float(0.5/dm.GetWidth()),float(0.5/dm.GetHeight())));
 
-			m_swapTexture = RenderToTexture::Create();
-			m_swapTexture->Setup(dm.GetWidth(),dm.GetHeight(),RenderBase::PixelFormat::A8R8G8B8, RenderBase::RenderTarget::ClearAll, Math::float4(0.f,0.f,0.f,1.f),  false,1.f,RenderBase::AntiAliasQuality::None);
+			// post effects and special post take their swap target from the transient pool
 
 
 			m_viewPort.width = dm.GetWidth();
@@ -555,9 +554,6 @@ namespace Graphic
 
 			Material::GetGlobalMaterialParams()->SetTextureParam(eGShaderTexMainBuffer, "g_MainBuffer",m_renderToTexture->GetTextureHandle());
 
-			m_swapTexture->Setup(dm.GetWidth(),dm.GetHeight(),RenderBase::PixelFormat::A8R8G8B8, RenderBase::RenderTarget::ClearAll, Math::float4(0.f,0.f,0.f,1.f),  false,1.f,RenderBase::AntiAliasQuality::None);
-			Material::GetGlobalMaterialParams()->SetTextureParam(eGShaderTexSwapBuffer, "g_SwapBuffer",m_swapTexture->GetTextureHandle());
-
 			m_bRenderNormal = true;
 			m_bRenderLightLitMap = true;
 
@@ -597,7 +593,10 @@ namespace Graphic
 		GPtr<RenderToTexture> rt = GetRenderToTexture();
 		rt->ChangeSize(t_width,t_height);
 		rt = GetSwapTexture();
-		rt->ChangeSize(t_width,t_height);
+		if (rt.isvalid())
+		{
+			rt->ChangeSize(t_width,t_height);
+		}
 		if (HasDepthMap())
 		{
 			rt = GetDepthMap();
@@ -27,6 +27,7 @@ THE SOFTWARE.
 #include "graphicsystem/Renderable/Renderable.h"
 #include "graphicsystem/Camera/RenderPipeline/VisibleNode.h"
 #include "foundation/util/stl.h"
+#include "graphicsystem/GraphicSystem.h"
 
 namespace Graphic
 {
@@ -35,13 +36,15 @@ namespace Graphic
 	class RenderDataSorter
 	{
 	public:
-		RenderDataSorter(const RenderData* _data)
+		RenderDataSorter(const RenderData* _data, bool _batching)
 		{
 			data = _data;
+			batching = _batching;
 		}
 		bool operator() (const int& l, const int& r) const;
 	private:
 		const RenderData* data;
+		bool batching;
 	};
 	template<bool opaque>
 	bool RenderDataSorter<opaque>::operator() (const int& lIndrex, const int& rIndex) const
@@ -73,8 +76,33 @@ namespace Graphic
 		
 		if (opaque)
 		{
+			// keep render datas of one material adjacent, so they can be instanced
+			if (batching)
+			{
+				if (lhs.renderable->GetMaterial() != rhs.renderable->GetMaterial())
+				{
+					return lhs.renderable->GetMaterial() < rhs.renderable->GetMaterial();
+				}
+				if (lhs.renderable->GetBatchKey() != rhs.renderable->GetBatchKey())
+				{
+					return lhs.renderable->GetBatchKey() < rhs.renderable->GetBatchKey();
+				}
+			}
 			return lhs.onwer->distance < rhs.onwer->distance;
 		}
+		if (!batching)
+		{
+			return lIndrex < rIndex;
+		}
+		// equal distance, keep render datas of one material and image adjacent, so sprites can be batched
+		if (lhs.renderable->GetMaterial() != rhs.renderable->GetMaterial())
+		{
+			return lhs.renderable->GetMaterial() < rhs.renderable->GetMaterial();
+		}
+		if (lhs.renderable->GetBatchKey() != rhs.renderable->GetBatchKey())
+		{
+			return lhs.renderable->GetBatchKey() < rhs.renderable->GetBatchKey();
+		}
 		return lIndrex < rIndex;
 	}
 
@@ -99,13 +127,15 @@ namespace Graphic
 	class DepthSorter
 	{
 	public:
-		DepthSorter(const RenderData* _data)
+		DepthSorter(const RenderData* _data, bool _batching)
 		{
 			data = _data;
+			batching = _batching;
 		}
 		bool operator()(const int& lIndrex, const int& rIndex) const;
 	private:
 		const RenderData* data;
+		bool batching;
 	};
 	bool DepthSorter::operator() (const int& lIndrex, const int& rIndex) const
 	{
@@ -120,6 +150,10 @@ namespace Graphic
 		{
 			return lhs.renderable->GetMaterial()->GetShaderInstanceID() < rhs.renderable->GetMaterial()->GetShaderInstanceID();
 		}
+		if (batching && lhs.renderable->GetMaterial() != rhs.renderable->GetMaterial())
+		{
+			return lhs.renderable->GetMaterial() < rhs.renderable->GetMaterial();
+		}
 
 		return lhs.onwer->distance < rhs.onwer->distance;
 	}
@@ -275,10 +309,17 @@ namespace Graphic
 	}
 
 
+	// material first ordering only pays off when a batcher merges the runs, otherwise front to back wins
+	static bool _isBatching()
+	{
+		GraphicSystem* gs = GraphicSystem::Instance();
+		return gs->GetInstanceBatcher()->IsActive() || gs->GetSpriteBatcher()->IsActive();
+	}
+
 	template<bool Opaque>
 	void RenderDataManager::_sort(RenderDataIndexArray& cache)
 	{
-		RenderDataSorter<Opaque> sorter(mRenderDatas.Begin());
+		RenderDataSorter<Opaque> sorter(mRenderDatas.Begin(), _isBatching());
 		Util::STL::sort(cache.Begin(), cache.End(), sorter);
 	}
 	void RenderDataManager::_sortScreen(RenderDataIndexArray& cache)
@@ -288,7 +329,7 @@ namespace Graphic
 	}
 	void RenderDataManager::_sortDepth(RenderDataIndexArray& cache)
 	{
-		DepthSorter sorter(mRenderDatas.Begin());
+		DepthSorter sorter(mRenderDatas.Begin(), _isBatching());
 		Util::STL::sort(cache.Begin(), cache.End(), sorter);
 	}
 }
\ No newline at end of file
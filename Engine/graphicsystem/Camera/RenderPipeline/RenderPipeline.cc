@@ -28,6 +28,9 @@ THE SOFTWARE.
 #include "graphicsystem/Renderable/RenderObject.h"
 #include "graphicsystem/Camera/Camera.h"
 #include "graphicsystem/Renderable/GraphicRenderer.h"
+#include "graphicsystem/Renderable/InstanceBatcher.h"
+#include "graphicsystem/Renderable/SpriteBatcher.h"
+#include "graphicsystem/Material/materialinstance.h"
 
 namespace Graphic
 {
@@ -191,14 +194,136 @@ namespace Graphic
 		return (indices.Count() > 0);
 	}
 
+	SizeT RenderPipeline::renderInstancedRun(PipelineParamters& params, RenderDataIndexArray::Iterator it, RenderDataIndexArray::Iterator end,
+		RenderPassType passType, const Material* customMat, uint mark, int attLightSupport)
+	{
+		InstanceBatcher* batcher = GraphicSystem::Instance()->GetInstanceBatcher();
+		if (!batcher->IsActive() || (it + 1) == end)
+		{
+			return 0;
+		}
+
+		RenderDataArray& datas = params.m_renderDatas.GetRenderDatas();
+		RenderData& first = datas[*it];
+		const MaterialPass* pass = GraphicRenderer::GetRenderPass(first.renderable, passType, customMat);
+		if (NULL == pass || !GraphicSystem::Instance()->IsInstancingProgram(pass->GetGPUProgramHandle()))
+		{
+			return 0;
+		}
+
+		InstanceInfo info;
+		if (!first.onwer->object->GetInstanceInfo(first.renderable, passType, customMat, info))
+		{
+			return 0;
+		}
+		batcher->Begin(info);
+
+		const MaterialInstance* material = first.renderable->GetMaterial();
+		bool bUsedForLightmap = false;
+		for (RenderDataIndexArray::Iterator next = it + 1; next != end; ++next)
+		{
+			RenderData& renderData = datas[*next];
+			if (renderData.renderable->GetMaterial() != material || (mark && !(renderData.renderable->GetMark() & mark)))
+			{
+				break;
+			}
+			if (attLightSupport >= 0 && params.m_activeLights.FindActiveAttLights(renderData.onwer->object, attLightSupport, bUsedForLightmap).Count() > 0)
+			{
+				break;
+			}
+			if (!renderData.onwer->object->GetInstanceInfo(renderData.renderable, passType, customMat, info) || !batcher->Accept(info))
+			{
+				break;
+			}
+			batcher->Push(info.data);
+		}
+
+		SizeT count = batcher->GetCount();
+		if (count < 2)
+		{
+			batcher->Cancel();
+			return 0;
+		}
+		GraphicRenderer::BeforeRender(first.renderable, passType, customMat);
+		GraphicRenderer::RenderInstanced(batcher->GetRun().surType, first.renderable, customMat);
+		return count;
+	}
+
+	SizeT RenderPipeline::renderSpriteRun(PipelineParamters& params, RenderDataIndexArray::Iterator it, RenderDataIndexArray::Iterator end,
+		RenderPassType passType, const Material* customMat, uint mark, int attLightSupport)
+	{
+		SpriteBatcher* batcher = GraphicSystem::Instance()->GetSpriteBatcher();
+		if (!batcher->IsActive() || (it + 1) == end)
+		{
+			return 0;
+		}
+
+		RenderDataArray& datas = params.m_renderDatas.GetRenderDatas();
+		RenderData& first = datas[*it];
+		SpriteQuadInfo info;
+		if (!first.onwer->object->GetSpriteQuadInfo(first.renderable, passType, customMat, info))
+		{
+			return 0;
+		}
+		batcher->Begin(info);
+
+		const MaterialInstance* material = first.renderable->GetMaterial();
+		bool bUsedForLightmap = false;
+		for (RenderDataIndexArray::Iterator next = it + 1; next != end; ++next)
+		{
+			RenderData& renderData = datas[*next];
+			if (renderData.renderable->GetMaterial() != material || (mark && !(renderData.renderable->GetMark() & mark)))
+			{
+				break;
+			}
+			if (attLightSupport >= 0 && params.m_activeLights.FindActiveAttLights(renderData.onwer->object, attLightSupport, bUsedForLightmap).Count() > 0)
+			{
+				break;
+			}
+			if (!renderData.onwer->object->GetSpriteQuadInfo(renderData.renderable, passType, customMat, info) || !batcher->Accept(info))
+			{
+				break;
+			}
+			batcher->Push(info);
+		}
+
+		SizeT count = batcher->GetCount();
+		if (count < 2)
+		{
+			batcher->Cancel();
+			return 0;
+		}
+		GraphicRenderer::BeforeRender(first.renderable, passType, customMat);
+		first.onwer->object->RenderSpriteBatch(first.renderable, passType, customMat);
+		return count;
+	}
+
+	SizeT RenderPipeline::renderBatchedRun(PipelineParamters& params, RenderDataIndexArray::Iterator it, RenderDataIndexArray::Iterator end,
+		RenderPassType passType, const Material* customMat, uint mark, int attLightSupport)
+	{
+		SizeT batched = renderSpriteRun(params, it, end, passType, customMat, mark, attLightSupport);
+		if (0 == batched)
+		{
+			batched = renderInstancedRun(params, it, end, passType, customMat, mark, attLightSupport);
+		}
+		return batched;
+	}
+
 	void RenderPipeline::renderRenderableList(PipelineParamters& params, RenderData::Type type ,RenderPassType passType, const Material* customMat)
 	{
+		PROFILER_ZONE("RenderPipeline::renderRenderableList");
 		RenderDataArray& datas = params.m_renderDatas.GetRenderDatas();
 		RenderDataIndexArray& indices = params.m_renderDatas.GetRenderDataIndices(type);
 		RenderDataIndexArray::Iterator it = indices.Begin();
 		RenderDataIndexArray::Iterator end = indices.End();
 		while (it != end)
 		{
+			SizeT batched = renderBatchedRun(params, it, end, passType, customMat, 0, -1);
+			if (batched)
+			{
+				it += batched;
+				continue;
+			}
 			RenderData& renderData = datas[*it];
 			GraphicRenderer::BeforeRender(renderData.renderable, passType, customMat);
 			renderData.onwer->object->Render(renderData.renderable, passType, customMat);
@@ -208,6 +333,7 @@ namespace Graphic
 
 	void RenderPipeline::renderRenderableList(PipelineParamters& params, RenderData::Type type , RenderPassType passType, const Material* customMat, uint mark)
 	{
+		PROFILER_ZONE("RenderPipeline::renderRenderableList");
 		RenderDataArray& datas = params.m_renderDatas.GetRenderDatas();
 		RenderDataIndexArray& indices = params.m_renderDatas.GetRenderDataIndices(type);
 		RenderDataIndexArray::Iterator it = indices.Begin();
@@ -218,6 +344,12 @@ namespace Graphic
 			Renderable* renderable = renderData.renderable;
 			if (renderable->GetMark() & mark)
 			{
+				SizeT batched = renderBatchedRun(params, it, end, passType, customMat, mark, -1);
+				if (batched)
+				{
+					it += batched;
+					continue;
+				}
 				GraphicRenderer::BeforeRender(renderData.renderable, passType, customMat);
 				renderData.onwer->object->Render(renderData.renderable, passType, customMat);
 			}
@@ -228,6 +360,7 @@ namespace Graphic
 
 	void RenderPipeline::renderRenderableListWidthLight(PipelineParamters& params, RenderData::Type type , const Material* customMat)
 	{
+		PROFILER_ZONE("RenderPipeline::renderRenderableListWidthLight");
 		RenderDataArray& datas = params.m_renderDatas.GetRenderDatas();
 		RenderDataIndexArray& indices = params.m_renderDatas.GetRenderDataIndices(type);
 		RenderDataIndexArray::Iterator it = indices.Begin();
@@ -265,6 +398,17 @@ namespace Graphic
 				++index;
 			}
 
+			// objects lit only by the common lights share them, the attenuated ones are per object
+			if (0 == block.Count())
+			{
+				SizeT batched = renderBatchedRun(params, it, end, eForward, customMat, 0, supportCount);
+				if (batched)
+				{
+					it += batched;
+					continue;
+				}
+			}
+
 			GraphicRenderer::BeforeRender(renderData.renderable, eForward, customMat);
 			renderData.onwer->object->Render(renderData.renderable, eForward, customMat);
 			++it;
@@ -381,11 +525,12 @@ namespace Graphic
 			const Camera* camera = params.m_camera;
 
 			m_currentRT = 0;
-			const GPtr<RenderToTexture>& rtt= camera->GetSwapTexture();
 			const GPtr<RenderToTexture>& mainTex = camera->GetRenderToTexture();
 
-			if ( mainTex.isvalid() && rtt.isvalid() )
+			if ( mainTex.isvalid() )
 			{
+				GPtr<RenderToTexture> rtt = acquireSwapTexture(mainTex);
+
 				RenderData::Type type[3] = { RenderData::Glass, RenderData::ParticleDecal, RenderData::ParticlePost};
 
 				for (int index = 0; index < sizeof(type)/sizeof(RenderData::Type); index++)
@@ -400,6 +545,7 @@ namespace Graphic
 					//draw Special effect
 					renderRenderableList(params, type[index], eForward, NULL);
 				}
+				RenderToTextureManager::Instance()->ReleaseTransient(rtt);
 			}
 		}
 	}
@@ -460,9 +606,11 @@ namespace Graphic
 		RenderToTexture* source = mainBuffer.get();
 		ImageFilterManager& postEffects = camera->GetPostEffectFilters();
 		int count = postEffects.Size();
+		GPtr<RenderToTexture> swapTexture;
 		if (count > 0)
 		{
-			RenderToTexture* destination = camera->GetSwapTexture().get();
+			swapTexture = acquireSwapTexture(mainBuffer);
+			RenderToTexture* destination = swapTexture.get();
 			int index = 0;
 			PROFILER_ADDDTICKBEGIN(postTime);
 			while(index < count)
@@ -480,7 +628,7 @@ namespace Graphic
 
 		if (contain(params,RenderData::Screen))
 		{
-			if (source == camera->GetSwapTexture().get())
+			if (swapTexture.isvalid() && source == swapTexture.get())
 			{
 				PROFILER_ADDDTICKBEGIN(postTime);
 				ImageFiltrationSystem::Render(&source->GetTextureHandle(), mainBuffer.get(), NULL, 0);//SwapTextureûȻ壬ҪcopymainBuffer
@@ -493,5 +641,20 @@ namespace Graphic
 		GraphicSystem::Instance()->SetRenderTarget(camera->GetBackBuffer(), 0, RenderBase::RenderTarget::ClearAll);
 #endif
 		ImageFiltrationSystem::Render(&source->GetTextureHandle(), NULL, NULL, 0);
+
+		if (swapTexture.isvalid())
+		{
+			RenderToTextureManager::Instance()->ReleaseTransient(swapTexture);
+		}
+	}
+
+	GPtr<RenderToTexture> RenderPipeline::acquireSwapTexture(const GPtr<RenderToTexture>& mainBuffer)
+	{
+		TransientTargetDesc desc;
+		desc.width = mainBuffer->GetWidth();
+		desc.height = mainBuffer->GetHeight();
+		desc.format = RenderBase::PixelFormat::A8R8G8B8;
+		desc.quality = RenderBase::AntiAliasQuality::None;
+		return RenderToTextureManager::Instance()->AcquireTransient(desc);
 	}
 } 
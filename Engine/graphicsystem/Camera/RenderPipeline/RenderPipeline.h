@@ -61,6 +61,16 @@ namespace Graphic
 		bool empty(PipelineParamters& params, RenderData::Type type);
 		bool contain(PipelineParamters& params, RenderData::Type type);
 		void renderRenderableListWidthLight(PipelineParamters& params, RenderData::Type type, const Material* customMat); 
+		/// draw the run starting at it as one instanced draw if it can be, returns the number of render datas drawn (0: render it alone).
+		/// mark 0 takes any renderable, attLightSupport >= 0 only takes objects without attenuated lights
+		SizeT renderInstancedRun(PipelineParamters& params, RenderDataIndexArray::Iterator it, RenderDataIndexArray::Iterator end,
+			RenderPassType passType, const Material* customMat, uint mark, int attLightSupport);
+		/// draw the run starting at it as one sprite batch if it can be, same contract as renderInstancedRun
+		SizeT renderSpriteRun(PipelineParamters& params, RenderDataIndexArray::Iterator it, RenderDataIndexArray::Iterator end,
+			RenderPassType passType, const Material* customMat, uint mark, int attLightSupport);
+		/// try a sprite batch, then an instanced draw
+		SizeT renderBatchedRun(PipelineParamters& params, RenderDataIndexArray::Iterator it, RenderDataIndexArray::Iterator end,
+			RenderPassType passType, const Material* customMat, uint mark, int attLightSupport);
 
 		void renderDepthMap(PipelineParamters& params);
 		void renderLightLitMap(PipelineParamters& params);
@@ -71,6 +81,9 @@ namespace Graphic
 		void renderMain(PipelineParamters& params);
 		void renderScreenObjs(PipelineParamters& params);
 
+		/// full size swap target from the transient pool, release it with RenderToTextureManager::ReleaseTransient
+		GPtr<RenderToTexture> acquireSwapTexture(const GPtr<RenderToTexture>& mainBuffer);
+
 		GPtr<RenderToTexture> m_currentRT;
 	public:
 		static const int s_lightSupport;
@@ -256,8 +256,11 @@ namespace Graphic
 	void RenderPipelineManager::renderShadowMap(const ActiveLightInfo* aLight)
 	{
 		RenderLayer cullmark = GraphicSystem::Instance()->GetRenderingCamera()->GetCullMask();
-		aLight->light->RenderShadowMapBegin();
-		const Light::ShadowMapCameraList& list = aLight->light->GetShadowMapCameraList();
+		Light* light = aLight->light;
+		light->RenderShadowMapBegin();
+		const Light::ShadowMapCameraList& list = light->GetShadowMapCameraList();
+		Light::ShadowCascadeInfoList& infos = light->_GetShadowCascadeInfos();
+		n_assert(infos.Size() == list.Size());
 		for (int i = 0; i < list.Size(); ++i)
 		{
 			GPtr<Camera> camera = list[i];
@@ -265,8 +268,32 @@ namespace Graphic
 			GPtr<RenderPipelineManager>& mgr = camera->GetRenderPipelineManager();
 			mgr->m_pipelineContext.m_camera = camera.get();
 			mgr->m_pipelineContext.m_renderDatas.SetUseFor(RenderDataCollection::Shadow);
-			AssignVisibleNodes(mgr->m_pipelineContext);
+		}
+
+		light->_SetShadowCulledCount(assignShadowCasters(list));
+
+		for (int i = 0; i < list.Size(); ++i)
+		{
+			GPtr<Camera> camera = list[i];
+			GPtr<RenderPipelineManager>& mgr = camera->GetRenderPipelineManager();
+			Light::ShadowCascadeInfo& info = infos[i];
+
+			// a slot of the shadow atlas is kept as long as its cascade did not move and saw the same, unmoved, rigid casters.
+			bool deforming = false;
+			uint signature = shadowCasterSignature(mgr->m_pipelineContext, deforming);
+			const Math::matrix44& viewProj = camera->GetViewProjTransform();
+			info.casters = mgr->m_pipelineContext.m_visibleNodes.Count();
+
+			if (info.valid && !deforming && signature == info.signature && viewProj == info.viewProj)
+			{
+				info.redrawn = false;
+				info.renderDatas = 0;
+				mgr->m_pipelineContext.m_camera = NULL;
+				continue;
+			}
+
 			AssignRenderDatas(mgr->m_pipelineContext);
+			info.renderDatas = mgr->m_pipelineContext.m_renderDatas.GetRenderDatas().Count();
 			renderPipeline(mgr);
 			GlobalMaterialParam* pGMP = Material::GetGlobalMaterialParams();
 			n_assert(NULL != pGMP);
@@ -276,7 +303,136 @@ namespace Graphic
 			desRect.x() = shadowMapParam.x() * i;
 			desRect.z() = desRect.x() + shadowMapParam.x();
 			GraphicSystem::Instance()->CopyRenderTarget(camera->GetRenderToTexture()->GetTargetHandle(),srcRect,camera->GetSwapTexture()->GetTargetHandle(),desRect);
+
+			info.viewProj = viewProj;
+			info.signature = signature;
+			info.valid = !deforming;
+			info.redrawn = true;
 			mgr->m_pipelineContext.m_camera = NULL;
 		}
 	}
+
+	SizeT RenderPipelineManager::assignShadowCasters(const Util::Array<GPtr<Camera> >& cameras)
+	{
+		if (cameras.IsEmpty())
+		{
+			return 0;
+		}
+
+		// all cascades look along the light, so the union of their frusta is one box in light view space.
+#if RENDERDEVICE_OPENGL || RENDERDEVICE_OPENGLES
+		const float ndcNear = -1.0f;
+#else
+		const float ndcNear = 0.0f;
+#endif
+		const Math::matrix44& lightView = cameras[0]->GetViewTransform();
+		Math::float4 vMin(N_FLOAT32_MAX, N_FLOAT32_MAX, N_FLOAT32_MAX, 1.0f);
+		Math::float4 vMax(-N_FLOAT32_MAX, -N_FLOAT32_MAX, -N_FLOAT32_MAX, 1.0f);
+		for (IndexT i = 0; i < cameras.Size(); ++i)
+		{
+			Math::matrix44 invViewProj = Math::matrix44::inverse(cameras[i]->GetViewProjTransform());
+			for (IndexT corner = 0; corner < 8; ++corner)
+			{
+				Math::float4 ndc((corner & 1) ? 1.0f : -1.0f, (corner & 2) ? 1.0f : -1.0f, (corner & 4) ? 1.0f : ndcNear, 1.0f);
+				Math::float4 world = Math::matrix44::transform(invViewProj, ndc);
+				world *= 1.0f / world.w();
+				Math::float4 inLight = Math::matrix44::transform(lightView, world);
+				vMin = Math::float4::minimize(vMin, inLight);
+				vMax = Math::float4::maximize(vMax, inLight);
+			}
+		}
+		Math::matrix44 unionProj = Math::matrix44::orthooffcenterrh(vMin.x(), vMax.x(), vMin.y(), vMax.y(), -vMax.z(), -vMin.z());
+		Math::matrix44 unionViewProj = Math::matrix44::multiply(unionProj, lightView);
+
+		Camera* first = cameras[0].get();
+		GPtr<Vis::VisQuery> pVisQuery = first->GetRenderScene()->Cull(unionViewProj, first->GetTransform().get_position());
+		n_assert( pVisQuery.isvalid() );
+		const Util::Array<GPtr<Vis::VisEntity> >& viEnityList = pVisQuery->GetQueryResult();
+
+		for (IndexT i = 0; i < cameras.Size(); ++i)
+		{
+			PipelineParamters& params = cameras[i]->GetRenderPipelineManager()->m_pipelineContext;
+			params.m_callBacks.Clear();
+			params.m_visibleNodes.Clear();
+		}
+
+		Math::float4 camPos = first->GetTransform().get_position();
+		Math::float4 camDir = -first->GetTransform().get_zaxis();
+		uint cullMask = (uint)first->GetCullMask();
+
+		for (IndexT i = 0; i < viEnityList.Size(); ++i)
+		{
+			const GPtr<Vis::VisEntity>& visEnt = viEnityList[i];
+			n_assert( visEnt.isvalid() );
+			Graphic::GraphicObject* obj = visEnt->GetUserData();
+			n_assert( obj && obj->GetRtti()->IsDerivedFrom( RenderObject::RTTI ) );
+
+			RenderObject* renderObj = static_cast<RenderObject*>(obj);
+			if (!(renderObj->GetRenderCullMark() & cullMask))
+			{
+				continue;
+			}
+
+			Math::float4 camToObj = renderObj->GetTransform().get_position() - camPos;
+			float distance = Math::float4::dot3(camDir, camToObj);
+			const Math::bbox& box = visEnt->GetBoundingBox();
+			for (IndexT c = 0; c < cameras.Size(); ++c)
+			{
+				if (Math::ClipStatus::Outside != box.clipstatus(cameras[c]->GetViewProjTransform()))
+				{
+					VisibleNode& node = cameras[c]->GetRenderPipelineManager()->m_pipelineContext.m_visibleNodes.PushBack();
+					node.object = renderObj;
+					node.distance = distance;
+				}
+			}
+		}
+
+		// objects kept out of culling are casters of every cascade, as in AssignVisibleNodes
+		for (IndexT c = 0; c < cameras.Size(); ++c)
+		{
+			Camera* camera = cameras[c].get();
+			PipelineParamters& params = camera->GetRenderPipelineManager()->m_pipelineContext;
+			uint mask = (uint)camera->GetCullMask();
+			if (eCO_Main == camera->GetCameraOrder())
+			{
+				appendNotCulled(params, camera->GetRenderScene()->GetNotCullRenderObjects(), mask);
+			}
+			appendNotCulled(params, camera->GetNotCullRenderObjects(), mask);
+		}
+		return viEnityList.Size();
+	}
+
+	void RenderPipelineManager::appendNotCulled(PipelineParamters& params, const Util::Array<RenderObject*>& objects, uint cullMask)
+	{
+		Util::Array<RenderObject*>::Iterator it = objects.Begin();
+		Util::Array<RenderObject*>::Iterator end = objects.End();
+		while(it != end)
+		{
+			if ((*it)->GetRenderCullMark() & cullMask)
+			{
+				VisibleNode& node = params.m_visibleNodes.PushBack();
+				node.object = *it;
+				node.distance = 0;
+			}
+			++it;
+		}
+	}
+
+	uint RenderPipelineManager::shadowCasterSignature(const PipelineParamters& params, bool& deforming)
+	{
+		// FNV-1a over the caster pointers and their shadow versions.
+		uint hash = 2166136261u;
+		deforming = false;
+		VisibleNodeCollection::ConstIterator it = params.m_visibleNodes.Begin();
+		VisibleNodeCollection::ConstIterator end = params.m_visibleNodes.End();
+		while(it != end)
+		{
+			const RenderObject* obj = it->object;
+			deforming |= obj->IsDeforming();
+			hash = (hash ^ (uint)(size_t)obj) * 16777619u;
+			hash = (hash ^ obj->GetShadowVersion()) * 16777619u;
+			++it;
+		}
+		return hash;
+	}
 }
@@ -85,6 +85,12 @@ namespace Graphic
 	protected:
 		static void renderPipeline(GPtr<RenderPipelineManager>& renderpipemanager);
 		static void renderShadowMap(const ActiveLightInfo* aLight);
+		/// cull the casters of all cascades once, against the union of the cascade frusta, and bucket them per cascade. returns the number of entities culled.
+		static SizeT assignShadowCasters(const Util::Array<GPtr<Camera> >& cameras);
+		/// append the objects matching cullMask to the visible nodes
+		static void appendNotCulled(PipelineParamters& params, const Util::Array<RenderObject*>& objects, uint cullMask);
+		/// hash of the casters of a cascade, deforming is set if one of them changes without moving
+		static uint shadowCasterSignature(const PipelineParamters& params, bool& deforming);
 	public:
 		PipelineParamters					m_pipelineContext;
 		GPtr<ForwardShadingRenderPipeline> m_forwardPipeline;
@@ -89,6 +89,8 @@ namespace Graphic
 		,m_uiDrawCallBack(NULL)
 		,m_uiBeforeDrawCallBack(NULL)
 		,m_fontCallBack(NULL)
+		,m_bindingSerial(0)
+		,m_numDrawCalls(0)
 	{
 		__ConstructImageSingleton;
 		m_graphicDisplay = RenderDisplay::Create();
@@ -159,6 +161,12 @@ namespace Graphic
 		m_streamBufferPool = StreamBufferPool::Create();
 		m_streamBufferPool->Setup(DefaultBlockSize, AdditionBlockSize);
 
+		m_instanceBatcher = InstanceBatcher::Create();
+		m_instanceBatcher->Setup();
+
+		m_spriteBatcher = SpriteBatcher::Create();
+		m_spriteBatcher->Setup();
+
 		m_ViewPortLists[MainViewPort]->SetDisplayMode(RenderBase::DisplayMode(0, 0, width, height, RenderBase::PixelFormat::X8R8G8B8));
 	}
 	//------------------------------------------------------------------------
@@ -180,6 +188,8 @@ namespace Graphic
 	void GraphicSystem::OnUpateFrame()
 	{
 		PROFILER_RESETDEVICESTATS();
+		m_instanceBatcher->ResetFrameStats();
+		m_spriteBatcher->ResetFrameStats();
 		PROFILER_ADDDTICKBEGIN(drawTime);
 		RenderAll();
 		Material::GetGlobalMaterialParams()->ResetTextureCache();
@@ -288,6 +298,8 @@ namespace Graphic
 	//--------------------------------------------------------------------------------
 	void GraphicSystem::OnBeginFrame()
 	{
+		m_RenderToTexturesManager->BeginFrame();
+
 		if (m_ViewPortDirty)
 		{
 			ViewPorts::Iterator it = m_ViewPortLists.Begin();
@@ -308,6 +320,8 @@ namespace Graphic
 				}
 				++it;
 			}
+			// resized camera targets lose the copied shadow cascades too
+			_InvalidateShadowCaches();
 			m_ViewPortDirty = false;
 		}
 	}
@@ -338,6 +352,12 @@ namespace Graphic
 		m_streamBufferPool->Destory();
 		m_streamBufferPool = NULL;
 
+		m_instanceBatcher->Discard();
+		m_instanceBatcher = NULL;
+
+		m_spriteBatcher->Discard();
+		m_spriteBatcher = NULL;
+
 		Material::RemoveGlobalMaterialParams();
 
 		CloseRenderSystem();
@@ -366,6 +386,7 @@ namespace Graphic
 
 	void GraphicSystem::SetVertexShaderConstantVectorF(const int& reg, const float4* val, const int& vec4count)
 	{
+		++m_bindingSerial;
 #if USE_RENDER_THREAD
 		GPtr<RenderBase::SetVertexShaderConstantVectorFMSG> svscmsg = RenderBase::SetVertexShaderConstantFMSG::Create();
 		svscmsg->SetReg(regIndex);
@@ -381,6 +402,7 @@ namespace Graphic
 
 	void GraphicSystem::SetPixelShaderConstantVectorF(const int& reg, const float4* val, const int& vec4count)
 	{
+		++m_bindingSerial;
 #if USE_RENDER_THREAD
 		GPtr<RenderBase::SetPixelShaderConstantVectorFMSG> spscmsg = RenderBase::SetPixelShaderConstantFMSG::Create();
 		spscmsg->SetReg(regIndex);
@@ -395,6 +417,7 @@ namespace Graphic
 
 	void GraphicSystem::SetVertexShaderConstantFloat(const int& reg, const float& val)
 	{
+		++m_bindingSerial;
 #if USE_RENDER_THREAD
 		GPtr<RenderBase::SetVertexShaderConstantFloatMSG> svscmsg = RenderBase::SetVertexShaderConstantFMSG::Create();
 		svscmsg->SetReg(regIndex);
@@ -407,6 +430,7 @@ namespace Graphic
 
 	void GraphicSystem::SetPixelShaderConstantFloat(const int& reg, const float& val)
 	{
+		++m_bindingSerial;
 #if USE_RENDER_THREAD
 		GPtr<RenderBase::SetPixelShaderConstantFloatMSG> svscmsg = RenderBase::SetVertexShaderConstantFMSG::Create();
 		svscmsg->SetReg(regIndex);
@@ -419,6 +443,7 @@ namespace Graphic
 
 	void GraphicSystem::SetVertexShaderConstantMatrixF(const int& reg, const matrix44* val, const int& matrixCount)
 	{
+		++m_bindingSerial;
 #if USE_RENDER_THREAD
 		GPtr<RenderBase::SetVertexShaderConstantMatrixFMSG> svscmsg = RenderBase::SetVertexShaderConstantFMSG::Create();
 		svscmsg->SetReg(regIndex);
@@ -432,6 +457,7 @@ namespace Graphic
 
 	void GraphicSystem::SetPixelShaderConstantMatrixF(const int& reg, const matrix44* val, const int& matrixCount)
 	{
+		++m_bindingSerial;
 #if USE_RENDER_THREAD
 		GPtr<RenderBase::SetPixelShaderConstantMatrixFMSG> svscmsg = RenderBase::SetVertexShaderConstantFMSG::Create();
 		svscmsg->SetReg(regIndex);
@@ -458,6 +484,11 @@ namespace Graphic
 
 	void GraphicSystem::SetShaderProgram(GPUProgramHandle handle)
 	{
+		if (handle != m_lastProgram)
+		{
+			m_lastProgram = handle;
+			++m_bindingSerial;
+		}
 #if USE_RENDER_THREAD
 		GPtr<RenderBase::SetGPUProgramMSG> ssmsg = RenderBase::SetGPUProgramMSG::Create();
 		ssmsg->SetHandle(handle);
@@ -621,6 +652,20 @@ namespace Graphic
 #endif
 	}
 
+	void GraphicSystem::UpdatePrimitiveVertices(RenderBase::PrimitiveHandle& handle, const void* vertices, SizeT sizeInByte, SizeT offsetInByte)
+	{
+#if USE_RENDER_THREAD
+		n_error("GraphicSystem::UpdatePrimitiveVertices is not supported with the render thread!");
+#else
+		n_assert(vertices);
+		RenderBase::DataStream ds;
+		ds.data = const_cast<void*>(vertices);
+		ds.sizeInByte = sizeInByte;
+		ds.offsetInByte = offsetInByte;
+		mRenderSystem->UpdateVertexBuffer(handle, ds);
+#endif
+	}
+
 	void GraphicSystem::GetVertexComponents(const RenderBase::PrimitiveHandle& handle, RenderBase::VertexComponents& vcs)
 	{
 		PrimitiveGroup* pg = mRenderSystem->GetPrimitiveGroup(handle);
@@ -671,6 +716,7 @@ namespace Graphic
 			startIndice,
 			numIndice);
 #endif
+		++m_numDrawCalls;
 
 	}
 
@@ -687,7 +733,22 @@ namespace Graphic
 #else
 		mRenderSystem->_DrawPrimitive(handle);
 #endif
+		++m_numDrawCalls;
+	}
 
+	void GraphicSystem::DrawPrimitiveInstanced(RenderBase::PrimitiveHandle handle, SizeT startVertice, SizeT numVertice, SizeT startIndice, SizeT numIndice,
+		RenderBase::PrimitiveHandle instanceStream, const void* instances, SizeT sizeInByte, SizeT numInstances)
+	{
+#if USE_RENDER_THREAD
+		n_error("GraphicSystem::DrawPrimitiveInstanced is not supported with the render thread!");
+#else
+		RenderBase::DataStream ds;
+		ds.data = const_cast<void*>(instances);
+		ds.sizeInByte = sizeInByte;
+		mRenderSystem->UpdateVertexBuffer(instanceStream, ds);
+		mRenderSystem->_DrawPrimitiveInstanced(handle, startVertice, numVertice, startIndice, numIndice, instanceStream, numInstances);
+#endif
+		++m_numDrawCalls;
 	}
 	void GraphicSystem::RemovePrimitive(const RenderBase::PrimitiveHandle &handle)
 	{
@@ -822,6 +883,7 @@ namespace Graphic
 
 	void GraphicSystem::SetTexture(SizeT index,TextureHandle handle)
 	{
+		++m_bindingSerial;
 #if USE_RENDER_THREAD
 		GPtr<RenderBase::SetTextureMSG> stmsg = RenderBase::SetTextureMSG::Create();
 		stmsg->SetTexUnit(index);
@@ -1033,6 +1095,8 @@ namespace Graphic
 	void GraphicSystem::OnDeviceLost()
 	{
 		mRenderSystem->OnDeviceLost();
+		m_lastProgram = RenderBase::GPUProgramHandle();
+		++m_bindingSerial;
 		_OnDeviceLost();
 	}
 	bool GraphicSystem::CheckReset()
@@ -1043,16 +1107,19 @@ namespace Graphic
 	void GraphicSystem::OnDeviceReset()
 	{
 		mRenderSystem->OnDeviceReset();
+		m_lastProgram = RenderBase::GPUProgramHandle();
+		++m_bindingSerial;
 		_OnDeviceReset();
 	}
 
 	void GraphicSystem::_OnDeviceLost()
 	{
-
+		_InvalidateShadowCaches();
 	}
 
 	void GraphicSystem::_OnDeviceReset()
 	{
+		m_RenderToTexturesManager->DiscardTransients();
 #if RENDERDEVICE_D3D9
 
 		CameraList::Iterator end = m_cameraList.End();
@@ -1069,7 +1136,25 @@ namespace Graphic
 		Resources::ResourceManager::Instance()->ReloadAllVideoMemResource();
 		ResetAllQuadRenderable();
 #endif
+		_InvalidateShadowCaches();
+	}
 
+	void GraphicSystem::_InvalidateShadowCaches()
+	{
+		CameraList::Iterator end = m_cameraList.End();
+		for( CameraList::Iterator iter = m_cameraList.Begin(); iter != end; ++iter )
+		{
+			RenderScene* scene = (*iter)->GetRenderScene();
+			if (NULL == scene)
+			{
+				continue;
+			}
+			const RenderScene::Lights& lights = scene->GetLights();
+			for (IndexT i = 0; i < lights.Size(); ++i)
+			{
+				lights[i]->InvalidateShadowCache();
+			}
+		}
 	}
 
 
@@ -39,6 +39,8 @@ THE SOFTWARE.
 #include "vis/visserver.h"
 #include "vis/visquery.h"
 #include "graphicsystem/base/StreamBufferPool.h"
+#include "graphicsystem/Renderable/InstanceBatcher.h"
+#include "graphicsystem/Renderable/SpriteBatcher.h"
 #include "ViewPortWindow.h"
 #include "util/stack.h"
 #include "foundation/delegates/delegatetype.h"
@@ -88,6 +90,8 @@ namespace Graphic
 	private:
 		void _OnDeviceLost();
 		void _OnDeviceReset();
+		/// the cached shadow cascades of all lights are lost with the render targets
+		void _InvalidateShadowCaches();
 	public:
 
 		void AddCamera(Camera* camera);
@@ -129,6 +133,8 @@ namespace Graphic
 		RenderBase::PrimitiveHandle CreatePrimitiveHandle(const VertexBufferData2* vbd2, const IndexBufferData2* ibd2 = NULL);
 
 		void UpdatePrimitiveHandle(RenderBase::PrimitiveHandle& handle, const DynamicBuffer* vertices, const DynamicBuffer* indices = NULL);
+		/// write vertices at offsetInByte of a dynamic vertex buffer, offset 0 discards the old content
+		void UpdatePrimitiveVertices(RenderBase::PrimitiveHandle& handle, const void* vertices, SizeT sizeInByte, SizeT offsetInByte);
 		void ChangePrimitiveHandle(RenderBase::PrimitiveHandle& handle, const RenderBase::VertexBufferData* vbd, const RenderBase::IndexBufferData* ibd = NULL);
 		void ChangePrimitiveHandle(RenderBase::PrimitiveHandle& handle, const VertexBufferData2* vbd2, const IndexBufferData2* ibd2 = NULL);
 
@@ -139,7 +145,12 @@ namespace Graphic
 
 		void DrawPrimitive(RenderBase::PrimitiveHandle handle, SizeT startVertice, SizeT numVertice, SizeT startIndice, SizeT numIndice);
 		void DrawPrimitive(RenderBase::PrimitiveHandle handle);
+		/// upload numInstances records to instanceStream and draw that many copies of the range
+		void DrawPrimitiveInstanced(RenderBase::PrimitiveHandle handle, SizeT startVertice, SizeT numVertice, SizeT startIndice, SizeT numIndice,
+			RenderBase::PrimitiveHandle instanceStream, const void* instances, SizeT sizeInByte, SizeT numInstances);
 		void RemovePrimitive(const RenderBase::PrimitiveHandle &handle);
+		/// draw calls submitted since open, an instanced draw counts once
+		SizeT GetNumDrawCalls() const;
 
 		RenderBase::RenderStateDescHandle CreateRenderStateDesc( GPtr<RenderBase::RenderStateDesc> rsObject);
 		void SetRenderState( GPtr<RenderBase::RenderStateDesc> rsObject);
@@ -184,6 +195,21 @@ namespace Graphic
 
 		void SetWireFrameMode(bool wireframe = false);
 
+		/// drop redundant program, texture, render state and constant writes before the device
+		void SetStateFilterEnabled(bool enable);
+
+		const RenderBase::RenderStateCache& GetStateCache() const;
+
+		/// does the program read the per instance stream
+		bool IsInstancingProgram(const RenderBase::GPUProgramHandle& handle) const;
+		/// batches identical mesh/material render datas into instanced draws
+		InstanceBatcher* GetInstanceBatcher() const;
+		/// batches sprites of one material and image into a shared vertex ring buffer
+		SpriteBatcher* GetSpriteBatcher() const;
+
+		/// bumped by every constant, texture or program write; equal serials mean the device bindings are untouched
+		uint GetBindingSerial() const;
+
 
 		typedef void (*UICallBack)();
 		inline void SetUIBeforeDrawCallBack(UICallBack call_back)
@@ -273,6 +299,13 @@ namespace Graphic
 
 		Util::Array< QuadRenderable* > m_AllQuadRenderable;
 
+		uint								m_bindingSerial;
+		RenderBase::GPUProgramHandle		m_lastProgram;
+
+		GPtr<InstanceBatcher>				m_instanceBatcher;
+		GPtr<SpriteBatcher>					m_spriteBatcher;
+		SizeT								m_numDrawCalls;
+
 	};
 
 	inline const CameraList& GraphicSystem::GetCameraList() const
@@ -285,6 +318,11 @@ namespace Graphic
 		return m_graphicDisplay;
 	}
 
+	inline uint GraphicSystem::GetBindingSerial() const
+	{
+		return m_bindingSerial;
+	}
+
 	inline const RenderBase::GraphicCardCapability GraphicSystem::GetGraphicCardCapability()
 	{
 		return mRenderSystem->GetGraphicCardCapability();
@@ -295,6 +333,36 @@ namespace Graphic
 		mRenderSystem->SetWireFrameMode(wireframe);
 	}
 
+	inline void GraphicSystem::SetStateFilterEnabled(bool enable)
+	{
+		mRenderSystem->SetStateFilterEnabled(enable);
+	}
+
+	inline const RenderBase::RenderStateCache& GraphicSystem::GetStateCache() const
+	{
+		return mRenderSystem->GetStateCache();
+	}
+
+	inline bool GraphicSystem::IsInstancingProgram(const RenderBase::GPUProgramHandle& handle) const
+	{
+		return mRenderSystem->IsInstancingProgram(handle);
+	}
+
+	inline InstanceBatcher* GraphicSystem::GetInstanceBatcher() const
+	{
+		return m_instanceBatcher.get();
+	}
+
+	inline SpriteBatcher* GraphicSystem::GetSpriteBatcher() const
+	{
+		return m_spriteBatcher.get();
+	}
+
+	inline SizeT GraphicSystem::GetNumDrawCalls() const
+	{
+		return m_numDrawCalls;
+	}
+
 	inline float GraphicSystem::GetHorizontalTexelOffset()
 	{
 		return mRenderSystem->GetHorizontalTexelOffset();
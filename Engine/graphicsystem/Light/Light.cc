@@ -52,6 +52,7 @@ namespace Graphic
 		//m_owner(NULL),
 		m_listener(NULL),
 		m_renderScene(NULL),
+		m_shadowCulledCount(0),
 		m_Lightmapping(eLM_Flexible),
 		m_LightmapShadow(false)
 	{
@@ -88,6 +89,16 @@ namespace Graphic
 
 		}
 		m_shadowMapCameras.Clear();
+		m_shadowCascadeInfos.Clear();
+		m_shadowCulledCount = 0;
+	}
+
+	void Light::InvalidateShadowCache()
+	{
+		for (IndexT i = 0; i < m_shadowCascadeInfos.Size(); ++i)
+		{
+			m_shadowCascadeInfos[i].valid = false;
+		}
 	}
 
 	void Light::Attach(RenderScene* rnsc)
@@ -268,6 +279,16 @@ namespace Graphic
 				m_shadowMapCameras.Append(shadowMapCamera);
 			}
 
+			ShadowCascadeInfo info;
+			info.viewProj = Math::matrix44::identity();
+			info.signature = 0;
+			info.valid = false;
+			info.redrawn = false;
+			info.casters = 0;
+			info.renderDatas = 0;
+			m_shadowCascadeInfos.Clear();
+			m_shadowCascadeInfos.Resize(splitCount, info);
+
 			for (SizeT i = splitCount ; i < S_C_CASCADEDCAMERANUM; i++)
 			{
 				if ( i  >= (m_dummyShadowRTs.Size() + splitCount) )
@@ -67,6 +67,18 @@ namespace Graphic
 
 		typedef GPtr<Camera> ShadowMapCamera;
 		typedef Util::Array<ShadowMapCamera> ShadowMapCameraList;
+
+		/// what the last shadow pass did for one cascade, and what its slot of the shadow atlas holds
+		struct ShadowCascadeInfo
+		{
+			Math::matrix44 viewProj;	// view projection the atlas slot was rendered with
+			uint signature;				// hash of the casters and render datas the slot was rendered from
+			bool valid;					// the atlas slot may be reused while viewProj and signature match
+			bool redrawn;				// the last pass rendered the cascade, false if the cached slot was kept
+			SizeT casters;				// visible nodes bucketed into the cascade
+			SizeT renderDatas;			// render datas collected and sorted for the cascade
+		};
+		typedef Util::Array<ShadowCascadeInfo> ShadowCascadeInfoList;
 		Light();
 		virtual ~Light();
 
@@ -138,6 +150,16 @@ namespace Graphic
 		const float& GetExponent() const;
 
 		const ShadowMapCameraList& GetShadowMapCameraList() const;
+		/// per cascade statistics of the last shadow pass
+		const ShadowCascadeInfoList& GetShadowCascadeInfos() const;
+		/// entities returned by the shared caster cull of the last shadow pass
+		SizeT GetShadowCulledCount() const;
+		/// force every cascade to be redrawn by the next shadow pass
+		void InvalidateShadowCache();
+		// !!!!!!internal call!!!!!  for the shadow pass.
+		ShadowCascadeInfoList& _GetShadowCascadeInfos();
+		// !!!!!!internal call!!!!!  for the shadow pass.
+		void _SetShadowCulledCount(SizeT count);
 		// check the state of light
 		void SetEnableShadow(bool enable);
 		const bool IsEnableShadow() const;
@@ -167,6 +189,8 @@ namespace Graphic
 		LightListener* m_listener;
 		RenderScene* m_renderScene;
 		ShadowMapCameraList m_shadowMapCameras;
+		ShadowCascadeInfoList m_shadowCascadeInfos;
+		SizeT m_shadowCulledCount;
 		Util::Array<GPtr<RenderToTexture> > m_dummyShadowRTs;
 
 		float4 m_lightColor;
@@ -376,6 +400,30 @@ namespace Graphic
 		return m_shadowMapCameras;
 	}
 
+	inline const Light::ShadowCascadeInfoList& 
+		Light::GetShadowCascadeInfos() const
+	{
+		return m_shadowCascadeInfos;
+	}
+
+	inline Light::ShadowCascadeInfoList& 
+		Light::_GetShadowCascadeInfos()
+	{
+		return m_shadowCascadeInfos;
+	}
+
+	inline SizeT 
+		Light::GetShadowCulledCount() const
+	{
+		return m_shadowCulledCount;
+	}
+
+	inline void 
+		Light::_SetShadowCulledCount(SizeT count)
+	{
+		m_shadowCulledCount = count;
+	}
+
 	inline const bool 
 		Light::IsEnableShadow() const
 	{
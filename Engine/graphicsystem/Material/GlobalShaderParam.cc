@@ -46,6 +46,8 @@ namespace Graphic
 	{
 		//matrix map
 		m_globalShaderParams.SetSize( GlobalParamCount );
+		m_paramVersions.SetSize( GlobalParamCount );
+		m_paramVersions.Fill( 1 );
 
 		//m_globalShaderParams[eGShaderMatMVP] = GlobalShaderParam(matrix44(),Util::String("g_ModelViewProj"));
 		m_globalShaderParams[eGShaderMatV] = GlobalShaderParam(matrix44(),Util::String("g_View"));
@@ -128,6 +130,7 @@ namespace Graphic
 	{
 		n_assert(index >= eGShaderMatBegin && index < eGShaderMatEnd);
 		m_globalShaderParams[index].m_value.SetMatrix44(mat);
+		_Touch(index);
 	}
 
 	void GlobalMaterialParam::GetMatrixParam(GlobalMatrixParamIndex index,Util::String& name, Math::matrix44& mat) const
@@ -143,6 +146,7 @@ namespace Graphic
 		n_assert(index >= eGShaderVecBegin && index < eGShaderVecEnd);
 
 		m_globalShaderParams[index].m_value.SetFloat4(vec);
+		_Touch(index);
 	}
 
 	void GlobalMaterialParam::GetVectorParam(GlobalVectorParamIndex index,Util::String& name,Math::float4& vec) const
@@ -158,6 +162,7 @@ namespace Graphic
 		n_assert(index >= eGShaderVecBegin && index < eGShaderVecEnd);
 
 		m_globalShaderParams[index].m_value.SetFloat4_X(val);
+		_Touch(index);
 	}
 
 	void GlobalMaterialParam::GetVectorParam_X(GlobalVectorParamIndex index,Util::String& name,float& val) const
@@ -173,6 +178,7 @@ namespace Graphic
 		n_assert(index >= eGShaderVecBegin && index < eGShaderVecEnd);
 
 		m_globalShaderParams[index].m_value.SetFloat4_Y(val);
+		_Touch(index);
 	}
 
 	void GlobalMaterialParam::GetVectorParam_Y(GlobalVectorParamIndex index,Util::String& name,float& val) const
@@ -188,6 +194,7 @@ namespace Graphic
 		n_assert(index >= eGShaderVecBegin && index < eGShaderVecEnd);
 
 		m_globalShaderParams[index].m_value.SetFloat4_Z(val);
+		_Touch(index);
 	}
 
 	void GlobalMaterialParam::GetVectorParam_Z(GlobalVectorParamIndex index,Util::String& name,float& val) const
@@ -203,6 +210,7 @@ namespace Graphic
 		n_assert(index >= eGShaderVecBegin && index < eGShaderVecEnd);
 
 		m_globalShaderParams[index].m_value.SetFloat4_W(val);
+		_Touch(index);
 	}
 
 	void GlobalMaterialParam::GetVectorParam_W(GlobalVectorParamIndex index,Util::String& name,float& val) const
@@ -220,6 +228,7 @@ namespace Graphic
 		if ( m_globalShaderParams[index].m_name == texName )
 		{
 			m_globalShaderParams[index].m_value.SetObject(texHandle.AsObject());
+			_Touch(index);
 		}
 		else
 		{
@@ -232,6 +241,7 @@ namespace Graphic
 		n_assert( index >= eGShaderTexBegin && index < eGShaderTexEnd);
 
 		m_globalShaderParams[index].m_value.SetObject(texHandle.AsObject());
+		_Touch(index);
 	}
 
 	void GlobalMaterialParam::GetTextureParam(GlobalTexParamIndex index,Util::String& name,RenderBase::TextureHandle& handle) const
@@ -247,6 +257,7 @@ namespace Graphic
 		for ( IndexT i = eGShaderTexBegin; i < eGShaderTexEnd; ++i )
 		{
 			m_globalShaderParams[i].m_value.SetObject(NULL);
+			_Touch(i);
 		}
 	}
 
@@ -254,8 +254,14 @@ namespace Graphic
 		bool CheckTextureParamBind(GlobalTexParamIndex index, const Util::String& texName);
 
 		void ResetTextureCache();
+
+		/// changes whenever the slot is written; never 0, so 0 can mean "not uploaded yet"
+		uint GetParamVersion(IndexT index) const;
 	protected:
+		void _Touch(IndexT index);
+
 		GlobalShaderParamMap m_globalShaderParams;
+		Util::FixedArray<uint> m_paramVersions;
 	};
 
 	//------------------------------------------------------------------------
@@ -314,6 +320,24 @@ namespace Graphic
 		return m_globalShaderParams[index].m_name;
 	}
 	//------------------------------------------------------------------------
+	inline
+		uint
+		GlobalMaterialParam::GetParamVersion(IndexT index) const
+	{
+		return m_paramVersions[index];
+	}
+	//------------------------------------------------------------------------
+	inline
+		void
+		GlobalMaterialParam::_Touch(IndexT index)
+	{
+		uint& version = m_paramVersions[index];
+		if (0 == ++version)
+		{
+			version = 1;
+		}
+	}
+	//------------------------------------------------------------------------
 	inline
 		bool
 		GlobalMaterialParam::CheckTextureParamBind(GlobalTexParamIndex index, const Util::String& texName)
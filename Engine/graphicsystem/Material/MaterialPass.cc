@@ -48,6 +48,7 @@ namespace Graphic
 		m_GlobalBinding.SetSize( SCT_COUNT );
 		m_LocalBinding.SetSize( SCT_COUNT );
 		m_GlobaBingdingInfos.SetSize(SCT_COUNT);
+		m_UploadedVersions.SetSize(SCT_COUNT);
 	}
 
 	inline void _set_info(MatParamBindings& global_sct, IndexT& index, int& end_, int enum_)
@@ -73,6 +74,17 @@ namespace Graphic
 			_set_info(global_sct, index, info.VecCommonEnd, eGShaderVecCommonEnd);
 			_set_info(global_sct, index, info.VecCustomEnd, eGShaderVecCustomEnd);
 
+			m_UploadedVersions[sct].SetSize(global_sct.Size());
+		}
+		_ResetUploadedVersions();
+	}
+
+	//------------------------------------------------------------------------
+	void ShaderParamBindingMap::_ResetUploadedVersions()
+	{
+		for ( IndexT sct = SCT_VS; sct < SCT_COUNT; ++sct )
+		{
+			m_UploadedVersions[sct].Fill(0);
 		}
 	}
 
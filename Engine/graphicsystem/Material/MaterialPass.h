@@ -50,6 +50,7 @@ namespace Graphic
 	};
 	typedef Util::Array<MatParamBinding> MatParamBindings;
 	typedef Util::FixedArray<MatParamBindings> BindingMap;
+	typedef Util::FixedArray< Util::FixedArray<uint> > BindingVersionMap;
 
 	struct GlobalBindingInfo
 	{
@@ -104,6 +105,13 @@ namespace Graphic
 		}
 		void Setup();
 
+		/// GlobalMaterialParam version last uploaded per global binding, parallel to GetGlobalBinding. 0 means unknown.
+		Util::FixedArray<uint>& _GetUploadedVersions(ShaderCodeType t){
+			n_assert( t >= SCT_VS && t < SCT_COUNT);
+			return m_UploadedVersions[t];
+		}
+		void _ResetUploadedVersions();
+
 	protected:
 
 
@@ -111,6 +119,7 @@ namespace Graphic
 		BindingMap m_GlobalBinding;	//	used for global parameters.
 		BindingMap m_LocalBinding;	//	used for local parameters.
 		GlobalBindingInfoMap m_GlobaBingdingInfos;
+		BindingVersionMap m_UploadedVersions;
 		friend class MaterialPass;
 	};
 
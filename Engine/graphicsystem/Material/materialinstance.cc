@@ -36,9 +36,11 @@ namespace Graphic
 	GPtr<MaterialInstance> MaterialInstance::NullMaterial(NULL);
 	static uint sInstanceID = 1;//λʾ
 	static const Util::String scUserDefTex="#UserDefTex";
+	Util::Array<MaterialInstance*> MaterialInstance::s_dirtyMaterials;
 
 
 	MaterialInstance::MaterialInstance() : m_dirty(false)
+		, m_queued(false)
 		, m_allLoaded(false)
 		, m_isbuild(false)
 		, m_materialID("")
@@ -51,9 +53,39 @@ namespace Graphic
 
 	MaterialInstance::~MaterialInstance()
 	{
+		if (m_queued)
+		{
+			IndexT index = s_dirtyMaterials.FindIndex(this);
+			if (InvalidIndex != index)
+			{
+				s_dirtyMaterials.EraseIndexSwap(index);
+			}
+		}
 		m_renderState = 0;
 	}
 
+	void MaterialInstance::_MarkDirty()
+	{
+		m_dirty = true;
+		if (!m_queued)
+		{
+			m_queued = true;
+			s_dirtyMaterials.Append(this);
+		}
+	}
+
+	void MaterialInstance::_TakeDirtyMaterials(Util::Array<GPtr<MaterialInstance> >& outList)
+	{
+		outList.Clear(false);
+		outList.Reserve(s_dirtyMaterials.Size());
+		for (IndexT i = 0; i < s_dirtyMaterials.Size(); ++i)
+		{
+			s_dirtyMaterials[i]->m_queued = false;
+			outList.Append(GPtr<MaterialInstance>(s_dirtyMaterials[i]));
+		}
+		s_dirtyMaterials.Clear(false);
+	}
+
 	SizeT MaterialInstance::GetTextureParamCount() const
 	{
 		return m_texParams.Size();
@@ -124,7 +156,7 @@ namespace Graphic
 				}
 				else
 				{
-					m_dirty = true;	
+					_MarkDirty();
 				}
 			}			
 		}
@@ -158,13 +190,13 @@ namespace Graphic
 
 				TexParamMap::key_value_pair_type& pair = m_texParams.KeyValuePairAtIndex(findtex);
 				pair.Value() = tri;
-				m_dirty = true;				
+				_MarkDirty();
 				return;
 			}			
 		}
 		GPtr<TextureResInfo> tri = ResourceManager::Instance()->CreateTextureInfo(*texID,priority);
 		m_texParams.Add( paramName, tri);	
-		m_dirty = true;
+		_MarkDirty();
 	}
 
 	void MaterialInstance::RemoveTexture(const ShaderParamString& paramName)
@@ -176,7 +208,7 @@ namespace Graphic
 			if ( findtex != InvalidIndex )
 			{
 				texMap.EraseAtIndex(findtex);				
-				m_dirty = true;
+				_MarkDirty();
 			}			
 		}
 	}
@@ -350,7 +382,7 @@ namespace Graphic
 
 			}
 		}
-		m_dirty = true;
+		_MarkDirty();
 	}
 	//------------------------------------------------------------------------
 	void MaterialInstance::CopyFrom(GPtr<MaterialInstance>& rht)
@@ -362,7 +394,7 @@ namespace Graphic
 		//
 		m_shaderID	 = rht->m_shaderID;
 		//m_materialID = rht->m_materialID;
-		m_dirty = true;
+		_MarkDirty();
 		m_allLoaded = false;
 		m_isbuild = false;
 
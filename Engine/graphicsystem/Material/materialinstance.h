@@ -138,6 +138,9 @@ namespace Graphic
 		void RemoveConstantParam(const ShaderParamString& paramName);
 
 		void _SetBuildState(bool value);//just for ResourceManager.
+		void _MarkDirty();//just for ResourceManager, queues the instance for the next OnLoadingShader.
+		/// hand over the instances marked dirty since the last call, just for ResourceManager.
+		static void _TakeDirtyMaterials(Util::Array<GPtr<MaterialInstance> >& outList);
 		void _SetShaderID(const Resources::ResourceId& id);//just for MaterialInstanceManager.
 		ParamFindResult _SetConstantParam(const ShaderParamString& paramName, Util::String val);//just for serialization.
 		//public:		
@@ -155,6 +158,7 @@ namespace Graphic
 		TexParamMap m_texParams;
 		GPtr<RenderBase::RenderStateDesc> m_renderState;
 		bool m_dirty;
+		bool m_queued;
 		bool m_isbuild;
 		bool m_allLoaded;
 		uint m_sort;
@@ -162,6 +166,7 @@ namespace Graphic
 		Resources::ResourceId m_materialID;			// from file path.
 		friend class MaterialInstanceManager;
 
+		static Util::Array<MaterialInstance*> s_dirtyMaterials;
 	};
 
 	inline uint MaterialInstance::GetSort() const
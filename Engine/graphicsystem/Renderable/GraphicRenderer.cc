@@ -31,6 +31,8 @@ namespace Graphic
 
 	uint GraphicRenderer::s_preShaderInstanceID = 0;
 	void* GraphicRenderer::s_pPreMaterialInstance = 0;
+	ShaderParamBindingMap* GraphicRenderer::s_pGlobalOwner = 0;
+	uint GraphicRenderer::s_globalOwnerSerial = 0;
 	__ImplementAbstractClass(GraphicRenderer,'GFGS',Core::RefCounted)
 
 		GraphicRenderer::GraphicRenderer()
@@ -48,92 +50,6 @@ namespace Graphic
 		//empty
 	}
 
-	void GraphicRenderer::SetGlobalVertexShaderConstant(const ShaderParam& sp)
-	{
-		GlobalMaterialParam* gsp = Material::GetGlobalMaterialParams();
-
-		for ( SizeT i = eGShaderMatBegin; i < eGShaderMatEnd; ++i )//eGShaderMatMVP
-		{
-			Util::String paramName;
-			Math::matrix44 matVal;
-			gsp->GetMatrixParam(static_cast<GlobalMatrixParamIndex>(i),paramName,matVal);
-			if (paramName == sp.GetName())
-			{
-				GraphicSystem::Instance()->SetVertexShaderConstantMatrixF(sp.GetRegister(), &matVal,1);
-				return;
-			}
-		}
-
-		for ( SizeT i = eGShaderVecBegin; i < eGShaderVecEnd; ++i )
-		{
-			Util::String paramName;
-			Math::float4 vecVal;
-			gsp->GetVectorParam(static_cast<GlobalVectorParamIndex>(i),paramName,vecVal);
-			if (paramName == sp.GetName())
-			{
-				GraphicSystem::Instance()->SetVertexShaderConstantVectorF(sp.GetRegister(), &vecVal,1);
-				return;
-			}
-		}
-
-		for ( IndexT i = eGShaderTexBegin; i < eGShaderTexEnd; ++i )
-		{
-			Util::String paramName;
-			RenderBase::TextureHandle texHandle;
-
-			gsp->GetTextureParam(static_cast<GlobalTexParamIndex>(i),paramName,texHandle);
-			if (paramName == sp.GetName() && texHandle.IsValid())
-			{
-				GraphicSystem::Instance()->SetTexture(sp.GetRegister(),texHandle);
-				return;
-			}
-		}
-
-	}
-
-	void GraphicRenderer::SetGlobalPixelShaderConstant(const ShaderParam& sp)
-	{
-		GlobalMaterialParam* gsp = Material::GetGlobalMaterialParams();
-
-		for ( SizeT i = eGShaderMatBegin; i < eGShaderMatEnd; ++i )
-		{
-			Util::String paramName;
-			Math::matrix44 matVal;
-			gsp->GetMatrixParam(static_cast<GlobalMatrixParamIndex>(i),paramName,matVal);
-			if (paramName == sp.GetName())
-			{
-				GraphicSystem::Instance()->SetPixelShaderConstantMatrixF(sp.GetRegister(), &matVal,1);
-				return;
-			}
-		}
-
-		for ( SizeT i = eGShaderVecBegin; i < eGShaderVecEnd; ++i )
-		{
-			Util::String paramName;
-			Math::float4 vecVal;
-			gsp->GetVectorParam(static_cast<GlobalVectorParamIndex>(i),paramName,vecVal);
-			if (paramName == sp.GetName())
-			{
-				GraphicSystem::Instance()->SetPixelShaderConstantVectorF(sp.GetRegister(), &vecVal,1);
-				return;
-			}
-		}
-
-
-		for ( IndexT i = eGShaderTexBegin; i < eGShaderTexEnd; ++i )
-		{
-			Util::String paramName;
-			RenderBase::TextureHandle texHandle;
-
-			gsp->GetTextureParam(static_cast<GlobalTexParamIndex>(i),paramName,texHandle);
-			if (paramName == sp.GetName() && texHandle.IsValid())
-			{
-				GraphicSystem::Instance()->SetTexture(sp.GetRegister(),texHandle);
-				return;
-			}
-		}
-	}
-
 	void GraphicRenderer::BeforeRender(const Renderable* renderable, RenderPassType passType, const Material* customizedMat)
 	{
 		const MaterialInstance* material_instance = renderable->GetMaterial();
@@ -181,42 +97,37 @@ namespace Graphic
 		}
 	}
 
+
+	const MaterialPass* GraphicRenderer::GetRenderPass(const Renderable* renderable, RenderPassType passType, const Material* customizedMat)
+	{
+		const MaterialInstance* material_instance = renderable->GetMaterial();
+
+		if (passType && material_instance && material_instance->GetTech()->IsTemplateTech())
+		{
+			const Util::Array< GPtr<MaterialPass> >& passList = material_instance->GetTech()->GetPassList();
+			return (passType <= passList.Size()) ? passList[passType-1].get() : NULL;
+		}
+		else if (customizedMat)
+		{
+			return customizedMat->GetTech()->GetDefaultPass().get();
+		}
+		else if (material_instance)
+		{
+			return material_instance->GetTech()->GetDefaultPass().get();
+		}
+		return NULL;
+	}
+
 	void GraphicRenderer::SetMaterialParams(const MaterialParamList& mpl,const GPtr<MaterialPass>& pass)
 	{
-#if 1
 		ResetCache();
-		GlobalMaterialParam* gsp = Material::GetGlobalMaterialParams();
 
-		const GPtr<ShaderParamBindingMap>& bindings = pass->GetParamBindings();
+		ShaderParamBindingMap* bindings = pass->GetParamBindings().get();
+		_BeginGlobalUpload(bindings);
 
 		// vs 
 		{
-
-			const MatParamBindings& globalbinds = bindings->GetGlobalBinding(SCT_VS);
-
-			for ( IndexT globalIndex = 0; globalIndex < globalbinds.Size(); ++globalIndex )
-			{
-				MatParamBinding& global = globalbinds[globalIndex];
-
-				if( global.bindIndex < eGShaderMatEnd )
-				{
-					const Math::matrix44& m = gsp->GetMatrixParam( static_cast<GlobalMatrixParamIndex>(global.bindIndex) );
-					GraphicSystem::Instance()->SetVertexShaderConstantMatrixF(global.Regiter, &m,1);
-				}
-				else if ( global.bindIndex < eGShaderVecEnd )
-				{
-					const Math::float4& vecVal = gsp->GetVectorParam( static_cast<GlobalVectorParamIndex>(global.bindIndex) );
-					GraphicSystem::Instance()->SetVertexShaderConstantVectorF(global.Regiter, &vecVal,1);
-				}
-				else if ( global.bindIndex < eGShaderTexEnd )
-				{
-					const RenderBase::TextureHandle& texHandle = gsp->GetTextureParam( static_cast<GlobalTexParamIndex>(global.bindIndex) );
-					if ( texHandle.IsValid() )
-					{
-						GraphicSystem::Instance()->SetTexture(global.Regiter,texHandle);
-					}
-				}
-			}
+			_SetGlobalBindings(bindings, SCT_VS, 0, bindings->GetGlobalBinding(SCT_VS).Size());
 
 			const MatParamBindings& localbinds = bindings->GetLocalBinding(SCT_VS);
 			for ( IndexT localIndex = 0; localIndex < localbinds.Size(); ++localIndex )
@@ -228,32 +139,7 @@ namespace Graphic
 
 		// ps
 		{
-
-			const MatParamBindings& globalbinds = bindings->GetGlobalBinding(SCT_PS);
-
-			for ( IndexT globalIndex = 0; globalIndex < globalbinds.Size(); ++globalIndex )
-			{
-				MatParamBinding& global = globalbinds[globalIndex];
-
-				if( global.bindIndex < eGShaderMatEnd )
-				{
-					const Math::matrix44& m = gsp->GetMatrixParam( static_cast<GlobalMatrixParamIndex>(global.bindIndex) );
-					GraphicSystem::Instance()->SetPixelShaderConstantMatrixF(global.Regiter, &m,1);
-				}
-				else if ( global.bindIndex < eGShaderVecEnd )
-				{
-					const Math::float4& vecVal = gsp->GetVectorParam( static_cast<GlobalVectorParamIndex>(global.bindIndex) );
-					GraphicSystem::Instance()->SetPixelShaderConstantVectorF(global.Regiter, &vecVal,1);
-				}
-				else if ( global.bindIndex < eGShaderTexEnd )
-				{
-					const RenderBase::TextureHandle& texHandle = gsp->GetTextureParam( static_cast<GlobalTexParamIndex>(global.bindIndex) );
-					if ( texHandle.IsValid() )
-					{
-						GraphicSystem::Instance()->SetTexture(global.Regiter,texHandle);
-					}
-				}
-			}
+			_SetGlobalBindings(bindings, SCT_PS, 0, bindings->GetGlobalBinding(SCT_PS).Size());
 
 			const MatParamBindings& localbinds = bindings->GetLocalBinding(SCT_PS);
 			for ( IndexT localIndex = 0; localIndex < localbinds.Size(); ++localIndex )
@@ -263,73 +149,29 @@ namespace Graphic
 			}
 		}
 
-
-
-
-#else	//	bind by string . old and slow
-		const GPtr<ShaderParamBindingMap>& bindings = pass->GetParamBindings();
-
-		if(mpl.IsEmpty())
-		{
-			MaterialParam dummymp;
-			FindBindingRegister(&dummymp,bindings->GetShaderParamBindingList() );
-		}
-		else
-		{
-			for (SizeT i = 0; i < mpl.Size(); ++i)
-			{
-				FindBindingRegister(mpl[i],bindings->GetShaderParamBindingList() );
-			}
-		}
-#endif 
+		_EndGlobalUpload(bindings);
 	}
 
 	void GraphicRenderer::SetMaterialCommonParams(const GPtr<MaterialPass>& pass)
 	{
-		GlobalMaterialParam* gsp = Material::GetGlobalMaterialParams();
-
-		const GPtr<ShaderParamBindingMap>& bindings = pass->GetParamBindings();
+		ShaderParamBindingMap* bindings = pass->GetParamBindings().get();
+		_BeginGlobalUpload(bindings);
 
 		// vs 
 		{
-			const MatParamBindings& globalbinds = bindings->GetGlobalBinding(SCT_VS);
 			const GlobalBindingInfo& globalInfo = bindings->GetGlobalBindingInfo(SCT_VS);
-
-			for (IndexT index = 0; index < globalInfo.MatCommonEnd; ++index)
-			{
-				MatParamBinding& global = globalbinds[index];
-				const Math::matrix44& m = gsp->GetMatrixParam( static_cast<GlobalMatrixParamIndex>(global.bindIndex) );
-				GraphicSystem::Instance()->SetVertexShaderConstantMatrixF(global.Regiter, &m,1);
-			}
-			for (IndexT index = globalInfo.VecCommonBegin; index < globalInfo.VecCommonEnd; ++index)
-			{
-				MatParamBinding& global = globalbinds[index];
-				const Math::float4& vecVal = gsp->GetVectorParam( static_cast<GlobalVectorParamIndex>(global.bindIndex) );
-				GraphicSystem::Instance()->SetVertexShaderConstantVectorF(global.Regiter, &vecVal,1);
-			}
-
-
+			_SetGlobalBindings(bindings, SCT_VS, 0, globalInfo.MatCommonEnd);
+			_SetGlobalBindings(bindings, SCT_VS, globalInfo.VecCommonBegin, globalInfo.VecCommonEnd);
 		}
 
 		// ps
 		{
-			const MatParamBindings& globalbinds = bindings->GetGlobalBinding(SCT_PS);
 			const GlobalBindingInfo& globalInfo = bindings->GetGlobalBindingInfo(SCT_PS);
-
-			for (IndexT index = 0; index < globalInfo.MatCommonEnd; ++index)
-			{
-				MatParamBinding& global = globalbinds[index];
-				const Math::matrix44& m = gsp->GetMatrixParam( static_cast<GlobalMatrixParamIndex>(global.bindIndex) );
-				GraphicSystem::Instance()->SetPixelShaderConstantMatrixF(global.Regiter,&m,1);
-			}
-			for (IndexT index = globalInfo.VecCommonBegin; index < globalInfo.VecCommonEnd; ++index)
-			{
-				MatParamBinding& global = globalbinds[index];
-				const Math::float4& vecVal = gsp->GetVectorParam( static_cast<GlobalVectorParamIndex>(global.bindIndex) );
-				GraphicSystem::Instance()->SetPixelShaderConstantVectorF(global.Regiter, &vecVal,1);
-			}
-
+			_SetGlobalBindings(bindings, SCT_PS, 0, globalInfo.MatCommonEnd);
+			_SetGlobalBindings(bindings, SCT_PS, globalInfo.VecCommonBegin, globalInfo.VecCommonEnd);
 		}
+
+		_EndGlobalUpload(bindings);
 	}
 
 	void GraphicRenderer::SetMaterialCustomParams(const Material* material, Graphic::RenderPassType surType)
@@ -341,38 +183,12 @@ namespace Graphic
 	}
 	void GraphicRenderer::SetMaterialCustomParams(const MaterialParamList& mpl,const GPtr<MaterialPass>& pass)
 	{
-		GlobalMaterialParam* gsp = Material::GetGlobalMaterialParams();
-
-		const GPtr<ShaderParamBindingMap>& bindings = pass->GetParamBindings();
+		ShaderParamBindingMap* bindings = pass->GetParamBindings().get();
+		_BeginGlobalUpload(bindings);
 
 		// vs 
 		{
-
-			const MatParamBindings& globalbinds = bindings->GetGlobalBinding(SCT_VS);
-			const GlobalBindingInfo& globalInfo = bindings->GetGlobalBindingInfo(SCT_VS);
-
-			for (IndexT index = globalInfo.MatCustomBegin; index < globalInfo.MatCustomEnd; ++index)
-			{
-				MatParamBinding& global = globalbinds[index];
-				const Math::matrix44& m = gsp->GetMatrixParam( static_cast<GlobalMatrixParamIndex>(global.bindIndex) );
-				GraphicSystem::Instance()->SetVertexShaderConstantMatrixF(global.Regiter, &m,1);
-			}
-			for (IndexT index = globalInfo.VecCustomBegin; index < globalInfo.VecCustomEnd; ++index)
-			{
-				MatParamBinding& global = globalbinds[index];
-				const Math::float4& vecVal = gsp->GetVectorParam( static_cast<GlobalVectorParamIndex>(global.bindIndex) );
-				GraphicSystem::Instance()->SetVertexShaderConstantVectorF(global.Regiter, &vecVal,1);
-			}
-			for (IndexT index = globalInfo.TexBegin; index < globalbinds.Size(); ++index)
-			{
-				MatParamBinding& global = globalbinds[index];
-				const RenderBase::TextureHandle& texHandle = gsp->GetTextureParam( static_cast<GlobalTexParamIndex>(global.bindIndex) );
-				if ( texHandle.IsValid() )
-				{
-					GraphicSystem::Instance()->SetTexture(global.Regiter,texHandle);
-				}
-			}
-
+			_SetGlobalCustomBindings(bindings, SCT_VS);
 
 			const MatParamBindings& localbinds = bindings->GetLocalBinding(SCT_VS);
 			for ( IndexT localIndex = 0; localIndex < localbinds.Size(); ++localIndex )
@@ -384,31 +200,7 @@ namespace Graphic
 
 		// ps
 		{
-
-			const MatParamBindings& globalbinds = bindings->GetGlobalBinding(SCT_PS);
-			const GlobalBindingInfo& globalInfo = bindings->GetGlobalBindingInfo(SCT_PS);
-
-			for (IndexT index = globalInfo.MatCustomBegin; index < globalInfo.MatCustomEnd; ++index)
-			{
-				MatParamBinding& global = globalbinds[index];
-				const Math::matrix44& m = gsp->GetMatrixParam( static_cast<GlobalMatrixParamIndex>(global.bindIndex) );
-				GraphicSystem::Instance()->SetPixelShaderConstantMatrixF(global.Regiter, &m,1);
-			}
-			for (IndexT index = globalInfo.VecCustomBegin; index < globalInfo.VecCustomEnd; ++index)
-			{
-				MatParamBinding& global = globalbinds[index];
-				const Math::float4& vecVal = gsp->GetVectorParam( static_cast<GlobalVectorParamIndex>(global.bindIndex) );
-				GraphicSystem::Instance()->SetPixelShaderConstantVectorF(global.Regiter, &vecVal,1);
-			}
-			for (IndexT index = globalInfo.TexBegin; index < globalbinds.Size(); ++index)
-			{
-				MatParamBinding& global = globalbinds[index];
-				const RenderBase::TextureHandle& texHandle = gsp->GetTextureParam( static_cast<GlobalTexParamIndex>(global.bindIndex) );
-				if ( texHandle.IsValid() )
-				{
-					GraphicSystem::Instance()->SetTexture(global.Regiter,texHandle);
-				}
-			}
+			_SetGlobalCustomBindings(bindings, SCT_PS);
 
 			const MatParamBindings& localbinds = bindings->GetLocalBinding(SCT_PS);
 			for ( IndexT localIndex = 0; localIndex < localbinds.Size(); ++localIndex )
@@ -417,74 +209,103 @@ namespace Graphic
 				SetPSBindingShadersOrTextures( localbind.Regiter, mpl[localbind.bindIndex] );
 			}
 		}
+
+		_EndGlobalUpload(bindings);
 	}
 
 	void GraphicRenderer::_SetMaterialCustomParamsOfGlobalBuffer(const Material* material, Graphic::RenderPassType surType)
 	{
-
-		GlobalMaterialParam* gsp = Material::GetGlobalMaterialParams();
 		const Util::Array< GPtr<MaterialPass> >& passList = material->GetTech()->GetPassList();
 		const GPtr<MaterialPass>& pass = passList[surType-1];
 
-		const GPtr<ShaderParamBindingMap>& bindings = pass->GetParamBindings();
+		ShaderParamBindingMap* bindings = pass->GetParamBindings().get();
+		_BeginGlobalUpload(bindings);
 
-		// vs
+		_SetGlobalCustomBindings(bindings, SCT_VS);
+		_SetGlobalCustomBindings(bindings, SCT_PS);
+
+		_EndGlobalUpload(bindings);
+	}
+
+	void GraphicRenderer::_SetGlobalCustomBindings(ShaderParamBindingMap* bindings, ShaderCodeType sct)
+	{
+		const GlobalBindingInfo& globalInfo = bindings->GetGlobalBindingInfo(sct);
+		_SetGlobalBindings(bindings, sct, globalInfo.MatCustomBegin, globalInfo.MatCustomEnd);
+		_SetGlobalBindings(bindings, sct, globalInfo.VecCustomBegin, globalInfo.VecCustomEnd);
+		_SetGlobalBindings(bindings, sct, globalInfo.TexBegin, bindings->GetGlobalBinding(sct).Size());
+	}
+
+	void GraphicRenderer::_SetGlobalBindings(ShaderParamBindingMap* bindings, ShaderCodeType sct, IndexT begin, IndexT end)
+	{
+		GlobalMaterialParam* gsp = Material::GetGlobalMaterialParams();
+		GraphicSystem* gs = GraphicSystem::Instance();
+
+		const MatParamBindings& globalbinds = bindings->GetGlobalBinding(sct);
+		Util::FixedArray<uint>& uploaded = bindings->_GetUploadedVersions(sct);
+
+		for ( IndexT index = begin; index < end; ++index )
 		{
-			const MatParamBindings& globalbinds = bindings->GetGlobalBinding(SCT_VS);
-			const GlobalBindingInfo& globalInfo = bindings->GetGlobalBindingInfo(SCT_VS);
+			const MatParamBinding& global = globalbinds[index];
 
-			for (IndexT index = globalInfo.MatCustomBegin; index < globalInfo.MatCustomEnd; ++index)
-			{
-				MatParamBinding& global = globalbinds[index];
-				const Math::matrix44& m = gsp->GetMatrixParam( static_cast<GlobalMatrixParamIndex>(global.bindIndex) );
-				GraphicSystem::Instance()->SetVertexShaderConstantMatrixF(global.Regiter, &m,1);
-			}
-			for (IndexT index = globalInfo.VecCustomBegin; index < globalInfo.VecCustomEnd; ++index)
+			// the register still holds this slot's value, unless someone else wrote it since (see _BeginGlobalUpload)
+			const uint version = gsp->GetParamVersion(global.bindIndex);
+			if ( uploaded[index] == version )
 			{
-				MatParamBinding& global = globalbinds[index];
-				const Math::float4& vecVal = gsp->GetVectorParam( static_cast<GlobalVectorParamIndex>(global.bindIndex) );
-				GraphicSystem::Instance()->SetVertexShaderConstantVectorF(global.Regiter, &vecVal,1);
+				continue;
 			}
-			for (IndexT index = globalInfo.TexBegin; index < globalbinds.Size(); ++index)
-			{
-				MatParamBinding& global = globalbinds[index];
-				const RenderBase::TextureHandle& texHandle = gsp->GetTextureParam( static_cast<GlobalTexParamIndex>(global.bindIndex) );
-				if ( texHandle.IsValid() )
-				{
-					GraphicSystem::Instance()->SetTexture(global.Regiter,texHandle);
-				}
-			}
-		}
-		// ps
-		{
-
-			const MatParamBindings& globalbinds = bindings->GetGlobalBinding(SCT_PS);
-			const GlobalBindingInfo& globalInfo = bindings->GetGlobalBindingInfo(SCT_PS);
+			uploaded[index] = version;
 
-			for (IndexT index = globalInfo.MatCustomBegin; index < globalInfo.MatCustomEnd; ++index)
+			if( global.bindIndex < eGShaderMatEnd )
 			{
-				MatParamBinding& global = globalbinds[index];
 				const Math::matrix44& m = gsp->GetMatrixParam( static_cast<GlobalMatrixParamIndex>(global.bindIndex) );
-				GraphicSystem::Instance()->SetPixelShaderConstantMatrixF(global.Regiter, &m,1);
+				if ( SCT_VS == sct )
+				{
+					gs->SetVertexShaderConstantMatrixF(global.Regiter, &m,1);
+				}
+				else
+				{
+					gs->SetPixelShaderConstantMatrixF(global.Regiter, &m,1);
+				}
 			}
-			for (IndexT index = globalInfo.VecCustomBegin; index < globalInfo.VecCustomEnd; ++index)
+			else if ( global.bindIndex < eGShaderVecEnd )
 			{
-				MatParamBinding& global = globalbinds[index];
 				const Math::float4& vecVal = gsp->GetVectorParam( static_cast<GlobalVectorParamIndex>(global.bindIndex) );
-				GraphicSystem::Instance()->SetPixelShaderConstantVectorF(global.Regiter, &vecVal,1);
+				if ( SCT_VS == sct )
+				{
+					gs->SetVertexShaderConstantVectorF(global.Regiter, &vecVal,1);
+				}
+				else
+				{
+					gs->SetPixelShaderConstantVectorF(global.Regiter, &vecVal,1);
+				}
 			}
-			for (IndexT index = globalInfo.TexBegin; index < globalbinds.Size(); ++index)
+			else if ( global.bindIndex < eGShaderTexEnd )
 			{
-				MatParamBinding& global = globalbinds[index];
 				const RenderBase::TextureHandle& texHandle = gsp->GetTextureParam( static_cast<GlobalTexParamIndex>(global.bindIndex) );
 				if ( texHandle.IsValid() )
 				{
-					GraphicSystem::Instance()->SetTexture(global.Regiter,texHandle);
+					gs->SetTexture(global.Regiter,texHandle);
 				}
 			}
 		}
 	}
 
+	void GraphicRenderer::_BeginGlobalUpload(ShaderParamBindingMap* bindings)
+	{
+		// another program, or any constant/texture/program write since our last upload, may have clobbered the registers
+		if ( s_pGlobalOwner != bindings || s_globalOwnerSerial != GraphicSystem::Instance()->GetBindingSerial() )
+		{
+			bindings->_ResetUploadedVersions();
+		}
+	}
+
+	void GraphicRenderer::_EndGlobalUpload(ShaderParamBindingMap* bindings)
+	{
+		s_pGlobalOwner = bindings;
+		s_globalOwnerSerial = GraphicSystem::Instance()->GetBindingSerial();
+	}
+
+
 
 	void GraphicRenderer::RenderForward(Graphic::RenderPassType surType, const Renderable* renderalbe, const RenderBase::PrimitiveHandle& primHandle,
 		IndexT firstVertex, SizeT numVertex, IndexT firstIndex, SizeT numIndex, const Material* customed)
@@ -497,6 +318,17 @@ namespace Graphic
 		_SetMaterialCustomParams(renderalbe, customed, surType);
 		GraphicSystem::Instance()->DrawPrimitive(primHandle);
 	}
+	void GraphicRenderer::RenderInstanced(Graphic::RenderPassType surType, const Renderable* renderalbe, const Material* customed)
+	{
+		_SetMaterialCustomParams(renderalbe, customed, surType);
+		GraphicSystem::Instance()->GetInstanceBatcher()->Flush();
+	}
+
+	void GraphicRenderer::RenderSprites(Graphic::RenderPassType surType, const Renderable* renderalbe, const Material* customed)
+	{
+		_SetMaterialCustomParams(renderalbe, customed, surType);
+		GraphicSystem::Instance()->GetSpriteBatcher()->Flush();
+	}
 
 	void GraphicRenderer::_SetMaterialCustomParams(const Renderable* renderalbe, const Material* customed, Graphic::RenderPassType surType)
 	{
@@ -517,42 +349,6 @@ namespace Graphic
 	}
 
 
-	void GraphicRenderer::FindBindingRegister(MaterialParam* mpl, const ShaderParamBindingList& binding)
-	{
-		// vs
-		{
-			const ShaderParamList& spl = binding[SCT_VS];
-			for (SizeT i = 0; i < spl.Size(); ++i)
-			{
-				if( spl[i].GetName() == mpl->GetName() )
-				{
-					SetVSBindingShadersOrTextures(spl[i].GetRegister(),mpl);
-				}
-				else
-				{
-					SetGlobalVertexShaderConstant(spl[i]);
-				}
-			}
-		}
-
-		// ps
-		{
-			const ShaderParamList& spl = binding[SCT_PS];
-			for (SizeT i = 0; i < spl.Size(); ++i)
-			{
-				if( spl[i].GetName() == mpl->GetName() )
-				{
-					SetPSBindingShadersOrTextures(spl[i].GetRegister(),mpl);
-				}
-				else
-				{
-					SetGlobalPixelShaderConstant(spl[i]);
-				}
-			}
-		}
-
-	}
-
 	void GraphicRenderer::SetVSBindingShadersOrTextures(int reg,MaterialParam* mpl)
 	{
 		switch (mpl->GetType())
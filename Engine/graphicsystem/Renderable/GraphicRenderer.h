@@ -39,9 +39,6 @@ namespace Graphic
 
 		virtual void Setup();		
 
-		static void SetGlobalVertexShaderConstant(const ShaderParam& sp);
-		static void SetGlobalPixelShaderConstant(const ShaderParam& sp);
-		static void FindBindingRegister(MaterialParam* mpl, const ShaderParamBindingList& binding);
 		static void SetVSBindingShadersOrTextures(int reg,MaterialParam* mpl);
 		static void SetPSBindingShadersOrTextures(int reg,MaterialParam* mpl);
 
@@ -59,13 +56,28 @@ namespace Graphic
 			IndexT firstVertex, SizeT numVertex, IndexT firstIndex, SizeT numIndex, const Material* customed);
 		static void RenderForward(Graphic::RenderPassType surType, const Renderable* renderalbe, const RenderBase::PrimitiveHandle& primHandle, const Material* customed);
 
+		/// draw the run collected by the instance batcher with the material of renderalbe
+		static void RenderInstanced(Graphic::RenderPassType surType, const Renderable* renderalbe, const Material* customed);
+		/// draw the run collected by the sprite batcher with the material of renderalbe
+		static void RenderSprites(Graphic::RenderPassType surType, const Renderable* renderalbe, const Material* customed);
+
 		static void BeforeRender(const Renderable* renderable, RenderPassType passType, const Material* customizedMat);
+		/// the pass BeforeRender selects
+		static const MaterialPass* GetRenderPass(const Renderable* renderable, RenderPassType passType, const Material* customizedMat);
 	protected:
 		static void _SetMaterialCustomParams(const Renderable* renderalbe, const Material* customed, Graphic::RenderPassType surType);
 		static void _SetMaterialCustomParamsOfGlobalBuffer(const Material* material, Graphic::RenderPassType surType);
 
+		/// upload global bindings [begin, end) of one stage, skipping slots whose version is already in the register
+		static void _SetGlobalBindings(ShaderParamBindingMap* bindings, ShaderCodeType sct, IndexT begin, IndexT end);
+		static void _SetGlobalCustomBindings(ShaderParamBindingMap* bindings, ShaderCodeType sct);
+		static void _BeginGlobalUpload(ShaderParamBindingMap* bindings);
+		static void _EndGlobalUpload(ShaderParamBindingMap* bindings);
+
 		static uint s_preShaderInstanceID;
 		static void* s_pPreMaterialInstance;
+		static ShaderParamBindingMap* s_pGlobalOwner;		// binding map that did the last global upload
+		static uint s_globalOwnerSerial;					// GraphicSystem binding serial right after that upload
 	};
 
 	inline void GraphicRenderer::ResetCache()
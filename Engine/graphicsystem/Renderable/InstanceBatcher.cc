@@ -0,0 +1,137 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "stdneb.h"
+#include "InstanceBatcher.h"
+#include "GraphicSystem.h"
+
+namespace Graphic
+{
+	__ImplementClass(InstanceBatcher,'INBA',Core::RefCounted)
+
+	InstanceBatcher::Stats::Stats()
+	{
+		Reset();
+	}
+
+	void InstanceBatcher::Stats::Reset()
+	{
+		batches = 0;
+		instances = 0;
+	}
+	//------------------------------------------------------------------------
+	InstanceBatcher::InstanceBatcher()
+		: m_count(0)
+		, m_enabled(true)
+	{
+		n_assert(sizeof(InstanceData) == RenderBase::InstanceVectorCount * sizeof(Math::float4));
+	}
+
+	InstanceBatcher::~InstanceBatcher()
+	{
+		Discard();
+	}
+	//------------------------------------------------------------------------
+	void InstanceBatcher::Setup()
+	{
+		n_assert(!m_instanceStream.IsValid());
+		GraphicSystem* gs = GraphicSystem::Instance();
+		if (!gs->GetGraphicCardCapability().mHardwareInstancing)
+		{
+			return;
+		}
+
+		RenderBase::VertexBufferData vbd;
+		vbd.usage = RenderBase::BufferData::Dynamic;
+		vbd.topology = RenderBase::PrimitiveTopology::TriangleList;
+		vbd.vertexCount = MaxInstances;
+		for (IndexT i = 0; i < RenderBase::InstanceVectorCount; ++i)
+		{
+			vbd.vertex.vertexComponents.Append(RenderBase::VertexComponent(RenderBase::VertexComponent::TexCoord,
+				RenderBase::InstanceTexCoordBase + i, RenderBase::VertexComponent::Float4, RenderBase::InstanceStreamIndex));
+		}
+		m_instanceStream = gs->CreatePrimitiveHandle(&vbd);
+		m_instances.SetSize(MaxInstances);
+		m_count = 0;
+		m_totalStats.Reset();
+		m_frameStats.Reset();
+	}
+	//------------------------------------------------------------------------
+	void InstanceBatcher::Discard()
+	{
+		if (m_instanceStream.IsValid())
+		{
+			GraphicSystem::Instance()->RemovePrimitive(m_instanceStream);
+			m_instanceStream = RenderBase::PrimitiveHandle();
+		}
+		m_instances.SetSize(0);
+		m_count = 0;
+	}
+	//------------------------------------------------------------------------
+	void InstanceBatcher::Begin(const InstanceInfo& info)
+	{
+		n_assert(IsActive());
+		m_run = info;
+		m_instances[0] = info.data;
+		m_count = 1;
+	}
+	//------------------------------------------------------------------------
+	bool InstanceBatcher::Accept(const InstanceInfo& info) const
+	{
+		return m_count < MaxInstances
+			&& info.surType == m_run.surType
+			&& info.primHandle == m_run.primHandle
+			&& info.firstVertex == m_run.firstVertex
+			&& info.numVertex == m_run.numVertex
+			&& info.firstIndex == m_run.firstIndex
+			&& info.numIndex == m_run.numIndex;
+	}
+	//------------------------------------------------------------------------
+	void InstanceBatcher::Push(const InstanceData& data)
+	{
+		n_assert(m_count < MaxInstances);
+		m_instances[m_count] = data;
+		++m_count;
+	}
+	//------------------------------------------------------------------------
+	void InstanceBatcher::Flush()
+	{
+		if (0 == m_count)
+		{
+			return;
+		}
+		GraphicSystem::Instance()->DrawPrimitiveInstanced(m_run.primHandle, m_run.firstVertex, m_run.numVertex, m_run.firstIndex, m_run.numIndex,
+			m_instanceStream, &m_instances[0], m_count * sizeof(InstanceData), m_count);
+
+		m_frameStats.batches++;
+		m_frameStats.instances += m_count;
+		m_totalStats.batches++;
+		m_totalStats.instances += m_count;
+		m_count = 0;
+	}
+	//------------------------------------------------------------------------
+	void InstanceBatcher::ResetFrameStats()
+	{
+		m_frameStats.Reset();
+	}
+}
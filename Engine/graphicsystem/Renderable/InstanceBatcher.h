@@ -0,0 +1,165 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef INSTANCEBATCHER_H_
+#define INSTANCEBATCHER_H_
+#include "core/refcounted.h"
+#include "math/matrix44.h"
+#include "math/float4.h"
+#include "util/fixedarray.h"
+#include "rendersystem/base/RenderDeviceTypes.h"
+#include "graphicsystem/base/RenderBase.h"
+
+namespace Graphic
+{
+	/// one record of the instance stream, read by instancing shaders from TEXCOORD11..15
+	struct InstanceData
+	{
+		Math::matrix44 world;	// rows laid out like a eGShaderMatM upload
+		Math::float4 param;		// x: receive shadow, yzw: free for the object
+	};
+
+	/// the draw a render object would issue for one renderable, see RenderObject::GetInstanceInfo
+	struct InstanceInfo
+	{
+		RenderPassType surType;		// pass the material params are set for
+		RenderBase::PrimitiveHandle primHandle;
+		IndexT firstVertex;
+		SizeT numVertex;
+		IndexT firstIndex;
+		SizeT numIndex;
+		InstanceData data;
+	};
+
+	/**
+		Collects runs of render datas that draw the same primitive range with the same
+		material into the per frame instance stream, and issues them as one instanced draw.
+
+		Only passes whose program reads the instance stream (GPUProgram::IsInstancing) are
+		batched, everything else keeps the single draw path. None of the shaders shipped
+		today declares TEXCOORD11..15, so on the real devices every run falls back to single
+		draws until instanced shader variants are authored; only the null device, which
+		treats every program as instanced, exercises the batching. GLES and GL report no
+		hardware instancing and never get here.
+	*/
+	class InstanceBatcher : public Core::RefCounted
+	{
+		__DeclareClass(InstanceBatcher);
+	public:
+		/// instances per draw, longer runs are split
+		static const SizeT MaxInstances = 256;
+
+		struct Stats
+		{
+			Stats();
+			void Reset();
+			SizeT batches;		// instanced draws issued
+			SizeT instances;	// render datas drawn by them
+		};
+
+		InstanceBatcher();
+		virtual ~InstanceBatcher();
+
+		/// create the instance stream, if the device supports instancing
+		void Setup();
+		/// release the instance stream
+		void Discard();
+
+		void SetEnabled(bool enable);
+		bool IsEnabled() const;
+		/// enabled and supported by the device
+		bool IsActive() const;
+
+		/// start a new run with info
+		void Begin(const InstanceInfo& info);
+		/// can info join the current run
+		bool Accept(const InstanceInfo& info) const;
+		/// add an instance of the current run
+		void Push(const InstanceData& data);
+		/// drop the current run
+		void Cancel();
+		/// number of instances in the current run
+		SizeT GetCount() const;
+		/// the draw shared by the current run
+		const InstanceInfo& GetRun() const;
+		/// draw the current run, the program and material params must be set already
+		void Flush();
+
+		/// counters of the current frame, reset by ResetFrameStats
+		const Stats& GetFrameStats() const;
+		/// counters since Setup
+		const Stats& GetTotalStats() const;
+		void ResetFrameStats();
+
+	private:
+		RenderBase::PrimitiveHandle m_instanceStream;
+		Util::FixedArray<InstanceData> m_instances;
+		InstanceInfo m_run;
+		SizeT m_count;
+		bool m_enabled;
+		Stats m_frameStats;
+		Stats m_totalStats;
+	};
+
+	inline void InstanceBatcher::SetEnabled(bool enable)
+	{
+		m_enabled = enable;
+	}
+
+	inline bool InstanceBatcher::IsEnabled() const
+	{
+		return m_enabled;
+	}
+
+	inline bool InstanceBatcher::IsActive() const
+	{
+		return m_enabled && m_instanceStream.IsValid();
+	}
+
+	inline void InstanceBatcher::Cancel()
+	{
+		m_count = 0;
+	}
+
+	inline SizeT InstanceBatcher::GetCount() const
+	{
+		return m_count;
+	}
+
+	inline const InstanceInfo& InstanceBatcher::GetRun() const
+	{
+		return m_run;
+	}
+
+	inline const InstanceBatcher::Stats& InstanceBatcher::GetFrameStats() const
+	{
+		return m_frameStats;
+	}
+
+	inline const InstanceBatcher::Stats& InstanceBatcher::GetTotalStats() const
+	{
+		return m_totalStats;
+	}
+}
+
+#endif //INSTANCEBATCHER_H_
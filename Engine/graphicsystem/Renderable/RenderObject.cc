@@ -37,6 +37,7 @@ namespace Graphic
 		, m_Projected(true)
 		, mbReceiveShadow(true)
 		, mbCastShadow(true)
+		, m_ShadowVersion(0)
 	{	
 		m_transform = matrix44::identity();
 	}
@@ -48,6 +49,7 @@ namespace Graphic
 	void RenderObject::SetBoundingBox(const bbox& box)
 	{
 		Super::SetBoundingBox(box);
+		++m_ShadowVersion;
 		if ( m_VisEnt.isvalid() && m_Root )	//	update BoundingBox and visEntity in visSystem
 		{
 			Math::bbox worldBB = m_boundingBox;
@@ -61,6 +63,7 @@ namespace Graphic
 	void RenderObject::SetTransform(const matrix44& trans)
 	{
 		Super::SetTransform(trans);
+		++m_ShadowVersion;
 		if ( m_VisEnt.isvalid() && m_Root )	//	update BoundingBox and visEntity in visSystem
 		{
 			Math::bbox worldBB = m_boundingBox;
@@ -129,6 +132,18 @@ namespace Graphic
 	{
 		n_error("empty");
 	}
+	bool RenderObject::GetInstanceInfo(const Renderable* renderable, RenderPassType passType, const Material* customizedMaterial, InstanceInfo& info)
+	{
+		return false;
+	}
+	bool RenderObject::GetSpriteQuadInfo(const Renderable* renderable, RenderPassType passType, const Material* customizedMaterial, SpriteQuadInfo& info)
+	{
+		return false;
+	}
+	void RenderObject::RenderSpriteBatch(const Renderable* renderable, RenderPassType passType, const Material* customizedMaterial)
+	{
+		n_error("empty");
+	}
 	void RenderObject::AddToCollection(RenderDataCollection* collection)
 	{
 		n_error("empty");
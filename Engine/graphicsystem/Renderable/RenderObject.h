@@ -33,6 +33,8 @@ namespace Graphic
 	class RenderDataCollection;
 	class Renderable;
 	class IRenderScene;
+	struct InstanceInfo;
+	struct SpriteQuadInfo;
 
 	typedef uint LayerID;
 
@@ -42,12 +44,23 @@ namespace Graphic
 	public:	
 		virtual ~RenderObject();
 		virtual void Render(const Renderable* renderable, RenderPassType passType, const Material* customizedMaterial);
+		/// describe the draw Render would issue, so equal draws can be instanced. false keeps the object on the Render path.
+		virtual bool GetInstanceInfo(const Renderable* renderable, RenderPassType passType, const Material* customizedMaterial, InstanceInfo& info);
+		/// describe the sprite quad Render would draw, so sprites of one image can share a draw. false keeps the object on the Render path.
+		virtual bool GetSpriteQuadInfo(const Renderable* renderable, RenderPassType passType, const Material* customizedMaterial, SpriteQuadInfo& info);
+		/// bind what the sprites of a batch share (texture, identity model matrix) and draw the batch, called on the first object of a run
+		virtual void RenderSpriteBatch(const Renderable* renderable, RenderPassType passType, const Material* customizedMaterial);
 		virtual void AddToCollection(RenderDataCollection* collection);
 		virtual void OnWillRenderObject(Camera* sender);
 
 		virtual void SetTransform(const Math::matrix44& trans);
 		virtual void SetBoundingBox(const Math::bbox& box);
 
+		/// true if the geometry changes without the transform changing (skinning, particles), such casters are never served from a cached shadow map
+		virtual bool IsDeforming() const;
+		/// bumped whenever something that affects the shadow this object casts changes
+		uint GetShadowVersion() const;
+
 		virtual bool IsUseLM() const;
 		virtual bool IsLMHandleValid() const;
 
@@ -88,6 +101,7 @@ namespace Graphic
 		bool m_Projected;
 		bool mbReceiveShadow;
 		bool mbCastShadow;
+		uint m_ShadowVersion;
 	};
 
 	inline void RenderObject::SetLayerID(LayerID rl)
@@ -114,6 +128,10 @@ namespace Graphic
 
 	inline void RenderObject::SetCastShadow( bool bCastShadow )
 	{
+		if (mbCastShadow != bCastShadow)
+		{
+			++m_ShadowVersion;
+		}
 		mbCastShadow = bCastShadow;
 	}
 	//------------------------------------------------------------------------
@@ -161,6 +179,16 @@ namespace Graphic
 		return false;
 	}
 
+	inline bool RenderObject::IsDeforming() const
+	{
+		return false;
+	}
+
+	inline uint RenderObject::GetShadowVersion() const
+	{
+		return m_ShadowVersion;
+	}
+
 
 	//------------------------------------------------------------------------
 	inline const GPtr<Vis::VisEntity>& RenderObject::_GetVisEnt(void) const
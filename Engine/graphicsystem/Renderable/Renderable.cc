@@ -29,6 +29,7 @@ namespace Graphic
 	Renderable::Renderable()
 		: mMaterial(NULL)
 		, mMark(MarkAll)
+		, mBatchKey(NULL)
 	{
 	}
 	Renderable::~Renderable()
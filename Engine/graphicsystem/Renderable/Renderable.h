@@ -47,6 +47,10 @@ namespace Graphic
 		Mark GetMark() const;
 		void SetMark(Mark mark);
 
+		/// what else a draw binds besides the material (a sprite image, ...), renderables with equal keys sort next to each other
+		const void* GetBatchKey() const;
+		void SetBatchKey(const void* key);
+
 		template<typename T> 
 		T* cast_safe();  //safe, but slow
 
@@ -63,6 +67,7 @@ namespace Graphic
 		Renderable();
 		MaterialInstance* mMaterial;
 		Mark mMark;
+		const void* mBatchKey;
 	};
 
 	inline MaterialInstance* Renderable::GetMaterial() const
@@ -84,6 +89,16 @@ namespace Graphic
 		mMark = mark;
 	}
 
+	inline const void* Renderable::GetBatchKey() const
+	{
+		return mBatchKey;
+	}
+
+	inline void Renderable::SetBatchKey(const void* key)
+	{
+		mBatchKey = key;
+	}
+
 
 	template<typename T> 
 	inline T* Renderable::cast_safe()
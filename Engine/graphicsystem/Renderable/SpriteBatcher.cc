@@ -0,0 +1,226 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "stdneb.h"
+#include "SpriteBatcher.h"
+#include "GraphicSystem.h"
+#include "jobs/stdjob.h"
+#include "jobs/job.h"
+#include "jobs/jobsystem.h"
+
+namespace Graphic
+{
+	//------------------------------------------------------------------------
+	/// transforms the quads of one slice, input: SpriteQuadInfo, output: 4 SpriteVertex per quad
+	static void _TransformSpriteQuads(const SpriteQuadInfo* quads, SizeT count, SpriteVertex* out)
+	{
+		for (IndexT i = 0; i < count; ++i)
+		{
+			const SpriteQuadInfo& quad = quads[i];
+			const Math::matrix44& world = *quad.world;
+			for (IndexT v = 0; v < 4; ++v)
+			{
+				const SpriteVertex& src = quad.vertices[v];
+				Math::float4 pos = Math::matrix44::transform(world, Math::float4(src.x, src.y, src.z, 1.0f));
+				SpriteVertex& dst = out[v];
+				dst.x = pos.x();
+				dst.y = pos.y();
+				dst.z = pos.z();
+				dst.u = src.u;
+				dst.v = src.v;
+			}
+			out += 4;
+		}
+	}
+
+	void SpriteTransformJobFunc(const JobFuncContext& ctx)
+	{
+		const SpriteQuadInfo* quads = (const SpriteQuadInfo*)ctx.inputs[0];
+		SizeT count = ctx.inputSizes[0] / sizeof(SpriteQuadInfo);
+		n_assert(ctx.outputSizes[0] == count * 4 * sizeof(SpriteVertex));
+		_TransformSpriteQuads(quads, count, (SpriteVertex*)ctx.outputs[0]);
+	}
+}
+__ImplementSpursJob(Graphic::SpriteTransformJobFunc);
+
+namespace Graphic
+{
+	__ImplementClass(SpriteBatcher,'SPBA',Core::RefCounted)
+
+	SpriteBatcher::Stats::Stats()
+	{
+		Reset();
+	}
+
+	void SpriteBatcher::Stats::Reset()
+	{
+		batches = 0;
+		sprites = 0;
+	}
+	//------------------------------------------------------------------------
+	SpriteBatcher::SpriteBatcher()
+		: m_ringCursor(0)
+		, m_count(0)
+		, m_enabled(true)
+	{
+		n_assert(sizeof(SpriteVertex) == 5 * sizeof(float));
+	}
+
+	SpriteBatcher::~SpriteBatcher()
+	{
+		Discard();
+	}
+	//------------------------------------------------------------------------
+	void SpriteBatcher::Setup()
+	{
+		n_assert(!m_ring.IsValid());
+
+		RenderBase::VertexBufferData vbd;
+		vbd.usage = RenderBase::BufferData::Dynamic;
+		vbd.topology = RenderBase::PrimitiveTopology::TriangleList;
+		vbd.vertexCount = MaxQuads * 4;
+		vbd.vertex.vertexComponents.Append(RenderBase::VertexComponent(RenderBase::VertexComponent::Position, 0, RenderBase::VertexComponent::Float3));
+		vbd.vertex.vertexComponents.Append(RenderBase::VertexComponent(RenderBase::VertexComponent::TexCoord, 0, RenderBase::VertexComponent::Float2));
+
+		// quad q uses the vertices 4q..4q+3, so every range of the ring can be drawn with the same indices
+		Util::FixedArray<ushort> indices(MaxQuads * 6);
+		for (IndexT q = 0; q < MaxQuads; ++q)
+		{
+			ushort base = ushort(q * 4);
+			ushort* quad = &indices[q * 6];
+			quad[0] = base;
+			quad[1] = base + 1;
+			quad[2] = base + 2;
+			quad[3] = base + 1;
+			quad[4] = base + 3;
+			quad[5] = base + 2;
+		}
+		RenderBase::IndexBufferData ibd;
+		ibd.usage = RenderBase::BufferData::Static;
+		ibd.indexType = RenderBase::IndexBufferData::Int16;
+		ibd.indexCount = indices.Size();
+		ibd.stream = &indices[0];
+
+		m_ring = GraphicSystem::Instance()->CreatePrimitiveHandle(&vbd, &ibd);
+		m_ringCursor = 0;
+		m_quads.SetSize(MaxQuads);
+		m_vertices.SetSize(MaxQuads * 4);
+		if (Jobs::JobSystem::HasInstance())
+		{
+			m_jobPort = Jobs::JobPort::Create();
+			m_jobPort->Setup();
+		}
+		m_count = 0;
+		m_totalStats.Reset();
+		m_frameStats.Reset();
+	}
+	//------------------------------------------------------------------------
+	void SpriteBatcher::Discard()
+	{
+		if (m_ring.IsValid())
+		{
+			GraphicSystem::Instance()->RemovePrimitive(m_ring);
+			m_ring = RenderBase::PrimitiveHandle();
+		}
+		if (m_jobPort.isvalid())
+		{
+			m_jobPort->Discard();
+			m_jobPort = NULL;
+		}
+		m_quads.SetSize(0);
+		m_vertices.SetSize(0);
+		m_count = 0;
+	}
+	//------------------------------------------------------------------------
+	void SpriteBatcher::Begin(const SpriteQuadInfo& info)
+	{
+		n_assert(IsActive());
+		m_quads[0] = info;
+		m_count = 1;
+	}
+	//------------------------------------------------------------------------
+	bool SpriteBatcher::Accept(const SpriteQuadInfo& info) const
+	{
+		return m_count < MaxQuads
+			&& info.surType == m_quads[0].surType
+			&& info.image == m_quads[0].image;
+	}
+	//------------------------------------------------------------------------
+	void SpriteBatcher::Push(const SpriteQuadInfo& info)
+	{
+		n_assert(m_count < MaxQuads);
+		m_quads[m_count] = info;
+		++m_count;
+	}
+	//------------------------------------------------------------------------
+	void SpriteBatcher::transformQuads()
+	{
+		if (m_count > QuadsPerSlice && m_jobPort.isvalid())
+		{
+			// one slice per QuadsPerSlice quads, spread over the worker threads
+			Jobs::JobFuncDesc jobFunction(SpriteTransformJobFunc);
+			Jobs::JobUniformDesc uniformData(&m_count, sizeof(SizeT), 0);
+			Jobs::JobDataDesc inputData(&m_quads[0], m_count * sizeof(SpriteQuadInfo), QuadsPerSlice * sizeof(SpriteQuadInfo));
+			Jobs::JobDataDesc outputData(&m_vertices[0], m_count * 4 * sizeof(SpriteVertex), QuadsPerSlice * 4 * sizeof(SpriteVertex));
+
+			GPtr<Jobs::Job> job = Jobs::Job::Create();
+			job->Setup(uniformData, inputData, outputData, jobFunction);
+			m_jobPort->PushJob(job);
+			m_jobPort->WaitDone();
+		}
+		else
+		{
+			_TransformSpriteQuads(&m_quads[0], m_count, &m_vertices[0]);
+		}
+	}
+	//------------------------------------------------------------------------
+	void SpriteBatcher::Flush()
+	{
+		if (0 == m_count)
+		{
+			return;
+		}
+		transformQuads();
+
+		// append behind the last run, start over with a discard when the ring is full
+		if (m_ringCursor + m_count > MaxQuads)
+		{
+			m_ringCursor = 0;
+		}
+		GraphicSystem* gs = GraphicSystem::Instance();
+		gs->UpdatePrimitiveVertices(m_ring, &m_vertices[0], m_count * 4 * sizeof(SpriteVertex), m_ringCursor * 4 * sizeof(SpriteVertex));
+		gs->DrawPrimitive(m_ring, m_ringCursor * 4, m_count * 4, m_ringCursor * 6, m_count * 6);
+		m_ringCursor += m_count;
+
+		m_frameStats.batches++;
+		m_frameStats.sprites += m_count;
+		m_totalStats.batches++;
+		m_totalStats.sprites += m_count;
+		m_count = 0;
+	}
+	//------------------------------------------------------------------------
+	void SpriteBatcher::ResetFrameStats()
+	{
+		m_frameStats.Reset();
+	}
+}
@@ -0,0 +1,163 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef SPRITEBATCHER_H_
+#define SPRITEBATCHER_H_
+#include "core/refcounted.h"
+#include "math/matrix44.h"
+#include "util/fixedarray.h"
+#include "jobs/jobport.h"
+#include "rendersystem/base/RenderDeviceTypes.h"
+#include "graphicsystem/base/RenderBase.h"
+
+namespace Graphic
+{
+	/// vertex of a sprite quad, the layout of the per sprite primitives and of the batch ring buffer
+	struct SpriteVertex
+	{
+		float x, y, z;
+		float u, v;
+	};
+
+	/// the quad a render object would draw for one renderable, see RenderObject::GetSpriteQuadInfo
+	struct SpriteQuadInfo
+	{
+		RenderPassType surType;			// pass the material params are set for
+		const void* image;				// texture of the quad, only quads of one image share a draw
+		const SpriteVertex* vertices;	// the 4 corners in object space
+		const Math::matrix44* world;
+	};
+
+	/**
+		Collects runs of sprite render datas that share material and image, transforms their
+		quads to world space and writes them into a per frame vertex ring buffer, so the
+		whole run is drawn with one call. Long runs are transformed by the job system.
+	*/
+	class SpriteBatcher : public Core::RefCounted
+	{
+		__DeclareClass(SpriteBatcher);
+	public:
+		/// quads in the ring buffer, longer runs are split
+		static const SizeT MaxQuads = 4096;
+		/// quads per job slice, runs of more than one slice are transformed by the job system
+		static const SizeT QuadsPerSlice = 128;
+
+		struct Stats
+		{
+			Stats();
+			void Reset();
+			SizeT batches;		// batched draws issued
+			SizeT sprites;		// sprites drawn by them
+		};
+
+		SpriteBatcher();
+		virtual ~SpriteBatcher();
+
+		/// create the ring buffer
+		void Setup();
+		/// release the ring buffer
+		void Discard();
+
+		void SetEnabled(bool enable);
+		bool IsEnabled() const;
+		/// enabled and set up
+		bool IsActive() const;
+
+		/// start a new run with info
+		void Begin(const SpriteQuadInfo& info);
+		/// can info join the current run
+		bool Accept(const SpriteQuadInfo& info) const;
+		/// add a sprite to the current run
+		void Push(const SpriteQuadInfo& info);
+		/// drop the current run
+		void Cancel();
+		/// number of sprites in the current run
+		SizeT GetCount() const;
+		/// the first sprite of the current run
+		const SpriteQuadInfo& GetRun() const;
+		/// write the current run to the ring buffer and draw it, the program and material params must be set already
+		void Flush();
+
+		/// counters of the current frame, reset by ResetFrameStats
+		const Stats& GetFrameStats() const;
+		/// counters since Setup
+		const Stats& GetTotalStats() const;
+		void ResetFrameStats();
+
+	private:
+		/// transform the quads of the current run into m_vertices
+		void transformQuads();
+
+		RenderBase::PrimitiveHandle m_ring;
+		SizeT m_ringCursor;			// first unused quad of the ring
+		Util::FixedArray<SpriteQuadInfo> m_quads;
+		Util::FixedArray<SpriteVertex> m_vertices;
+		GPtr<Jobs::JobPort> m_jobPort;
+		SizeT m_count;
+		bool m_enabled;
+		Stats m_frameStats;
+		Stats m_totalStats;
+	};
+
+	inline void SpriteBatcher::SetEnabled(bool enable)
+	{
+		m_enabled = enable;
+	}
+
+	inline bool SpriteBatcher::IsEnabled() const
+	{
+		return m_enabled;
+	}
+
+	inline bool SpriteBatcher::IsActive() const
+	{
+		return m_enabled && m_ring.IsValid();
+	}
+
+	inline void SpriteBatcher::Cancel()
+	{
+		m_count = 0;
+	}
+
+	inline SizeT SpriteBatcher::GetCount() const
+	{
+		return m_count;
+	}
+
+	inline const SpriteQuadInfo& SpriteBatcher::GetRun() const
+	{
+		return m_quads[0];
+	}
+
+	inline const SpriteBatcher::Stats& SpriteBatcher::GetFrameStats() const
+	{
+		return m_frameStats;
+	}
+
+	inline const SpriteBatcher::Stats& SpriteBatcher::GetTotalStats() const
+	{
+		return m_totalStats;
+	}
+}
+
+#endif //SPRITEBATCHER_H_
@@ -240,18 +240,33 @@ namespace Graphic
 	//------------------------------------------------------------------------
 	GPtr<Vis::VisQuery> RenderScene::Cull(const Camera& camera)
 	{
-		return Cull(camera.GetViewProjTransform(), camera.GetTransform().get_position());
+		return Cull(camera.GetViewProjTransform(), camera.GetTransform().get_position(), true);
 	}
 
 	//------------------------------------------------------------------------
-	GPtr<Vis::VisQuery> RenderScene::Cull(const Math::matrix44& viewProj, const Math::float4& pos)
+	GPtr<Vis::VisQuery> RenderScene::Cull(const Math::matrix44& viewProj, const Math::float4& pos, bool occlusionCulling)
 	{
 		n_assert( mVisServer.isvalid() );
 		GPtr<Vis::ObserverContext> observer = Vis::ObserverContext::Create();
 		observer->Setup(viewProj, pos);
+		observer->SetOcclusionCulling(occlusionCulling);
 		return mVisServer->PerformVisQuery(observer, Util::Array<IndexT>() );
 	}
 
+	//------------------------------------------------------------------------
+	void RenderScene::AttachOccluder(const GPtr<Vis::Occluder>& occluder)
+	{
+		n_assert( mVisServer.isvalid() );
+		mVisServer->AttachOccluder(occluder);
+	}
+
+	//------------------------------------------------------------------------
+	void RenderScene::RemoveOccluder(const GPtr<Vis::Occluder>& occluder)
+	{
+		n_assert( mVisServer.isvalid() );
+		mVisServer->RemoveOccluder(occluder);
+	}
+
 	//------------------------------------------------------------------------
 	// internal call
 	void RenderScene::_UpdateVisEntity(const GPtr<Vis::VisEntity>& visEnt )
@@ -31,6 +31,7 @@ namespace Vis
 	class VisServer;
 	class VisQuery;
 	class VisEntity;
+	class Occluder;
 }
 namespace Graphic
 {
@@ -85,8 +86,13 @@ namespace Graphic
 
 		const Util::Array<RenderObject*>& GetNotCullRenderObjects() const;
 
+		// cameras are occlusion culled
 		GPtr<Vis::VisQuery> Cull(const Camera& camera);
-		GPtr<Vis::VisQuery> Cull(const Math::matrix44& viewProj, const Math::float4& pos);
+		GPtr<Vis::VisQuery> Cull(const Math::matrix44& viewProj, const Math::float4& pos, bool occlusionCulling = false);
+
+		// occluder meshes hide the render objects behind them from the cameras
+		void AttachOccluder(const GPtr<Vis::Occluder>& occluder);
+		void RemoveOccluder(const GPtr<Vis::Occluder>& occluder);
 
 
 		Light* GetSunLight() const;
@@ -24,6 +24,7 @@ THE SOFTWARE.
 #include "stdneb.h"
 #include "ImageFilters.h"
 #include "graphicsystem/GraphicSystem.h"
+#include "graphicsystem/base/RenderToTexture.h"
 #include "materialmaker/parser/GenesisShaderParser.h"
 #include "graphicsystem/Renderable/QuadRenderable.h"
 #include "graphicsystem/Renderable/GraphicRenderer.h"
@@ -60,7 +61,8 @@ namespace Graphic
 	}
 	void ImageFiltrationSystem::ResizeWindow()
 	{
-
+		// filters take their targets from the transient pool, the old sizes are not asked for anymore
+		RenderToTextureManager::Instance()->DiscardTransients();
 	}
 	void ImageFiltrationSystem::Shutdown()
 	{
@@ -127,6 +127,9 @@ namespace Graphic
 		}
 
 		m_quadRenderable->Setup(width, height);
+
+		m_width  = width;
+		m_height = height;
 	}
 
 	void RenderToTexture::Discard()
@@ -190,14 +193,127 @@ namespace Graphic
 	}
 
 	RenderToTextureManager::RenderToTextureManager()
+		: m_TransientBytesInUse(0),
+		m_TransientLifetime(60),
+		m_FrameIndex(0)
 	{
 		__ConstructImageSingleton
+		Memory::Clear(&m_TransientStats, sizeof(m_TransientStats));
 	}
 
 	RenderToTextureManager::~RenderToTextureManager()
 	{
 		__DestructImageSingleton
 			m_RenderToTextures.Clear();
+		m_Transients.Clear();
+	}
+
+	SizeT RenderToTextureManager::transientBytes(const TransientTargetDesc& desc)
+	{
+		SizeT samples = (RenderBase::AntiAliasQuality::None == desc.quality) ? 1 : (1 << (int)desc.quality);
+		return RenderBase::PixelFormat::GetMemorySize(desc.width, desc.height, 1, desc.format) * samples;
+	}
+
+	GPtr<RenderToTexture> RenderToTextureManager::AcquireTransient(const TransientTargetDesc& desc)
+	{
+		n_assert(desc.width > 0 && desc.height > 0);
+		++m_TransientStats.acquired;
+
+		TransientTarget* found = NULL;
+		for (IndexT i = 0; i < m_Transients.Size(); ++i)
+		{
+			TransientTarget& entry = m_Transients[i];
+			if (!entry.inUse && entry.desc == desc)
+			{
+				found = &entry;
+				break;
+			}
+		}
+
+		if (NULL != found)
+		{
+			if (found->lastFrame == m_FrameIndex)
+			{
+				// an earlier user of this frame is done with it
+				++m_TransientStats.aliased;
+				m_TransientStats.aliasedBytes += found->bytes;
+			}
+		}
+		else
+		{
+			TransientTarget entry;
+			entry.target = RenderToTexture::Create();
+			entry.target->Setup(desc.width, desc.height, desc.format, 
+				RenderBase::RenderTarget::ClearAll, Math::float4(0.f,0.f,0.f,1.f), 
+				false, 0.f, desc.quality);
+			entry.desc = desc;
+			entry.bytes = transientBytes(desc);
+			entry.lastFrame = m_FrameIndex;
+			entry.inUse = false;
+			m_Transients.Append(entry);
+			found = &m_Transients.Back();
+
+			++m_TransientStats.created;
+			++m_TransientStats.pooled;
+			m_TransientStats.pooledBytes += entry.bytes;
+		}
+
+		found->inUse = true;
+		found->lastFrame = m_FrameIndex;
+		m_TransientBytesInUse += found->bytes;
+		m_TransientStats.peakBytes = Math::n_max(m_TransientStats.peakBytes, m_TransientBytesInUse);
+		return found->target;
+	}
+
+	void RenderToTextureManager::ReleaseTransient(const GPtr<RenderToTexture>& target)
+	{
+		for (IndexT i = 0; i < m_Transients.Size(); ++i)
+		{
+			TransientTarget& entry = m_Transients[i];
+			if (entry.target == target)
+			{
+				n_assert(entry.inUse);
+				entry.inUse = false;
+				m_TransientBytesInUse -= entry.bytes;
+				return;
+			}
+		}
+		n_error("RenderToTextureManager::ReleaseTransient: the target is not a transient target!");
+	}
+
+	void RenderToTextureManager::BeginFrame()
+	{
+		++m_FrameIndex;
+
+		for (IndexT i = m_Transients.Size() - 1; i >= 0; --i)
+		{
+			const TransientTarget& entry = m_Transients[i];
+			n_assert(!entry.inUse);
+			if (m_FrameIndex - entry.lastFrame > m_TransientLifetime)
+			{
+				m_Transients.EraseIndex(i);
+			}
+		}
+
+		Memory::Clear(&m_TransientStats, sizeof(m_TransientStats));
+		for (IndexT i = 0; i < m_Transients.Size(); ++i)
+		{
+			m_TransientStats.pooledBytes += m_Transients[i].bytes;
+		}
+		m_TransientStats.pooled = m_Transients.Size();
+	}
+
+	void RenderToTextureManager::DiscardTransients()
+	{
+		for (IndexT i = m_Transients.Size() - 1; i >= 0; --i)
+		{
+			if (!m_Transients[i].inUse)
+			{
+				m_TransientStats.pooledBytes -= m_Transients[i].bytes;
+				m_Transients.EraseIndex(i);
+			}
+		}
+		m_TransientStats.pooled = m_Transients.Size();
 	}
 
 
@@ -71,6 +71,9 @@ namespace Graphic
 
 		void ChangeSize(int width,int height);
 		const GPtr<QuadRenderable>& GetRenderable() const;
+
+		int GetWidth() const;
+		int GetHeight() const;
 	private:
 
 		GPtr<RenderBase::RenderTarget> m_RT;
@@ -82,6 +85,36 @@ namespace Graphic
 		int                 m_height;
 	};
 
+	/// what a transient target is matched by, targets with an equal desc are interchangeable
+	struct TransientTargetDesc
+	{
+		int width;
+		int height;
+		RenderBase::PixelFormat::Code format;
+		RenderBase::AntiAliasQuality::Code quality;
+
+		TransientTargetDesc()
+			: width(0), height(0), format(RenderBase::PixelFormat::A8R8G8B8), quality(RenderBase::AntiAliasQuality::None)
+		{
+		}
+
+		bool operator==(const TransientTargetDesc& rhs) const
+		{
+			return width == rhs.width && height == rhs.height && format == rhs.format && quality == rhs.quality;
+		}
+	};
+
+	struct TransientTargetStats
+	{
+		SizeT acquired;		// requests this frame
+		SizeT aliased;		// requests served by a target released earlier in the same frame
+		SizeT created;		// targets created this frame
+		SizeT pooled;		// targets alive in the pool
+		SizeT pooledBytes;	// video memory of all pooled targets
+		SizeT peakBytes;	// most memory held by users at the same time this frame
+		SizeT aliasedBytes;	// memory saved against one target per request
+	};
+
 	class RenderToTextureManager : public Core::RefCounted
 	{
 		__DeclareSubClass(RenderToTextureManager, Core::RefCounted)
@@ -92,10 +125,41 @@ namespace Graphic
 
 		virtual ~RenderToTextureManager();
 
+		/// hand out a frame scoped render target, must be released before the frame ends
+		GPtr<RenderToTexture> AcquireTransient(const TransientTargetDesc& desc);
+
+		/// give the target back, later requests of the same desc in this frame alias it
+		void ReleaseTransient(const GPtr<RenderToTexture>& target);
+
+		/// reset the frame stats and drop targets nobody asked for in the last frames
+		void BeginFrame();
+
+		/// drop every target not in use, after a resize or device reset
+		void DiscardTransients();
+
+		void SetTransientLifetime(SizeT frames);
+
+		const TransientTargetStats& GetTransientStats() const;
 
 	private:
+		struct TransientTarget
+		{
+			GPtr<RenderToTexture> target;
+			TransientTargetDesc desc;
+			SizeT bytes;
+			uint lastFrame;
+			bool inUse;
+		};
+
+		static SizeT transientBytes(const TransientTargetDesc& desc);
+
 		Util::Array< RenderToTexture* > m_RenderToTextures;
 
+		Util::Array<TransientTarget> m_Transients;
+		TransientTargetStats m_TransientStats;
+		SizeT m_TransientBytesInUse;
+		SizeT m_TransientLifetime;
+		uint m_FrameIndex;
 	};
 
 	inline const RenderBase::RenderTargetHandle&
@@ -133,5 +197,29 @@ namespace Graphic
 	{
 		return m_quadRenderable;
 	}
+
+	inline int
+		RenderToTexture::GetWidth() const
+	{
+		return m_width;
+	}
+
+	inline int
+		RenderToTexture::GetHeight() const
+	{
+		return m_height;
+	}
+
+	inline void
+		RenderToTextureManager::SetTransientLifetime(SizeT frames)
+	{
+		m_TransientLifetime = frames;
+	}
+
+	inline const TransientTargetStats&
+		RenderToTextureManager::GetTransientStats() const
+	{
+		return m_TransientStats;
+	}
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,337 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "stdneb.h"
+#include "servergameapplication.h"
+#include "basegamefeature/managers/timemanager.h"
+#include "inputfeature/inputfeature.h"
+#include "input/inputserver.h"
+#include "io/ioserver.h"
+#include "io/assignregistry.h"
+#include "debug/zoneprofiler.h"
+#include "debug/containerbenchmark.h"
+#include "graphicsystem/GraphicSystem.h"
+#include "appframework/actormanager.h"
+#include "resource/meshSpliter.h"
+#include "resource/debug/texturedecodebenchmark.h"
+#include "vis/debug/occlusionbenchmark.h"
+
+namespace GenesisServer
+{
+	__ImplementThreadSingleton(ServerGameApplication);
+
+	using namespace Util;
+
+	//------------------------------------------------------------------------------
+	ServerGameApplication::ServerGameApplication()
+		: mNumFrames(0)
+		, mFixedFrameTime(1.0 / 30.0)
+		, mRandomSeed(0)
+		, mStateFilter(true)
+		, mInstancing(true)
+		, mSpriteBatch(true)
+		, mNumProps(0)
+		, mContainerBenchmark(false)
+		, mDecodeBenchmark(false)
+		, mOcclusionBenchmark(false)
+		, mMeshSplitBones(0)
+	{
+		__ConstructThreadSingleton;
+	}
+	//------------------------------------------------------------------------------
+	ServerGameApplication::~ServerGameApplication()
+	{
+		__DestructThreadSingleton;
+		if (this->IsOpen())
+		{
+			this->Close();
+		}
+	}
+	//------------------------------------------------------------------------------
+	void ServerGameApplication::setupAppFromCmdLineArgs()
+	{
+		Super::setupAppFromCmdLineArgs();
+
+		const CommandLineArgs& args = this->GetCmdLineArgs();
+		mSceneName = args.GetString("-scene");
+		mNumFrames = args.GetInt("-frames", 0);
+		mFixedFrameTime = args.GetFloat("-fixedstep", float(mFixedFrameTime));
+		mRandomSeed = (uint)args.GetInt("-seed", 0);
+		mRecordPath = args.GetString("-record");
+		mReplayPath = args.GetString("-replay");
+		mBenchmarkPath = args.GetString("-benchmark");
+		mTracePath = args.GetString("-trace");
+		mStateFilter = !args.GetBoolFlag("-nostatefilter");
+		mInstancing = !args.GetBoolFlag("-noinstancing");
+		mSpriteBatch = !args.GetBoolFlag("-nospritebatch");
+		mNumProps = args.GetInt("-props", 0);
+		mPropTemplate = args.GetString("-proptemplate");
+		mContainerBenchmark = args.GetBoolFlag("-containerbenchmark");
+		mDecodeBenchmark = args.GetBoolFlag("-decodebenchmark");
+		mOcclusionBenchmark = args.GetBoolFlag("-occlusionbenchmark");
+		mMeshSplitBones = args.GetInt("-meshsplitbones", 0);
+	}
+	//------------------------------------------------------------------------------
+	GPtr<IO::Stream> ServerGameApplication::createStream(const String& path) const
+	{
+		String resolved = IO::AssignRegistry::Instance()->ResolveAssignsInString(path);
+		return IO::IoServer::Instance()->CreateFileStream(IO::URI(resolved));
+	}
+	//------------------------------------------------------------------------------
+	bool ServerGameApplication::Open()
+	{
+		if (!Super::Open())
+		{
+			return false;
+		}
+
+		srand(mRandomSeed);
+		return true;
+	}
+	//------------------------------------------------------------------------------
+	bool ServerGameApplication::Start()
+	{
+		if (!Super::Start())
+		{
+			return false;
+		}
+
+		App::TimeManager::Instance()->SetFixedFrameTime(mFixedFrameTime);
+		Graphic::GraphicSystem::Instance()->SetStateFilterEnabled(mStateFilter);
+		Graphic::GraphicSystem::Instance()->GetInstanceBatcher()->SetEnabled(mInstancing);
+		Graphic::GraphicSystem::Instance()->GetSpriteBatcher()->SetEnabled(mSpriteBatch);
+		if (mMeshSplitBones > 0)
+		{
+			Resources::MeshSpliter::Instance()->SetMaxBoneBySubmesh(mMeshSplitBones);
+		}
+
+		if (mRecordPath.IsValid())
+		{
+			mInputRecorder = Input::InputRecorder::Create();
+			mInputRecorder->SetStream(createStream(mRecordPath));
+			if (mInputRecorder->Open())
+			{
+				this->mInputFeature->GetInputServer()->SetInputRecorder(mInputRecorder);
+			}
+			else
+			{
+				mInputRecorder = NULL;
+			}
+		}
+
+		if (mBenchmarkPath.IsValid())
+		{
+			mBenchmark = App::FrameBenchmark::Create();
+			mBenchmark->SetInfo("scene", mSceneName);
+			mBenchmark->SetInfo("fixedstep", String::FromFloat(float(mFixedFrameTime)));
+			mBenchmark->SetInfo("seed", String::FromInt(mRandomSeed));
+			mBenchmark->SetInfo("replay", mReplayPath);
+		}
+
+		if (mContainerBenchmark)
+		{
+			Util::Array<Debug::ContainerBenchmark::Result> results = Debug::ContainerBenchmark::Run();
+			Debug::ContainerBenchmark::Print(results);
+			if (mBenchmark.isvalid())
+			{
+				for (IndexT i = 0; i < results.Size(); i++)
+				{
+					mBenchmark->SetInfo(String("container.") + results[i].name, String::FromFloat(float(results[i].time * 1000.0)));
+				}
+			}
+		}
+
+		if (mDecodeBenchmark)
+		{
+			Util::Array<Debug::TextureDecodeBenchmark::Result> results = Debug::TextureDecodeBenchmark::Run();
+			Debug::TextureDecodeBenchmark::Print(results);
+			if (mBenchmark.isvalid())
+			{
+				for (IndexT i = 0; i < results.Size(); i++)
+				{
+					mBenchmark->SetInfo(String("decode.") + results[i].name, String::FromFloat(float(results[i].time * 1000.0)));
+				}
+			}
+		}
+
+		if (mOcclusionBenchmark)
+		{
+			Util::Array<Debug::OcclusionBenchmark::Result> results = Debug::OcclusionBenchmark::Run();
+			const bool passed = Debug::OcclusionBenchmark::Print(results);
+			if (!passed)
+			{
+				n_warning("ServerGameApplication: OcclusionBuffer gave a wrong answer, see the log!\n");
+			}
+			if (mBenchmark.isvalid())
+			{
+				for (IndexT i = 0; i < results.Size(); i++)
+				{
+					mBenchmark->SetInfo(String("occlusion.") + results[i].name, String::FromFloat(float(results[i].time * 1000.0)));
+				}
+				mBenchmark->SetInfo("occlusion.check", passed ? "ok" : "failed");
+			}
+		}
+
+		if (mSceneName.IsValid())
+		{
+			String fullScenePath = mSceneName;
+			if (InvalidIndex == fullScenePath.FindCharIndex(':'))
+			{
+				fullScenePath = "asset:" + mSceneName;
+			}
+			if (!this->OpenScene(fullScenePath))
+			{
+				n_warning("ServerGameApplication: can not open scene '%s'!\n", fullScenePath.AsCharPtr());
+				return false;
+			}
+		}
+		spawnProps();
+		return true;
+	}
+	//------------------------------------------------------------------------------
+	void ServerGameApplication::spawnProps()
+	{
+		if (0 == mNumProps)
+		{
+			return;
+		}
+		if (!mPropTemplate.IsValid())
+		{
+			n_warning("ServerGameApplication: -props needs -proptemplate!\n");
+			return;
+		}
+
+		// square grid around the origin, 2 units apart
+		const float spacing = 2.0f;
+		SizeT side = 1;
+		while (side * side < mNumProps)
+		{
+			side++;
+		}
+		const float origin = -0.5f * spacing * float(side - 1);
+		for (IndexT i = 0; i < mNumProps; i++)
+		{
+			GPtr<App::Actor> prop = App::ActorManager::Instance()->CreateFromTemplate(mPropTemplate);
+			if (!prop.isvalid())
+			{
+				n_warning("ServerGameApplication: can not create actor from template '%s'!\n", mPropTemplate.AsCharPtr());
+				return;
+			}
+			prop->SetPosition(Math::vector(origin + spacing * float(i % side), 0.0f, origin + spacing * float(i / side)));
+			App::ActorManager::Instance()->ActiveActor(prop);
+		}
+	}
+	//------------------------------------------------------------------------------
+	void ServerGameApplication::RunFrames()
+	{
+		IndexT frame = 0;
+		while (!this->IsQuit() && (0 == mNumFrames || frame < mNumFrames))
+		{
+			if (mBenchmark.isvalid())
+			{
+				mBenchmark->BeginFrame();
+				this->Run();
+				mBenchmark->EndFrame();
+			}
+			else
+			{
+				this->Run();
+			}
+			frame++;
+
+			if (this->mInputFeature->GetInputServer()->IsQuitRequested())
+			{
+				this->Quit();
+			}
+		}
+		writeResults();
+	}
+	//------------------------------------------------------------------------------
+	void ServerGameApplication::writeResults()
+	{
+		if (mBenchmark.isvalid())
+		{
+			// device calls counted by the null device's shadow state, comparable with -nostatefilter runs
+			static const char* callNames[RenderBase::RenderStateCache::NumCallTypes] = { "program", "texture", "sampler", "renderstate", "constant" };
+			const RenderBase::RenderStateCache::Stats& stats = Graphic::GraphicSystem::Instance()->GetStateCache().GetTotalStats();
+			mBenchmark->SetInfo("statefilter", mStateFilter ? "on" : "off");
+
+			// draw calls of both paths, an instanced draw counts once
+			const Graphic::InstanceBatcher::Stats& instStats = Graphic::GraphicSystem::Instance()->GetInstanceBatcher()->GetTotalStats();
+			const Graphic::SpriteBatcher::Stats& spriteStats = Graphic::GraphicSystem::Instance()->GetSpriteBatcher()->GetTotalStats();
+			mBenchmark->SetInfo("instancing", mInstancing ? "on" : "off");
+			mBenchmark->SetInfo("spriteBatch", mSpriteBatch ? "on" : "off");
+			mBenchmark->SetInfo("props", String::FromInt(mNumProps));
+			mBenchmark->SetInfo("drawCalls", String::FromInt(Graphic::GraphicSystem::Instance()->GetNumDrawCalls()));
+			mBenchmark->SetInfo("instancedDraws", String::FromInt(instStats.batches));
+			mBenchmark->SetInfo("instancedObjects", String::FromInt(instStats.instances));
+			mBenchmark->SetInfo("spriteBatches", String::FromInt(spriteStats.batches));
+			mBenchmark->SetInfo("batchedSprites", String::FromInt(spriteStats.sprites));
+			mBenchmark->SetInfo("deviceCallsIssued", String::FromInt(stats.GetNumIssued()));
+			mBenchmark->SetInfo("deviceCallsFiltered", String::FromInt(stats.GetNumFiltered()));
+			for (IndexT i = 0; i < RenderBase::RenderStateCache::NumCallTypes; i++)
+			{
+				mBenchmark->SetInfo(String("deviceCalls.") + callNames[i], String::FromInt(stats.issued[i]) + "/" + String::FromInt(stats.issued[i] + stats.filtered[i]));
+			}
+
+			// skinned mesh splits of the session, compare runs with a cold and a warm user:cache/meshsplit
+			const Resources::MeshSplitStats splitStats = Resources::MeshSpliter::Instance()->GetStats();
+			mBenchmark->SetInfo("meshSplit.maxBones", String::FromInt(Resources::MeshSpliter::Instance()->GetMaxBoneBySubmesh()));
+			mBenchmark->SetInfo("meshSplit.meshes", String::FromInt(splitStats.meshesSplit));
+			mBenchmark->SetInfo("meshSplit.submeshesIn", String::FromInt(splitStats.submeshesIn));
+			mBenchmark->SetInfo("meshSplit.submeshesOut", String::FromInt(splitStats.submeshesOut));
+			mBenchmark->SetInfo("meshSplit.cacheHits", String::FromInt(splitStats.cacheHits));
+			mBenchmark->SetInfo("meshSplit.cacheMisses", String::FromInt(splitStats.cacheMisses));
+			mBenchmark->SetInfo("meshSplit.ms", String::FromFloat(float(splitStats.splitTime * 1000.0)));
+
+			if (!mBenchmark->WriteJson(createStream(mBenchmarkPath)))
+			{
+				n_warning("ServerGameApplication: can not write benchmark '%s'!\n", mBenchmarkPath.AsCharPtr());
+			}
+			mBenchmark = NULL;
+		}
+		if (mTracePath.IsValid())
+		{
+			if (!Debug::ZoneProfiler::WriteChromeTrace(createStream(mTracePath)))
+			{
+				n_warning("ServerGameApplication: can not write trace '%s'!\n", mTracePath.AsCharPtr());
+			}
+		}
+	}
+	//------------------------------------------------------------------------------
+	void ServerGameApplication::Close()
+	{
+		if (mInputRecorder.isvalid())
+		{
+			this->mInputFeature->GetInputServer()->SetInputRecorder(NULL);
+			mInputRecorder->Close();
+			mInputRecorder = NULL;
+		}
+		Super::Close();
+	}
+	//------------------------------------------------------------------------------
+	void ServerGameApplication::displayLOGO()
+	{
+		// empty
+	}
+}
@@ -0,0 +1,116 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef _ServerGameApplication_H_
+#define _ServerGameApplication_H_
+
+#include "appframework/gameapplication.h"
+#include "appframework/framebenchmark.h"
+#include "input/inputrecorder.h"
+
+namespace GenesisServer
+{
+	/**
+		Headless game application for dedicated servers and automated
+		benchmarks. Runs on the null render device without gui and audio,
+		advances the simulation with a fixed frame time and can record or
+		replay the input of a session.
+
+		Only built on Windows (SERVER_BUILD together with WINDOWS_BUILD): it
+		links the Windows player's libraries, and the engine has no desktop
+		platform layer besides win32.
+
+		Command line:
+		-home <dir>        project directory
+		-scene <name>      scene to open (asset: is prepended if no assign is given)
+		-frames <n>        quit after n frames (0 = run until quit is requested)
+		-fixedstep <sec>   fixed frame time in seconds (default 1/30, 0 = real time)
+		-seed <n>          seed of the c runtime random generator (default 0)
+		-record <file>     record the input into file
+		-replay <file>     replay the input from file
+		-benchmark <file>  write per frame and per zone timings as json
+		-trace <file>      write the zones of the last frames as chrome trace
+		-nostatefilter     send redundant state changes to the device, to measure the filter
+		-noinstancing      draw every render data alone instead of batching identical ones
+		-nospritebatch     draw every sprite alone instead of batching the ones sharing an image
+		-props <n>         spawn n copies of -proptemplate on a grid, a synthetic load for the renderer
+		-proptemplate <t>  actor template spawned by -props
+		-containerbenchmark run the Util container and message dispatch micro benchmarks before the scene is opened
+		-decodebenchmark   run the DXT/ETC1 texture decode benchmark before the scene is opened
+		-occlusionbenchmark check and time the software occlusion buffer before the scene is opened
+		-meshsplitbones <n> split skinned meshes for a budget of n bones per submesh (a device's budget)
+	*/
+	class ServerGameApplication : public App::GameApplication
+	{
+		typedef App::GameApplication Super;
+		__DeclareThreadSingleton(ServerGameApplication);
+	public:
+		/// constructor
+		ServerGameApplication();
+		/// destructor
+		virtual ~ServerGameApplication();
+		/// open the application
+		virtual bool Open();
+		/// start the application
+		virtual bool Start();
+		/// close application
+		virtual void Close( void );
+		/// run the configured number of frames, returns when finished or quit is requested
+		void RunFrames();
+
+	protected:
+		/// setup app from cmd lines
+		virtual void setupAppFromCmdLineArgs();
+		/// no logo without a window
+		virtual void displayLOGO();
+		/// open a stream on a file given at the command line
+		GPtr<IO::Stream> createStream(const Util::String& path) const;
+		/// write the benchmark and trace files
+		void writeResults();
+		/// spawn the -props actors
+		void spawnProps();
+
+	private:
+		Util::String mSceneName;
+		SizeT mNumFrames;
+		Timing::Time mFixedFrameTime;
+		uint mRandomSeed;
+		Util::String mRecordPath;
+		Util::String mReplayPath;
+		Util::String mBenchmarkPath;
+		Util::String mTracePath;
+		bool mStateFilter;
+		bool mInstancing;
+		bool mSpriteBatch;
+		SizeT mNumProps;
+		Util::String mPropTemplate;
+		bool mContainerBenchmark;
+		bool mDecodeBenchmark;
+		bool mOcclusionBenchmark;
+		int mMeshSplitBones;
+		GPtr<Input::InputRecorder> mInputRecorder;
+		GPtr<App::FrameBenchmark> mBenchmark;
+	};
+}
+
+#endif
@@ -0,0 +1,73 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "stdneb.h"
+#include "servergameapplication.h"
+#include "input/inputsource.h"
+#include "input/inputreplaysource.h"
+
+using namespace GenesisServer;
+
+//------------------------------------------------------------------------
+int main(int argc, const char** argv)
+{
+	Util::CommandLineArgs args(argc, argv);
+
+	ServerGameApplication* app = n_new( ServerGameApplication );
+	app->SetCompanyName( "CYOU-INC.COM" );
+	app->SetAppTitle( "Genesis Server" );
+	app->SetCmdLineArgs( args );
+	app->SetResourceBaseDir( args.GetString("-home", ".") );
+	app->SetEngineDir( args.GetString("-engine", args.GetString("-home", ".")) );
+	app->SetGameResolution( args.GetInt("-width", 1024), args.GetInt("-height", 768) );
+	app->SetGui( false );
+
+	// without a window there is no input but the replayed one
+	GPtr<Input::InputSource> input;
+	if (args.HasArg("-replay"))
+	{
+		GPtr<Input::InputReplaySource> replay = Input::InputReplaySource::Create();
+		// assigns like home: are resolved when the source is opened, after the app set them up
+		replay->SetURI(IO::URI(args.GetString("-replay")));
+		input = replay.upcast<Input::InputSource>();
+	}
+	else
+	{
+		input = Input::InputSource::Create();
+	}
+	app->SetInput( input );
+
+	int result = 0;
+	if (app->Open() && app->Start())
+	{
+		app->RunFrames();
+	}
+	else
+	{
+		result = 1;
+	}
+	app->Exit();
+	n_delete( app );
+	ServerGameApplication::ShutDown();
+	return result;
+}
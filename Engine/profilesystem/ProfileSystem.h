@@ -26,6 +26,7 @@ THE SOFTWARE.
 #define __PROFILE_SYSTEM_H__
 #include "profilesystem/DeviceStats.h"
 #include "profilesystem/TickStats.h"
+#include "debug/zoneprofiler.h"
 
 #ifdef __PROFILER__ 
 namespace Profile
@@ -39,8 +40,8 @@ namespace Profile
 #	define PROFILER_GETDEVICESTATEVAL( Value )  Profile::DeviceStats::GetDeviceState().Value
 
 #	define PROFILER_COPYTICKSTATS( out )  out = Profile::TickStats::GetTickStats()
-#	define PROFILER_ADDDTICKBEGIN( Value ) Timing::MicrosecondTick __tick_begin_##Value = (Timing::MicrosecondTick)Profile::GetusTicks();
-#	define PROFILER_ADDDTICKEND( Value ) Profile::TickStats::GetTickStats().Value += (int)(Profile::GetusTicks() - __tick_begin_##Value);
+#	define PROFILER_ADDDTICKBEGIN( Value ) _zone_begin(#Value) Timing::MicrosecondTick __tick_begin_##Value = (Timing::MicrosecondTick)Profile::GetusTicks();
+#	define PROFILER_ADDDTICKEND( Value ) Threading::Interlocked::Add(Profile::TickStats::GetTickStats().Value, (int)(Profile::GetusTicks() - __tick_begin_##Value)); _zone_end()
 #	define PROFILER_RESETICKSTATS() Profile::TickStats::GetTickStats().ResetStats()
 #	define PROFILER_GETTICKSTATEVAL( Value ) Profile::TickStats::GetTickStats().Value
 
@@ -52,13 +53,19 @@ namespace Profile
 #	define PROFILER_GETDEVICESTATEVAL( Value ) 0
 
 #	define PROFILER_COPYTICKSTATS( out )
-#	define PROFILER_ADDDTICKBEGIN( Value )
-#	define PROFILER_ADDDTICKEND( Value )
+#	define PROFILER_ADDDTICKBEGIN( Value ) _zone_begin(#Value)
+#	define PROFILER_ADDDTICKEND( Value ) _zone_end()
 #	define PROFILER_RESETICKSTATS()
 #	define PROFILER_GETTICKSTATEVAL( Value ) 0
 
 
 #endif
 
+// scoped zones of the hierarchical profiler, available in all builds (see Debug::ZoneProfiler)
+#	define PROFILER_ZONE( Name ) _zone(Name)
+#	define PROFILER_ZONE_BEGIN( Name ) _zone_begin(Name)
+#	define PROFILER_ZONE_END() _zone_end()
+#	define PROFILER_NEXTFRAME() _zone_next_frame()
+
 
 #endif //__PROFILE_SYSTEM_H__
\ No newline at end of file
@@ -28,6 +28,7 @@ THE SOFTWARE.
 
 #ifdef __PROFILER__ 
 #include "timing/time.h"
+#include "threading/interlocked.h"
 namespace Profile
 {
 	struct TickStats 
@@ -33,7 +33,7 @@ THE SOFTWARE.
 #if RENDERDEVICE_OPENGLES
 #include "gles/RenderDeviceGLES.h"
 #endif
-#if RENDERDEVICE_NULL
+#if RENDERDEVICE_NULL || RENDERDEVICE_HEADLESS
 #include "null/RenderDeviceNull.h"
 #endif
 
@@ -53,24 +53,24 @@ namespace RenderBase
 	using namespace GLES;
 #endif
 
-#if RENDERDEVICE_NULL
+#if RENDERDEVICE_NULL || RENDERDEVICE_HEADLESS
 	using namespace NullDevice;
 #endif
 
  	void RenderSystem::Open(int width, int height)
  	{
 		
-#if RENDERDEVICE_D3D9
+#if RENDERDEVICE_D3D9 && !RENDERDEVICE_HEADLESS
 		m_renderDevice = RenderDeviceD3D9::Create();
 		m_renderDevice.cast<RenderDeviceD3D9>()->SetMainWindowHandle(m_mainHWND);
 #endif
 
-#if RENDERDEVICE_NULL
+#if RENDERDEVICE_NULL || RENDERDEVICE_HEADLESS
 		m_renderDevice = RenderDeviceNull::Create();
 		m_renderDevice.cast<RenderDeviceNull>()->SetMainWindowHandle(m_mainHWND);
 #endif
 
-#if RENDERDEVICE_OPENGLES
+#if RENDERDEVICE_OPENGLES && !RENDERDEVICE_HEADLESS
 		m_renderDevice = RenderDeviceGLES::Create();
 		m_renderDevice.cast<RenderDeviceGLES>()->SetMainWindowHandle(m_mainHWND);
 #endif
@@ -79,6 +79,14 @@ namespace RenderBase
 
 		m_renderDevice->DetectGraphicCardCaps();
 
+#if RENDERDEVICE_OPENGLES && !RENDERDEVICE_HEADLESS
+		// uniforms belong to the program, texture parameters to the texture object
+		m_stateCache.SetProgramLocalBindings(true);
+		m_stateCache.SetTextureLocalSamplers(true);
+		m_stateCache.SetRegistersPerMatrix(1);
+#endif
+		m_stateCache.Invalidate();
+
 		if (!m_dummyRenderTargetHandle.IsValid())
 		{
 			GPtr<RenderBase::RenderTarget> renderTarget = RenderBase::RenderTarget::Create();
@@ -123,7 +131,12 @@ namespace RenderBase
 
 	void RenderSystem::BeginFrame()
 	{
+		m_stateCache.BeginFrame();
 		m_renderDevice->BeginFrame();
+		// the devices unbind the program and the textures at the end of a frame
+		// behind the back of the cache, the first binds of a frame must go through
+		m_stateCache.InvalidateProgram();
+		m_stateCache.InvalidateTextures();
 	}
 
 	void RenderSystem::EndFrame()
@@ -189,6 +202,8 @@ namespace RenderBase
 
 	GPUProgramHandle RenderSystem::CreateShaderProgram( const GPtr<GPUProgram>& program )
 	{
+		// a new program may reuse the address of a released one
+		m_stateCache.InvalidateProgram();
 		const GPtr<RenderCommandType> rcType = m_renderDevice->CreateRenderGPUProgram(program).upcast<RenderCommandType>();
 		rcType->SetRenderCommandType(RenderCommandType::SetGPUProgram);
 
@@ -220,6 +235,9 @@ namespace RenderBase
 	{
 		n_assert(rt.isvalid())
 		
+		// creating the resolve texture binds it on some devices
+		m_stateCache.InvalidateTextures();
+
 		//generate render target guid
 		GPtr<RenderTarget> deviceRT = m_renderDevice->CreateRenderTarget(rt);
 		GPtr<RenderCommandType> rcType = deviceRT.upcast<RenderCommandType>();
@@ -272,6 +290,7 @@ namespace RenderBase
 	TextureHandle RenderSystem::CreateTexture( const GPtr<Texture>& tex)
 	{
 		n_assert(tex.isvalid())
+		m_stateCache.InvalidateTextures();
 		GPtr<RenderCommandType> rcType = m_renderDevice->CreateRenderSideTexture(tex).upcast<RenderCommandType>();
 		rcType->SetRenderCommandType(RenderCommandType::SetTexture);
 		
@@ -295,6 +314,7 @@ namespace RenderBase
 		GPtr<RenderCommandType> rcType( (RenderCommandType*)texHandle.mRO );
 		GPtr<Texture> destTex = rcType.downcast<Texture>();
 		n_assert(destTex.isvalid())
+		m_stateCache.InvalidateTextures();
 		m_renderDevice->UpdateTexture(texUpdateFunc,destTex, tag);
 
 	}
@@ -310,6 +330,7 @@ namespace RenderBase
 		GPtr<RenderCommandType> rcType( (RenderCommandType*)texHandle.mRO );
 		GPtr<Texture> destTex = rcType.downcast<Texture>();
 		n_assert(destTex.isvalid())
+		m_stateCache.InvalidateTextures();
 		m_renderDevice->UpdateTexture( texture, destTex );
 
 	}
@@ -325,6 +346,7 @@ namespace RenderBase
 		GPtr<RenderCommandType> rcType( (RenderCommandType*)texHandle.mRO );
 		GPtr<Texture> destTex = rcType.downcast<Texture>();
 		n_assert(destTex.isvalid())
+		m_stateCache.InvalidateTextures();
 		m_renderDevice->ChangeTexture( texture, destTex );
 	}
 
@@ -352,10 +374,25 @@ namespace RenderBase
 		m_renderDevice->Draw(primGroup->GetBaseVertex(), primGroup->GetNumVertices(), primGroup->GetBaseIndex(), primGroup->GetNumIndices());
 	}
 	//--------------------------------------------------------------------------------
-	void RenderSystem::_DrawPrimitiveHWInstance(PrimitiveHandle handle)
-	{	
+	void RenderSystem::_DrawPrimitiveInstanced(PrimitiveHandle handle, SizeT startVertice, SizeT numVertice, SizeT startIndice, SizeT numIndice, PrimitiveHandle instanceStream, SizeT numInstances)
+	{
+		n_assert( handle.IsValid() && instanceStream.IsValid() );
+		n_assert( GetGraphicCardCapability().mHardwareInstancing );
 
-		
+		const PrimitiveGroup* primGroup = static_cast<const PrimitiveGroup*>(handle.mRO);
+		const PrimitiveGroup* instGroup = static_cast<const PrimitiveGroup*>(instanceStream.mRO);
+		n_assert(primGroup && instGroup);
+
+		m_renderDevice->SetPrimitiveGroup(primGroup);
+		m_renderDevice->SetStreamSource(InstanceStreamIndex, instGroup->GetVertexBuffer().get(), 0);
+		m_renderDevice->DrawIndexedInstanced(startVertice, numVertice, startIndice, numIndice, numInstances);
+	}
+	//--------------------------------------------------------------------------------
+	bool RenderSystem::IsInstancingProgram(GPUProgramHandle handle) const
+	{
+		n_assert(handle.IsValid());
+		const GPUProgram* program = static_cast<const GPUProgram*>((RenderCommandType*)handle.mRO);
+		return program->IsInstancing();
 	}
 	//--------------------------------------------------------------------------------
 
@@ -366,6 +403,7 @@ namespace RenderBase
 
 			if (0 != index)
 			{
+				m_stateCache.InvalidateTextures();
 				m_renderDevice->DisableRenderTarget(index);
 				return;
 			}
@@ -382,6 +420,7 @@ namespace RenderBase
 			
 		}
 		rt->SetClearFlags(clearflag);
+		m_stateCache.InvalidateTextures();
 		m_renderDevice->SetRenderTarget(rt);
 	}
 	//--------------------------------------------------------------------------------
@@ -413,6 +452,8 @@ namespace RenderBase
 		GPtr<RenderCommandType> desRCType( (RenderCommandType*)desHandle.mRO );
 		GPtr<RenderTarget> desRT = desRCType.downcast<RenderTarget>();
 		n_assert(desRT);
+		// the copy may draw with its own program and textures
+		m_stateCache.Invalidate();
 		desRT->CopyFrom(srcRect,srcRT,desRect);
 
 	}
@@ -422,6 +463,7 @@ namespace RenderBase
 		GPtr<RenderCommandType> rcType( (RenderCommandType*)handle.mRO );
 		GPtr<MultipleRenderTarget> mrt = rcType.downcast<MultipleRenderTarget>();
 
+		m_stateCache.InvalidateTextures();
 		m_renderDevice->SetMultipleRenderTarget(mrt, resume);
 	}
 
@@ -442,7 +484,10 @@ namespace RenderBase
 		n_assert( index >= 0 && index <= 12)
 
 		tex->SetUnitIndex(index);
-		m_renderDevice->SetTexture(tex);
+		if (m_stateCache.UpdateTexture(index, tex))
+		{
+			m_renderDevice->SetTexture(tex);
+		}
 	}
 
 	void RenderSystem::_SetShaderProgram(GPUProgramHandle handle)
@@ -453,37 +498,58 @@ namespace RenderBase
 		GPtr<GPUProgram> program = rcType.downcast<GPUProgram>();
 		n_assert(program);
 
-		m_renderDevice->SetGPUProgram(program);
+		if (m_stateCache.UpdateProgram(program))
+		{
+			m_renderDevice->SetGPUProgram(program);
+		}
 	}
 
 	void RenderSystem::SetVertexShaderConstantVectorF(const int& reg, float* val, const int& vec4count)
 	{
-		m_renderDevice->SetVertexShaderConstantVectorF(reg,val,vec4count);
+		if (m_stateCache.UpdateConstants(RenderStateCache::VertexStage, reg, vec4count, val, vec4count * 4))
+		{
+			m_renderDevice->SetVertexShaderConstantVectorF(reg,val,vec4count);
+		}
 	}
 
 	void RenderSystem::SetPixelShaderConstantVectorF(const int& reg, float* val, const int& vec4count)
 	{
-		m_renderDevice->SetPixelShaderConstantVectorF(reg,val,vec4count);
+		if (m_stateCache.UpdateConstants(RenderStateCache::PixelStage, reg, vec4count, val, vec4count * 4))
+		{
+			m_renderDevice->SetPixelShaderConstantVectorF(reg,val,vec4count);
+		}
 	}
 
 	void RenderSystem::SetVertexShaderConstantFloat(const int& reg, float* val)
 	{
-		m_renderDevice->SetVertexShaderConstantFloat(reg, val);
+		if (m_stateCache.UpdateConstants(RenderStateCache::VertexStage, reg, 1, val, 1))
+		{
+			m_renderDevice->SetVertexShaderConstantFloat(reg, val);
+		}
 	}
 
 	void RenderSystem::SetPixelShaderConstantFloat(const int& reg, float* val)
 	{
-		m_renderDevice->SetPixelShaderConstantFloat(reg, val);
+		if (m_stateCache.UpdateConstants(RenderStateCache::PixelStage, reg, 1, val, 1))
+		{
+			m_renderDevice->SetPixelShaderConstantFloat(reg, val);
+		}
 	}
 
 	void RenderSystem::SetVertexShaderConstantMatrixF(const int& reg, float* val, const int& matrixCount)
 	{
-		m_renderDevice->SetVertexShaderConstantMatrixF(reg, val, matrixCount);
+		if (m_stateCache.UpdateConstants(RenderStateCache::VertexStage, reg, m_stateCache.GetRegistersPerMatrix() * matrixCount, val, matrixCount * 16))
+		{
+			m_renderDevice->SetVertexShaderConstantMatrixF(reg, val, matrixCount);
+		}
 	}
 
 	void RenderSystem::SetPixelShaderConstantMatrixF(const int& reg, float* val, const int& matrixCount)
 	{
-		m_renderDevice->SetPixelShaderConstantMatrixF(reg, val, matrixCount);
+		if (m_stateCache.UpdateConstants(RenderStateCache::PixelStage, reg, m_stateCache.GetRegistersPerMatrix() * matrixCount, val, matrixCount * 16))
+		{
+			m_renderDevice->SetPixelShaderConstantMatrixF(reg, val, matrixCount);
+		}
 	}
 
 	void RenderSystem::_SetRenderState( GPtr<RenderStateDesc> rsObject)
@@ -491,19 +557,19 @@ namespace RenderBase
 		n_assert(rsObject.isvalid())
 			unsigned int flag = rsObject->GetUpdateFlag();
 		n_assert(RenderStateDesc::eInvalidRenderState != flag)
-			if (flag & RenderStateDesc::eRenderSamplerState)
+			if ((flag & RenderStateDesc::eRenderSamplerState) && m_stateCache.UpdateSamplerState(rsObject->GetSamplerState()))
 			{
 				m_renderDevice->SetTextureSamplerState(rsObject->GetSamplerState());
 			}
-			if (flag & RenderStateDesc::eRenderBlendState)
+			if ((flag & RenderStateDesc::eRenderBlendState) && m_stateCache.UpdateBlendState(rsObject->GetBlendState()))
 			{
 				m_renderDevice->SetBlendState(rsObject->GetBlendState());
 			}
-			if (flag & RenderStateDesc::eRenderDepthAndStencilState)
+			if ((flag & RenderStateDesc::eRenderDepthAndStencilState) && m_stateCache.UpdateDepthAndStencilState(rsObject->GetDepthAndStencilState()))
 			{
 				m_renderDevice->SetDepthAndStencilState(rsObject->GetDepthAndStencilState());
 			}
-			if (flag & RenderStateDesc::eRenderRasterizerState)
+			if ((flag & RenderStateDesc::eRenderRasterizerState) && m_stateCache.UpdateRasterState(rsObject->GetRasterizerState()))
 			{
 				m_renderDevice->SetRasterState(rsObject->GetRasterizerState());
 			}
@@ -660,16 +726,16 @@ namespace RenderBase
 
 	RenderWindow* RenderSystem::CreateViewPortWnd( WindHandle hWnd )
 	{
-#if RENDERDEVICE_D3D9
+#if RENDERDEVICE_D3D9 && !RENDERDEVICE_HEADLESS
 		return m_renderDevice.cast<RenderDeviceD3D9>()->CreateViewPortWnd( hWnd );
 #endif
 
-#if RENDERDEVICE_OPENGLES
+#if RENDERDEVICE_OPENGLES && !RENDERDEVICE_HEADLESS
 
 		return m_renderDevice.cast<RenderDeviceGLES>()->CreateViewPortWnd(hWnd);
 #endif
 
-#if RENDERDEVICE_NULL
+#if RENDERDEVICE_NULL || RENDERDEVICE_HEADLESS
 		return m_renderDevice.cast<RenderDeviceNull>()->CreateViewPortWnd(hWnd);
 #endif
 		return NULL;
@@ -678,20 +744,25 @@ namespace RenderBase
 
 	void RenderSystem::DestroyViewPortWnd(RenderWindow* view)
 	{
-#if RENDERDEVICE_D3D9
+#if RENDERDEVICE_D3D9 && !RENDERDEVICE_HEADLESS
 		m_renderDevice.cast<RenderDeviceD3D9>()->DestroyViewPortWnd( static_cast<D3D9Window*>(view) );
 #endif
 
-#if RENDERDEVICE_OPENGLES
+#if RENDERDEVICE_OPENGLES && !RENDERDEVICE_HEADLESS
 
 		m_renderDevice.cast<RenderDeviceGLES>()->DestroyViewPortWnd(static_cast<GLESWindow*>(view));
 #endif
+
+#if RENDERDEVICE_NULL || RENDERDEVICE_HEADLESS
+		m_renderDevice.cast<RenderDeviceNull>()->DestroyViewPortWnd(static_cast<NullWindow*>(view));
+#endif
 	}
 
 	void RenderSystem::OnDeviceLost()
 	{
 		m_renderDevice->OnDeviceLost();
 		_OnDeviceLost();
+		m_stateCache.Invalidate();
 	}
 
 	bool RenderSystem::CheckReset()
@@ -703,6 +774,7 @@ namespace RenderBase
 	{
 		m_renderDevice->OnDeviceReset();
 		_OnDeviceReset();
+		m_stateCache.Invalidate();
 	}
 
 	
@@ -39,6 +39,7 @@ THE SOFTWARE.
 #include "RenderSystemThreadHandler.h"
 #include "base/GraphicCardCapability.h"
 #include "base/RenderWindow.h"
+#include "base/RenderStateCache.h"
 
 namespace RenderBase
 {
@@ -99,7 +100,10 @@ namespace RenderBase
 		
 		void _DrawPrimitive(PrimitiveHandle handle,SizeT startVertice,SizeT endVertice,SizeT startIndice,SizeT endIndice);
 		void _DrawPrimitive(PrimitiveHandle handle);
-		void _DrawPrimitiveHWInstance(PrimitiveHandle handle);
+		/// draw numInstances copies of a range of handle, instanceStream holds one InstanceVectorCount float4 record per instance
+		void _DrawPrimitiveInstanced(PrimitiveHandle handle, SizeT startVertice, SizeT numVertice, SizeT startIndice, SizeT numIndice, PrimitiveHandle instanceStream, SizeT numInstances);
+		/// can the program be fed from the instance stream
+		bool IsInstancingProgram(GPUProgramHandle handle) const;
 		
 
 		RenderStateDescHandle CreateRenderStateObject( const GPtr<RenderStateDesc>& rsObject);
@@ -142,6 +146,11 @@ namespace RenderBase
 
 		void SetWireFrameMode(bool wireframe = false);
 
+		/// enable or disable dropping redundant state changes before they reach the device
+		void SetStateFilterEnabled(bool enable);
+		/// the shadow state, with the issued and filtered call counters
+		const RenderStateCache& GetStateCache() const;
+
 		void OnDeviceLost();
 
 		bool CheckReset();
@@ -159,6 +168,7 @@ namespace RenderBase
 		GPtr<RenderDevice> m_renderDevice;
 		GPtr<RenderDisplay> m_renderDisplay;
 		RenderBase::RenderTargetHandle m_dummyRenderTargetHandle;
+		RenderStateCache m_stateCache;
 
 		typedef Util::STL_set<RenderResourceHandle> RenderResourceHandleSet;
 		RenderResourceHandleSet::type m_renderHandles;
@@ -216,6 +226,16 @@ namespace RenderBase
 		m_renderDevice->SetDrawWireFrame(wireframe);
 	}
 
+	inline void RenderSystem::SetStateFilterEnabled(bool enable)
+	{
+		m_stateCache.SetEnabled(enable);
+	}
+
+	inline const RenderStateCache& RenderSystem::GetStateCache() const
+	{
+		return m_stateCache;
+	}
+
 	inline float RenderSystem::GetHorizontalTexelOffset()
 	{
 		return m_renderDevice->GetHorizontalTexelOffset();
@@ -47,6 +47,29 @@ namespace RenderBase
 	void RenderSystemThreadHandler::Open()
 	{
 		Super::Open();
+
+		m_handlers.Add<StartRenderSystemMSG>();
+		m_handlers.Add<BeginFrameMSG>();
+		m_handlers.Add<EndFrameMSG>();
+		m_handlers.Add<SetViewPortMSG>();
+		m_handlers.Add<CreateTextureMSG>();
+		m_handlers.Add<CreateShaderProgramMSG>();
+		m_handlers.Add<CreateRenderTargetMSG>();
+		m_handlers.Add<CreatePrimitiveGroupMSG>();
+		m_handlers.Add<UpdatePrimitiveGroupMSG>();
+		m_handlers.Add<SetTextureMSG>();
+		m_handlers.Add<SetRenderStateMSG>();
+		m_handlers.Add<SetVertexShaderConstantVectorFMSG>();
+		m_handlers.Add<SetPixelShaderConstantVectorFMSG>();
+		m_handlers.Add<SetVertexShaderConstantFloatMSG>();
+		m_handlers.Add<SetPixelShaderConstantFloatMSG>();
+		m_handlers.Add<SetVertexShaderConstantMatrixFMSG>();
+		m_handlers.Add<SetPixelShaderConstantMatrixFMSG>();
+		m_handlers.Add<SetGPUProgramMSG>();
+		m_handlers.Add<SetRenderTargetMSG>();
+		m_handlers.Add<DrawMSG>();
+		m_handlers.Add<RemoveRenderResourceMSG>();
+
 		m_renderSystem = RenderSystem::Create();
 #ifdef __WIN32__
 		m_renderSystem->SetMainWindowHandle(m_mainHWND);
@@ -64,30 +87,7 @@ namespace RenderBase
 	bool RenderSystemThreadHandler::HandleMessage(const GPtr<Messaging::Message>& msg)
 	{
 		n_assert(msg.isvalid());
-
-		__StaticHandle(StartRenderSystemMSG);
-		__StaticHandle(BeginFrameMSG);
-		__StaticHandle(EndFrameMSG);
-		__StaticHandle(SetViewPortMSG);
-		__StaticHandle(CreateTextureMSG);
-		__StaticHandle(CreateShaderProgramMSG);
-		__StaticHandle(CreateRenderTargetMSG);
-		__StaticHandle(CreatePrimitiveGroupMSG);
-		__StaticHandle(UpdatePrimitiveGroupMSG);
-		__StaticHandle(SetTextureMSG);
-		__StaticHandle(SetRenderStateMSG);
-		__StaticHandle(SetVertexShaderConstantVectorFMSG);
-		__StaticHandle(SetPixelShaderConstantVectorFMSG);
-		__StaticHandle(SetVertexShaderConstantFloatMSG);
-		__StaticHandle(SetPixelShaderConstantFloatMSG);
-		__StaticHandle(SetVertexShaderConstantMatrixFMSG);
-		__StaticHandle(SetPixelShaderConstantMatrixFMSG);
-		__StaticHandle(SetGPUProgramMSG);
-		__StaticHandle(SetRenderTargetMSG);
-		__StaticHandle(DrawMSG);
-		__StaticHandle(RemoveRenderResourceMSG);
-
-		return false;
+		return m_handlers.Dispatch(msg);
 
 	}
 
@@ -27,6 +27,7 @@ THE SOFTWARE.
 #include "RenderSystem.h"
 #include "interface/interfacehandlerbase.h"
 #include "messaging/message.h"
+#include "messaging/staticmessagehandler.h"
 
 
 namespace RenderBase
@@ -52,6 +53,7 @@ public:
 
 private:
 	GPtr<RenderSystem> m_renderSystem;
+	Messaging::StaticHandlerTable m_handlers;
 
 #ifdef __WIN32__
 	HWND m_mainHWND;
@@ -35,6 +35,13 @@ namespace RenderBase
 {
 	const int MaxNumVertexStreams = 2;
 
+	/// hardware instancing: the per instance data is bound to this stream
+	const IndexT InstanceStreamIndex = 1;
+	/// per instance vectors are fed to TEXCOORD[InstanceTexCoordBase, InstanceTexCoordBase + InstanceVectorCount)
+	const IndexT InstanceTexCoordBase = 11;
+	/// four world matrix rows and one instance parameter
+	const SizeT InstanceVectorCount = 5;
+
 	struct BufferData
 	{
 		enum Usage
@@ -54,9 +61,11 @@ namespace RenderBase
 	{
 		void* data;
 		int sizeInByte;
+		int offsetInByte;	// > 0 appends behind data the gpu may still read, 0 replaces the whole buffer
 		inline DataStream()
 			:data(NULL)
 			,sizeInByte(0)
+			,offsetInByte(0)
 		{
 
 		}
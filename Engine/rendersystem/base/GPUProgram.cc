@@ -30,6 +30,7 @@ namespace RenderBase
 	__ImplementClass(GPUProgram,'GPRS',RenderCommandType)
 
 	GPUProgram::GPUProgram()
+		: m_instancing(false)
 	{
 		SetRenderCommandType(RenderCommandType::SetGPUProgram);
 	}
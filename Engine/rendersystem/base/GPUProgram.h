@@ -54,11 +54,16 @@ namespace RenderBase
 
 		void SetID(const Util::StringAtom& id);
 
+		/// does the vertex shader read the per instance stream (TEXCOORD InstanceTexCoordBase and up)
+		bool IsInstancing() const;
+		void SetInstancing(bool instancing);
+
 	protected:
 		ResourcePath m_codePath;
 		Util::String m_vertexCode;
 		Util::String m_pixelCode;
 		Util::StringAtom m_id;
+		bool m_instancing;
 	};
 
 	inline void GPUProgram::SetCodePath(const ResourcePath& path)
@@ -101,6 +106,16 @@ namespace RenderBase
 	{
 		m_id = id;
 	}
+
+	inline bool GPUProgram::IsInstancing() const
+	{
+		return m_instancing;
+	}
+
+	inline void GPUProgram::SetInstancing(bool instancing)
+	{
+		m_instancing = instancing;
+	}
 }
 
 #endif
\ No newline at end of file
@@ -41,6 +41,7 @@ namespace RenderBase
 struct GraphicCardCapability
 {
 	GraphicCardCapability()
+		: mHardwareInstancing(false)
 	{
 	}
 
@@ -49,6 +50,9 @@ struct GraphicCardCapability
 
 	SizeT mMaxTextureWidth;
 	SizeT mMaxTextureHeight;
+
+	/// device can draw many instances of one primitive group with a per instance vertex stream
+	bool mHardwareInstancing;
 	
 #if RENDERDEVICE_OPENGLES
 	int  mMaxUniformVectors;
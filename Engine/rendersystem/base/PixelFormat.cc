@@ -114,6 +114,7 @@ namespace RenderBase
 				// DXT formats work by dividing the image into 4x4 blocks, then encoding each
 				// 4x4 block with a certain number of bytes. 
 			case DXT1:
+			case ETC1_RGB8:
 				return ((width+3)/4)*((height+3)/4)*8 * depth;
 			case DXT2:
 			case DXT3:
@@ -73,7 +73,7 @@ RenderDevice::SetStreamSource(IndexT streamIndex, const VertexBuffer* vb, IndexT
 /**
 */
 void
-RenderDevice::DrawIndexedInstanced(SizeT numInstances)
+RenderDevice::DrawIndexedInstanced(SizeT startVertice, SizeT numVertice, SizeT startIndice, SizeT numIndice, SizeT numInstances)
 {
     //n_assert(this->inBeginPass);
     // override in subclass!
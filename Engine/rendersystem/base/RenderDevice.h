@@ -170,8 +170,8 @@ public:
 	virtual void SetGPUProgram(const GPUProgram* program) = 0;
 	/// draw current primitives
 	virtual void Draw(SizeT startVertice,SizeT endVertice,SizeT startIndice,SizeT endIndice) = 0;
-	/// draw indexed, instanced primitives
-	virtual void DrawIndexedInstanced(SizeT numInstances);
+	/// draw numInstances copies of the current primitive group, per instance data comes from InstanceStreamIndex
+	virtual void DrawIndexedInstanced(SizeT startVertice, SizeT numVertice, SizeT startIndice, SizeT numIndice, SizeT numInstances);
 	/// end current frame
 	virtual void EndFrame() = 0;
 	/// present the rendered scene
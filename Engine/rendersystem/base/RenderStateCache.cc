@@ -0,0 +1,333 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#include "stdneb.h"
+#include "RenderStateCache.h"
+
+namespace RenderBase
+{
+	//------------------------------------------------------------------------
+	RenderStateCache::Stats::Stats()
+	{
+		Clear();
+	}
+	//------------------------------------------------------------------------
+	void
+		RenderStateCache::Stats::Clear()
+	{
+		for (IndexT i = 0; i < NumCallTypes; ++i)
+		{
+			issued[i] = 0;
+			filtered[i] = 0;
+		}
+	}
+	//------------------------------------------------------------------------
+	SizeT
+		RenderStateCache::Stats::GetNumIssued() const
+	{
+		SizeT num = 0;
+		for (IndexT i = 0; i < NumCallTypes; ++i)
+		{
+			num += issued[i];
+		}
+		return num;
+	}
+	//------------------------------------------------------------------------
+	SizeT
+		RenderStateCache::Stats::GetNumFiltered() const
+	{
+		SizeT num = 0;
+		for (IndexT i = 0; i < NumCallTypes; ++i)
+		{
+			num += filtered[i];
+		}
+		return num;
+	}
+	//------------------------------------------------------------------------
+	RenderStateCache::RenderStateCache()
+		: m_enabled(true),
+		m_programLocalBindings(false),
+		m_textureLocalSamplers(false),
+		m_registersPerMatrix(4)
+	{
+		Invalidate();
+	}
+	//------------------------------------------------------------------------
+	void
+		RenderStateCache::Invalidate()
+	{
+		InvalidateProgram();
+		InvalidateTextures();
+		InvalidateConstants();
+		m_blendValid = false;
+		m_depthValid = false;
+		m_rasterValid = false;
+	}
+	//------------------------------------------------------------------------
+	void
+		RenderStateCache::InvalidateProgram()
+	{
+		m_program = NULL;
+	}
+	//------------------------------------------------------------------------
+	void
+		RenderStateCache::InvalidateTextures()
+	{
+		for (IndexT i = 0; i < MaxTextureUnits; ++i)
+		{
+			m_textures[i] = NULL;
+		}
+		m_samplerValid = false;
+	}
+	//------------------------------------------------------------------------
+	void
+		RenderStateCache::InvalidateConstants()
+	{
+		for (IndexT stage = 0; stage < NumShaderStages; ++stage)
+		{
+			for (IndexT reg = 0; reg < MaxConstantRegisters; ++reg)
+			{
+				ConstantRange& range = m_constants[stage][reg];
+				range.hash = 0;
+				range.owner = -1;
+				range.numRegisters = 0;
+			}
+		}
+	}
+	//------------------------------------------------------------------------
+	void
+		RenderStateCache::BeginFrame()
+	{
+		m_frameStats = m_curFrameStats;
+		m_curFrameStats.Clear();
+	}
+	//------------------------------------------------------------------------
+	bool
+		RenderStateCache::UpdateProgram(const GPUProgram* program)
+	{
+		if (m_enabled && program == m_program)
+		{
+			return _Filter(ProgramCall);
+		}
+		m_program = program;
+		if (m_programLocalBindings)
+		{
+			// the new program has its own uniforms
+			InvalidateConstants();
+			InvalidateTextures();
+		}
+		return _Issue(ProgramCall);
+	}
+	//------------------------------------------------------------------------
+	bool
+		RenderStateCache::UpdateTexture(IndexT unit, const Texture* tex)
+	{
+		if (unit < 0 || unit >= MaxTextureUnits)
+		{
+			return _Issue(TextureCall);
+		}
+		if (m_enabled && tex == m_textures[unit])
+		{
+			return _Filter(TextureCall);
+		}
+		m_textures[unit] = tex;
+		if (m_textureLocalSamplers)
+		{
+			m_samplerValid = false;
+		}
+		return _Issue(TextureCall);
+	}
+	//------------------------------------------------------------------------
+	bool
+		RenderStateCache::UpdateSamplerState(const DeviceSamplerState& state)
+	{
+		if (m_enabled && m_samplerValid && _Equal(state, m_samplerState))
+		{
+			return _Filter(SamplerCall);
+		}
+		m_samplerState = state;
+		m_samplerValid = true;
+		return _Issue(SamplerCall);
+	}
+	//------------------------------------------------------------------------
+	bool
+		RenderStateCache::UpdateBlendState(const DeviceBlendState& state)
+	{
+		if (m_enabled && m_blendValid && _Equal(state, m_blendState))
+		{
+			return _Filter(RenderStateCall);
+		}
+		m_blendState = state;
+		m_blendValid = true;
+		return _Issue(RenderStateCall);
+	}
+	//------------------------------------------------------------------------
+	bool
+		RenderStateCache::UpdateDepthAndStencilState(const DeviceDepthAndStencilState& state)
+	{
+		if (m_enabled && m_depthValid && _Equal(state, m_depthState))
+		{
+			return _Filter(RenderStateCall);
+		}
+		m_depthState = state;
+		m_depthValid = true;
+		return _Issue(RenderStateCall);
+	}
+	//------------------------------------------------------------------------
+	bool
+		RenderStateCache::UpdateRasterState(const DeviceRasterizerState& state)
+	{
+		if (m_enabled && m_rasterValid && _Equal(state, m_rasterState))
+		{
+			return _Filter(RenderStateCall);
+		}
+		m_rasterState = state;
+		m_rasterValid = true;
+		return _Issue(RenderStateCall);
+	}
+	//------------------------------------------------------------------------
+	bool
+		RenderStateCache::UpdateConstants(ShaderStage stage, int reg, SizeT numRegisters, const float* data, SizeT numFloats)
+	{
+		n_assert(stage >= 0 && stage < NumShaderStages);
+		ConstantRange* ranges = m_constants[stage];
+		const int begin = Math::n_max(reg, 0);
+		const int end = Math::n_min(reg + (int)numRegisters, (int)MaxConstantRegisters);
+		const bool tracked = m_enabled && reg >= 0 && reg + (int)numRegisters <= (int)MaxConstantRegisters;
+
+		uint64 hash = 0;
+		if (tracked)
+		{
+			hash = _Hash(data, numFloats);
+			const ConstantRange& head = ranges[reg];
+			if (head.owner == reg && head.numRegisters == numRegisters && head.hash == hash)
+			{
+				return _Filter(ConstantCall);
+			}
+		}
+
+		// the write replaces every range it overlaps
+		for (int r = begin; r < end; ++r)
+		{
+			const int owner = ranges[r].owner;
+			if (owner >= 0)
+			{
+				const int ownerEnd = owner + (int)ranges[owner].numRegisters;
+				for (int o = owner; o < ownerEnd; ++o)
+				{
+					ranges[o].owner = -1;
+				}
+			}
+		}
+
+		if (tracked)
+		{
+			for (int r = begin; r < end; ++r)
+			{
+				ranges[r].owner = reg;
+			}
+			ranges[reg].hash = hash;
+			ranges[reg].numRegisters = numRegisters;
+		}
+		return _Issue(ConstantCall);
+	}
+	//------------------------------------------------------------------------
+	uint64
+		RenderStateCache::_Hash(const float* data, SizeT numFloats)
+	{
+		// FNV-1a
+		const unsigned char* bytes = (const unsigned char*)data;
+		const SizeT numBytes = numFloats * sizeof(float);
+		uint64 hash = 14695981039346656037ULL;
+		for (SizeT i = 0; i < numBytes; ++i)
+		{
+			hash ^= bytes[i];
+			hash *= 1099511628211ULL;
+		}
+		return hash;
+	}
+	//------------------------------------------------------------------------
+	bool
+		RenderStateCache::_Equal(const DeviceSamplerState& lhs, const DeviceSamplerState& rhs)
+	{
+		return lhs.m_textureIndexEnable == rhs.m_textureIndexEnable
+			&& lhs.m_addressU == rhs.m_addressU
+			&& lhs.m_addressV == rhs.m_addressV
+			&& lhs.m_addressW == rhs.m_addressW
+			&& lhs.m_Filter == rhs.m_Filter
+			&& lhs.m_maxAnisotropy == rhs.m_maxAnisotropy
+			&& lhs.m_textureType == rhs.m_textureType;
+	}
+	//------------------------------------------------------------------------
+	bool
+		RenderStateCache::_Equal(const DeviceBlendState& lhs, const DeviceBlendState& rhs)
+	{
+		return lhs.m_alphaTestEnable == rhs.m_alphaTestEnable
+			&& lhs.m_separateAlphaBlendEnable == rhs.m_separateAlphaBlendEnable
+			&& lhs.m_alphaFunc == rhs.m_alphaFunc
+			&& lhs.m_alphaRef == rhs.m_alphaRef
+			&& lhs.m_alphaBlendEnable == rhs.m_alphaBlendEnable
+			&& lhs.m_blendOP == rhs.m_blendOP
+			&& lhs.m_srcBlend == rhs.m_srcBlend
+			&& lhs.m_destBlend == rhs.m_destBlend
+			&& lhs.m_blendOPAlpha == rhs.m_blendOPAlpha
+			&& lhs.m_srcBlendAlpha == rhs.m_srcBlendAlpha
+			&& lhs.m_destBlendAlpha == rhs.m_destBlendAlpha
+			&& lhs.m_colorWriteMask == rhs.m_colorWriteMask;
+	}
+	//------------------------------------------------------------------------
+	bool
+		RenderStateCache::_Equal(const DeviceDepthAndStencilState& lhs, const DeviceDepthAndStencilState& rhs)
+	{
+		return lhs.m_depthEnable == rhs.m_depthEnable
+			&& lhs.m_depthWriteMask == rhs.m_depthWriteMask
+			&& lhs.m_zFunc == rhs.m_zFunc
+			&& lhs.m_stencilRef == rhs.m_stencilRef
+			&& lhs.m_stencilEnable == rhs.m_stencilEnable
+			&& lhs.m_stencilFunc == rhs.m_stencilFunc
+			&& lhs.m_stencilReadMask == rhs.m_stencilReadMask
+			&& lhs.m_stencilWriteMask == rhs.m_stencilWriteMask
+			&& lhs.m_stencilFail == rhs.m_stencilFail
+			&& lhs.m_stencilZFail == rhs.m_stencilZFail
+			&& lhs.m_stencilPass == rhs.m_stencilPass
+			&& lhs.m_stencilTwoEnable == rhs.m_stencilTwoEnable
+			&& lhs.m_StencilTwoFunc == rhs.m_StencilTwoFunc
+			&& lhs.m_stencilTwoReadMask == rhs.m_stencilTwoReadMask
+			&& lhs.m_stencilTwoWriteMask == rhs.m_stencilTwoWriteMask
+			&& lhs.m_stencilTwoFail == rhs.m_stencilTwoFail
+			&& lhs.m_stencilTwoZFail == rhs.m_stencilTwoZFail
+			&& lhs.m_stencilTwoPass == rhs.m_stencilTwoPass;
+	}
+	//------------------------------------------------------------------------
+	bool
+		RenderStateCache::_Equal(const DeviceRasterizerState& lhs, const DeviceRasterizerState& rhs)
+	{
+		return lhs.m_fillMode == rhs.m_fillMode
+			&& lhs.m_cullMode == rhs.m_cullMode
+			&& lhs.m_slopScaleDepthBias == rhs.m_slopScaleDepthBias
+			&& lhs.m_depthBias == rhs.m_depthBias
+			&& lhs.m_scissorTestEnable == rhs.m_scissorTestEnable
+			&& lhs.m_multisampleEnable == rhs.m_multisampleEnable;
+	}
+}
@@ -0,0 +1,233 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+
+#ifndef RENDERSTATECACHE_H_
+#define RENDERSTATECACHE_H_
+#include "core/types.h"
+#include "RenderDeviceTypes.h"
+
+namespace RenderBase
+{
+	class GPUProgram;
+	class Texture;
+
+	/**
+		Shadow copy of the device state, sits between the RenderSystem and the RenderDevice.
+
+		Every Update* method returns true when the value differs from the one the device
+		already has, the caller must send it to the device then. Shader constants are kept
+		per start register as a 64 bit hash of the written range, a write of the same data
+		to the same range is dropped, writes overlapping an older range invalidate it.
+
+		Some apis keep bindings in other objects than the device: GL uniforms (constants,
+		sampler units) belong to the program and the sampler state belongs to the texture
+		object, SetProgramLocalBindings and SetTextureLocalSamplers tell the cache so.
+
+		Anything that touches the device behind the back of the cache (resource creation,
+		render target copies, device reset) must call one of the Invalidate methods.
+	*/
+	class RenderStateCache
+	{
+	public:
+		enum CallType
+		{
+			ProgramCall = 0,
+			TextureCall,
+			SamplerCall,
+			RenderStateCall,	//	blend, depth-stencil and rasterizer state
+			ConstantCall,
+
+			NumCallTypes
+		};
+
+		enum ShaderStage
+		{
+			VertexStage = 0,
+			PixelStage,
+
+			NumShaderStages
+		};
+
+		/// issued and filtered device calls
+		struct Stats
+		{
+			Stats();
+			void Clear();
+			SizeT GetNumIssued() const;
+			SizeT GetNumFiltered() const;
+
+			SizeT issued[NumCallTypes];
+			SizeT filtered[NumCallTypes];
+		};
+
+		static const SizeT MaxTextureUnits = 16;
+		static const SizeT MaxConstantRegisters = 256;
+
+		RenderStateCache();
+
+		/// enable or disable filtering, a disabled cache lets every call through
+		void SetEnabled(bool enable);
+		bool IsEnabled() const;
+
+		/// constants and sampler unit bindings are lost when the program changes
+		void SetProgramLocalBindings(bool programLocal);
+		/// the sampler state has to be set again after a texture was bound
+		void SetTextureLocalSamplers(bool textureLocal);
+		/// constant registers (or uniform locations) taken by one matrix
+		void SetRegistersPerMatrix(SizeT numRegisters);
+		SizeT GetRegistersPerMatrix() const;
+
+		/// forget the whole device state
+		void Invalidate();
+		/// forget the bound program
+		void InvalidateProgram();
+		/// forget the bound textures and the sampler state
+		void InvalidateTextures();
+		/// forget all shader constants
+		void InvalidateConstants();
+
+		/// start a new frame, the stats of the finished frame move to GetFrameStats
+		void BeginFrame();
+
+		bool UpdateProgram(const GPUProgram* program);
+		bool UpdateTexture(IndexT unit, const Texture* tex);
+		bool UpdateSamplerState(const DeviceSamplerState& state);
+		bool UpdateBlendState(const DeviceBlendState& state);
+		bool UpdateDepthAndStencilState(const DeviceDepthAndStencilState& state);
+		bool UpdateRasterState(const DeviceRasterizerState& state);
+		/// numRegisters: registers covered by the write, data: the float data of the write
+		bool UpdateConstants(ShaderStage stage, int reg, SizeT numRegisters, const float* data, SizeT numFloats);
+
+		/// stats of the last finished frame
+		const Stats& GetFrameStats() const;
+		/// stats since the cache was created
+		const Stats& GetTotalStats() const;
+
+	private:
+		struct ConstantRange
+		{
+			uint64 hash;
+			int owner;	//	start register of the range covering this register, -1 if unknown
+			SizeT numRegisters;	//	only valid for owner == own register
+		};
+
+		bool _Issue(CallType type);
+		bool _Filter(CallType type);
+
+		static uint64 _Hash(const float* data, SizeT numFloats);
+		static bool _Equal(const DeviceSamplerState& lhs, const DeviceSamplerState& rhs);
+		static bool _Equal(const DeviceBlendState& lhs, const DeviceBlendState& rhs);
+		static bool _Equal(const DeviceDepthAndStencilState& lhs, const DeviceDepthAndStencilState& rhs);
+		static bool _Equal(const DeviceRasterizerState& lhs, const DeviceRasterizerState& rhs);
+
+		bool m_enabled;
+		bool m_programLocalBindings;
+		bool m_textureLocalSamplers;
+		SizeT m_registersPerMatrix;
+
+		const GPUProgram* m_program;
+		const Texture* m_textures[MaxTextureUnits];
+
+		bool m_samplerValid;
+		bool m_blendValid;
+		bool m_depthValid;
+		bool m_rasterValid;
+		DeviceSamplerState m_samplerState;
+		DeviceBlendState m_blendState;
+		DeviceDepthAndStencilState m_depthState;
+		DeviceRasterizerState m_rasterState;
+
+		ConstantRange m_constants[NumShaderStages][MaxConstantRegisters];
+
+		Stats m_curFrameStats;
+		Stats m_frameStats;
+		Stats m_totalStats;
+	};
+
+	inline void
+		RenderStateCache::SetEnabled(bool enable)
+	{
+		m_enabled = enable;
+		Invalidate();
+	}
+
+	inline bool
+		RenderStateCache::IsEnabled() const
+	{
+		return m_enabled;
+	}
+
+	inline void
+		RenderStateCache::SetProgramLocalBindings(bool programLocal)
+	{
+		m_programLocalBindings = programLocal;
+	}
+
+	inline void
+		RenderStateCache::SetTextureLocalSamplers(bool textureLocal)
+	{
+		m_textureLocalSamplers = textureLocal;
+	}
+
+	inline void
+		RenderStateCache::SetRegistersPerMatrix(SizeT numRegisters)
+	{
+		m_registersPerMatrix = numRegisters;
+	}
+
+	inline SizeT
+		RenderStateCache::GetRegistersPerMatrix() const
+	{
+		return m_registersPerMatrix;
+	}
+
+	inline const RenderStateCache::Stats&
+		RenderStateCache::GetFrameStats() const
+	{
+		return m_frameStats;
+	}
+
+	inline const RenderStateCache::Stats&
+		RenderStateCache::GetTotalStats() const
+	{
+		return m_totalStats;
+	}
+
+	inline bool
+		RenderStateCache::_Issue(CallType type)
+	{
+		++m_curFrameStats.issued[type];
+		++m_totalStats.issued[type];
+		return true;
+	}
+
+	inline bool
+		RenderStateCache::_Filter(CallType type)
+	{
+		++m_curFrameStats.filtered[type];
+		++m_totalStats.filtered[type];
+		return false;
+	}
+}
+#endif
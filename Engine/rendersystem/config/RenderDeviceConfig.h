@@ -45,4 +45,12 @@ THE SOFTWARE.
 #	define RENDERDEVICE_NULL 0
 #endif
 
+// headless server builds keep the conventions (clip space, shader targets, default resources)
+// of the platform's device above, but create the null device instead of the real one.
+#if __GENESIS_SERVER__
+#	define RENDERDEVICE_HEADLESS 1
+#else
+#	define RENDERDEVICE_HEADLESS 0
+#endif
+
 #endif// RENDERDEVICECONFIG_H
\ No newline at end of file
@@ -56,6 +56,24 @@ namespace D3D9
 		}
 	}
 
+	void GPUProgramD3D9::_DetectInstancing(const DWORD* vsFunction)
+	{
+		D3DXSEMANTIC semantics[MAXD3DDECLLENGTH];
+		UINT count = 0;
+		m_instancing = false;
+		if (SUCCEEDED(D3DXGetShaderInputSemantics(vsFunction, semantics, &count)))
+		{
+			for (UINT i = 0; i < count; ++i)
+			{
+				if (D3DDECLUSAGE_TEXCOORD == semantics[i].Usage && semantics[i].UsageIndex >= (UINT)InstanceTexCoordBase)
+				{
+					m_instancing = true;
+					break;
+				}
+			}
+		}
+	}
+
 	void GPUProgramD3D9::LoadBuffers()
 	{
 		m_useHLSL = true;
@@ -71,6 +89,7 @@ namespace D3D9
 			//DXTRACE_ERR( TEXT("CompileShader"), hr );
 		}
  		hr = device->CreateVertexShader((DWORD*)pCompiledCode->GetBufferPointer(),&m_iVertexShaderD9);
+		_DetectInstancing((DWORD*)pCompiledCode->GetBufferPointer());
  		pCompiledCode->Release();
  		if (FAILED(hr))
  		{
@@ -111,6 +130,7 @@ namespace D3D9
 		}
 
 		hr = device->CreateVertexShader((DWORD*)compiled->GetBufferPointer(),&m_iVertexShaderD9);
+		_DetectInstancing((DWORD*)compiled->GetBufferPointer());
 		compiled->Release();
 		if (FAILED(hr))
 		{
@@ -47,6 +47,9 @@ namespace D3D9
 		/// if using HLSL
 		bool UseHLSL();
 	private:
+		/// mark the program as instancing when the vertex shader reads the per instance texcoords
+		void _DetectInstancing(const DWORD* vsFunction);
+
 		bool m_useHLSL;
 		IDirect3DVertexShader9* m_iVertexShaderD9;
 		IDirect3DPixelShader9* m_iPixelShaderD9;
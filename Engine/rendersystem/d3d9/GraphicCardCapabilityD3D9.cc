@@ -53,6 +53,8 @@ void GraphicCardCapability::DetectGraphicCardCapsD3D9()
 
 	mMaxTextureWidth = d3dCaps.MaxTextureWidth;
 	mMaxTextureHeight = d3dCaps.MaxTextureHeight;
+	// stream frequency instancing is guaranteed from vs_3_0 on
+	mHardwareInstancing = d3dCaps.VertexShaderVersion >= D3DVS_VERSION(3, 0);
 }
 #endif
 
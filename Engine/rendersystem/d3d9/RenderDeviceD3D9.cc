@@ -1098,10 +1098,32 @@ namespace D3D9
 	/**
 	*/
 	void
-		RenderDeviceD3D9::DrawIndexedInstanced(SizeT numInstances)
+		RenderDeviceD3D9::DrawIndexedInstanced(SizeT startVertice, SizeT numVertice, SizeT startIndice, SizeT numIndice, SizeT numInstances)
 	{
-		//n_assert(this->inBeginPass);
-		// override in subclass!
+		n_assert(m_primitiveGroupD9 && m_primitiveGroupD9->GetNumIndices() > 0);
+		n_assert(streamVertexBuffers[InstanceStreamIndex]);
+		n_assert(numInstances > 0);
+
+		const VertexLayoutD3D9* pVL = _Convert<VertexLayout, VertexLayoutD3D9>(m_primitiveGroupD9->GetVertexBuffer()->GetVertexLayout());
+		HRESULT hr = m_iDevice9->SetVertexDeclaration(pVL->GetD3D9InstancedDeclaration());
+		n_assert(SUCCEEDED(hr));
+		SetStreamSourceFreq(0, D3DSTREAMSOURCE_INDEXEDDATA | numInstances);
+		SetStreamSourceFreq(InstanceStreamIndex, D3DSTREAMSOURCE_INSTANCEDATA | 1);
+
+		D3DPRIMITIVETYPE d3dPrimType = D3D9Types::AsD3D9PrimitiveType(m_primitiveGroupD9->GetPrimitiveTopology());
+		SizeT numTris = m_primitiveGroupD9->NumberOfPrimitives(m_primitiveGroupD9->GetPrimitiveTopology(), numIndice);
+		hr = m_iDevice9->DrawIndexedPrimitive(d3dPrimType, 0, startVertice, numVertice, startIndice, numTris);
+		n_assert(SUCCEEDED(hr));
+
+		// back to non instanced drawing, the cached primitive group keeps its own declaration
+		SetStreamSourceFreq(0, 1);
+		SetStreamSourceFreq(InstanceStreamIndex, 1);
+		hr = m_iDevice9->SetVertexDeclaration(pVL->GetD3D9VertexDeclaration());
+		n_assert(SUCCEEDED(hr));
+
+		PROFILER_ADDDEVICESTATEVAL( tris, numTris * numInstances );
+		PROFILER_ADDDEVICESTATEVAL( calls, 1 );
+		PROFILER_ADDDEVICESTATEVAL( verts, numVertice * numInstances );
 	}
 
 	GPtr<PrimitiveGroup> RenderDeviceD3D9::CreatePrimitiveGroup(const VertexBufferData* vbd, const IndexBufferData* ibd)
@@ -125,7 +125,7 @@ namespace D3D9
 		/// draw current primitive
 		virtual void Draw(SizeT startVertice,SizeT numVertice,SizeT startIndice,SizeT numIndice);
 		/// draw indexed, instanced primitives
-		virtual void DrawIndexedInstanced(SizeT numInstances);
+		virtual void DrawIndexedInstanced(SizeT startVertice, SizeT numVertice, SizeT startIndice, SizeT numIndice, SizeT numInstances);
 		/// end current frame
 		virtual void EndFrame();
 		/// check if inside BeginFrame
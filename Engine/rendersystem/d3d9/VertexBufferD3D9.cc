@@ -47,11 +47,21 @@ namespace D3D9
 	void VertexBufferD3D9::UpdateData(const RenderBase::DataStream& stream)
 	{
 		n_assert(stream.data);
-		n_assert(vertexDataSize >= stream.sizeInByte);
+		n_assert(vertexDataSize >= stream.offsetInByte + stream.sizeInByte);
 		if (m_d3d9VertexBuffer)
 		{
 			void* dstPtr = 0;
-			HRESULT hr = GetD3D9VertexBuffer()->Lock(0, 0, &dstPtr, RenderResource::UsageDynamic == GetUsage() ? D3DLOCK_DISCARD : 0);//D3DLOCK_NOSYSLOCKHasCpuBuffer()? D3DLOCK_DISCARD : 
+			HRESULT hr;
+			if (stream.offsetInByte > 0)
+			{
+				// the range was not used since the last discard, the gpu can keep reading the rest
+				n_assert(RenderResource::UsageDynamic == GetUsage());
+				hr = GetD3D9VertexBuffer()->Lock(stream.offsetInByte, stream.sizeInByte, &dstPtr, D3DLOCK_NOOVERWRITE);
+			}
+			else
+			{
+				hr = GetD3D9VertexBuffer()->Lock(0, 0, &dstPtr, RenderResource::UsageDynamic == GetUsage() ? D3DLOCK_DISCARD : 0);//D3DLOCK_NOSYSLOCKHasCpuBuffer()? D3DLOCK_DISCARD : 
+			}
 			n_assert(SUCCEEDED(hr));
 			n_assert(0 != dstPtr);
 			Memory::CopyToGraphicsMemory(stream.data, dstPtr, stream.sizeInByte);
@@ -35,7 +35,7 @@ namespace D3D9
 {
 	using namespace RenderBase;
 	__ImplementClass(VertexLayoutD3D9,'IDD9',RenderBase::VertexLayout)
-		VertexLayoutD3D9::VertexLayoutD3D9():d3d9VertexDeclaration(NULL)
+		VertexLayoutD3D9::VertexLayoutD3D9():d3d9VertexDeclaration(NULL), d3d9InstancedDeclaration(NULL)
 	{
 
 	}
@@ -47,6 +47,11 @@ namespace D3D9
 			d3d9VertexDeclaration->Release();
 			d3d9VertexDeclaration = NULL;
 		}
+		if ( d3d9InstancedDeclaration )
+		{
+			d3d9InstancedDeclaration->Release();
+			d3d9InstancedDeclaration = NULL;
+		}
 	}
 
 	void VertexLayoutD3D9::GenerateDeclarationD3D9()
@@ -54,15 +59,34 @@ namespace D3D9
 		n_assert(GetVertexComponents().Size() > 0);
 
 		components = GetVertexComponents();
+		SetD3D9VertexDeclaration(_CreateDeclaration(this->components));
+	}
+
+	IDirect3DVertexDeclaration9* VertexLayoutD3D9::GetD3D9InstancedDeclaration() const
+	{
+		if (NULL == d3d9InstancedDeclaration)
+		{
+			VertexComponents comps = this->components;
+			for (IndexT i = 0; i < InstanceVectorCount; ++i)
+			{
+				comps.Append(VertexComponent(VertexComponent::TexCoord, InstanceTexCoordBase + i, VertexComponent::Float4, InstanceStreamIndex));
+			}
+			d3d9InstancedDeclaration = _CreateDeclaration(comps);
+		}
+		return d3d9InstancedDeclaration;
+	}
+
+	IDirect3DVertexDeclaration9* VertexLayoutD3D9::_CreateDeclaration(const VertexComponents& comps)
+	{
 		// create a D3D9 vertex declaration object
 		const SizeT maxElements = 32;
-		n_assert(this->components.Size() < maxElements);
+		n_assert(comps.Size() < maxElements);
 		D3DVERTEXELEMENT9 decl[maxElements] = { 0 };
 		IndexT curOffset[RenderBase::MaxNumVertexStreams] = { 0 };
 		IndexT compIndex;
-		for (compIndex = 0; compIndex < this->components.Size(); compIndex++)
+		for (compIndex = 0; compIndex < comps.Size(); compIndex++)
 		{
-			const VertexComponent& component = this->components[compIndex];
+			const VertexComponent& component = comps[compIndex];
 			WORD streamIndex = (WORD) component.GetStreamIndex();
 			n_assert(streamIndex < RenderBase::MaxNumVertexStreams);
 			decl[compIndex].Stream = streamIndex;
@@ -81,7 +105,7 @@ namespace D3D9
 		HRESULT hr = device->CreateVertexDeclaration(decl, &d3d9VertexDeclaration);
 		n_assert(SUCCEEDED(hr));
 		n_assert(0 != d3d9VertexDeclaration);
-		SetD3D9VertexDeclaration(d3d9VertexDeclaration);
+		return d3d9VertexDeclaration;
 	}
 }
 #endif
\ No newline at end of file
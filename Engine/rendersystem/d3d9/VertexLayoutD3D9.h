@@ -45,8 +45,13 @@ namespace D3D9
 		void SetVertexByteSize(SizeT vbs);
 
 		void GenerateDeclarationD3D9();
+		/// declaration with the per instance vectors of RenderBase::InstanceStreamIndex appended, created on first use
+		IDirect3DVertexDeclaration9* GetD3D9InstancedDeclaration() const;
 	private:
+		static IDirect3DVertexDeclaration9* _CreateDeclaration(const Util::Array<RenderBase::VertexComponent>& comps);
+
 		IDirect3DVertexDeclaration9* d3d9VertexDeclaration;
+		mutable IDirect3DVertexDeclaration9* d3d9InstancedDeclaration;
 	};
 
 	//------------------------------------------------------------------------------
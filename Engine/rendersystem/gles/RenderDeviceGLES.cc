@@ -787,9 +787,10 @@ const GPtr<MultipleRenderTarget> RenderDeviceGLES::CreateMultipleRenderTarget(co
 	return NULL;
 }
 
-void RenderDeviceGLES::DrawIndexedInstanced(SizeT numInstances)
+void RenderDeviceGLES::DrawIndexedInstanced(SizeT startVertice, SizeT numVertice, SizeT startIndice, SizeT numIndice, SizeT numInstances)
 {
-
+	// the capability is off on this device, the instance batcher keeps single draws
+	n_error("RenderDeviceGLES::DrawIndexedInstanced: hardware instancing is not supported!");
 }
 
 void RenderDeviceGLES::FXSetClipPlane(const int &index, const Math::float4 &plane)
@@ -115,7 +115,7 @@ public:
 	/// draw current primitives
 	virtual void Draw(SizeT startVertice,SizeT numVertice,SizeT startIndice,SizeT numIndice);
 	/// draw indexed, instanced primitives
-	virtual void DrawIndexedInstanced(SizeT numInstances);
+	virtual void DrawIndexedInstanced(SizeT startVertice, SizeT numVertice, SizeT startIndice, SizeT numIndice, SizeT numInstances);
 	/// end current frame
 	virtual void EndFrame();
 	/// present the rendered scene
@@ -131,7 +131,7 @@ void VertexBufferObjectGLES::BindingVertexLayout(const GPUProgramGLES* pGlesProg
 void VertexBufferObjectGLES::UpdateData(const RenderBase::DataStream& stream)
 {
 	n_assert(stream.data);
-	n_assert(vertexDataSize >= stream.sizeInByte);
+	n_assert(vertexDataSize >= stream.offsetInByte + stream.sizeInByte);
 	GLenum usagegl = GLESTypes::AsGLESUsage(usage);
 	if (!m_VBObejectGLES)
 	{
@@ -139,11 +139,24 @@ void VertexBufferObjectGLES::UpdateData(const RenderBase::DataStream& stream)
 	}
 	GLESImpl::Instance()->ActiveVertexBufferObject(m_VBObejectGLES);
 
-	glBufferData(GL_ARRAY_BUFFER,
-		stream.sizeInByte,
-		stream.data,
-		usagegl
-		);
+	if (stream.offsetInByte > 0)
+	{
+		glBufferSubData(GL_ARRAY_BUFFER, stream.offsetInByte, stream.sizeInByte, stream.data);
+	}
+	else if (stream.sizeInByte < vertexDataSize && RenderBase::BufferData::Dynamic == usage)
+	{
+		// keep the full size, later appends write behind this range
+		glBufferData(GL_ARRAY_BUFFER, vertexDataSize, NULL, usagegl);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, stream.sizeInByte, stream.data);
+	}
+	else
+	{
+		glBufferData(GL_ARRAY_BUFFER,
+			stream.sizeInByte,
+			stream.data,
+			usagegl
+			);
+	}
 	GLESImpl::Instance()->CheckError();
 }
 
@@ -21,26 +21,19 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 ****************************************************************************/
-#if __WIN32__
 #include "stdneb.h"
-#include "d3d9/D3D9Types.h"
-#include "d3d9/RenderTargetD3D9.h"
 #include "null/RenderDeviceNull.h"
 
 namespace NullDevice
 {
 	using namespace RenderBase;
 
-	using namespace D3D9;
-
-	typedef IDirect3D9* (WINAPI* Direct3DCreate9Func)(UINT);
-
 	__ImplementClass(RenderTargetNull, 'RDTN', RenderTarget);
 
 	__ImplementClass(RenderDeviceNull, 'RDVN', RenderDevice);
 	__ImplementThreadSingleton(RenderDeviceNull);
 
-	NullWindow::NullWindow( RenderDeviceNull*  device, HWND winHandle)
+	NullWindow::NullWindow( RenderDeviceNull*  device, WindHandle winHandle)
 		: RenderWindow( winHandle )
 	{
 	}
@@ -71,123 +64,19 @@ namespace NullDevice
 		this->resolveTexture->Setup();
 	}
 	//------------------------------------------------------------------------
-	RenderDeviceNull::RenderDeviceNull():
-	m_iD3D9( NULL ),
-		m_iDevice9( NULL ),
-		m_iBackBufferSurface9( NULL ),
-		m_iCurrentSwapChain( NULL ),
-		m_hMainWindow( NULL ),
-		m_hHiddenWindow( NULL ),
-		m_instD3D9Dll( NULL ),
-		m_bWindowed( true ),
-		m_bDeviceLost( false ),
-		m_bNeedReset( false ),
-		m_adapterCount( D3DADAPTER_DEFAULT ),
-		m_displayFormat( D3DFMT_X8R8G8B8 ),
-		m_deviceType(D3DDEVTYPE_HAL)
+	RenderDeviceNull::RenderDeviceNull()
+		: m_hMainWindow( NULL )
 	{
 		__ConstructThreadSingleton;
-
-		m_defaultDisplayPresentParams.BackBufferCount = 1;
-		m_defaultDisplayPresentParams.Windowed = m_bWindowed;
-		m_defaultDisplayPresentParams.BackBufferFormat = m_displayFormat;
-		m_defaultDisplayPresentParams.BackBufferWidth = 1024;
-		m_defaultDisplayPresentParams.BackBufferHeight = 768;
-		m_defaultDisplayPresentParams.EnableAutoDepthStencil = FALSE;
-		m_defaultDisplayPresentParams.AutoDepthStencilFormat = D3DFMT_D24S8;
-		m_defaultDisplayPresentParams.PresentationInterval = D3DPRESENT_INTERVAL_IMMEDIATE;
-		m_defaultDisplayPresentParams.SwapEffect = D3DSWAPEFFECT_DISCARD;
-		m_defaultDisplayPresentParams.hDeviceWindow = (HWND)m_hMainWindow;
-		m_defaultDisplayPresentParams.FullScreen_RefreshRateInHz = D3DPRESENT_RATE_DEFAULT;
-		m_defaultDisplayPresentParams.MultiSampleType = D3DMULTISAMPLE_NONE;
-		m_defaultDisplayPresentParams.MultiSampleQuality = 0;
-		m_defaultDisplayPresentParams.Flags = 0;
-
-		m_deviceBehaviourFlags = D3DCREATE_FPU_PRESERVE | D3DCREATE_HARDWARE_VERTEXPROCESSING;
 	}
 	//------------------------------------------------------------------------
 	RenderDeviceNull::~RenderDeviceNull()
 	{
 		__DestructThreadSingleton;
 	}
-	//------------------------------------------------------------------------
-	bool RenderDeviceNull::CreateD3DObjectAndHiddenWindow()
-	{
-
-		m_instD3D9Dll = LoadLibrary( "d3d9.dll" );
-
-		if (!m_instD3D9Dll)
-		{
-			n_error("RenderDeviceD3D9::CreateD3DObjectAndHiddenWindow: No D3D9Runtime Installed\n");
-			m_instD3D9Dll = NULL;
-			return false;
-		}
-
-		Direct3DCreate9Func d3dcreateFunc = (Direct3DCreate9Func)GetProcAddress( m_instD3D9Dll, "Direct3DCreate9");
-
-		if( !d3dcreateFunc )
-		{
-			n_error( "RenderDeviceD3D9::CreateD3DObjectAndHiddenWindow: Direct3DCreate9 Not Found\n" );
-			FreeLibrary( m_instD3D9Dll );
-			m_instD3D9Dll = NULL;
-			return false;
-		}
-
-		m_iD3D9 = d3dcreateFunc( D3D_SDK_VERSION );
-		if ( !m_iD3D9 )
-		{
-			n_error("RenderDeviceD3D9::CreateD3DObjectAndHiddenWindow: D3D9 Version Is Not Correct");
-			m_iD3D9 = NULL;
-			return false;
-		}
-
-		//Create Hidden Window
-		m_hHiddenWindow = CreateWindowW(
-			L"STATIC",
-			L"GenesisHiddenWindow",
-			WS_OVERLAPPEDWINDOW | WS_CLIPSIBLINGS |	WS_CLIPCHILDREN,
-			0, 0, 1, 1,
-			NULL, NULL,
-			GetModuleHandle(0), NULL );
-		if( !m_hHiddenWindow )
-		{
-			n_error("RenderDeviceD3D9::CreateD3DObjectAndHiddenWindow: Create Hidden Window Failed!");
-			return false;
-		}
-
-		return true;
-
-	}
-	//------------------------------------------------------------------------
-	void RenderDeviceNull::SetupDisplayParams()
-	{
-		// backbuffer ĸʽʹСϲ
-		m_defaultDisplayPresentParams.hDeviceWindow = m_hHiddenWindow;
-		m_defaultDisplayPresentParams.BackBufferFormat = D3D9::D3D9Types::AsD3D9PixelFormat(RenderBase::PixelFormat::X8R8G8B8);
-		m_defaultDisplayPresentParams.BackBufferHeight = 800;
-		m_defaultDisplayPresentParams.BackBufferWidth = 600;
-	}
 	//----------------------------------------------------------------------
 	bool RenderDeviceNull::InitDevice()
 	{
-		if(!CreateD3DObjectAndHiddenWindow())
-			return false;
-
-		SetupDisplayParams();
-
-		HRESULT hr = m_iD3D9->CreateDevice(m_adapterCount,
-			D3DDEVTYPE_HAL,
-			m_hHiddenWindow,
-			m_deviceBehaviourFlags,
-			&m_defaultDisplayPresentParams,
-			&m_iDevice9
-			);
-
-		if (FAILED(hr))
-		{
-			n_error("Failed to create Direct3D device object: %s!\n", DXGetErrorString9(hr));
-			return false;
-		}
 		return true;
 	}
 	//------------------------------------------------------------------------
@@ -214,6 +103,7 @@ namespace NullDevice
 	void RenderDeviceNull::DetectGraphicCardCaps()
 	{
 		//m_graphicCardCaps.DetectGraphicCardCapsD3D9();
+		m_graphicCardCaps.mHardwareInstancing = true;
 	}
 	//------------------------------------------------------------------------
 	const GraphicCardCapability& RenderDeviceNull::GetGraphicCardCapability()
@@ -233,7 +123,10 @@ namespace NullDevice
 	//------------------------------------------------------------------------
 	const GPtr<GPUProgram> RenderDeviceNull::CreateRenderGPUProgram(const GPtr<GPUProgram>& srcGPUProgram)
 	{
-		return GPUProgram::Create();
+		GPtr<GPUProgram> program = GPUProgram::Create();
+		// nothing is drawn, so every program may take the instanced path
+		program->SetInstancing(true);
+		return program;
 	}
 	//------------------------------------------------------------------------
 	const GPtr<RenderStateDesc> RenderDeviceNull::CreateRenderState(const GPtr<RenderStateDesc>& state)
@@ -330,40 +223,6 @@ namespace NullDevice
 	//------------------------------------------------------------------------
 	bool RenderDeviceNull::BeginFrame()
 	{
-		HRESULT hr;
-		if (m_bDeviceLost)
-		{
-			SetupDisplayParams();
-			Sleep(100);
-			bool bRealDeviceLost = false;
-			while ( FAILED(hr = m_iDevice9->TestCooperativeLevel()))
-			{
-				if (hr == D3DERR_DEVICELOST)
-				{
-					bRealDeviceLost = true;
-					Sleep(100);
-					continue;
-				}
-
-				if (hr == D3DERR_DEVICENOTRESET)
-				{
-					bRealDeviceLost = true;
-					//if(!_OnDeviceLost())
-					{
-						continue;
-					}
-				}
-
-			}
-			if (false == bRealDeviceLost)
-			{
-				//_OnDeviceLost();
-			}
-			m_bDeviceLost = false;
-		}
-		this->m_iDevice9->Clear( 0, NULL, D3DCLEAR_TARGET, D3DCOLOR_XRGB(0,0,255), 1.0f, 0 );
-		hr = this->m_iDevice9->BeginScene();
-		n_assert(SUCCEEDED(hr));
 		return true;
 	}
 	//------------------------------------------------------------------------
@@ -398,36 +257,19 @@ namespace NullDevice
 		return;
 	}
 	//------------------------------------------------------------------------
-	void RenderDeviceNull::DrawIndexedInstanced(SizeT numInstances)
+	void RenderDeviceNull::DrawIndexedInstanced(SizeT startVertice, SizeT numVertice, SizeT startIndice, SizeT numIndice, SizeT numInstances)
 	{
 		return;
 	}
 	//------------------------------------------------------------------------
 	void RenderDeviceNull::EndFrame()
 	{
-		HRESULT hr = this->m_iDevice9->EndScene();
-		n_assert(SUCCEEDED(hr));
-
-		for (SizeT i = 0; i < 8; ++i)
-		{
-			hr = m_iDevice9->SetTexture(i,NULL);
-			n_assert(SUCCEEDED(hr))
-		}
-
-		for (DWORD i = D3DVERTEXTEXTURESAMPLER0; i <= D3DVERTEXTEXTURESAMPLER3; ++i)
-		{
-			hr = m_iDevice9->SetTexture(i,NULL);
-			n_assert(SUCCEEDED(hr))
-		}
-
+		return;
 	}
 	//------------------------------------------------------------------------
 	void RenderDeviceNull::Present(WindHandle hwnd ) 
 	{
-		if (!hwnd)		
-			hwnd = m_hMainWindow;
-
-		m_iDevice9->Present(NULL,NULL,(HWND)hwnd,NULL);
+		return;
 	}
 	//------------------------------------------------------------------------
 	/// set viewport
@@ -443,7 +285,12 @@ namespace NullDevice
 
 	RenderWindow* RenderDeviceNull::CreateViewPortWnd( WindHandle hWnd )
 	{
-		return new NullWindow( this, (HWND)hWnd );
+		return n_new(NullWindow( this, hWnd ));
+	}
+	//------------------------------------------------------------------------
+	void RenderDeviceNull::DestroyViewPortWnd( NullWindow* view )
+	{
+		n_delete(view);
 	}
 
 	bool RenderDeviceNull::OnDeviceLost()
@@ -451,5 +298,3 @@ namespace NullDevice
 		return true;
 	}
 }
-
-#endif
\ No newline at end of file
@@ -37,6 +37,13 @@ namespace NullDevice
 {
 	using namespace RenderBase;
 
+	class NullWindow;
+
+	/**
+		A render device which never touches a graphics api. Every resource it
+		creates is an empty placeholder and every draw call is dropped, so the
+		engine can run headless (dedicated servers, automated benchmarks).
+	*/
 	class RenderDeviceNull : public RenderDevice
 	{
 		__DeclareSubClass(RenderDeviceNull,RenderDevice);
@@ -144,7 +151,7 @@ namespace NullDevice
 		virtual void Draw(SizeT startVertice,SizeT endVertice,SizeT startIndice,SizeT endIndice);
 
 		/// draw indexed, instanced primitives
-		virtual void DrawIndexedInstanced(SizeT numInstances);
+		virtual void DrawIndexedInstanced(SizeT startVertice, SizeT numVertice, SizeT startIndice, SizeT numIndice, SizeT numInstances);
 
 		/// end current frame
 		virtual void EndFrame();
@@ -166,35 +173,17 @@ namespace NullDevice
 		{
 			return true;
 		}
-		///
-		bool CreateD3DObjectAndHiddenWindow();
-		///
-		void SetupDisplayParams();
 
 		void SetMainWindowHandle(WindHandle hwnd);
 
 		RenderWindow* CreateViewPortWnd( WindHandle hWnd );
 
+		void DestroyViewPortWnd( NullWindow* view );
+
 	protected:
 		GraphicCardCapability m_graphicCardCaps;
 
-		IDirect3D9*				m_iD3D9;
-		IDirect3DDevice9*		m_iDevice9;
-		IDirect3DSurface9*		m_iBackBufferSurface9;
-		IDirect3DSwapChain9*    m_iCurrentSwapChain;
 		WindHandle				m_hMainWindow;
-		HWND					m_hHiddenWindow;
-		HINSTANCE				m_instD3D9Dll;
-		D3DPRESENT_PARAMETERS	m_defaultDisplayPresentParams;
-		D3DFORMAT				m_displayFormat;
-		D3DDEVTYPE				m_deviceType;
-		DWORD					m_deviceBehaviourFlags;
-		bool					m_bWindowed;
-		bool					m_bDeviceLost;
-		bool					m_bNeedReset;
-		D3DDISPLAYMODE 			m_lastWindowedMode;
-
-		DWORD					m_adapterCount;
 	};
 
 	inline void RenderDeviceNull::SetMainWindowHandle(WindHandle hwnd)
@@ -220,7 +209,7 @@ namespace NullDevice
 	class NullWindow : public RenderWindow
 	{
 	public:
-		NullWindow( RenderDeviceNull* device, HWND winHandle);
+		NullWindow( RenderDeviceNull* device, WindHandle winHandle);
 		virtual ~NullWindow();
 		virtual void		BeginRender();
 		virtual void		EndRender();
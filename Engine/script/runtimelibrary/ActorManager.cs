@@ -151,5 +151,24 @@ namespace ScriptRuntime
                 return ICall_ActorManager_GetMainCameraActor();
             }
         }
+        /// <summary>
+        /// 一次获取多个Actor的世界坐标和世界旋转,结果写入预先分配的数组,不产生托管内存分配.
+        /// </summary>
+        /// <param name="actors">要查询的Actor,为null的元素会被跳过.</param>
+        /// <param name="outPositions">输出的世界坐标,长度不能小于actors.</param>
+        /// <param name="outRotations">输出的世界旋转,长度不能小于actors.</param>
+        static public void GetWorldTransforms(Actor[] actors, Vector3[] outPositions, Quaternion[] outRotations)
+        {
+            ICall_ActorManager_GetWorldTransforms(actors, outPositions, outRotations);
+        }
+        /// <summary>
+        /// 一次设置多个Actor的世界坐标.
+        /// </summary>
+        /// <param name="actors">要设置的Actor,为null的元素会被跳过.</param>
+        /// <param name="positions">新的世界坐标,长度不能小于actors.</param>
+        static public void SetWorldPositions(Actor[] actors, Vector3[] positions)
+        {
+            ICall_ActorManager_SetWorldPositions(actors, positions);
+        }
     }
 }
@@ -56,5 +56,11 @@ namespace ScriptRuntime
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
         extern private static Actor ICall_ActorManager_GetMainCameraActor();
 
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        extern private static void ICall_ActorManager_GetWorldTransforms(Actor[] actors, Vector3[] outPositions, Quaternion[] outRotations);
+
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        extern private static void ICall_ActorManager_SetWorldPositions(Actor[] actors, Vector3[] positions);
+
     }
 } 
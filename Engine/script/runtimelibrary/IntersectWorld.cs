@@ -142,6 +142,31 @@ namespace ScriptRuntime
             ICall_IntersectWorld_Triangle(ref ray, mark.MarkAsUINT, out outPoint1, out outPoint2, out outPoint3);
         }
 
+        /// <summary>
+        /// һμ,ȡÿߴеĵһ,дԤȷ.
+        /// </summary>
+        /// <param name="rays">Ҫ</param>
+        /// <param name="mark">ActorĹ˲</param>
+        /// <param name="outPoints">ÿߵĽ,ȲСrays</param>
+        /// <param name="outHits">ÿǷ,ȲСrays</param>
+        /// <returns>еĿ</returns>
+        static public int IntersectWorld_Points(Ray[] rays, LayerMark mark, Vector3[] outPoints, bool[] outHits)
+        {
+            return ICall_IntersectWorld_Points(rays, mark.MarkAsUINT, outPoints, outHits);
+        }
+
+        /// <summary>
+        /// һμ,ȡÿߴеĵһActor,ûеԪΪnull.
+        /// </summary>
+        /// <param name="rays">Ҫ</param>
+        /// <param name="mark">ActorĹ˲</param>
+        /// <param name="outActors">ÿߴеActor,ȲСrays</param>
+        /// <returns>еĿ</returns>
+        static public int IntersectWorld_Actors(Ray[] rays, LayerMark mark, Actor[] outActors)
+        {
+            return ICall_IntersectWorld_Actors(rays, mark.MarkAsUINT, outActors);
+        }
+
         // - internal call declare
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
         extern private static void ICall_IntersectWorld_ComputeRay(ref Vector2 screenPos, out Ray outRay);
@@ -157,5 +182,11 @@ namespace ScriptRuntime
 
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
         extern private static void ICall_IntersectWorld_Triangle(ref Ray ray, uint selectMark, out Vector3 outPoint1, out Vector3 outPoint2, out Vector3 outPoint3);
+
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        extern private static int ICall_IntersectWorld_Points(Ray[] rays, uint selectMark, Vector3[] outPoints, bool[] outHits);
+
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        extern private static int ICall_IntersectWorld_Actors(Ray[] rays, uint selectMark, Actor[] outActors);
     }
 }
@@ -0,0 +1,5 @@
+//------------------------------------------------------------------------------
+//  stdneb.cc
+//  (C) 2007 Radon Labs GmbH
+//------------------------------------------------------------------------------
+#include "stdneb.h"
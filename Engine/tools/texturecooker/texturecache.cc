@@ -0,0 +1,134 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "stdneb.h"
+#include "tools/texturecooker/texturecache.h"
+#include "io/filestream.h"
+#include "io/textreader.h"
+#include "io/textwriter.h"
+
+namespace Tools
+{
+	//------------------------------------------------------------------------------
+	TextureCache::TextureCache()
+	{
+
+	}
+	//------------------------------------------------------------------------------
+	void 
+		TextureCache::Load(const IO::URI& uri)
+	{
+		mEntries.Clear();
+
+		GPtr<IO::FileStream> stream = IO::FileStream::Create();
+		stream->SetURI(uri);
+		stream->SetAccessMode(IO::Stream::ReadAccess);
+		if (!stream->Open())
+		{
+			return;
+		}
+
+		// one "<hash> <source>" pair per line, the source may contain blanks so only the first one splits
+		GPtr<IO::TextReader> reader = IO::TextReader::Create();
+		reader->SetStream(stream.upcast<IO::Stream>());
+		if (reader->Open())
+		{
+			Util::Array<Util::String> lines = reader->ReadAllLines();
+			for (IndexT i = 0; i < lines.Size(); ++i)
+			{
+				const Util::String& line = lines[i];
+				IndexT sep = line.FindCharIndex(' ');
+				if (sep == InvalidIndex || sep + 1 >= line.Length())
+				{
+					continue;
+				}
+				Util::String source = line.ExtractRange(sep + 1, line.Length() - sep - 1);
+				source.TrimRight("\r\n");
+				uint hash = (uint)strtoul(line.ExtractRange(0, sep).AsCharPtr(), NULL, 16);
+				if (!mEntries.Contains(source))
+				{
+					mEntries.Add(source, hash);
+				}
+			}
+			reader->Close();
+		}
+		stream->Close();
+	}
+	//------------------------------------------------------------------------------
+	bool 
+		TextureCache::Save(const IO::URI& uri) const
+	{
+		GPtr<IO::FileStream> stream = IO::FileStream::Create();
+		stream->SetURI(uri);
+		stream->SetAccessMode(IO::Stream::WriteAccess);
+		if (!stream->Open())
+		{
+			n_warning("TextureCache::Save: can not write '%s'\n", uri.LocalPath().AsCharPtr());
+			return false;
+		}
+
+		GPtr<IO::TextWriter> writer = IO::TextWriter::Create();
+		writer->SetStream(stream.upcast<IO::Stream>());
+		if (writer->Open())
+		{
+			for (IndexT i = 0; i < mEntries.Size(); ++i)
+			{
+				writer->WriteFormatted("%08x %s\n", mEntries.ValueAtIndex(i), mEntries.KeyAtIndex(i).AsCharPtr());
+			}
+			writer->Close();
+		}
+		stream->Close();
+		return true;
+	}
+	//------------------------------------------------------------------------------
+	bool 
+		TextureCache::IsUpToDate(const Util::String& source, uint hash) const
+	{
+		IndexT found = mEntries.FindIndex(source);
+		return (found != InvalidIndex) && (mEntries.ValueAtIndex(found) == hash);
+	}
+	//------------------------------------------------------------------------------
+	void 
+		TextureCache::Update(const Util::String& source, uint hash)
+	{
+		IndexT found = mEntries.FindIndex(source);
+		if (found == InvalidIndex)
+		{
+			mEntries.Add(source, hash);
+		}
+		else
+		{
+			mEntries.ValueAtIndex(found) = hash;
+		}
+	}
+	//------------------------------------------------------------------------------
+	void 
+		TextureCache::Remove(const Util::String& source)
+	{
+		IndexT found = mEntries.FindIndex(source);
+		if (found != InvalidIndex)
+		{
+			mEntries.EraseAtIndex(found);
+		}
+	}
+}
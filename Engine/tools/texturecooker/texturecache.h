@@ -0,0 +1,71 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __texturecache_H__
+#define __texturecache_H__
+#include "util/string.h"
+#include "util/dictionary.h"
+#include "io/uri.h"
+
+namespace Tools
+{
+	// remembers the content hash of every cooked source, so unchanged inputs are skipped on the next run.
+	// the key combines the source bytes and the cook options, changing either one cooks again.
+	// loaded and saved on the main thread, the cooker threads only read it while they run
+	class TextureCache
+	{
+	public:
+		TextureCache();
+
+		/// load the cache file, a missing or broken file just means everything is cooked
+		void Load(const IO::URI& uri);
+
+		/// save the cache file
+		bool Save(const IO::URI& uri) const;
+
+		/// return true if the source was cooked with this hash before
+		bool IsUpToDate(const Util::String& source, uint hash) const;
+
+		/// remember the hash of a cooked source
+		void Update(const Util::String& source, uint hash);
+
+		/// forget a source, used when cooking it failed
+		void Remove(const Util::String& source);
+
+		/// number of entries
+		SizeT GetNumEntries() const;
+
+	private:
+		Util::Dictionary<Util::String, uint> mEntries;
+	};
+
+	//------------------------------------------------------------------------------
+	inline
+		SizeT 
+		TextureCache::GetNumEntries() const
+	{
+		return mEntries.Size();
+	}
+}
+
+#endif // __texturecache_H__
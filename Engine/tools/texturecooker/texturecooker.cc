@@ -0,0 +1,442 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "stdneb.h"
+#include "tools/texturecooker/texturecooker.h"
+#include "io/filestream.h"
+#include "io/fswrapper.h"
+#include "threading/interlocked.h"
+#include "system/systeminfo.h"
+#include "timing/timer.h"
+#include "util/crc.h"
+
+// must define FREEIMAGE_LIB when use FreeImage as static lib
+#define FREEIMAGE_LIB
+#include <FreeImage/FreeImage.h>
+
+namespace Tools
+{
+	// bump when the encoder output changes, every cached hash becomes stale
+	static const int s_CookerVersion = 1;
+
+	//------------------------------------------------------------------------------
+	static void 
+		_FreeImageErrorHandler(FREE_IMAGE_FORMAT fif, const char* message)
+	{
+		const char* typeName = (fif != FIF_UNKNOWN) ? FreeImage_GetFormatFromFIF(fif) : "Unknown";
+		n_printf("TextureCooker: FreeImage error '%s' when loading format %s\n", message, typeName);
+	}
+	//------------------------------------------------------------------------------
+	TextureCooker::TextureCooker()
+		: mFormatMode(AutoFormat)
+		, mSrgb(true)
+		, mMips(true)
+		, mForce(false)
+		, mNumThreads(1)
+		, mNextItem(0)
+		, mNumFinished(0)
+	{
+
+	}
+	//------------------------------------------------------------------------------
+	TextureCooker::~TextureCooker()
+	{
+		n_assert(mThreads.IsEmpty());
+	}
+	//------------------------------------------------------------------------------
+	bool 
+		TextureCooker::Open()
+	{
+		if (!Application::Open())
+		{
+			return false;
+		}
+
+		if (this->args.GetBoolFlag("-help") || !this->args.HasArg("-in"))
+		{
+			n_printf("Genesis Texture Cooker.\n"
+				"Cooks source images into DXT1/DXT5 dds files with mip maps,\n"
+				"or into ETC1 pkm files for GLES targets.\n"
+				"  -in <dir>          source directory, searched recursively\n"
+				"  -out <dir>         output directory (default: the source directory)\n"
+				"  -format <fmt>      auto, dxt1, dxt5 or etc1 (default: auto)\n"
+				"                     etc1 writes .pkm files without mips and alpha\n"
+				"  -linear            filter mips in linear space, for normal and data maps\n"
+				"  -nomips            only write the top level\n"
+				"  -threads <n>       number of cooker threads (default: one per core)\n"
+				"  -cache <file>      content hash cache (default: <out>/texturecooker.cache)\n"
+				"  -force             cook everything, ignore the cache\n");
+			return false;
+		}
+
+		mInputDir = this->args.GetString("-in");
+		mInputDir.ConvertBackslashes();
+		mInputDir.TrimRight("/");
+		mOutputDir = this->args.GetString("-out", mInputDir);
+		mOutputDir.ConvertBackslashes();
+		mOutputDir.TrimRight("/");
+		mCacheFile = this->args.GetString("-cache", mOutputDir + "/texturecooker.cache");
+
+		Util::String format = this->args.GetString("-format", "auto");
+		format.ToLower();
+		if (format == "dxt1")
+		{
+			mFormatMode = ForceDXT1;
+		}
+		else if (format == "dxt5")
+		{
+			mFormatMode = ForceDXT5;
+		}
+		else if (format == "etc1")
+		{
+			mFormatMode = ForceETC1;
+		}
+		else if (format == "auto")
+		{
+			mFormatMode = AutoFormat;
+		}
+		else
+		{
+			n_printf("TextureCooker: unknown format '%s'\n", format.AsCharPtr());
+			return false;
+		}
+
+		mSrgb = !this->args.GetBoolFlag("-linear");
+		mMips = !this->args.GetBoolFlag("-nomips");
+		mForce = this->args.GetBoolFlag("-force");
+
+		System::SystemInfo systemInfo;
+		mNumThreads = this->args.GetInt("-threads", systemInfo.GetNumCpuCores());
+		mNumThreads = Math::n_max(1, mNumThreads);
+
+		mExtensions.Clear();
+		mExtensions.Append("png");
+		mExtensions.Append("tga");
+		mExtensions.Append("jpg");
+		mExtensions.Append("bmp");
+		mExtensions.Append("tif");
+		mExtensions.Append("psd");
+
+		mCoreServer = Core::CoreServer::Create();
+		mCoreServer->SetCompanyName(this->GetCompanyName());
+		mCoreServer->SetAppName(this->GetAppTitle());
+		mCoreServer->Open();
+
+		mIoServer = IO::IoServer::Create();
+
+		FreeImage_Initialise(false);
+		FreeImage_SetOutputMessage(_FreeImageErrorHandler);
+		return true;
+	}
+	//------------------------------------------------------------------------------
+	void 
+		TextureCooker::Close()
+	{
+		n_assert(mThreads.IsEmpty());
+		mItems.Clear();
+
+		FreeImage_DeInitialise();
+
+		mIoServer = NULL;
+		if (mCoreServer.isvalid())
+		{
+			mCoreServer->Close();
+			mCoreServer = NULL;
+		}
+		Application::Close();
+	}
+	//------------------------------------------------------------------------------
+	void 
+		TextureCooker::Run()
+	{
+		Timing::Timer timer;
+		timer.Start();
+
+		mItems.Clear();
+		_GatherFiles(mInputDir, "");
+		if (mItems.IsEmpty())
+		{
+			n_printf("TextureCooker: no source textures found in '%s'\n", mInputDir.AsCharPtr());
+			return;
+		}
+
+		mCache.Load(IO::URI(mCacheFile));
+
+		// directories are created up front, the cooker threads only write files
+		Util::String lastDir;
+		for (IndexT i = 0; i < mItems.Size(); ++i)
+		{
+			Util::String dir = mItems[i].dstPath.ExtractDirName();
+			if (dir != lastDir)
+			{
+				mIoServer->CreateDirectory(IO::URI(dir));
+				lastDir = dir;
+			}
+		}
+
+		// the first Crc builds the shared table, do it before the threads race for it
+		Util::Crc crcTable;
+
+		mNextItem = 0;
+		mNumFinished = 0;
+		SizeT numThreads = Math::n_min(mNumThreads, mItems.Size());
+		for (IndexT i = 0; i < numThreads; ++i)
+		{
+			GPtr<TextureCookerThread> thread = TextureCookerThread::Create();
+			thread->SetName(STRING_FORMAT("TextureCooker%d", i));
+			thread->SetStackSize(1024 * 1024);
+			thread->Setup(this);
+			thread->Start();
+			mThreads.Append(thread);
+		}
+
+		int reported = 0;
+		while (mNumFinished < mItems.Size())
+		{
+			Core::SysFunc::Sleep(0.05);
+			int finished = mNumFinished;
+			if (finished / 50 != reported / 50)
+			{
+				n_printf("TextureCooker: %d/%d\n", finished, mItems.Size());
+			}
+			reported = finished;
+		}
+
+		for (IndexT i = 0; i < mThreads.Size(); ++i)
+		{
+			mThreads[i]->Stop();
+		}
+		mThreads.Clear();
+
+		SizeT numCooked = 0;
+		SizeT numSkipped = 0;
+		SizeT numFailed = 0;
+		for (IndexT i = 0; i < mItems.Size(); ++i)
+		{
+			const CookItem& item = mItems[i];
+			switch (item.result)
+			{
+			case Cooked:
+				mCache.Update(item.source, item.hash);
+				++numCooked;
+				break;
+			case Skipped:
+				++numSkipped;
+				break;
+			default:
+				mCache.Remove(item.source);
+				n_printf("TextureCooker: failed to cook '%s'\n", item.srcPath.AsCharPtr());
+				++numFailed;
+				break;
+			}
+		}
+		mCache.Save(IO::URI(mCacheFile));
+
+		timer.Stop();
+		n_printf("TextureCooker: %d cooked, %d up to date, %d failed on %d threads in %.2f s\n",
+			numCooked, numSkipped, numFailed, numThreads, (float)timer.GetTime());
+
+		this->SetReturnCode(numFailed > 0 ? 1 : 0);
+	}
+	//------------------------------------------------------------------------------
+	void 
+		TextureCooker::_GatherFiles(const Util::String& dir, const Util::String& relDir)
+	{
+		for (IndexT e = 0; e < mExtensions.Size(); ++e)
+		{
+			Util::Array<Util::String> files = mIoServer->ListFiles(IO::URI(dir), "*." + mExtensions[e]);
+			for (IndexT i = 0; i < files.Size(); ++i)
+			{
+				CookItem item;
+				item.source = relDir + files[i];
+				item.srcPath = dir + "/" + files[i];
+				Util::String dstName = files[i];
+				dstName.StripFileExtension();
+				item.dstPath = mOutputDir + "/" + relDir + dstName + (mFormatMode == ForceETC1 ? ".pkm" : ".dds");
+				mItems.Append(item);
+			}
+		}
+
+		Util::Array<Util::String> dirs = mIoServer->ListDirectories(IO::URI(dir), "*");
+		for (IndexT i = 0; i < dirs.Size(); ++i)
+		{
+			if (dirs[i].IsEmpty() || dirs[i][0] == '.')
+			{
+				continue;
+			}
+			Util::String subDir = dir + "/" + dirs[i];
+			// the output dir may live below the input dir
+			if (subDir == mOutputDir)
+			{
+				continue;
+			}
+			_GatherFiles(subDir, relDir + dirs[i] + "/");
+		}
+	}
+	//------------------------------------------------------------------------------
+	bool 
+		TextureCooker::CookNextItem()
+	{
+		int index = Threading::Interlocked::Increment(mNextItem) - 1;
+		if (index >= mItems.Size())
+		{
+			return false;
+		}
+		CookItem& item = mItems[index];
+		item.result = _Cook(item);
+		Threading::Interlocked::Increment(mNumFinished);
+		return true;
+	}
+	//------------------------------------------------------------------------------
+	uint 
+		TextureCooker::_ComputeHash(const ubyte* data, SizeT size) const
+	{
+		Util::String options;
+		options.Format("%d;%d;%d;%d", s_CookerVersion, mFormatMode, mSrgb, mMips);
+
+		Util::Crc crc;
+		crc.Begin();
+		crc.Compute(const_cast<ubyte*>(data), size);
+		crc.Compute((unsigned char*)options.AsCharPtr(), options.Length());
+		crc.End();
+		return crc.GetResult();
+	}
+	//------------------------------------------------------------------------------
+	TextureCooker::Result 
+		TextureCooker::_Cook(CookItem& item) const
+	{
+		GPtr<IO::FileStream> srcStream = IO::FileStream::Create();
+		srcStream->SetURI(IO::URI(item.srcPath));
+		srcStream->SetAccessMode(IO::Stream::ReadAccess);
+		if (!srcStream->Open())
+		{
+			return Failed;
+		}
+		SizeT size = srcStream->GetSize();
+		if (size <= 0)
+		{
+			srcStream->Close();
+			return Failed;
+		}
+		Util::FixedArray<ubyte> data(size);
+		srcStream->Read(data.Begin(), size);
+		srcStream->Close();
+
+		item.hash = _ComputeHash(data.Begin(), size);
+		if (!mForce && mCache.IsUpToDate(item.source, item.hash) && IO::FSWrapper::FileExists(item.dstPath))
+		{
+			return Skipped;
+		}
+
+		TextureEncoder::Surface surface;
+		if (!_Decode(item, data.Begin(), size, surface))
+		{
+			return Failed;
+		}
+
+		GPtr<IO::FileStream> dstStream = IO::FileStream::Create();
+		dstStream->SetURI(IO::URI(item.dstPath));
+		dstStream->SetAccessMode(IO::Stream::WriteAccess);
+
+		// pkm holds a single level, the mip chain is not built
+		if (mFormatMode == ForceETC1)
+		{
+			if (TextureEncoder::HasAlpha(surface))
+			{
+				n_printf("TextureCooker: '%s' has alpha, ETC1 drops it\n", item.srcPath.AsCharPtr());
+			}
+			if (!dstStream->Open())
+			{
+				return Failed;
+			}
+			bool ok = TextureEncoder::WritePKM(dstStream.upcast<IO::Stream>(), surface);
+			dstStream->Close();
+			return ok ? Cooked : Failed;
+		}
+
+		Util::Array<TextureEncoder::Surface> levels;
+		TextureEncoder::BuildMipChain(surface, mSrgb, mMips, levels);
+
+		TextureEncoder::Format format = TextureEncoder::DXT1;
+		if (mFormatMode == ForceDXT5 || (mFormatMode == AutoFormat && TextureEncoder::HasAlpha(surface)))
+		{
+			format = TextureEncoder::DXT5;
+		}
+
+		if (!dstStream->Open())
+		{
+			return Failed;
+		}
+		bool ok = TextureEncoder::WriteDDS(dstStream.upcast<IO::Stream>(), levels, format);
+		dstStream->Close();
+		return ok ? Cooked : Failed;
+	}
+	//------------------------------------------------------------------------------
+	bool 
+		TextureCooker::_Decode(const CookItem& item, ubyte* data, SizeT size, TextureEncoder::Surface& outSurface) const
+	{
+		FIMEMORY* fiMem = FreeImage_OpenMemory(data, static_cast<DWORD>(size));
+		if (!fiMem)
+		{
+			return false;
+		}
+
+		FREE_IMAGE_FORMAT fileType = FreeImage_GetFileTypeFromMemory(fiMem);
+		if (fileType == FIF_UNKNOWN)
+		{
+			fileType = FreeImage_GetFIFFromFilename(item.srcPath.AsCharPtr());
+		}
+		FIBITMAP* fiBitmap = (fileType != FIF_UNKNOWN) ? FreeImage_LoadFromMemory(fileType, fiMem) : NULL;
+		FreeImage_CloseMemory(fiMem);
+		if (!fiBitmap)
+		{
+			return false;
+		}
+
+		FIBITMAP* rgba = FreeImage_ConvertTo32Bits(fiBitmap);
+		FreeImage_Unload(fiBitmap);
+		if (!rgba)
+		{
+			return false;
+		}
+
+		// FreeImage stores rows bottom up, dds wants them top down
+		outSurface.width = FreeImage_GetWidth(rgba);
+		outSurface.height = FreeImage_GetHeight(rgba);
+		outSurface.pixels.SetSize(outSurface.width * outSurface.height * 4);
+		for (IndexT y = 0; y < outSurface.height; ++y)
+		{
+			const BYTE* src = FreeImage_GetScanLine(rgba, outSurface.height - 1 - y);
+			ubyte* dst = &outSurface.pixels[y * outSurface.width * 4];
+			for (IndexT x = 0; x < outSurface.width; ++x, src += 4, dst += 4)
+			{
+				dst[0] = src[FI_RGBA_RED];
+				dst[1] = src[FI_RGBA_GREEN];
+				dst[2] = src[FI_RGBA_BLUE];
+				dst[3] = src[FI_RGBA_ALPHA];
+			}
+		}
+		FreeImage_Unload(rgba);
+		return outSurface.width > 0 && outSurface.height > 0;
+	}
+}
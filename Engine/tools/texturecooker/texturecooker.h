@@ -0,0 +1,117 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __texturecooker_H__
+#define __texturecooker_H__
+#include "app/application.h"
+#include "core/coreserver.h"
+#include "io/ioserver.h"
+#include "util/fixedarray.h"
+#include "tools/texturecooker/textureencoder.h"
+#include "tools/texturecooker/texturecache.h"
+#include "tools/texturecooker/texturecookerthread.h"
+
+namespace Tools
+{
+	// offline texture cooker: turns the source images of a directory tree into dds files with a full
+	// gamma correct mip chain and DXT1/DXT5 compression, which ImageResLoader::LoadDXT loads directly,
+	// or for GLES devices into ETC1 pkm files (one level, no alpha) for ImageResLoader::LoadETC.
+	// files are cooked on several threads, sources whose bytes and options did not change since the
+	// last run are skipped by the content hash cache
+	class TextureCooker : public App::Application
+	{
+	public:
+		enum FormatMode
+		{
+			AutoFormat,		// DXT5 if the source has any alpha, DXT1 otherwise
+			ForceDXT1,
+			ForceDXT5,
+			ForceETC1,		// pkm output for GLES targets
+		};
+
+		enum Result
+		{
+			Pending,
+			Cooked,
+			Skipped,
+			Failed,
+		};
+
+		struct CookItem
+		{
+			CookItem()
+				: hash(0)
+				, result(Pending)
+			{ }
+			Util::String source;	// path relative to the input dir, the cache key
+			Util::String srcPath;
+			Util::String dstPath;
+			uint hash;
+			Result result;
+		};
+
+		TextureCooker();
+		virtual ~TextureCooker();
+
+		/// open the application
+		virtual bool Open();
+		/// close the application
+		virtual void Close();
+		/// run the application
+		virtual void Run();
+
+		/// cook the next pending item, called from the cooker threads. return false when none is left
+		bool CookNextItem();
+
+	private:
+		/// collect source files below a directory
+		void _GatherFiles(const Util::String& dir, const Util::String& relDir);
+		/// cook one item
+		Result _Cook(CookItem& item) const;
+		/// hash the source bytes together with everything that changes the output
+		uint _ComputeHash(const ubyte* data, SizeT size) const;
+		/// decode the source image into a top-down rgba8 surface
+		bool _Decode(const CookItem& item, ubyte* data, SizeT size, TextureEncoder::Surface& outSurface) const;
+
+		GPtr<Core::CoreServer> mCoreServer;
+		GPtr<IO::IoServer> mIoServer;
+
+		Util::String mInputDir;
+		Util::String mOutputDir;
+		Util::String mCacheFile;
+		Util::Array<Util::String> mExtensions;
+		FormatMode mFormatMode;
+		bool mSrgb;
+		bool mMips;
+		bool mForce;
+		SizeT mNumThreads;
+
+		TextureCache mCache;
+		Util::Array<CookItem> mItems;
+		Util::Array<GPtr<TextureCookerThread> > mThreads;
+		volatile int mNextItem;
+		volatile int mNumFinished;
+	};
+}
+
+#endif // __texturecooker_H__
@@ -0,0 +1,632 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#include "stdneb.h"
+#include "tools/texturecooker/textureencoder.h"
+#include "math/scalar.h"
+#include "math/newMath/new_scalar.h"
+
+namespace Tools
+{
+#define FOURCC(c0, c1, c2, c3) (c0 | (c1 << 8) | (c2 << 16) | (c3 << 24))
+
+	typedef uint uint32;
+	typedef ushort uint16;
+	typedef ubyte uint8;
+
+#include "resource/DDS_Header.h"
+
+	// srgb <-> linear conversion, the decode side is a table since it runs for every texel of every level
+	static float s_SrgbToLinear[256];
+	static bool s_SrgbTableInitialized = false;
+
+	//------------------------------------------------------------------------------
+	static void 
+		_InitSrgbTable()
+	{
+		if (s_SrgbTableInitialized)
+		{
+			return;
+		}
+		for (IndexT i = 0; i < 256; ++i)
+		{
+			float c = i / 255.0f;
+			s_SrgbToLinear[i] = (c <= 0.04045f) ? c / 12.92f : Math::n_pow((c + 0.055f) / 1.055f, 2.4f);
+		}
+		s_SrgbTableInitialized = true;
+	}
+	//------------------------------------------------------------------------------
+	static ubyte 
+		_LinearToSrgb(float c)
+	{
+		c = Math::n_clamp(c, 0.0f, 1.0f);
+		c = (c <= 0.0031308f) ? c * 12.92f : 1.055f * Math::n_pow(c, 1.0f / 2.4f) - 0.055f;
+		return (ubyte)(c * 255.0f + 0.5f);
+	}
+	//------------------------------------------------------------------------------
+	static ubyte 
+		_ToByte(float c)
+	{
+		return (ubyte)(Math::n_clamp(c, 0.0f, 1.0f) * 255.0f + 0.5f);
+	}
+	//------------------------------------------------------------------------------
+	static uint16 
+		_To565(const float* c)
+	{
+		int r = (int)(Math::n_clamp(c[0], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+		int g = (int)(Math::n_clamp(c[1], 0.0f, 255.0f) * 63.0f / 255.0f + 0.5f);
+		int b = (int)(Math::n_clamp(c[2], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+		return (uint16)((r << 11) | (g << 5) | b);
+	}
+	//------------------------------------------------------------------------------
+	static void 
+		_From565(uint16 c, int* rgb)
+	{
+		int r = (c >> 11) & 31;
+		int g = (c >> 5) & 63;
+		int b = c & 31;
+		rgb[0] = (r << 3) | (r >> 2);
+		rgb[1] = (g << 2) | (g >> 4);
+		rgb[2] = (b << 3) | (b >> 2);
+	}
+	//------------------------------------------------------------------------------
+	void 
+		TextureEncoder::BuildMipChain(const Surface& top, bool srgb, bool mips, Util::Array<Surface>& outLevels)
+	{
+		n_assert(top.width > 0 && top.height > 0);
+		outLevels.Clear();
+		outLevels.Append(top);
+		if (!mips)
+		{
+			return;
+		}
+
+		_InitSrgbTable();
+
+		// the current level is kept in float linear space, so every level is filtered from
+		// full precision data instead of re-quantized bytes
+		SizeT width = top.width;
+		SizeT height = top.height;
+		Util::FixedArray<float> linear(width * height * 4);
+		for (IndexT i = 0; i < width * height; ++i)
+		{
+			const ubyte* src = &top.pixels[i * 4];
+			float* dst = &linear[i * 4];
+			for (IndexT c = 0; c < 3; ++c)
+			{
+				dst[c] = srgb ? s_SrgbToLinear[src[c]] : src[c] / 255.0f;
+			}
+			dst[3] = src[3] / 255.0f;
+		}
+
+		while (width > 1 || height > 1)
+		{
+			SizeT nextWidth = Math::n_max(1, width / 2);
+			SizeT nextHeight = Math::n_max(1, height / 2);
+			Util::FixedArray<float> next(nextWidth * nextHeight * 4);
+
+			// box filter, a dimension that is already 1 is only filtered along the other one
+			for (IndexT y = 0; y < nextHeight; ++y)
+			{
+				IndexT y0 = Math::n_min(y * 2, height - 1);
+				IndexT y1 = Math::n_min(y * 2 + 1, height - 1);
+				for (IndexT x = 0; x < nextWidth; ++x)
+				{
+					IndexT x0 = Math::n_min(x * 2, width - 1);
+					IndexT x1 = Math::n_min(x * 2 + 1, width - 1);
+					const float* s00 = &linear[(y0 * width + x0) * 4];
+					const float* s01 = &linear[(y0 * width + x1) * 4];
+					const float* s10 = &linear[(y1 * width + x0) * 4];
+					const float* s11 = &linear[(y1 * width + x1) * 4];
+					float* dst = &next[(y * nextWidth + x) * 4];
+					for (IndexT c = 0; c < 4; ++c)
+					{
+						dst[c] = (s00[c] + s01[c] + s10[c] + s11[c]) * 0.25f;
+					}
+				}
+			}
+
+			Surface level;
+			level.width = nextWidth;
+			level.height = nextHeight;
+			level.pixels.SetSize(nextWidth * nextHeight * 4);
+			for (IndexT i = 0; i < nextWidth * nextHeight; ++i)
+			{
+				const float* src = &next[i * 4];
+				ubyte* dst = &level.pixels[i * 4];
+				for (IndexT c = 0; c < 3; ++c)
+				{
+					dst[c] = srgb ? _LinearToSrgb(src[c]) : _ToByte(src[c]);
+				}
+				dst[3] = _ToByte(src[3]);
+			}
+			outLevels.Append(level);
+
+			linear = next;
+			width = nextWidth;
+			height = nextHeight;
+		}
+	}
+	//------------------------------------------------------------------------------
+	bool 
+		TextureEncoder::HasAlpha(const Surface& surface)
+	{
+		SizeT count = surface.width * surface.height;
+		for (IndexT i = 0; i < count; ++i)
+		{
+			if (surface.pixels[i * 4 + 3] != 255)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+	//------------------------------------------------------------------------------
+	void 
+		TextureEncoder::_FetchBlock(const Surface& surface, IndexT bx, IndexT by, ubyte* block)
+	{
+		for (IndexT y = 0; y < 4; ++y)
+		{
+			IndexT sy = Math::n_min(by * 4 + y, surface.height - 1);
+			for (IndexT x = 0; x < 4; ++x)
+			{
+				IndexT sx = Math::n_min(bx * 4 + x, surface.width - 1);
+				const ubyte* src = &surface.pixels[(sy * surface.width + sx) * 4];
+				ubyte* dst = block + (y * 4 + x) * 4;
+				dst[0] = src[0];
+				dst[1] = src[1];
+				dst[2] = src[2];
+				dst[3] = src[3];
+			}
+		}
+	}
+	//------------------------------------------------------------------------------
+	void 
+		TextureEncoder::_EncodeColorBlock(const ubyte* block, ubyte* dst)
+	{
+		// principal axis of the block colors by power iteration on the covariance matrix
+		float mean[3] = { 0.0f, 0.0f, 0.0f };
+		for (IndexT i = 0; i < 16; ++i)
+		{
+			mean[0] += block[i * 4 + 0];
+			mean[1] += block[i * 4 + 1];
+			mean[2] += block[i * 4 + 2];
+		}
+		mean[0] /= 16.0f;
+		mean[1] /= 16.0f;
+		mean[2] /= 16.0f;
+
+		float cov[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+		for (IndexT i = 0; i < 16; ++i)
+		{
+			float r = block[i * 4 + 0] - mean[0];
+			float g = block[i * 4 + 1] - mean[1];
+			float b = block[i * 4 + 2] - mean[2];
+			cov[0] += r * r;
+			cov[1] += r * g;
+			cov[2] += r * b;
+			cov[3] += g * g;
+			cov[4] += g * b;
+			cov[5] += b * b;
+		}
+
+		float axis[3] = { 1.0f, 1.0f, 1.0f };
+		for (IndexT iter = 0; iter < 8; ++iter)
+		{
+			float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+			float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+			float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+			float len = Math::n_max(Math::n_max(Math::n_abs(x), Math::n_abs(y)), Math::n_abs(z));
+			if (len < 1e-6f)
+			{
+				break;
+			}
+			axis[0] = x / len;
+			axis[1] = y / len;
+			axis[2] = z / len;
+		}
+
+		float minT = 0.0f;
+		float maxT = 0.0f;
+		float axisLenSq = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+		if (axisLenSq > 1e-6f)
+		{
+			minT = 1e30f;
+			maxT = -1e30f;
+			for (IndexT i = 0; i < 16; ++i)
+			{
+				float t = ((block[i * 4 + 0] - mean[0]) * axis[0] +
+					(block[i * 4 + 1] - mean[1]) * axis[1] +
+					(block[i * 4 + 2] - mean[2]) * axis[2]) / axisLenSq;
+				minT = Math::n_min(minT, t);
+				maxT = Math::n_max(maxT, t);
+			}
+			// inset the endpoints a little, the interpolated colors then cover the range better
+			float inset = (maxT - minT) / 16.0f;
+			minT += inset;
+			maxT -= inset;
+		}
+
+		float maxColor[3];
+		float minColor[3];
+		for (IndexT c = 0; c < 3; ++c)
+		{
+			maxColor[c] = mean[c] + axis[c] * maxT;
+			minColor[c] = mean[c] + axis[c] * minT;
+		}
+
+		uint16 c0 = _To565(maxColor);
+		uint16 c1 = _To565(minColor);
+		if (c0 < c1)
+		{
+			uint16 tmp = c0;
+			c0 = c1;
+			c1 = tmp;
+		}
+
+		uint32 indices = 0;
+		if (c0 != c1)
+		{
+			// c0 > c1 selects the four color mode
+			int palette[4][3];
+			_From565(c0, palette[0]);
+			_From565(c1, palette[1]);
+			for (IndexT c = 0; c < 3; ++c)
+			{
+				palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+			}
+
+			for (IndexT i = 0; i < 16; ++i)
+			{
+				int best = 0;
+				int bestDist = 0x7fffffff;
+				for (int p = 0; p < 4; ++p)
+				{
+					int dr = block[i * 4 + 0] - palette[p][0];
+					int dg = block[i * 4 + 1] - palette[p][1];
+					int db = block[i * 4 + 2] - palette[p][2];
+					int dist = dr * dr + dg * dg + db * db;
+					if (dist < bestDist)
+					{
+						bestDist = dist;
+						best = p;
+					}
+				}
+				indices |= (uint32)best << (i * 2);
+			}
+		}
+
+		dst[0] = (ubyte)(c0 & 0xff);
+		dst[1] = (ubyte)(c0 >> 8);
+		dst[2] = (ubyte)(c1 & 0xff);
+		dst[3] = (ubyte)(c1 >> 8);
+		dst[4] = (ubyte)(indices & 0xff);
+		dst[5] = (ubyte)((indices >> 8) & 0xff);
+		dst[6] = (ubyte)((indices >> 16) & 0xff);
+		dst[7] = (ubyte)((indices >> 24) & 0xff);
+	}
+	//------------------------------------------------------------------------------
+	void 
+		TextureEncoder::_EncodeAlphaBlock(const ubyte* block, ubyte* dst)
+	{
+		int a0 = 0;
+		int a1 = 255;
+		for (IndexT i = 0; i < 16; ++i)
+		{
+			a0 = Math::n_max(a0, (int)block[i * 4 + 3]);
+			a1 = Math::n_min(a1, (int)block[i * 4 + 3]);
+		}
+
+		// a0 > a1 selects the eight alpha mode, with a0 == a1 every index 0 is exact anyway
+		int palette[8];
+		palette[0] = a0;
+		palette[1] = a1;
+		for (int p = 1; p < 7; ++p)
+		{
+			palette[p + 1] = ((7 - p) * a0 + p * a1) / 7;
+		}
+
+		unsigned long long bits = 0;
+		if (a0 != a1)
+		{
+			for (IndexT i = 0; i < 16; ++i)
+			{
+				int a = block[i * 4 + 3];
+				int best = 0;
+				int bestDist = 0x7fffffff;
+				for (int p = 0; p < 8; ++p)
+				{
+					int dist = Math::n_abs(a - palette[p]);
+					if (dist < bestDist)
+					{
+						bestDist = dist;
+						best = p;
+					}
+				}
+				bits |= (unsigned long long)best << (i * 3);
+			}
+		}
+
+		dst[0] = (ubyte)a0;
+		dst[1] = (ubyte)a1;
+		for (IndexT i = 0; i < 6; ++i)
+		{
+			dst[2 + i] = (ubyte)((bits >> (i * 8)) & 0xff);
+		}
+	}
+	//------------------------------------------------------------------------------
+	// etc1 intensity modifiers, by table codeword and pixel index
+	static const int s_Etc1Modifiers[8][4] =
+	{
+		{   2,   8,   -2,   -8 },
+		{   5,  17,   -5,  -17 },
+		{   9,  29,   -9,  -29 },
+		{  13,  42,  -13,  -42 },
+		{  18,  60,  -18,  -60 },
+		{  24,  80,  -24,  -80 },
+		{  33, 106,  -33, -106 },
+		{  47, 183,  -47, -183 }
+	};
+	//------------------------------------------------------------------------------
+	void 
+		TextureEncoder::_EncodeEtc1Block(const ubyte* block, ubyte* dst)
+	{
+		// both sub block layouts are tried, flip 0 splits left/right, flip 1 top/bottom.
+		// each half gets its average color as base, the table and indices are searched exhaustively
+		int bestError = 0x7fffffff;
+		for (int flip = 0; flip < 2; ++flip)
+		{
+			float avg[2][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+			for (IndexT y = 0; y < 4; ++y)
+			{
+				for (IndexT x = 0; x < 4; ++x)
+				{
+					int half = flip ? (y >> 1) : (x >> 1);
+					for (IndexT c = 0; c < 3; ++c)
+					{
+						avg[half][c] += block[(y * 4 + x) * 4 + c] / 8.0f;
+					}
+				}
+			}
+
+			// differential mode keeps 5 bits per base, if the second base is within the 3 bit delta
+			int quant[2][3];
+			bool diff = true;
+			for (IndexT half = 0; half < 2; ++half)
+			{
+				for (IndexT c = 0; c < 3; ++c)
+				{
+					quant[half][c] = (int)(avg[half][c] * 31.0f / 255.0f + 0.5f);
+				}
+			}
+			for (IndexT c = 0; c < 3; ++c)
+			{
+				int delta = quant[1][c] - quant[0][c];
+				diff = diff && delta >= -4 && delta <= 3;
+			}
+			int base[2][3];
+			for (IndexT half = 0; half < 2; ++half)
+			{
+				for (IndexT c = 0; c < 3; ++c)
+				{
+					if (!diff)
+					{
+						quant[half][c] = (int)(avg[half][c] * 15.0f / 255.0f + 0.5f);
+						base[half][c] = quant[half][c] * 17;
+					}
+					else
+					{
+						base[half][c] = (quant[half][c] << 3) | (quant[half][c] >> 2);
+					}
+				}
+			}
+
+			int error = 0;
+			int tables[2] = { 0, 0 };
+			uint32 msb = 0;
+			uint32 lsb = 0;
+			for (int half = 0; half < 2; ++half)
+			{
+				int halfError = 0x7fffffff;
+				uint32 halfMsb = 0;
+				uint32 halfLsb = 0;
+				for (int t = 0; t < 8; ++t)
+				{
+					int palette[4][3];
+					for (IndexT i = 0; i < 4; ++i)
+					{
+						for (IndexT c = 0; c < 3; ++c)
+						{
+							palette[i][c] = Math::n_clamp(base[half][c] + s_Etc1Modifiers[t][i], 0, 255);
+						}
+					}
+
+					int tableError = 0;
+					uint32 tableMsb = 0;
+					uint32 tableLsb = 0;
+					for (IndexT y = 0; y < 4; ++y)
+					{
+						for (IndexT x = 0; x < 4; ++x)
+						{
+							if ((flip ? (y >> 1) : (x >> 1)) != half)
+							{
+								continue;
+							}
+							const ubyte* pixel = block + (y * 4 + x) * 4;
+							int best = 0;
+							int bestDist = 0x7fffffff;
+							for (int i = 0; i < 4; ++i)
+							{
+								int dr = pixel[0] - palette[i][0];
+								int dg = pixel[1] - palette[i][1];
+								int db = pixel[2] - palette[i][2];
+								int dist = dr * dr + dg * dg + db * db;
+								if (dist < bestDist)
+								{
+									bestDist = dist;
+									best = i;
+								}
+							}
+							// the indices run down the columns
+							int bit = x * 4 + y;
+							tableMsb |= (uint32)(best >> 1) << bit;
+							tableLsb |= (uint32)(best & 1) << bit;
+							tableError += bestDist;
+						}
+					}
+					if (tableError < halfError)
+					{
+						halfError = tableError;
+						halfMsb = tableMsb;
+						halfLsb = tableLsb;
+						tables[half] = t;
+					}
+				}
+				error += halfError;
+				msb |= halfMsb;
+				lsb |= halfLsb;
+			}
+
+			if (error >= bestError)
+			{
+				continue;
+			}
+			bestError = error;
+
+			// the 64 bits are stored big endian
+			for (IndexT c = 0; c < 3; ++c)
+			{
+				dst[c] = diff ? (ubyte)((quant[0][c] << 3) | ((quant[1][c] - quant[0][c]) & 0x7))
+					: (ubyte)((quant[0][c] << 4) | quant[1][c]);
+			}
+			dst[3] = (ubyte)((tables[0] << 5) | (tables[1] << 2) | (diff ? 0x2 : 0) | flip);
+			dst[4] = (ubyte)(msb >> 8);
+			dst[5] = (ubyte)(msb & 0xff);
+			dst[6] = (ubyte)(lsb >> 8);
+			dst[7] = (ubyte)(lsb & 0xff);
+		}
+	}
+	//------------------------------------------------------------------------------
+	void 
+		TextureEncoder::Compress(const Surface& surface, Format format, ubyte* dst)
+	{
+		ubyte block[64];
+		SizeT blocksX = (surface.width + 3) / 4;
+		SizeT blocksY = (surface.height + 3) / 4;
+		for (IndexT by = 0; by < blocksY; ++by)
+		{
+			for (IndexT bx = 0; bx < blocksX; ++bx)
+			{
+				_FetchBlock(surface, bx, by, block);
+				if (format == ETC1)
+				{
+					_EncodeEtc1Block(block, dst);
+					dst += 8;
+					continue;
+				}
+				if (format == DXT5)
+				{
+					_EncodeAlphaBlock(block, dst);
+					dst += 8;
+				}
+				_EncodeColorBlock(block, dst);
+				dst += 8;
+			}
+		}
+	}
+	//------------------------------------------------------------------------------
+	bool 
+		TextureEncoder::WriteDDS(const GPtr<IO::Stream>& stream, const Util::Array<Surface>& levels, Format format)
+	{
+		n_assert(stream.isvalid() && stream->IsOpen());
+		n_assert(levels.Size() > 0);
+		n_assert(format != ETC1);
+
+		const Surface& top = levels[0];
+
+		DDSHeader header;
+		Memory::Clear(&header, sizeof(header));
+		header.size = DDS_HEADER_SIZE;
+		header.flags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_LINEARSIZE;
+		header.height = top.height;
+		header.width = top.width;
+		header.sizeOrPitch = GetCompressedSize(top.width, top.height, format);
+		header.depth = 1;
+		header.mipMapCount = levels.Size();
+		header.pixelFormat.size = DDS_PIXELFORMAT_SIZE;
+		header.pixelFormat.flags = DDPF_FOURCC;
+		header.pixelFormat.fourCC = (format == DXT1) ? FOURCC('D','X','T','1') : FOURCC('D','X','T','5');
+		header.caps.caps1 = DDSCAPS_TEXTURE;
+		if (levels.Size() > 1)
+		{
+			header.flags |= DDSD_MIPMAPCOUNT;
+			header.caps.caps1 |= DDSCAPS_COMPLEX | DDSCAPS_MIPMAP;
+		}
+
+		uint32 magic = DDS_MAGIC;
+		stream->Write(&magic, sizeof(magic));
+		stream->Write(&header, sizeof(header));
+
+		Util::FixedArray<ubyte> buffer(GetCompressedSize(top.width, top.height, format));
+		for (IndexT i = 0; i < levels.Size(); ++i)
+		{
+			const Surface& level = levels[i];
+			SizeT size = GetCompressedSize(level.width, level.height, format);
+			Compress(level, format, buffer.Begin());
+			stream->Write(buffer.Begin(), size);
+		}
+		return true;
+	}
+	//------------------------------------------------------------------------------
+	bool 
+		TextureEncoder::WritePKM(const GPtr<IO::Stream>& stream, const Surface& top)
+	{
+		n_assert(stream.isvalid() && stream->IsOpen());
+		n_assert(top.width > 0 && top.height > 0);
+		if (top.width > 0xffff || top.height > 0xffff)
+		{
+			return false;
+		}
+
+		// "PKM 10", format 0 (ETC1_RGB_NO_MIPMAPS), padded and original size, all big endian. see ETCHeader
+		const SizeT paddedWidth = (top.width + 3) & ~3;
+		const SizeT paddedHeight = (top.height + 3) & ~3;
+		ubyte header[16] = { 'P', 'K', 'M', ' ', '1', '0', 0, 0 };
+		header[8] = (ubyte)(paddedWidth >> 8);
+		header[9] = (ubyte)(paddedWidth & 0xff);
+		header[10] = (ubyte)(paddedHeight >> 8);
+		header[11] = (ubyte)(paddedHeight & 0xff);
+		header[12] = (ubyte)(top.width >> 8);
+		header[13] = (ubyte)(top.width & 0xff);
+		header[14] = (ubyte)(top.height >> 8);
+		header[15] = (ubyte)(top.height & 0xff);
+		stream->Write(header, sizeof(header));
+
+		SizeT size = GetCompressedSize(top.width, top.height, ETC1);
+		Util::FixedArray<ubyte> buffer(size);
+		Compress(top, ETC1, buffer.Begin());
+		stream->Write(buffer.Begin(), size);
+		return true;
+	}
+}
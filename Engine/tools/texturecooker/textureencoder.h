@@ -0,0 +1,97 @@
+/****************************************************************************
+Copyright (c) 2011-2013,WebJet Business Division,CYOU
+ 
+http://www.genesis-3d.com.cn
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+****************************************************************************/
+#ifndef __textureencoder_H__
+#define __textureencoder_H__
+#include "core/types.h"
+#include "util/array.h"
+#include "util/fixedarray.h"
+#include "io/stream.h"
+
+namespace Tools
+{
+	// offline texture processing: gamma correct mip chain, DXT block compression and dds output,
+	// ETC1 block compression and pkm output for GLES devices.
+	// everything is static and stateless so it can run on any number of cooker threads at once
+	class TextureEncoder
+	{
+	public:
+		enum Format
+		{
+			DXT1,		// BC1, opaque
+			DXT5,		// BC3, interpolated alpha
+			ETC1,		// GL_ETC1_RGB8_OES, opaque, pkm files only
+		};
+
+		/// one uncompressed rgba8 level, rows top to bottom
+		struct Surface
+		{
+			Surface()
+				: width(0)
+				, height(0)
+			{ }
+			SizeT width;
+			SizeT height;
+			Util::FixedArray<ubyte> pixels;
+		};
+
+		/// build all mip levels down to 1x1, level 0 is a copy of the source. srgb filters in linear space
+		static void BuildMipChain(const Surface& top, bool srgb, bool mips, Util::Array<Surface>& outLevels);
+
+		/// return true if any texel is not fully opaque
+		static bool HasAlpha(const Surface& surface);
+
+		/// size in bytes of one compressed level
+		static SizeT GetCompressedSize(SizeT width, SizeT height, Format format);
+
+		/// compress one level, dst must hold GetCompressedSize bytes
+		static void Compress(const Surface& surface, Format format, ubyte* dst);
+
+		/// compress all levels and write them as a dds file the image loader understands
+		static bool WriteDDS(const GPtr<IO::Stream>& stream, const Util::Array<Surface>& levels, Format format);
+
+		/// compress the top level to ETC1 and write it as a pkm file, the format has no mip levels
+		static bool WritePKM(const GPtr<IO::Stream>& stream, const Surface& top);
+
+	private:
+		/// gather a 4x4 block, clamping at the border
+		static void _FetchBlock(const Surface& surface, IndexT bx, IndexT by, ubyte* block);
+		/// encode the color part of a block
+		static void _EncodeColorBlock(const ubyte* block, ubyte* dst);
+		/// encode the interpolated alpha part of a block
+		static void _EncodeAlphaBlock(const ubyte* block, ubyte* dst);
+		/// encode a block as ETC1, the alpha is dropped
+		static void _EncodeEtc1Block(const ubyte* block, ubyte* dst);
+	};
+
+	//------------------------------------------------------------------------------
+	inline
+		SizeT 
+		TextureEncoder::GetCompressedSize(SizeT width, SizeT height, Format format)
+	{
+		SizeT blocks = ((width + 3) / 4) * ((height + 3) / 4);
+		return blocks * (format == DXT5 ? 16 : 8);
+	}
+}
+
+#endif // __textureencoder_H__